@@ -0,0 +1,175 @@
+#include "cds.h"
+#include <time.h>
+
+
+#define DEFAULT_NUM_STR     (1 << 18)
+#define SIZE_STR            (96)
+#define NUM_HOST            (512)
+#define NUM_PATH            (64)
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+uint64_t NextRandom(uint64_t *pState)
+{
+    /* The xorshift64 generator keeps the benchmark input reproducible. */
+    uint64_t ulState = *pState;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    *pState = ulState;
+    return ulState;
+}
+
+void Report(const char *szMethod, const char *szOp, uint64_t ulNano,
+            int32_t iNum)
+{
+    printf("%-8s %-10s %10.3f ms %10.1f ns/op\n", szMethod, szOp,
+           (double)ulNano / 1e6, (double)ulNano / iNum);
+    return;
+}
+
+int32_t CompareStr(Key keySrc, Key keyTge)
+{
+    return strcmp((const char*)keySrc, (const char*)keyTge);
+}
+
+void BenchArtMap(char **aStr, int32_t *aLen, int32_t iNum)
+{
+    ArtMap *pMap;
+    if (ArtMapInit(&pMap) != SUCC)
+        return;
+
+    uint64_t ulBgn = NowNanoSecond();
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        pMap->put(pMap, (Key)aStr[iIdx], aLen[iIdx], (Value)aStr[iIdx]);
+    Report("art_map", "put", NowNanoSecond() - ulBgn, iNum);
+
+    Value value;
+    int32_t iFound = 0;
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        iFound += (pMap->get(pMap, (Key)aStr[iIdx], aLen[iIdx], &value) == SUCC);
+    Report("art_map", "get", NowNanoSecond() - ulBgn, iNum);
+
+    /* Scan the entries in order, which the hash based index cannot offer. */
+    ArtEntry *pEntry;
+    int32_t iScan = 0;
+    ulBgn = NowNanoSecond();
+    pMap->iterate(pMap, true, NULL);
+    while (pMap->iterate(pMap, false, &pEntry) == CONTINUE)
+        iScan++;
+    Report("art_map", "iterate", NowNanoSecond() - ulBgn, iScan);
+
+    if (iFound != iNum)
+        printf("art_map misses %d strings\n", iNum - iFound);
+    ArtMapDeinit(&pMap);
+    return;
+}
+
+void BenchTreeMap(char **aStr, int32_t iNum)
+{
+    TreeMap *pMap;
+    if (TreeMapInit(&pMap) != SUCC)
+        return;
+    pMap->set_compare(pMap, CompareStr);
+    pMap->set_pair_mode(pMap, TREE_MAP_PAIR_INLINE);
+
+    Pair pair;
+    uint64_t ulBgn = NowNanoSecond();
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        pair.key = aStr[iIdx];
+        pair.value = aStr[iIdx];
+        pMap->put(pMap, &pair);
+    }
+    Report("tree_map", "put", NowNanoSecond() - ulBgn, iNum);
+
+    Value value;
+    int32_t iFound = 0;
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        iFound += (pMap->get(pMap, (Key)aStr[iIdx], &value) == SUCC);
+    Report("tree_map", "get", NowNanoSecond() - ulBgn, iNum);
+
+    Pair *pPair;
+    int32_t iScan = 0;
+    ulBgn = NowNanoSecond();
+    pMap->iterate(pMap, true, NULL);
+    while (pMap->iterate(pMap, false, &pPair) != END)
+        iScan++;
+    Report("tree_map", "iterate", NowNanoSecond() - ulBgn, iScan);
+
+    if (iFound != iNum)
+        printf("tree_map misses %d strings\n", iNum - iFound);
+    TreeMapDeinit(&pMap);
+    return;
+}
+
+void BenchTrie(char **aStr, int32_t iNum)
+{
+    Trie *pTrie;
+    if (TrieInit(&pTrie) != SUCC)
+        return;
+
+    uint64_t ulBgn = NowNanoSecond();
+    pTrie->bulk_insert(pTrie, aStr, iNum);
+    Report("trie", "put", NowNanoSecond() - ulBgn, iNum);
+
+    int32_t iIdx, iFound = 0;
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        iFound += (pTrie->has_exact(pTrie, aStr[iIdx]) == SUCC);
+    Report("trie", "get", NowNanoSecond() - ulBgn, iNum);
+
+    if (iFound != iNum)
+        printf("trie misses %d strings\n", iNum - iFound);
+    TrieDeinit(&pTrie);
+    return;
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iNum = (argc > 1)? atoi(argv[1]) : DEFAULT_NUM_STR;
+    if (iNum <= 0)
+        iNum = DEFAULT_NUM_STR;
+
+    char **aStr = (char**)malloc(sizeof(char*) * iNum);
+    int32_t *aLen = (int32_t*)malloc(sizeof(int32_t) * iNum);
+    char *aBuf = (char*)malloc(SIZE_STR * (size_t)iNum);
+    if (!aStr || !aLen || !aBuf) {
+        free(aStr);
+        free(aLen);
+        free(aBuf);
+        return ERR_NOMEM;
+    }
+
+    /* Synthesize the URLs which share the scheme, the hosts, and the paths. */
+    uint64_t ulState = 0x9e3779b97f4a7c15ull;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        aStr[iIdx] = aBuf + (size_t)iIdx * SIZE_STR;
+        aLen[iIdx] = snprintf(aStr[iIdx], SIZE_STR,
+                              "https://www.host%03d.com/path%02d/%llx",
+                              (int32_t)(NextRandom(&ulState) % NUM_HOST),
+                              (int32_t)(NextRandom(&ulState) % NUM_PATH),
+                              (unsigned long long)(NextRandom(&ulState) >> 16));
+    }
+    printf("Insert and search %d synthetic URLs\n", iNum);
+
+    BenchArtMap(aStr, aLen, iNum);
+    BenchTreeMap(aStr, iNum);
+    BenchTrie(aStr, iNum);
+
+    free(aStr);
+    free(aLen);
+    free(aBuf);
+    return SUCC;
+}
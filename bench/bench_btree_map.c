@@ -0,0 +1,203 @@
+#include "cds.h"
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+
+#define DEFAULT_NUM_PAIR    (1 << 20)
+#define DEFAULT_NUM_LOOKUP  (1 << 22)
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+uint64_t NextRandom(uint64_t *pState)
+{
+    /* The xorshift64 generator keeps the benchmark input reproducible. */
+    uint64_t ulState = *pState;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    *pState = ulState;
+    return ulState;
+}
+
+int32_t OpenMissCounter()
+{
+#ifdef __linux__
+    /* Count the last level cache misses of the calling thread in user space. */
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int32_t)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+void StartCounter(int32_t iFd)
+{
+#ifdef __linux__
+    if (iFd >= 0) {
+        ioctl(iFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(iFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+int64_t StopCounter(int32_t iFd)
+{
+#ifdef __linux__
+    uint64_t ulCount;
+    if (iFd >= 0) {
+        ioctl(iFd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(iFd, &ulCount, sizeof(ulCount)) == sizeof(ulCount))
+            return (int64_t)ulCount;
+    }
+#endif
+    return -1;
+}
+
+void Report(const char *szMap, const char *szOp, uint64_t ulNano, int64_t lMiss,
+            int32_t iNum)
+{
+    printf("%-10s %-8s %10.3f ms %8.1f ns/op", szMap, szOp, (double)ulNano / 1e6,
+           (double)ulNano / iNum);
+    if (lMiss >= 0)
+        printf(" %8.2f misses/op\n", (double)lMiss / iNum);
+    else
+        printf(" %8s misses/op\n", "n/a");
+}
+
+void BenchTreeMap(const char *szMap, int32_t iMode, Pair *aPair, int32_t iNum,
+                  Key *aProbe, int32_t iProbe, int32_t iFd)
+{
+    TreeMap *pMap;
+    if (TreeMapInit(&pMap) != SUCC)
+        return;
+    pMap->set_pair_mode(pMap, iMode);
+
+    int32_t iIdx;
+    StartCounter(iFd);
+    uint64_t ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        pMap->put(pMap, &aPair[iIdx]);
+    Report(szMap, "put", NowNanoSecond() - ulBgn, StopCounter(iFd), iNum);
+
+    Value value;
+    int32_t iHit = 0;
+    StartCounter(iFd);
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iProbe ; iIdx++)
+        iHit += (pMap->get(pMap, aProbe[iIdx], &value) == SUCC);
+    Report(szMap, "get", NowNanoSecond() - ulBgn, StopCounter(iFd), iProbe);
+    if (iHit != iProbe)
+        printf("%s misses %d keys\n", szMap, iProbe - iHit);
+
+    Pair *pPair;
+    StartCounter(iFd);
+    ulBgn = NowNanoSecond();
+    pMap->iterate(pMap, true, NULL);
+    while (pMap->iterate(pMap, false, &pPair) != END);
+    Report(szMap, "iterate", NowNanoSecond() - ulBgn, StopCounter(iFd),
+           pMap->size(pMap));
+
+    TreeMapDeinit(&pMap);
+}
+
+void BenchBTreeMap(Pair *aPair, int32_t iNum, Key *aProbe, int32_t iProbe,
+                   int32_t iFd)
+{
+    BTreeMap *pMap;
+    if (BTreeMapInit(&pMap) != SUCC)
+        return;
+
+    int32_t iIdx;
+    StartCounter(iFd);
+    uint64_t ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        pMap->put(pMap, &aPair[iIdx]);
+    Report("btree_map", "put", NowNanoSecond() - ulBgn, StopCounter(iFd), iNum);
+
+    Value value;
+    int32_t iHit = 0;
+    StartCounter(iFd);
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iProbe ; iIdx++)
+        iHit += (pMap->get(pMap, aProbe[iIdx], &value) == SUCC);
+    Report("btree_map", "get", NowNanoSecond() - ulBgn, StopCounter(iFd), iProbe);
+    if (iHit != iProbe)
+        printf("btree_map misses %d keys\n", iProbe - iHit);
+
+    Pair *pPair;
+    StartCounter(iFd);
+    ulBgn = NowNanoSecond();
+    pMap->iterate(pMap, true, NULL);
+    while (pMap->iterate(pMap, false, &pPair) != END);
+    Report("btree_map", "iterate", NowNanoSecond() - ulBgn, StopCounter(iFd),
+           pMap->size(pMap));
+
+    BTreeMapDeinit(&pMap);
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iNum = (argc > 1)? atoi(argv[1]) : DEFAULT_NUM_PAIR;
+    int32_t iProbe = (argc > 2)? atoi(argv[2]) : DEFAULT_NUM_LOOKUP;
+    if (iNum <= 0)
+        iNum = DEFAULT_NUM_PAIR;
+    if (iProbe <= 0)
+        iProbe = DEFAULT_NUM_LOOKUP;
+
+    /* The pairs are owned by the benchmark, so both maps keep the default
+       destroy method which leaves them untouched. */
+    Pair *aPair = (Pair*)malloc(sizeof(Pair) * iNum);
+    Key *aProbe = (Key*)malloc(sizeof(Key) * iProbe);
+    if (!aPair || !aProbe) {
+        free(aPair);
+        free(aProbe);
+        return ERR_NOMEM;
+    }
+
+    uint64_t ulState = 0x9e3779b97f4a7c15ull;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        aPair[iIdx].key = (void*)(uintptr_t)NextRandom(&ulState);
+        aPair[iIdx].value = (void*)(uintptr_t)iIdx;
+    }
+    for (iIdx = 0 ; iIdx < iProbe ; iIdx++)
+        aProbe[iIdx] = aPair[NextRandom(&ulState) % iNum].key;
+
+    int32_t iFd = OpenMissCounter();
+    printf("Put %d random pairs and get %d random keys\n", iNum, iProbe);
+    if (iFd < 0)
+        printf("The cache miss counter is not available\n");
+
+    BenchTreeMap("tree_map", TREE_MAP_PAIR_REFER, aPair, iNum, aProbe, iProbe,
+                 iFd);
+    BenchTreeMap("tree_inl", TREE_MAP_PAIR_INLINE, aPair, iNum, aProbe, iProbe,
+                 iFd);
+    BenchTreeMap("tree_int", TREE_MAP_PAIR_INTEGER, aPair, iNum, aProbe, iProbe,
+                 iFd);
+    BenchBTreeMap(aPair, iNum, aProbe, iProbe, iFd);
+
+    if (iFd >= 0)
+        close(iFd);
+    free(aPair);
+    free(aProbe);
+    return SUCC;
+}
@@ -0,0 +1,222 @@
+#include "cds.h"
+#include <time.h>
+#include <pthread.h>
+
+
+#define DEFAULT_NUM_PAIR    (1 << 18)
+#define DEFAULT_NUM_OP      (1 << 20)
+#define MAX_NUM_THREAD      (8)
+#define LEN_SCAN            (16)
+
+/* The workload mix out of 100 operations. */
+#define RATIO_PUT           (10)
+#define RATIO_REMOVE        (5)
+#define RATIO_SCAN          (5)
+
+
+typedef struct _Worker {
+    void *pMap;
+    Pair *aPair;
+    int32_t iNum;
+    int32_t iOp;
+    uint64_t ulSeed;
+    pthread_rwlock_t *pLock;
+    pthread_barrier_t *pBarrier;
+} Worker;
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+uint64_t NextRandom(uint64_t *pState)
+{
+    /* The xorshift64 generator keeps the benchmark input reproducible. */
+    uint64_t ulState = *pState;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    *pState = ulState;
+    return ulState;
+}
+
+void* RunTreeMap(void *pArg)
+{
+    Worker *pWorker = (Worker*)pArg;
+    TreeMap *pMap = (TreeMap*)pWorker->pMap;
+    pthread_rwlock_t *pLock = pWorker->pLock;
+    uint64_t ulState = pWorker->ulSeed;
+    pthread_barrier_wait(pWorker->pBarrier);
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < pWorker->iOp ; iIdx++) {
+        uint64_t ulRand = NextRandom(&ulState);
+        Pair *pPair = &(pWorker->aPair[(ulRand >> 8) % pWorker->iNum]);
+        int32_t iDice = (int32_t)(ulRand % 100);
+
+        if (iDice < RATIO_PUT) {
+            pthread_rwlock_wrlock(pLock);
+            pMap->put(pMap, pPair);
+            pthread_rwlock_unlock(pLock);
+        } else if (iDice < RATIO_PUT + RATIO_REMOVE) {
+            pthread_rwlock_wrlock(pLock);
+            pMap->remove(pMap, pPair->key);
+            pthread_rwlock_unlock(pLock);
+        } else if (iDice < RATIO_PUT + RATIO_REMOVE + RATIO_SCAN) {
+            Pair *pScan;
+            TreeMapCursor cursor;
+            int32_t iStep = 0;
+            pthread_rwlock_rdlock(pLock);
+            pMap->cursor_seek(pMap, pPair->key, &cursor);
+            while (iStep++ < LEN_SCAN &&
+                   pMap->cursor_next(pMap, &cursor, &pScan) == SUCC);
+            pthread_rwlock_unlock(pLock);
+        } else {
+            Value value;
+            pthread_rwlock_rdlock(pLock);
+            pMap->get(pMap, pPair->key, &value);
+            pthread_rwlock_unlock(pLock);
+        }
+    }
+    return NULL;
+}
+
+void* RunConcurrentTreeMap(void *pArg)
+{
+    Worker *pWorker = (Worker*)pArg;
+    ConcurrentTreeMap *pMap = (ConcurrentTreeMap*)pWorker->pMap;
+    uint64_t ulState = pWorker->ulSeed;
+    pthread_barrier_wait(pWorker->pBarrier);
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < pWorker->iOp ; iIdx++) {
+        uint64_t ulRand = NextRandom(&ulState);
+        Pair *pPair = &(pWorker->aPair[(ulRand >> 8) % pWorker->iNum]);
+        int32_t iDice = (int32_t)(ulRand % 100);
+
+        if (iDice < RATIO_PUT)
+            pMap->put(pMap, pPair);
+        else if (iDice < RATIO_PUT + RATIO_REMOVE)
+            pMap->remove(pMap, pPair->key);
+        else if (iDice < RATIO_PUT + RATIO_REMOVE + RATIO_SCAN) {
+            Pair *pScan;
+            ConcurrentTreeMapView view;
+            int32_t iStep = 0;
+            pMap->view_open(pMap, &view);
+            pMap->view_seek(pMap, &view, pPair->key);
+            while (iStep++ < LEN_SCAN &&
+                   pMap->view_iterate(pMap, &view, false, &pScan) == CONTINUE);
+            pMap->view_close(pMap, &view);
+        } else {
+            Value value;
+            pMap->get(pMap, pPair->key, &value);
+        }
+    }
+    return NULL;
+}
+
+void RunWorkers(const char *szMap, void *pMap, void* (*pRoutine) (void*),
+                Pair *aPair, int32_t iNum, int32_t iOp, int32_t iThrd)
+{
+    pthread_t aThrd[MAX_NUM_THREAD];
+    Worker aWorker[MAX_NUM_THREAD];
+    pthread_rwlock_t lock;
+    pthread_barrier_t barrier;
+    pthread_rwlock_init(&lock, NULL);
+    pthread_barrier_init(&barrier, NULL, iThrd + 1);
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iThrd ; iIdx++) {
+        aWorker[iIdx].pMap = pMap;
+        aWorker[iIdx].aPair = aPair;
+        aWorker[iIdx].iNum = iNum;
+        aWorker[iIdx].iOp = iOp / iThrd;
+        aWorker[iIdx].ulSeed = 0x9e3779b97f4a7c15ull * (iIdx + 1);
+        aWorker[iIdx].pLock = &lock;
+        aWorker[iIdx].pBarrier = &barrier;
+        pthread_create(&aThrd[iIdx], NULL, pRoutine, &aWorker[iIdx]);
+    }
+
+    pthread_barrier_wait(&barrier);
+    uint64_t ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iThrd ; iIdx++)
+        pthread_join(aThrd[iIdx], NULL);
+    uint64_t ulNano = NowNanoSecond() - ulBgn;
+
+    int32_t iTotal = (iOp / iThrd) * iThrd;
+    printf("%-20s %2d threads %10.3f ms %10.3f Mops/s\n", szMap, iThrd,
+           (double)ulNano / 1e6, (double)iTotal * 1e3 / ulNano);
+
+    pthread_barrier_destroy(&barrier);
+    pthread_rwlock_destroy(&lock);
+}
+
+void BenchTreeMap(Pair *aPair, int32_t iNum, int32_t iOp, int32_t iThrd)
+{
+    TreeMap *pMap;
+    if (TreeMapInit(&pMap) != SUCC)
+        return;
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx += 2)
+        pMap->put(pMap, &aPair[iIdx]);
+    RunWorkers("tree_map+rwlock", pMap, RunTreeMap, aPair, iNum, iOp, iThrd);
+
+    TreeMapDeinit(&pMap);
+}
+
+void BenchConcurrentTreeMap(Pair *aPair, int32_t iNum, int32_t iOp,
+                            int32_t iThrd)
+{
+    ConcurrentTreeMap *pMap;
+    if (ConcurrentTreeMapInit(&pMap) != SUCC)
+        return;
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx += 2)
+        pMap->put(pMap, &aPair[iIdx]);
+    RunWorkers("concurrent_tree_map", pMap, RunConcurrentTreeMap, aPair, iNum,
+               iOp, iThrd);
+
+    ConcurrentTreeMapDeinit(&pMap);
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iNum = (argc > 1)? atoi(argv[1]) : DEFAULT_NUM_PAIR;
+    int32_t iOp = (argc > 2)? atoi(argv[2]) : DEFAULT_NUM_OP;
+    if (iNum <= 0)
+        iNum = DEFAULT_NUM_PAIR;
+    if (iOp <= 0)
+        iOp = DEFAULT_NUM_OP;
+
+    /* The pairs are owned by the benchmark, so both maps keep the default
+       destroy method which leaves them untouched. */
+    Pair *aPair = (Pair*)malloc(sizeof(Pair) * iNum);
+    if (!aPair)
+        return ERR_NOMEM;
+
+    uint64_t ulState = 0x9e3779b97f4a7c15ull;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        aPair[iIdx].key = (void*)(uintptr_t)NextRandom(&ulState);
+        aPair[iIdx].value = (void*)(uintptr_t)iIdx;
+    }
+
+    printf("Run %d mixed operations over %d keys: %d%% put, %d%% remove, "
+           "%d%% scan of %d pairs, and the rest get\n", iOp, iNum, RATIO_PUT,
+           RATIO_REMOVE, RATIO_SCAN, LEN_SCAN);
+
+    int32_t iThrd;
+    for (iThrd = 1 ; iThrd <= MAX_NUM_THREAD ; iThrd <<= 1) {
+        BenchTreeMap(aPair, iNum, iOp, iThrd);
+        BenchConcurrentTreeMap(aPair, iNum, iOp, iThrd);
+    }
+
+    free(aPair);
+    return SUCC;
+}
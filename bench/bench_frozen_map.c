@@ -0,0 +1,106 @@
+#include "cds.h"
+#include <time.h>
+#include <unistd.h>
+
+
+#define DEFAULT_NUM_PAIR    (1 << 20)
+#define PATH_FROZEN         "/tmp/bench_frozen_map.frozen"
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+uint64_t NextRandom(uint64_t *pState)
+{
+    /* The xorshift64 generator keeps the benchmark input reproducible. */
+    uint64_t ulState = *pState;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    *pState = ulState;
+    return ulState;
+}
+
+void Report(const char *szMethod, const char *szOp, uint64_t ulNano,
+            int32_t iNum)
+{
+    printf("%-11s %-8s %10.3f ms %12.1f ns/op\n", szMethod, szOp,
+           (double)ulNano / 1e6, (double)ulNano / iNum);
+    return;
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iNum = (argc > 1)? atoi(argv[1]) : DEFAULT_NUM_PAIR;
+    if (iNum <= 0)
+        iNum = DEFAULT_NUM_PAIR;
+
+    intptr_t *aKey = (intptr_t*)malloc(sizeof(intptr_t) * iNum);
+    TreeMap *pTree = NULL;
+    FrozenMap *pMap = NULL;
+    if (!aKey || (TreeMapInit(&pTree) != SUCC) ||
+        (FrozenMapInit(&pMap) != SUCC)) {
+        free(aKey);
+        if (pTree)
+            TreeMapDeinit(&pTree);
+        return ERR_NOMEM;
+    }
+    pTree->set_pair_mode(pTree, TREE_MAP_PAIR_INTEGER);
+
+    uint64_t ulState = 0x9e3779b97f4a7c15ull;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        aKey[iIdx] = (intptr_t)(NextRandom(&ulState) >> 1);
+    printf("Build, freeze, and query %d random integer pairs\n", iNum);
+
+    /* Compare the cost to rebuild the tree with the cost to map the file. */
+    uint64_t ulBgn = NowNanoSecond();
+    Pair pair;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        pair.key = (void*)aKey[iIdx];
+        pair.value = (void*)aKey[iIdx];
+        pTree->put(pTree, &pair);
+    }
+    Report("tree_map", "build", NowNanoSecond() - ulBgn, iNum);
+
+    ulBgn = NowNanoSecond();
+    int32_t rc = FrozenMapFreeze(pTree, PATH_FROZEN, 0, 0);
+    Report("frozen_map", "freeze", NowNanoSecond() - ulBgn, iNum);
+    if (rc == SUCC) {
+        ulBgn = NowNanoSecond();
+        rc = pMap->open(pMap, PATH_FROZEN);
+        Report("frozen_map", "open", NowNanoSecond() - ulBgn, iNum);
+    }
+    if (rc != SUCC) {
+        printf("Fail to freeze the map into %s\n", PATH_FROZEN);
+        goto EXIT;
+    }
+
+    /* Both structures should find all the keys. */
+    Value value;
+    int32_t iTree = 0;
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        iTree += (pTree->get(pTree, (Key)aKey[iIdx], &value) == SUCC);
+    Report("tree_map", "get", NowNanoSecond() - ulBgn, iNum);
+
+    int32_t iFrozen = 0;
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        iFrozen += (pMap->get(pMap, (Key)aKey[iIdx], &value) == SUCC);
+    Report("frozen_map", "get", NowNanoSecond() - ulBgn, iNum);
+    if (iTree != iFrozen)
+        printf("tree_map finds %d keys but frozen_map %d\n", iTree, iFrozen);
+
+EXIT:
+    FrozenMapDeinit(&pMap);
+    TreeMapDeinit(&pTree);
+    unlink(PATH_FROZEN);
+    free(aKey);
+    return SUCC;
+}
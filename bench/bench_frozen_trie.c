@@ -0,0 +1,160 @@
+#include "cds.h"
+#include <time.h>
+#include <unistd.h>
+
+
+#define DEFAULT_NUM_STR     (1 << 18)
+#define SIZE_STR            (96)
+#define NUM_HOST            (512)
+#define NUM_PATH            (64)
+#define PATH_FROZEN         "/tmp/bench_frozen_trie.frozen"
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+uint64_t NextRandom(uint64_t *pState)
+{
+    /* The xorshift64 generator keeps the benchmark input reproducible. */
+    uint64_t ulState = *pState;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    *pState = ulState;
+    return ulState;
+}
+
+void Report(const char *szMethod, const char *szOp, uint64_t ulNano,
+            int32_t iNum)
+{
+    printf("%-8s %-10s %10.3f ms %10.1f ns/op\n", szMethod, szOp,
+           (double)ulNano / 1e6, (double)ulNano / iNum);
+    return;
+}
+
+void ReportStat(const char *szMethod, TrieStat *pStat, int32_t iNum)
+{
+    printf("%-8s %lld nodes, %.2f MB, %.1f bytes per string\n", szMethod,
+           (long long)pStat->lCountNode, (double)pStat->lCountByte / (1 << 20),
+           (double)pStat->lCountByte / iNum);
+    return;
+}
+
+void BenchQuery(const char *szMethod, void *pDict,
+                int32_t (*pExact) (void*, char*),
+                int32_t (*pPrefix) (void*, char*), char **aStr, int32_t iNum)
+{
+    int32_t iIdx, iFound = 0;
+    uint64_t ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        iFound += (pExact(pDict, aStr[iIdx]) == SUCC);
+    Report(szMethod, "has_exact", NowNanoSecond() - ulBgn, iNum);
+
+    /* Probe the host prefixes which are shared by many strings. */
+    int32_t iPrefix = 0;
+    char szPrefix[SIZE_STR];
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        strncpy(szPrefix, aStr[iIdx], 24);
+        szPrefix[24] = 0;
+        iPrefix += (pPrefix(pDict, szPrefix) == SUCC);
+    }
+    Report(szMethod, "has_prefix", NowNanoSecond() - ulBgn, iNum);
+
+    if ((iFound != iNum) || (iPrefix != iNum))
+        printf("%-8s misses %d strings and %d prefixes\n", szMethod,
+               iNum - iFound, iNum - iPrefix);
+    return;
+}
+
+int32_t TrieExact(void *pDict, char *str)
+{
+    return TrieHasExact((Trie*)pDict, str);
+}
+
+int32_t TriePrefix(void *pDict, char *str)
+{
+    return TrieHasPrefixAs((Trie*)pDict, str);
+}
+
+int32_t FrozenExact(void *pDict, char *str)
+{
+    return FrozenTrieHasExact((FrozenTrie*)pDict, str);
+}
+
+int32_t FrozenPrefix(void *pDict, char *str)
+{
+    return FrozenTrieHasPrefixAs((FrozenTrie*)pDict, str);
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iNum = (argc > 1)? atoi(argv[1]) : DEFAULT_NUM_STR;
+    if (iNum <= 0)
+        iNum = DEFAULT_NUM_STR;
+
+    char **aStr = (char**)malloc(sizeof(char*) * iNum);
+    char *aBuf = (char*)malloc(SIZE_STR * (size_t)iNum);
+    Trie *pTrie = NULL;
+    FrozenTrie *pFrozen = NULL;
+    if (!aStr || !aBuf || (TrieInit(&pTrie) != SUCC) ||
+        (FrozenTrieInit(&pFrozen) != SUCC)) {
+        free(aStr);
+        free(aBuf);
+        if (pTrie)
+            TrieDeinit(&pTrie);
+        return ERR_NOMEM;
+    }
+
+    /* Synthesize the URLs which share the scheme, the hosts, and the paths. */
+    uint64_t ulState = 0x9e3779b97f4a7c15ull;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        aStr[iIdx] = aBuf + (size_t)iIdx * SIZE_STR;
+        snprintf(aStr[iIdx], SIZE_STR, "https://www.host%03d.com/path%02d/%llx",
+                 (int32_t)(NextRandom(&ulState) % NUM_HOST),
+                 (int32_t)(NextRandom(&ulState) % NUM_PATH),
+                 (unsigned long long)(NextRandom(&ulState) >> 16));
+    }
+    printf("Build, freeze, and query %d synthetic URLs\n", iNum);
+
+    uint64_t ulBgn = NowNanoSecond();
+    pTrie->bulk_insert(pTrie, aStr, iNum);
+    Report("trie", "insert", NowNanoSecond() - ulBgn, iNum);
+
+    /* Compare the cost to freeze the trie with the cost to map the file. */
+    ulBgn = NowNanoSecond();
+    int32_t rc = FrozenTrieFreeze(pTrie, PATH_FROZEN);
+    Report("frozen", "freeze", NowNanoSecond() - ulBgn, iNum);
+    if (rc == SUCC) {
+        ulBgn = NowNanoSecond();
+        rc = pFrozen->open(pFrozen, PATH_FROZEN);
+        Report("frozen", "open", NowNanoSecond() - ulBgn, iNum);
+    }
+    if (rc != SUCC) {
+        printf("Fail to freeze the trie into %s\n", PATH_FROZEN);
+        goto EXIT;
+    }
+
+    BenchQuery("trie", pTrie, TrieExact, TriePrefix, aStr, iNum);
+    BenchQuery("frozen", pFrozen, FrozenExact, FrozenPrefix, aStr, iNum);
+
+    TrieStat stat;
+    pTrie->get_stat(pTrie, &stat);
+    ReportStat("trie", &stat, iNum);
+    pFrozen->get_stat(pFrozen, &stat);
+    ReportStat("frozen", &stat, iNum);
+
+EXIT:
+    FrozenTrieDeinit(&pFrozen);
+    TrieDeinit(&pTrie);
+    unlink(PATH_FROZEN);
+    free(aStr);
+    free(aBuf);
+    return SUCC;
+}
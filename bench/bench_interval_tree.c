@@ -0,0 +1,107 @@
+#include "cds.h"
+#include <time.h>
+
+
+#define DEFAULT_NUM_INTERVAL    (1 << 20)
+#define DEFAULT_NUM_QUERY       (1 << 12)
+#define RANGE_POINT             (1ll << 40)
+#define RANGE_SPAN              (1ll << 24)
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+uint64_t NextRandom(uint64_t *pState)
+{
+    /* The xorshift64 generator keeps the benchmark input reproducible. */
+    uint64_t ulState = *pState;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    *pState = ulState;
+    return ulState;
+}
+
+int32_t CountInterval(Interval *pInterval, void *pArg)
+{
+    (*(int64_t*)pArg)++;
+    return CONTINUE;
+}
+
+void Report(const char *szMethod, const char *szOp, uint64_t ulNano,
+            int32_t iNum)
+{
+    printf("%-14s %-8s %10.3f ms %12.1f ns/op\n", szMethod, szOp,
+           (double)ulNano / 1e6, (double)ulNano / iNum);
+    return;
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iNum = (argc > 1)? atoi(argv[1]) : DEFAULT_NUM_INTERVAL;
+    int32_t iQuery = (argc > 2)? atoi(argv[2]) : DEFAULT_NUM_QUERY;
+    if (iNum <= 0)
+        iNum = DEFAULT_NUM_INTERVAL;
+    if (iQuery <= 0)
+        iQuery = DEFAULT_NUM_QUERY;
+
+    Interval *aInterval = (Interval*)malloc(sizeof(Interval) * iNum);
+    int64_t *aPoint = (int64_t*)malloc(sizeof(int64_t) * iQuery);
+    IntervalTree *pTree = NULL;
+    if (!aInterval || !aPoint || (IntervalTreeInit(&pTree) != SUCC)) {
+        free(aInterval);
+        free(aPoint);
+        return ERR_NOMEM;
+    }
+
+    uint64_t ulState = 0x9e3779b97f4a7c15ull;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        aInterval[iIdx].lLow = NextRandom(&ulState) % RANGE_POINT;
+        aInterval[iIdx].lHigh = aInterval[iIdx].lLow +
+                                NextRandom(&ulState) % RANGE_SPAN;
+        aInterval[iIdx].value = (Value)(intptr_t)iIdx;
+    }
+    for (iIdx = 0 ; iIdx < iQuery ; iIdx++)
+        aPoint[iIdx] = NextRandom(&ulState) % RANGE_POINT;
+    printf("Put %d random intervals and stab %d random points\n", iNum, iQuery);
+
+    uint64_t ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        pTree->put(pTree, &aInterval[iIdx]);
+    Report("interval_tree", "put", NowNanoSecond() - ulBgn, iNum);
+
+    /* Both methods should report the same number of intervals. */
+    int64_t lTree = 0;
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iQuery ; iIdx++)
+        pTree->stab(pTree, aPoint[iIdx], CountInterval, &lTree);
+    Report("interval_tree", "stab", NowNanoSecond() - ulBgn, iQuery);
+
+    int64_t lScan = 0;
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iQuery ; iIdx++) {
+        int64_t lPoint = aPoint[iIdx];
+        int32_t iScan;
+        for (iScan = 0 ; iScan < iNum ; iScan++) {
+            if ((aInterval[iScan].lLow <= lPoint) &&
+                (aInterval[iScan].lHigh >= lPoint))
+                CountInterval(&aInterval[iScan], &lScan);
+        }
+    }
+    Report("linear_scan", "stab", NowNanoSecond() - ulBgn, iQuery);
+    if (lTree != lScan)
+        printf("interval_tree reports %lld intervals but linear_scan %lld\n",
+               (long long)lTree, (long long)lScan);
+    printf("%.2f intervals per point\n", (double)lTree / iQuery);
+
+    IntervalTreeDeinit(&pTree);
+    free(aInterval);
+    free(aPoint);
+    return SUCC;
+}
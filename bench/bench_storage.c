@@ -0,0 +1,155 @@
+#include "cds.h"
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+
+#define DEFAULT_SIZE_MB     (512)
+#define DEFAULT_PATH        "/tmp/bench_storage.spill"
+#define SIZE_PAGE           (4096)
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+int32_t OpenTlbCounter()
+{
+#ifdef __linux__
+    /* Count the data TLB read misses of the calling thread in user space. */
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int32_t)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+void StartCounter(int32_t iFd)
+{
+#ifdef __linux__
+    if (iFd >= 0) {
+        ioctl(iFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(iFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+int64_t StopCounter(int32_t iFd)
+{
+#ifdef __linux__
+    uint64_t ulCount;
+    if (iFd >= 0) {
+        ioctl(iFd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(iFd, &ulCount, sizeof(ulCount)) == sizeof(ulCount))
+            return (int64_t)ulCount;
+    }
+#endif
+    return -1;
+}
+
+void Report(const char *szMode, const char *szScan, uint64_t ulNano,
+            int64_t lMiss, size_t ulSize)
+{
+    double dSec = (double)ulNano / 1e9;
+    printf("%-10s %-10s %10.3f ms %8.2f GB/s", szMode, szScan, dSec * 1e3,
+           (double)ulSize / dSec / 1e9);
+    if (lMiss >= 0)
+        printf(" %14lld dTLB misses\n", (long long)lMiss);
+    else
+        printf(" %14s dTLB misses\n", "n/a");
+}
+
+void RunScan(const char *szMode, int32_t iMode, const char *szPath,
+             size_t ulSize, int32_t iFd)
+{
+    Storage store;
+    if ((StorageInit(&store, iMode, szPath) != SUCC) ||
+        (StorageResize(&store, ulSize) != SUCC)) {
+        printf("%-10s unavailable\n", szMode);
+        return;
+    }
+
+    /* Touch all the pages before the measurement. */
+    uint64_t *aWord = (uint64_t*)store.pBase;
+    size_t ulNum = ulSize / sizeof(uint64_t);
+    size_t ulIdx;
+    for (ulIdx = 0 ; ulIdx < ulNum ; ulIdx++)
+        aWord[ulIdx] = ulIdx;
+
+    /* Scan all the words sequentially. */
+    volatile uint64_t ulSink;
+    uint64_t ulSum = 0;
+    StartCounter(iFd);
+    uint64_t ulBgn = NowNanoSecond();
+    for (ulIdx = 0 ; ulIdx < ulNum ; ulIdx++)
+        ulSum += aWord[ulIdx];
+    uint64_t ulNano = NowNanoSecond() - ulBgn;
+    Report(szMode, "sequential", ulNano, StopCounter(iFd), ulSize);
+    ulSink = ulSum;
+
+    /* Visit one word per page in a scattered order to stress the TLB. */
+    size_t ulPage = ulSize / SIZE_PAGE;
+    size_t ulStep = 7919;
+    while ((ulPage % ulStep) == 0)
+        ulStep += 2;
+    size_t ulWordPerPage = SIZE_PAGE / sizeof(uint64_t);
+    size_t ulRound = 8;
+    ulSum = 0;
+    StartCounter(iFd);
+    ulBgn = NowNanoSecond();
+    size_t ulCount, ulPos = 0, ulRun;
+    for (ulRun = 0 ; ulRun < ulRound ; ulRun++) {
+        for (ulCount = 0 ; ulCount < ulPage ; ulCount++) {
+            ulSum += aWord[ulPos * ulWordPerPage + ulRun];
+            ulPos += ulStep;
+            if (ulPos >= ulPage)
+                ulPos -= ulPage;
+        }
+    }
+    ulNano = NowNanoSecond() - ulBgn;
+    Report(szMode, "scattered", ulNano, StopCounter(iFd),
+           ulPage * ulRound * sizeof(uint64_t));
+    ulSink = ulSum;
+    (void)ulSink;
+
+    StorageDeinit(&store);
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iSizeMb = (argc > 1)? atoi(argv[1]) : DEFAULT_SIZE_MB;
+    const char *szPath = (argc > 2)? argv[2] : DEFAULT_PATH;
+    if (iSizeMb <= 0)
+        iSizeMb = DEFAULT_SIZE_MB;
+    size_t ulSize = (size_t)iSizeMb << 20;
+
+    int32_t iFd = OpenTlbCounter();
+    printf("Scan %d MB per storage mode\n", iSizeMb);
+    if (iFd < 0)
+        printf("The dTLB miss counter is not available\n");
+
+    RunScan("heap", STORAGE_HEAP, NULL, ulSize, iFd);
+    RunScan("huge_page", STORAGE_HUGE_PAGE, NULL, ulSize, iFd);
+    RunScan("file", STORAGE_FILE, szPath, ulSize, iFd);
+
+    if (iFd >= 0)
+        close(iFd);
+    return SUCC;
+}
@@ -0,0 +1,186 @@
+#include "cds.h"
+#include <time.h>
+
+
+#define DEFAULT_NUM_STR     (1 << 18)
+#define SIZE_STR            (96)
+#define NUM_HOST            (512)
+#define NUM_PATH            (64)
+#define NUM_ENUM            (1024)
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+uint64_t NextRandom(uint64_t *pState)
+{
+    /* The xorshift64 generator keeps the benchmark input reproducible. */
+    uint64_t ulState = *pState;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    *pState = ulState;
+    return ulState;
+}
+
+void Report(const char *szMethod, const char *szOp, uint64_t ulNano,
+            int32_t iNum)
+{
+    printf("%-8s %-10s %10.3f ms %10.1f ns/op\n", szMethod, szOp,
+           (double)ulNano / 1e6, (double)ulNano / iNum);
+    return;
+}
+
+void ReportStat(const char *szMethod, TrieStat *pStat, int32_t iNum)
+{
+    printf("%-8s %lld nodes, %.2f MB, %.1f bytes per string, "
+           "%.1f bits per node\n", szMethod, (long long)pStat->lCountNode,
+           (double)pStat->lCountByte / (1 << 20),
+           (double)pStat->lCountByte / iNum,
+           (double)pStat->lCountByte * 8 / pStat->lCountNode);
+    return;
+}
+
+void BenchQuery(const char *szMethod, void *pDict,
+                int32_t (*pExact) (void*, char*),
+                int32_t (*pPrefix) (void*, char*),
+                int32_t (*pEnum) (void*, char*, char***, int*),
+                char **aStr, int32_t iNum)
+{
+    int32_t iIdx, iFound = 0;
+    uint64_t ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        iFound += (pExact(pDict, aStr[iIdx]) == SUCC);
+    Report(szMethod, "has_exact", NowNanoSecond() - ulBgn, iNum);
+
+    /* Probe the host prefixes which are shared by many strings. */
+    int32_t iPrefix = 0;
+    char szPrefix[SIZE_STR];
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        strncpy(szPrefix, aStr[iIdx], 24);
+        szPrefix[24] = 0;
+        iPrefix += (pPrefix(pDict, szPrefix) == SUCC);
+    }
+    Report(szMethod, "has_prefix", NowNanoSecond() - ulBgn, iNum);
+
+    /* Enumerate the strings under the host and path prefixes. */
+    int32_t iEnum = 0, iRound = (iNum < NUM_ENUM)? iNum : NUM_ENUM;
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iRound ; iIdx++) {
+        strncpy(szPrefix, aStr[iIdx], 31);
+        szPrefix[31] = 0;
+        char **aGet;
+        int iGet;
+        if (pEnum(pDict, szPrefix, &aGet, &iGet) != SUCC)
+            continue;
+        int32_t iOrd;
+        for (iOrd = 0 ; iOrd < iGet ; iOrd++)
+            free(aGet[iOrd]);
+        free(aGet);
+        iEnum += iGet;
+    }
+    Report(szMethod, "get_prefix", NowNanoSecond() - ulBgn, iRound);
+
+    if ((iFound != iNum) || (iPrefix != iNum))
+        printf("%-8s misses %d strings and %d prefixes\n", szMethod,
+               iNum - iFound, iNum - iPrefix);
+    printf("%-8s enumerates %d strings\n", szMethod, iEnum);
+    return;
+}
+
+int32_t TrieExact(void *pDict, char *str)
+{
+    return TrieHasExact((Trie*)pDict, str);
+}
+
+int32_t TriePrefix(void *pDict, char *str)
+{
+    return TrieHasPrefixAs((Trie*)pDict, str);
+}
+
+int32_t TrieEnum(void *pDict, char *str, char ***paStr, int *piNum)
+{
+    return TrieGetPrefixAs((Trie*)pDict, str, paStr, piNum);
+}
+
+int32_t SuccinctExact(void *pDict, char *str)
+{
+    return SuccinctTrieHasExact((SuccinctTrie*)pDict, str);
+}
+
+int32_t SuccinctPrefix(void *pDict, char *str)
+{
+    return SuccinctTrieHasPrefixAs((SuccinctTrie*)pDict, str);
+}
+
+int32_t SuccinctEnum(void *pDict, char *str, char ***paStr, int *piNum)
+{
+    return SuccinctTrieGetPrefixAs((SuccinctTrie*)pDict, str, paStr, piNum);
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iNum = (argc > 1)? atoi(argv[1]) : DEFAULT_NUM_STR;
+    if (iNum <= 0)
+        iNum = DEFAULT_NUM_STR;
+
+    char **aStr = (char**)malloc(sizeof(char*) * iNum);
+    char *aBuf = (char*)malloc(SIZE_STR * (size_t)iNum);
+    Trie *pTrie = NULL;
+    SuccinctTrie *pSuccinct = NULL;
+    if (!aStr || !aBuf || (TrieInit(&pTrie) != SUCC) ||
+        (SuccinctTrieInit(&pSuccinct) != SUCC)) {
+        free(aStr);
+        free(aBuf);
+        if (pTrie)
+            TrieDeinit(&pTrie);
+        return ERR_NOMEM;
+    }
+
+    /* Synthesize the URLs which share the scheme, the hosts, and the paths. */
+    uint64_t ulState = 0x9e3779b97f4a7c15ull;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        aStr[iIdx] = aBuf + (size_t)iIdx * SIZE_STR;
+        snprintf(aStr[iIdx], SIZE_STR, "https://www.host%03d.com/path%02d/%llx",
+                 (int32_t)(NextRandom(&ulState) % NUM_HOST),
+                 (int32_t)(NextRandom(&ulState) % NUM_PATH),
+                 (unsigned long long)(NextRandom(&ulState) >> 16));
+    }
+    printf("Build and query %d synthetic URLs\n", iNum);
+
+    uint64_t ulBgn = NowNanoSecond();
+    pTrie->bulk_insert(pTrie, aStr, iNum);
+    Report("trie", "insert", NowNanoSecond() - ulBgn, iNum);
+
+    ulBgn = NowNanoSecond();
+    int32_t rc = pSuccinct->build(pSuccinct, pTrie);
+    Report("succinct", "build", NowNanoSecond() - ulBgn, iNum);
+    if (rc != SUCC) {
+        printf("Fail to encode the trie\n");
+        goto EXIT;
+    }
+
+    BenchQuery("trie", pTrie, TrieExact, TriePrefix, TrieEnum, aStr, iNum);
+    BenchQuery("succinct", pSuccinct, SuccinctExact, SuccinctPrefix,
+               SuccinctEnum, aStr, iNum);
+
+    TrieStat stat;
+    pTrie->get_stat(pTrie, &stat);
+    ReportStat("trie", &stat, iNum);
+    pSuccinct->get_stat(pSuccinct, &stat);
+    ReportStat("succinct", &stat, iNum);
+
+EXIT:
+    SuccinctTrieDeinit(&pSuccinct);
+    TrieDeinit(&pTrie);
+    free(aStr);
+    free(aBuf);
+    return SUCC;
+}
@@ -0,0 +1,114 @@
+#include "cds.h"
+#include <time.h>
+
+
+#define DEFAULT_NUM_STR     (1 << 18)
+#define SIZE_STR            (96)
+#define NUM_HOST            (512)
+#define NUM_PATH            (64)
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+uint64_t NextRandom(uint64_t *pState)
+{
+    /* The xorshift64 generator keeps the benchmark input reproducible. */
+    uint64_t ulState = *pState;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    *pState = ulState;
+    return ulState;
+}
+
+void Report(const char *szMethod, const char *szOp, uint64_t ulNano,
+            int32_t iNum)
+{
+    printf("%-8s %-10s %10.3f ms %10.1f ns/op\n", szMethod, szOp,
+           (double)ulNano / 1e6, (double)ulNano / iNum);
+    return;
+}
+
+void BenchTrie(const char *szMethod, int32_t iMode, char **aStr, int32_t iNum)
+{
+    Trie *pTrie;
+    if (TrieInit(&pTrie) != SUCC)
+        return;
+    if (pTrie->set_mode(pTrie, iMode) != SUCC) {
+        TrieDeinit(&pTrie);
+        return;
+    }
+
+    uint64_t ulBgn = NowNanoSecond();
+    pTrie->bulk_insert(pTrie, aStr, iNum);
+    Report(szMethod, "insert", NowNanoSecond() - ulBgn, iNum);
+
+    int32_t iIdx, iFound = 0;
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        iFound += (pTrie->has_exact(pTrie, aStr[iIdx]) == SUCC);
+    Report(szMethod, "has_exact", NowNanoSecond() - ulBgn, iNum);
+
+    /* Probe the host prefixes which are shared by many strings. */
+    int32_t iPrefix = 0;
+    char szPrefix[SIZE_STR];
+    ulBgn = NowNanoSecond();
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        strncpy(szPrefix, aStr[iIdx], 24);
+        szPrefix[24] = 0;
+        iPrefix += (pTrie->has_prefix_as(pTrie, szPrefix) == SUCC);
+    }
+    Report(szMethod, "has_prefix", NowNanoSecond() - ulBgn, iNum);
+
+    TrieStat stat;
+    pTrie->get_stat(pTrie, &stat);
+    printf("%-8s %lld nodes, %.2f MB, %.1f bytes per string\n", szMethod,
+           (long long)stat.lCountNode, (double)stat.lCountByte / (1 << 20),
+           (double)stat.lCountByte / pTrie->size(pTrie));
+    if ((iFound != iNum) || (iPrefix != iNum))
+        printf("%-8s misses %d strings and %d prefixes\n", szMethod,
+               iNum - iFound, iNum - iPrefix);
+
+    TrieDeinit(&pTrie);
+    return;
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iNum = (argc > 1)? atoi(argv[1]) : DEFAULT_NUM_STR;
+    if (iNum <= 0)
+        iNum = DEFAULT_NUM_STR;
+
+    char **aStr = (char**)malloc(sizeof(char*) * iNum);
+    char *aBuf = (char*)malloc(SIZE_STR * (size_t)iNum);
+    if (!aStr || !aBuf) {
+        free(aStr);
+        free(aBuf);
+        return ERR_NOMEM;
+    }
+
+    /* Synthesize the URLs which share the scheme, the hosts, and the paths. */
+    uint64_t ulState = 0x9e3779b97f4a7c15ull;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        aStr[iIdx] = aBuf + (size_t)iIdx * SIZE_STR;
+        snprintf(aStr[iIdx], SIZE_STR, "https://www.host%03d.com/path%02d/%llx",
+                 (int32_t)(NextRandom(&ulState) % NUM_HOST),
+                 (int32_t)(NextRandom(&ulState) % NUM_PATH),
+                 (unsigned long long)(NextRandom(&ulState) >> 16));
+    }
+    printf("Insert and search %d synthetic URLs\n", iNum);
+
+    BenchTrie("ternary", TRIE_MODE_TERNARY, aStr, iNum);
+    BenchTrie("radix", TRIE_MODE_RADIX, aStr, iNum);
+
+    free(aStr);
+    free(aBuf);
+    return SUCC;
+}
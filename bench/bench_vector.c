@@ -0,0 +1,134 @@
+#include "cds.h"
+#include <time.h>
+
+
+#define DEFAULT_NUM_ITEM    (1 << 22)
+#define DEFAULT_NUM_THREAD  (0)
+#define DEFAULT_NUM_TOP     (100)
+
+
+uint64_t NowNanoSecond()
+{
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (uint64_t)spec.tv_sec * 1000000000ull + spec.tv_nsec;
+}
+
+uint64_t NextRandom(uint64_t *pState)
+{
+    /* The xorshift64 generator keeps the benchmark input reproducible. */
+    uint64_t ulState = *pState;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    *pState = ulState;
+    return ulState;
+}
+
+int32_t CompareItem(const void *ppSrc, const void *ppTge)
+{
+    uintptr_t ulSrc = (uintptr_t)*((Item*)ppSrc);
+    uintptr_t ulTge = (uintptr_t)*((Item*)ppTge);
+    if (ulSrc == ulTge)
+        return 0;
+    return (ulSrc > ulTge)? 1 : (-1);
+}
+
+uint64_t ExtractKey(Item item)
+{
+    return (uint64_t)(uintptr_t)item;
+}
+
+int32_t PrepareVector(Vector *pVec, int32_t iNum)
+{
+    uint64_t ulState = 0x9e3779b97f4a7c15ull;
+    while (pVec->size(pVec) > 0)
+        pVec->pop_back(pVec);
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        uintptr_t ulItem = (uintptr_t)(NextRandom(&ulState) >> 32);
+        int32_t rc = pVec->push_back(pVec, (Item)ulItem);
+        if (rc != SUCC)
+            return rc;
+    }
+    return SUCC;
+}
+
+bool CheckOrder(Vector *pVec)
+{
+    Item item, itemPrev = NULL;
+    pVec->iterate(pVec, true, NULL);
+    while (pVec->iterate(pVec, false, &item) != END) {
+        if ((uintptr_t)itemPrev > (uintptr_t)item)
+            return false;
+        itemPrev = item;
+    }
+    return true;
+}
+
+void Report(const char *szName, int32_t iNum, uint64_t ulNano, bool bOrder)
+{
+    double dSec = (double)ulNano / 1e9;
+    printf("%-16s %10.3f ms %12.0f items/s %s\n", szName, dSec * 1e3,
+           (double)iNum / dSec, bOrder? "" : "(UNSORTED)");
+}
+
+
+int main(int argc, char **argv)
+{
+    int32_t iNum = (argc > 1)? atoi(argv[1]) : DEFAULT_NUM_ITEM;
+    int32_t iThread = (argc > 2)? atoi(argv[2]) : DEFAULT_NUM_THREAD;
+    if (iNum <= 0)
+        iNum = DEFAULT_NUM_ITEM;
+
+    Vector *pVec;
+    int32_t rc = VectorInit(&pVec, iNum);
+    if (rc != SUCC)
+        return rc;
+
+    printf("Sort %d items, thread setting %d\n", iNum, iThread);
+
+    PrepareVector(pVec, iNum);
+    uint64_t ulBgn = NowNanoSecond();
+    pVec->sort(pVec, CompareItem);
+    Report("qsort", iNum, NowNanoSecond() - ulBgn, CheckOrder(pVec));
+
+    PrepareVector(pVec, iNum);
+    ulBgn = NowNanoSecond();
+    pVec->stable_sort(pVec, CompareItem);
+    Report("stable_sort", iNum, NowNanoSecond() - ulBgn, CheckOrder(pVec));
+
+    PrepareVector(pVec, iNum);
+    ulBgn = NowNanoSecond();
+    pVec->parallel_sort(pVec, CompareItem, iThread);
+    Report("parallel_sort", iNum, NowNanoSecond() - ulBgn, CheckOrder(pVec));
+
+    PrepareVector(pVec, iNum);
+    ulBgn = NowNanoSecond();
+    pVec->radix_sort(pVec, ExtractKey, sizeof(uint32_t));
+    Report("radix_sort", iNum, NowNanoSecond() - ulBgn, CheckOrder(pVec));
+
+    /* Select only the leading items instead of sorting all of them. */
+    printf("Select the top %d of %d items\n", DEFAULT_NUM_TOP, iNum);
+    int32_t iTop = (iNum < DEFAULT_NUM_TOP)? iNum : DEFAULT_NUM_TOP;
+
+    PrepareVector(pVec, iNum);
+    ulBgn = NowNanoSecond();
+    pVec->nth_element(pVec, iTop - 1, CompareItem);
+    Report("nth_element", iNum, NowNanoSecond() - ulBgn, true);
+
+    PrepareVector(pVec, iNum);
+    ulBgn = NowNanoSecond();
+    pVec->partial_sort(pVec, iTop, CompareItem);
+    Report("partial_sort", iNum, NowNanoSecond() - ulBgn, true);
+
+    Item aTop[DEFAULT_NUM_TOP];
+    PrepareVector(pVec, iNum);
+    ulBgn = NowNanoSecond();
+    pVec->top_k(pVec, iTop, CompareItem, aTop);
+    Report("top_k", iNum, NowNanoSecond() - ulBgn, true);
+
+    VectorDeinit(&pVec);
+    return SUCC;
+}
@@ -0,0 +1,76 @@
+#include "cds.h"
+
+
+void CleanEntry(ArtEntry *pEntry)
+{
+    free((int32_t*)pEntry->value);
+    return;
+}
+
+
+int main()
+{
+    ArtMap *pMap;
+
+    /* You should initialize the DS before any operations. */
+    int32_t rc = ArtMapInit(&pMap);
+    if (rc != SUCC)
+        return rc;
+
+    /* Let the map release the values, while the keys are always owned by it. */
+    pMap->set_destroy(pMap, CleanEntry);
+
+    /* Map the routes to the handler ids. The keys are the raw bytes, so a
+       route can be the prefix of another one. */
+    char *aRoute[6];
+    aRoute[0] = "/api";
+    aRoute[1] = "/api/users";
+    aRoute[2] = "/api/users/42";
+    aRoute[3] = "/api/orders";
+    aRoute[4] = "/static/app.js";
+    aRoute[5] = "/static/app.css";
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 6 ; iIdx++) {
+        int32_t *pId = (int32_t*)malloc(sizeof(int32_t));
+        if (!pId)
+            break;
+        *pId = iIdx;
+        pMap->put(pMap, (Key)aRoute[iIdx], strlen(aRoute[iIdx]), (Value)pId);
+    }
+    assert(pMap->size(pMap) == 6);
+
+    /* Retrieve the value with the designated key. */
+    Value value;
+    pMap->get(pMap, (Key)"/api/users", 10, &value);
+    assert(*(int32_t*)value == 1);
+    assert(pMap->find(pMap, (Key)"/api/user", 9) == NOKEY);
+
+    /* The entries are ordered by memcmp, and a key goes before the keys it
+       prefixes. */
+    ArtEntry *pEntry;
+    pMap->minimum(pMap, &pEntry);
+    assert(pEntry->iSize == 4);
+    pMap->maximum(pMap, &pEntry);
+    assert(memcmp(pEntry->key, aRoute[4], pEntry->iSize) == 0);
+
+    /* Scan the routes under "/api/users" without visiting the others. */
+    int32_t iNum = 0;
+    pMap->iterate_prefix(pMap, true, (Key)"/api/users", 10, NULL);
+    while (pMap->iterate_prefix(pMap, false, NULL, 0, &pEntry) == CONTINUE)
+        iNum++;
+    assert(iNum == 2);
+
+    /* Delete the entry and the clean method releases its value. */
+    pMap->remove(pMap, (Key)"/static/app.css", 15);
+    iNum = 0;
+    pMap->iterate(pMap, true, NULL);
+    while (pMap->iterate(pMap, false, &pEntry) == CONTINUE)
+        iNum++;
+    assert(iNum == 5);
+
+    /* You should deinitialize the DS after all the relevant tasks. */
+    ArtMapDeinit(&pMap);
+
+    return SUCC;
+}
@@ -0,0 +1,82 @@
+#include "cds.h"
+#include <pthread.h>
+
+
+#define COUNT_KEY       (100)
+
+
+void DestroyPair(Pair *pPair)
+{
+    free(pPair);
+}
+
+void* ReadRoutine(void *pArg)
+{
+    ConcurrentTreeMap *pMap = (ConcurrentTreeMap*)pArg;
+
+    /* The readers never block, even when a writer is active. */
+    Value value;
+    if (pMap->get(pMap, (Key)(intptr_t)1, &value) == SUCC)
+        assert((intptr_t)value == 1);
+
+    /* Open a view to see one consistent version across several reads. */
+    Pair *pPair;
+    ConcurrentTreeMapView view;
+    pMap->view_open(pMap, &view);
+    intptr_t iCount = 0;
+    pMap->view_iterate(pMap, &view, true, NULL);
+    while (pMap->view_iterate(pMap, &view, false, &pPair) == SUCC)
+        iCount++;
+    pMap->view_close(pMap, &view);
+    return (void*)iCount;
+}
+
+int main()
+{
+    ConcurrentTreeMap *pMap;
+
+    /* You should initialize the DS before any operations. */
+    int32_t rc = ConcurrentTreeMapInit(&pMap);
+    if (rc != SUCC)
+        return rc;
+
+    /* The custom methods should be set before sharing the map. The replaced
+       and removed pairs are cleaned after no reader can see them. */
+    pMap->set_destroy(pMap, DestroyPair);
+
+    /* Insert key value pairs while another thread reads the map. */
+    pthread_t thrd;
+    pthread_create(&thrd, NULL, ReadRoutine, pMap);
+    intptr_t iKey;
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey++) {
+        Pair *pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = (void*)iKey;
+        pPair->value = (void*)iKey;
+        pMap->put(pMap, pPair);
+    }
+    void *pCount;
+    pthread_join(thrd, &pCount);
+    assert((intptr_t)pCount <= COUNT_KEY);
+
+    /* Scan the pairs starting from the designated key. */
+    Pair *pPair;
+    ConcurrentTreeMapView view;
+    pMap->view_open(pMap, &view);
+    pMap->view_seek(pMap, &view, (Key)(intptr_t)(COUNT_KEY - 1));
+    pMap->view_iterate(pMap, &view, false, &pPair);
+    assert((intptr_t)pPair->key == COUNT_KEY - 1);
+    pMap->view_iterate(pMap, &view, false, &pPair);
+    assert((intptr_t)pPair->key == COUNT_KEY);
+    assert(pMap->view_iterate(pMap, &view, false, &pPair) == END);
+    pMap->view_close(pMap, &view);
+
+    /* Remove the key value pair with the designated key. */
+    pMap->remove(pMap, (Key)(intptr_t)1);
+    assert(pMap->find(pMap, (Key)(intptr_t)1) == NOKEY);
+    assert(pMap->size(pMap) == COUNT_KEY - 1);
+
+    /* You should deinitialize the DS after all the relevant tasks. */
+    ConcurrentTreeMapDeinit(&pMap);
+
+    return SUCC;
+}
@@ -0,0 +1,115 @@
+#include "cds.h"
+
+
+typedef struct Employ_ {
+    int8_t cYear;
+    int8_t cLevel;
+    int32_t iId;
+} Employ;
+
+
+int32_t CompareKey(Key keySrc, Key keyTge)
+{
+    char *nameSrc = (char*)keySrc;
+    char *nameTge = (char*)keyTge;
+
+    int32_t iOrder = strcmp(nameSrc, nameTge);
+    if (iOrder == 0)
+        return 0;
+    return (iOrder > 0)? 1 : (-1);
+}
+
+void DestroyPair(Pair *pPair)
+{
+    /* The pair structure is stored inside the map, so only the value should be
+       released here. */
+    free((Employ*)pPair->value);
+}
+
+Employ* CreateEmploy(int32_t iId, int8_t cLevel)
+{
+    Employ *pEmploy = (Employ*)malloc(sizeof(Employ));
+    pEmploy->iId = iId;
+    pEmploy->cYear = 25;
+    pEmploy->cLevel = cLevel;
+    return pEmploy;
+}
+
+int main()
+{
+    char *aName[4] = {"Alice\0", "Bob\0", "Claire\0", "Wesker\0"};
+    FlatMap *pMap;
+
+    /* You should initialize the DS before any operations. */
+    int32_t rc = FlatMapInit(&pMap);
+    if (rc != SUCC)
+        return rc;
+
+    /* You should specify how to compare your keys. */
+    pMap->set_compare(pMap, CompareKey);
+
+    /* If you plan to delegate the resource clean task to the DS, please set the
+       custom clean method. */
+    pMap->set_destroy(pMap, DestroyPair);
+
+    /* Build the map from the unsorted pairs in one shot. The pairs are copied
+       into the map, so the array can be discarded afterward. */
+    Pair aPair[3];
+    aPair[0].key = aName[3];
+    aPair[0].value = CreateEmploy(4, 70);
+    aPair[1].key = aName[0];
+    aPair[1].value = CreateEmploy(1, 100);
+    aPair[2].key = aName[2];
+    aPair[2].value = CreateEmploy(3, 80);
+    pMap->build(pMap, aPair, 3);
+
+    /* Insert a single pair. */
+    Pair pair;
+    pair.key = aName[1];
+    pair.value = CreateEmploy(2, 90);
+    pMap->put(pMap, &pair);
+
+    /* Insert a batch of pairs with a single merge. The existing key is
+       replaced and its old value is released by the clean method. */
+    aPair[0].key = aName[3];
+    aPair[0].value = CreateEmploy(4, 75);
+    pMap->put_batch(pMap, aPair, 1);
+
+    /* Retrieve the value with the designated key. */
+    Value value;
+    pMap->get(pMap, (Key)aName[0], &value);
+    assert(((Employ*)value)->iId == 1);
+    pMap->get(pMap, (Key)aName[3], &value);
+    assert(((Employ*)value)->cLevel == 75);
+
+    /* Retrieve the pairs with minimum and maximum key orders from the map. */
+    Pair *pPair;
+    pMap->minimum(pMap, &pPair);
+    assert(strcmp((char*)pPair->key, aName[0]) == 0);
+    pMap->maximum(pMap, &pPair);
+    assert(strcmp((char*)pPair->key, aName[3]) == 0);
+
+    /* Reference the predecessor and successor pairs with the designated key. */
+    pMap->predecessor(pMap, (Key)aName[1], &pPair);
+    assert(strcmp((char*)pPair->key, aName[0]) == 0);
+    pMap->successor(pMap, (Key)aName[1], &pPair);
+    assert(strcmp((char*)pPair->key, aName[2]) == 0);
+
+    /* Iterate through the map in key order. */
+    int32_t idx = 0;
+    pMap->iterate(pMap, true, NULL);
+    while (pMap->iterate(pMap, false, &pPair) != END) {
+        assert(strcmp((char*)pPair->key, aName[idx]) == 0);
+        idx++;
+    }
+
+    /* Remove the key value pair with the designated key. */
+    pMap->remove(pMap, (Key)aName[1]);
+    assert(pMap->find(pMap, (Key)aName[1]) == NOKEY);
+    assert(pMap->size(pMap) == 3);
+
+    /* You should deinitialize the DS after all the relevant tasks. */
+    FlatMapDeinit(&pMap);
+
+    return SUCC;
+}
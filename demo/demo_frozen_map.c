@@ -0,0 +1,66 @@
+#include "cds.h"
+#include <unistd.h>
+
+
+#define PATH_FROZEN     "/tmp/demo_frozen_map.frozen"
+
+
+int main()
+{
+    TreeMap *pTree;
+
+    /* Build the content with TreeMap first. */
+    int32_t rc = TreeMapInit(&pTree);
+    if (rc != SUCC)
+        return rc;
+    pTree->set_pair_mode(pTree, TREE_MAP_PAIR_INLINE);
+
+    Pair pair;
+    intptr_t iPort;
+    for (iPort = 8000 ; iPort < 8100 ; iPort += 10) {
+        pair.key = (void*)iPort;
+        pair.value = (void*)(iPort - 8000);
+        pTree->put(pTree, &pair);
+    }
+
+    /* Freeze the integer keys and values into the file. */
+    rc = FrozenMapFreeze(pTree, PATH_FROZEN, 0, 0);
+    TreeMapDeinit(&pTree);
+    if (rc != SUCC)
+        return rc;
+
+    /* Any process can map the file and query it without the rebuild. */
+    FrozenMap *pMap;
+    rc = FrozenMapInit(&pMap);
+    if (rc != SUCC)
+        return rc;
+    rc = pMap->open(pMap, PATH_FROZEN);
+    if (rc != SUCC) {
+        FrozenMapDeinit(&pMap);
+        return rc;
+    }
+    assert(pMap->size(pMap) == 10);
+
+    Value value;
+    pMap->get(pMap, (Key)8030, &value);
+    assert(value == (Value)30);
+    assert(pMap->find(pMap, (Key)8031) == NOKEY);
+
+    /* The returned pair is overwritten by the next query. */
+    Pair *pPair;
+    pMap->lower_bound(pMap, (Key)8031, &pPair);
+    assert(pPair->key == (Key)8040);
+
+    /* Scan the ports within [8020, 8050). */
+    int32_t iNum = 0;
+    pMap->iterate_range(pMap, true, (Key)8020, (Key)8050, NULL);
+    while (pMap->iterate_range(pMap, false, NULL, NULL, &pPair) == SUCC)
+        iNum++;
+    assert(iNum == 3);
+
+    /* You should deinitialize the DS after all the relevant tasks. */
+    FrozenMapDeinit(&pMap);
+    unlink(PATH_FROZEN);
+
+    return SUCC;
+}
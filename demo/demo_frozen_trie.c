@@ -0,0 +1,68 @@
+#include "cds.h"
+#include <unistd.h>
+
+
+#define PATH_FROZEN     "/tmp/demo_frozen_trie.frozen"
+
+
+int main()
+{
+    Trie *pTrie;
+
+    /* Build the dictionary with Trie first. */
+    int32_t rc = TrieInit(&pTrie);
+    if (rc != SUCC)
+        return rc;
+
+    char *aWord[6];
+    aWord[0] = "token";
+    aWord[1] = "tokenize";
+    aWord[2] = "tokenizer";
+    aWord[3] = "toke";
+    aWord[4] = "type";
+    aWord[5] = "typeset";
+    pTrie->bulk_insert(pTrie, aWord, 6);
+
+    /* Freeze the strings into the double array file. */
+    rc = FrozenTrieFreeze(pTrie, PATH_FROZEN);
+    TrieDeinit(&pTrie);
+    if (rc != SUCC)
+        return rc;
+
+    /* Any process can map the file and query it without the rebuild. */
+    FrozenTrie *pFrozen;
+    rc = FrozenTrieInit(&pFrozen);
+    if (rc != SUCC)
+        return rc;
+    rc = pFrozen->open(pFrozen, PATH_FROZEN);
+    if (rc != SUCC) {
+        FrozenTrieDeinit(&pFrozen);
+        return rc;
+    }
+    assert(pFrozen->size(pFrozen) == 6);
+
+    /* Check for exact string and prefix. */
+    assert(pFrozen->has_exact(pFrozen, "tokenize") == SUCC);
+    assert(pFrozen->has_exact(pFrozen, "tok") == NOKEY);
+    assert(pFrozen->has_prefix_as(pFrozen, "tok") == SUCC);
+    assert(pFrozen->has_prefix_as(pFrozen, "tap") == NOKEY);
+
+    /* Get the sorted array of strings matching the designated prefix. */
+    char **aStr;
+    int32_t iSizeArr;
+    pFrozen->get_prefix_as(pFrozen, "token", &aStr, &iSizeArr);
+    assert(iSizeArr == 3);
+    assert(strcmp(aStr[0], "token") == 0);
+    assert(strcmp(aStr[2], "tokenizer") == 0);
+
+    /* Remember to free the returned array of strings. */
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iSizeArr ; ++iIdx)
+        free(aStr[iIdx]);
+    free(aStr);
+
+    FrozenTrieDeinit(&pFrozen);
+    unlink(PATH_FROZEN);
+
+    return SUCC;
+}
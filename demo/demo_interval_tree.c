@@ -0,0 +1,65 @@
+#include "cds.h"
+
+
+typedef struct _Match {
+    int32_t iNum;
+    int32_t iMax;
+    const char *aName[4];
+} Match;
+
+int32_t CollectInterval(Interval *pInterval, void *pArg)
+{
+    /* Stop the query once the designated number of intervals is collected. */
+    Match *pMatch = (Match*)pArg;
+    pMatch->aName[pMatch->iNum++] = (const char*)pInterval->value;
+    return (pMatch->iNum < pMatch->iMax)? CONTINUE : END;
+}
+
+int main()
+{
+    IntervalTree *pTree;
+
+    /* You should initialize the DS before any operations. */
+    int32_t rc = IntervalTreeInit(&pTree);
+    if (rc != SUCC)
+        return rc;
+
+    /* Insert the closed intervals. The tree keeps its own copies. */
+    Interval interval;
+    interval.lLow = 0x1000;
+    interval.lHigh = 0x1fff;
+    interval.value = "text";
+    pTree->put(pTree, &interval);
+    interval.lLow = 0x2000;
+    interval.lHigh = 0x2fff;
+    interval.value = "data";
+    pTree->put(pTree, &interval);
+    interval.lLow = 0x0000;
+    interval.lHigh = 0xffff;
+    interval.value = "segment";
+    pTree->put(pTree, &interval);
+    assert(pTree->size(pTree) == 3);
+
+    /* Find the intervals containing the address in the ascending order of
+       the lower endpoints. */
+    Match match = {0, 4, {NULL}};
+    pTree->stab(pTree, 0x2100, CollectInterval, &match);
+    assert(match.iNum == 2);
+    assert(strcmp(match.aName[0], "segment") == 0);
+    assert(strcmp(match.aName[1], "data") == 0);
+
+    /* Find the intervals overlapping the range, and stop at the first one. */
+    match.iNum = 0;
+    match.iMax = 1;
+    pTree->overlap(pTree, 0x1800, 0x2800, CollectInterval, &match);
+    assert(match.iNum == 1);
+
+    /* Delete the interval identified by its endpoints and value. */
+    pTree->remove(pTree, &interval);
+    assert(pTree->find(pTree, &interval) == NOKEY);
+
+    /* You should deinitialize the DS after all the relevant tasks. */
+    IntervalTreeDeinit(&pTree);
+
+    return SUCC;
+}
@@ -0,0 +1,74 @@
+#include "cds.h"
+#include <pthread.h>
+
+
+#define COUNT_THREAD    (4)
+#define COUNT_KEY       (100)
+
+
+void DestroyPair(Pair *pPair)
+{
+    free(pPair);
+}
+
+void* WriteRoutine(void *pArg)
+{
+    SkipList *pList = (SkipList*)pArg;
+
+    /* All the threads insert and remove the pairs without locking. */
+    intptr_t iKey;
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey++) {
+        Pair *pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = (void*)iKey;
+        pPair->value = (void*)iKey;
+        pList->put(pList, pPair);
+    }
+    pList->remove(pList, (Key)(intptr_t)COUNT_KEY);
+    return NULL;
+}
+
+int main()
+{
+    SkipList *pList;
+
+    /* You should initialize the DS before any operations. */
+    int32_t rc = SkipListInit(&pList);
+    if (rc != SUCC)
+        return rc;
+
+    /* The custom methods should be set before sharing the list. The replaced
+       and removed pairs are cleaned after no thread can see them. */
+    pList->set_destroy(pList, DestroyPair);
+
+    pthread_t aThrd[COUNT_THREAD];
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_THREAD ; iIdx++)
+        pthread_create(&aThrd[iIdx], NULL, WriteRoutine, pList);
+    for (iIdx = 0 ; iIdx < COUNT_THREAD ; iIdx++)
+        pthread_join(aThrd[iIdx], NULL);
+
+    /* Retrieve the value with the designated key. */
+    Value value;
+    pList->get(pList, (Key)(intptr_t)1, &value);
+    assert((intptr_t)value == 1);
+
+    /* Check the key existence. */
+    assert(pList->find(pList, (Key)(intptr_t)COUNT_KEY) == NOKEY);
+    assert(pList->size(pList) == COUNT_KEY - 1);
+
+    /* Scan the pairs in the range [10, 20). */
+    Pair *pPair;
+    SkipListIter iter;
+    intptr_t iKey = 10;
+    pList->iter_range(pList, &iter, (Key)(intptr_t)10, (Key)(intptr_t)20);
+    while (pList->iter_next(pList, &iter, &pPair) == CONTINUE) {
+        assert((intptr_t)pPair->key == iKey);
+        iKey++;
+    }
+    pList->iter_close(pList, &iter);
+
+    /* You should deinitialize the DS after all the relevant tasks. */
+    SkipListDeinit(&pList);
+
+    return SUCC;
+}
@@ -0,0 +1,62 @@
+#include "cds.h"
+
+
+int main()
+{
+    Trie *pTrie;
+
+    /* Build the dictionary with Trie first. */
+    int32_t rc = TrieInit(&pTrie);
+    if (rc != SUCC)
+        return rc;
+
+    char *aWord[6];
+    aWord[0] = "edge";
+    aWord[1] = "edges";
+    aWord[2] = "edgeless";
+    aWord[3] = "eddy";
+    aWord[4] = "node";
+    aWord[5] = "nodes";
+    pTrie->bulk_insert(pTrie, aWord, 6);
+
+    /* Encode the strings into the succinct trie, and release the source. */
+    SuccinctTrie *pSuccinct;
+    rc = SuccinctTrieInit(&pSuccinct);
+    if (rc != SUCC) {
+        TrieDeinit(&pTrie);
+        return rc;
+    }
+    rc = pSuccinct->build(pSuccinct, pTrie);
+    TrieDeinit(&pTrie);
+    if (rc != SUCC) {
+        SuccinctTrieDeinit(&pSuccinct);
+        return rc;
+    }
+    assert(pSuccinct->size(pSuccinct) == 6);
+
+    /* Check for exact string and prefix. */
+    assert(pSuccinct->has_exact(pSuccinct, "edges") == SUCC);
+    assert(pSuccinct->has_exact(pSuccinct, "edg") == NOKEY);
+    assert(pSuccinct->has_prefix_as(pSuccinct, "edg") == SUCC);
+    assert(pSuccinct->has_prefix_as(pSuccinct, "nope") == NOKEY);
+
+    /* Get the sorted array of strings matching the designated prefix. */
+    char **aStr;
+    int32_t iSizeArr;
+    pSuccinct->get_prefix_as(pSuccinct, "ed", &aStr, &iSizeArr);
+    assert(iSizeArr == 4);
+    assert(strcmp(aStr[0], "eddy") == 0);
+    assert(strcmp(aStr[1], "edge") == 0);
+    assert(strcmp(aStr[2], "edgeless") == 0);
+    assert(strcmp(aStr[3], "edges") == 0);
+
+    /* Remember to free the returned array of strings. */
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iSizeArr ; ++iIdx)
+        free(aStr[iIdx]);
+    free(aStr);
+
+    SuccinctTrieDeinit(&pSuccinct);
+
+    return SUCC;
+}
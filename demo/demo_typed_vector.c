@@ -0,0 +1,117 @@
+#include "cds.h"
+
+
+typedef struct Employ_ {
+    int8_t cYear;
+    int8_t cLevel;
+    int32_t iId;
+} Employ;
+
+
+int32_t CompareObject(const void *pSrc, const void *pTge)
+{
+    const Employ *empSrc = (const Employ*)pSrc;
+    const Employ *empTge = (const Employ*)pTge;
+    if (empSrc->iId == empTge->iId)
+        return 0;
+    return (empSrc->iId > empTge->iId)? 1 : (-1);
+}
+
+
+int main()
+{
+    TypedVector *pVec;
+
+    /* You should initialize the DS with the element size before any
+       operations. The elements are stored by value, so no per element
+       allocation is needed. */
+    int32_t rc = TypedVectorInit(&pVec, sizeof(Employ), 1);
+    if (rc != SUCC)
+        return rc;
+
+    /* Push the elements. The content is copied into the vector. */
+    Employ employ;
+    employ.iId = 3;
+    employ.cLevel = 3;
+    employ.cYear = 3;
+    pVec->push_back(pVec, &employ);
+
+    employ.iId = 4;
+    employ.cLevel = 4;
+    employ.cYear = 4;
+    pVec->push_back(pVec, &employ);
+
+    /* Insert the elements at the designated indexes. */
+    employ.iId = 1;
+    employ.cLevel = 1;
+    employ.cYear = 1;
+    pVec->insert(pVec, &employ, 0);
+
+    /* Construct the element directly inside the vector storage. */
+    void *pElem;
+    pVec->emplace_back(pVec, &pElem);
+    Employ *pEmploy = (Employ*)pElem;
+    pEmploy->iId = 2;
+    pEmploy->cLevel = 2;
+    pEmploy->cYear = 2;
+
+    /*---------------------------------------------------------------*
+     * Now the vector should be: [1] | [3] | [4] | [2]               *
+     *---------------------------------------------------------------*/
+
+    /* Sort the elements with the custom element comparison method. */
+    pVec->sort(pVec, CompareObject);
+
+    /*---------------------------------------------------------------*
+     * Now the vector should be: [1] | [2] | [3] | [4]               *
+     *---------------------------------------------------------------*/
+
+    /* Iterate through the vector and update the elements in place. */
+    int32_t iId = 1;
+    pVec->iterate(pVec, true, NULL);
+    while (pVec->iterate(pVec, false, &pElem) != END) {
+        pEmploy = (Employ*)pElem;
+        assert(pEmploy->iId == iId);
+        pEmploy->cLevel *= 10;
+        iId++;
+    }
+
+    /* Reversely iterate through the vector. */
+    iId = 4;
+    pVec->reverse_iterate(pVec, true, NULL);
+    while (pVec->reverse_iterate(pVec, false, &pElem) != END) {
+        assert(((Employ*)pElem)->iId == iId);
+        iId--;
+    }
+
+    /* Copy the element out with direct indexing. */
+    pVec->get(pVec, &employ, 0);
+    assert(employ.iId == 1);
+    assert(employ.cLevel == 10);
+
+    /* Access the element in place with direct indexing. */
+    pVec->at(pVec, &pElem, 3);
+    assert(((Employ*)pElem)->iId == 4);
+
+    /* Replace the element with direct indexing. */
+    employ.iId = 40;
+    pVec->set(pVec, &employ, 3);
+
+    /* Delete the elements. */
+    pVec->remove(pVec, 0);
+    pVec->pop_back(pVec);
+
+    /*---------------------------------------------------------------*
+     * Now the vector should be: [2] | [3]                           *
+     *---------------------------------------------------------------*/
+
+    int32_t iSize = pVec->size(pVec);
+    assert(iSize == 2);
+    pVec->get(pVec, &employ, 1);
+    assert(employ.iId == 3);
+
+    /* You should deinitialize the DS after all the relevant tasks. */
+    TypedVectorDeinit(&pVec);
+
+    return SUCC;
+}
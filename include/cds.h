@@ -1,11 +1,24 @@
 #include "util.h"
 #include "container/vector.h"
+#include "container/typed_vector.h"
 #include "container/linked_list.h"
 #include "container/tree_map.h"
+#include "container/flat_map.h"
+#include "container/btree_map.h"
+#include "container/concurrent_tree_map.h"
+#include "container/skip_list.h"
+#include "container/interval_tree.h"
+#include "container/frozen_map.h"
+#include "container/art_map.h"
 #include "container/hash_map.h"
 #include "container/hash_set.h"
 #include "container/stack.h"
 #include "container/queue.h"
 #include "container/priority_queue.h"
 #include "container/trie.h"
-#include "math/hash.h"
\ No newline at end of file
+#include "container/frozen_trie.h"
+#include "container/succinct_trie.h"
+#include "math/hash.h"
+#include "memory/storage.h"
+#include "memory/epoch.h"
+#include "memory/frozen_file.h"
\ No newline at end of file
@@ -0,0 +1,289 @@
+/**
+ * @file art_map.h The ordered map indexed by byte string keys with the adaptive
+ * radix tree.
+ */
+
+#ifndef _ART_MAP_H_
+#define _ART_MAP_H_
+
+#include "../util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** ArtMapData is the data type for the container private information. */
+typedef struct _ArtMapData ArtMapData;
+
+/** The key value entry kept by the map. */
+typedef struct _ArtEntry {
+    /** The copy of the key bytes owned by the map */
+    Key key;
+    /** The size of the key in bytes */
+    int32_t iSize;
+    /** The value attached by the user */
+    Value value;
+} ArtEntry;
+
+/** The implementation for adaptive radix tree. */
+typedef struct _ArtMap {
+    /** The container private information */
+    ArtMapData *pData;
+
+    /** Insert a key value entry into the map.
+        @see ArtMapPut */
+    int32_t (*put) (struct _ArtMap*, Key, int32_t, Value);
+
+    /** Retrieve the value corresponding to the designated key.
+        @see ArtMapGet */
+    int32_t (*get) (struct _ArtMap*, Key, int32_t, Value*);
+
+    /** Check if the map contains the designated key.
+        @see ArtMapFind */
+    int32_t (*find) (struct _ArtMap*, Key, int32_t);
+
+    /** Delete the entry corresponding to the designated key.
+        @see ArtMapRemove */
+    int32_t (*remove) (struct _ArtMap*, Key, int32_t);
+
+    /** Return the number of stored entries.
+        @see ArtMapSize */
+    int32_t (*size) (struct _ArtMap*);
+
+    /** Retrieve the entry with the minimum key.
+        @see ArtMapMinimum */
+    int32_t (*minimum) (struct _ArtMap*, ArtEntry**);
+
+    /** Retrieve the entry with the maximum key.
+        @see ArtMapMaximum */
+    int32_t (*maximum) (struct _ArtMap*, ArtEntry**);
+
+    /** Iterate through the map in the ascending key order.
+        @see ArtMapIterate */
+    int32_t (*iterate) (struct _ArtMap*, bool, ArtEntry**);
+
+    /** Iterate through the entries whose keys start with the given prefix.
+        @see ArtMapIteratePrefix */
+    int32_t (*iterate_prefix) (struct _ArtMap*, bool, Key, int32_t,
+                               ArtEntry**);
+
+    /** Set the custom resource clean method.
+        @see ArtMapSetDestroy */
+    int32_t (*set_destroy) (struct _ArtMap*, void (*) (ArtEntry*));
+} ArtMap;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief The constructor for ArtMap.
+ *
+ * The keys are byte strings ordered by memcmp, where a key goes before all
+ * the longer keys it prefixes. The inner nodes grow through the Node4, Node16,
+ * Node48, and Node256 layouts with their fanouts and shrink back on removal.
+ * Each inner node keeps the compressed path shared by its subtree, and a key
+ * is stored in a leaf hung at the first node where it branches off.
+ *
+ * @param ppObj         The double pointer to the to be constructed map
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for map construction
+ */
+int32_t ArtMapInit(ArtMap **ppObj);
+
+/**
+ * @brief The destructor for ArtMap.
+ *
+ * If the custom resource clean method is set, it also runs the clean method
+ * for each entry.
+ *
+ * @param ppObj         The double pointer to the to be destructed map
+ */
+void ArtMapDeinit(ArtMap **ppObj);
+
+/**
+ * @brief Insert a key value entry into the map.
+ *
+ * The map copies the key bytes. If the key is already stored, the value is
+ * replaced, and the custom resource clean method runs for the entry before
+ * the replacement.
+ *
+ * @param self          The pointer to ArtMap structure
+ * @param key           The pointer to the key bytes
+ * @param iSize         The size of the key in bytes
+ * @param value         The designated value
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for map extension
+ * @retval ERR_KEYSIZE  Negative key size, or missing key bytes
+ */
+int32_t ArtMapPut(ArtMap *self, Key key, int32_t iSize, Value value);
+
+/**
+ * @brief Retrieve the value corresponding to the designated key.
+ *
+ * @param self          The pointer to ArtMap structure
+ * @param key           The pointer to the key bytes
+ * @param iSize         The size of the key in bytes
+ * @param pValue        The pointer to the returned value
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ * @retval ERR_GET      Invalid parameter to store returned value
+ * @retval ERR_KEYSIZE  Negative key size, or missing key bytes
+ */
+int32_t ArtMapGet(ArtMap *self, Key key, int32_t iSize, Value *pValue);
+
+/**
+ * @brief Check if the map contains the designated key.
+ *
+ * @param self          The pointer to ArtMap structure
+ * @param key           The pointer to the key bytes
+ * @param iSize         The size of the key in bytes
+ *
+ * @retval SUCC         The key can be found
+ * @retval NOKEY        The key cannot be found
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_KEYSIZE  Negative key size, or missing key bytes
+ */
+int32_t ArtMapFind(ArtMap *self, Key key, int32_t iSize);
+
+/**
+ * @brief Delete the entry corresponding to the designated key.
+ *
+ * If the custom resource clean method is set, it runs the clean method for
+ * the deleted entry.
+ *
+ * @param self          The pointer to ArtMap structure
+ * @param key           The pointer to the key bytes
+ * @param iSize         The size of the key in bytes
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ * @retval ERR_KEYSIZE  Negative key size, or missing key bytes
+ */
+int32_t ArtMapRemove(ArtMap *self, Key key, int32_t iSize);
+
+/**
+ * @brief Return the number of stored entries.
+ *
+ * @param self          The pointer to ArtMap structure
+ *
+ * @return              The number of stored entries
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t ArtMapSize(ArtMap *self);
+
+/**
+ * @brief Retrieve the entry with the minimum key.
+ *
+ * @param self          The pointer to ArtMap structure
+ * @param ppEntry       The double pointer to the returned entry
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Empty map
+ * @retval ERR_GET      Invalid parameter to store returned entry
+ */
+int32_t ArtMapMinimum(ArtMap *self, ArtEntry **ppEntry);
+
+/**
+ * @brief Retrieve the entry with the maximum key.
+ *
+ * @param self          The pointer to ArtMap structure
+ * @param ppEntry       The double pointer to the returned entry
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Empty map
+ * @retval ERR_GET      Invalid parameter to store returned entry
+ */
+int32_t ArtMapMaximum(ArtMap *self, ArtEntry **ppEntry);
+
+/**
+ * @brief Iterate through the map in the ascending key order.
+ *
+ * Before iterating through the map, it is necessary to pass:
+ *  - bReset = true
+ *  - pEntry = NULL
+ * for iterator initialization.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - pEntry = the pointer to get the returned entry at each iteration.
+ *
+ * The iterator is invalidated by the insertion and the deletion.
+ *
+ * @param self          The pointer to ArtMap structure
+ * @param bReset        The knob to restart the iteration
+ * @param ppEntry       The double pointer to the returned entry
+ *
+ * @retval SUCC         Iterator initialized successfully
+ * @retval CONTINUE     Iteration in progress
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for the iterator path
+ * @retval ERR_GET      Invalid parameter to store returned entry
+ */
+int32_t ArtMapIterate(ArtMap *self, bool bReset, ArtEntry **ppEntry);
+
+/**
+ * @brief Iterate through the entries whose keys start with the given prefix
+ * in the ascending key order.
+ *
+ * Before iterating through the entries, it is necessary to pass:
+ *  - bReset = true
+ *  - key and iSize = the designated prefix
+ *  - pEntry = NULL
+ * for iterator initialization. The iterator descends to the subtree sharing
+ * the prefix, so the whole scan costs O(m + k) for the prefix of m bytes and
+ * k reported entries.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - key and iSize = ignored
+ *  - pEntry = the pointer to get the returned entry at each iteration.
+ *
+ * The iterator shares its state with ArtMapIterate, and is invalidated by the
+ * insertion and the deletion.
+ *
+ * @param self          The pointer to ArtMap structure
+ * @param bReset        The knob to restart the iteration
+ * @param key           The pointer to the prefix bytes
+ * @param iSize         The size of the prefix in bytes
+ * @param ppEntry       The double pointer to the returned entry
+ *
+ * @retval SUCC         Iterator initialized successfully
+ * @retval CONTINUE     Iteration in progress
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for the iterator path
+ * @retval ERR_GET      Invalid parameter to store returned entry
+ * @retval ERR_KEYSIZE  Negative prefix size, or missing prefix bytes
+ */
+int32_t ArtMapIteratePrefix(ArtMap *self, bool bReset, Key key, int32_t iSize,
+                            ArtEntry **ppEntry);
+
+/**
+ * @brief Set the custom resource clean method.
+ *
+ * The method receives the entry whose key is owned by the map, so it should
+ * release only the value.
+ *
+ * @param self          The pointer to ArtMap structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t ArtMapSetDestroy(ArtMap *self, void (*pFunc) (ArtEntry*));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,309 @@
+/**
+ * @file btree_map.h The ordered map to store key value pairs in a B+ tree.
+ */
+
+#ifndef _BTREE_MAP_H_
+#define _BTREE_MAP_H_
+
+#include "../util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** BTreeMapData is the data type for the container private information. */
+typedef struct _BTreeMapData BTreeMapData;
+
+/** The implementation for ordered map with cache line sized B+ tree nodes. */
+typedef struct _BTreeMap {
+    /** The container private information */
+    BTreeMapData *pData;
+
+    /** Insert a key value pair into the map.
+        @see BTreeMapPut */
+    int32_t (*put) (struct _BTreeMap*, Pair*);
+
+    /** Retrieve the value corresponding to the designated key.
+        @see BTreeMapGet */
+    int32_t (*get) (struct _BTreeMap*, Key, Value*);
+
+    /** Check if the map contains the designated key.
+        @see BTreeMapFind */
+    int32_t (*find) (struct _BTreeMap*, Key);
+
+    /** Delete the key value pair corresponding to the designated key.
+        @see BTreeMapRemove */
+    int32_t (*remove) (struct _BTreeMap*, Key);
+
+    /** Return the number of stored key value pairs.
+        @see BTreeMapSize */
+    int32_t (*size) (struct _BTreeMap*);
+
+    /** Retrieve the key value pair with the minimum order from the map.
+        @see BTreeMapMinimum */
+    int32_t (*minimum) (struct _BTreeMap*, Pair**);
+
+    /** Retrieve the key value pair with the maximum order from the map.
+        @see BTreeMapMaximum */
+    int32_t (*maximum) (struct _BTreeMap*, Pair**);
+
+    /** Retrieve the key value pair which is the predecessor of the given key.
+        @see BTreeMapPredecessor */
+    int32_t (*predecessor) (struct _BTreeMap*, Key, Pair**);
+
+    /** Retrieve the key value pair which is the successor of the given key.
+        @see BTreeMapSuccessor */
+    int32_t (*successor) (struct _BTreeMap*, Key, Pair**);
+
+    /** Iterate through the map from the minimum order to the maximum order.
+        @see BTreeMapIterate */
+    int32_t (*iterate) (struct _BTreeMap*, bool, Pair**);
+
+    /** Iterate through the map from the maximum order to the minimum order.
+        @see BTreeMapReverseIterate */
+    int32_t (*reverse_iterate) (struct _BTreeMap*, bool, Pair**);
+
+    /** Set the custom key comparison method.
+        @see BTreeMapSetCompare */
+    int32_t (*set_compare) (struct _BTreeMap*, int32_t (*) (Key, Key));
+
+    /** Set the custom key value pair resource clean method.
+        @see BTreeMapSetDestroy */
+    int32_t (*set_destroy) (struct _BTreeMap*, void (*) (Pair*));
+} BTreeMap;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief The constructor for BTreeMap.
+ *
+ * @param ppObj         The double pointer to the to be constructed map
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for map construction
+ */
+int32_t BTreeMapInit(BTreeMap **ppObj);
+
+/**
+ * @brief The destructor for BTreeMap.
+ *
+ * If the custom resource clean method is set, it also runs the clean method
+ * for each pair.
+ *
+ * @param ppObj         The double pointer to the to be destructed map
+ */
+void BTreeMapDeinit(BTreeMap **ppObj);
+
+/**
+ * @brief Insert a key value pair into the map.
+ *
+ * This function inserts a key value pair into the map. If the order of the
+ * designated pair is the same with a certain one stored in the map, that pair
+ * will be replaced. Also, if the custom resource clean method is set, it runs
+ * the clean method for the replaced pair.
+ *
+ * The key is copied into the leaf node next to the pair pointer, so the
+ * search never dereferences the stored pairs. Full nodes on the search path
+ * are split on the way down.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param pPair         The pointer to the designated pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for map extension
+ */
+int32_t BTreeMapPut(BTreeMap *self, Pair *pPair);
+
+/**
+ * @brief Retrieve the value corresponding to the designated key.
+ *
+ * This function retrieves the value corresponding to the designated key from
+ * the map. If the key can be found, the value will be returned by the third
+ * parameter. Otherwise, the error code in returned and the third parameter is
+ * updated with NULL.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param key           The designated key
+ * @param pValue        The pointer to the returned value
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ * @retval ERR_GET      Invalid parameter to store returned value
+ */
+int32_t BTreeMapGet(BTreeMap *self, Key key, Value *pValue);
+
+/**
+ * @brief Check if the map contains the designated key.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param key           The designated key
+ *
+ * @retval SUCC         The key can be found
+ * @retval NOKEY        The key cannot be found
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t BTreeMapFind(BTreeMap *self, Key key);
+
+/**
+ * @brief Delete the key value pair corresponding to the designated key.
+ *
+ * This function deletes the key value pair corresponding to the designated key.
+ * If the custom resource clean method is set, it runs the clean methods for
+ * the deleted pair. The nodes on the search path are refilled from their
+ * siblings or merged with them on the way down, so every node except the root
+ * stays at least half full.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param key           The designated key
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ */
+int32_t BTreeMapRemove(BTreeMap *self, Key key);
+
+/**
+ * @brief Return the number of stored key value pairs.
+ *
+ * @param self          The pointer to BTreeMap structure
+ *
+ * @return              The number of stored pairs
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t BTreeMapSize(BTreeMap *self);
+
+/**
+ * @brief Retrieve the key value pair with the minimum order from the map.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Empty map
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t BTreeMapMinimum(BTreeMap *self, Pair **ppPair);
+
+/**
+ * @brief Retrieve the key value pair with the maximum order from the map.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Empty map
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t BTreeMapMaximum(BTreeMap *self, Pair **ppPair);
+
+/**
+ * @brief Retrieve the key value pair which is the predecessor of the given key.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   Non-existent immediate predecessor
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t BTreeMapPredecessor(BTreeMap *self, Key key, Pair **ppPair);
+
+/**
+ * @brief Retrieve the key value pair which is the successor of the given key.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   Non-existent immediate successor
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t BTreeMapSuccessor(BTreeMap *self, Key key, Pair **ppPair);
+
+/**
+ * @brief Iterate through the map from the minimum order to the maximum order.
+ *
+ * Before iterating through the map, it is necessary to pass:
+ *  - bReset = true
+ *  - pPair = NULL
+ * for iterator initialization.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - pPair = the pointer to get the returned pair at each iteration.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param bReset        The knob to restart the iteration
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC         Iterator initialized successfully or pair returned
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ *
+ * @note The iterator walks through the linked leaves, so the map should not be
+ * modified during the iteration.
+ */
+int32_t BTreeMapIterate(BTreeMap *self, bool bReset, Pair **ppPair);
+
+/**
+ * @brief Reversely iterate through the map from the maximum order to the
+ *  minimum order.
+ *
+ * Before iterating through the map, it is necessary to pass:
+ *  - bReset = true
+ *  - pPair = NULL
+ * for iterator initialization.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - pPair = the pointer to get the returned pair at each iteration.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param bReset        The knob to restart the iteration
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC         Iterator initialized successfully or pair returned
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t BTreeMapReverseIterate(BTreeMap *self, bool bReset, Pair **ppPair);
+
+/**
+ * @brief Set the custom key comparison method.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t BTreeMapSetCompare(BTreeMap *self, int32_t (*pFunc) (Key, Key));
+
+/**
+ * @brief Set the custom key value pair resource clean method.
+ *
+ * @param self          The pointer to BTreeMap structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t BTreeMapSetDestroy(BTreeMap *self, void (*pFunc) (Pair*));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,313 @@
+/**
+ * @file concurrent_tree_map.h The ordered map shared by lock free readers and
+ * serialized writers.
+ */
+
+#ifndef _CONCURRENT_TREE_MAP_H_
+#define _CONCURRENT_TREE_MAP_H_
+
+#include "../util.h"
+#include "tree_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** ConcurrentTreeMapData is the data type for the container private
+    information. */
+typedef struct _ConcurrentTreeMapData ConcurrentTreeMapData;
+
+/** The consistent read only view of the map held by one reader. */
+typedef struct _ConcurrentTreeMapView {
+    /** The epoch ticket of the reader while the view is open */
+    uint32_t uiTicket;
+    /** The pinned version with the iteration state of the reader */
+    TreeMapSnapshot snap;
+} ConcurrentTreeMapView;
+
+/** The implementation for concurrent ordered map. */
+typedef struct _ConcurrentTreeMap {
+    /** The container private information */
+    ConcurrentTreeMapData *pData;
+
+    /** Insert a key value pair into the map.
+        @see ConcurrentTreeMapPut */
+    int32_t (*put) (struct _ConcurrentTreeMap*, Pair*);
+
+    /** Retrieve the value corresponding to the designated key.
+        @see ConcurrentTreeMapGet */
+    int32_t (*get) (struct _ConcurrentTreeMap*, Key, Value*);
+
+    /** Check if the map contains the designated key.
+        @see ConcurrentTreeMapFind */
+    int32_t (*find) (struct _ConcurrentTreeMap*, Key);
+
+    /** Delete the key value pair corresponding to the designated key.
+        @see ConcurrentTreeMapRemove */
+    int32_t (*remove) (struct _ConcurrentTreeMap*, Key);
+
+    /** Return the number of stored key value pairs.
+        @see ConcurrentTreeMapSize */
+    int32_t (*size) (struct _ConcurrentTreeMap*);
+
+    /** Open a consistent view of the latest version.
+        @see ConcurrentTreeMapViewOpen */
+    int32_t (*view_open) (struct _ConcurrentTreeMap*, ConcurrentTreeMapView*);
+
+    /** Close the view.
+        @see ConcurrentTreeMapViewClose */
+    int32_t (*view_close) (struct _ConcurrentTreeMap*, ConcurrentTreeMapView*);
+
+    /** Retrieve the value corresponding to the designated key in the view.
+        @see ConcurrentTreeMapViewGet */
+    int32_t (*view_get) (struct _ConcurrentTreeMap*, ConcurrentTreeMapView*,
+                         Key, Value*);
+
+    /** Iterate through the view in the ascending key order.
+        @see ConcurrentTreeMapViewIterate */
+    int32_t (*view_iterate) (struct _ConcurrentTreeMap*,
+                             ConcurrentTreeMapView*, bool, Pair**);
+
+    /** Position the view iteration at the lower bound of the given key.
+        @see ConcurrentTreeMapViewSeek */
+    int32_t (*view_seek) (struct _ConcurrentTreeMap*, ConcurrentTreeMapView*,
+                          Key);
+
+    /** Set the custom key comparison method.
+        @see ConcurrentTreeMapSetCompare */
+    int32_t (*set_compare) (struct _ConcurrentTreeMap*, int32_t (*) (Key, Key));
+
+    /** Set the custom key value pair resource clean method.
+        @see ConcurrentTreeMapSetDestroy */
+    int32_t (*set_destroy) (struct _ConcurrentTreeMap*, void (*) (Pair*));
+} ConcurrentTreeMap;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief The constructor for ConcurrentTreeMap.
+ *
+ * The map keeps a TreeMap as the version of the writers, and publishes a
+ * snapshot of it after each write. The readers load the published snapshot
+ * without locking and traverse its immutable nodes, while the writers copy the
+ * modified path and are serialized by a mutex. The replaced snapshots are
+ * reclaimed through the epoch domain of the map once no reader holds them.
+ *
+ * @param ppObj         The double pointer to the to be constructed map
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for map construction
+ */
+int32_t ConcurrentTreeMapInit(ConcurrentTreeMap **ppObj);
+
+/**
+ * @brief The destructor for ConcurrentTreeMap.
+ *
+ * If the custom resource clean method is set, it also runs the clean method
+ * for each pair. No reader should be active.
+ *
+ * @param ppObj         The double pointer to the to be destructed map
+ */
+void ConcurrentTreeMapDeinit(ConcurrentTreeMap **ppObj);
+
+/**
+ * @brief Insert a key value pair into the map.
+ *
+ * This function inserts a key value pair into the map. If the order of the
+ * designated pair is the same with a certain one stored in the map, that pair
+ * will be replaced. The replaced pair is passed to the custom resource clean
+ * method after all the readers which may see it are gone.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param pPair         The pointer to the designated pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for map extension
+ */
+int32_t ConcurrentTreeMapPut(ConcurrentTreeMap *self, Pair *pPair);
+
+/**
+ * @brief Retrieve the value corresponding to the designated key.
+ *
+ * The lookup runs without locking. If the custom resource clean method
+ * releases the values, the value should be accessed through a view instead,
+ * which keeps it alive until the view is closed.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param key           The designated key
+ * @param pValue        The pointer to the returned value
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ * @retval ERR_GET      Invalid parameter to store returned value
+ */
+int32_t ConcurrentTreeMapGet(ConcurrentTreeMap *self, Key key, Value *pValue);
+
+/**
+ * @brief Check if the map contains the designated key without locking.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param key           The designated key
+ *
+ * @retval SUCC         The key can be found
+ * @retval NOKEY        The key cannot be found
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t ConcurrentTreeMapFind(ConcurrentTreeMap *self, Key key);
+
+/**
+ * @brief Delete the key value pair corresponding to the designated key.
+ *
+ * The deleted pair is passed to the custom resource clean method after all the
+ * readers which may see it are gone.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param key           The designated key
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ * @retval ERR_NOMEM    Insufficient memory for the path copying
+ */
+int32_t ConcurrentTreeMapRemove(ConcurrentTreeMap *self, Key key);
+
+/**
+ * @brief Return the number of key value pairs in the latest version.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ *
+ * @return              The number of stored pairs
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t ConcurrentTreeMapSize(ConcurrentTreeMap *self);
+
+/**
+ * @brief Open a consistent view of the latest version.
+ *
+ * The view pins the version for the calling thread without locking, and all
+ * the lookups and the iterations through the view see the same pairs
+ * regardless of the concurrent writes. The view should be closed by the same
+ * thread, and kept short since it delays the reclamation of all the versions
+ * replaced in the meantime.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param pView         The pointer to the view owned by the calling thread
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the view
+ */
+int32_t ConcurrentTreeMapViewOpen(ConcurrentTreeMap *self,
+                                  ConcurrentTreeMapView *pView);
+
+/**
+ * @brief Close the view.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param pView         The pointer to the view
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid or already closed view
+ */
+int32_t ConcurrentTreeMapViewClose(ConcurrentTreeMap *self,
+                                   ConcurrentTreeMapView *pView);
+
+/**
+ * @brief Retrieve the value corresponding to the designated key in the view.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param pView         The pointer to the view
+ * @param key           The designated key
+ * @param pValue        The pointer to the returned value
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ * @retval ERR_GET      Invalid view or parameter to store returned value
+ */
+int32_t ConcurrentTreeMapViewGet(ConcurrentTreeMap *self,
+                                 ConcurrentTreeMapView *pView, Key key,
+                                 Value *pValue);
+
+/**
+ * @brief Iterate through the view from the minimum order to the maximum order.
+ *
+ * Before iterating through the view, it is necessary to pass:
+ *  - bReset = true
+ *  - pPair = NULL
+ * for iterator initialization.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - pPair = the pointer to get the returned pair at each iteration.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param pView         The pointer to the view
+ * @param bReset        The knob to restart the iteration
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC         Iterator initialized or a pair returned successfully
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid view or parameter to store returned pair
+ */
+int32_t ConcurrentTreeMapViewIterate(ConcurrentTreeMap *self,
+                                     ConcurrentTreeMapView *pView, bool bReset,
+                                     Pair **ppPair);
+
+/**
+ * @brief Position the view iteration at the first pair whose key is not
+ * ordered before the given key.
+ *
+ * It replaces the iterator initialization of ConcurrentTreeMapViewIterate for
+ * the range scans.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param pView         The pointer to the view
+ * @param key           The designated key
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid view
+ */
+int32_t ConcurrentTreeMapViewSeek(ConcurrentTreeMap *self,
+                                  ConcurrentTreeMapView *pView, Key key);
+
+/**
+ * @brief Set the custom key comparison method.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ *
+ * @note It should be set before the map is shared with other threads.
+ */
+int32_t ConcurrentTreeMapSetCompare(ConcurrentTreeMap *self,
+                                    int32_t (*pFunc) (Key, Key));
+
+/**
+ * @brief Set the custom key value pair resource clean method.
+ *
+ * @param self          The pointer to ConcurrentTreeMap structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ *
+ * @note It should be set before the map is shared with other threads.
+ */
+int32_t ConcurrentTreeMapSetDestroy(ConcurrentTreeMap *self,
+                                    void (*pFunc) (Pair*));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
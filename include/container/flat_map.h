@@ -0,0 +1,370 @@
+/**
+ * @file flat_map.h The ordered map storing key value pairs in a sorted array.
+ */
+
+#ifndef _FLAT_MAP_H_
+#define _FLAT_MAP_H_
+
+#include "../util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** FlatMapData is the data type for the container private information. */
+typedef struct _FlatMapData FlatMapData;
+
+/** The implementation for ordered map with contiguous pairs. */
+typedef struct _FlatMap {
+    /** The container private information */
+    FlatMapData *pData;
+
+    /** Insert a key value pair into the map.
+        @see FlatMapPut */
+    int32_t (*put) (struct _FlatMap*, const Pair*);
+
+    /** Insert an array of key value pairs into the map with a single merge.
+        @see FlatMapPutBatch */
+    int32_t (*put_batch) (struct _FlatMap*, const Pair*, int32_t);
+
+    /** Replace the map content with an array of unsorted key value pairs.
+        @see FlatMapBuild */
+    int32_t (*build) (struct _FlatMap*, const Pair*, int32_t);
+
+    /** Retrieve the value corresponding to the designated key.
+        @see FlatMapGet */
+    int32_t (*get) (struct _FlatMap*, Key, Value*);
+
+    /** Check if the map contains the designated key.
+        @see FlatMapFind */
+    int32_t (*find) (struct _FlatMap*, Key);
+
+    /** Delete the key value pair corresponding to the designated key.
+        @see FlatMapRemove */
+    int32_t (*remove) (struct _FlatMap*, Key);
+
+    /** Return the number of stored key value pairs.
+        @see FlatMapSize */
+    int32_t (*size) (struct _FlatMap*);
+
+    /** Retrieve the key value pair with the minimum order from the map.
+        @see FlatMapMinimum */
+    int32_t (*minimum) (struct _FlatMap*, Pair**);
+
+    /** Retrieve the key value pair with the maximum order from the map.
+        @see FlatMapMaximum */
+    int32_t (*maximum) (struct _FlatMap*, Pair**);
+
+    /** Retrieve the key value pair which is the predecessor of the given key.
+        @see FlatMapPredecessor */
+    int32_t (*predecessor) (struct _FlatMap*, Key, Pair**);
+
+    /** Retrieve the key value pair which is the successor of the given key.
+        @see FlatMapSuccessor */
+    int32_t (*successor) (struct _FlatMap*, Key, Pair**);
+
+    /** Iterate through the map from the minimum order to the maximum order.
+        @see FlatMapIterate */
+    int32_t (*iterate) (struct _FlatMap*, bool, Pair**);
+
+    /** Iterate through the map from the maximum order to the minimum order.
+        @see FlatMapReverseIterate */
+    int32_t (*reverse_iterate) (struct _FlatMap*, bool, Pair**);
+
+    /** Set the custom key comparison method.
+        @see FlatMapSetCompare */
+    int32_t (*set_compare) (struct _FlatMap*, int32_t (*) (Key, Key));
+
+    /** Set the custom key value pair resource clean method.
+        @see FlatMapSetDestroy */
+    int32_t (*set_destroy) (struct _FlatMap*, void (*) (Pair*));
+} FlatMap;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief The constructor for FlatMap.
+ *
+ * @param ppObj         The double pointer to the to be constructed map
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for map construction
+ */
+int32_t FlatMapInit(FlatMap **ppObj);
+
+/**
+ * @brief The destructor for FlatMap.
+ *
+ * If the custom resource clean method is set, it also runs the clean method
+ * for each pair.
+ *
+ * @param ppObj         The double pointer to the to be destructed map
+ */
+void FlatMapDeinit(FlatMap **ppObj);
+
+/**
+ * @brief Insert a key value pair into the map.
+ *
+ * This function copies the designated pair into the sorted array and shifts
+ * the trailing pairs, so the single insertion costs O(n) moves. If the order of
+ * the designated pair is the same with a certain one stored in the map, that
+ * pair will be replaced. Also, if the custom resource clean method is set, it
+ * runs the clean method for the replaced pair.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param pPair         The pointer to the designated pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid designated pair
+ * @retval ERR_NOMEM    Insufficient memory for map extension
+ *
+ * @note The pair structure itself is not kept by the map, so it can be freed or
+ * reused by the caller right after the insertion.
+ */
+int32_t FlatMapPut(FlatMap *self, const Pair *pPair);
+
+/**
+ * @brief Insert an array of key value pairs into the map with a single merge.
+ *
+ * This function stably sorts a copy of the designated pairs, and merges them
+ * into the map from the tail end after extending the storage once. The cost is
+ * O(n + k log k) for k designated pairs. If several pairs share the same order,
+ * the one placed last in the array wins. The replaced and the dropped pairs are
+ * passed to the custom resource clean method if it is set.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param aPair         The array of the designated pairs
+ * @param iNum          The number of the designated pairs
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal pair array or pair count
+ * @retval ERR_NOMEM    Insufficient memory for map extension
+ *
+ * @note The map is not modified if the function fails.
+ */
+int32_t FlatMapPutBatch(FlatMap *self, const Pair *aPair, int32_t iNum);
+
+/**
+ * @brief Replace the map content with an array of unsorted key value pairs.
+ *
+ * This function releases all the stored pairs, then sorts and deduplicates the
+ * designated pairs in the storage directly. If several pairs share the same
+ * order, the one placed last in the array wins, and the others are passed to
+ * the custom resource clean method if it is set.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param aPair         The array of the designated pairs
+ * @param iNum          The number of the designated pairs
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal pair array or pair count
+ * @retval ERR_NOMEM    Insufficient memory for the storage
+ *
+ * @note The map is not modified if the function fails.
+ */
+int32_t FlatMapBuild(FlatMap *self, const Pair *aPair, int32_t iNum);
+
+/**
+ * @brief Retrieve the value corresponding to the designated key.
+ *
+ * This function applies the branchless binary search over the sorted pairs.
+ * If the key can be found, the value will be returned by the third parameter.
+ * Otherwise, the error code in returned and the third parameter is updated
+ * with NULL.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param key           The designated key
+ * @param pValue        The pointer to the returned value
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ * @retval ERR_GET      Invalid parameter to store returned value
+ */
+int32_t FlatMapGet(FlatMap *self, Key key, Value *pValue);
+
+/**
+ * @brief Check if the map contains the designated key.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param key           The designated key
+ *
+ * @retval SUCC         The key can be found
+ * @retval NOKEY        The key cannot be found
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t FlatMapFind(FlatMap *self, Key key);
+
+/**
+ * @brief Delete the key value pair corresponding to the designated key.
+ *
+ * This function deletes the key value pair corresponding to the designated key
+ * and shifts the trailing pairs. If the custom resource clean method is set,
+ * it runs the clean methods for the deleted pair.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param key           The designated key
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ */
+int32_t FlatMapRemove(FlatMap *self, Key key);
+
+/**
+ * @brief Return the number of stored key value pairs.
+ *
+ * @param self          The pointer to FlatMap structure
+ *
+ * @return              The number of stored pairs
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t FlatMapSize(FlatMap *self);
+
+/**
+ * @brief Retrieve the key value pair with the minimum order from the map.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Empty map
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ *
+ * @note The returned pair is stored inside the map and stays valid only till
+ * the next modification.
+ */
+int32_t FlatMapMinimum(FlatMap *self, Pair **ppPair);
+
+/**
+ * @brief Retrieve the key value pair with the maximum order from the map.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Empty map
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ *
+ * @note The returned pair is stored inside the map and stays valid only till
+ * the next modification.
+ */
+int32_t FlatMapMaximum(FlatMap *self, Pair **ppPair);
+
+/**
+ * @brief Retrieve the key value pair which is the predecessor of the given key.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   Non-existent immediate predecessor
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ *
+ * @note Unlike TreeMapPredecessor(), the designated key does not need to be
+ * stored in the map.
+ */
+int32_t FlatMapPredecessor(FlatMap *self, Key key, Pair **ppPair);
+
+/**
+ * @brief Retrieve the key value pair which is the successor of the given key.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   Non-existent immediate successor
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ *
+ * @note Unlike TreeMapSuccessor(), the designated key does not need to be
+ * stored in the map.
+ */
+int32_t FlatMapSuccessor(FlatMap *self, Key key, Pair **ppPair);
+
+/**
+ * @brief Iterate through the map from the minimum order to the maximum order.
+ *
+ * Before iterating through the map, it is necessary to pass:
+ *  - bReset = true
+ *  - pPair = NULL
+ * for iterator initialization.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - pPair = the pointer to get the returned pair at each iteration.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param bReset        The knob to restart the iteration
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC         Iterator initialized successfully or pair returned
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FlatMapIterate(FlatMap *self, bool bReset, Pair **ppPair);
+
+/**
+ * @brief Reversely iterate through the map from the maximum order to the
+ *  minimum order.
+ *
+ * The iterator follows the same convention as FlatMapIterate().
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param bReset        The knob to restart the iteration
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC         Iterator initialized successfully or pair returned
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FlatMapReverseIterate(FlatMap *self, bool bReset, Pair **ppPair);
+
+/**
+ * @brief Set the custom key comparison method.
+ *
+ * The comparison method follows the same convention as the one for
+ * TreeMapSetCompare().
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ *
+ * @note The stored pairs are not sorted again, so the method should be set
+ * before the pairs are inserted.
+ */
+int32_t FlatMapSetCompare(FlatMap *self, int32_t (*pFunc) (Key, Key));
+
+/**
+ * @brief Set the custom key value pair resource clean method.
+ *
+ * @param self          The pointer to FlatMap structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ *
+ * @note The pairs are stored inside the map, so the clean method should release
+ * only the key and the value but not the pair structure itself.
+ */
+int32_t FlatMapSetDestroy(FlatMap *self, void (*pFunc) (Pair*));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
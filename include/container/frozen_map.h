@@ -0,0 +1,354 @@
+/**
+ * @file frozen_map.h The read only ordered map mapped from a file frozen from
+ * TreeMap.
+ */
+
+#ifndef _FROZEN_MAP_H_
+#define _FROZEN_MAP_H_
+
+#include "../util.h"
+#include "tree_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** FrozenMapData is the data type for the container private information. */
+typedef struct _FrozenMapData FrozenMapData;
+
+/** The implementation for frozen map. */
+typedef struct _FrozenMap {
+    /** The container private information */
+    FrozenMapData *pData;
+
+    /** Map the frozen file for the queries.
+        @see FrozenMapOpen */
+    int32_t (*open) (struct _FrozenMap*, const char*);
+
+    /** Retrieve the value corresponding to the designated key.
+        @see FrozenMapGet */
+    int32_t (*get) (struct _FrozenMap*, Key, Value*);
+
+    /** Check if the map contains the designated key.
+        @see FrozenMapFind */
+    int32_t (*find) (struct _FrozenMap*, Key);
+
+    /** Return the number of stored key value pairs.
+        @see FrozenMapSize */
+    int32_t (*size) (struct _FrozenMap*);
+
+    /** Retrieve the key value pair with the minimum order.
+        @see FrozenMapMinimum */
+    int32_t (*minimum) (struct _FrozenMap*, Pair**);
+
+    /** Retrieve the key value pair with the maximum order.
+        @see FrozenMapMaximum */
+    int32_t (*maximum) (struct _FrozenMap*, Pair**);
+
+    /** Retrieve the key value pair which is the predecessor of the given key.
+        @see FrozenMapPredecessor */
+    int32_t (*predecessor) (struct _FrozenMap*, Key, Pair**);
+
+    /** Retrieve the key value pair which is the successor of the given key.
+        @see FrozenMapSuccessor */
+    int32_t (*successor) (struct _FrozenMap*, Key, Pair**);
+
+    /** Retrieve the first pair whose key is not ordered before the given key.
+        @see FrozenMapLowerBound */
+    int32_t (*lower_bound) (struct _FrozenMap*, Key, Pair**);
+
+    /** Retrieve the first pair whose key is ordered after the given key.
+        @see FrozenMapUpperBound */
+    int32_t (*upper_bound) (struct _FrozenMap*, Key, Pair**);
+
+    /** Iterate through the map from the minimum order to the maximum order.
+        @see FrozenMapIterate */
+    int32_t (*iterate) (struct _FrozenMap*, bool, Pair**);
+
+    /** Iterate through the pairs whose keys fall in the given range.
+        @see FrozenMapIterateRange */
+    int32_t (*iterate_range) (struct _FrozenMap*, bool, Key, Key, Pair**);
+
+    /** Set the custom key comparison method.
+        @see FrozenMapSetCompare */
+    int32_t (*set_compare) (struct _FrozenMap*, int32_t (*) (Key, Key));
+} FrozenMap;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief Freeze the content of TreeMap into a file.
+ *
+ * The file holds no pointer. The keys and the values are laid out in two
+ * arrays following the implicit search tree of the Eytzinger order, where the
+ * children of the slot k are the slots 2k and 2k + 1, so that a lookup walks
+ * the arrays from the front and prefetches the next levels of the tree.
+ *
+ * If the designated key size is 0, the key itself is stored as a 64 bit
+ * integer, which suits the integer keys cast to pointers. Otherwise, the key
+ * points to that many bytes which are copied into the file. The values are
+ * stored in the same way with the designated value size. The file is bound to
+ * the byte order of the machine writing it.
+ *
+ * The file is written beside the path, flushed to the disk, and then renamed
+ * over the path. So the path never refers to a partial file, and the maps
+ * which opened the replaced file keep reading it.
+ *
+ * @param pMap          The pointer to the frozen TreeMap
+ * @param szPath        The path of the file, which is replaced if it exists
+ * @param uiKeySize     The size of each key in bytes, or 0 for integer keys
+ * @param uiValueSize   The size of each value in bytes, or 0 for integer
+ *                      values
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized TreeMap
+ * @retval ERR_NOMEM    Insufficient memory for the temporary path
+ * @retval ERR_IDX      Illegal path
+ * @retval ERR_IO       Fail to write the file
+ */
+int32_t FrozenMapFreeze(TreeMap *pMap, const char *szPath, uint32_t uiKeySize,
+                        uint32_t uiValueSize);
+
+/**
+ * @brief The constructor for FrozenMap.
+ *
+ * The constructed map is empty until a frozen file is opened.
+ *
+ * @param ppObj         The double pointer to the to be constructed map
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for map construction
+ */
+int32_t FrozenMapInit(FrozenMap **ppObj);
+
+/**
+ * @brief The destructor for FrozenMap.
+ *
+ * It unmaps the frozen file.
+ *
+ * @param ppObj         The double pointer to the to be destructed map
+ */
+void FrozenMapDeinit(FrozenMap **ppObj);
+
+/**
+ * @brief Map the frozen file for the queries.
+ *
+ * The file is mapped read only and shared, so opening it costs no
+ * deserialization, and the processes opening the same file share its pages
+ * in the page cache. The previously opened file is unmapped first.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param szPath        The path of the frozen file
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal path
+ * @retval ERR_IO       Fail to map the file, or the file is not frozen by
+ *                      FrozenMapFreeze on a machine of the same byte order
+ */
+int32_t FrozenMapOpen(FrozenMap *self, const char *szPath);
+
+/**
+ * @brief Retrieve the value corresponding to the designated key.
+ *
+ * For the sized values, the returned value points into the mapped file.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param key           The designated key
+ * @param pValue        The pointer to the returned value
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ * @retval ERR_GET      Invalid parameter to store returned value
+ */
+int32_t FrozenMapGet(FrozenMap *self, Key key, Value *pValue);
+
+/**
+ * @brief Check if the map contains the designated key.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param key           The designated key
+ *
+ * @retval SUCC         The key can be found
+ * @retval NOKEY        The key cannot be found
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t FrozenMapFind(FrozenMap *self, Key key);
+
+/**
+ * @brief Return the number of stored key value pairs.
+ *
+ * @param self          The pointer to FrozenMap structure
+ *
+ * @return              The number of stored pairs
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t FrozenMapSize(FrozenMap *self);
+
+/**
+ * @brief Retrieve the key value pair with the minimum order from the map.
+ *
+ * The pairs returned by all the queries are kept by the map, and each query
+ * overwrites the pair returned by the previous one.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Empty map
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FrozenMapMinimum(FrozenMap *self, Pair **ppPair);
+
+/**
+ * @brief Retrieve the key value pair with the maximum order from the map.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Empty map
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FrozenMapMaximum(FrozenMap *self, Pair **ppPair);
+
+/**
+ * @brief Retrieve the key value pair which is the predecessor of the given key.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   Non-existent immediate predecessor
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FrozenMapPredecessor(FrozenMap *self, Key key, Pair **ppPair);
+
+/**
+ * @brief Retrieve the key value pair which is the successor of the given key.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   Non-existent immediate successor
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FrozenMapSuccessor(FrozenMap *self, Key key, Pair **ppPair);
+
+/**
+ * @brief Retrieve the first key value pair whose key is not ordered before the
+ * given key.
+ *
+ * Unlike FrozenMapSuccessor, the given key does not need to exist in the map.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   All the keys are ordered before the given key
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FrozenMapLowerBound(FrozenMap *self, Key key, Pair **ppPair);
+
+/**
+ * @brief Retrieve the first key value pair whose key is ordered after the given
+ * key.
+ *
+ * Unlike FrozenMapSuccessor, the given key does not need to exist in the map.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No key is ordered after the given key
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FrozenMapUpperBound(FrozenMap *self, Key key, Pair **ppPair);
+
+/**
+ * @brief Iterate through the map from the minimum order to the maximum order.
+ *
+ * Before iterating through the map, it is necessary to pass:
+ *  - bReset = true
+ *  - pPair = NULL
+ * for iterator initialization.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - pPair = the pointer to get the returned pair at each iteration.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param bReset        The knob to restart the iteration
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC         Iterator initialized or a pair returned successfully
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FrozenMapIterate(FrozenMap *self, bool bReset, Pair **ppPair);
+
+/**
+ * @brief Iterate through the pairs whose keys fall in the range
+ * [keyBgn, keyEnd) in the ascending key order.
+ *
+ * Before iterating through the range, it is necessary to pass:
+ *  - bReset = true
+ *  - keyBgn and keyEnd = the range boundaries
+ *  - pPair = NULL
+ * for iterator initialization. The iterator is positioned at the lower bound
+ * of keyBgn, so the whole scan costs O(log n + k) for k pairs in the range.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - keyBgn and keyEnd = ignored
+ *  - pPair = the pointer to get the returned pair at each iteration.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param bReset        The knob to restart the iteration
+ * @param keyBgn        The inclusive lower boundary of the range
+ * @param keyEnd        The exclusive upper boundary of the range
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC         Iterator initialized or a pair returned successfully
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t FrozenMapIterateRange(FrozenMap *self, bool bReset, Key keyBgn,
+                              Key keyEnd, Pair **ppPair);
+
+/**
+ * @brief Set the custom key comparison method.
+ *
+ * It should order the keys in the same way as the comparison method of the
+ * frozen TreeMap. For the sized keys, the method receives the pointers to the
+ * key bytes.
+ *
+ * @param self          The pointer to FrozenMap structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t FrozenMapSetCompare(FrozenMap *self, int32_t (*pFunc) (Key, Key));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
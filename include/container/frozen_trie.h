@@ -0,0 +1,194 @@
+/**
+ * @file frozen_trie.h The read only string dictionary mapped from a file frozen
+ * from Trie.
+ */
+
+#ifndef _FROZEN_TRIE_H_
+#define _FROZEN_TRIE_H_
+
+#include "../util.h"
+#include "trie.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** FrozenTrieData is the data type for the container private information. */
+typedef struct _FrozenTrieData FrozenTrieData;
+
+/** The implementation for frozen trie. */
+typedef struct _FrozenTrie {
+    /** The container private information */
+    FrozenTrieData *pData;
+
+    /** Map the frozen file for the queries.
+        @see FrozenTrieOpen */
+    int32_t (*open) (struct _FrozenTrie*, const char*);
+
+    /** Check if the trie contains the designated string.
+        @see FrozenTrieHasExact */
+    int32_t (*has_exact) (struct _FrozenTrie*, char*);
+
+    /** Check if the trie contains the strings matching the designated prefix.
+        @see FrozenTrieHasPrefixAs */
+    int32_t (*has_prefix_as) (struct _FrozenTrie*, char*);
+
+    /** Retrieve the strings from the trie matching the designated prefix.
+        @see FrozenTrieGetPrefixAs */
+    int32_t (*get_prefix_as) (struct _FrozenTrie*, char*, char***, int*);
+
+    /** Return the number of strings stored in the trie.
+        @see FrozenTrieSize */
+    int32_t (*size) (struct _FrozenTrie*);
+
+    /** Report the number of units and the memory mapped by the trie.
+        @see FrozenTrieGetStat */
+    int32_t (*get_stat) (struct _FrozenTrie*, TrieStat*);
+} FrozenTrie;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief Freeze the strings of Trie into a file.
+ *
+ * The strings are drawn from the trie in either node layout and packed into
+ * a double array, where each unit holds the base and the check of a node. The
+ * child of the node s with the byte c lives in the unit base[s] + c + 1, and
+ * it is valid only if its check equals s. The unit base[s] marks the end of a
+ * stored string. So a lookup consumes each byte with one unit load and no
+ * pointer. The file is bound to the byte order of the machine writing it.
+ *
+ * The file is written beside the path, flushed to the disk, and then renamed
+ * over the path. So the path never refers to a partial file, and the tries
+ * which opened the replaced file keep reading it.
+ *
+ * @param pTrie         The pointer to the frozen Trie
+ * @param szPath        The path of the file, which is replaced if it exists
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized Trie
+ * @retval ERR_NOMEM    Insufficient memory to collect the strings, to build
+ *                      the double array, or for the temporary path
+ * @retval ERR_IDX      Illegal path
+ * @retval ERR_IO       Fail to write the file
+ */
+int32_t FrozenTrieFreeze(Trie *pTrie, const char *szPath);
+
+/**
+ * @brief The constructor for FrozenTrie.
+ *
+ * The constructed trie is empty until a frozen file is opened.
+ *
+ * @param ppObj         The double pointer to the to be constructed trie
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for trie construction
+ */
+int32_t FrozenTrieInit(FrozenTrie **ppObj);
+
+/**
+ * @brief The destructor for FrozenTrie.
+ *
+ * It unmaps the frozen file.
+ *
+ * @param ppObj         The double pointer to the to be destructed trie
+ */
+void FrozenTrieDeinit(FrozenTrie **ppObj);
+
+/**
+ * @brief Map the frozen file for the queries.
+ *
+ * The file is mapped read only and shared, so opening it costs no
+ * deserialization. The previously opened file is unmapped first.
+ *
+ * @param self          The pointer to FrozenTrie structure
+ * @param szPath        The path of the frozen file
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal path
+ * @retval ERR_IO       Fail to map the file, or the file is not frozen by
+ *                      FrozenTrieFreeze on a machine of the same byte order
+ */
+int32_t FrozenTrieOpen(FrozenTrie *self, const char *szPath);
+
+/**
+ * @brief Check if the trie contains the designated string.
+ *
+ * @param self          The pointer to FrozenTrie structure
+ * @param str           The designated string
+ *
+ * @retval SUCC
+ * @retval NOKEY
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t FrozenTrieHasExact(FrozenTrie *self, char *str);
+
+/**
+ * @brief Check if the trie contains the strings matching the designated prefix.
+ *
+ * @param self          The pointer to FrozenTrie structure
+ * @param str           The designated prefix
+ *
+ * @retval SUCC
+ * @retval NOKEY
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t FrozenTrieHasPrefixAs(FrozenTrie *self, char *str);
+
+/**
+ * @brief Retrieve the strings from the trie matching the designated prefix.
+ *
+ * It follows the same protocol as TrieGetPrefixAs. The returned strings are
+ * sorted in the ascending byte order as strcmp.
+ *
+ * @param self          The pointer to FrozenTrie structure
+ * @param str           The designated prefix
+ * @param paStr         The pointer to the returned array of strings
+ * @param piNum         The pointer to the returned array size
+ *
+ * @retval SUCC
+ * @retval NOKEY
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned data
+ * @retval ERR_NOMEM    Insufficient memory to store the resolved strings
+ *
+ * @note Please remember to free the following resource:
+ *       - Each returned string
+ *       - The array to store returned strings
+ */
+int32_t FrozenTrieGetPrefixAs(FrozenTrie *self, char *str, char ***paStr,
+                              int *piNum);
+
+/**
+ * @brief Return the number of strings stored in the trie.
+ *
+ * @param self          The pointer to FrozenTrie structure
+ *
+ * @return              The number of strings
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t FrozenTrieSize(FrozenTrie *self);
+
+/**
+ * @brief Report the number of units and the memory mapped by the trie.
+ *
+ * The units, including the free ones left between the nodes, are counted as
+ * the nodes, and the bytes count the whole mapped file.
+ *
+ * @param self          The pointer to FrozenTrie structure
+ * @param pStat         The pointer to the returned statistics
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned statistics
+ */
+int32_t FrozenTrieGetStat(FrozenTrie *self, TrieStat *pStat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,211 @@
+/**
+ * @file interval_tree.h The ordered set of closed intervals answering the
+ * stabbing and overlap queries.
+ */
+
+#ifndef _INTERVAL_TREE_H_
+#define _INTERVAL_TREE_H_
+
+#include "../util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** IntervalTreeData is the data type for the container private information. */
+typedef struct _IntervalTreeData IntervalTreeData;
+
+/** The closed interval [lLow, lHigh] with its attached value. */
+typedef struct _Interval {
+    /** The inclusive lower endpoint */
+    int64_t lLow;
+    /** The inclusive upper endpoint */
+    int64_t lHigh;
+    /** The value attached by the user */
+    Value value;
+} Interval;
+
+/** The visitor receiving each interval reported by a query. It returns
+    CONTINUE to proceed or END to stop the query. */
+typedef int32_t (*IntervalTreeVisit) (Interval*, void*);
+
+/** The implementation for interval tree. */
+typedef struct _IntervalTree {
+    /** The container private information */
+    IntervalTreeData *pData;
+
+    /** Insert an interval into the tree.
+        @see IntervalTreePut */
+    int32_t (*put) (struct _IntervalTree*, Interval*);
+
+    /** Check if the tree contains the designated interval.
+        @see IntervalTreeFind */
+    int32_t (*find) (struct _IntervalTree*, Interval*);
+
+    /** Delete the designated interval.
+        @see IntervalTreeRemove */
+    int32_t (*remove) (struct _IntervalTree*, Interval*);
+
+    /** Return the number of stored intervals.
+        @see IntervalTreeSize */
+    int32_t (*size) (struct _IntervalTree*);
+
+    /** Visit the intervals containing the designated point.
+        @see IntervalTreeStab */
+    int32_t (*stab) (struct _IntervalTree*, int64_t, IntervalTreeVisit, void*);
+
+    /** Visit the intervals overlapping the designated range.
+        @see IntervalTreeOverlap */
+    int32_t (*overlap) (struct _IntervalTree*, int64_t, int64_t,
+                        IntervalTreeVisit, void*);
+
+    /** Set the custom interval resource clean method.
+        @see IntervalTreeSetDestroy */
+    int32_t (*set_destroy) (struct _IntervalTree*, void (*) (Interval*));
+} IntervalTree;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief The constructor for IntervalTree.
+ *
+ * The intervals are ordered by the lower endpoints in the red black tree of
+ * TreeMap, and each node keeps the maximum upper endpoint of its subtree. The
+ * maximum is refreshed by the rotations and the deletions of the shared tree
+ * core, so the queries can skip the subtrees ending before the queried range.
+ *
+ * @param ppObj         The double pointer to the to be constructed tree
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for tree construction
+ */
+int32_t IntervalTreeInit(IntervalTree **ppObj);
+
+/**
+ * @brief The destructor for IntervalTree.
+ *
+ * If the custom resource clean method is set, it also runs the clean method
+ * for each interval.
+ *
+ * @param ppObj         The double pointer to the to be destructed tree
+ */
+void IntervalTreeDeinit(IntervalTree **ppObj);
+
+/**
+ * @brief Insert an interval into the tree.
+ *
+ * The interval is copied into the tree, so the caller may reuse the passed
+ * structure. The intervals are identified by both endpoints and the value, and
+ * inserting an interval already stored leaves the tree unchanged.
+ *
+ * @param self          The pointer to IntervalTree structure
+ * @param pInterval     The pointer to the designated interval
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal interval whose lower endpoint exceeds the upper
+ *                      one
+ * @retval ERR_NOMEM    Insufficient memory for tree extension
+ */
+int32_t IntervalTreePut(IntervalTree *self, Interval *pInterval);
+
+/**
+ * @brief Check if the tree contains the designated interval.
+ *
+ * @param self          The pointer to IntervalTree structure
+ * @param pInterval     The pointer to the designated interval
+ *
+ * @retval SUCC         The interval can be found
+ * @retval NOKEY        The interval cannot be found
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal interval
+ */
+int32_t IntervalTreeFind(IntervalTree *self, Interval *pInterval);
+
+/**
+ * @brief Delete the designated interval.
+ *
+ * @param self          The pointer to IntervalTree structure
+ * @param pInterval     The pointer to the designated interval
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal interval
+ * @retval ERR_NODATA   No tree entry can be found
+ */
+int32_t IntervalTreeRemove(IntervalTree *self, Interval *pInterval);
+
+/**
+ * @brief Return the number of stored intervals.
+ *
+ * @param self          The pointer to IntervalTree structure
+ *
+ * @return              The number of stored intervals
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t IntervalTreeSize(IntervalTree *self);
+
+/**
+ * @brief Visit the intervals containing the designated point in the ascending
+ * order of the lower endpoints.
+ *
+ * @param self          The pointer to IntervalTree structure
+ * @param lPoint        The designated point
+ * @param pVisit        The visitor for the reported intervals
+ * @param pArg          The argument passed to the visitor
+ *
+ * @return              The number of visited intervals
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid visitor
+ *
+ * @note The tree should not be modified by the visitor.
+ */
+int32_t IntervalTreeStab(IntervalTree *self, int64_t lPoint,
+                         IntervalTreeVisit pVisit, void *pArg);
+
+/**
+ * @brief Visit the intervals overlapping the range [lLow, lHigh] in the
+ * ascending order of the lower endpoints.
+ *
+ * The query descends only into the subtrees whose maximum upper endpoint
+ * reaches the range and whose lower endpoints may not exceed it. Reporting k
+ * intervals costs O(min(n, k log n)) in the worst case, and close to
+ * O(log n + k) when the matching intervals are clustered.
+ *
+ * @param self          The pointer to IntervalTree structure
+ * @param lLow          The inclusive lower endpoint of the range
+ * @param lHigh         The inclusive upper endpoint of the range
+ * @param pVisit        The visitor for the reported intervals
+ * @param pArg          The argument passed to the visitor
+ *
+ * @return              The number of visited intervals
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal range
+ * @retval ERR_GET      Invalid visitor
+ *
+ * @note The tree should not be modified by the visitor.
+ */
+int32_t IntervalTreeOverlap(IntervalTree *self, int64_t lLow, int64_t lHigh,
+                            IntervalTreeVisit pVisit, void *pArg);
+
+/**
+ * @brief Set the custom interval resource clean method.
+ *
+ * The method receives the copy stored in the tree, and should release only
+ * the resource referred to by the interval.
+ *
+ * @param self          The pointer to IntervalTree structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t IntervalTreeSetDestroy(IntervalTree *self, void (*pFunc) (Interval*));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -6,6 +6,7 @@
 #define _QUEUE_H_
 
 #include "../util.h"
+#include "../memory/storage.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,6 +43,10 @@ typedef struct _Queue {
     /** Set the custom item resource clean method.
         @see QueueSetDestroy */
     int32_t (*set_destroy) (struct _Queue*, void (*) (Item));
+
+    /** Move the items to the storage with the designated mode.
+        @see QueueSetStorage */
+    int32_t (*set_storage) (struct _Queue*, int32_t, const char*);
 } Queue;
 
 
@@ -153,6 +158,24 @@ int32_t QueueSize(Queue *self);
  */
 int32_t QueueSetDestroy(Queue *self, void (*pFunc) (Item));
 
+/**
+ * @brief Move the items to the storage with the designated mode.
+ *
+ * The mode can be STORAGE_HEAP, STORAGE_HUGE_PAGE, or STORAGE_FILE. Afterward,
+ * the storage is extended within the same mode.
+ *
+ * @param self          The pointer to Queue structure
+ * @param iMode         The designated storage mode
+ * @param szPath        The path of the backing file for STORAGE_FILE mode
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_POLICY   Illegal or unsupported storage mode
+ * @retval ERR_NOMEM    Insufficient memory for the new storage
+ * @retval ERR_IO       Fail to create the backing file
+ */
+int32_t QueueSetStorage(Queue *self, int32_t iMode, const char *szPath);
+
 #ifdef __cplusplus
 }
 #endif
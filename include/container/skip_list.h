@@ -0,0 +1,279 @@
+/**
+ * @file skip_list.h The lock free ordered map shared by concurrent readers and
+ * writers.
+ */
+
+#ifndef _SKIP_LIST_H_
+#define _SKIP_LIST_H_
+
+#include "../util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** SkipListData is the data type for the container private information. */
+typedef struct _SkipListData SkipListData;
+
+/** The iterator owned by one thread to scan the list in the key order. */
+typedef struct _SkipListIter {
+    /** The epoch ticket of the thread while the iterator is open */
+    uint32_t uiTicket;
+    /** Whether the iterator is open */
+    bool bOpen;
+    /** Whether the scan stops at keyEnd */
+    bool bBound;
+    /** The exclusive upper boundary of the range scan */
+    Key keyEnd;
+    /** The next node to visit, maintained by the list */
+    void *pNode;
+} SkipListIter;
+
+/** The implementation for lock free skip list. */
+typedef struct _SkipList {
+    /** The container private information */
+    SkipListData *pData;
+
+    /** Insert a key value pair into the list.
+        @see SkipListPut */
+    int32_t (*put) (struct _SkipList*, Pair*);
+
+    /** Retrieve the value corresponding to the designated key.
+        @see SkipListGet */
+    int32_t (*get) (struct _SkipList*, Key, Value*);
+
+    /** Check if the list contains the designated key.
+        @see SkipListFind */
+    int32_t (*find) (struct _SkipList*, Key);
+
+    /** Delete the key value pair corresponding to the designated key.
+        @see SkipListRemove */
+    int32_t (*remove) (struct _SkipList*, Key);
+
+    /** Return the number of stored key value pairs.
+        @see SkipListSize */
+    int32_t (*size) (struct _SkipList*);
+
+    /** Open the iterator to scan all the pairs.
+        @see SkipListIterOpen */
+    int32_t (*iter_open) (struct _SkipList*, SkipListIter*);
+
+    /** Open the iterator to scan the pairs in the given key range.
+        @see SkipListIterRange */
+    int32_t (*iter_range) (struct _SkipList*, SkipListIter*, Key, Key);
+
+    /** Retrieve the next pair from the iterator.
+        @see SkipListIterNext */
+    int32_t (*iter_next) (struct _SkipList*, SkipListIter*, Pair**);
+
+    /** Close the iterator.
+        @see SkipListIterClose */
+    int32_t (*iter_close) (struct _SkipList*, SkipListIter*);
+
+    /** Set the custom key comparison method.
+        @see SkipListSetCompare */
+    int32_t (*set_compare) (struct _SkipList*, int32_t (*) (Key, Key));
+
+    /** Set the custom key value pair resource clean method.
+        @see SkipListSetDestroy */
+    int32_t (*set_destroy) (struct _SkipList*, void (*) (Pair*));
+} SkipList;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief The constructor for SkipList.
+ *
+ * All the operations are lock free. The writers link and unlink the nodes with
+ * atomic compare and swap, the deleted nodes are first marked and then
+ * unlinked by any thread passing by, and the unlinked nodes are reclaimed
+ * through the epoch domain of the list once no thread can reach them.
+ *
+ * @param ppObj         The double pointer to the to be constructed list
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for list construction
+ */
+int32_t SkipListInit(SkipList **ppObj);
+
+/**
+ * @brief The destructor for SkipList.
+ *
+ * If the custom resource clean method is set, it also runs the clean method
+ * for each pair. No other thread should access the list.
+ *
+ * @param ppObj         The double pointer to the to be destructed list
+ */
+void SkipListDeinit(SkipList **ppObj);
+
+/**
+ * @brief Insert a key value pair into the list.
+ *
+ * This function inserts a key value pair into the list. If the order of the
+ * designated pair is the same with a certain one stored in the list, that pair
+ * will be replaced. The replaced pair is passed to the custom resource clean
+ * method after no thread can see it.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param pPair         The pointer to the designated pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for list extension
+ */
+int32_t SkipListPut(SkipList *self, Pair *pPair);
+
+/**
+ * @brief Retrieve the value corresponding to the designated key.
+ *
+ * If the custom resource clean method releases the values, the value should
+ * be accessed through an iterator instead, which keeps it alive until the
+ * iterator is closed.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param key           The designated key
+ * @param pValue        The pointer to the returned value
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No list entry can be found
+ * @retval ERR_GET      Invalid parameter to store returned value
+ */
+int32_t SkipListGet(SkipList *self, Key key, Value *pValue);
+
+/**
+ * @brief Check if the list contains the designated key.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param key           The designated key
+ *
+ * @retval SUCC         The key can be found
+ * @retval NOKEY        The key cannot be found
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t SkipListFind(SkipList *self, Key key);
+
+/**
+ * @brief Delete the key value pair corresponding to the designated key.
+ *
+ * The deleted pair is passed to the custom resource clean method after no
+ * thread can see it.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param key           The designated key
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No list entry can be found
+ */
+int32_t SkipListRemove(SkipList *self, Key key);
+
+/**
+ * @brief Return the number of stored key value pairs.
+ *
+ * The result is exact when no writer is active, and approximate otherwise.
+ *
+ * @param self          The pointer to SkipList structure
+ *
+ * @return              The number of stored pairs
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t SkipListSize(SkipList *self);
+
+/**
+ * @brief Open the iterator to scan all the pairs in the ascending key order.
+ *
+ * The scan is weakly consistent. It returns each pair which stays in the list
+ * during the whole scan exactly once and in order, and may or may not return
+ * the pairs inserted or deleted concurrently. The returned pairs stay alive
+ * until the iterator is closed by the same thread, so the iterator should be
+ * kept short since it delays the reclamation.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param pIter         The pointer to the iterator owned by the calling thread
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the iterator
+ */
+int32_t SkipListIterOpen(SkipList *self, SkipListIter *pIter);
+
+/**
+ * @brief Open the iterator to scan the pairs whose keys fall in the range
+ * [keyBgn, keyEnd) in the ascending key order.
+ *
+ * The iterator is positioned at the lower bound of keyBgn, so the whole scan
+ * costs O(log n + k) for k pairs in the range. It follows the same consistency
+ * as SkipListIterOpen.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param pIter         The pointer to the iterator owned by the calling thread
+ * @param keyBgn        The inclusive lower boundary of the range
+ * @param keyEnd        The exclusive upper boundary of the range
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the iterator
+ */
+int32_t SkipListIterRange(SkipList *self, SkipListIter *pIter, Key keyBgn,
+                          Key keyEnd);
+
+/**
+ * @brief Retrieve the next pair from the iterator.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param pIter         The pointer to the iterator
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval CONTINUE     Iteration in progress
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid iterator or parameter to store returned pair
+ */
+int32_t SkipListIterNext(SkipList *self, SkipListIter *pIter, Pair **ppPair);
+
+/**
+ * @brief Close the iterator.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param pIter         The pointer to the iterator
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid or already closed iterator
+ */
+int32_t SkipListIterClose(SkipList *self, SkipListIter *pIter);
+
+/**
+ * @brief Set the custom key comparison method.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ *
+ * @note It should be set before the list is shared with other threads.
+ */
+int32_t SkipListSetCompare(SkipList *self, int32_t (*pFunc) (Key, Key));
+
+/**
+ * @brief Set the custom key value pair resource clean method.
+ *
+ * @param self          The pointer to SkipList structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ *
+ * @note It should be set before the list is shared with other threads.
+ */
+int32_t SkipListSetDestroy(SkipList *self, void (*pFunc) (Pair*));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * @file succinct_trie.h The read only string dictionary encoded by the level
+ * order unary degree sequence.
+ */
+
+#ifndef _SUCCINCT_TRIE_H_
+#define _SUCCINCT_TRIE_H_
+
+#include "../util.h"
+#include "trie.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** SuccinctTrieData is the data type for the container private information. */
+typedef struct _SuccinctTrieData SuccinctTrieData;
+
+/** The implementation for succinct trie. */
+typedef struct _SuccinctTrie {
+    /** The container private information */
+    SuccinctTrieData *pData;
+
+    /** Replace the trie content with the strings of Trie.
+        @see SuccinctTrieBuild */
+    int32_t (*build) (struct _SuccinctTrie*, Trie*);
+
+    /** Check if the trie contains the designated string.
+        @see SuccinctTrieHasExact */
+    int32_t (*has_exact) (struct _SuccinctTrie*, char*);
+
+    /** Check if the trie contains the strings matching the designated prefix.
+        @see SuccinctTrieHasPrefixAs */
+    int32_t (*has_prefix_as) (struct _SuccinctTrie*, char*);
+
+    /** Retrieve the strings from the trie matching the designated prefix.
+        @see SuccinctTrieGetPrefixAs */
+    int32_t (*get_prefix_as) (struct _SuccinctTrie*, char*, char***, int*);
+
+    /** Return the number of strings stored in the trie.
+        @see SuccinctTrieSize */
+    int32_t (*size) (struct _SuccinctTrie*);
+
+    /** Report the number of nodes and the memory held by the trie.
+        @see SuccinctTrieGetStat */
+    int32_t (*get_stat) (struct _SuccinctTrie*, TrieStat*);
+} SuccinctTrie;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief The constructor for SuccinctTrie.
+ *
+ * The constructed trie is empty until it is built from a Trie.
+ *
+ * @param ppObj         The double pointer to the to be constructed trie
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for trie construction
+ */
+int32_t SuccinctTrieInit(SuccinctTrie **ppObj);
+
+/**
+ * @brief The destructor for SuccinctTrie.
+ *
+ * @param ppObj         The double pointer to the to be destructed trie
+ */
+void SuccinctTrieDeinit(SuccinctTrie **ppObj);
+
+/**
+ * @brief Replace the trie content with the strings of Trie.
+ *
+ * The strings are drawn from the trie in either node layout, and the nodes of
+ * the character trie holding them are numbered in the level order. Each node
+ * writes one 1 bit per child followed by a 0 bit into the LOUDS bit vector,
+ * so the children of the node x occupy the run of 1 bits after the x-th 0 bit
+ * and the run is located by the select operation. The edge labels follow the
+ * same order in the label array, and one more bit per node marks the end of
+ * a string. The whole trie takes about 10 bits per node plus the rank and the
+ * select directories, at the cost of the bit operations on each byte.
+ *
+ * @param self          The pointer to SuccinctTrie structure
+ * @param pTrie         The pointer to the source Trie
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container or Trie
+ * @retval ERR_NOMEM    Insufficient memory to collect the strings or to encode
+ *                      the trie
+ *
+ * @note The trie is not modified if the function fails.
+ */
+int32_t SuccinctTrieBuild(SuccinctTrie *self, Trie *pTrie);
+
+/**
+ * @brief Check if the trie contains the designated string.
+ *
+ * @param self          The pointer to SuccinctTrie structure
+ * @param str           The designated string
+ *
+ * @retval SUCC
+ * @retval NOKEY
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t SuccinctTrieHasExact(SuccinctTrie *self, char *str);
+
+/**
+ * @brief Check if the trie contains the strings matching the designated prefix.
+ *
+ * @param self          The pointer to SuccinctTrie structure
+ * @param str           The designated prefix
+ *
+ * @retval SUCC
+ * @retval NOKEY
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t SuccinctTrieHasPrefixAs(SuccinctTrie *self, char *str);
+
+/**
+ * @brief Retrieve the strings from the trie matching the designated prefix.
+ *
+ * It follows the same protocol as TrieGetPrefixAs. The returned strings are
+ * sorted in the ascending byte order as strcmp.
+ *
+ * @param self          The pointer to SuccinctTrie structure
+ * @param str           The designated prefix
+ * @param paStr         The pointer to the returned array of strings
+ * @param piNum         The pointer to the returned array size
+ *
+ * @retval SUCC
+ * @retval NOKEY
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned data
+ * @retval ERR_NOMEM    Insufficient memory to store the resolved strings
+ *
+ * @note Please remember to free the following resource:
+ *       - Each returned string
+ *       - The array to store returned strings
+ */
+int32_t SuccinctTrieGetPrefixAs(SuccinctTrie *self, char *str, char ***paStr,
+                                int *piNum);
+
+/**
+ * @brief Return the number of strings stored in the trie.
+ *
+ * @param self          The pointer to SuccinctTrie structure
+ *
+ * @return              The number of strings
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t SuccinctTrieSize(SuccinctTrie *self);
+
+/**
+ * @brief Report the number of nodes and the memory held by the trie.
+ *
+ * The bytes count the bit vectors, the label array, and the rank and the
+ * select directories.
+ *
+ * @param self          The pointer to SuccinctTrie structure
+ * @param pStat         The pointer to the returned statistics
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned statistics
+ */
+int32_t SuccinctTrieGetStat(SuccinctTrie *self, TrieStat *pStat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -14,6 +14,43 @@ extern "C" {
 /** TreeMapData is the data type for the container private information. */
 typedef struct _TreeMapData TreeMapData;
 
+/** The cursor to traverse the map independently of the built-in iterators. */
+typedef struct _TreeMapCursor {
+    /** The node the cursor stays on, or NULL if the cursor is exhausted */
+    void *pNode;
+} TreeMapCursor;
+
+/** The nodes refer to the pairs allocated by the caller. */
+static const int32_t TREE_MAP_PAIR_REFER = 0;
+
+/** The nodes keep the copies of the key and value pointers. */
+static const int32_t TREE_MAP_PAIR_INLINE = 1;
+
+/** The nodes keep the copies, and the keys are signed integers compared in
+    place without the comparison method. */
+static const int32_t TREE_MAP_PAIR_INTEGER = 2;
+
+/** The maximum height of the tree, which bounds the snapshot iteration. */
+#define TREE_MAP_SNAPSHOT_DEPTH     (64)
+
+/** The read only version of the map taken by TreeMapSnapshotTake. All the
+    fields are maintained by the map. */
+typedef struct _TreeMapSnapshot {
+    /** The root of the version, or NULL if the snapshot is released */
+    void *pRoot;
+    /** The last record of the pairs retired while the snapshot is the newest */
+    void *pRetire;
+    /** The neighboring snapshots of the same map in the taken order */
+    struct _TreeMapSnapshot *pPrev;
+    struct _TreeMapSnapshot *pNext;
+    /** The number of pairs in the version */
+    int32_t iSize;
+    /** The number of nodes in the iteration stack */
+    int32_t iDepth;
+    /** The ancestors of the next iterated node */
+    void *aStack[TREE_MAP_SNAPSHOT_DEPTH];
+} TreeMapSnapshot;
+
 /** The implementation for ordered map. */
 typedef struct _TreeMap {
     /** The container private information */
@@ -23,6 +60,10 @@ typedef struct _TreeMap {
         @see TreeMapPut */
     int32_t (*put) (struct _TreeMap*, Pair*);
 
+    /** Replace the map content with an array of key value pairs.
+        @see TreeMapBuild */
+    int32_t (*build) (struct _TreeMap*, Pair**, int32_t);
+
     /** Retrieve the value corresponding to the designated key.
         @see TreeMapGet */
     int32_t (*get) (struct _TreeMap*, Key, Value*);
@@ -55,6 +96,16 @@ typedef struct _TreeMap {
         @see TreeMapSuccessor */
     int32_t (*successor) (struct _TreeMap*, Key, Pair**);
 
+    /** Retrieve the first key value pair whose key is not ordered before the
+        given key.
+        @see TreeMapLowerBound */
+    int32_t (*lower_bound) (struct _TreeMap*, Key, Pair**);
+
+    /** Retrieve the first key value pair whose key is ordered after the given
+        key.
+        @see TreeMapUpperBound */
+    int32_t (*upper_bound) (struct _TreeMap*, Key, Pair**);
+
     /** Iterate through the map from the minimum order to the maximum order.
         @see TreeMapIterate */
     int32_t (*iterate) (struct _TreeMap*, bool, Pair**);
@@ -63,6 +114,79 @@ typedef struct _TreeMap {
         @see TreeMapReverseIterate */
     int32_t (*reverse_iterate) (struct _TreeMap*, bool, Pair**);
 
+    /** Iterate through the pairs whose keys fall in the given range.
+        @see TreeMapIterateRange */
+    int32_t (*iterate_range) (struct _TreeMap*, bool, Key, Key, Pair**);
+
+    /** Return the number of pairs whose keys fall in the given range.
+        @see TreeMapCountRange */
+    int32_t (*count_range) (struct _TreeMap*, Key, Key);
+
+    /** Position the cursor at the pair with the minimum order.
+        @see TreeMapCursorFirst */
+    int32_t (*cursor_first) (struct _TreeMap*, TreeMapCursor*);
+
+    /** Position the cursor at the pair with the maximum order.
+        @see TreeMapCursorLast */
+    int32_t (*cursor_last) (struct _TreeMap*, TreeMapCursor*);
+
+    /** Position the cursor at the lower bound of the given key.
+        @see TreeMapCursorSeek */
+    int32_t (*cursor_seek) (struct _TreeMap*, Key, TreeMapCursor*);
+
+    /** Retrieve the pair at the cursor and move the cursor to its successor.
+        @see TreeMapCursorNext */
+    int32_t (*cursor_next) (struct _TreeMap*, TreeMapCursor*, Pair**);
+
+    /** Retrieve the pair at the cursor and move the cursor to its predecessor.
+        @see TreeMapCursorPrev */
+    int32_t (*cursor_prev) (struct _TreeMap*, TreeMapCursor*, Pair**);
+
+    /** Return the number of keys ordered before the given key.
+        @see TreeMapRank */
+    int32_t (*rank) (struct _TreeMap*, Key);
+
+    /** Retrieve the key value pair with the given rank.
+        @see TreeMapSelect */
+    int32_t (*select) (struct _TreeMap*, int32_t, Pair**);
+
+    /** Move all the pairs of another map whose keys do not overlap.
+        @see TreeMapJoin */
+    int32_t (*join) (struct _TreeMap*, struct _TreeMap*);
+
+    /** Move the pairs not ordered before the given key to another map.
+        @see TreeMapSplit */
+    int32_t (*split) (struct _TreeMap*, Key, struct _TreeMap*);
+
+    /** Move all the pairs of another map with the key collisions resolved.
+        @see TreeMapMerge */
+    int32_t (*merge) (struct _TreeMap*, struct _TreeMap*);
+
+    /** Pin the current version of the map as a read only snapshot.
+        @see TreeMapSnapshotTake */
+    int32_t (*snapshot_take) (struct _TreeMap*, TreeMapSnapshot*);
+
+    /** Release the snapshot.
+        @see TreeMapSnapshotRelease */
+    int32_t (*snapshot_release) (struct _TreeMap*, TreeMapSnapshot*);
+
+    /** Retrieve the value corresponding to the designated key in the snapshot.
+        @see TreeMapSnapshotGet */
+    int32_t (*snapshot_get) (struct _TreeMap*, TreeMapSnapshot*, Key, Value*);
+
+    /** Iterate through the snapshot in the ascending key order.
+        @see TreeMapSnapshotIterate */
+    int32_t (*snapshot_iterate) (struct _TreeMap*, TreeMapSnapshot*, bool,
+                                 Pair**);
+
+    /** Position the snapshot iteration at the lower bound of the given key.
+        @see TreeMapSnapshotSeek */
+    int32_t (*snapshot_seek) (struct _TreeMap*, TreeMapSnapshot*, Key);
+
+    /** Return the number of pairs in the snapshot.
+        @see TreeMapSnapshotSize */
+    int32_t (*snapshot_size) (struct _TreeMap*, TreeMapSnapshot*);
+
     /** Set the custom key comparison method.
         @see TreeMapSetCompare */
     int32_t (*set_compare) (struct _TreeMap*, int32_t (*) (Key, Key));
@@ -70,6 +194,14 @@ typedef struct _TreeMap {
     /** Set the custom key value pair resource clean method.
         @see TreeMapSetDestroy */
     int32_t (*set_destroy) (struct _TreeMap*, void (*) (Pair*));
+
+    /** Enable or disable the subtree count augmentation.
+        @see TreeMapSetOrderStatistic */
+    int32_t (*set_order_statistic) (struct _TreeMap*, bool);
+
+    /** Set the storage of the key value pairs.
+        @see TreeMapSetPairMode */
+    int32_t (*set_pair_mode) (struct _TreeMap*, int32_t);
 } TreeMap;
 
 
@@ -113,6 +245,31 @@ void TreeMapDeinit(TreeMap **ppObj);
  */
 int32_t TreeMapPut(TreeMap *self, Pair *pPair);
 
+/**
+ * @brief Replace the map content with an array of key value pairs.
+ *
+ * This function releases all the stored pairs and links the designated pairs
+ * into a balanced and properly colored red black tree in linear time. All the
+ * nodes are carved from one allocation, and the nodes released by the later
+ * deletions are reused by the later insertions. Unsorted pairs are sorted
+ * first. If several pairs share the same order, the one placed last in the
+ * array wins, and the others are passed to the custom resource clean method
+ * if it is set.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param aPair         The array of the pointers to the designated pairs
+ * @param iNum          The number of the designated pairs
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal pair array or pair count
+ * @retval ERR_NOMEM    Insufficient memory for the nodes
+ * @retval ERR_POLICY   Snapshots of the map are alive
+ *
+ * @note The map is not modified if the function fails.
+ */
+int32_t TreeMapBuild(TreeMap *self, Pair **aPair, int32_t iNum);
+
 /**
  * @brief Retrieve the value corresponding to the designated key.
  *
@@ -224,6 +381,40 @@ int32_t TreeMapPredecessor(TreeMap *self, Key key, Pair **ppPair);
  */
 int32_t TreeMapSuccessor(TreeMap *self, Key key, Pair **ppPair);
 
+/**
+ * @brief Retrieve the first key value pair whose key is not ordered before the
+ * given key.
+ *
+ * Unlike TreeMapSuccessor, the given key does not need to exist in the map.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   All the keys are ordered before the given key
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t TreeMapLowerBound(TreeMap *self, Key key, Pair **ppPair);
+
+/**
+ * @brief Retrieve the first key value pair whose key is ordered after the given
+ * key.
+ *
+ * Unlike TreeMapSuccessor, the given key does not need to exist in the map.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param key           The designated key
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No key is ordered after the given key
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t TreeMapUpperBound(TreeMap *self, Key key, Pair **ppPair);
+
 /**
  * @brief Iterate through the map from the minimum order to the maximum order.
  *
@@ -236,6 +427,9 @@ int32_t TreeMapSuccessor(TreeMap *self, Key key, Pair **ppPair);
  *  - bReset = false
  *  - pPair = the pointer to get the returned pair at each iteration.
  *
+ * The iterator keeps only the current node and advances through the parent
+ * links, so it needs no extra memory.
+ *
  * @param self          The pointer to TreeMap structure
  * @param bReset        The knob to restart the iteration
  * @param ppPair        The double pointer to the returned pair
@@ -261,6 +455,9 @@ int32_t TreeMapIterate(TreeMap *self, bool bReset, Pair **ppPair);
  *  - bReset = false
  *  - pPair = the pointer to get the returned pair at each iteration.
  *
+ * The iterator keeps only the current node and advances through the parent
+ * links, so it needs no extra memory.
+ *
  * @param self          The pointer to TreeMap structure
  * @param bReset        The knob to restart the iteration
  * @param ppPair        The double pointer to the returned pair
@@ -273,6 +470,355 @@ int32_t TreeMapIterate(TreeMap *self, bool bReset, Pair **ppPair);
  */
 int32_t TreeMapReverseIterate(TreeMap *self, bool bReset, Pair **ppPair);
 
+/**
+ * @brief Iterate through the pairs whose keys fall in the range [keyBgn, keyEnd)
+ * in the ascending key order.
+ *
+ * Before iterating through the range, it is necessary to pass:
+ *  - bReset = true
+ *  - keyBgn and keyEnd = the range boundaries
+ *  - pPair = NULL
+ * for iterator initialization. The iterator is positioned at the lower bound
+ * of keyBgn, so the whole scan costs O(log n + k) for k pairs in the range.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - keyBgn and keyEnd = ignored
+ *  - pPair = the pointer to get the returned pair at each iteration.
+ *
+ * The map should not be modified during the iteration.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param bReset        The knob to restart the iteration
+ * @param keyBgn        The inclusive lower boundary of the range
+ * @param keyEnd        The exclusive upper boundary of the range
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC         Iterator initialized or a pair returned successfully
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t TreeMapIterateRange(TreeMap *self, bool bReset, Key keyBgn, Key keyEnd,
+                            Pair **ppPair);
+
+/**
+ * @brief Return the number of pairs whose keys fall in the range
+ * [keyBgn, keyEnd).
+ *
+ * It costs O(log n) in the order statistic mode and O(log n + k) otherwise.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param keyBgn        The inclusive lower boundary of the range
+ * @param keyEnd        The exclusive upper boundary of the range
+ *
+ * @return              The number of pairs in the range
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t TreeMapCountRange(TreeMap *self, Key keyBgn, Key keyEnd);
+
+/**
+ * @brief Position the cursor at the pair with the minimum order.
+ *
+ * A cursor holds only the node it stays on, so any number of cursors can
+ * traverse the map at the same time in constant memory. Insertions and
+ * deletions of other pairs keep the cursor valid, while deleting the pair the
+ * cursor stays on invalidates it.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pCursor       The pointer to the cursor, which is exhausted for the
+ *                      empty map
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the cursor
+ */
+int32_t TreeMapCursorFirst(TreeMap *self, TreeMapCursor *pCursor);
+
+/**
+ * @brief Position the cursor at the pair with the maximum order.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pCursor       The pointer to the cursor, which is exhausted for the
+ *                      empty map
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the cursor
+ */
+int32_t TreeMapCursorLast(TreeMap *self, TreeMapCursor *pCursor);
+
+/**
+ * @brief Position the cursor at the first pair whose key is not ordered before
+ * the given key.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param key           The designated key
+ * @param pCursor       The pointer to the cursor, which is exhausted if all the
+ *                      keys are ordered before the given key
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the cursor
+ */
+int32_t TreeMapCursorSeek(TreeMap *self, Key key, TreeMapCursor *pCursor);
+
+/**
+ * @brief Retrieve the pair at the cursor and move the cursor to the successor.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pCursor       The pointer to the cursor
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval END          The cursor is exhausted
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter for the cursor or the returned pair
+ */
+int32_t TreeMapCursorNext(TreeMap *self, TreeMapCursor *pCursor, Pair **ppPair);
+
+/**
+ * @brief Retrieve the pair at the cursor and move the cursor to the
+ * predecessor.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pCursor       The pointer to the cursor
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval END          The cursor is exhausted
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter for the cursor or the returned pair
+ */
+int32_t TreeMapCursorPrev(TreeMap *self, TreeMapCursor *pCursor, Pair **ppPair);
+
+/**
+ * @brief Return the number of keys ordered before the given key.
+ *
+ * The given key does not need to exist in the map. It costs O(log n) in the
+ * order statistic mode and O(k) otherwise.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param key           The designated key
+ *
+ * @return              The rank of the key
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t TreeMapRank(TreeMap *self, Key key);
+
+/**
+ * @brief Retrieve the key value pair with the given rank, which is the number
+ * of pairs ordered before it.
+ *
+ * It costs O(log n) in the order statistic mode and O(k) otherwise.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param iIdx          The designated rank
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Out of range rank
+ * @retval ERR_GET      Invalid parameter to store returned pair
+ */
+int32_t TreeMapSelect(TreeMap *self, int32_t iIdx, Pair **ppPair);
+
+/**
+ * @brief Move all the pairs of another map into this map, given that all the
+ * keys of one map are ordered before all the keys of the other.
+ *
+ * The two trees are concatenated without touching the individual pairs, which
+ * costs O(log n). Both maps should share the same key comparison method, and
+ * the moved pairs are then cleaned by the custom resource clean method of this
+ * map. The other map is left empty.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pOther        The pointer to the map whose pairs are moved
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      The key ranges of the two maps overlap
+ * @retval ERR_NOMEM    Insufficient memory to track the shared nodes
+ * @retval ERR_POLICY   Snapshots of either map are alive, or the maps store
+ *                      the pairs in different modes
+ *
+ * @note The maps are not modified if the function fails. If only this map
+ * runs in the order statistic mode, the moved nodes are recounted first.
+ */
+int32_t TreeMapJoin(TreeMap *self, TreeMap *pOther);
+
+/**
+ * @brief Move the pairs whose keys are not ordered before the given key into
+ * another empty map.
+ *
+ * The tree is cut along the search path of the key, which costs O(log n). The
+ * sizes of the two parts come from the subtree counts in the order statistic
+ * mode. Otherwise both parts are walked in turn until the smaller one ends, so
+ * the split costs O(log n + min(k, n - k)) for the k pairs left in this map.
+ * The other map should use the same key comparison method.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param key           The designated key
+ * @param pOther        The pointer to the empty map receiving the pairs
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      The other map is not empty
+ * @retval ERR_NOMEM    Insufficient memory to track the shared nodes
+ * @retval ERR_POLICY   Snapshots of either map are alive, or the maps store
+ *                      the pairs in different modes
+ *
+ * @note The maps are not modified if the function fails. If only the other map
+ * runs in the order statistic mode, the moved nodes are recounted, which costs
+ * O(n - k).
+ */
+int32_t TreeMapSplit(TreeMap *self, Key key, TreeMap *pOther);
+
+/**
+ * @brief Move all the pairs of another map into this map.
+ *
+ * This tree is recursively split along the nodes of the other tree and joined
+ * back, which costs O(m log(n/m + 1)) for the map sizes m <= n. If a
+ * key is stored in both maps, the pair from the other map wins, and the pair
+ * of this map is passed to the custom resource clean method if it is set.
+ * Both maps should share the same key comparison method. The other map is left
+ * empty.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pOther        The pointer to the map whose pairs are moved
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Both parameters refer to the same map
+ * @retval ERR_NOMEM    Insufficient memory to track the shared nodes
+ * @retval ERR_POLICY   Snapshots of either map are alive, or the maps store
+ *                      the pairs in different modes
+ *
+ * @note If only this map runs in the order statistic mode, the moved nodes are
+ * recounted first.
+ */
+int32_t TreeMapMerge(TreeMap *self, TreeMap *pOther);
+
+/**
+ * @brief Pin the current version of the map as a read only snapshot.
+ *
+ * Taking a snapshot costs O(1). While any snapshot is alive, the insertions
+ * and the deletions turn into path copying: the nodes shared with the
+ * snapshots are copied along the modified path instead of being written, so
+ * each write produces a new root and leaves the pinned versions intact. The
+ * nodes are reference counted and reclaimed when the last version holding
+ * them is released. The replaced and the deleted pairs are passed to the
+ * custom resource clean method once no snapshot can reach them.
+ *
+ * The snapshot reading functions may run in other threads concurrently with
+ * the writes to the map without locking, since the writes never touch the
+ * node fields they read. Taking and releasing snapshots are writes themselves
+ * and must be serialized with the other writes. Each reader should use its own
+ * snapshot, which is cheap to take. The built-in iterators and the cursors of
+ * the map itself are invalidated by the writes while snapshots are alive.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pSnap         The pointer to the snapshot to fill, which must stay at
+ *                      the same address until it is released
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the snapshot
+ *
+ * @note The bulk build, join, split, and merge are refused while snapshots are
+ * alive. The snapshots still alive are released by the destructor of the map.
+ */
+int32_t TreeMapSnapshotTake(TreeMap *self, TreeMapSnapshot *pSnap);
+
+/**
+ * @brief Release the snapshot and reclaim the nodes and the pairs which are no
+ * longer reachable from any version.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pSnap         The pointer to the snapshot
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid or already released snapshot
+ */
+int32_t TreeMapSnapshotRelease(TreeMap *self, TreeMapSnapshot *pSnap);
+
+/**
+ * @brief Retrieve the value corresponding to the designated key in the
+ * snapshot.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pSnap         The pointer to the snapshot
+ * @param key           The designated key
+ * @param pValue        The pointer to the returned value
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NODATA   No map entry can be found
+ * @retval ERR_GET      Invalid snapshot or parameter to store returned value
+ */
+int32_t TreeMapSnapshotGet(TreeMap *self, TreeMapSnapshot *pSnap, Key key,
+                           Value *pValue);
+
+/**
+ * @brief Iterate through the snapshot from the minimum order to the maximum
+ * order.
+ *
+ * Before iterating through the snapshot, it is necessary to pass:
+ *  - bReset = true
+ *  - pPair = NULL
+ * for iterator initialization.
+ *
+ * After initialization, you can pass:
+ *  - bReset = false
+ *  - pPair = the pointer to get the returned pair at each iteration.
+ *
+ * The iteration state is kept in the snapshot with an explicit ancestor stack,
+ * since the nodes shared by several versions have no unique parent.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pSnap         The pointer to the snapshot
+ * @param bReset        The knob to restart the iteration
+ * @param ppPair        The double pointer to the returned pair
+ *
+ * @retval SUCC         Iterator initialized or a pair returned successfully
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid snapshot or parameter to store returned pair
+ */
+int32_t TreeMapSnapshotIterate(TreeMap *self, TreeMapSnapshot *pSnap,
+                               bool bReset, Pair **ppPair);
+
+/**
+ * @brief Position the snapshot iteration at the first pair whose key is not
+ * ordered before the given key.
+ *
+ * It replaces the iterator initialization of TreeMapSnapshotIterate, and the
+ * following iterations return the pairs from the lower bound in the ascending
+ * key order, which serves the range scans in O(log n + k).
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pSnap         The pointer to the snapshot
+ * @param key           The designated key
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid or already released snapshot
+ */
+int32_t TreeMapSnapshotSeek(TreeMap *self, TreeMapSnapshot *pSnap, Key key);
+
+/**
+ * @brief Return the number of pairs in the snapshot.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param pSnap         The pointer to the snapshot
+ *
+ * @return              The number of pairs
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid or already released snapshot
+ */
+int32_t TreeMapSnapshotSize(TreeMap *self, TreeMapSnapshot *pSnap);
+
 /**
  * @brief Set the custom key comparison method.
  *
@@ -295,6 +841,50 @@ int32_t TreeMapSetCompare(TreeMap *self, int32_t (*pFunc) (Key, Key));
  */
 int32_t TreeMapSetDestroy(TreeMap *self, void (*pFunc) (Pair*));
 
+/**
+ * @brief Enable or disable the order statistic mode.
+ *
+ * In this mode, each node keeps the number of nodes in its subtree. The counts
+ * are maintained by the insertion, the deletion, and the rotations of the
+ * rebalancing, which turns rank, select, and range count into O(log n)
+ * operations. Enabling the mode on a non-empty map recounts all the nodes.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param bEnable       Whether to maintain the subtree counts
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t TreeMapSetOrderStatistic(TreeMap *self, bool bEnable);
+
+/**
+ * @brief Set the storage of the key value pairs.
+ *
+ * By default, each node refers to the pair passed by the caller, so the search
+ * loads the pair before comparing its key. In the TREE_MAP_PAIR_INLINE mode,
+ * the insertion copies the key and value pointers into the node instead, and
+ * the caller may reuse or release the passed Pair structure right after the
+ * call. The pairs returned by the map then point into the nodes, and the
+ * custom resource clean method should release only the key and the value. The
+ * TREE_MAP_PAIR_INTEGER mode further treats the keys as signed integers cast
+ * to pointers, and compares them in place instead of calling the comparison
+ * method. The inline copy adds the size of a Pair to each node, which the
+ * nodes of the TREE_MAP_PAIR_REFER mode leave out.
+ *
+ * @param self          The pointer to TreeMap structure
+ * @param iMode         TREE_MAP_PAIR_REFER, TREE_MAP_PAIR_INLINE, or
+ *                      TREE_MAP_PAIR_INTEGER
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_POLICY   Illegal mode, or the map is not empty, or snapshots of
+ *                      the map are alive
+ *
+ * @note Setting the custom key comparison method afterwards leaves the
+ * TREE_MAP_PAIR_INTEGER mode for the TREE_MAP_PAIR_INLINE mode.
+ */
+int32_t TreeMapSetPairMode(TreeMap *self, int32_t iMode);
+
 #ifdef __cplusplus
 }
 #endif
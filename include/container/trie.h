@@ -13,6 +13,21 @@ extern "C" {
 /** TrieData is the data type for the container private information. */
 typedef struct TrieData_ TrieData;
 
+/** Each node of the ternary search tree holds one character of the strings. */
+static const int32_t TRIE_MODE_TERNARY = 0;
+
+/** Each node of the path compressed radix trie holds a span of characters
+    kept in the label arena. */
+static const int32_t TRIE_MODE_RADIX = 1;
+
+/** The footprint of the trie reported by TrieGetStat. */
+typedef struct _TrieStat {
+    /** The number of allocated nodes */
+    int64_t lCountNode;
+    /** The bytes held by the nodes and the label arena */
+    int64_t lCountByte;
+} TrieStat;
+
 /** The implementation for trie. */
 typedef struct _Trie {
     /** The container private information. */
@@ -45,6 +60,14 @@ typedef struct _Trie {
     /** Return the number of strings stored in the trie.
         @see TrieSize */
     int32_t (*size) (struct _Trie*);
+
+    /** Set the node layout of the trie.
+        @see TrieSetMode */
+    int32_t (*set_mode) (struct _Trie*, int32_t);
+
+    /** Report the number of nodes and the memory held by the trie.
+        @see TrieGetStat */
+    int32_t (*get_stat) (struct _Trie*, TrieStat*);
 } Trie;
 
 
@@ -168,6 +191,47 @@ int32_t TrieRemove(Trie *self, char *str);
  */
 int32_t TrieSize(Trie *self);
 
+/**
+ * @brief Set the node layout of the trie.
+ *
+ * By default, the trie is a ternary search tree which allocates one node for
+ * each character. In the TRIE_MODE_RADIX mode, the chains of the single child
+ * nodes are collapsed into one node whose edge label is a span of the label
+ * arena, so the number of nodes is bounded by twice the number of strings. The
+ * children of a radix node are chained in the ascending order of their first
+ * characters. The removal prunes and merges the radix nodes, and the label of
+ * a merged node is appended to the arena. Once the characters left behind
+ * outweigh the live labels, the removal re-packs the arena, so the arena stays
+ * within twice the live labels under any churn of the strings.
+ *
+ * The exported operations keep the same semantics in both modes.
+ *
+ * @param self          The pointer to Trie structure
+ * @param iMode         TRIE_MODE_TERNARY or TRIE_MODE_RADIX
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for the radix root
+ * @retval ERR_POLICY   Illegal mode, or the trie is not empty
+ */
+int32_t TrieSetMode(Trie *self, int32_t iMode);
+
+/**
+ * @brief Report the number of nodes and the memory held by the trie.
+ *
+ * The bytes count the node structures and the capacity of the label arena,
+ * but not the bookkeeping of the memory allocator. Note that the ternary
+ * search tree keeps the nodes of the removed strings.
+ *
+ * @param self          The pointer to Trie structure
+ * @param pStat         The pointer to the returned statistics
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned statistics
+ */
+int32_t TrieGetStat(Trie *self, TrieStat *pStat);
+
 #ifdef __cplusplus
 }
 #endif
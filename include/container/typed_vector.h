@@ -0,0 +1,373 @@
+/**
+ * @file typed_vector.h The dynamically growable array storing fixed size
+ * elements by value.
+ */
+
+#ifndef _TYPED_VECTOR_H_
+#define _TYPED_VECTOR_H_
+
+#include "../util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** TypedVectorData is the data type for the container private information. */
+typedef struct _TypedVectorData TypedVectorData;
+
+/** The implementation for dynamically growable array with inline elements. */
+typedef struct _TypedVector {
+    /** The container private information */
+    TypedVectorData *pData;
+
+    /** Push an element to the tail of the vector.
+        @see TypedVectorPushBack */
+    int32_t (*push_back) (struct _TypedVector*, const void*);
+
+    /** Reserve an element slot at the tail of the vector.
+        @see TypedVectorEmplaceBack */
+    int32_t (*emplace_back) (struct _TypedVector*, void**);
+
+    /** Insert an element to the designated index of the vector.
+        @see TypedVectorInsert */
+    int32_t (*insert) (struct _TypedVector*, const void*, int32_t);
+
+    /** Pop an element from the tail of the vector.
+        @see TypedVectorPopBack */
+    int32_t (*pop_back) (struct _TypedVector*);
+
+    /** Remove an element from the designated index of the vector.
+        @see TypedVectorRemove */
+    int32_t (*remove) (struct _TypedVector*, int32_t);
+
+    /** Set an element at the designated index of the vector.
+        @see TypedVectorSet */
+    int32_t (*set) (struct _TypedVector*, const void*, int32_t);
+
+    /** Copy an element from the designated index of the vector.
+        @see TypedVectorGet */
+    int32_t (*get) (struct _TypedVector*, void*, int32_t);
+
+    /** Get the address of the element at the designated index of the vector.
+        @see TypedVectorAt */
+    int32_t (*at) (struct _TypedVector*, void**, int32_t);
+
+    /** Change the container capacity.
+        @see TypedVectorResize */
+    int32_t (*resize) (struct _TypedVector*, int32_t);
+
+    /** Return the number of stored elements.
+        @see TypedVectorSize */
+    int32_t (*size) (struct _TypedVector*);
+
+    /** Return the container capacity.
+        @see TypedVectorCapacity */
+    int32_t (*capacity) (struct _TypedVector*);
+
+    /** Return the size of a single element in bytes.
+        @see TypedVectorElementSize */
+    int32_t (*element_size) (struct _TypedVector*);
+
+    /** Sort the elements via the designated element comparison method.
+        @see TypedVectorSort */
+    int32_t (*sort) (struct _TypedVector*, int32_t (*) (const void*, const void*));
+
+    /** Iterate through the vector till the tail end.
+        @see TypedVectorIterate */
+    int32_t (*iterate) (struct _TypedVector*, bool, void**);
+
+    /** Reversely iterate through the vector till the head end.
+        @see TypedVectorReverseIterate */
+    int32_t (*reverse_iterate) (struct _TypedVector*, bool, void**);
+
+    /** Set the custom element resource clean method.
+        @see TypedVectorSetDestroy */
+    int32_t (*set_destroy) (struct _TypedVector*, void (*) (void*));
+} TypedVector;
+
+
+/*===========================================================================*
+ *             Definition for the exported member operations                 *
+ *===========================================================================*/
+/**
+ * @brief The constructor for TypedVector.
+ *
+ * @param ppObj         The double pointer to the to be constructed vector
+ * @param iSizeElem     The size of a single element in bytes
+ * @param iCap          The designated initial capacity
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for vector construction
+ * @retval ERR_ELEMSIZE Illegal element size
+ *
+ * @note Specify iCap to 0 for default initial capacity.
+ */
+int32_t TypedVectorInit(TypedVector **ppObj, int32_t iSizeElem, int32_t iCap);
+
+/**
+ * @brief The destructor for TypedVector.
+ *
+ * If the custom resource clean method is set, it also runs the clean method for
+ * all the elements.
+ *
+ * @param ppObj         The double pointer to the to be destructed vector
+ */
+void TypedVectorDeinit(TypedVector **ppObj);
+
+/**
+ * @brief Push an element to the tail of the vector.
+ *
+ * This function copies the element pointed by the second parameter to the tail
+ * of the vector. If the storage is full, the space reallocation is automatically
+ * triggered to store the newly pushed element.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param pElem         The pointer to the designated element
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for vector extension
+ */
+int32_t TypedVectorPushBack(TypedVector *self, const void *pElem);
+
+/**
+ * @brief Reserve an element slot at the tail of the vector.
+ *
+ * This function extends the vector by one element and returns the address of
+ * the new slot so that the caller can construct the element in place. The
+ * content of the slot is zero filled.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param ppElem        The pointer to the returned element address
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for vector extension
+ * @retval ERR_GET      Invalid parameter to store returned address
+ *
+ * @note The returned address is invalidated by any subsequent operation which
+ * may change the container capacity.
+ */
+int32_t TypedVectorEmplaceBack(TypedVector *self, void **ppElem);
+
+/**
+ * @brief Insert an element to the designated index of the vector.
+ *
+ * This function copies the element to the designated index of the vector and
+ * shifts the trailing elements one position to the tail.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param pElem         The pointer to the designated element
+ * @param iIdx          The designated index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for vector extension
+ * @retval ERR_IDX      Illegal index
+ *
+ * @note The designated index should be equal to or smaller than the vector
+ * size and should not be negative. If the index is equal to the vector size,
+ * the effect is equivalent to push_back().
+ */
+int32_t TypedVectorInsert(TypedVector *self, const void *pElem, int32_t iIdx);
+
+/**
+ * @brief Pop an element from the tail of the vector.
+ *
+ * If the custom resource clean method is set, it also runs the clean method for
+ * the removed element.
+ *
+ * @param self          The pointer to the TypedVector structure
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Empty vector
+ */
+int32_t TypedVectorPopBack(TypedVector *self);
+
+/**
+ * @brief Delete an element from the designated index of the vector.
+ *
+ * This function removes an element from the designated index of the vector and
+ * shifts the trailing elements one position to the head. If the custom resource
+ * clean method is set, it also runs the clean method for the removed element.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param iIdx          The designated index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal index
+ */
+int32_t TypedVectorRemove(TypedVector *self, int32_t iIdx);
+
+/**
+ * @brief Set an element at the designated index of the vector.
+ *
+ * This function overwrites the element at the designated index of the vector.
+ * If the custom resource clean method is set, it also runs the clean method for
+ * the replaced element.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param pElem         The pointer to the designated element
+ * @param iIdx          The designated index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal index
+ */
+int32_t TypedVectorSet(TypedVector *self, const void *pElem, int32_t iIdx);
+
+/**
+ * @brief Copy an element from the designated index of the vector.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param pElem         The pointer to the buffer receiving the element
+ * @param iIdx          The designated index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal index
+ * @retval ERR_GET      Invalid parameter to store returned element
+ */
+int32_t TypedVectorGet(TypedVector *self, void *pElem, int32_t iIdx);
+
+/**
+ * @brief Get the address of the element at the designated index of the vector.
+ *
+ * The element can be read and updated in place through the returned address.
+ * If the index is illegal, the error code is returned and the second parameter
+ * is updated with NULL.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param ppElem        The pointer to the returned element address
+ * @param iIdx          The designated index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal index
+ * @retval ERR_GET      Invalid parameter to store returned address
+ *
+ * @note The returned address is invalidated by any subsequent operation which
+ * may change the container capacity.
+ */
+int32_t TypedVectorAt(TypedVector *self, void **ppElem, int32_t iIdx);
+
+/**
+ * @brief Change the container capacity.
+ *
+ * If the new capacity is smaller than the old size, the trailing elements will
+ * be removed. If the custom resource clean method is set, it also runs the clean
+ * method for the removed elements.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param iCap          The designated capacity
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for vector extension
+ * @retval ERR_IDX      Non-positive capacity
+ */
+int32_t TypedVectorResize(TypedVector *self, int32_t iCap);
+
+/**
+ * @brief Return the number of stored elements.
+ *
+ * @param self          The pointer to the TypedVector structure
+ *
+ * @return              The number of stored elements
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t TypedVectorSize(TypedVector *self);
+
+/**
+ * @brief Return the container capacity.
+ *
+ * @param self          The pointer to the TypedVector structure
+ *
+ * @return              The container capacity
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t TypedVectorCapacity(TypedVector *self);
+
+/**
+ * @brief Return the size of a single element in bytes.
+ *
+ * @param self          The pointer to the TypedVector structure
+ *
+ * @return              The element size
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t TypedVectorElementSize(TypedVector *self);
+
+/**
+ * @brief Sort the elements via the designated element comparison method.
+ *
+ * The comparison method receives the addresses of two elements stored in the
+ * vector, which is the same convention as qsort().
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t TypedVectorSort(TypedVector *self,
+                        int32_t (*pFunc) (const void*, const void*));
+
+/**
+ * @brief Iterate through the vector till the tail end.
+ *
+ * Before iterating through the vector, it is necessary to pass bReset := true
+ * and ppElem := NULL for iterator initialization.
+ * After initialization, you can pass bReset := false and ppElem := the relevant
+ * pointer to get the address of the element at each iteration.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param bReset        The knob to reset the iteration
+ * @param ppElem        The pointer to the returned element address
+ *
+ * @retval SUCC
+ * @retval END          At the tail end of the vector
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned address
+ */
+int32_t TypedVectorIterate(TypedVector *self, bool bReset, void **ppElem);
+
+/**
+ * @brief Reversely iterate through the vector till the head end.
+ *
+ * Before reversely iterating through the vector, it is necessary to pass
+ * bReset := true and ppElem := NULL for iterator initialization.
+ * After initialization, you can pass bReset := false and ppElem := the relevant
+ * pointer to get the address of the element at each iteration.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param bReset        The knob to reset the iteration
+ * @param ppElem        The pointer to the returned element address
+ *
+ * @retval SUCC
+ * @retval END          At the head end of the vector
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store returned address
+ */
+int32_t TypedVectorReverseIterate(TypedVector *self, bool bReset, void **ppElem);
+
+/**
+ * @brief Set the custom element resource clean method.
+ *
+ * The clean method receives the address of the element stored in the vector.
+ *
+ * @param self          The pointer to the TypedVector structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ */
+int32_t TypedVectorSetDestroy(TypedVector *self, void (*pFunc) (void*));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -6,11 +6,21 @@
 #define _VECTOR_H_
 
 #include "../util.h"
+#include "../memory/storage.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Extend the storage to double of the capacity. */
+static const int32_t VECTOR_GROW_DOUBLE = 0;
+
+/** Extend the storage to one and a half of the capacity. */
+static const int32_t VECTOR_GROW_HALF = 1;
+
+/** Extend the storage by the fixed number of items. */
+static const int32_t VECTOR_GROW_CHUNK = 2;
+
 /** VectorData is the data type for the container private information. */
 typedef struct _VectorData VectorData;
 
@@ -25,7 +35,15 @@ typedef struct _Vector {
 
     /** Insert an item to the designated index of the vector.
         @see VectorInsert */
-    int32_t (*insert) (struct _Vector*, Item, int32_t);
+    int32_t (*insert) (struct _Vector*, Item, int64_t);
+
+    /** Push an array of items to the tail of the vector.
+        @see VectorAppend */
+    int32_t (*append) (struct _Vector*, const Item*, int64_t);
+
+    /** Insert an array of items to the designated index of the vector.
+        @see VectorInsertRange */
+    int32_t (*insert_range) (struct _Vector*, const Item*, int64_t, int64_t);
 
     /** Pop an item from the tail of the vector.
         @see VectorPopBack */
@@ -33,32 +51,105 @@ typedef struct _Vector {
 
     /** Remove an item from the designated index of the vector.
         @see VectorRemove */
-    int32_t (*remove) (struct _Vector*, int32_t);
+    int32_t (*remove) (struct _Vector*, int64_t);
+
+    /** Remove a range of items starting from the designated index of the vector.
+        @see VectorRemoveRange */
+    int32_t (*remove_range) (struct _Vector*, int64_t, int64_t);
 
     /** Set an item at the designated index of the vector.
         @see VectorSet */
-    int32_t (*set) (struct _Vector*, Item, int32_t);
+    int32_t (*set) (struct _Vector*, Item, int64_t);
 
     /** Get an item from the designated index of the vector.
         @see VectorGet */
-    int32_t (*get) (struct _Vector*, Item*, int32_t);
+    int32_t (*get) (struct _Vector*, Item*, int64_t);
 
     /** Change the container capacity.
         @see VectorResize */
-    int32_t (*resize) (struct _Vector*, int32_t);
+    int32_t (*resize) (struct _Vector*, int64_t);
 
     /** Return the number of stored items.
         @see VectorSize */
-    int32_t (*size) (struct _Vector*);
+    int64_t (*size) (struct _Vector*);
 
     /** Return the container capacity.
         @see VectorCapacity */
-    int32_t (*capacity) (struct _Vector*);
+    int64_t (*capacity) (struct _Vector*);
 
     /** Sort the items via the designated item comparison method.
         @see VectorSort */
     int32_t (*sort) (struct _Vector*, int32_t (*) (const void*, const void*));
 
+    /** Sort the items and preserve the relative order of equal items.
+        @see VectorStableSort */
+    int32_t (*stable_sort) (struct _Vector*, int32_t (*) (const void*, const void*));
+
+    /** Sort the items with multiple threads.
+        @see VectorParallelSort */
+    int32_t (*parallel_sort) (struct _Vector*, int32_t (*) (const void*, const void*),
+                              int32_t);
+
+    /** Sort the items by the integer keys extracted from them.
+        @see VectorRadixSort */
+    int32_t (*radix_sort) (struct _Vector*, uint64_t (*) (Item), int32_t);
+
+    /** Place the item of the designated rank at its sorted position.
+        @see VectorNthElement */
+    int32_t (*nth_element) (struct _Vector*, int64_t,
+                            int32_t (*) (const void*, const void*));
+
+    /** Sort only the designated number of leading items.
+        @see VectorPartialSort */
+    int32_t (*partial_sort) (struct _Vector*, int64_t,
+                             int32_t (*) (const void*, const void*));
+
+    /** Copy the designated number of leading items in sorted order to an array.
+        @see VectorTopK */
+    int32_t (*top_k) (struct _Vector*, int64_t,
+                      int32_t (*) (const void*, const void*), Item*);
+
+    /** Find the first index of the designated item.
+        @see VectorFind */
+    int32_t (*find) (struct _Vector*, Item, int64_t, int64_t*);
+
+    /** Count the items equal to the designated item.
+        @see VectorCount */
+    int32_t (*count) (struct _Vector*, Item, int64_t*);
+
+    /** Find the indexes of the minimum and maximum integer items.
+        @see VectorMinMax */
+    int32_t (*min_max) (struct _Vector*, bool, int64_t*, int64_t*);
+
+    /** Append the integer items within the designated range to another vector.
+        @see VectorFilter */
+    int32_t (*filter) (struct _Vector*, struct _Vector*, Item, Item, bool);
+
+    /** Find the first index whose item is not ordered before the designated item.
+        @see VectorLowerBound */
+    int32_t (*lower_bound) (struct _Vector*, Item, int32_t (*) (const void*, const void*),
+                            int64_t*);
+
+    /** Find the first index whose item is ordered after the designated item.
+        @see VectorUpperBound */
+    int32_t (*upper_bound) (struct _Vector*, Item, int32_t (*) (const void*, const void*),
+                            int64_t*);
+
+    /** Find the index range of the items equivalent to the designated item.
+        @see VectorEqualRange */
+    int32_t (*equal_range) (struct _Vector*, Item, int32_t (*) (const void*, const void*),
+                            int64_t*, int64_t*);
+
+    /** Insert an item to the sorted vector and keep the order.
+        @see VectorInsertSorted */
+    int32_t (*insert_sorted) (struct _Vector*, Item,
+                              int32_t (*) (const void*, const void*));
+
+    /** Merge the items of another sorted vector and keep the order.
+        @see VectorMerge */
+    int32_t (*merge) (struct _Vector*, struct _Vector*,
+                      int32_t (*) (const void*, const void*));
+
     /** Iterate through the vector till the tail end.
         @see VectorIterate */
     int32_t (*iterate) (struct _Vector*, bool, Item*);
@@ -70,6 +161,14 @@ typedef struct _Vector {
     /** Set the custom item resource clean method.
         @see VectorSetDestroy */
     int32_t (*set_destroy) (struct _Vector*, void (*) (Item));
+
+    /** Set the storage growth policy.
+        @see VectorSetGrowth */
+    int32_t (*set_growth) (struct _Vector*, int32_t, int64_t);
+
+    /** Move the items to the storage with the designated mode.
+        @see VectorSetStorage */
+    int32_t (*set_storage) (struct _Vector*, int32_t, const char*);
 } Vector;
 
 
@@ -87,7 +186,7 @@ typedef struct _Vector {
  *
  * @note Specify iCap to 0 for default initial capacity.
  */
-int32_t VectorInit(Vector **ppObj, int32_t iCap);
+int32_t VectorInit(Vector **ppObj, int64_t iCap);
 
 /**
  * @brief The destructor for Vector.
@@ -135,7 +234,51 @@ int32_t VectorPushBack(Vector *self, Item item);
  * size and should not be negative. If the index is equal to the vector size,
  * the effect is equivalent to push_back().
  */
-int32_t VectorInsert(Vector *self, Item item, int32_t iIdx);
+int32_t VectorInsert(Vector *self, Item item, int64_t iIdx);
+
+/**
+ * @brief Push an array of items to the tail of the vector.
+ *
+ * This function copies the designated items to the tail of the vector in their
+ * array order. The storage is reallocated at most once, and the new capacity is
+ * at least double of the old one so that the repeated appends stay amortized.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param aItem         The array of the designated items
+ * @param iNum          The number of the designated items
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal item array or item count
+ * @retval ERR_NOMEM    Insufficient memory for vector extension
+ *
+ * @note The vector is not modified if the function fails.
+ */
+int32_t VectorAppend(Vector *self, const Item *aItem, int64_t iNum);
+
+/**
+ * @brief Insert an array of items to the designated index of the vector.
+ *
+ * This function inserts the designated items to the designated index of the
+ * vector in their array order and shifts the trailing items to the tail with a
+ * single move. The storage is reallocated at most once.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param aItem         The array of the designated items
+ * @param iNum          The number of the designated items
+ * @param iIdx          The designated index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal index, item array, or item count
+ * @retval ERR_NOMEM    Insufficient memory for vector extension
+ *
+ * @note The designated index should be equal to or smaller than the vector
+ * size and should not be negative. If the index is equal to the vector size,
+ * the effect is equivalent to append().
+ */
+int32_t VectorInsertRange(Vector *self, const Item *aItem, int64_t iNum,
+                          int64_t iIdx);
 
 /**
  * @brief Pop an item from the tail of the vector.
@@ -171,7 +314,28 @@ int32_t VectorPopBack(Vector *self);
  * should not be negative. If the index is equal to the vector size minus one,
  * the operation is equivalent to pop_back().
  */
-int32_t VectorRemove(Vector *self, int32_t iIdx);
+int32_t VectorRemove(Vector *self, int64_t iIdx);
+
+/**
+ * @brief Remove a range of items starting from the designated index of the vector.
+ *
+ * This function removes the items in the index range [iIdx, iIdx + iNum). If
+ * the custom resource clean method is set, it runs the clean method for all the
+ * removed items first. Then the trailing items are shifted to the head with a
+ * single move.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param iIdx          The designated index
+ * @param iNum          The number of items to remove
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal index range
+ *
+ * @note The whole range should lie within the vector. Removing zero items is
+ * a legal no-op.
+ */
+int32_t VectorRemoveRange(Vector *self, int64_t iIdx, int64_t iNum);
 
 /**
  * @brief Set an item at the designated index of the vector.
@@ -191,7 +355,7 @@ int32_t VectorRemove(Vector *self, int32_t iIdx);
  * @note The designated index should be smaller than the vector size and should
  * not be negative.
  */
-int32_t VectorSet(Vector *self, Item item, int32_t iIdx);
+int32_t VectorSet(Vector *self, Item item, int64_t iIdx);
 
 /**
  * @brief Get an item from the designated index of the vector.
@@ -212,7 +376,7 @@ int32_t VectorSet(Vector *self, Item item, int32_t iIdx);
  * @note The designated index should be smaller than the vector size and should
  * not be negative.
  */
-int32_t VectorGet(Vector *self, Item *pItem, int32_t iIdx);
+int32_t VectorGet(Vector *self, Item *pItem, int64_t iIdx);
 
 /**
  * @brief Change the container capacity.
@@ -228,9 +392,12 @@ int32_t VectorGet(Vector *self, Item *pItem, int32_t iIdx);
  * @retval ERR_NOINIT   Uninitialized container
  * @retval ERR_NOMEM   Insufficient memory for vector extension
  *
- * @note The designated capacity should greater than zero.
+ * @note The designated capacity should greater than zero. Large storage is
+ * mapped directly from the system on Linux, and its capacity is rounded up to
+ * fill the last page.
+ * @see VectorSetStorage
  */
-int32_t VectorResize(Vector *self, int32_t iCap);
+int32_t VectorResize(Vector *self, int64_t iCap);
 
 /**
  * @brief Return the number of stored items.
@@ -240,7 +407,7 @@ int32_t VectorResize(Vector *self, int32_t iCap);
  * @return              The number of stored items
  * @retval ERR_NOINIT   Uninitialized container
  */
-int32_t VectorSize(Vector *self);
+int64_t VectorSize(Vector *self);
 
 /**
  * @brief Return the container capacity.
@@ -250,7 +417,7 @@ int32_t VectorSize(Vector *self);
  * @return              The container capacity
  * @retval ERR_NOINIT   Uninitialized container
  */
-int32_t VectorCapacity(Vector *self);
+int64_t VectorCapacity(Vector *self);
 
 /**
  * @brief Sort the items via the designated item comparison method.
@@ -263,6 +430,320 @@ int32_t VectorCapacity(Vector *self);
  */
 int32_t VectorSort(Vector *self, int32_t (*pFunc) (const void*, const void*));
 
+/**
+ * @brief Sort the items and preserve the relative order of equal items.
+ *
+ * This function applies the bottom-up merge sort. The comparison method
+ * follows the same convention as the one for VectorSort().
+ *
+ * @param self          The pointer to the Vector structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for the auxiliary buffer
+ */
+int32_t VectorStableSort(Vector *self, int32_t (*pFunc) (const void*, const void*));
+
+/**
+ * @brief Sort the items with multiple threads.
+ *
+ * This function splits the items into one run per thread and sorts the runs
+ * concurrently. The sorted runs are then merged pairwise, and each pairwise
+ * merge is again partitioned among the threads with the merge path split.
+ * The sort is stable, and the comparison method follows the same convention as
+ * the one for VectorSort().
+ *
+ * @param self          The pointer to the Vector structure
+ * @param pFunc         The function pointer to the custom method
+ * @param iThread       The number of threads
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for the auxiliary buffer
+ *
+ * @note Specify iThread to 0 to use all the online processors. Small vectors
+ * are sorted with fewer threads.
+ */
+int32_t VectorParallelSort(Vector *self, int32_t (*pFunc) (const void*, const void*),
+                           int32_t iThread);
+
+/**
+ * @brief Sort the items by the integer keys extracted from them.
+ *
+ * This function applies the LSD radix sort with 8 bit digits. The key extractor
+ * is called exactly once for each item, and the items are ordered by the
+ * ascending unsigned order of their keys. The sort is stable, and the passes
+ * for the digits shared by all the keys are skipped.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param pKey          The function pointer to the key extractor
+ * @param iWidth        The number of significant key bytes (1 to 8)
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_KEYSIZE  Illegal key width
+ * @retval ERR_NOMEM    Insufficient memory for the auxiliary buffers
+ *
+ * @note To sort signed keys, the extractor should flip the sign bit of the
+ * key so that the unsigned order matches the signed one.
+ */
+int32_t VectorRadixSort(Vector *self, uint64_t (*pKey) (Item), int32_t iWidth);
+
+/**
+ * @brief Place the item of the designated rank at its sorted position.
+ *
+ * This function applies introselect. The range is narrowed with the quickselect
+ * partition around the median of three, and is sorted with heap sort if the
+ * partitions keep being unbalanced, so the expected cost is linear and the worst
+ * case is bounded by O(n log n). Afterwards, no item before the designated index
+ * is ordered after the item there, and no item after the index is ordered
+ * before it. The comparison method follows the same convention as the one for
+ * VectorSort().
+ *
+ * @param self          The pointer to the Vector structure
+ * @param iNth          The designated index
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal index
+ *
+ * @note The designated index should be smaller than the vector size and should
+ * not be negative.
+ */
+int32_t VectorNthElement(Vector *self, int64_t iNth,
+                         int32_t (*pFunc) (const void*, const void*));
+
+/**
+ * @brief Sort only the designated number of leading items.
+ *
+ * This function moves the smallest iNum items to the head with
+ * VectorNthElement() and sorts them, which costs O(n + k log k). The order of
+ * the remaining items is unspecified.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param iNum          The number of items to sort
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal item count
+ *
+ * @note The item count should not be larger than the vector size and should
+ * not be negative.
+ */
+int32_t VectorPartialSort(Vector *self, int64_t iNum,
+                          int32_t (*pFunc) (const void*, const void*));
+
+/**
+ * @brief Copy the designated number of leading items in sorted order to an array.
+ *
+ * This function keeps the smallest items seen so far in a bounded binary heap
+ * built in the destination array, so it scans the vector once with O(n log k)
+ * comparisons and never modifies the vector. Reverse the comparison method to
+ * collect the largest items instead.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param iNum          The number of items to collect
+ * @param pFunc         The function pointer to the custom method
+ * @param aDst          The destination array with at least iNum slots
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_IDX      Illegal item count
+ * @retval ERR_GET      Invalid destination array
+ *
+ * @note The item count should not be larger than the vector size and should
+ * not be negative. The collected items are still owned by the vector.
+ */
+int32_t VectorTopK(Vector *self, int64_t iNum,
+                   int32_t (*pFunc) (const void*, const void*), Item *aDst);
+
+/**
+ * @brief Find the first index of the designated item.
+ *
+ * This function compares the raw item values, so it applies to pointer items
+ * and integer items alike. The items are scanned with AVX2 or SSE2 if the
+ * running processor supports them.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param item          The designated item
+ * @param iBgn          The index to start the search
+ * @param pIdx          The pointer to the returned index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the returned index
+ * @retval ERR_IDX      Illegal starting index
+ * @retval ERR_NODATA   No matched item
+ *
+ * @note The returned index is set to -1 if no item is matched.
+ */
+int32_t VectorFind(Vector *self, Item item, int64_t iBgn, int64_t *pIdx);
+
+/**
+ * @brief Count the items equal to the designated item.
+ *
+ * This function compares the raw item values with the SIMD kernels like
+ * VectorFind().
+ *
+ * @param self          The pointer to the Vector structure
+ * @param item          The designated item
+ * @param pCount        The pointer to the returned count
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the returned count
+ */
+int32_t VectorCount(Vector *self, Item item, int64_t *pCount);
+
+/**
+ * @brief Find the indexes of the minimum and maximum integer items.
+ *
+ * This function interprets the items as 64 bit integers and returns the first
+ * index for each extreme. The items are scanned with AVX2 or SSE4.2 if the
+ * running processor supports them.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param bSigned       Whether to compare the items as signed integers
+ * @param pIdxMin       The pointer to the returned index of the minimum
+ * @param pIdxMax       The pointer to the returned index of the maximum
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Both the parameters to store the indexes are NULL
+ * @retval ERR_IDX      Empty vector
+ *
+ * @note Either of the index pointers can be NULL if it is not needed.
+ */
+int32_t VectorMinMax(Vector *self, bool bSigned, int64_t *pIdxMin,
+                     int64_t *pIdxMax);
+
+/**
+ * @brief Append the integer items within the designated range to another vector.
+ *
+ * This function interprets the items as 64 bit integers and appends the ones
+ * within the closed range [itemLow, itemHigh] to the destination vector in
+ * their original order. The items are selected with AVX2 or SSE4.2 if the
+ * running processor supports them, and are appended in bulk.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param pDst          The pointer to the destination Vector structure
+ * @param itemLow       The lower bound of the range
+ * @param itemHigh      The upper bound of the range
+ * @param bSigned       Whether to compare the items as signed integers
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized source or destination container
+ * @retval ERR_NOMEM    Insufficient memory for destination extension
+ *
+ * @note The selected items are shared by both vectors, so at most one of them
+ * should own the custom resource clean method. Pass the same item as both
+ * bounds to filter by equality.
+ */
+int32_t VectorFilter(Vector *self, Vector *pDst, Item itemLow, Item itemHigh,
+                     bool bSigned);
+
+/**
+ * @brief Find the first index whose item is not ordered before the designated item.
+ *
+ * The vector should be sorted by the designated comparison method, which follows
+ * the same convention as the one for VectorSort(). This function applies the
+ * branchless binary search, so the loop runs exactly log2(size) times and the
+ * probe is selected with a conditional move instead of a branch.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param item          The designated item
+ * @param pFunc         The function pointer to the custom method
+ * @param pIdx          The pointer to the returned index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the returned index
+ *
+ * @note The returned index is equal to the vector size if all the items are
+ * ordered before the designated item.
+ */
+int32_t VectorLowerBound(Vector *self, Item item,
+                         int32_t (*pFunc) (const void*, const void*), int64_t *pIdx);
+
+/**
+ * @brief Find the first index whose item is ordered after the designated item.
+ *
+ * The search follows the same convention as VectorLowerBound().
+ *
+ * @param self          The pointer to the Vector structure
+ * @param item          The designated item
+ * @param pFunc         The function pointer to the custom method
+ * @param pIdx          The pointer to the returned index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameter to store the returned index
+ */
+int32_t VectorUpperBound(Vector *self, Item item,
+                         int32_t (*pFunc) (const void*, const void*), int64_t *pIdx);
+
+/**
+ * @brief Find the index range of the items equivalent to the designated item.
+ *
+ * The returned range [*pBgn, *pEnd) is empty if no equivalent item exists, and
+ * both indexes then point to the position where the item would be inserted.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param item          The designated item
+ * @param pFunc         The function pointer to the custom method
+ * @param pBgn          The pointer to the returned beginning index
+ * @param pEnd          The pointer to the returned ending index
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_GET      Invalid parameters to store the returned indexes
+ */
+int32_t VectorEqualRange(Vector *self, Item item,
+                         int32_t (*pFunc) (const void*, const void*),
+                         int64_t *pBgn, int64_t *pEnd);
+
+/**
+ * @brief Insert an item to the sorted vector and keep the order.
+ *
+ * The item is inserted after all the equivalent items, so the repeated
+ * insertions preserve their arrival order.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param item          The designated item
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_NOMEM    Insufficient memory for vector extension
+ */
+int32_t VectorInsertSorted(Vector *self, Item item,
+                           int32_t (*pFunc) (const void*, const void*));
+
+/**
+ * @brief Merge the items of another sorted vector and keep the order.
+ *
+ * Both vectors should be sorted by the designated comparison method. This
+ * function extends the storage once and merges the items from the tail end in
+ * place, so no auxiliary buffer is needed. For equivalent items, the ones of
+ * this vector are placed first. The source vector is not modified.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param pSrc          The pointer to the source Vector structure
+ * @param pFunc         The function pointer to the custom method
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized source or destination container
+ * @retval ERR_NOMEM    Insufficient memory for vector extension
+ *
+ * @note The merged items are shared by both vectors, so at most one of them
+ * should own the custom resource clean method.
+ */
+int32_t VectorMerge(Vector *self, Vector *pSrc,
+                    int32_t (*pFunc) (const void*, const void*));
+
 /**
  * @brief Iterate through the vector till the tail end.
  *
@@ -312,6 +793,50 @@ int32_t VectorReverseIterate(Vector *self, bool bReset, Item *pItem);
  */
 int32_t VectorSetDestroy(Vector *self, void (*pFunc) (Item));
 
+/**
+ * @brief Set the storage growth policy.
+ *
+ * This function decides how much the storage is extended when it is full. The
+ * policy can be VECTOR_GROW_DOUBLE, VECTOR_GROW_HALF, or VECTOR_GROW_CHUNK.
+ * By default, the capacity is doubled for each extension.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param iPolicy       The designated growth policy
+ * @param iChunk        The number of items for each extension under the
+ *                      VECTOR_GROW_CHUNK policy
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_POLICY   Illegal growth policy or chunk size
+ *
+ * @note The chunk size is ignored by the other policies. A bulk insertion
+ * always extends the storage enough to hold all the new items.
+ */
+int32_t VectorSetGrowth(Vector *self, int32_t iPolicy, int64_t iChunk);
+
+/**
+ * @brief Move the items to the storage with the designated mode.
+ *
+ * The mode can be STORAGE_HEAP, STORAGE_HUGE_PAGE, or STORAGE_FILE. The huge
+ * page storage reduces the TLB misses for scanning the large vector, and the
+ * file backed storage lets the kernel spill the cold pages to disk. Afterward,
+ * the storage is extended within the same mode.
+ *
+ * @param self          The pointer to the Vector structure
+ * @param iMode         The designated storage mode
+ * @param szPath        The path of the backing file for STORAGE_FILE mode
+ *
+ * @retval SUCC
+ * @retval ERR_NOINIT   Uninitialized container
+ * @retval ERR_POLICY   Illegal or unsupported storage mode
+ * @retval ERR_NOMEM    Insufficient memory for the new storage
+ * @retval ERR_IO       Fail to create the backing file
+ *
+ * @note The mapped storage capacity is rounded up to the page size or the huge
+ * page size. The backing file is unlinked right after creation.
+ */
+int32_t VectorSetStorage(Vector *self, int32_t iMode, const char *szPath);
+
 #ifdef __cplusplus
 }
 #endif
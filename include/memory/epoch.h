@@ -0,0 +1,135 @@
+/**
+ * @file epoch.h The epoch based memory reclamation for lock free readers.
+ */
+
+#ifndef _EPOCH_H_
+#define _EPOCH_H_
+
+#include "../util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The number of reader counter slots. The readers are spread over the slots
+    by their thread identities to avoid contending on one cache line. */
+#define EPOCH_NUM_SLOT      (64)
+
+/** The number of the retired object lists, one for each of the epochs which
+    may still be observed by the readers. */
+#define EPOCH_NUM_LIMBO     (3)
+
+/** Extract the reader slot from the ticket returned by EpochEnter. The callers
+    can use it to spread their own per thread counters. */
+#define EPOCH_TICKET_SLOT(uiTicket)     ((uiTicket) >> 1)
+
+/** The link embedded in the objects which are retired to the epoch domain. */
+typedef struct _EpochNode {
+    /** The next retired object */
+    struct _EpochNode *pNext;
+} EpochNode;
+
+/** The cache line sized counters of the readers in the even and odd epochs. */
+typedef struct _EpochSlot {
+    int64_t aCount[2];
+    int64_t aPad[6];
+} EpochSlot;
+
+/** The epoch domain shared by the readers and the writer of a structure. */
+typedef struct _Epoch {
+    /** The cache line aligned reader counters */
+    EpochSlot *aSlot;
+    /** The global epoch */
+    uint64_t ulEpoch;
+    /** The newest objects retired in each epoch modulo EPOCH_NUM_LIMBO */
+    EpochNode *aLimbo[EPOCH_NUM_LIMBO];
+    /** The flag held by the thread advancing the epoch */
+    int32_t iBusy;
+} Epoch;
+
+
+/*===========================================================================*
+ *                 Definition for the exported operations                    *
+ *===========================================================================*/
+/**
+ * @brief Prepare the epoch domain.
+ *
+ * @param pEpoch        The pointer to the Epoch structure
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for the reader counters
+ */
+int32_t EpochInit(Epoch *pEpoch);
+
+/**
+ * @brief Release the epoch domain. The retired objects should be flushed
+ * beforehand.
+ *
+ * @param pEpoch        The pointer to the Epoch structure
+ */
+void EpochDeinit(Epoch *pEpoch);
+
+/**
+ * @brief Announce that the calling thread starts reading the shared objects.
+ *
+ * The objects loaded after this call are not reclaimed until the matching
+ * EpochExit. The call only increments a counter shared by a fraction of the
+ * threads, so the readers scale without writing to any common cache line.
+ *
+ * @param pEpoch        The pointer to the Epoch structure
+ *
+ * @return              The ticket to pass to EpochExit
+ */
+uint32_t EpochEnter(Epoch *pEpoch);
+
+/**
+ * @brief Announce that the calling thread stops reading the shared objects.
+ *
+ * @param pEpoch        The pointer to the Epoch structure
+ * @param uiTicket      The ticket returned by EpochEnter
+ */
+void EpochExit(Epoch *pEpoch, uint32_t uiTicket);
+
+/**
+ * @brief Retire an object which has been unpublished from the readers.
+ *
+ * The object is reclaimable after the global epoch advances twice, when all
+ * the readers which may have loaded it are gone. The function is lock free and
+ * can be called by multiple writers concurrently.
+ *
+ * @param pEpoch        The pointer to the Epoch structure
+ * @param pNode         The pointer to the link embedded in the object
+ */
+void EpochRetire(Epoch *pEpoch, EpochNode *pNode);
+
+/**
+ * @brief Try to advance the global epoch, and detach the retired objects which
+ * no reader can reach any longer.
+ *
+ * The epoch advances only if no reader stays in the previous epoch, so the
+ * call never blocks. If another thread is advancing the epoch, the call
+ * returns immediately without reclaiming anything.
+ *
+ * @param pEpoch        The pointer to the Epoch structure
+ *
+ * @return              The list of the reclaimable objects in the retired
+ *                      order linked by pNext, or NULL if there is none
+ */
+EpochNode* EpochReclaim(Epoch *pEpoch);
+
+/**
+ * @brief Detach all the retired objects regardless of the epoch.
+ *
+ * @param pEpoch        The pointer to the Epoch structure
+ *
+ * @return              The list of all the retired objects linked by pNext
+ *
+ * @note It should be called only when no reader is active.
+ */
+EpochNode* EpochFlush(Epoch *pEpoch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
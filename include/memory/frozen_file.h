@@ -0,0 +1,118 @@
+/**
+ * @file frozen_file.h The read only file mapped by the frozen structures.
+ */
+
+#ifndef _FROZEN_FILE_H_
+#define _FROZEN_FILE_H_
+
+#include "../util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The common head of the frozen file headers. The header of each structure
+    embeds it as the first member. */
+typedef struct _FrozenFileHead {
+    /** The magic identifying the structure */
+    char aMagic[8];
+    /** The file format version */
+    uint32_t uiVersion;
+    /** The marker to reject the file written in another byte order */
+    uint32_t uiOrder;
+    /** The size of the whole file */
+    uint64_t ulFileSize;
+} FrozenFileHead;
+
+/** The frozen file under writing. */
+typedef struct _FrozenFile {
+    /** The base address of the writable mapping */
+    uint8_t *pBase;
+    /** The file size in bytes */
+    size_t ulSize;
+    /** The descriptor of the temporary file */
+    int32_t iFd;
+    /** The path of the temporary file */
+    char *szTemp;
+} FrozenFile;
+
+
+/*===========================================================================*
+ *                 Definition for the exported operations                    *
+ *===========================================================================*/
+/**
+ * @brief Create the temporary file to be filled for the designated path.
+ *
+ * The temporary file is created in the directory of the designated path,
+ * extended with zeros, and mapped for writing. The designated path is not
+ * touched until the file is committed.
+ *
+ * @param pFile         The pointer to the FrozenFile structure
+ * @param szPath        The path of the frozen file
+ * @param ulSize        The file size in bytes, including the header
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for the temporary path
+ * @retval ERR_IO       Fail to create or to map the temporary file
+ */
+int32_t FrozenFileCreate(FrozenFile *pFile, const char *szPath, size_t ulSize);
+
+/**
+ * @brief Fill the common head, flush the file, and replace the designated path
+ * with it.
+ *
+ * The content is synchronized to the disk before the file is renamed over the
+ * designated path, so the path always refers to a complete file. The readers
+ * which mapped the replaced file keep their inode and are not disturbed. The
+ * temporary file is removed if the flush or the rename fails.
+ *
+ * @param pFile         The pointer to the FrozenFile structure
+ * @param szPath        The path of the frozen file
+ * @param szMagic       The magic of the structure
+ * @param uiVersion     The file format version
+ *
+ * @retval SUCC
+ * @retval ERR_IO       Fail to flush or to rename the file, or fail to flush
+ *                      the directory after the rename
+ */
+int32_t FrozenFileCommit(FrozenFile *pFile, const char *szPath,
+                         const char *szMagic, uint32_t uiVersion);
+
+/**
+ * @brief Discard the temporary file.
+ *
+ * @param pFile         The pointer to the FrozenFile structure
+ */
+void FrozenFileAbort(FrozenFile *pFile);
+
+/**
+ * @brief Map the frozen file read only and check its common head.
+ *
+ * @param szPath        The path of the frozen file
+ * @param szMagic       The expected magic
+ * @param uiVersion     The expected file format version
+ * @param ulHead        The size of the header of the structure
+ * @param ppBase        The pointer to the returned base address
+ * @param pulSize       The pointer to the returned file size
+ *
+ * @retval SUCC
+ * @retval ERR_IO       Fail to map the file, or the file is shorter than the
+ *                      header or has the mismatched head
+ */
+int32_t FrozenFileOpen(const char *szPath, const char *szMagic,
+                       uint32_t uiVersion, size_t ulHead, uint8_t **ppBase,
+                       size_t *pulSize);
+
+/**
+ * @brief Unmap the frozen file opened by FrozenFileOpen.
+ *
+ * @param pBase         The base address of the mapping
+ * @param ulSize        The file size in bytes
+ */
+void FrozenFileClose(uint8_t *pBase, size_t ulSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file storage.h The backing storage for array based data structures.
+ */
+
+#ifndef _STORAGE_H_
+#define _STORAGE_H_
+
+#include "../util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Allocate the storage from the heap. Large storage is mapped directly from
+    the system on Linux so that it can be extended without copying. */
+static const int32_t STORAGE_HEAP = 0;
+
+/** Map the storage anonymously with the transparent huge page advice. */
+static const int32_t STORAGE_HUGE_PAGE = 1;
+
+/** Map the storage from a file so that the cold pages can spill to disk. */
+static const int32_t STORAGE_FILE = 2;
+
+/** The contiguous storage which can be resized with the content preserved. */
+typedef struct _Storage {
+    /** The base address of the storage */
+    void *pBase;
+    /** The storage size in bytes */
+    size_t ulSize;
+    /** The storage mode */
+    int32_t iMode;
+    /** The descriptor of the backing file */
+    int32_t iFd;
+    /** Whether the storage is mapped from the system */
+    bool bMapped;
+} Storage;
+
+
+/*===========================================================================*
+ *                 Definition for the exported operations                    *
+ *===========================================================================*/
+/**
+ * @brief Prepare the empty storage with the designated mode.
+ *
+ * For the STORAGE_FILE mode, the designated file is created and immediately
+ * unlinked. Its pages are written back by the kernel under memory pressure, and
+ * the disk space is released when the storage is destroyed.
+ *
+ * @param pStore        The pointer to the Storage structure
+ * @param iMode         The designated storage mode
+ * @param szPath        The path of the backing file for STORAGE_FILE mode
+ *
+ * @retval SUCC
+ * @retval ERR_POLICY   Illegal or unsupported storage mode
+ * @retval ERR_IO       Fail to create the backing file
+ */
+int32_t StorageInit(Storage *pStore, int32_t iMode, const char *szPath);
+
+/**
+ * @brief Release the storage.
+ *
+ * @param pStore        The pointer to the Storage structure
+ */
+void StorageDeinit(Storage *pStore);
+
+/**
+ * @brief Resize the storage and preserve the content within the new size.
+ *
+ * The mapped storage is extended by remapping the pages, so the content is not
+ * copied even if the base address changes. The size of the mapped storage is
+ * rounded up to the page size, or to the huge page size for STORAGE_HUGE_PAGE
+ * mode. The storage is not modified if the function fails.
+ *
+ * @param pStore        The pointer to the Storage structure
+ * @param ulSize        The designated size in bytes
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for storage extension
+ * @retval ERR_IO       Fail to resize the backing file
+ */
+int32_t StorageResize(Storage *pStore, size_t ulSize);
+
+/**
+ * @brief Move the content to the new storage with the designated mode.
+ *
+ * @param pStore        The pointer to the Storage structure
+ * @param iMode         The designated storage mode
+ * @param szPath        The path of the backing file for STORAGE_FILE mode
+ *
+ * @retval SUCC
+ * @retval ERR_POLICY   Illegal or unsupported storage mode
+ * @retval ERR_NOMEM    Insufficient memory for the new storage
+ * @retval ERR_IO       Fail to create the backing file
+ *
+ * @note The old storage is kept if the function fails.
+ */
+int32_t StorageSwitch(Storage *pStore, int32_t iMode, const char *szPath);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -35,6 +35,15 @@ static const int32_t ERR_ITER = -7;
 /** Fail to register the unit test function. */
 static const int32_t ERR_REG = -8;
 
+/** Invalid argument to specify the element size for typed data structures. */
+static const int32_t ERR_ELEMSIZE = -9;
+
+/** Invalid argument to specify the storage policy for data structures. */
+static const int32_t ERR_POLICY = -10;
+
+/** Fail to access the file backing the data structure. */
+static const int32_t ERR_IO = -11;
+
 /** Iteration in progress. */
 static const int32_t CONTINUE = 1;
 
@@ -0,0 +1,1241 @@
+#include "container/art_map.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+#define ART_NODE_4              (0)
+#define ART_NODE_16             (1)
+#define ART_NODE_48             (2)
+#define ART_NODE_256            (3)
+
+/* The leading bytes of the compressed path kept in the node. The rest of a
+   longer path is read from a leaf of the subtree. */
+#define ART_PREFIX_INLINE       (8)
+
+#define SIZE_FRAME_INIT         (16)
+
+/* The Node256 shrinks to Node48 and the Node48 shrinks to Node16 a few
+   children below their capacities to avoid the thrashing at the boundaries. */
+#define ART_SHRINK_256          (37)
+#define ART_SHRINK_48           (12)
+#define ART_SHRINK_16           (3)
+
+/* The child links tag the leaves with the lowest bit. */
+#define ART_IS_LEAF(p)          (((uintptr_t)(p)) & 1)
+#define ART_LEAF(p)             ((ArtLeaf*)(((uintptr_t)(p)) & ~(uintptr_t)1))
+#define ART_TAG(p)              ((void*)(((uintptr_t)(p)) | 1))
+
+typedef struct _ArtLeaf {
+    ArtEntry entry_;
+    uint8_t aKey_[];
+} ArtLeaf;
+
+/* The header shared by all the node layouts. The leaf of the key ending right
+   after the compressed path is hung on the node itself. */
+typedef struct _ArtNode {
+    uint8_t ucType_;
+    uint16_t usNum_;
+    uint32_t uiLenPrefix_;
+    ArtLeaf *pTerm_;
+    uint8_t aPrefix_[ART_PREFIX_INLINE];
+} ArtNode;
+
+typedef struct _ArtNode4 {
+    ArtNode node_;
+    uint8_t aKey_[4];
+    void *aChild_[4];
+} ArtNode4;
+
+typedef struct _ArtNode16 {
+    ArtNode node_;
+    uint8_t aKey_[16];
+    void *aChild_[16];
+} ArtNode16;
+
+/* The index maps a byte to the child slot plus one. */
+typedef struct _ArtNode48 {
+    ArtNode node_;
+    uint8_t aIndex_[256];
+    void *aChild_[48];
+} ArtNode48;
+
+typedef struct _ArtNode256 {
+    ArtNode node_;
+    void *aChild_[256];
+} ArtNode256;
+
+typedef struct _ArtFrame {
+    void *pNode_;
+    int32_t iPos_;
+} ArtFrame;
+
+struct _ArtMapData {
+    int32_t iSize_;
+    void *pRoot_;
+    ArtFrame *aFrame_;
+    int32_t iTop_;
+    int32_t iCapFrame_;
+    void (*pDestroy_) (ArtEntry*);
+};
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Traverse all the nodes and clean the allocated resource.
+ *
+ * @param pData         The pointer to the map private data
+ * @param pCurr         The tagged pointer to the root of the designated subtree
+ */
+void _ArtMapDeinit(ArtMapData *pData, void *pCurr);
+
+/**
+ * @brief Allocate a leaf holding the copy of the key.
+ *
+ * @param aKey          The key bytes
+ * @param iSize         The size of the key in bytes
+ * @param value         The designated value
+ *
+ * @return              The pointer to the leaf or NULL for insufficient memory
+ */
+ArtLeaf* _ArtMapNewLeaf(uint8_t *aKey, int32_t iSize, Value value);
+
+/**
+ * @brief Allocate an empty inner node of the designated layout.
+ *
+ * @param ucType        The node layout
+ *
+ * @return              The pointer to the node or NULL for insufficient memory
+ */
+ArtNode* _ArtMapNewNode(uint8_t ucType);
+
+/**
+ * @brief Check if the leaf holds the designated key.
+ *
+ * @param pLeaf         The pointer to the leaf
+ * @param aKey          The key bytes
+ * @param iSize         The size of the key in bytes
+ *
+ * @return              true if the keys are the same
+ */
+bool _ArtMapLeafMatch(ArtLeaf *pLeaf, uint8_t *aKey, int32_t iSize);
+
+/**
+ * @brief Get the child link labeled by the designated byte.
+ *
+ * @param pNode         The pointer to the inner node
+ * @param ucByte        The designated byte
+ *
+ * @return              The pointer to the child link or NULL
+ */
+void** _ArtMapFindChild(ArtNode *pNode, uint8_t ucByte);
+
+/**
+ * @brief Get the first child at or after the designated position, and move the
+ * position past it.
+ *
+ * The position is the slot index for Node4 and Node16, and the byte for Node48
+ * and Node256, so the children are visited in the ascending byte order.
+ *
+ * @param pNode         The pointer to the inner node
+ * @param piPos         The pointer to the position
+ *
+ * @return              The tagged pointer to the child or NULL
+ */
+void* _ArtMapNextChild(ArtNode *pNode, int32_t *piPos);
+
+/**
+ * @brief Hang the child on the node, and grow the node to the next layout if
+ * it is full.
+ *
+ * @param ppRef         The link to the node, which is updated after growth
+ * @param ucByte        The label of the child
+ * @param pChild        The tagged pointer to the child
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for node growth
+ */
+int32_t _ArtMapAddChild(void **ppRef, uint8_t ucByte, void *pChild);
+
+/**
+ * @brief Unhang the child from the node, and shrink or collapse the node if it
+ * becomes sparse.
+ *
+ * @param ppRef         The link to the node, which is updated after shrinking
+ * @param ucByte        The label of the child
+ * @param ppSlot        The link to the child
+ */
+void _ArtMapRemoveChild(void **ppRef, uint8_t ucByte, void **ppSlot);
+
+/**
+ * @brief Replace the node holding a single entry with that entry.
+ *
+ * If the remaining entry is an inner node, the compressed paths are joined
+ * through the label byte.
+ *
+ * @param ppRef         The link to the node
+ */
+void _ArtMapCollapse(void **ppRef);
+
+/**
+ * @brief Get the leaf with the minimum key in the subtree.
+ *
+ * @param pCurr         The tagged pointer to the root of the subtree
+ *
+ * @return              The pointer to the leaf
+ */
+ArtLeaf* _ArtMapMinimum(void *pCurr);
+
+/**
+ * @brief Get the leaf with the maximum key in the subtree.
+ *
+ * @param pCurr         The tagged pointer to the root of the subtree
+ *
+ * @return              The pointer to the leaf
+ */
+ArtLeaf* _ArtMapMaximum(void *pCurr);
+
+/**
+ * @brief Compare the whole compressed path of the node with the key.
+ *
+ * @param pNode         The pointer to the inner node
+ * @param aKey          The key bytes
+ * @param iSize         The size of the key in bytes
+ * @param iDepth        The offset of the path in the key
+ *
+ * @return              The number of the leading matched bytes
+ */
+int32_t _ArtMapMismatch(ArtNode *pNode, uint8_t *aKey, int32_t iSize,
+                        int32_t iDepth);
+
+/**
+ * @brief Get the leaf holding the designated key.
+ *
+ * The search compares only the inline part of each compressed path, and the
+ * final leaf comparison rejects the false match.
+ *
+ * @param pData         The pointer to the map private data
+ * @param aKey          The key bytes
+ * @param iSize         The size of the key in bytes
+ *
+ * @return              The pointer to the leaf or NULL
+ */
+ArtLeaf* _ArtMapSearch(ArtMapData *pData, uint8_t *aKey, int32_t iSize);
+
+/**
+ * @brief Insert the key value entry.
+ *
+ * @param pData         The pointer to the map private data
+ * @param aKey          The key bytes
+ * @param iSize         The size of the key in bytes
+ * @param value         The designated value
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for map extension
+ */
+int32_t _ArtMapInsert(ArtMapData *pData, uint8_t *aKey, int32_t iSize,
+                      Value value);
+
+/**
+ * @brief Detach the leaf holding the designated key.
+ *
+ * @param pData         The pointer to the map private data
+ * @param aKey          The key bytes
+ * @param iSize         The size of the key in bytes
+ *
+ * @return              The pointer to the detached leaf or NULL
+ */
+ArtLeaf* _ArtMapDelete(ArtMapData *pData, uint8_t *aKey, int32_t iSize);
+
+/**
+ * @brief Push the node to the iterator path.
+ *
+ * @param pData         The pointer to the map private data
+ * @param pNode         The tagged pointer to the node
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for the iterator path
+ */
+int32_t _ArtMapPush(ArtMapData *pData, void *pNode);
+
+/**
+ * @brief Advance the iterator to the next entry.
+ *
+ * @param pData         The pointer to the map private data
+ * @param ppEntry       The double pointer to the returned entry
+ *
+ * @retval CONTINUE     Iteration in progress
+ * @retval END          Iteration terminiated
+ * @retval ERR_NOMEM    Insufficient memory for the iterator path
+ */
+int32_t _ArtMapNext(ArtMapData *pData, ArtEntry **ppEntry);
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+#define CHECK_KEY(key, iSize)                                                   \
+            do {                                                                \
+                if ((iSize < 0) || ((iSize > 0) && !key))                       \
+                    return ERR_KEYSIZE;                                         \
+            } while (0);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t ArtMapInit(ArtMap **ppObj)
+{
+    *ppObj = (ArtMap*)malloc(sizeof(ArtMap));
+    if (!(*ppObj))
+        return ERR_NOMEM;
+    ArtMap *pObj = *ppObj;
+
+    pObj->pData = (ArtMapData*)malloc(sizeof(ArtMapData));
+    if (!(pObj->pData)) {
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+    ArtMapData *pData = pObj->pData;
+
+    pData->iSize_ = 0;
+    pData->pRoot_ = NULL;
+    pData->aFrame_ = NULL;
+    pData->iTop_ = pData->iCapFrame_ = 0;
+    pData->pDestroy_ = NULL;
+
+    pObj->put = ArtMapPut;
+    pObj->get = ArtMapGet;
+    pObj->find = ArtMapFind;
+    pObj->remove = ArtMapRemove;
+    pObj->size = ArtMapSize;
+    pObj->minimum = ArtMapMinimum;
+    pObj->maximum = ArtMapMaximum;
+    pObj->iterate = ArtMapIterate;
+    pObj->iterate_prefix = ArtMapIteratePrefix;
+    pObj->set_destroy = ArtMapSetDestroy;
+
+    return SUCC;
+}
+
+void ArtMapDeinit(ArtMap **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+
+    ArtMap *pObj = *ppObj;
+    if (!(pObj->pData))
+        goto FREE_MAP;
+
+    ArtMapData *pData = pObj->pData;
+    _ArtMapDeinit(pData, pData->pRoot_);
+    free(pData->aFrame_);
+    free(pObj->pData);
+
+FREE_MAP:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t ArtMapPut(ArtMap *self, Key key, int32_t iSize, Value value)
+{
+    CHECK_INIT(self);
+    CHECK_KEY(key, iSize);
+    return _ArtMapInsert(self->pData, (uint8_t*)key, iSize, value);
+}
+
+int32_t ArtMapGet(ArtMap *self, Key key, int32_t iSize, Value *pValue)
+{
+    CHECK_INIT(self);
+    CHECK_KEY(key, iSize);
+    if (!pValue)
+        return ERR_GET;
+
+    ArtLeaf *pLeaf = _ArtMapSearch(self->pData, (uint8_t*)key, iSize);
+    if (!pLeaf) {
+        *pValue = NULL;
+        return ERR_NODATA;
+    }
+    *pValue = pLeaf->entry_.value;
+    return SUCC;
+}
+
+int32_t ArtMapFind(ArtMap *self, Key key, int32_t iSize)
+{
+    CHECK_INIT(self);
+    CHECK_KEY(key, iSize);
+    return (_ArtMapSearch(self->pData, (uint8_t*)key, iSize))? SUCC : NOKEY;
+}
+
+int32_t ArtMapRemove(ArtMap *self, Key key, int32_t iSize)
+{
+    CHECK_INIT(self);
+    CHECK_KEY(key, iSize);
+
+    ArtMapData *pData = self->pData;
+    ArtLeaf *pLeaf = _ArtMapDelete(pData, (uint8_t*)key, iSize);
+    if (!pLeaf)
+        return ERR_NODATA;
+
+    if (pData->pDestroy_)
+        pData->pDestroy_(&(pLeaf->entry_));
+    free(pLeaf);
+    pData->iSize_--;
+    return SUCC;
+}
+
+int32_t ArtMapSize(ArtMap *self)
+{
+    CHECK_INIT(self);
+    return self->pData->iSize_;
+}
+
+int32_t ArtMapMinimum(ArtMap *self, ArtEntry **ppEntry)
+{
+    CHECK_INIT(self);
+    if (!ppEntry)
+        return ERR_GET;
+
+    ArtMapData *pData = self->pData;
+    if (!(pData->pRoot_)) {
+        *ppEntry = NULL;
+        return ERR_IDX;
+    }
+    *ppEntry = &(_ArtMapMinimum(pData->pRoot_)->entry_);
+    return SUCC;
+}
+
+int32_t ArtMapMaximum(ArtMap *self, ArtEntry **ppEntry)
+{
+    CHECK_INIT(self);
+    if (!ppEntry)
+        return ERR_GET;
+
+    ArtMapData *pData = self->pData;
+    if (!(pData->pRoot_)) {
+        *ppEntry = NULL;
+        return ERR_IDX;
+    }
+    *ppEntry = &(_ArtMapMaximum(pData->pRoot_)->entry_);
+    return SUCC;
+}
+
+int32_t ArtMapIterate(ArtMap *self, bool bReset, ArtEntry **ppEntry)
+{
+    CHECK_INIT(self);
+
+    ArtMapData *pData = self->pData;
+    if (bReset) {
+        pData->iTop_ = 0;
+        return (pData->pRoot_)? _ArtMapPush(pData, pData->pRoot_) : SUCC;
+    }
+
+    if (!ppEntry)
+        return ERR_GET;
+    return _ArtMapNext(pData, ppEntry);
+}
+
+int32_t ArtMapIteratePrefix(ArtMap *self, bool bReset, Key key, int32_t iSize,
+                            ArtEntry **ppEntry)
+{
+    CHECK_INIT(self);
+
+    ArtMapData *pData = self->pData;
+    if (!bReset) {
+        if (!ppEntry)
+            return ERR_GET;
+        return _ArtMapNext(pData, ppEntry);
+    }
+
+    CHECK_KEY(key, iSize);
+    pData->iTop_ = 0;
+
+    /* Descend until the prefix is consumed. All the keys in the reached subtree
+       share the bytes on the path, so checking one of them is enough to reject
+       the path skipped by the optimistic comparison. */
+    uint8_t *aKey = (uint8_t*)key;
+    void *pCurr = pData->pRoot_;
+    int32_t iDepth = 0;
+    while (pCurr && !ART_IS_LEAF(pCurr)) {
+        ArtNode *pNode = (ArtNode*)pCurr;
+        iDepth += pNode->uiLenPrefix_;
+        if (iDepth >= iSize)
+            break;
+        void **ppSlot = _ArtMapFindChild(pNode, aKey[iDepth]);
+        pCurr = (ppSlot)? *ppSlot : NULL;
+        ++iDepth;
+    }
+    if (!pCurr)
+        return SUCC;
+
+    ArtLeaf *pLeaf = _ArtMapMinimum(pCurr);
+    if ((pLeaf->entry_.iSize < iSize) ||
+        ((iSize > 0) && (memcmp(pLeaf->aKey_, aKey, iSize) != 0)))
+        return SUCC;
+    return _ArtMapPush(pData, pCurr);
+}
+
+int32_t ArtMapSetDestroy(ArtMap *self, void (*pFunc) (ArtEntry*))
+{
+    CHECK_INIT(self);
+    self->pData->pDestroy_ = pFunc;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+void _ArtMapDeinit(ArtMapData *pData, void *pCurr)
+{
+    if (!pCurr)
+        return;
+
+    if (ART_IS_LEAF(pCurr)) {
+        ArtLeaf *pLeaf = ART_LEAF(pCurr);
+        if (pData->pDestroy_)
+            pData->pDestroy_(&(pLeaf->entry_));
+        free(pLeaf);
+        return;
+    }
+
+    /* The recursion is bounded by the key size. */
+    ArtNode *pNode = (ArtNode*)pCurr;
+    if (pNode->pTerm_)
+        _ArtMapDeinit(pData, ART_TAG(pNode->pTerm_));
+    int32_t iPos = 0;
+    void *pChild;
+    while ((pChild = _ArtMapNextChild(pNode, &iPos)) != NULL)
+        _ArtMapDeinit(pData, pChild);
+    free(pNode);
+    return;
+}
+
+ArtLeaf* _ArtMapNewLeaf(uint8_t *aKey, int32_t iSize, Value value)
+{
+    ArtLeaf *pLeaf = (ArtLeaf*)malloc(sizeof(ArtLeaf) + iSize);
+    if (!pLeaf)
+        return NULL;
+
+    if (iSize > 0)
+        memcpy(pLeaf->aKey_, aKey, iSize);
+    pLeaf->entry_.key = pLeaf->aKey_;
+    pLeaf->entry_.iSize = iSize;
+    pLeaf->entry_.value = value;
+    return pLeaf;
+}
+
+ArtNode* _ArtMapNewNode(uint8_t ucType)
+{
+    size_t ulSize;
+    switch (ucType) {
+        case ART_NODE_4:
+            ulSize = sizeof(ArtNode4);
+            break;
+        case ART_NODE_16:
+            ulSize = sizeof(ArtNode16);
+            break;
+        case ART_NODE_48:
+            ulSize = sizeof(ArtNode48);
+            break;
+        default:
+            ulSize = sizeof(ArtNode256);
+    }
+
+    ArtNode *pNode = (ArtNode*)calloc(1, ulSize);
+    if (pNode)
+        pNode->ucType_ = ucType;
+    return pNode;
+}
+
+bool _ArtMapLeafMatch(ArtLeaf *pLeaf, uint8_t *aKey, int32_t iSize)
+{
+    if (pLeaf->entry_.iSize != iSize)
+        return false;
+    return (iSize == 0) || (memcmp(pLeaf->aKey_, aKey, iSize) == 0);
+}
+
+void** _ArtMapFindChild(ArtNode *pNode, uint8_t ucByte)
+{
+    int32_t iIdx;
+    switch (pNode->ucType_) {
+        case ART_NODE_4: {
+            ArtNode4 *pNode4 = (ArtNode4*)pNode;
+            for (iIdx = 0 ; iIdx < pNode->usNum_ ; iIdx++) {
+                if (pNode4->aKey_[iIdx] == ucByte)
+                    return &(pNode4->aChild_[iIdx]);
+            }
+            return NULL;
+        }
+        case ART_NODE_16: {
+            ArtNode16 *pNode16 = (ArtNode16*)pNode;
+#ifdef __SSE2__
+            /* Compare all the 16 labels at once and mask the unused slots. */
+            __m128i vCmp = _mm_cmpeq_epi8(_mm_set1_epi8((char)ucByte),
+                           _mm_loadu_si128((__m128i*)pNode16->aKey_));
+            int32_t iMask = _mm_movemask_epi8(vCmp) &
+                            ((1 << pNode->usNum_) - 1);
+            return (iMask)? &(pNode16->aChild_[__builtin_ctz(iMask)]) : NULL;
+#else
+            for (iIdx = 0 ; iIdx < pNode->usNum_ ; iIdx++) {
+                if (pNode16->aKey_[iIdx] == ucByte)
+                    return &(pNode16->aChild_[iIdx]);
+            }
+            return NULL;
+#endif
+        }
+        case ART_NODE_48: {
+            ArtNode48 *pNode48 = (ArtNode48*)pNode;
+            iIdx = pNode48->aIndex_[ucByte];
+            return (iIdx)? &(pNode48->aChild_[iIdx - 1]) : NULL;
+        }
+        default: {
+            ArtNode256 *pNode256 = (ArtNode256*)pNode;
+            return (pNode256->aChild_[ucByte])?
+                   &(pNode256->aChild_[ucByte]) : NULL;
+        }
+    }
+}
+
+void* _ArtMapNextChild(ArtNode *pNode, int32_t *piPos)
+{
+    int32_t iPos = *piPos;
+    switch (pNode->ucType_) {
+        case ART_NODE_4:
+            if (iPos >= pNode->usNum_)
+                return NULL;
+            *piPos = iPos + 1;
+            return ((ArtNode4*)pNode)->aChild_[iPos];
+        case ART_NODE_16:
+            if (iPos >= pNode->usNum_)
+                return NULL;
+            *piPos = iPos + 1;
+            return ((ArtNode16*)pNode)->aChild_[iPos];
+        case ART_NODE_48: {
+            ArtNode48 *pNode48 = (ArtNode48*)pNode;
+            for ( ; iPos < 256 ; iPos++) {
+                if (pNode48->aIndex_[iPos]) {
+                    *piPos = iPos + 1;
+                    return pNode48->aChild_[pNode48->aIndex_[iPos] - 1];
+                }
+            }
+            *piPos = iPos;
+            return NULL;
+        }
+        default: {
+            ArtNode256 *pNode256 = (ArtNode256*)pNode;
+            for ( ; iPos < 256 ; iPos++) {
+                if (pNode256->aChild_[iPos]) {
+                    *piPos = iPos + 1;
+                    return pNode256->aChild_[iPos];
+                }
+            }
+            *piPos = iPos;
+            return NULL;
+        }
+    }
+}
+
+int32_t _ArtMapAddChild(void **ppRef, uint8_t ucByte, void *pChild)
+{
+    ArtNode *pNode = (ArtNode*)*ppRef;
+    int32_t iNum = pNode->usNum_;
+    int32_t iIdx;
+
+    switch (pNode->ucType_) {
+        case ART_NODE_4: {
+            ArtNode4 *pNode4 = (ArtNode4*)pNode;
+            if (iNum < 4) {
+                for (iIdx = iNum ; (iIdx > 0) &&
+                     (pNode4->aKey_[iIdx - 1] > ucByte) ; iIdx--) {
+                    pNode4->aKey_[iIdx] = pNode4->aKey_[iIdx - 1];
+                    pNode4->aChild_[iIdx] = pNode4->aChild_[iIdx - 1];
+                }
+                pNode4->aKey_[iIdx] = ucByte;
+                pNode4->aChild_[iIdx] = pChild;
+                pNode->usNum_++;
+                return SUCC;
+            }
+
+            ArtNode16 *pNew = (ArtNode16*)_ArtMapNewNode(ART_NODE_16);
+            if (!pNew)
+                return ERR_NOMEM;
+            memcpy(&(pNew->node_), pNode, sizeof(ArtNode));
+            pNew->node_.ucType_ = ART_NODE_16;
+            memcpy(pNew->aKey_, pNode4->aKey_, sizeof(pNode4->aKey_));
+            memcpy(pNew->aChild_, pNode4->aChild_, sizeof(pNode4->aChild_));
+            free(pNode);
+            *ppRef = pNew;
+            return _ArtMapAddChild(ppRef, ucByte, pChild);
+        }
+        case ART_NODE_16: {
+            ArtNode16 *pNode16 = (ArtNode16*)pNode;
+            if (iNum < 16) {
+#ifdef __SSE2__
+                /* Flip the sign bits so that the signed comparison orders the
+                   labels as unsigned bytes. */
+                __m128i vBias = _mm_set1_epi8((char)0x80);
+                __m128i vCmp = _mm_cmplt_epi8(
+                    _mm_xor_si128(_mm_set1_epi8((char)ucByte), vBias),
+                    _mm_xor_si128(_mm_loadu_si128((__m128i*)pNode16->aKey_),
+                                  vBias));
+                int32_t iMask = _mm_movemask_epi8(vCmp) & ((1 << iNum) - 1);
+                iIdx = (iMask)? __builtin_ctz(iMask) : iNum;
+#else
+                for (iIdx = 0 ; (iIdx < iNum) &&
+                     (pNode16->aKey_[iIdx] < ucByte) ; iIdx++);
+#endif
+                memmove(pNode16->aKey_ + iIdx + 1, pNode16->aKey_ + iIdx,
+                        iNum - iIdx);
+                memmove(pNode16->aChild_ + iIdx + 1, pNode16->aChild_ + iIdx,
+                        sizeof(void*) * (iNum - iIdx));
+                pNode16->aKey_[iIdx] = ucByte;
+                pNode16->aChild_[iIdx] = pChild;
+                pNode->usNum_++;
+                return SUCC;
+            }
+
+            ArtNode48 *pNew = (ArtNode48*)_ArtMapNewNode(ART_NODE_48);
+            if (!pNew)
+                return ERR_NOMEM;
+            memcpy(&(pNew->node_), pNode, sizeof(ArtNode));
+            pNew->node_.ucType_ = ART_NODE_48;
+            for (iIdx = 0 ; iIdx < 16 ; iIdx++) {
+                pNew->aIndex_[pNode16->aKey_[iIdx]] = iIdx + 1;
+                pNew->aChild_[iIdx] = pNode16->aChild_[iIdx];
+            }
+            free(pNode);
+            *ppRef = pNew;
+            return _ArtMapAddChild(ppRef, ucByte, pChild);
+        }
+        case ART_NODE_48: {
+            ArtNode48 *pNode48 = (ArtNode48*)pNode;
+            if (iNum < 48) {
+                for (iIdx = 0 ; pNode48->aChild_[iIdx] ; iIdx++);
+                pNode48->aChild_[iIdx] = pChild;
+                pNode48->aIndex_[ucByte] = iIdx + 1;
+                pNode->usNum_++;
+                return SUCC;
+            }
+
+            ArtNode256 *pNew = (ArtNode256*)_ArtMapNewNode(ART_NODE_256);
+            if (!pNew)
+                return ERR_NOMEM;
+            memcpy(&(pNew->node_), pNode, sizeof(ArtNode));
+            pNew->node_.ucType_ = ART_NODE_256;
+            for (iIdx = 0 ; iIdx < 256 ; iIdx++) {
+                if (pNode48->aIndex_[iIdx])
+                    pNew->aChild_[iIdx] =
+                        pNode48->aChild_[pNode48->aIndex_[iIdx] - 1];
+            }
+            free(pNode);
+            *ppRef = pNew;
+            return _ArtMapAddChild(ppRef, ucByte, pChild);
+        }
+        default:
+            ((ArtNode256*)pNode)->aChild_[ucByte] = pChild;
+            pNode->usNum_++;
+            return SUCC;
+    }
+}
+
+void _ArtMapRemoveChild(void **ppRef, uint8_t ucByte, void **ppSlot)
+{
+    ArtNode *pNode = (ArtNode*)*ppRef;
+    int32_t iIdx, iPos;
+
+    /* The smaller layout is optional, so the failed allocation only leaves the
+       node sparse. */
+    switch (pNode->ucType_) {
+        case ART_NODE_4: {
+            ArtNode4 *pNode4 = (ArtNode4*)pNode;
+            iPos = ppSlot - pNode4->aChild_;
+            memmove(pNode4->aKey_ + iPos, pNode4->aKey_ + iPos + 1,
+                    pNode->usNum_ - iPos - 1);
+            memmove(pNode4->aChild_ + iPos, pNode4->aChild_ + iPos + 1,
+                    sizeof(void*) * (pNode->usNum_ - iPos - 1));
+            pNode->usNum_--;
+            break;
+        }
+        case ART_NODE_16: {
+            ArtNode16 *pNode16 = (ArtNode16*)pNode;
+            iPos = ppSlot - pNode16->aChild_;
+            memmove(pNode16->aKey_ + iPos, pNode16->aKey_ + iPos + 1,
+                    pNode->usNum_ - iPos - 1);
+            memmove(pNode16->aChild_ + iPos, pNode16->aChild_ + iPos + 1,
+                    sizeof(void*) * (pNode->usNum_ - iPos - 1));
+            pNode->usNum_--;
+            if (pNode->usNum_ != ART_SHRINK_16)
+                break;
+
+            ArtNode4 *pNew = (ArtNode4*)_ArtMapNewNode(ART_NODE_4);
+            if (!pNew)
+                break;
+            memcpy(&(pNew->node_), pNode, sizeof(ArtNode));
+            pNew->node_.ucType_ = ART_NODE_4;
+            memcpy(pNew->aKey_, pNode16->aKey_, ART_SHRINK_16);
+            memcpy(pNew->aChild_, pNode16->aChild_,
+                   sizeof(void*) * ART_SHRINK_16);
+            free(pNode);
+            *ppRef = pNew;
+            pNode = &(pNew->node_);
+            break;
+        }
+        case ART_NODE_48: {
+            ArtNode48 *pNode48 = (ArtNode48*)pNode;
+            pNode48->aChild_[pNode48->aIndex_[ucByte] - 1] = NULL;
+            pNode48->aIndex_[ucByte] = 0;
+            pNode->usNum_--;
+            if (pNode->usNum_ != ART_SHRINK_48)
+                break;
+
+            ArtNode16 *pNew = (ArtNode16*)_ArtMapNewNode(ART_NODE_16);
+            if (!pNew)
+                break;
+            memcpy(&(pNew->node_), pNode, sizeof(ArtNode));
+            pNew->node_.ucType_ = ART_NODE_16;
+            for (iIdx = 0, iPos = 0 ; iIdx < 256 ; iIdx++) {
+                if (pNode48->aIndex_[iIdx]) {
+                    pNew->aKey_[iPos] = iIdx;
+                    pNew->aChild_[iPos++] =
+                        pNode48->aChild_[pNode48->aIndex_[iIdx] - 1];
+                }
+            }
+            free(pNode);
+            *ppRef = pNew;
+            pNode = &(pNew->node_);
+            break;
+        }
+        default: {
+            ArtNode256 *pNode256 = (ArtNode256*)pNode;
+            pNode256->aChild_[ucByte] = NULL;
+            pNode->usNum_--;
+            if (pNode->usNum_ != ART_SHRINK_256)
+                break;
+
+            ArtNode48 *pNew = (ArtNode48*)_ArtMapNewNode(ART_NODE_48);
+            if (!pNew)
+                break;
+            memcpy(&(pNew->node_), pNode, sizeof(ArtNode));
+            pNew->node_.ucType_ = ART_NODE_48;
+            for (iIdx = 0, iPos = 0 ; iIdx < 256 ; iIdx++) {
+                if (pNode256->aChild_[iIdx]) {
+                    pNew->aChild_[iPos++] = pNode256->aChild_[iIdx];
+                    pNew->aIndex_[iIdx] = iPos;
+                }
+            }
+            free(pNode);
+            *ppRef = pNew;
+            pNode = &(pNew->node_);
+        }
+    }
+
+    if (pNode->usNum_ + ((pNode->pTerm_)? 1 : 0) <= 1)
+        _ArtMapCollapse(ppRef);
+    return;
+}
+
+void _ArtMapCollapse(void **ppRef)
+{
+    ArtNode *pNode = (ArtNode*)*ppRef;
+    if (pNode->usNum_ == 0) {
+        *ppRef = (pNode->pTerm_)? ART_TAG(pNode->pTerm_) : NULL;
+        free(pNode);
+        return;
+    }
+
+    int32_t iPos = 0;
+    void *pChild = _ArtMapNextChild(pNode, &iPos);
+    if (!ART_IS_LEAF(pChild)) {
+        /* Join the paths through the label. Only the leading bytes are kept
+           inline, and the length covers the whole joined path. */
+        ArtNode *pLower = (ArtNode*)pChild;
+        uint8_t ucByte = (pNode->ucType_ == ART_NODE_4)?
+                         ((ArtNode4*)pNode)->aKey_[0] :
+                         (pNode->ucType_ == ART_NODE_16)?
+                         ((ArtNode16*)pNode)->aKey_[0] : (uint8_t)(iPos - 1);
+        uint8_t aPrefix[ART_PREFIX_INLINE];
+        int32_t iLen = (pNode->uiLenPrefix_ < ART_PREFIX_INLINE)?
+                       pNode->uiLenPrefix_ : ART_PREFIX_INLINE;
+        memcpy(aPrefix, pNode->aPrefix_, iLen);
+        if (iLen < ART_PREFIX_INLINE)
+            aPrefix[iLen++] = ucByte;
+        int32_t iIdx;
+        for (iIdx = 0 ; (iLen < ART_PREFIX_INLINE) &&
+             (iIdx < (int32_t)pLower->uiLenPrefix_) ; iIdx++)
+            aPrefix[iLen++] = pLower->aPrefix_[iIdx];
+
+        memcpy(pLower->aPrefix_, aPrefix, iLen);
+        pLower->uiLenPrefix_ += pNode->uiLenPrefix_ + 1;
+    }
+
+    *ppRef = pChild;
+    free(pNode);
+    return;
+}
+
+ArtLeaf* _ArtMapMinimum(void *pCurr)
+{
+    while (!ART_IS_LEAF(pCurr)) {
+        ArtNode *pNode = (ArtNode*)pCurr;
+        if (pNode->pTerm_)
+            return pNode->pTerm_;
+        int32_t iPos = 0;
+        pCurr = _ArtMapNextChild(pNode, &iPos);
+    }
+    return ART_LEAF(pCurr);
+}
+
+ArtLeaf* _ArtMapMaximum(void *pCurr)
+{
+    while (!ART_IS_LEAF(pCurr)) {
+        ArtNode *pNode = (ArtNode*)pCurr;
+        int32_t iIdx;
+        switch (pNode->ucType_) {
+            case ART_NODE_4:
+                pCurr = ((ArtNode4*)pNode)->aChild_[pNode->usNum_ - 1];
+                break;
+            case ART_NODE_16:
+                pCurr = ((ArtNode16*)pNode)->aChild_[pNode->usNum_ - 1];
+                break;
+            case ART_NODE_48: {
+                ArtNode48 *pNode48 = (ArtNode48*)pNode;
+                for (iIdx = 255 ; !(pNode48->aIndex_[iIdx]) ; iIdx--);
+                pCurr = pNode48->aChild_[pNode48->aIndex_[iIdx] - 1];
+                break;
+            }
+            default: {
+                ArtNode256 *pNode256 = (ArtNode256*)pNode;
+                for (iIdx = 255 ; !(pNode256->aChild_[iIdx]) ; iIdx--);
+                pCurr = pNode256->aChild_[iIdx];
+            }
+        }
+    }
+    return ART_LEAF(pCurr);
+}
+
+int32_t _ArtMapMismatch(ArtNode *pNode, uint8_t *aKey, int32_t iSize,
+                        int32_t iDepth)
+{
+    int32_t iMax = iSize - iDepth;
+    if ((int32_t)pNode->uiLenPrefix_ < iMax)
+        iMax = pNode->uiLenPrefix_;
+
+    int32_t iIdx;
+    int32_t iInline = (iMax < ART_PREFIX_INLINE)? iMax : ART_PREFIX_INLINE;
+    for (iIdx = 0 ; iIdx < iInline ; iIdx++) {
+        if (pNode->aPrefix_[iIdx] != aKey[iDepth + iIdx])
+            return iIdx;
+    }
+    if (iIdx == iMax)
+        return iMax;
+
+    ArtLeaf *pLeaf = _ArtMapMinimum(pNode);
+    for ( ; iIdx < iMax ; iIdx++) {
+        if (pLeaf->aKey_[iDepth + iIdx] != aKey[iDepth + iIdx])
+            return iIdx;
+    }
+    return iMax;
+}
+
+ArtLeaf* _ArtMapSearch(ArtMapData *pData, uint8_t *aKey, int32_t iSize)
+{
+    void *pCurr = pData->pRoot_;
+    int32_t iDepth = 0;
+
+    while (pCurr) {
+        if (ART_IS_LEAF(pCurr)) {
+            ArtLeaf *pLeaf = ART_LEAF(pCurr);
+            return (_ArtMapLeafMatch(pLeaf, aKey, iSize))? pLeaf : NULL;
+        }
+
+        ArtNode *pNode = (ArtNode*)pCurr;
+        int32_t iLen = pNode->uiLenPrefix_;
+        if (iLen > 0) {
+            int32_t iCmp = (iLen < ART_PREFIX_INLINE)? iLen : ART_PREFIX_INLINE;
+            if ((iDepth + iLen > iSize) ||
+                (memcmp(pNode->aPrefix_, aKey + iDepth, iCmp) != 0))
+                return NULL;
+            iDepth += iLen;
+        }
+
+        if (iDepth == iSize) {
+            ArtLeaf *pLeaf = pNode->pTerm_;
+            return (pLeaf && _ArtMapLeafMatch(pLeaf, aKey, iSize))? pLeaf : NULL;
+        }
+
+        void **ppSlot = _ArtMapFindChild(pNode, aKey[iDepth]);
+        if (!ppSlot)
+            return NULL;
+        pCurr = *ppSlot;
+        ++iDepth;
+    }
+
+    return NULL;
+}
+
+int32_t _ArtMapInsert(ArtMapData *pData, uint8_t *aKey, int32_t iSize,
+                      Value value)
+{
+    void **ppRef = &(pData->pRoot_);
+    int32_t iDepth = 0;
+
+    while (true) {
+        void *pCurr = *ppRef;
+        if (!pCurr) {
+            ArtLeaf *pNew = _ArtMapNewLeaf(aKey, iSize, value);
+            if (!pNew)
+                return ERR_NOMEM;
+            *ppRef = ART_TAG(pNew);
+            break;
+        }
+
+        if (ART_IS_LEAF(pCurr)) {
+            ArtLeaf *pLeaf = ART_LEAF(pCurr);
+            if (_ArtMapLeafMatch(pLeaf, aKey, iSize)) {
+                if (pData->pDestroy_)
+                    pData->pDestroy_(&(pLeaf->entry_));
+                pLeaf->entry_.value = value;
+                return SUCC;
+            }
+
+            /* Lazy expansion: the node appears only where the two keys branch,
+               and it compresses their common bytes. */
+            ArtLeaf *pNew = _ArtMapNewLeaf(aKey, iSize, value);
+            ArtNode *pNode = _ArtMapNewNode(ART_NODE_4);
+            if (!pNew || !pNode) {
+                free(pNew);
+                free(pNode);
+                return ERR_NOMEM;
+            }
+
+            int32_t iLimit = (pLeaf->entry_.iSize < iSize)?
+                             pLeaf->entry_.iSize : iSize;
+            int32_t iSplit = iDepth;
+            while ((iSplit < iLimit) && (pLeaf->aKey_[iSplit] == aKey[iSplit]))
+                ++iSplit;
+            int32_t iLen = iSplit - iDepth;
+            pNode->uiLenPrefix_ = iLen;
+            if (iLen > 0)
+                memcpy(pNode->aPrefix_, aKey + iDepth,
+                       (iLen < ART_PREFIX_INLINE)? iLen : ART_PREFIX_INLINE);
+
+            *ppRef = pNode;
+            if (pLeaf->entry_.iSize == iSplit)
+                pNode->pTerm_ = pLeaf;
+            else
+                _ArtMapAddChild(ppRef, pLeaf->aKey_[iSplit], pCurr);
+            if (iSize == iSplit)
+                pNode->pTerm_ = pNew;
+            else
+                _ArtMapAddChild(ppRef, aKey[iSplit], ART_TAG(pNew));
+            break;
+        }
+
+        ArtNode *pNode = (ArtNode*)pCurr;
+        int32_t iLen = pNode->uiLenPrefix_;
+        if (iLen > 0) {
+            int32_t iDiff = _ArtMapMismatch(pNode, aKey, iSize, iDepth);
+            if (iDiff < iLen) {
+                /* Split the compressed path at the first mismatched byte. */
+                ArtLeaf *pNew = _ArtMapNewLeaf(aKey, iSize, value);
+                ArtNode *pUpper = _ArtMapNewNode(ART_NODE_4);
+                if (!pNew || !pUpper) {
+                    free(pNew);
+                    free(pUpper);
+                    return ERR_NOMEM;
+                }
+                pUpper->uiLenPrefix_ = iDiff;
+                memcpy(pUpper->aPrefix_, pNode->aPrefix_,
+                       (iDiff < ART_PREFIX_INLINE)? iDiff : ART_PREFIX_INLINE);
+
+                uint8_t ucByte;
+                pNode->uiLenPrefix_ = iLen - iDiff - 1;
+                if (iLen <= ART_PREFIX_INLINE) {
+                    ucByte = pNode->aPrefix_[iDiff];
+                    memmove(pNode->aPrefix_, pNode->aPrefix_ + iDiff + 1,
+                            pNode->uiLenPrefix_);
+                } else {
+                    ArtLeaf *pMin = _ArtMapMinimum(pNode);
+                    ucByte = pMin->aKey_[iDepth + iDiff];
+                    int32_t iCopy = pNode->uiLenPrefix_;
+                    memcpy(pNode->aPrefix_, pMin->aKey_ + iDepth + iDiff + 1,
+                           (iCopy < ART_PREFIX_INLINE)?
+                           iCopy : ART_PREFIX_INLINE);
+                }
+
+                *ppRef = pUpper;
+                _ArtMapAddChild(ppRef, ucByte, pNode);
+                if (iSize == iDepth + iDiff)
+                    pUpper->pTerm_ = pNew;
+                else
+                    _ArtMapAddChild(ppRef, aKey[iDepth + iDiff], ART_TAG(pNew));
+                break;
+            }
+            iDepth += iLen;
+        }
+
+        if (iDepth == iSize) {
+            if (pNode->pTerm_) {
+                ArtLeaf *pLeaf = pNode->pTerm_;
+                if (pData->pDestroy_)
+                    pData->pDestroy_(&(pLeaf->entry_));
+                pLeaf->entry_.value = value;
+                return SUCC;
+            }
+            pNode->pTerm_ = _ArtMapNewLeaf(aKey, iSize, value);
+            if (!(pNode->pTerm_))
+                return ERR_NOMEM;
+            break;
+        }
+
+        void **ppSlot = _ArtMapFindChild(pNode, aKey[iDepth]);
+        if (ppSlot) {
+            ppRef = ppSlot;
+            ++iDepth;
+            continue;
+        }
+
+        ArtLeaf *pNew = _ArtMapNewLeaf(aKey, iSize, value);
+        if (!pNew)
+            return ERR_NOMEM;
+        if (_ArtMapAddChild(ppRef, aKey[iDepth], ART_TAG(pNew)) != SUCC) {
+            free(pNew);
+            return ERR_NOMEM;
+        }
+        break;
+    }
+
+    pData->iSize_++;
+    return SUCC;
+}
+
+ArtLeaf* _ArtMapDelete(ArtMapData *pData, uint8_t *aKey, int32_t iSize)
+{
+    void **ppRef = &(pData->pRoot_);
+    void *pCurr = *ppRef;
+    if (!pCurr)
+        return NULL;
+
+    if (ART_IS_LEAF(pCurr)) {
+        ArtLeaf *pLeaf = ART_LEAF(pCurr);
+        if (!_ArtMapLeafMatch(pLeaf, aKey, iSize))
+            return NULL;
+        *ppRef = NULL;
+        return pLeaf;
+    }
+
+    int32_t iDepth = 0;
+    while (true) {
+        ArtNode *pNode = (ArtNode*)*ppRef;
+        int32_t iLen = pNode->uiLenPrefix_;
+        if (iLen > 0) {
+            int32_t iCmp = (iLen < ART_PREFIX_INLINE)? iLen : ART_PREFIX_INLINE;
+            if ((iDepth + iLen > iSize) ||
+                (memcmp(pNode->aPrefix_, aKey + iDepth, iCmp) != 0))
+                return NULL;
+            iDepth += iLen;
+        }
+
+        if (iDepth == iSize) {
+            ArtLeaf *pLeaf = pNode->pTerm_;
+            if (!pLeaf || !_ArtMapLeafMatch(pLeaf, aKey, iSize))
+                return NULL;
+            pNode->pTerm_ = NULL;
+            if (pNode->usNum_ <= 1)
+                _ArtMapCollapse(ppRef);
+            return pLeaf;
+        }
+
+        uint8_t ucByte = aKey[iDepth];
+        void **ppSlot = _ArtMapFindChild(pNode, ucByte);
+        if (!ppSlot)
+            return NULL;
+
+        void *pChild = *ppSlot;
+        if (ART_IS_LEAF(pChild)) {
+            ArtLeaf *pLeaf = ART_LEAF(pChild);
+            if (!_ArtMapLeafMatch(pLeaf, aKey, iSize))
+                return NULL;
+            _ArtMapRemoveChild(ppRef, ucByte, ppSlot);
+            return pLeaf;
+        }
+
+        ppRef = ppSlot;
+        ++iDepth;
+    }
+}
+
+int32_t _ArtMapPush(ArtMapData *pData, void *pNode)
+{
+    int32_t iRtn = SUCC;
+    if (pData->iTop_ == pData->iCapFrame_) {
+        int32_t iCap = (pData->iCapFrame_)?
+                       (pData->iCapFrame_ << 1) : SIZE_FRAME_INIT;
+        ArtFrame *aFrame = (ArtFrame*)realloc(pData->aFrame_,
+                                              sizeof(ArtFrame) * iCap);
+        if (!aFrame) {
+            iRtn = ERR_NOMEM;
+            goto EXIT;
+        }
+        pData->aFrame_ = aFrame;
+        pData->iCapFrame_ = iCap;
+    }
+
+    ArtFrame *pFrame = &(pData->aFrame_[pData->iTop_++]);
+    pFrame->pNode_ = pNode;
+    pFrame->iPos_ = -1;
+
+EXIT:
+    return iRtn;
+}
+
+int32_t _ArtMapNext(ArtMapData *pData, ArtEntry **ppEntry)
+{
+    /* Each frame keeps the position of the next child to visit, and the
+       shorter key hung on the node goes before all the children. */
+    while (pData->iTop_ > 0) {
+        ArtFrame *pFrame = &(pData->aFrame_[pData->iTop_ - 1]);
+        if (ART_IS_LEAF(pFrame->pNode_)) {
+            pData->iTop_--;
+            *ppEntry = &(ART_LEAF(pFrame->pNode_)->entry_);
+            return CONTINUE;
+        }
+
+        ArtNode *pNode = (ArtNode*)pFrame->pNode_;
+        if (pFrame->iPos_ < 0) {
+            pFrame->iPos_ = 0;
+            if (pNode->pTerm_) {
+                *ppEntry = &(pNode->pTerm_->entry_);
+                return CONTINUE;
+            }
+        }
+
+        void *pChild = _ArtMapNextChild(pNode, &(pFrame->iPos_));
+        if (!pChild) {
+            pData->iTop_--;
+            continue;
+        }
+        if (ART_IS_LEAF(pChild)) {
+            *ppEntry = &(ART_LEAF(pChild)->entry_);
+            return CONTINUE;
+        }
+        if (_ArtMapPush(pData, pChild) != SUCC)
+            return ERR_NOMEM;
+    }
+
+    *ppEntry = NULL;
+    return END;
+}
@@ -0,0 +1,759 @@
+#include "container/btree_map.h"
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+typedef struct _BTreeNode {
+    int32_t iCount;
+    bool bLeaf;
+} BTreeNode;
+
+/* Every node is allocated with the same size, a multiple of the cache line
+   size, and the slot counts are the most that fit in it. On 64 bit targets the
+   inner node fills its lines exactly, while the leaf with its two links ends
+   8 bytes short of them. */
+#define NODE_SIZE       (512)
+#define NODE_ALIGN      (64)
+#define LEAF_SLOTS      ((int32_t)((NODE_SIZE - sizeof(BTreeNode) - 2 * sizeof(void*)) / \
+                                   (sizeof(Key) + sizeof(Pair*))))
+#define INNER_SLOTS     ((int32_t)((NODE_SIZE - sizeof(BTreeNode) - sizeof(void*)) / \
+                                   (sizeof(Key) + sizeof(void*))))
+#define LEAF_MIN        (LEAF_SLOTS / 2)
+#define INNER_MIN       ((INNER_SLOTS - 1) / 2)
+
+/* The leaf stores the keys inline next to the pair pointers. The leaves are
+   doubly linked for the ordered iteration. */
+typedef struct _BTreeLeaf {
+    BTreeNode head;
+    struct _BTreeLeaf *pPrev;
+    struct _BTreeLeaf *pNext;
+    Key aKey[LEAF_SLOTS];
+    Pair *aPair[LEAF_SLOTS];
+} BTreeLeaf;
+
+/* The child i holds the keys within [aKey[i - 1], aKey[i]). */
+typedef struct _BTreeInner {
+    BTreeNode head;
+    Key aKey[INNER_SLOTS];
+    BTreeNode *aChild[INNER_SLOTS + 1];
+} BTreeInner;
+
+struct _BTreeMapData {
+    int32_t iSize_;
+    int32_t iIter_;
+    BTreeNode *pRoot_;
+    BTreeLeaf *pIter_;
+    int32_t (*pCompare_) (Key, Key);
+    void (*pDestroy_) (Pair*);
+};
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Allocate an empty node aligned to the cache line.
+ *
+ * @param bLeaf         Whether to allocate a leaf node
+ *
+ * @return              The pointer to the allocated node or NULL
+ */
+BTreeNode* _BTreeMapNewNode(bool bLeaf);
+
+/**
+ * @brief Release all the nodes of the subtree rooted by the designated node.
+ *
+ * If the custom resource clean method is set, it also runs the clean method for
+ * the pairs stored in the leaves.
+ *
+ * @param pData         The pointer to the map private data
+ * @param pNode         The pointer to the designated node
+ */
+void _BTreeMapDeinit(BTreeMapData *pData, BTreeNode *pNode);
+
+/**
+ * @brief Return the index of the first key not ordered before the designated
+ * key, or ordered after the key for the upper bound.
+ *
+ * @param aKey          The array of sorted keys
+ * @param iCount        The number of keys
+ * @param key           The designated key
+ * @param pCompare      The key comparison method
+ * @param bUpper        Whether to find the upper bound
+ *
+ * @return              The bound index
+ */
+int32_t _BTreeMapBound(Key *aKey, int32_t iCount, Key key,
+                       int32_t (*pCompare) (Key, Key), bool bUpper);
+
+/**
+ * @brief Get the leaf which should contain the designated key.
+ *
+ * @param pData         The pointer to the map private data
+ * @param key           The designated key
+ * @param pIdx          The pointer to the returned index of the key in the leaf
+ *                      or -1 if the key cannot be found
+ *
+ * @return              The pointer to the leaf
+ */
+BTreeLeaf* _BTreeMapSearch(BTreeMapData *pData, Key key, int32_t *pIdx);
+
+/**
+ * @brief Split the designated full child and insert the separator key into the
+ * parent.
+ *
+ * @param pParent       The pointer to the parent node which is not full
+ * @param iIdx          The index of the designated child
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for the new node
+ */
+int32_t _BTreeMapSplitChild(BTreeInner *pParent, int32_t iIdx);
+
+/**
+ * @brief Refill the designated child which holds the minimum number of keys.
+ *
+ * The child borrows one key from a sibling which has spare keys, or is merged
+ * with a sibling otherwise.
+ *
+ * @param pParent       The pointer to the parent node
+ * @param iIdx          The index of the designated child
+ *
+ * @return              The index of the refilled child, which moves to the
+ *                      left sibling if the two are merged
+ */
+int32_t _BTreeMapFillChild(BTreeInner *pParent, int32_t iIdx);
+
+/**
+ * @brief Merge the designated child with its right sibling.
+ *
+ * @param pParent       The pointer to the parent node
+ * @param iIdx          The index of the designated child
+ */
+void _BTreeMapMergeChild(BTreeInner *pParent, int32_t iIdx);
+
+/**
+ * @brief The default key comparison method.
+ *
+ * @param keySrc         The source key
+ * @param keyTge         The target key
+ *
+ * @retval 1             The source key has the larger order
+ * @retval 0             Both the keys have the same order
+ * @retval -1            The source key has the smaller order
+ */
+int32_t _BTreeMapCompare(Key keySrc, Key keyTge);
+
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData->pRoot_))                                     \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+#define NODE_FULL(pNode)                                                        \
+            ((pNode)->iCount == (((pNode)->bLeaf)? LEAF_SLOTS : INNER_SLOTS))
+
+#define NODE_LEAN(pNode)                                                        \
+            ((pNode)->iCount <= (((pNode)->bLeaf)? LEAF_MIN : INNER_MIN))
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t BTreeMapInit(BTreeMap **ppObj)
+{
+    *ppObj = (BTreeMap*)malloc(sizeof(BTreeMap));
+    if (!(*ppObj))
+        return ERR_NOMEM;
+    BTreeMap *pObj = *ppObj;
+
+    pObj->pData = (BTreeMapData*)malloc(sizeof(BTreeMapData));
+    if (!(pObj->pData)) {
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+    BTreeMapData *pData = pObj->pData;
+
+    /* The empty map is represented by an empty root leaf. */
+    pData->pRoot_ = _BTreeMapNewNode(true);
+    if (!(pData->pRoot_)) {
+        free(pObj->pData);
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+    pData->iSize_ = 0;
+    pData->iIter_ = 0;
+    pData->pIter_ = NULL;
+    pData->pCompare_ = _BTreeMapCompare;
+    pData->pDestroy_ = NULL;
+
+    pObj->put = BTreeMapPut;
+    pObj->get = BTreeMapGet;
+    pObj->find = BTreeMapFind;
+    pObj->remove = BTreeMapRemove;
+    pObj->size = BTreeMapSize;
+    pObj->minimum = BTreeMapMinimum;
+    pObj->maximum = BTreeMapMaximum;
+    pObj->predecessor = BTreeMapPredecessor;
+    pObj->successor = BTreeMapSuccessor;
+    pObj->iterate = BTreeMapIterate;
+    pObj->reverse_iterate = BTreeMapReverseIterate;
+    pObj->set_compare = BTreeMapSetCompare;
+    pObj->set_destroy = BTreeMapSetDestroy;
+
+    return SUCC;
+}
+
+void BTreeMapDeinit(BTreeMap **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+    BTreeMapData *pData = (*ppObj)->pData;
+    if (!pData)
+        goto FREE_MAP;
+    if (pData->pRoot_)
+        _BTreeMapDeinit(pData, pData->pRoot_);
+    free(pData);
+FREE_MAP:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t BTreeMapPut(BTreeMap *self, Pair *pPair)
+{
+    CHECK_INIT(self);
+    BTreeMapData *pData = self->pData;
+    Key key = pPair->key;
+
+    /* Grow the tree by one level if the root is full. */
+    if (NODE_FULL(pData->pRoot_)) {
+        BTreeInner *pRoot = (BTreeInner*)_BTreeMapNewNode(false);
+        if (!pRoot)
+            return ERR_NOMEM;
+        pRoot->aChild[0] = pData->pRoot_;
+        if (_BTreeMapSplitChild(pRoot, 0) != SUCC) {
+            free(pRoot);
+            return ERR_NOMEM;
+        }
+        pData->pRoot_ = (BTreeNode*)pRoot;
+    }
+
+    /* Split the full nodes on the way down so that the leaf always has room
+       for the new key. */
+    BTreeNode *pNode = pData->pRoot_;
+    while (!pNode->bLeaf) {
+        BTreeInner *pInner = (BTreeInner*)pNode;
+        int32_t iIdx = _BTreeMapBound(pInner->aKey, pNode->iCount, key,
+                                      pData->pCompare_, true);
+        if (NODE_FULL(pInner->aChild[iIdx])) {
+            if (_BTreeMapSplitChild(pInner, iIdx) != SUCC)
+                return ERR_NOMEM;
+            if (pData->pCompare_(key, pInner->aKey[iIdx]) >= 0)
+                iIdx++;
+        }
+        pNode = pInner->aChild[iIdx];
+    }
+
+    BTreeLeaf *pLeaf = (BTreeLeaf*)pNode;
+    int32_t iCount = pNode->iCount;
+    int32_t iIdx = _BTreeMapBound(pLeaf->aKey, iCount, key, pData->pCompare_,
+                                  false);
+    if ((iIdx < iCount) && (pData->pCompare_(pLeaf->aKey[iIdx], key) == 0)) {
+        if (pData->pDestroy_ && (pLeaf->aPair[iIdx] != pPair))
+            pData->pDestroy_(pLeaf->aPair[iIdx]);
+        pLeaf->aKey[iIdx] = key;
+        pLeaf->aPair[iIdx] = pPair;
+        return SUCC;
+    }
+
+    int32_t iShftSize = iCount - iIdx;
+    if (iShftSize > 0) {
+        memmove(pLeaf->aKey + iIdx + 1, pLeaf->aKey + iIdx, sizeof(Key) * iShftSize);
+        memmove(pLeaf->aPair + iIdx + 1, pLeaf->aPair + iIdx,
+                sizeof(Pair*) * iShftSize);
+    }
+    pLeaf->aKey[iIdx] = key;
+    pLeaf->aPair[iIdx] = pPair;
+    pNode->iCount++;
+    pData->iSize_++;
+    return SUCC;
+}
+
+int32_t BTreeMapGet(BTreeMap *self, Key key, Value *pValue)
+{
+    CHECK_INIT(self);
+    if (!pValue)
+        return ERR_GET;
+
+    int32_t iIdx;
+    BTreeLeaf *pLeaf = _BTreeMapSearch(self->pData, key, &iIdx);
+    if (iIdx < 0) {
+        *pValue = NULL;
+        return ERR_NODATA;
+    }
+    *pValue = pLeaf->aPair[iIdx]->value;
+    return SUCC;
+}
+
+int32_t BTreeMapFind(BTreeMap *self, Key key)
+{
+    CHECK_INIT(self);
+
+    int32_t iIdx;
+    _BTreeMapSearch(self->pData, key, &iIdx);
+    return (iIdx < 0)? NOKEY : SUCC;
+}
+
+int32_t BTreeMapRemove(BTreeMap *self, Key key)
+{
+    CHECK_INIT(self);
+    BTreeMapData *pData = self->pData;
+
+    /* Refill the lean nodes on the way down so that the leaf can lose a key
+       without further rebalancing. */
+    BTreeNode *pNode = pData->pRoot_;
+    while (!pNode->bLeaf) {
+        BTreeInner *pInner = (BTreeInner*)pNode;
+        int32_t iIdx = _BTreeMapBound(pInner->aKey, pNode->iCount, key,
+                                      pData->pCompare_, true);
+        if (NODE_LEAN(pInner->aChild[iIdx]))
+            iIdx = _BTreeMapFillChild(pInner, iIdx);
+        pNode = pInner->aChild[iIdx];
+
+        /* Shrink the tree by one level if the root loses its last key. */
+        if (pInner->head.iCount == 0) {
+            pData->pRoot_ = pNode;
+            free(pInner);
+        }
+    }
+
+    BTreeLeaf *pLeaf = (BTreeLeaf*)pNode;
+    int32_t iCount = pNode->iCount;
+    int32_t iIdx = _BTreeMapBound(pLeaf->aKey, iCount, key, pData->pCompare_,
+                                  false);
+    if ((iIdx == iCount) || (pData->pCompare_(pLeaf->aKey[iIdx], key) != 0))
+        return ERR_NODATA;
+
+    if (pData->pDestroy_)
+        pData->pDestroy_(pLeaf->aPair[iIdx]);
+    int32_t iShftSize = iCount - iIdx - 1;
+    if (iShftSize > 0) {
+        memmove(pLeaf->aKey + iIdx, pLeaf->aKey + iIdx + 1, sizeof(Key) * iShftSize);
+        memmove(pLeaf->aPair + iIdx, pLeaf->aPair + iIdx + 1,
+                sizeof(Pair*) * iShftSize);
+    }
+    pNode->iCount--;
+    pData->iSize_--;
+    return SUCC;
+}
+
+int32_t BTreeMapSize(BTreeMap *self)
+{
+    CHECK_INIT(self);
+    return self->pData->iSize_;
+}
+
+int32_t BTreeMapMinimum(BTreeMap *self, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    BTreeNode *pNode = self->pData->pRoot_;
+    while (!pNode->bLeaf)
+        pNode = ((BTreeInner*)pNode)->aChild[0];
+    if (pNode->iCount == 0) {
+        *ppPair = NULL;
+        return ERR_IDX;
+    }
+    *ppPair = ((BTreeLeaf*)pNode)->aPair[0];
+    return SUCC;
+}
+
+int32_t BTreeMapMaximum(BTreeMap *self, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    BTreeNode *pNode = self->pData->pRoot_;
+    while (!pNode->bLeaf)
+        pNode = ((BTreeInner*)pNode)->aChild[pNode->iCount];
+    if (pNode->iCount == 0) {
+        *ppPair = NULL;
+        return ERR_IDX;
+    }
+    *ppPair = ((BTreeLeaf*)pNode)->aPair[pNode->iCount - 1];
+    return SUCC;
+}
+
+int32_t BTreeMapPredecessor(BTreeMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    int32_t iIdx;
+    BTreeLeaf *pLeaf = _BTreeMapSearch(self->pData, key, &iIdx);
+    if (iIdx < 0)
+        return ERR_NODATA;
+
+    /* Only the root leaf can be empty, so the previous leaf has keys. */
+    if (iIdx == 0) {
+        pLeaf = pLeaf->pPrev;
+        if (!pLeaf) {
+            *ppPair = NULL;
+            return ERR_NODATA;
+        }
+        iIdx = pLeaf->head.iCount;
+    }
+    *ppPair = pLeaf->aPair[iIdx - 1];
+    return SUCC;
+}
+
+int32_t BTreeMapSuccessor(BTreeMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    int32_t iIdx;
+    BTreeLeaf *pLeaf = _BTreeMapSearch(self->pData, key, &iIdx);
+    if (iIdx < 0)
+        return ERR_NODATA;
+
+    iIdx++;
+    if (iIdx == pLeaf->head.iCount) {
+        pLeaf = pLeaf->pNext;
+        if (!pLeaf) {
+            *ppPair = NULL;
+            return ERR_NODATA;
+        }
+        iIdx = 0;
+    }
+    *ppPair = pLeaf->aPair[iIdx];
+    return SUCC;
+}
+
+int32_t BTreeMapIterate(BTreeMap *self, bool bReset, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    BTreeMapData *pData = self->pData;
+
+    if (bReset) {
+        BTreeNode *pNode = pData->pRoot_;
+        while (!pNode->bLeaf)
+            pNode = ((BTreeInner*)pNode)->aChild[0];
+        pData->pIter_ = (BTreeLeaf*)pNode;
+        pData->iIter_ = 0;
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+
+    BTreeLeaf *pLeaf = pData->pIter_;
+    while (pLeaf && (pData->iIter_ >= pLeaf->head.iCount)) {
+        pLeaf = pLeaf->pNext;
+        pData->iIter_ = 0;
+    }
+    pData->pIter_ = pLeaf;
+    if (!pLeaf) {
+        *ppPair = NULL;
+        return END;
+    }
+    *ppPair = pLeaf->aPair[pData->iIter_++];
+    return SUCC;
+}
+
+int32_t BTreeMapReverseIterate(BTreeMap *self, bool bReset, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    BTreeMapData *pData = self->pData;
+
+    if (bReset) {
+        BTreeNode *pNode = pData->pRoot_;
+        while (!pNode->bLeaf)
+            pNode = ((BTreeInner*)pNode)->aChild[pNode->iCount];
+        pData->pIter_ = (BTreeLeaf*)pNode;
+        pData->iIter_ = pNode->iCount - 1;
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+
+    BTreeLeaf *pLeaf = pData->pIter_;
+    while (pLeaf && (pData->iIter_ < 0)) {
+        pLeaf = pLeaf->pPrev;
+        if (pLeaf)
+            pData->iIter_ = pLeaf->head.iCount - 1;
+    }
+    pData->pIter_ = pLeaf;
+    if (!pLeaf) {
+        *ppPair = NULL;
+        return END;
+    }
+    *ppPair = pLeaf->aPair[pData->iIter_--];
+    return SUCC;
+}
+
+int32_t BTreeMapSetCompare(BTreeMap *self, int32_t (*pFunc) (Key, Key))
+{
+    CHECK_INIT(self);
+    self->pData->pCompare_ = pFunc;
+    return SUCC;
+}
+
+int32_t BTreeMapSetDestroy(BTreeMap *self, void (*pFunc) (Pair*))
+{
+    CHECK_INIT(self);
+    self->pData->pDestroy_ = pFunc;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+BTreeNode* _BTreeMapNewNode(bool bLeaf)
+{
+    void *pMem;
+    if (posix_memalign(&pMem, NODE_ALIGN, NODE_SIZE) != 0)
+        return NULL;
+
+    BTreeNode *pNode = (BTreeNode*)pMem;
+    pNode->iCount = 0;
+    pNode->bLeaf = bLeaf;
+    if (bLeaf) {
+        ((BTreeLeaf*)pNode)->pPrev = NULL;
+        ((BTreeLeaf*)pNode)->pNext = NULL;
+    }
+    return pNode;
+}
+
+void _BTreeMapDeinit(BTreeMapData *pData, BTreeNode *pNode)
+{
+    int32_t iIdx;
+    if (pNode->bLeaf) {
+        if (pData->pDestroy_) {
+            BTreeLeaf *pLeaf = (BTreeLeaf*)pNode;
+            for (iIdx = 0 ; iIdx < pNode->iCount ; iIdx++)
+                pData->pDestroy_(pLeaf->aPair[iIdx]);
+        }
+    } else {
+        BTreeInner *pInner = (BTreeInner*)pNode;
+        for (iIdx = 0 ; iIdx <= pNode->iCount ; iIdx++)
+            _BTreeMapDeinit(pData, pInner->aChild[iIdx]);
+    }
+    free(pNode);
+    return;
+}
+
+int32_t _BTreeMapBound(Key *aKey, int32_t iCount, Key key,
+                       int32_t (*pCompare) (Key, Key), bool bUpper)
+{
+    int32_t iLow = 0, iHigh = iCount;
+    int32_t iLimit = (bUpper)? 1 : 0;
+    while (iLow < iHigh) {
+        int32_t iMid = (iLow + iHigh) >> 1;
+        if (pCompare(aKey[iMid], key) < iLimit)
+            iLow = iMid + 1;
+        else
+            iHigh = iMid;
+    }
+    return iLow;
+}
+
+BTreeLeaf* _BTreeMapSearch(BTreeMapData *pData, Key key, int32_t *pIdx)
+{
+    BTreeNode *pNode = pData->pRoot_;
+    while (!pNode->bLeaf) {
+        BTreeInner *pInner = (BTreeInner*)pNode;
+        int32_t iIdx = _BTreeMapBound(pInner->aKey, pNode->iCount, key,
+                                      pData->pCompare_, true);
+        pNode = pInner->aChild[iIdx];
+    }
+
+    BTreeLeaf *pLeaf = (BTreeLeaf*)pNode;
+    int32_t iIdx = _BTreeMapBound(pLeaf->aKey, pNode->iCount, key,
+                                  pData->pCompare_, false);
+    if ((iIdx == pNode->iCount) || (pData->pCompare_(pLeaf->aKey[iIdx], key) != 0))
+        iIdx = -1;
+    *pIdx = iIdx;
+    return pLeaf;
+}
+
+int32_t _BTreeMapSplitChild(BTreeInner *pParent, int32_t iIdx)
+{
+    BTreeNode *pChild = pParent->aChild[iIdx];
+    BTreeNode *pSplit = _BTreeMapNewNode(pChild->bLeaf);
+    if (!pSplit)
+        return ERR_NOMEM;
+
+    Key keySep;
+    int32_t iHalf = pChild->iCount >> 1;
+    if (pChild->bLeaf) {
+        /* Copy the upper half to the new leaf, whose first key is copied up as
+           the separator. */
+        BTreeLeaf *pLeft = (BTreeLeaf*)pChild;
+        BTreeLeaf *pRight = (BTreeLeaf*)pSplit;
+        int32_t iMove = pChild->iCount - iHalf;
+        memcpy(pRight->aKey, pLeft->aKey + iHalf, sizeof(Key) * iMove);
+        memcpy(pRight->aPair, pLeft->aPair + iHalf, sizeof(Pair*) * iMove);
+        pSplit->iCount = iMove;
+        pChild->iCount = iHalf;
+
+        pRight->pNext = pLeft->pNext;
+        if (pRight->pNext)
+            pRight->pNext->pPrev = pRight;
+        pRight->pPrev = pLeft;
+        pLeft->pNext = pRight;
+        keySep = pRight->aKey[0];
+    } else {
+        /* Move the middle key up and the keys after it to the new node. */
+        BTreeInner *pLeft = (BTreeInner*)pChild;
+        BTreeInner *pRight = (BTreeInner*)pSplit;
+        int32_t iMove = pChild->iCount - iHalf - 1;
+        memcpy(pRight->aKey, pLeft->aKey + iHalf + 1, sizeof(Key) * iMove);
+        memcpy(pRight->aChild, pLeft->aChild + iHalf + 1,
+               sizeof(BTreeNode*) * (iMove + 1));
+        pSplit->iCount = iMove;
+        pChild->iCount = iHalf;
+        keySep = pLeft->aKey[iHalf];
+    }
+
+    int32_t iShftSize = pParent->head.iCount - iIdx;
+    if (iShftSize > 0) {
+        memmove(pParent->aKey + iIdx + 1, pParent->aKey + iIdx,
+                sizeof(Key) * iShftSize);
+        memmove(pParent->aChild + iIdx + 2, pParent->aChild + iIdx + 1,
+                sizeof(BTreeNode*) * iShftSize);
+    }
+    pParent->aKey[iIdx] = keySep;
+    pParent->aChild[iIdx + 1] = pSplit;
+    pParent->head.iCount++;
+    return SUCC;
+}
+
+int32_t _BTreeMapFillChild(BTreeInner *pParent, int32_t iIdx)
+{
+    BTreeNode *pChild = pParent->aChild[iIdx];
+    BTreeNode *pLeft = (iIdx > 0)? pParent->aChild[iIdx - 1] : NULL;
+    BTreeNode *pRight = (iIdx < pParent->head.iCount)?
+                        pParent->aChild[iIdx + 1] : NULL;
+
+    if (pLeft && !NODE_LEAN(pLeft)) {
+        /* Rotate the last key of the left sibling through the parent. */
+        int32_t iCount = pChild->iCount;
+        if (pChild->bLeaf) {
+            BTreeLeaf *pDst = (BTreeLeaf*)pChild;
+            BTreeLeaf *pSrc = (BTreeLeaf*)pLeft;
+            memmove(pDst->aKey + 1, pDst->aKey, sizeof(Key) * iCount);
+            memmove(pDst->aPair + 1, pDst->aPair, sizeof(Pair*) * iCount);
+            pDst->aKey[0] = pSrc->aKey[pLeft->iCount - 1];
+            pDst->aPair[0] = pSrc->aPair[pLeft->iCount - 1];
+            pParent->aKey[iIdx - 1] = pDst->aKey[0];
+        } else {
+            BTreeInner *pDst = (BTreeInner*)pChild;
+            BTreeInner *pSrc = (BTreeInner*)pLeft;
+            memmove(pDst->aKey + 1, pDst->aKey, sizeof(Key) * iCount);
+            memmove(pDst->aChild + 1, pDst->aChild, sizeof(BTreeNode*) * (iCount + 1));
+            pDst->aKey[0] = pParent->aKey[iIdx - 1];
+            pDst->aChild[0] = pSrc->aChild[pLeft->iCount];
+            pParent->aKey[iIdx - 1] = pSrc->aKey[pLeft->iCount - 1];
+        }
+        pLeft->iCount--;
+        pChild->iCount++;
+        return iIdx;
+    }
+
+    if (pRight && !NODE_LEAN(pRight)) {
+        /* Rotate the first key of the right sibling through the parent. */
+        int32_t iCount = pChild->iCount;
+        int32_t iRest = pRight->iCount - 1;
+        if (pChild->bLeaf) {
+            BTreeLeaf *pDst = (BTreeLeaf*)pChild;
+            BTreeLeaf *pSrc = (BTreeLeaf*)pRight;
+            pDst->aKey[iCount] = pSrc->aKey[0];
+            pDst->aPair[iCount] = pSrc->aPair[0];
+            memmove(pSrc->aKey, pSrc->aKey + 1, sizeof(Key) * iRest);
+            memmove(pSrc->aPair, pSrc->aPair + 1, sizeof(Pair*) * iRest);
+            pParent->aKey[iIdx] = pSrc->aKey[0];
+        } else {
+            BTreeInner *pDst = (BTreeInner*)pChild;
+            BTreeInner *pSrc = (BTreeInner*)pRight;
+            pDst->aKey[iCount] = pParent->aKey[iIdx];
+            pDst->aChild[iCount + 1] = pSrc->aChild[0];
+            pParent->aKey[iIdx] = pSrc->aKey[0];
+            memmove(pSrc->aKey, pSrc->aKey + 1, sizeof(Key) * iRest);
+            memmove(pSrc->aChild, pSrc->aChild + 1, sizeof(BTreeNode*) * (iRest + 1));
+        }
+        pRight->iCount--;
+        pChild->iCount++;
+        return iIdx;
+    }
+
+    /* Both the siblings are lean, so merge the child with one of them. */
+    if (pRight) {
+        _BTreeMapMergeChild(pParent, iIdx);
+        return iIdx;
+    }
+    _BTreeMapMergeChild(pParent, iIdx - 1);
+    return iIdx - 1;
+}
+
+void _BTreeMapMergeChild(BTreeInner *pParent, int32_t iIdx)
+{
+    BTreeNode *pLeft = pParent->aChild[iIdx];
+    BTreeNode *pRight = pParent->aChild[iIdx + 1];
+    int32_t iCount = pLeft->iCount;
+
+    if (pLeft->bLeaf) {
+        BTreeLeaf *pDst = (BTreeLeaf*)pLeft;
+        BTreeLeaf *pSrc = (BTreeLeaf*)pRight;
+        memcpy(pDst->aKey + iCount, pSrc->aKey, sizeof(Key) * pRight->iCount);
+        memcpy(pDst->aPair + iCount, pSrc->aPair, sizeof(Pair*) * pRight->iCount);
+        pLeft->iCount += pRight->iCount;
+        pDst->pNext = pSrc->pNext;
+        if (pDst->pNext)
+            pDst->pNext->pPrev = pDst;
+    } else {
+        /* The separator is pulled down between the keys of the two nodes. */
+        BTreeInner *pDst = (BTreeInner*)pLeft;
+        BTreeInner *pSrc = (BTreeInner*)pRight;
+        pDst->aKey[iCount] = pParent->aKey[iIdx];
+        memcpy(pDst->aKey + iCount + 1, pSrc->aKey, sizeof(Key) * pRight->iCount);
+        memcpy(pDst->aChild + iCount + 1, pSrc->aChild,
+               sizeof(BTreeNode*) * (pRight->iCount + 1));
+        pLeft->iCount += pRight->iCount + 1;
+    }
+    free(pRight);
+
+    int32_t iShftSize = pParent->head.iCount - iIdx - 1;
+    if (iShftSize > 0) {
+        memmove(pParent->aKey + iIdx, pParent->aKey + iIdx + 1,
+                sizeof(Key) * iShftSize);
+        memmove(pParent->aChild + iIdx + 1, pParent->aChild + iIdx + 2,
+                sizeof(BTreeNode*) * iShftSize);
+    }
+    pParent->head.iCount--;
+    return;
+}
+
+int32_t _BTreeMapCompare(Key keySrc, Key keyTge)
+{
+    if (keySrc == keyTge)
+        return 0;
+    return (keySrc > keyTge)? 1 : (-1);
+}
@@ -0,0 +1,358 @@
+#include "container/concurrent_tree_map.h"
+#include "memory/epoch.h"
+#include <pthread.h>
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+/* The published version of the map. The epoch link comes first so that the
+   reclaimed links can be cast back to the versions. */
+typedef struct _TreeVersion {
+    EpochNode node;
+    TreeMapSnapshot snap;
+} TreeVersion;
+
+struct _ConcurrentTreeMapData {
+    TreeMap *pMap_;
+    TreeVersion *pLatest_;
+    Epoch epoch_;
+    pthread_mutex_t mutex_;
+};
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Publish the current content of the map as the latest version, and
+ * reclaim the versions which no reader can reach.
+ *
+ * @param pData         The pointer to the map private data
+ * @param pVer          The pointer to the version to be published
+ *
+ * @note It should be called with the writer lock held.
+ */
+void _ConcurrentTreeMapPublish(ConcurrentTreeMapData *pData, TreeVersion *pVer);
+
+/**
+ * @brief Release the list of the versions detached from the epoch domain.
+ *
+ * @param pData         The pointer to the map private data
+ * @param pNode         The pointer to the first detached link
+ */
+void _ConcurrentTreeMapRelease(ConcurrentTreeMapData *pData, EpochNode *pNode);
+
+/**
+ * @brief Pin the latest version for the calling thread.
+ *
+ * @param pData         The pointer to the map private data
+ * @param puiTicket     The pointer to the returned epoch ticket
+ *
+ * @return              The pointer to the pinned version
+ */
+TreeVersion* _ConcurrentTreeMapPin(ConcurrentTreeMapData *pData,
+                                   uint32_t *puiTicket);
+
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData->pMap_))                                      \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t ConcurrentTreeMapInit(ConcurrentTreeMap **ppObj)
+{
+    int32_t iRtn = ERR_NOMEM;
+
+    *ppObj = (ConcurrentTreeMap*)malloc(sizeof(ConcurrentTreeMap));
+    if (!(*ppObj))
+        goto EXIT;
+    ConcurrentTreeMap *pObj = *ppObj;
+
+    pObj->pData = (ConcurrentTreeMapData*)malloc(sizeof(ConcurrentTreeMapData));
+    if (!(pObj->pData))
+        goto FREE_MAP;
+    ConcurrentTreeMapData *pData = pObj->pData;
+
+    pData->pLatest_ = (TreeVersion*)malloc(sizeof(TreeVersion));
+    if (!(pData->pLatest_))
+        goto FREE_DATA;
+
+    if (EpochInit(&(pData->epoch_)) != SUCC)
+        goto FREE_VERSION;
+
+    iRtn = TreeMapInit(&(pData->pMap_));
+    if (iRtn != SUCC)
+        goto FREE_EPOCH;
+
+    if (pthread_mutex_init(&(pData->mutex_), NULL) != 0) {
+        iRtn = ERR_NOMEM;
+        goto FREE_TREE;
+    }
+
+    /* Keep a version alive all the time, so that every write copies the nodes
+       visible to the readers instead of modifying them in place. */
+    TreeMapSnapshotTake(pData->pMap_, &(pData->pLatest_->snap));
+
+    pObj->put = ConcurrentTreeMapPut;
+    pObj->get = ConcurrentTreeMapGet;
+    pObj->find = ConcurrentTreeMapFind;
+    pObj->remove = ConcurrentTreeMapRemove;
+    pObj->size = ConcurrentTreeMapSize;
+    pObj->view_open = ConcurrentTreeMapViewOpen;
+    pObj->view_close = ConcurrentTreeMapViewClose;
+    pObj->view_get = ConcurrentTreeMapViewGet;
+    pObj->view_iterate = ConcurrentTreeMapViewIterate;
+    pObj->view_seek = ConcurrentTreeMapViewSeek;
+    pObj->set_compare = ConcurrentTreeMapSetCompare;
+    pObj->set_destroy = ConcurrentTreeMapSetDestroy;
+    return SUCC;
+
+FREE_TREE:
+    TreeMapDeinit(&(pData->pMap_));
+FREE_EPOCH:
+    EpochDeinit(&(pData->epoch_));
+FREE_VERSION:
+    free(pData->pLatest_);
+FREE_DATA:
+    free(pObj->pData);
+FREE_MAP:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return iRtn;
+}
+
+void ConcurrentTreeMapDeinit(ConcurrentTreeMap **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+
+    ConcurrentTreeMap *pObj = *ppObj;
+    if (!(pObj->pData))
+        goto FREE_MAP;
+
+    ConcurrentTreeMapData *pData = pObj->pData;
+    if (!(pData->pMap_))
+        goto FREE_DATA;
+
+    _ConcurrentTreeMapRelease(pData, EpochFlush(&(pData->epoch_)));
+    TreeMapSnapshotRelease(pData->pMap_, &(pData->pLatest_->snap));
+    free(pData->pLatest_);
+
+    TreeMapDeinit(&(pData->pMap_));
+    EpochDeinit(&(pData->epoch_));
+    pthread_mutex_destroy(&(pData->mutex_));
+
+FREE_DATA:
+    free(pObj->pData);
+FREE_MAP:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t ConcurrentTreeMapPut(ConcurrentTreeMap *self, Pair *pPair)
+{
+    CHECK_INIT(self);
+
+    TreeVersion *pVer = (TreeVersion*)malloc(sizeof(TreeVersion));
+    if (!pVer)
+        return ERR_NOMEM;
+
+    ConcurrentTreeMapData *pData = self->pData;
+    pthread_mutex_lock(&(pData->mutex_));
+    int32_t iRtn = TreeMapPut(pData->pMap_, pPair);
+    if (iRtn == SUCC)
+        _ConcurrentTreeMapPublish(pData, pVer);
+    pthread_mutex_unlock(&(pData->mutex_));
+
+    if (iRtn != SUCC)
+        free(pVer);
+    return iRtn;
+}
+
+int32_t ConcurrentTreeMapGet(ConcurrentTreeMap *self, Key key, Value *pValue)
+{
+    CHECK_INIT(self);
+    if (!pValue)
+        return ERR_GET;
+
+    uint32_t uiTicket;
+    ConcurrentTreeMapData *pData = self->pData;
+    TreeVersion *pVer = _ConcurrentTreeMapPin(pData, &uiTicket);
+    int32_t iRtn = TreeMapSnapshotGet(pData->pMap_, &(pVer->snap), key, pValue);
+    EpochExit(&(pData->epoch_), uiTicket);
+    return iRtn;
+}
+
+int32_t ConcurrentTreeMapFind(ConcurrentTreeMap *self, Key key)
+{
+    CHECK_INIT(self);
+
+    Value value;
+    uint32_t uiTicket;
+    ConcurrentTreeMapData *pData = self->pData;
+    TreeVersion *pVer = _ConcurrentTreeMapPin(pData, &uiTicket);
+    int32_t iRtn = TreeMapSnapshotGet(pData->pMap_, &(pVer->snap), key, &value);
+    EpochExit(&(pData->epoch_), uiTicket);
+    return (iRtn == SUCC)? SUCC : NOKEY;
+}
+
+int32_t ConcurrentTreeMapRemove(ConcurrentTreeMap *self, Key key)
+{
+    CHECK_INIT(self);
+
+    TreeVersion *pVer = (TreeVersion*)malloc(sizeof(TreeVersion));
+    if (!pVer)
+        return ERR_NOMEM;
+
+    ConcurrentTreeMapData *pData = self->pData;
+    pthread_mutex_lock(&(pData->mutex_));
+    int32_t iRtn = TreeMapRemove(pData->pMap_, key);
+    if (iRtn == SUCC)
+        _ConcurrentTreeMapPublish(pData, pVer);
+    pthread_mutex_unlock(&(pData->mutex_));
+
+    if (iRtn != SUCC)
+        free(pVer);
+    return iRtn;
+}
+
+int32_t ConcurrentTreeMapSize(ConcurrentTreeMap *self)
+{
+    CHECK_INIT(self);
+
+    uint32_t uiTicket;
+    ConcurrentTreeMapData *pData = self->pData;
+    TreeVersion *pVer = _ConcurrentTreeMapPin(pData, &uiTicket);
+    int32_t iSize = pVer->snap.iSize;
+    EpochExit(&(pData->epoch_), uiTicket);
+    return iSize;
+}
+
+int32_t ConcurrentTreeMapViewOpen(ConcurrentTreeMap *self,
+                                  ConcurrentTreeMapView *pView)
+{
+    CHECK_INIT(self);
+    if (!pView)
+        return ERR_GET;
+
+    /* Copy only the fields which the writers never touch after publishing, so
+       the view owns its iteration state. */
+    TreeVersion *pVer = _ConcurrentTreeMapPin(self->pData, &(pView->uiTicket));
+    pView->snap.pRoot = pVer->snap.pRoot;
+    pView->snap.iSize = pVer->snap.iSize;
+    pView->snap.pRetire = NULL;
+    pView->snap.pPrev = NULL;
+    pView->snap.pNext = NULL;
+    pView->snap.iDepth = 0;
+    return SUCC;
+}
+
+int32_t ConcurrentTreeMapViewClose(ConcurrentTreeMap *self,
+                                   ConcurrentTreeMapView *pView)
+{
+    CHECK_INIT(self);
+    if (!pView || !(pView->snap.pRoot))
+        return ERR_GET;
+
+    pView->snap.pRoot = NULL;
+    pView->snap.iDepth = 0;
+    EpochExit(&(self->pData->epoch_), pView->uiTicket);
+    return SUCC;
+}
+
+int32_t ConcurrentTreeMapViewGet(ConcurrentTreeMap *self,
+                                 ConcurrentTreeMapView *pView, Key key,
+                                 Value *pValue)
+{
+    CHECK_INIT(self);
+    if (!pView)
+        return ERR_GET;
+
+    return TreeMapSnapshotGet(self->pData->pMap_, &(pView->snap), key, pValue);
+}
+
+int32_t ConcurrentTreeMapViewIterate(ConcurrentTreeMap *self,
+                                     ConcurrentTreeMapView *pView, bool bReset,
+                                     Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!pView)
+        return ERR_GET;
+
+    return TreeMapSnapshotIterate(self->pData->pMap_, &(pView->snap), bReset,
+                                  ppPair);
+}
+
+int32_t ConcurrentTreeMapViewSeek(ConcurrentTreeMap *self,
+                                  ConcurrentTreeMapView *pView, Key key)
+{
+    CHECK_INIT(self);
+    if (!pView)
+        return ERR_GET;
+
+    return TreeMapSnapshotSeek(self->pData->pMap_, &(pView->snap), key);
+}
+
+int32_t ConcurrentTreeMapSetCompare(ConcurrentTreeMap *self,
+                                    int32_t (*pFunc) (Key, Key))
+{
+    CHECK_INIT(self);
+    return TreeMapSetCompare(self->pData->pMap_, pFunc);
+}
+
+int32_t ConcurrentTreeMapSetDestroy(ConcurrentTreeMap *self,
+                                    void (*pFunc) (Pair*))
+{
+    CHECK_INIT(self);
+    return TreeMapSetDestroy(self->pData->pMap_, pFunc);
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+void _ConcurrentTreeMapPublish(ConcurrentTreeMapData *pData, TreeVersion *pVer)
+{
+    TreeMapSnapshotTake(pData->pMap_, &(pVer->snap));
+
+    /* The new root is fully built before the store, and the readers which load
+       the replaced version are counted in the epoch before they do. */
+    TreeVersion *pOld = pData->pLatest_;
+    __atomic_store_n(&(pData->pLatest_), pVer, __ATOMIC_SEQ_CST);
+
+    EpochRetire(&(pData->epoch_), &(pOld->node));
+    _ConcurrentTreeMapRelease(pData, EpochReclaim(&(pData->epoch_)));
+    return;
+}
+
+void _ConcurrentTreeMapRelease(ConcurrentTreeMapData *pData, EpochNode *pNode)
+{
+    while (pNode) {
+        EpochNode *pNext = pNode->pNext;
+        TreeVersion *pVer = (TreeVersion*)pNode;
+        TreeMapSnapshotRelease(pData->pMap_, &(pVer->snap));
+        free(pVer);
+        pNode = pNext;
+    }
+    return;
+}
+
+TreeVersion* _ConcurrentTreeMapPin(ConcurrentTreeMapData *pData,
+                                   uint32_t *puiTicket)
+{
+    *puiTicket = EpochEnter(&(pData->epoch_));
+    return __atomic_load_n(&(pData->pLatest_), __ATOMIC_SEQ_CST);
+}
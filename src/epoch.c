@@ -0,0 +1,171 @@
+#include "memory/epoch.h"
+#include <pthread.h>
+
+
+#define SIZE_CACHE_LINE     (64)
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Map the calling thread to its reader counter slot.
+ *
+ * @return              The slot index
+ */
+uint32_t _EpochSlot();
+
+/**
+ * @brief Reverse the list of the retired objects.
+ *
+ * @param pNode         The pointer to the newest retired object
+ *
+ * @return              The pointer to the oldest retired object
+ */
+EpochNode* _EpochReverse(EpochNode *pNode);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t EpochInit(Epoch *pEpoch)
+{
+    pEpoch->ulEpoch = 0;
+    pEpoch->iBusy = 0;
+    memset(pEpoch->aLimbo, 0, sizeof(pEpoch->aLimbo));
+
+    void *pSlot;
+    if (posix_memalign(&pSlot, SIZE_CACHE_LINE,
+                       sizeof(EpochSlot) * EPOCH_NUM_SLOT) != 0) {
+        pEpoch->aSlot = NULL;
+        return ERR_NOMEM;
+    }
+    pEpoch->aSlot = (EpochSlot*)pSlot;
+    memset(pEpoch->aSlot, 0, sizeof(EpochSlot) * EPOCH_NUM_SLOT);
+    return SUCC;
+}
+
+void EpochDeinit(Epoch *pEpoch)
+{
+    free(pEpoch->aSlot);
+    pEpoch->aSlot = NULL;
+    memset(pEpoch->aLimbo, 0, sizeof(pEpoch->aLimbo));
+    return;
+}
+
+uint32_t EpochEnter(Epoch *pEpoch)
+{
+    /* The reader is counted in the epoch which is still current after the
+       counting, so the epoch cannot move two steps beyond it until it exits. */
+    uint32_t uiSlot = _EpochSlot();
+    uint64_t ulEpoch = __atomic_load_n(&pEpoch->ulEpoch, __ATOMIC_SEQ_CST);
+    while (true) {
+        uint32_t uiParity = (uint32_t)(ulEpoch & 1);
+        __atomic_fetch_add(&pEpoch->aSlot[uiSlot].aCount[uiParity], 1,
+                           __ATOMIC_SEQ_CST);
+        uint64_t ulCheck = __atomic_load_n(&pEpoch->ulEpoch, __ATOMIC_SEQ_CST);
+        if (ulCheck == ulEpoch)
+            return (uiSlot << 1) | uiParity;
+        __atomic_fetch_sub(&pEpoch->aSlot[uiSlot].aCount[uiParity], 1,
+                           __ATOMIC_SEQ_CST);
+        ulEpoch = ulCheck;
+    }
+}
+
+void EpochExit(Epoch *pEpoch, uint32_t uiTicket)
+{
+    __atomic_fetch_sub(&pEpoch->aSlot[uiTicket >> 1].aCount[uiTicket & 1], 1,
+                       __ATOMIC_RELEASE);
+    return;
+}
+
+void EpochRetire(Epoch *pEpoch, EpochNode *pNode)
+{
+    /* A late push into the list of an older epoch only delays the object. */
+    uint64_t ulEpoch = __atomic_load_n(&pEpoch->ulEpoch, __ATOMIC_SEQ_CST);
+    EpochNode **ppHead = &pEpoch->aLimbo[ulEpoch % EPOCH_NUM_LIMBO];
+    EpochNode *pHead = __atomic_load_n(ppHead, __ATOMIC_RELAXED);
+    do {
+        pNode->pNext = pHead;
+    } while (!__atomic_compare_exchange_n(ppHead, &pHead, pNode, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    return;
+}
+
+EpochNode* EpochReclaim(Epoch *pEpoch)
+{
+    if (__atomic_load_n(&pEpoch->iBusy, __ATOMIC_RELAXED) ||
+        __atomic_exchange_n(&pEpoch->iBusy, 1, __ATOMIC_ACQUIRE))
+        return NULL;
+
+    /* The epoch moves from e to e + 1 only if no reader is counted in the
+       parity of e - 1, which is the parity reused by the new epoch. */
+    EpochNode *pList = NULL;
+    uint64_t ulEpoch = __atomic_load_n(&pEpoch->ulEpoch, __ATOMIC_SEQ_CST);
+    uint32_t uiParity = (uint32_t)((ulEpoch + 1) & 1);
+    uint32_t uiSlot;
+    for (uiSlot = 0 ; uiSlot < EPOCH_NUM_SLOT ; uiSlot++) {
+        int64_t lCount = __atomic_load_n(&pEpoch->aSlot[uiSlot].aCount[uiParity],
+                                         __ATOMIC_SEQ_CST);
+        if (lCount != 0)
+            goto RELEASE;
+    }
+    ulEpoch++;
+    __atomic_store_n(&pEpoch->ulEpoch, ulEpoch, __ATOMIC_SEQ_CST);
+
+    /* The objects retired in epoch e - 1 are unreachable since epoch e + 1.
+       Their list is reused by epoch e + 2, which cannot start before the flag
+       is released. */
+    EpochNode **ppHead = &pEpoch->aLimbo[(ulEpoch + 1) % EPOCH_NUM_LIMBO];
+    pList = _EpochReverse(__atomic_exchange_n(ppHead, NULL, __ATOMIC_ACQUIRE));
+
+RELEASE:
+    __atomic_store_n(&pEpoch->iBusy, 0, __ATOMIC_RELEASE);
+    return pList;
+}
+
+EpochNode* EpochFlush(Epoch *pEpoch)
+{
+    /* Visit the objects from the newest one, and prepend each of them. */
+    EpochNode *pList = NULL;
+    uint64_t ulEpoch = pEpoch->ulEpoch + EPOCH_NUM_LIMBO;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < EPOCH_NUM_LIMBO ; iIdx++) {
+        EpochNode **ppHead = &pEpoch->aLimbo[(ulEpoch - iIdx) % EPOCH_NUM_LIMBO];
+        EpochNode *pHead = *ppHead;
+        *ppHead = NULL;
+        while (pHead) {
+            EpochNode *pNext = pHead->pNext;
+            pHead->pNext = pList;
+            pList = pHead;
+            pHead = pNext;
+        }
+    }
+    return pList;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+uint32_t _EpochSlot()
+{
+    /* Mix the thread identity since its low bits are often aligned. */
+    uint64_t ulId = (uint64_t)(uintptr_t)pthread_self();
+    ulId ^= ulId >> 33;
+    ulId *= 0xff51afd7ed558ccdull;
+    ulId ^= ulId >> 33;
+    return (uint32_t)(ulId % EPOCH_NUM_SLOT);
+}
+
+EpochNode* _EpochReverse(EpochNode *pNode)
+{
+    EpochNode *pPrev = NULL;
+    while (pNode) {
+        EpochNode *pNext = pNode->pNext;
+        pNode->pNext = pPrev;
+        pPrev = pNode;
+        pNode = pNext;
+    }
+    return pPrev;
+}
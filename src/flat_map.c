@@ -0,0 +1,532 @@
+#include "container/flat_map.h"
+#include "memory/storage.h"
+#include "sort_internal.h"
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+struct _FlatMapData {
+    int32_t iSize_;
+    int32_t iCapacity_;
+    int32_t iIter_;
+    Storage store_;
+    Pair *aPair_;
+    int32_t (*pCompare_) (Key, Key);
+    void (*pDestroy_) (Pair*);
+};
+
+#define DEFAULT_CAPACITY    (4)
+
+typedef int32_t (*PairCompare) (Key, Key);
+
+/* The comparison method receives the keys of the pairs. */
+#define PAIR_ORDER(pCompare, pSrc, pTge)                                        \
+            ((pCompare)((pSrc)->key, (pTge)->key))
+#define PAIR_ORDER_PROBE(pCompare, pPair, keyTge)                               \
+            ((pCompare)((pPair)->key, (keyTge)))
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Extend the storage to hold the designated number of additional pairs.
+ *
+ * The capacity is at least doubled so that the repeated insertions stay
+ * amortized.
+ *
+ * @param pData         The pointer to the map private data
+ * @param iNum          The number of additional pairs
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for map extension
+ */
+int32_t _FlatMapReserve(FlatMapData *pData, int32_t iNum);
+
+/**
+ * @brief Return the index of the first pair not ordered before the designated
+ * key, or ordered after the key for the upper bound.
+ *
+ * @param aPair         The array of sorted pairs
+ * @param iSize         The number of pairs
+ * @param key           The designated key
+ * @param pCompare      The key comparison method
+ * @param bUpper        Whether to find the upper bound
+ *
+ * @return              The bound index
+ */
+int64_t _FlatMapBound(const Pair *aPair, int64_t iSize, Key key,
+                      PairCompare pCompare, bool bUpper);
+
+/**
+ * @brief Stably sort the designated pairs by their keys.
+ *
+ * @param aPair         The array of pairs
+ * @param aTmp          The auxiliary buffer with the same size
+ * @param iSize         The number of pairs
+ * @param pCompare      The key comparison method
+ */
+void _FlatMapSort(Pair *aPair, Pair *aTmp, int64_t iSize, PairCompare pCompare);
+
+/**
+ * @brief Remove the duplicated keys from the sorted pairs.
+ *
+ * For each group of pairs sharing the same order, the last one is kept and the
+ * others are passed to the custom resource clean method if it is set.
+ *
+ * @param pData         The pointer to the map private data
+ * @param aPair         The array of sorted pairs
+ * @param iSize         The number of pairs
+ *
+ * @return              The number of the kept pairs
+ */
+int32_t _FlatMapUnique(FlatMapData *pData, Pair *aPair, int32_t iSize);
+
+/**
+ * @brief The default key comparison method.
+ *
+ * @param keySrc         The source key
+ * @param keyTge         The target key
+ *
+ * @retval 1             The source key has the larger order
+ * @retval 0             Both the keys have the same order
+ * @retval -1            The source key has the smaller order
+ */
+int32_t _FlatMapCompare(Key keySrc, Key keyTge);
+
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t FlatMapInit(FlatMap **ppObj)
+{
+    *ppObj = (FlatMap*)malloc(sizeof(FlatMap));
+    if (!(*ppObj))
+        return ERR_NOMEM;
+    FlatMap *pObj = *ppObj;
+
+    pObj->pData = (FlatMapData*)malloc(sizeof(FlatMapData));
+    if (!(pObj->pData)) {
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+    FlatMapData *pData = pObj->pData;
+
+    StorageInit(&pData->store_, STORAGE_HEAP, NULL);
+    if (StorageResize(&pData->store_, sizeof(Pair) * DEFAULT_CAPACITY) != SUCC) {
+        free(pObj->pData);
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+    pData->aPair_ = (Pair*)pData->store_.pBase;
+    pData->iCapacity_ = DEFAULT_CAPACITY;
+    pData->iSize_ = 0;
+    pData->iIter_ = 0;
+    pData->pCompare_ = _FlatMapCompare;
+    pData->pDestroy_ = NULL;
+
+    pObj->put = FlatMapPut;
+    pObj->put_batch = FlatMapPutBatch;
+    pObj->build = FlatMapBuild;
+    pObj->get = FlatMapGet;
+    pObj->find = FlatMapFind;
+    pObj->remove = FlatMapRemove;
+    pObj->size = FlatMapSize;
+    pObj->minimum = FlatMapMinimum;
+    pObj->maximum = FlatMapMaximum;
+    pObj->predecessor = FlatMapPredecessor;
+    pObj->successor = FlatMapSuccessor;
+    pObj->iterate = FlatMapIterate;
+    pObj->reverse_iterate = FlatMapReverseIterate;
+    pObj->set_compare = FlatMapSetCompare;
+    pObj->set_destroy = FlatMapSetDestroy;
+
+    return SUCC;
+}
+
+void FlatMapDeinit(FlatMap **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+    FlatMapData *pData = (*ppObj)->pData;
+    if (!pData)
+        goto FREE_MAP;
+
+    if (pData->pDestroy_) {
+        int32_t iIdx;
+        for (iIdx = 0 ; iIdx < pData->iSize_ ; iIdx++)
+            pData->pDestroy_(&pData->aPair_[iIdx]);
+    }
+    StorageDeinit(&pData->store_);
+    free(pData);
+FREE_MAP:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t FlatMapPut(FlatMap *self, const Pair *pPair)
+{
+    CHECK_INIT(self);
+    if (!pPair)
+        return ERR_GET;
+
+    /* Replace the pair having the same order in place. */
+    FlatMapData *pData = self->pData;
+    int32_t iIdx = (int32_t)_FlatMapBound(pData->aPair_, pData->iSize_,
+                                           pPair->key, pData->pCompare_, false);
+    if ((iIdx < pData->iSize_) &&
+        (pData->pCompare_(pData->aPair_[iIdx].key, pPair->key) == 0)) {
+        if (pData->pDestroy_)
+            pData->pDestroy_(&pData->aPair_[iIdx]);
+        pData->aPair_[iIdx] = *pPair;
+        return SUCC;
+    }
+
+    int32_t iRtnCode = _FlatMapReserve(pData, 1);
+    if (iRtnCode != SUCC)
+        return iRtnCode;
+
+    Pair *aPair = pData->aPair_;
+    int32_t iShftSize = pData->iSize_ - iIdx;
+    if (iShftSize > 0)
+        memmove(aPair + iIdx + 1, aPair + iIdx, sizeof(Pair) * iShftSize);
+    aPair[iIdx] = *pPair;
+    pData->iSize_++;
+    return SUCC;
+}
+
+int32_t FlatMapPutBatch(FlatMap *self, const Pair *aPair, int32_t iNum)
+{
+    CHECK_INIT(self);
+    if ((iNum < 0) || ((iNum > 0) && (!aPair)))
+        return ERR_IDX;
+    if (iNum == 0)
+        return SUCC;
+
+    /* Sort a copy of the designated pairs with the auxiliary buffer. */
+    FlatMapData *pData = self->pData;
+    Pair *aNew = (Pair*)malloc(sizeof(Pair) * iNum * 2);
+    if (!aNew)
+        return ERR_NOMEM;
+    memcpy(aNew, aPair, sizeof(Pair) * iNum);
+    _FlatMapSort(aNew, aNew + iNum, iNum, pData->pCompare_);
+
+    int32_t iRtnCode = _FlatMapReserve(pData, iNum);
+    if (iRtnCode != SUCC) {
+        free(aNew);
+        return iRtnCode;
+    }
+    iNum = _FlatMapUnique(pData, aNew, iNum);
+
+    /* Merge from the tail end. A stored pair having the same order as a new one
+       is replaced, which leaves a gap between the remaining stored pairs and
+       the merged ones. */
+    Pair *aDst = pData->aPair_;
+    int32_t iFst = pData->iSize_ - 1;
+    int32_t iSnd = iNum - 1;
+    int32_t iPos = pData->iSize_ + iNum - 1;
+    while ((iFst >= 0) && (iSnd >= 0)) {
+        int32_t iOrder = pData->pCompare_(aDst[iFst].key, aNew[iSnd].key);
+        if (iOrder > 0) {
+            aDst[iPos--] = aDst[iFst--];
+            continue;
+        }
+        if (iOrder == 0) {
+            if (pData->pDestroy_)
+                pData->pDestroy_(&aDst[iFst]);
+            iFst--;
+        }
+        aDst[iPos--] = aNew[iSnd--];
+    }
+    while (iSnd >= 0)
+        aDst[iPos--] = aNew[iSnd--];
+    free(aNew);
+
+    int32_t iGap = iPos - iFst;
+    int32_t iSizeNew = pData->iSize_ + iNum - iGap;
+    if (iGap > 0)
+        memmove(aDst + iFst + 1, aDst + iPos + 1,
+                sizeof(Pair) * (iSizeNew - iFst - 1));
+    pData->iSize_ = iSizeNew;
+    return SUCC;
+}
+
+int32_t FlatMapBuild(FlatMap *self, const Pair *aPair, int32_t iNum)
+{
+    CHECK_INIT(self);
+    if ((iNum < 0) || ((iNum > 0) && (!aPair)))
+        return ERR_IDX;
+
+    /* Prepare all the memory before the stored pairs are released. */
+    FlatMapData *pData = self->pData;
+    Pair *aTmp = NULL;
+    if (iNum > 0) {
+        aTmp = (Pair*)malloc(sizeof(Pair) * iNum);
+        if (!aTmp)
+            return ERR_NOMEM;
+    }
+    if (iNum > pData->iCapacity_) {
+        if (StorageResize(&pData->store_, sizeof(Pair) * iNum) != SUCC) {
+            free(aTmp);
+            return ERR_NOMEM;
+        }
+        pData->aPair_ = (Pair*)pData->store_.pBase;
+        pData->iCapacity_ = pData->store_.ulSize / sizeof(Pair);
+    }
+
+    if (pData->pDestroy_) {
+        int32_t iIdx;
+        for (iIdx = 0 ; iIdx < pData->iSize_ ; iIdx++)
+            pData->pDestroy_(&pData->aPair_[iIdx]);
+    }
+
+    if (iNum > 0)
+        memcpy(pData->aPair_, aPair, sizeof(Pair) * iNum);
+    _FlatMapSort(pData->aPair_, aTmp, iNum, pData->pCompare_);
+    pData->iSize_ = _FlatMapUnique(pData, pData->aPair_, iNum);
+    free(aTmp);
+    return SUCC;
+}
+
+int32_t FlatMapGet(FlatMap *self, Key key, Value *pValue)
+{
+    CHECK_INIT(self);
+    if (!pValue)
+        return ERR_GET;
+
+    FlatMapData *pData = self->pData;
+    int32_t iIdx = (int32_t)_FlatMapBound(pData->aPair_, pData->iSize_, key,
+                                           pData->pCompare_, false);
+    if ((iIdx < pData->iSize_) &&
+        (pData->pCompare_(pData->aPair_[iIdx].key, key) == 0)) {
+        *pValue = pData->aPair_[iIdx].value;
+        return SUCC;
+    }
+    *pValue = NULL;
+    return ERR_NODATA;
+}
+
+int32_t FlatMapFind(FlatMap *self, Key key)
+{
+    CHECK_INIT(self);
+
+    FlatMapData *pData = self->pData;
+    int32_t iIdx = (int32_t)_FlatMapBound(pData->aPair_, pData->iSize_, key,
+                                           pData->pCompare_, false);
+    if ((iIdx < pData->iSize_) &&
+        (pData->pCompare_(pData->aPair_[iIdx].key, key) == 0))
+        return SUCC;
+    return NOKEY;
+}
+
+int32_t FlatMapRemove(FlatMap *self, Key key)
+{
+    CHECK_INIT(self);
+
+    FlatMapData *pData = self->pData;
+    int32_t iIdx = (int32_t)_FlatMapBound(pData->aPair_, pData->iSize_, key,
+                                           pData->pCompare_, false);
+    if ((iIdx == pData->iSize_) ||
+        (pData->pCompare_(pData->aPair_[iIdx].key, key) != 0))
+        return ERR_NODATA;
+
+    Pair *aPair = pData->aPair_;
+    if (pData->pDestroy_)
+        pData->pDestroy_(&aPair[iIdx]);
+    int32_t iShftSize = pData->iSize_ - iIdx - 1;
+    if (iShftSize > 0)
+        memmove(aPair + iIdx, aPair + iIdx + 1, sizeof(Pair) * iShftSize);
+    pData->iSize_--;
+    return SUCC;
+}
+
+int32_t FlatMapSize(FlatMap *self)
+{
+    CHECK_INIT(self);
+    return self->pData->iSize_;
+}
+
+int32_t FlatMapMinimum(FlatMap *self, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    FlatMapData *pData = self->pData;
+    if (pData->iSize_ == 0) {
+        *ppPair = NULL;
+        return ERR_IDX;
+    }
+    *ppPair = &pData->aPair_[0];
+    return SUCC;
+}
+
+int32_t FlatMapMaximum(FlatMap *self, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    FlatMapData *pData = self->pData;
+    if (pData->iSize_ == 0) {
+        *ppPair = NULL;
+        return ERR_IDX;
+    }
+    *ppPair = &pData->aPair_[pData->iSize_ - 1];
+    return SUCC;
+}
+
+int32_t FlatMapPredecessor(FlatMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    FlatMapData *pData = self->pData;
+    int32_t iIdx = (int32_t)_FlatMapBound(pData->aPair_, pData->iSize_, key,
+                                           pData->pCompare_, false);
+    if (iIdx == 0) {
+        *ppPair = NULL;
+        return ERR_NODATA;
+    }
+    *ppPair = &pData->aPair_[iIdx - 1];
+    return SUCC;
+}
+
+int32_t FlatMapSuccessor(FlatMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    FlatMapData *pData = self->pData;
+    int32_t iIdx = (int32_t)_FlatMapBound(pData->aPair_, pData->iSize_, key,
+                                           pData->pCompare_, true);
+    if (iIdx == pData->iSize_) {
+        *ppPair = NULL;
+        return ERR_NODATA;
+    }
+    *ppPair = &pData->aPair_[iIdx];
+    return SUCC;
+}
+
+int32_t FlatMapIterate(FlatMap *self, bool bReset, Pair **ppPair)
+{
+    CHECK_INIT(self);
+
+    FlatMapData *pData = self->pData;
+    if (bReset) {
+        pData->iIter_ = 0;
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+    if (pData->iIter_ >= pData->iSize_) {
+        *ppPair = NULL;
+        return END;
+    }
+    *ppPair = &pData->aPair_[pData->iIter_++];
+    return SUCC;
+}
+
+int32_t FlatMapReverseIterate(FlatMap *self, bool bReset, Pair **ppPair)
+{
+    CHECK_INIT(self);
+
+    FlatMapData *pData = self->pData;
+    if (bReset) {
+        pData->iIter_ = pData->iSize_ - 1;
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+    if ((pData->iIter_ < 0) || (pData->iIter_ >= pData->iSize_)) {
+        *ppPair = NULL;
+        return END;
+    }
+    *ppPair = &pData->aPair_[pData->iIter_--];
+    return SUCC;
+}
+
+int32_t FlatMapSetCompare(FlatMap *self, int32_t (*pFunc) (Key, Key))
+{
+    CHECK_INIT(self);
+    self->pData->pCompare_ = pFunc;
+    return SUCC;
+}
+
+int32_t FlatMapSetDestroy(FlatMap *self, void (*pFunc) (Pair*))
+{
+    CHECK_INIT(self);
+    self->pData->pDestroy_ = pFunc;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+int32_t _FlatMapReserve(FlatMapData *pData, int32_t iNum)
+{
+    int64_t iNeed = (int64_t)pData->iSize_ + iNum;
+    if (iNeed <= pData->iCapacity_)
+        return SUCC;
+    if (iNeed > INT32_MAX)
+        return ERR_NOMEM;
+
+    int64_t iCapNew = (int64_t)pData->iCapacity_ << 1;
+    if (iCapNew < iNeed)
+        iCapNew = iNeed;
+    if (iCapNew > INT32_MAX)
+        iCapNew = INT32_MAX;
+    if (StorageResize(&pData->store_, sizeof(Pair) * iCapNew) != SUCC)
+        return ERR_NOMEM;
+
+    size_t ulCap = pData->store_.ulSize / sizeof(Pair);
+    pData->aPair_ = (Pair*)pData->store_.pBase;
+    pData->iCapacity_ = (ulCap > INT32_MAX)? INT32_MAX : (int32_t)ulCap;
+    return SUCC;
+}
+
+SORT_DEFINE_BOUND(_FlatMapBound, Pair, Key, PairCompare, PAIR_ORDER_PROBE)
+
+SORT_DEFINE_MERGE(_FlatMapSort, Pair, PairCompare, PAIR_ORDER)
+
+int32_t _FlatMapUnique(FlatMapData *pData, Pair *aPair, int32_t iSize)
+{
+    int32_t iOut = 0, iIdx;
+    for (iIdx = 0 ; iIdx < iSize ; iIdx++) {
+        if ((iOut > 0) &&
+            (pData->pCompare_(aPair[iOut - 1].key, aPair[iIdx].key) == 0)) {
+            if (pData->pDestroy_)
+                pData->pDestroy_(&aPair[iOut - 1]);
+            aPair[iOut - 1] = aPair[iIdx];
+            continue;
+        }
+        aPair[iOut++] = aPair[iIdx];
+    }
+    return iOut;
+}
+
+int32_t _FlatMapCompare(Key keySrc, Key keyTge)
+{
+    if (keySrc == keyTge)
+        return 0;
+    return (keySrc > keyTge)? 1 : (-1);
+}
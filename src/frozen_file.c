@@ -0,0 +1,176 @@
+#include "memory/frozen_file.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+#define FROZEN_FILE_ORDER   (0x01020304)
+#define SUFFIX_TEMP         ".XXXXXX"
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Flush the directory holding the designated path so that the renamed
+ * entry survives a crash.
+ *
+ * @param szPath        The designated path
+ *
+ * @retval SUCC
+ * @retval ERR_IO       Fail to flush the directory
+ */
+int32_t _FrozenFileSyncDir(const char *szPath);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t FrozenFileCreate(FrozenFile *pFile, const char *szPath, size_t ulSize)
+{
+    pFile->pBase = NULL;
+    pFile->ulSize = ulSize;
+    pFile->iFd = -1;
+
+    size_t ulLen = strlen(szPath);
+    pFile->szTemp = (char*)malloc(ulLen + sizeof(SUFFIX_TEMP));
+    if (!pFile->szTemp)
+        return ERR_NOMEM;
+    memcpy(pFile->szTemp, szPath, ulLen);
+    memcpy(pFile->szTemp + ulLen, SUFFIX_TEMP, sizeof(SUFFIX_TEMP));
+
+    /* The temporary file lives in the same directory so that the rename
+       replaces the path atomically. */
+    pFile->iFd = mkstemp(pFile->szTemp);
+    if (pFile->iFd < 0) {
+        free(pFile->szTemp);
+        pFile->szTemp = NULL;
+        return ERR_IO;
+    }
+
+    /* The file is extended with zeros and filled through a shared mapping. */
+    if ((fchmod(pFile->iFd, 0644) != 0) ||
+        (ftruncate(pFile->iFd, (off_t)ulSize) != 0))
+        goto FAIL;
+    void *pBase = mmap(NULL, ulSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       pFile->iFd, 0);
+    if (pBase == MAP_FAILED)
+        goto FAIL;
+    pFile->pBase = (uint8_t*)pBase;
+    return SUCC;
+
+FAIL:
+    FrozenFileAbort(pFile);
+    return ERR_IO;
+}
+
+int32_t FrozenFileCommit(FrozenFile *pFile, const char *szPath,
+                         const char *szMagic, uint32_t uiVersion)
+{
+    FrozenFileHead *pHead = (FrozenFileHead*)pFile->pBase;
+    memcpy(pHead->aMagic, szMagic, sizeof(pHead->aMagic));
+    pHead->uiVersion = uiVersion;
+    pHead->uiOrder = FROZEN_FILE_ORDER;
+    pHead->ulFileSize = pFile->ulSize;
+
+    /* The content reaches the disk before the path refers to it. */
+    if ((msync(pFile->pBase, pFile->ulSize, MS_SYNC) != 0) ||
+        (fsync(pFile->iFd) != 0) ||
+        (rename(pFile->szTemp, szPath) != 0)) {
+        FrozenFileAbort(pFile);
+        return ERR_IO;
+    }
+
+    munmap(pFile->pBase, pFile->ulSize);
+    close(pFile->iFd);
+    free(pFile->szTemp);
+    pFile->pBase = NULL;
+    pFile->iFd = -1;
+    pFile->szTemp = NULL;
+    return _FrozenFileSyncDir(szPath);
+}
+
+void FrozenFileAbort(FrozenFile *pFile)
+{
+    if (pFile->pBase)
+        munmap(pFile->pBase, pFile->ulSize);
+    if (pFile->iFd >= 0)
+        close(pFile->iFd);
+    if (pFile->szTemp) {
+        unlink(pFile->szTemp);
+        free(pFile->szTemp);
+    }
+    pFile->pBase = NULL;
+    pFile->iFd = -1;
+    pFile->szTemp = NULL;
+    return;
+}
+
+int32_t FrozenFileOpen(const char *szPath, const char *szMagic,
+                       uint32_t uiVersion, size_t ulHead, uint8_t **ppBase,
+                       size_t *pulSize)
+{
+    int32_t iFd = open(szPath, O_RDONLY);
+    if (iFd < 0)
+        return ERR_IO;
+    struct stat info;
+    if ((fstat(iFd, &info) != 0) || ((size_t)info.st_size < ulHead)) {
+        close(iFd);
+        return ERR_IO;
+    }
+    size_t ulSize = (size_t)info.st_size;
+    uint8_t *pBase = (uint8_t*)mmap(NULL, ulSize, PROT_READ, MAP_SHARED, iFd, 0);
+    close(iFd);
+    if ((void*)pBase == MAP_FAILED)
+        return ERR_IO;
+
+    const FrozenFileHead *pHead = (const FrozenFileHead*)pBase;
+    if ((memcmp(pHead->aMagic, szMagic, sizeof(pHead->aMagic)) != 0) ||
+        (pHead->uiVersion != uiVersion) ||
+        (pHead->uiOrder != FROZEN_FILE_ORDER) ||
+        (pHead->ulFileSize != ulSize)) {
+        munmap(pBase, ulSize);
+        return ERR_IO;
+    }
+
+    *ppBase = pBase;
+    *pulSize = ulSize;
+    return SUCC;
+}
+
+void FrozenFileClose(uint8_t *pBase, size_t ulSize)
+{
+    munmap(pBase, ulSize);
+    return;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+int32_t _FrozenFileSyncDir(const char *szPath)
+{
+    const char *szSlash = strrchr(szPath, '/');
+    int32_t iFd;
+    if (!szSlash)
+        iFd = open(".", O_RDONLY);
+    else if (szSlash == szPath)
+        iFd = open("/", O_RDONLY);
+    else {
+        size_t ulLen = szSlash - szPath;
+        char *szDir = (char*)malloc(ulLen + 1);
+        if (!szDir)
+            return ERR_IO;
+        memcpy(szDir, szPath, ulLen);
+        szDir[ulLen] = 0;
+        iFd = open(szDir, O_RDONLY);
+        free(szDir);
+    }
+    if (iFd < 0)
+        return ERR_IO;
+
+    int32_t iRtn = (fsync(iFd) == 0)? SUCC : ERR_IO;
+    close(iFd);
+    return iRtn;
+}
@@ -0,0 +1,655 @@
+#include "container/frozen_map.h"
+#include "memory/frozen_file.h"
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+#define FROZEN_MAGIC        "CDSFROZ"
+#define FROZEN_VERSION      (2)
+#define SIZE_CACHE_LINE     (64)
+
+/* The header leads the frozen file, and the key and value arrays follow it at
+   the cache line aligned offsets. Slot 0 of both arrays is left unused so that
+   the children of slot k are the slots 2k and 2k + 1. */
+typedef struct _FrozenHeader {
+    FrozenFileHead head;
+    uint32_t uiKeySize;
+    uint32_t uiValueSize;
+    uint64_t ulNum;
+    uint64_t ulKeyOff;
+    uint64_t ulValueOff;
+} FrozenHeader;
+
+/* The state passing the sorted pairs of TreeMap to the slots in order. */
+typedef struct _FrozenLayout {
+    TreeMap *pMap;
+    TreeMapCursor cursor;
+    uint8_t *pKey;
+    uint8_t *pValue;
+    uint32_t uiKeySize;
+    uint32_t uiValueSize;
+    size_t ulKeyStride;
+    size_t ulValueStride;
+    uint64_t ulNum;
+} FrozenLayout;
+
+struct _FrozenMapData {
+    uint8_t *pBase_;
+    size_t ulMap_;
+    const uint8_t *pKey_;
+    const uint8_t *pValue_;
+    uint32_t uiKeySize_;
+    uint32_t uiValueSize_;
+    size_t ulKeyStride_;
+    size_t ulValueStride_;
+    uint64_t ulAhead_;
+    uint64_t ulNum_;
+    uint64_t ulIter_;
+    uint64_t ulRange_;
+    Key keyEnd_;
+    Pair pair_;
+    int32_t (*pCompare_) (Key, Key);
+};
+
+#define ALIGN_LINE(ulSize)  (((ulSize) + SIZE_CACHE_LINE - 1) &                \
+                             ~((uint64_t)SIZE_CACHE_LINE - 1))
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Unmap the frozen file and reset the map to the empty one.
+ *
+ * @param pData         The pointer to the map private data
+ */
+void _FrozenMapClose(FrozenMapData *pData);
+
+/**
+ * @brief Fill the slots of the designated subtree with the pairs drawn from
+ * the TreeMap cursor in the in-order sequence.
+ *
+ * @param pLayout       The pointer to the layout state
+ * @param ulSlot        The root slot of the designated subtree
+ */
+void _FrozenMapLayout(FrozenLayout *pLayout, uint64_t ulSlot);
+
+/**
+ * @brief Return the key stored in the designated slot.
+ *
+ * @param pData         The pointer to the map private data
+ * @param ulSlot        The designated slot
+ *
+ * @return              The integer key or the pointer to the key bytes
+ */
+Key _FrozenMapKey(FrozenMapData *pData, uint64_t ulSlot);
+
+/**
+ * @brief Fill the pair kept by the map with the designated slot.
+ *
+ * @param pData         The pointer to the map private data
+ * @param ulSlot        The designated slot
+ *
+ * @return              The pointer to the pair kept by the map
+ */
+Pair* _FrozenMapPair(FrozenMapData *pData, uint64_t ulSlot);
+
+/**
+ * @brief Get the slot storing the first key not ordered before the designated
+ * key, or ordered after the key for the upper bound.
+ *
+ * @param pData         The pointer to the map private data
+ * @param key           The designated key
+ * @param bUpper        Whether to find the upper bound
+ *
+ * @return              The slot or 0 if all the keys are ordered before the
+ *                      bound
+ */
+uint64_t _FrozenMapBound(FrozenMapData *pData, Key key, bool bUpper);
+
+/**
+ * @brief Get the slot storing the designated key.
+ *
+ * @param pData         The pointer to the map private data
+ * @param key           The designated key
+ *
+ * @return              The slot or 0 if the key cannot be found
+ */
+uint64_t _FrozenMapSearch(FrozenMapData *pData, Key key);
+
+/**
+ * @brief Return the slot storing the minimal key or 0 for the empty map.
+ *
+ * @param ulNum         The number of slots
+ */
+uint64_t _FrozenMapFirst(uint64_t ulNum);
+
+/**
+ * @brief Return the slot storing the maximal key or 0 for the empty map.
+ *
+ * @param ulNum         The number of slots
+ */
+uint64_t _FrozenMapLast(uint64_t ulNum);
+
+/**
+ * @brief Return the in-order successor of the designated slot or 0.
+ *
+ * @param ulNum         The number of slots
+ * @param ulSlot        The designated slot
+ */
+uint64_t _FrozenMapNext(uint64_t ulNum, uint64_t ulSlot);
+
+/**
+ * @brief Return the in-order predecessor of the designated slot or 0.
+ *
+ * @param ulNum         The number of slots
+ * @param ulSlot        The designated slot
+ */
+uint64_t _FrozenMapPrev(uint64_t ulNum, uint64_t ulSlot);
+
+/**
+ * @brief The default comparison method for a pair of keys.
+ *
+ * @param keySrc        The source key
+ * @param keyTge        The target key
+ *
+ * @retval 1            The source key should go after the target one
+ * @retval 0            The source key is equal to the target one
+ * @retval -1           The source key should go before the target one
+ */
+int32_t _FrozenMapCompare(Key keySrc, Key keyTge);
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t FrozenMapFreeze(TreeMap *pMap, const char *szPath, uint32_t uiKeySize,
+                        uint32_t uiValueSize)
+{
+    int32_t iNum = TreeMapSize(pMap);
+    if (iNum < 0)
+        return iNum;
+    if (!szPath)
+        return ERR_IDX;
+
+    FrozenLayout layout;
+    layout.pMap = pMap;
+    layout.uiKeySize = uiKeySize;
+    layout.uiValueSize = uiValueSize;
+    layout.ulKeyStride = (uiKeySize > 0)? uiKeySize : sizeof(uint64_t);
+    layout.ulValueStride = (uiValueSize > 0)? uiValueSize : sizeof(uint64_t);
+    layout.ulNum = (uint64_t)iNum;
+
+    uint64_t ulKeyOff = ALIGN_LINE(sizeof(FrozenHeader));
+    uint64_t ulValueOff = ALIGN_LINE(ulKeyOff +
+                                     layout.ulKeyStride * (layout.ulNum + 1));
+    uint64_t ulFileSize = ulValueOff + layout.ulValueStride * (layout.ulNum + 1);
+
+    /* The pairs are written to a temporary file which replaces the path
+       only after it is complete, so the readers of the old file are kept. */
+    FrozenFile file;
+    int32_t iRtn = FrozenFileCreate(&file, szPath, ulFileSize);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    layout.pKey = file.pBase + ulKeyOff;
+    layout.pValue = file.pBase + ulValueOff;
+    TreeMapCursorFirst(pMap, &layout.cursor);
+    _FrozenMapLayout(&layout, 1);
+
+    FrozenHeader *pHead = (FrozenHeader*)file.pBase;
+    pHead->uiKeySize = uiKeySize;
+    pHead->uiValueSize = uiValueSize;
+    pHead->ulNum = layout.ulNum;
+    pHead->ulKeyOff = ulKeyOff;
+    pHead->ulValueOff = ulValueOff;
+    return FrozenFileCommit(&file, szPath, FROZEN_MAGIC, FROZEN_VERSION);
+}
+
+int32_t FrozenMapInit(FrozenMap **ppObj)
+{
+    *ppObj = (FrozenMap*)malloc(sizeof(FrozenMap));
+    if (!(*ppObj))
+        return ERR_NOMEM;
+    FrozenMap *pObj = *ppObj;
+
+    pObj->pData = (FrozenMapData*)malloc(sizeof(FrozenMapData));
+    if (!(pObj->pData)) {
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+
+    pObj->pData->pBase_ = NULL;
+    pObj->pData->pCompare_ = _FrozenMapCompare;
+    _FrozenMapClose(pObj->pData);
+
+    pObj->open = FrozenMapOpen;
+    pObj->get = FrozenMapGet;
+    pObj->find = FrozenMapFind;
+    pObj->size = FrozenMapSize;
+    pObj->minimum = FrozenMapMinimum;
+    pObj->maximum = FrozenMapMaximum;
+    pObj->predecessor = FrozenMapPredecessor;
+    pObj->successor = FrozenMapSuccessor;
+    pObj->lower_bound = FrozenMapLowerBound;
+    pObj->upper_bound = FrozenMapUpperBound;
+    pObj->iterate = FrozenMapIterate;
+    pObj->iterate_range = FrozenMapIterateRange;
+    pObj->set_compare = FrozenMapSetCompare;
+
+    return SUCC;
+}
+
+void FrozenMapDeinit(FrozenMap **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+
+    FrozenMap *pObj = *ppObj;
+    if (!(pObj->pData))
+        goto FREE_MAP;
+
+    _FrozenMapClose(pObj->pData);
+    free(pObj->pData);
+FREE_MAP:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t FrozenMapOpen(FrozenMap *self, const char *szPath)
+{
+    CHECK_INIT(self);
+    if (!szPath)
+        return ERR_IDX;
+
+    FrozenMapData *pData = self->pData;
+    _FrozenMapClose(pData);
+
+    uint8_t *pBase;
+    size_t ulMap;
+    int32_t iRtn = FrozenFileOpen(szPath, FROZEN_MAGIC, FROZEN_VERSION,
+                                  sizeof(FrozenHeader), &pBase, &ulMap);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    /* Check that both arrays lie within the file before trusting them. */
+    FrozenHeader *pHead = (FrozenHeader*)pBase;
+    size_t ulKeyStride = (pHead->uiKeySize > 0)?
+                         pHead->uiKeySize : sizeof(uint64_t);
+    size_t ulValueStride = (pHead->uiValueSize > 0)?
+                           pHead->uiValueSize : sizeof(uint64_t);
+    if ((pHead->ulNum > INT32_MAX) ||
+        (pHead->ulKeyOff < sizeof(FrozenHeader)) ||
+        (pHead->ulKeyOff > pHead->ulValueOff) ||
+        (ulKeyStride * (pHead->ulNum + 1) > pHead->ulValueOff - pHead->ulKeyOff) ||
+        (pHead->ulValueOff > ulMap) ||
+        (ulValueStride * (pHead->ulNum + 1) > ulMap - pHead->ulValueOff)) {
+        FrozenFileClose(pBase, ulMap);
+        return ERR_IO;
+    }
+
+    pData->pBase_ = pBase;
+    pData->ulMap_ = ulMap;
+    pData->pKey_ = pBase + pHead->ulKeyOff;
+    pData->pValue_ = pBase + pHead->ulValueOff;
+    pData->uiKeySize_ = pHead->uiKeySize;
+    pData->uiValueSize_ = pHead->uiValueSize;
+    pData->ulKeyStride_ = ulKeyStride;
+    pData->ulValueStride_ = ulValueStride;
+    pData->ulNum_ = pHead->ulNum;
+
+    /* The descendants of slot k at a fixed depth are contiguous, so the search
+       prefetches the cache line holding them several levels ahead. */
+    pData->ulAhead_ = 2;
+    while (pData->ulAhead_ * 2 * ulKeyStride <= SIZE_CACHE_LINE)
+        pData->ulAhead_ <<= 1;
+    return SUCC;
+}
+
+int32_t FrozenMapGet(FrozenMap *self, Key key, Value *pValue)
+{
+    CHECK_INIT(self);
+    if (!pValue)
+        return ERR_GET;
+
+    FrozenMapData *pData = self->pData;
+    uint64_t ulSlot = _FrozenMapSearch(pData, key);
+    if (ulSlot == 0)
+        return ERR_NODATA;
+    *pValue = _FrozenMapPair(pData, ulSlot)->value;
+    return SUCC;
+}
+
+int32_t FrozenMapFind(FrozenMap *self, Key key)
+{
+    CHECK_INIT(self);
+    return (_FrozenMapSearch(self->pData, key) != 0)? SUCC : NOKEY;
+}
+
+int32_t FrozenMapSize(FrozenMap *self)
+{
+    CHECK_INIT(self);
+    return (int32_t)self->pData->ulNum_;
+}
+
+int32_t FrozenMapMinimum(FrozenMap *self, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    FrozenMapData *pData = self->pData;
+    if (pData->ulNum_ == 0) {
+        *ppPair = NULL;
+        return ERR_IDX;
+    }
+    *ppPair = _FrozenMapPair(pData, _FrozenMapFirst(pData->ulNum_));
+    return SUCC;
+}
+
+int32_t FrozenMapMaximum(FrozenMap *self, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    FrozenMapData *pData = self->pData;
+    if (pData->ulNum_ == 0) {
+        *ppPair = NULL;
+        return ERR_IDX;
+    }
+    *ppPair = _FrozenMapPair(pData, _FrozenMapLast(pData->ulNum_));
+    return SUCC;
+}
+
+int32_t FrozenMapPredecessor(FrozenMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    FrozenMapData *pData = self->pData;
+    uint64_t ulSlot = _FrozenMapSearch(pData, key);
+    if (ulSlot != 0)
+        ulSlot = _FrozenMapPrev(pData->ulNum_, ulSlot);
+    if (ulSlot == 0) {
+        *ppPair = NULL;
+        return ERR_NODATA;
+    }
+    *ppPair = _FrozenMapPair(pData, ulSlot);
+    return SUCC;
+}
+
+int32_t FrozenMapSuccessor(FrozenMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    FrozenMapData *pData = self->pData;
+    uint64_t ulSlot = _FrozenMapSearch(pData, key);
+    if (ulSlot != 0)
+        ulSlot = _FrozenMapNext(pData->ulNum_, ulSlot);
+    if (ulSlot == 0) {
+        *ppPair = NULL;
+        return ERR_NODATA;
+    }
+    *ppPair = _FrozenMapPair(pData, ulSlot);
+    return SUCC;
+}
+
+int32_t FrozenMapLowerBound(FrozenMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    uint64_t ulSlot = _FrozenMapBound(self->pData, key, false);
+    if (ulSlot == 0) {
+        *ppPair = NULL;
+        return ERR_NODATA;
+    }
+    *ppPair = _FrozenMapPair(self->pData, ulSlot);
+    return SUCC;
+}
+
+int32_t FrozenMapUpperBound(FrozenMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    uint64_t ulSlot = _FrozenMapBound(self->pData, key, true);
+    if (ulSlot == 0) {
+        *ppPair = NULL;
+        return ERR_NODATA;
+    }
+    *ppPair = _FrozenMapPair(self->pData, ulSlot);
+    return SUCC;
+}
+
+int32_t FrozenMapIterate(FrozenMap *self, bool bReset, Pair **ppPair)
+{
+    CHECK_INIT(self);
+
+    FrozenMapData *pData = self->pData;
+    if (bReset) {
+        pData->ulIter_ = _FrozenMapFirst(pData->ulNum_);
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+
+    if (pData->ulIter_ == 0) {
+        *ppPair = NULL;
+        return END;
+    }
+    *ppPair = _FrozenMapPair(pData, pData->ulIter_);
+    pData->ulIter_ = _FrozenMapNext(pData->ulNum_, pData->ulIter_);
+    return SUCC;
+}
+
+int32_t FrozenMapIterateRange(FrozenMap *self, bool bReset, Key keyBgn,
+                              Key keyEnd, Pair **ppPair)
+{
+    CHECK_INIT(self);
+
+    FrozenMapData *pData = self->pData;
+    if (bReset) {
+        pData->ulRange_ = _FrozenMapBound(pData, keyBgn, false);
+        pData->keyEnd_ = keyEnd;
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+
+    /* Walk the in-order successors until the exclusive upper boundary. */
+    uint64_t ulSlot = pData->ulRange_;
+    if ((ulSlot == 0) ||
+        (pData->pCompare_(_FrozenMapKey(pData, ulSlot), pData->keyEnd_) >= 0)) {
+        pData->ulRange_ = 0;
+        *ppPair = NULL;
+        return END;
+    }
+
+    *ppPair = _FrozenMapPair(pData, ulSlot);
+    pData->ulRange_ = _FrozenMapNext(pData->ulNum_, ulSlot);
+    return SUCC;
+}
+
+int32_t FrozenMapSetCompare(FrozenMap *self, int32_t (*pFunc) (Key, Key))
+{
+    CHECK_INIT(self);
+    self->pData->pCompare_ = pFunc;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+void _FrozenMapClose(FrozenMapData *pData)
+{
+    if (pData->pBase_)
+        FrozenFileClose(pData->pBase_, pData->ulMap_);
+    pData->pBase_ = NULL;
+    pData->ulMap_ = 0;
+    pData->pKey_ = NULL;
+    pData->pValue_ = NULL;
+    pData->uiKeySize_ = 0;
+    pData->uiValueSize_ = 0;
+    pData->ulKeyStride_ = sizeof(uint64_t);
+    pData->ulValueStride_ = sizeof(uint64_t);
+    pData->ulAhead_ = 1;
+    pData->ulNum_ = 0;
+    pData->ulIter_ = 0;
+    pData->ulRange_ = 0;
+    pData->keyEnd_ = NULL;
+    pData->pair_.key = NULL;
+    pData->pair_.value = NULL;
+    return;
+}
+
+void _FrozenMapLayout(FrozenLayout *pLayout, uint64_t ulSlot)
+{
+    /* The recursion depth is bounded by the tree height. */
+    if (ulSlot > pLayout->ulNum)
+        return;
+
+    _FrozenMapLayout(pLayout, ulSlot << 1);
+
+    Pair *pPair;
+    TreeMapCursorNext(pLayout->pMap, &pLayout->cursor, &pPair);
+    uint8_t *pKey = pLayout->pKey + pLayout->ulKeyStride * ulSlot;
+    if (pLayout->uiKeySize == 0)
+        *(uint64_t*)pKey = (uint64_t)(uintptr_t)pPair->key;
+    else if (pPair->key)
+        memcpy(pKey, pPair->key, pLayout->uiKeySize);
+    uint8_t *pValue = pLayout->pValue + pLayout->ulValueStride * ulSlot;
+    if (pLayout->uiValueSize == 0)
+        *(uint64_t*)pValue = (uint64_t)(uintptr_t)pPair->value;
+    else if (pPair->value)
+        memcpy(pValue, pPair->value, pLayout->uiValueSize);
+
+    _FrozenMapLayout(pLayout, (ulSlot << 1) + 1);
+    return;
+}
+
+Key _FrozenMapKey(FrozenMapData *pData, uint64_t ulSlot)
+{
+    const uint8_t *pKey = pData->pKey_ + pData->ulKeyStride_ * ulSlot;
+    if (pData->uiKeySize_ == 0)
+        return (Key)(uintptr_t)*(const uint64_t*)pKey;
+    return (Key)pKey;
+}
+
+Pair* _FrozenMapPair(FrozenMapData *pData, uint64_t ulSlot)
+{
+    const uint8_t *pValue = pData->pValue_ + pData->ulValueStride_ * ulSlot;
+    pData->pair_.key = (void*)_FrozenMapKey(pData, ulSlot);
+    if (pData->uiValueSize_ == 0)
+        pData->pair_.value = (void*)(uintptr_t)*(const uint64_t*)pValue;
+    else
+        pData->pair_.value = (void*)pValue;
+    return &(pData->pair_);
+}
+
+uint64_t _FrozenMapBound(FrozenMapData *pData, Key key, bool bUpper)
+{
+    /* Descend without branching on the comparison, turning right while the
+       slot key satisfies the bound. */
+    int32_t iLimit = (bUpper)? 1 : 0;
+    uint64_t ulNum = pData->ulNum_;
+    uint64_t ulSlot = 1;
+    while (ulSlot <= ulNum) {
+        __builtin_prefetch(pData->pKey_ +
+                           pData->ulKeyStride_ * ulSlot * pData->ulAhead_);
+        ulSlot = (ulSlot << 1) +
+                 (pData->pCompare_(_FrozenMapKey(pData, ulSlot), key) < iLimit);
+    }
+
+    /* Cancel the right turns made after the last left turn, which leads to the
+       bound, or to 0 if the path never turned left. */
+    ulSlot >>= __builtin_ffsll((long long)~ulSlot);
+    return ulSlot;
+}
+
+uint64_t _FrozenMapSearch(FrozenMapData *pData, Key key)
+{
+    uint64_t ulSlot = _FrozenMapBound(pData, key, false);
+    if ((ulSlot != 0) &&
+        (pData->pCompare_(_FrozenMapKey(pData, ulSlot), key) == 0))
+        return ulSlot;
+    return 0;
+}
+
+uint64_t _FrozenMapFirst(uint64_t ulNum)
+{
+    if (ulNum == 0)
+        return 0;
+    uint64_t ulSlot = 1;
+    while ((ulSlot << 1) <= ulNum)
+        ulSlot <<= 1;
+    return ulSlot;
+}
+
+uint64_t _FrozenMapLast(uint64_t ulNum)
+{
+    if (ulNum == 0)
+        return 0;
+    uint64_t ulSlot = 1;
+    while ((ulSlot << 1) + 1 <= ulNum)
+        ulSlot = (ulSlot << 1) + 1;
+    return ulSlot;
+}
+
+uint64_t _FrozenMapNext(uint64_t ulNum, uint64_t ulSlot)
+{
+    /* Take the leftmost slot of the right subtree, or climb until arriving
+       from a left child. */
+    if ((ulSlot << 1) + 1 <= ulNum) {
+        ulSlot = (ulSlot << 1) + 1;
+        while ((ulSlot << 1) <= ulNum)
+            ulSlot <<= 1;
+        return ulSlot;
+    }
+    while (ulSlot & 1)
+        ulSlot >>= 1;
+    return ulSlot >> 1;
+}
+
+uint64_t _FrozenMapPrev(uint64_t ulNum, uint64_t ulSlot)
+{
+    /* Take the rightmost slot of the left subtree, or climb until arriving
+       from a right child. */
+    if ((ulSlot << 1) <= ulNum) {
+        ulSlot <<= 1;
+        while ((ulSlot << 1) + 1 <= ulNum)
+            ulSlot = (ulSlot << 1) + 1;
+        return ulSlot;
+    }
+    while (!(ulSlot & 1))
+        ulSlot >>= 1;
+    return ulSlot >> 1;
+}
+
+int32_t _FrozenMapCompare(Key keySrc, Key keyTge)
+{
+    if (keySrc == keyTge)
+        return 0;
+    return (keySrc > keyTge)? 1 : (-1);
+}
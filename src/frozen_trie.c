@@ -0,0 +1,684 @@
+#include "container/frozen_trie.h"
+#include "memory/frozen_file.h"
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+#define FROZEN_TRIE_MAGIC   "CDSDART"
+#define FROZEN_TRIE_VERSION (2)
+#define SIZE_CACHE_LINE     (64)
+#define SIZE_ALPHABET       (257)
+#define UNIT_FREE           (-1)
+#define UNIT_LEAF           (-1)
+#define UNIT_ROOT           (-2)
+#define CAP_INIT_UNIT       (1024)
+#define CAP_INIT_STR        (16)
+
+/* The header leads the frozen file, and the unit array follows it at the cache
+   line aligned offset. Unit 0 is the root. */
+typedef struct _FrozenTrieHeader {
+    FrozenFileHead head;
+    uint32_t uiNumStr;
+    uint32_t uiMaxLen;
+    uint64_t ulNumUnit;
+    uint64_t ulUnitOff;
+} FrozenTrieHeader;
+
+/* The base and the check of a node share one unit, so the load validating a
+   transition also brings the base for the next byte. */
+typedef struct _FrozenTrieUnit {
+    int32_t iBase;
+    int32_t iCheck;
+} FrozenTrieUnit;
+
+/* The state growing the double array from the sorted strings. */
+typedef struct _FrozenTrieBuild {
+    char **aStr;
+    FrozenTrieUnit *aUnit;
+    int64_t lCapUnit;
+    int64_t lNumUnit;
+    int64_t lNextCheck;
+    int32_t aCode[SIZE_ALPHABET];
+} FrozenTrieBuild;
+
+/* The growing array of the strings resolved by the prefix query. */
+typedef struct _FrozenTrieResult {
+    char **aStr;
+    int32_t iNum;
+    int32_t iCap;
+} FrozenTrieResult;
+
+struct _FrozenTrieData {
+    uint8_t *pBase_;
+    size_t ulMap_;
+    const FrozenTrieUnit *aUnit_;
+    uint32_t uiNumUnit_;
+    uint32_t uiNumStr_;
+    uint32_t uiMaxLen_;
+};
+
+#define ALIGN_LINE(ulSize)  (((ulSize) + SIZE_CACHE_LINE - 1) &                \
+                             ~((uint64_t)SIZE_CACHE_LINE - 1))
+
+/* The end of a string takes the code 0, and the byte c takes the code c + 1. */
+#define CODE(cByte)         (((cByte) == 0)? 0 : ((int32_t)(uint8_t)(cByte) + 1))
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Unmap the frozen file and reset the trie to the empty one.
+ *
+ * @param pData         The pointer to the trie private data
+ */
+void _FrozenTrieClose(FrozenTrieData *pData);
+
+/**
+ * @brief Collect all the strings of Trie and sort them in the byte order.
+ *
+ * @param pTrie         The pointer to the frozen Trie
+ * @param paStr         The pointer to the returned array of strings
+ * @param piNum         The pointer to the number of strings, which is the
+ *                      size of the trie on entry and the collected one on exit
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory to collect the strings
+ */
+int32_t _FrozenTrieCollectTrie(Trie *pTrie, char ***paStr, int32_t *piNum);
+
+/**
+ * @brief Extend the unit array to cover the designated unit.
+ *
+ * @param pBuild        The pointer to the build state
+ * @param lUnit         The designated unit
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory, or the unit exceeds the range of
+ *                      the 32 bit index
+ */
+int32_t _FrozenTrieReserve(FrozenTrieBuild *pBuild, int64_t lUnit);
+
+/**
+ * @brief Find the base whose units for all the designated codes are free.
+ *
+ * @param pBuild        The pointer to the build state
+ * @param iNum          The number of codes kept by the build state
+ * @param piBase        The pointer to the returned base
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory to extend the unit array
+ */
+int32_t _FrozenTrieFindBase(FrozenTrieBuild *pBuild, int32_t iNum,
+                            int32_t *piBase);
+
+/**
+ * @brief Place the children of the designated node and the subtrees below them.
+ *
+ * @param pBuild        The pointer to the build state
+ * @param iNode         The designated node
+ * @param iBgn          The first string sharing the node
+ * @param iEnd          The string after the last one sharing the node
+ * @param iDepth        The depth of the node
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory to extend the unit array
+ */
+int32_t _FrozenTrieBuild(FrozenTrieBuild *pBuild, int32_t iNode, int32_t iBgn,
+                         int32_t iEnd, int32_t iDepth);
+
+/**
+ * @brief Follow the designated string from the root.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param str           The designated string
+ *
+ * @return              The node reached by the string or -1 for the mismatch
+ */
+int32_t _FrozenTrieWalk(FrozenTrieData *pData, const char *str);
+
+/**
+ * @brief Append the strings below the designated node in the byte order.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param iNode         The designated node
+ * @param szBuf         The buffer holding the path to the node
+ * @param iLen          The length of the path
+ * @param pResult       The pointer to the result array
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory to store the resolved strings
+ */
+int32_t _FrozenTrieCollect(FrozenTrieData *pData, int32_t iNode, char *szBuf,
+                           int32_t iLen, FrozenTrieResult *pResult);
+
+/**
+ * @brief The comparison method for qsort on the string array.
+ */
+int _FrozenTrieCompare(const void *pSrc, const void *pTge);
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t FrozenTrieFreeze(Trie *pTrie, const char *szPath)
+{
+    int32_t iNum = TrieSize(pTrie);
+    if (iNum < 0)
+        return iNum;
+    if (!szPath)
+        return ERR_IDX;
+
+    char **aStr;
+    int32_t iRtn = _FrozenTrieCollectTrie(pTrie, &aStr, &iNum);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    uint32_t uiMaxLen = 0;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        size_t ulLen = strlen(aStr[iIdx]);
+        if (ulLen > uiMaxLen)
+            uiMaxLen = (uint32_t)ulLen;
+    }
+
+    /* Unit 0 is taken by the root, and the search for the free units starts
+       right after it. */
+    FrozenTrieBuild build;
+    build.aStr = aStr;
+    build.aUnit = NULL;
+    build.lCapUnit = 0;
+    build.lNumUnit = 1;
+    build.lNextCheck = 1;
+    iRtn = _FrozenTrieReserve(&build, CAP_INIT_UNIT - 1);
+    if (iRtn != SUCC)
+        goto FREE_STR;
+    build.aUnit[0].iCheck = UNIT_ROOT;
+    iRtn = _FrozenTrieBuild(&build, 0, 0, iNum, 0);
+    if (iRtn != SUCC)
+        goto FREE_UNIT;
+
+    uint64_t ulUnitOff = ALIGN_LINE(sizeof(FrozenTrieHeader));
+    uint64_t ulNumUnit = (uint64_t)build.lNumUnit;
+    uint64_t ulFileSize = ulUnitOff + sizeof(FrozenTrieUnit) * ulNumUnit;
+
+    /* The units are written to a temporary file which replaces the path
+       only after it is complete, so the readers of the old file are kept. */
+    FrozenFile file;
+    iRtn = FrozenFileCreate(&file, szPath, ulFileSize);
+    if (iRtn != SUCC)
+        goto FREE_UNIT;
+    memcpy(file.pBase + ulUnitOff, build.aUnit,
+           sizeof(FrozenTrieUnit) * ulNumUnit);
+
+    FrozenTrieHeader *pHead = (FrozenTrieHeader*)file.pBase;
+    pHead->uiNumStr = (uint32_t)iNum;
+    pHead->uiMaxLen = uiMaxLen;
+    pHead->ulNumUnit = ulNumUnit;
+    pHead->ulUnitOff = ulUnitOff;
+    iRtn = FrozenFileCommit(&file, szPath, FROZEN_TRIE_MAGIC,
+                            FROZEN_TRIE_VERSION);
+
+FREE_UNIT:
+    free(build.aUnit);
+FREE_STR:
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        free(aStr[iIdx]);
+    free(aStr);
+    return iRtn;
+}
+
+int32_t FrozenTrieInit(FrozenTrie **ppObj)
+{
+    *ppObj = (FrozenTrie*)malloc(sizeof(FrozenTrie));
+    if (!(*ppObj))
+        return ERR_NOMEM;
+    FrozenTrie *pObj = *ppObj;
+
+    pObj->pData = (FrozenTrieData*)malloc(sizeof(FrozenTrieData));
+    if (!(pObj->pData)) {
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+
+    pObj->pData->pBase_ = NULL;
+    _FrozenTrieClose(pObj->pData);
+
+    pObj->open = FrozenTrieOpen;
+    pObj->has_exact = FrozenTrieHasExact;
+    pObj->has_prefix_as = FrozenTrieHasPrefixAs;
+    pObj->get_prefix_as = FrozenTrieGetPrefixAs;
+    pObj->size = FrozenTrieSize;
+    pObj->get_stat = FrozenTrieGetStat;
+
+    return SUCC;
+}
+
+void FrozenTrieDeinit(FrozenTrie **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+
+    FrozenTrie *pObj = *ppObj;
+    if (!(pObj->pData))
+        goto FREE_TRIE;
+
+    _FrozenTrieClose(pObj->pData);
+    free(pObj->pData);
+FREE_TRIE:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t FrozenTrieOpen(FrozenTrie *self, const char *szPath)
+{
+    CHECK_INIT(self);
+    if (!szPath)
+        return ERR_IDX;
+
+    FrozenTrieData *pData = self->pData;
+    _FrozenTrieClose(pData);
+
+    uint8_t *pBase;
+    size_t ulMap;
+    int32_t iRtn = FrozenFileOpen(szPath, FROZEN_TRIE_MAGIC,
+                                  FROZEN_TRIE_VERSION, sizeof(FrozenTrieHeader),
+                                  &pBase, &ulMap);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    /* Check that the unit array lies within the file before trusting it. */
+    FrozenTrieHeader *pHead = (FrozenTrieHeader*)pBase;
+    if ((pHead->uiNumStr > INT32_MAX) ||
+        (pHead->ulNumUnit == 0) ||
+        (pHead->ulNumUnit > INT32_MAX) ||
+        (pHead->ulUnitOff < sizeof(FrozenTrieHeader)) ||
+        (pHead->ulUnitOff > ulMap) ||
+        (sizeof(FrozenTrieUnit) * pHead->ulNumUnit > ulMap - pHead->ulUnitOff)) {
+        FrozenFileClose(pBase, ulMap);
+        return ERR_IO;
+    }
+
+    pData->pBase_ = pBase;
+    pData->ulMap_ = ulMap;
+    pData->aUnit_ = (const FrozenTrieUnit*)(pBase + pHead->ulUnitOff);
+    pData->uiNumUnit_ = (uint32_t)pHead->ulNumUnit;
+    pData->uiNumStr_ = pHead->uiNumStr;
+    pData->uiMaxLen_ = pHead->uiMaxLen;
+    return SUCC;
+}
+
+int32_t FrozenTrieHasExact(FrozenTrie *self, char *str)
+{
+    CHECK_INIT(self);
+    if (!str)
+        return NOKEY;
+    if (*str == 0)
+        return NOKEY;
+
+    FrozenTrieData *pData = self->pData;
+    int32_t iNode = _FrozenTrieWalk(pData, str);
+    if (iNode < 0)
+        return NOKEY;
+
+    /* The terminal unit takes the code 0 of the node. */
+    uint32_t uiTerm = (uint32_t)pData->aUnit_[iNode].iBase;
+    if ((uiTerm >= pData->uiNumUnit_) ||
+        (pData->aUnit_[uiTerm].iCheck != iNode))
+        return NOKEY;
+    return SUCC;
+}
+
+int32_t FrozenTrieHasPrefixAs(FrozenTrie *self, char *str)
+{
+    CHECK_INIT(self);
+    if (!str)
+        return NOKEY;
+    if (*str == 0)
+        return NOKEY;
+
+    /* Every node leads to at least one stored string. */
+    return (_FrozenTrieWalk(self->pData, str) >= 0)? SUCC : NOKEY;
+}
+
+int32_t FrozenTrieGetPrefixAs(FrozenTrie *self, char *str, char ***paStr,
+                              int *piNum)
+{
+    CHECK_INIT(self);
+    if (!paStr || !piNum)
+        return ERR_GET;
+
+    *paStr = NULL;
+    *piNum = 0;
+    if (!str)
+        return NOKEY;
+    if (*str == 0)
+        return NOKEY;
+
+    FrozenTrieData *pData = self->pData;
+    int32_t iNode = _FrozenTrieWalk(pData, str);
+    int32_t iLen = strlen(str);
+    if ((iNode < 0) || ((uint32_t)iLen > pData->uiMaxLen_))
+        return NOKEY;
+
+    /* The walk consumed the whole prefix, so it is not longer than the longest
+       stored string, which bounds the buffer. */
+    int32_t iRtn;
+    char *szBuf = (char*)malloc(sizeof(char) * (pData->uiMaxLen_ + 1));
+    if (!szBuf)
+        return ERR_NOMEM;
+    memcpy(szBuf, str, iLen);
+
+    FrozenTrieResult result;
+    result.aStr = NULL;
+    result.iNum = 0;
+    result.iCap = 0;
+    iRtn = _FrozenTrieCollect(pData, iNode, szBuf, iLen, &result);
+    free(szBuf);
+    if (iRtn != SUCC) {
+        int32_t iIdx;
+        for (iIdx = 0 ; iIdx < result.iNum ; iIdx++)
+            free(result.aStr[iIdx]);
+        free(result.aStr);
+        return iRtn;
+    }
+
+    *paStr = result.aStr;
+    *piNum = result.iNum;
+    return SUCC;
+}
+
+int32_t FrozenTrieSize(FrozenTrie *self)
+{
+    CHECK_INIT(self);
+    return (int32_t)self->pData->uiNumStr_;
+}
+
+int32_t FrozenTrieGetStat(FrozenTrie *self, TrieStat *pStat)
+{
+    CHECK_INIT(self);
+    if (!pStat)
+        return ERR_GET;
+
+    pStat->lCountNode = self->pData->uiNumUnit_;
+    pStat->lCountByte = self->pData->ulMap_;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+void _FrozenTrieClose(FrozenTrieData *pData)
+{
+    if (pData->pBase_)
+        FrozenFileClose(pData->pBase_, pData->ulMap_);
+    pData->pBase_ = NULL;
+    pData->ulMap_ = 0;
+    pData->aUnit_ = NULL;
+    pData->uiNumUnit_ = 0;
+    pData->uiNumStr_ = 0;
+    pData->uiMaxLen_ = 0;
+    return;
+}
+
+int32_t _FrozenTrieCollectTrie(Trie *pTrie, char ***paStr, int32_t *piNum)
+{
+    int32_t iCap = *piNum + 1;
+    char **aStr = (char**)malloc(sizeof(char*) * iCap);
+    if (!aStr)
+        return ERR_NOMEM;
+
+    /* Trie rejects the empty prefix, so the strings are drawn by their first
+       bytes, which works for both node layouts. */
+    int32_t iRtn = SUCC;
+    int32_t iSize = 0;
+    int32_t iByte, iIdx;
+    for (iByte = 1 ; iByte < 256 ; iByte++) {
+        char szPrefix[2];
+        szPrefix[0] = (char)iByte;
+        szPrefix[1] = 0;
+
+        char **aPart;
+        int iPart;
+        iRtn = TrieGetPrefixAs(pTrie, szPrefix, &aPart, &iPart);
+        if (iRtn == NOKEY)
+            continue;
+        if (iRtn != SUCC)
+            goto FREE_STR;
+
+        if (iSize + iPart > iCap) {
+            char **aNew = (char**)realloc(aStr, sizeof(char*) * (iSize + iPart));
+            if (!aNew) {
+                for (iIdx = 0 ; iIdx < iPart ; iIdx++)
+                    free(aPart[iIdx]);
+                free(aPart);
+                iRtn = ERR_NOMEM;
+                goto FREE_STR;
+            }
+            aStr = aNew;
+            iCap = iSize + iPart;
+        }
+        memcpy(aStr + iSize, aPart, sizeof(char*) * iPart);
+        iSize += iPart;
+        free(aPart);
+    }
+
+    /* The ternary nodes compare the plain chars, whose signedness depends on
+       the platform, so the strings are sorted again in the byte order. */
+    qsort(aStr, iSize, sizeof(char*), _FrozenTrieCompare);
+    *paStr = aStr;
+    *piNum = iSize;
+    return SUCC;
+
+FREE_STR:
+    for (iIdx = 0 ; iIdx < iSize ; iIdx++)
+        free(aStr[iIdx]);
+    free(aStr);
+    return iRtn;
+}
+
+int32_t _FrozenTrieReserve(FrozenTrieBuild *pBuild, int64_t lUnit)
+{
+    if (lUnit < pBuild->lCapUnit)
+        return SUCC;
+    if (lUnit >= INT32_MAX)
+        return ERR_NOMEM;
+
+    int64_t lCap = (pBuild->lCapUnit > 0)? pBuild->lCapUnit : CAP_INIT_UNIT;
+    while (lCap <= lUnit)
+        lCap <<= 1;
+    if (lCap > INT32_MAX)
+        lCap = INT32_MAX;
+
+    FrozenTrieUnit *aUnit = (FrozenTrieUnit*)realloc(pBuild->aUnit,
+                             sizeof(FrozenTrieUnit) * lCap);
+    if (!aUnit)
+        return ERR_NOMEM;
+
+    int64_t lIdx;
+    for (lIdx = pBuild->lCapUnit ; lIdx < lCap ; lIdx++) {
+        aUnit[lIdx].iBase = 0;
+        aUnit[lIdx].iCheck = UNIT_FREE;
+    }
+    pBuild->aUnit = aUnit;
+    pBuild->lCapUnit = lCap;
+    return SUCC;
+}
+
+int32_t _FrozenTrieFindBase(FrozenTrieBuild *pBuild, int32_t iNum,
+                            int32_t *piBase)
+{
+    const int32_t *aCode = pBuild->aCode;
+    int64_t lPos = (aCode[0] + 1 > pBuild->lNextCheck)?
+                   aCode[0] + 1 : pBuild->lNextCheck;
+    int64_t lUsed = 0;
+    bool bFirst = true;
+
+    /* Anchor the smallest code at each free unit, and accept the base once
+       the units for the other codes are free too. */
+    for (lPos-- ; ; ) {
+        lPos++;
+        int32_t iRtn = _FrozenTrieReserve(pBuild, lPos + SIZE_ALPHABET);
+        if (iRtn != SUCC)
+            return iRtn;
+        if (pBuild->aUnit[lPos].iCheck != UNIT_FREE) {
+            lUsed++;
+            continue;
+        }
+        if (bFirst) {
+            pBuild->lNextCheck = lPos;
+            bFirst = false;
+        }
+
+        int64_t lBase = lPos - aCode[0];
+        int32_t iIdx;
+        for (iIdx = 1 ; iIdx < iNum ; iIdx++) {
+            if (pBuild->aUnit[lBase + aCode[iIdx]].iCheck != UNIT_FREE)
+                break;
+        }
+        if (iIdx == iNum) {
+            *piBase = (int32_t)lBase;
+            break;
+        }
+    }
+
+    /* Skip the densely packed head of the array in the later searches. */
+    if (lUsed * 20 >= (lPos - pBuild->lNextCheck + 1) * 19)
+        pBuild->lNextCheck = lPos;
+    return SUCC;
+}
+
+int32_t _FrozenTrieBuild(FrozenTrieBuild *pBuild, int32_t iNode, int32_t iBgn,
+                         int32_t iEnd, int32_t iDepth)
+{
+    /* The strings are sorted, so the children appear as the runs of the same
+       code. The code array is reused by the deeper calls once the children
+       are placed. */
+    int32_t iNum = 0;
+    int32_t iIdx;
+    for (iIdx = iBgn ; iIdx < iEnd ; iIdx++) {
+        int32_t iCode = CODE(pBuild->aStr[iIdx][iDepth]);
+        if ((iNum == 0) || (pBuild->aCode[iNum - 1] != iCode))
+            pBuild->aCode[iNum++] = iCode;
+    }
+    if (iNum == 0) {
+        pBuild->aUnit[iNode].iBase = UNIT_LEAF;
+        return SUCC;
+    }
+
+    int32_t iBase;
+    int32_t iRtn = _FrozenTrieFindBase(pBuild, iNum, &iBase);
+    if (iRtn != SUCC)
+        return iRtn;
+    pBuild->aUnit[iNode].iBase = iBase;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        int64_t lChild = (int64_t)iBase + pBuild->aCode[iIdx];
+        pBuild->aUnit[lChild].iCheck = iNode;
+        if (lChild >= pBuild->lNumUnit)
+            pBuild->lNumUnit = lChild + 1;
+    }
+
+    iIdx = iBgn;
+    while (iIdx < iEnd) {
+        int32_t iCode = CODE(pBuild->aStr[iIdx][iDepth]);
+        int32_t iNext = iIdx + 1;
+        while ((iNext < iEnd) &&
+               (CODE(pBuild->aStr[iNext][iDepth]) == iCode))
+            iNext++;
+
+        if (iCode == 0)
+            pBuild->aUnit[iBase].iBase = UNIT_LEAF;
+        else {
+            iRtn = _FrozenTrieBuild(pBuild, iBase + iCode, iIdx, iNext,
+                                    iDepth + 1);
+            if (iRtn != SUCC)
+                return iRtn;
+        }
+        iIdx = iNext;
+    }
+    return SUCC;
+}
+
+int32_t _FrozenTrieWalk(FrozenTrieData *pData, const char *str)
+{
+    const FrozenTrieUnit *aUnit = pData->aUnit_;
+    uint32_t uiNumUnit = pData->uiNumUnit_;
+    if (uiNumUnit == 0)
+        return -1;
+
+    /* The unsigned comparison also rejects the negative base of the leaf. */
+    int32_t iNode = 0;
+    while (*str) {
+        uint32_t uiNext = (uint32_t)(aUnit[iNode].iBase + CODE(*str));
+        if ((uiNext >= uiNumUnit) || (aUnit[uiNext].iCheck != iNode))
+            return -1;
+        iNode = (int32_t)uiNext;
+        str++;
+    }
+    return iNode;
+}
+
+int32_t _FrozenTrieCollect(FrozenTrieData *pData, int32_t iNode, char *szBuf,
+                           int32_t iLen, FrozenTrieResult *pResult)
+{
+    const FrozenTrieUnit *aUnit = pData->aUnit_;
+    int32_t iBase = aUnit[iNode].iBase;
+    if (iBase < 0)
+        return SUCC;
+
+    int32_t iCode;
+    for (iCode = 0 ; iCode < SIZE_ALPHABET ; iCode++) {
+        uint32_t uiChild = (uint32_t)iBase + iCode;
+        if (uiChild >= pData->uiNumUnit_)
+            break;
+        if (aUnit[uiChild].iCheck != iNode)
+            continue;
+
+        if (iCode > 0) {
+            /* The guard keeps a corrupted file from overrunning the buffer. */
+            if ((uint32_t)iLen >= pData->uiMaxLen_)
+                continue;
+            szBuf[iLen] = (char)(iCode - 1);
+            int32_t iRtn = _FrozenTrieCollect(pData, (int32_t)uiChild, szBuf,
+                                              iLen + 1, pResult);
+            if (iRtn != SUCC)
+                return iRtn;
+            continue;
+        }
+
+        if (pResult->iNum == pResult->iCap) {
+            int32_t iCap = (pResult->iCap > 0)?
+                           (pResult->iCap << 1) : CAP_INIT_STR;
+            char **aStr = (char**)realloc(pResult->aStr, sizeof(char*) * iCap);
+            if (!aStr)
+                return ERR_NOMEM;
+            pResult->aStr = aStr;
+            pResult->iCap = iCap;
+        }
+        char *szStr = (char*)malloc(sizeof(char) * (iLen + 1));
+        if (!szStr)
+            return ERR_NOMEM;
+        memcpy(szStr, szBuf, iLen);
+        szStr[iLen] = 0;
+        pResult->aStr[pResult->iNum++] = szStr;
+    }
+    return SUCC;
+}
+
+int _FrozenTrieCompare(const void *pSrc, const void *pTge)
+{
+    return strcmp(*(char* const*)pSrc, *(char* const*)pTge);
+}
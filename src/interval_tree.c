@@ -0,0 +1,358 @@
+#include "container/interval_tree.h"
+#include "tree_map_internal.h"
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+/* The tree node comes first so that the shared core can link the interval
+   nodes. The maximum covers the upper endpoints of the whole subtree. */
+typedef struct _IntervalNode {
+    TreeNode node;
+    Interval interval;
+    int64_t lMax;
+} IntervalNode;
+
+struct _IntervalTreeData {
+    TreeMapData tree_;
+    void (*pDestroy_) (Interval*);
+};
+
+#define INTERVAL(pNode)  ((IntervalNode*)(pNode))
+
+/* The sentinel carries the minimal maximum so that the augmentation needs no
+   special case for the leaves. It is never written. */
+static IntervalNode _IntervalTreeNull = {
+    {COLOR_BLACK, false, 0, 0, NULL, &(_IntervalTreeNull.node),
+     &(_IntervalTreeNull.node), &(_IntervalTreeNull.node), {NULL, NULL}},
+    {0, 0, NULL}, INT64_MIN};
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Traverse all the tree nodes and clean the allocated resource.
+ *
+ * @param pData         The pointer to the tree private data
+ * @param pCurr         The pointer to the root of the designated subtree
+ */
+void _IntervalTreeDeinit(IntervalTreeData *pData, TreeNode *pCurr);
+
+/**
+ * @brief Recompute the maximum upper endpoint of the designated node from its
+ * interval and its children.
+ *
+ * @param pNode         The pointer to the designated node
+ */
+void _IntervalTreeAugment(TreeNode *pNode);
+
+/**
+ * @brief The total order of the intervals, which compares the lower endpoints,
+ * the upper endpoints, and the values in turn.
+ *
+ * @param pSrc          The pointer to the source interval
+ * @param pTge          The pointer to the target interval
+ *
+ * @retval 1            The source interval should go after the target one
+ * @retval 0            The source interval is equal to the target one
+ * @retval -1           The source interval should go before the target one
+ */
+int32_t _IntervalTreeCompare(Interval *pSrc, Interval *pTge);
+
+/**
+ * @brief Get the node storing the designated interval.
+ *
+ * @param pData         The pointer to the tree private data
+ * @param pInterval     The pointer to the designated interval
+ *
+ * @return              The pointer to the node or the dummy node
+ */
+TreeNode* _IntervalTreeSearch(IntervalTreeData *pData, Interval *pInterval);
+
+/**
+ * @brief Visit the intervals overlapping the designated range in the subtree
+ * rooted by the designated node.
+ *
+ * @param pData         The pointer to the tree private data
+ * @param pCurr         The pointer to the root of the designated subtree
+ * @param lLow          The inclusive lower endpoint of the range
+ * @param lHigh         The inclusive upper endpoint of the range
+ * @param pVisit        The visitor for the reported intervals
+ * @param pArg          The argument passed to the visitor
+ * @param pCount        The pointer to the number of visited intervals
+ *
+ * @retval CONTINUE     The query goes on
+ * @retval END          The visitor stopped the query
+ */
+int32_t _IntervalTreeOverlap(IntervalTreeData *pData, TreeNode *pCurr,
+                             int64_t lLow, int64_t lHigh,
+                             IntervalTreeVisit pVisit, void *pArg,
+                             int32_t *pCount);
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t IntervalTreeInit(IntervalTree **ppObj)
+{
+    *ppObj = (IntervalTree*)malloc(sizeof(IntervalTree));
+    if (!(*ppObj))
+        return ERR_NOMEM;
+    IntervalTree *pObj = *ppObj;
+
+    pObj->pData = (IntervalTreeData*)malloc(sizeof(IntervalTreeData));
+    if (!(pObj->pData)) {
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+    IntervalTreeData *pData = pObj->pData;
+
+    /* Only the fields used by the shared core are meaningful. */
+    TreeMapData *pTree = &(pData->tree_);
+    memset(pTree, 0, sizeof(TreeMapData));
+    pTree->pNull_ = &(_IntervalTreeNull.node);
+    pTree->pRoot_ = pTree->pNull_;
+    pTree->pIter_ = pTree->pNull_;
+    pTree->pRange_ = pTree->pNull_;
+    pTree->pAugment_ = _IntervalTreeAugment;
+    pData->pDestroy_ = NULL;
+
+    pObj->put = IntervalTreePut;
+    pObj->find = IntervalTreeFind;
+    pObj->remove = IntervalTreeRemove;
+    pObj->size = IntervalTreeSize;
+    pObj->stab = IntervalTreeStab;
+    pObj->overlap = IntervalTreeOverlap;
+    pObj->set_destroy = IntervalTreeSetDestroy;
+
+    return SUCC;
+}
+
+void IntervalTreeDeinit(IntervalTree **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+
+    IntervalTree *pObj = *ppObj;
+    if (!(pObj->pData))
+        goto FREE_TREE;
+
+    _IntervalTreeDeinit(pObj->pData, pObj->pData->tree_.pRoot_);
+    free(pObj->pData);
+FREE_TREE:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t IntervalTreePut(IntervalTree *self, Interval *pInterval)
+{
+    CHECK_INIT(self);
+    if (!pInterval || (pInterval->lLow > pInterval->lHigh))
+        return ERR_IDX;
+
+    TreeMapData *pTree = &(self->pData->tree_);
+    TreeNode *pNull = pTree->pNull_;
+    TreeNode *pParent = pNull;
+    TreeNode *pCurr = pTree->pRoot_;
+    int32_t iOrder = 0;
+    while (pCurr != pNull) {
+        iOrder = _IntervalTreeCompare(pInterval, &(INTERVAL(pCurr)->interval));
+        if (iOrder == 0)
+            return SUCC;
+        pParent = pCurr;
+        pCurr = (iOrder > 0)? pCurr->pRight : pCurr->pLeft;
+    }
+
+    IntervalNode *pNew = (IntervalNode*)malloc(sizeof(IntervalNode));
+    if (!pNew)
+        return ERR_NOMEM;
+    pNew->node.bColor = COLOR_RED;
+    pNew->node.bBlock = false;
+    pNew->node.iCount = 1;
+    pNew->node.iRef = 1;
+    pNew->node.pPair = NULL;
+    pNew->node.pParent = pParent;
+    pNew->node.pLeft = pNull;
+    pNew->node.pRight = pNull;
+    pNew->interval = *pInterval;
+    pNew->lMax = pInterval->lHigh;
+
+    if (pParent == pNull)
+        pTree->pRoot_ = &(pNew->node);
+    else if (iOrder > 0)
+        pParent->pRight = &(pNew->node);
+    else
+        pParent->pLeft = &(pNew->node);
+
+    /* Raise the maxima along the path until one already covers the interval.
+       The rotations of the fixup then keep the maxima by themselves. */
+    while ((pParent != pNull) && (INTERVAL(pParent)->lMax < pNew->lMax)) {
+        INTERVAL(pParent)->lMax = pNew->lMax;
+        pParent = pParent->pParent;
+    }
+    pTree->iSize_++;
+    _TreeMapInsertFixup(pTree, &(pNew->node));
+
+    return SUCC;
+}
+
+int32_t IntervalTreeFind(IntervalTree *self, Interval *pInterval)
+{
+    CHECK_INIT(self);
+    if (!pInterval)
+        return ERR_IDX;
+
+    TreeNode *pFind = _IntervalTreeSearch(self->pData, pInterval);
+    return (pFind != self->pData->tree_.pNull_)? SUCC : NOKEY;
+}
+
+int32_t IntervalTreeRemove(IntervalTree *self, Interval *pInterval)
+{
+    CHECK_INIT(self);
+    if (!pInterval)
+        return ERR_IDX;
+
+    IntervalTreeData *pData = self->pData;
+    TreeNode *pFind = _IntervalTreeSearch(pData, pInterval);
+    if (pFind == pData->tree_.pNull_)
+        return ERR_NODATA;
+
+    /* The core lowers the maxima above the spliced position. */
+    _TreeMapUnlink(&(pData->tree_), pFind);
+    pData->tree_.iSize_--;
+    if (pData->pDestroy_)
+        pData->pDestroy_(&(INTERVAL(pFind)->interval));
+    free(pFind);
+    return SUCC;
+}
+
+int32_t IntervalTreeSize(IntervalTree *self)
+{
+    CHECK_INIT(self);
+    return self->pData->tree_.iSize_;
+}
+
+int32_t IntervalTreeStab(IntervalTree *self, int64_t lPoint,
+                         IntervalTreeVisit pVisit, void *pArg)
+{
+    return IntervalTreeOverlap(self, lPoint, lPoint, pVisit, pArg);
+}
+
+int32_t IntervalTreeOverlap(IntervalTree *self, int64_t lLow, int64_t lHigh,
+                            IntervalTreeVisit pVisit, void *pArg)
+{
+    CHECK_INIT(self);
+    if (lLow > lHigh)
+        return ERR_IDX;
+    if (!pVisit)
+        return ERR_GET;
+
+    int32_t iCount = 0;
+    IntervalTreeData *pData = self->pData;
+    _IntervalTreeOverlap(pData, pData->tree_.pRoot_, lLow, lHigh, pVisit, pArg,
+                         &iCount);
+    return iCount;
+}
+
+int32_t IntervalTreeSetDestroy(IntervalTree *self, void (*pFunc) (Interval*))
+{
+    CHECK_INIT(self);
+    self->pData->pDestroy_ = pFunc;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+void _IntervalTreeDeinit(IntervalTreeData *pData, TreeNode *pCurr)
+{
+    /* The recursion depth is bounded by the tree height. */
+    if (pCurr == pData->tree_.pNull_)
+        return;
+    _IntervalTreeDeinit(pData, pCurr->pLeft);
+    _IntervalTreeDeinit(pData, pCurr->pRight);
+    if (pData->pDestroy_)
+        pData->pDestroy_(&(INTERVAL(pCurr)->interval));
+    free(pCurr);
+    return;
+}
+
+void _IntervalTreeAugment(TreeNode *pNode)
+{
+    int64_t lMax = INTERVAL(pNode)->interval.lHigh;
+    int64_t lLeft = INTERVAL(pNode->pLeft)->lMax;
+    int64_t lRight = INTERVAL(pNode->pRight)->lMax;
+    if (lLeft > lMax)
+        lMax = lLeft;
+    if (lRight > lMax)
+        lMax = lRight;
+    INTERVAL(pNode)->lMax = lMax;
+    return;
+}
+
+int32_t _IntervalTreeCompare(Interval *pSrc, Interval *pTge)
+{
+    if (pSrc->lLow != pTge->lLow)
+        return (pSrc->lLow > pTge->lLow)? 1 : (-1);
+    if (pSrc->lHigh != pTge->lHigh)
+        return (pSrc->lHigh > pTge->lHigh)? 1 : (-1);
+    if (pSrc->value == pTge->value)
+        return 0;
+    return (pSrc->value > pTge->value)? 1 : (-1);
+}
+
+TreeNode* _IntervalTreeSearch(IntervalTreeData *pData, Interval *pInterval)
+{
+    TreeNode *pNull = pData->tree_.pNull_;
+    TreeNode *pCurr = pData->tree_.pRoot_;
+    while (pCurr != pNull) {
+        int32_t iOrder = _IntervalTreeCompare(pInterval,
+                                              &(INTERVAL(pCurr)->interval));
+        if (iOrder == 0)
+            break;
+        pCurr = (iOrder > 0)? pCurr->pRight : pCurr->pLeft;
+    }
+    return pCurr;
+}
+
+int32_t _IntervalTreeOverlap(IntervalTreeData *pData, TreeNode *pCurr,
+                             int64_t lLow, int64_t lHigh,
+                             IntervalTreeVisit pVisit, void *pArg,
+                             int32_t *pCount)
+{
+    /* Skip the subtree ending before the range. The recursion depth is
+       bounded by the tree height. */
+    if ((pCurr == pData->tree_.pNull_) || (INTERVAL(pCurr)->lMax < lLow))
+        return CONTINUE;
+
+    if (_IntervalTreeOverlap(pData, pCurr->pLeft, lLow, lHigh, pVisit, pArg,
+                             pCount) == END)
+        return END;
+
+    /* The current node and its right subtree start after the range. */
+    Interval *pInterval = &(INTERVAL(pCurr)->interval);
+    if (pInterval->lLow > lHigh)
+        return CONTINUE;
+
+    if (pInterval->lHigh >= lLow) {
+        (*pCount)++;
+        if (pVisit(pInterval, pArg) == END)
+            return END;
+    }
+
+    return _IntervalTreeOverlap(pData, pCurr->pRight, lLow, lHigh, pVisit, pArg,
+                                pCount);
+}
@@ -8,6 +8,7 @@ struct _PriorityQueueData {
     int32_t iSize_;
     int32_t iCapacity_;
     Item *aItem_;
+    Storage store_;
     int32_t (*pCompare_) (Item, Item);
     void (*pDestroy_) (Item);
 };
@@ -61,14 +62,15 @@ int32_t PriorityQueueInit(PriorityQueue **ppObj)
     }
     PriorityQueueData *pData = pObj->pData;
 
-    pData->aItem_ = (Item*)malloc(sizeof(Item) * DEFAULT_CAPACITY);
-    if (!(pData->aItem_)) {
+    StorageInit(&pData->store_, STORAGE_HEAP, NULL);
+    if (StorageResize(&pData->store_, sizeof(Item) * DEFAULT_CAPACITY) != SUCC) {
         free(pObj->pData);
         free(*ppObj);
         *ppObj = NULL;
         return ERR_NOMEM;
     }
     pData->iSize_ = 0;
+    pData->aItem_ = (Item*)pData->store_.pBase;
     pData->iCapacity_ = DEFAULT_CAPACITY;
     pData->pCompare_ = _PriorityQueueItemComp;
     pData->pDestroy_ = NULL;
@@ -79,6 +81,7 @@ int32_t PriorityQueueInit(PriorityQueue **ppObj)
     pObj->size = PriorityQueueSize;
     pObj->set_compare = PriorityQueueSetCompare;
     pObj->set_destroy = PriorityQueueSetDestroy;
+    pObj->set_storage = PriorityQueueSetStorage;
 
     return SUCC;
 }
@@ -105,7 +108,7 @@ void PriorityQueueDeinit(PriorityQueue **ppObj)
         pData->pDestroy_(aItem[iIdx]);
 
 FREE_ARRAY:
-    free(pData->aItem_);
+    StorageDeinit(&pData->store_);
 FREE_DATA:
     free(pObj->pData);
 FREE_QUEUE:
@@ -123,11 +126,11 @@ int32_t PriorityQueuePush(PriorityQueue *self, Item item)
     Item *aItem = pData->aItem_;
     if (pData->iSize_ == pData->iCapacity_) {
         int32_t iCapaNew = pData->iCapacity_ << 1;
-        Item *aItemNew = (Item*)realloc(aItem, iCapaNew * sizeof(Item));
-        if (!aItemNew)
-            return ERR_NOMEM;
-        aItem = pData->aItem_ = aItemNew;
-        pData->iCapacity_ = iCapaNew;
+        int32_t iRtn = StorageResize(&pData->store_, iCapaNew * sizeof(Item));
+        if (iRtn != SUCC)
+            return iRtn;
+        aItem = pData->aItem_ = (Item*)pData->store_.pBase;
+        pData->iCapacity_ = pData->store_.ulSize / sizeof(Item);
     }
 
     /* Push the item to the bottom of the heap. */
@@ -228,6 +231,20 @@ int32_t PriorityQueueSetDestroy(PriorityQueue *self, void (*pFunc) (Item))
     return SUCC;
 }
 
+int32_t PriorityQueueSetStorage(PriorityQueue *self, int32_t iMode,
+                                const char *szPath)
+{
+    CHECK_INIT(self);
+    PriorityQueueData *pData = self->pData;
+    int32_t iRtn = StorageSwitch(&pData->store_, iMode, szPath);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    pData->aItem_ = (Item*)pData->store_.pBase;
+    pData->iCapacity_ = pData->store_.ulSize / sizeof(Item);
+    return SUCC;
+}
+
 
 /*===========================================================================*
  *               Implementation for internal operations                      *
@@ -10,6 +10,7 @@ struct _QueueData {
     int32_t iSize_;
     int32_t iCapacity_;
     Item *aItem_;
+    Storage store_;
     void (*pDestroy_) (Item);
 };
 
@@ -44,8 +45,8 @@ int32_t QueueInit(Queue **ppObj)
     }
     QueueData *pData = pObj->pData;
 
-    pData->aItem_ = (Item*)malloc(sizeof(Item) * DEFAULT_CAPACITY);
-    if (!(pData->aItem_)) {
+    StorageInit(&pData->store_, STORAGE_HEAP, NULL);
+    if (StorageResize(&pData->store_, sizeof(Item) * DEFAULT_CAPACITY) != SUCC) {
         free(pObj->pData);
         free(*ppObj);
         *ppObj = NULL;
@@ -54,6 +55,7 @@ int32_t QueueInit(Queue **ppObj)
     pData->iFront_ = 0;
     pData->iBack_ = 0;
     pData->iSize_ = 0;
+    pData->aItem_ = (Item*)pData->store_.pBase;
     pData->iCapacity_ = DEFAULT_CAPACITY;
     pData->pDestroy_ = NULL;
 
@@ -63,6 +65,7 @@ int32_t QueueInit(Queue **ppObj)
     pObj->back = QueueBack;
     pObj->size = QueueSize;
     pObj->set_destroy = QueueSetDestroy;
+    pObj->set_storage = QueueSetStorage;
 
     return SUCC;
 }
@@ -96,7 +99,7 @@ void QueueDeinit(Queue **ppObj)
     }
 
 FREE_ARRAY:
-    free(pData->aItem_);
+    StorageDeinit(&pData->store_);
 FREE_DATA:
     free(pObj->pData);
 FREE_QUEUE:
@@ -113,11 +116,11 @@ int32_t QueuePush(Queue *self, Item item)
     /* If the array is full, extend it to double capacity. */
     if (pData->iSize_ == pData->iCapacity_) {
         int32_t iCapaNew = pData->iCapacity_ << 1;
-        Item *aItemNew = (Item*)realloc(pData->aItem_, iCapaNew * sizeof(Item));
-        if (!aItemNew)
-            return ERR_NOMEM;
-        pData->aItem_ = aItemNew;
-        pData->iCapacity_ = iCapaNew;
+        int32_t iRtn = StorageResize(&pData->store_, iCapaNew * sizeof(Item));
+        if (iRtn != SUCC)
+            return iRtn;
+        pData->aItem_ = (Item*)pData->store_.pBase;
+        pData->iCapacity_ = pData->store_.ulSize / sizeof(Item);
 
         /* If back index is smaller than front index, we should migrate the
            circularly pushed items to the newly allocated space. */
@@ -202,4 +205,30 @@ int32_t QueueSetDestroy(Queue *self, void (*pFunc) (Item))
     CHECK_INIT(self);
     self->pData->pDestroy_ = pFunc;
     return SUCC;
-}
\ No newline at end of file
+}
+
+int32_t QueueSetStorage(Queue *self, int32_t iMode, const char *szPath)
+{
+    CHECK_INIT(self);
+    QueueData *pData = self->pData;
+    int32_t iRtn = StorageSwitch(&pData->store_, iMode, szPath);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    int32_t iCapaOld = pData->iCapacity_;
+    pData->aItem_ = (Item*)pData->store_.pBase;
+    pData->iCapacity_ = pData->store_.ulSize / sizeof(Item);
+
+    /* The new storage may be larger due to the page alignment. If the items are
+       circularly pushed, we should migrate the items near the old array end to
+       the new array end. */
+    int32_t iCapaDiff = pData->iCapacity_ - iCapaOld;
+    if ((iCapaDiff > 0) && (pData->iSize_ > 0) &&
+        (pData->iBack_ <= pData->iFront_)) {
+        memmove(pData->aItem_ + pData->iFront_ + iCapaDiff,
+                pData->aItem_ + pData->iFront_,
+                sizeof(Item) * (iCapaOld - pData->iFront_));
+        pData->iFront_ += iCapaDiff;
+    }
+    return SUCC;
+}
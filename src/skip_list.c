@@ -0,0 +1,753 @@
+#include "container/skip_list.h"
+#include "memory/epoch.h"
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+/* The links of a node are tagged in the lowest bit once the node is deleted,
+   so that no writer can link a new node behind it. The epoch link comes first
+   so that the reclaimed links can be cast back to the nodes. */
+typedef struct _SkipNode {
+    EpochNode link;
+    Key key;
+    Pair *pPair;
+    Pair *pDead;
+    int32_t iHeight;
+    int32_t iOwner;
+    uintptr_t aNext[];
+} SkipNode;
+
+/* The pair counters are spread over the epoch slots of the writers. */
+typedef struct _SkipCounter {
+    int64_t lCount;
+    int64_t aPad[7];
+} SkipCounter;
+
+struct _SkipListData {
+    SkipNode *pHead_;
+    SkipCounter *aCount_;
+    int32_t iLevel_;
+    Epoch epoch_;
+    int32_t (*pCompare_) (Key, Key);
+    void (*pDestroy_) (Pair*);
+};
+
+#define SKIP_LIST_MAX_LEVEL     (16)
+#define SKIP_LIST_RECLAIM_MASK  (31)
+#define SIZE_CACHE_LINE         (64)
+
+#define MARK(pNode)             ((uintptr_t)(pNode) | 1)
+#define IS_MARKED(uLink)        ((uLink) & 1)
+#define NODE(uLink)             ((SkipNode*)((uLink) & ~(uintptr_t)1))
+
+/* The random generator and the retirement counter of each thread. */
+static __thread uint64_t _ulSkipListSeed;
+static __thread uint32_t _uiSkipListRetire;
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief The default function for key comparison.
+ *
+ * @param keySrc        The source key
+ * @param keyTge        The target key
+ *
+ * @retval 1            The source key should go after the target one.
+ * @retval 0            The source key is equal to the target one.
+ * @retval -1           The source key should go before the target one.
+ */
+int32_t _SkipListCompare(Key keySrc, Key keyTge);
+
+/**
+ * @brief Allocate a node with the designated number of levels.
+ *
+ * @param iHeight       The number of levels
+ *
+ * @return              The pointer to the node or NULL for insufficient memory
+ */
+SkipNode* _SkipListNewNode(int32_t iHeight);
+
+/**
+ * @brief Draw the number of levels for a new node, which grows by one with
+ * the probability of one fourth.
+ *
+ * @return              The number of levels
+ */
+int32_t _SkipListHeight();
+
+/**
+ * @brief Locate the predecessor and the successor of the given key at each
+ * level, and unlink the deleted nodes on the way.
+ *
+ * @param pData         The pointer to the list private data
+ * @param key           The designated key
+ * @param iTop          The highest level to locate
+ * @param aPred         The array of the returned predecessors
+ * @param aSucc         The array of the returned successors
+ *
+ * @retval true         The successor at the lowest level holds the key
+ * @retval false        Otherwise
+ */
+bool _SkipListLocate(SkipListData *pData, Key key, int32_t iTop,
+                     SkipNode **aPred, SkipNode **aSucc);
+
+/**
+ * @brief Return the first node at the lowest level whose key is not ordered
+ * before the given key without modifying the list.
+ *
+ * @param pData         The pointer to the list private data
+ * @param key           The designated key
+ *
+ * @return              The pointer to the node or NULL if there is none
+ */
+SkipNode* _SkipListSeek(SkipListData *pData, Key key);
+
+/**
+ * @brief Mark all the links of the deleted node from the highest level.
+ *
+ * @param pNode         The pointer to the deleted node
+ */
+void _SkipListMark(SkipNode *pNode);
+
+/**
+ * @brief Unlink the marked node from every level it may still be linked to.
+ *
+ * A node of the same key can be linked in front of the deleted one, so the
+ * walk passes all the nodes holding the key instead of stopping at the first
+ * one as the locating does.
+ *
+ * @param pData         The pointer to the list private data
+ * @param pNode         The pointer to the marked node
+ * @param iTop          The highest level to walk
+ */
+void _SkipListUnlink(SkipListData *pData, SkipNode *pNode, int32_t iTop);
+
+/**
+ * @brief Drop the reference of the inserting or the deleting thread, and
+ * retire the node when both of them have finished with it.
+ *
+ * @param pData         The pointer to the list private data
+ * @param pNode         The pointer to the node
+ */
+void _SkipListDrop(SkipListData *pData, SkipNode *pNode);
+
+/**
+ * @brief Retire the node, and occasionally reclaim the nodes which no thread
+ * can reach.
+ *
+ * @param pData         The pointer to the list private data
+ * @param pNode         The pointer to the unlinked node
+ */
+void _SkipListRetire(SkipListData *pData, SkipNode *pNode);
+
+/**
+ * @brief Release the list of the nodes detached from the epoch domain.
+ *
+ * @param pData         The pointer to the list private data
+ * @param pLink         The pointer to the first detached link
+ */
+void _SkipListRelease(SkipListData *pData, EpochNode *pLink);
+
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData->pHead_))                                     \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t SkipListInit(SkipList **ppObj)
+{
+    *ppObj = (SkipList*)malloc(sizeof(SkipList));
+    if (!(*ppObj))
+        goto EXIT;
+    SkipList *pObj = *ppObj;
+
+    pObj->pData = (SkipListData*)malloc(sizeof(SkipListData));
+    if (!(pObj->pData))
+        goto FREE_LIST;
+    SkipListData *pData = pObj->pData;
+
+    pData->pHead_ = _SkipListNewNode(SKIP_LIST_MAX_LEVEL);
+    if (!(pData->pHead_))
+        goto FREE_DATA;
+    memset(pData->pHead_->aNext, 0, sizeof(uintptr_t) * SKIP_LIST_MAX_LEVEL);
+
+    void *pCount;
+    if (posix_memalign(&pCount, SIZE_CACHE_LINE,
+                       sizeof(SkipCounter) * EPOCH_NUM_SLOT) != 0)
+        goto FREE_HEAD;
+    pData->aCount_ = (SkipCounter*)pCount;
+    memset(pData->aCount_, 0, sizeof(SkipCounter) * EPOCH_NUM_SLOT);
+
+    if (EpochInit(&(pData->epoch_)) != SUCC)
+        goto FREE_COUNT;
+
+    pData->iLevel_ = 0;
+    pData->pCompare_ = _SkipListCompare;
+    pData->pDestroy_ = NULL;
+
+    pObj->put = SkipListPut;
+    pObj->get = SkipListGet;
+    pObj->find = SkipListFind;
+    pObj->remove = SkipListRemove;
+    pObj->size = SkipListSize;
+    pObj->iter_open = SkipListIterOpen;
+    pObj->iter_range = SkipListIterRange;
+    pObj->iter_next = SkipListIterNext;
+    pObj->iter_close = SkipListIterClose;
+    pObj->set_compare = SkipListSetCompare;
+    pObj->set_destroy = SkipListSetDestroy;
+    return SUCC;
+
+FREE_COUNT:
+    free(pData->aCount_);
+FREE_HEAD:
+    free(pData->pHead_);
+FREE_DATA:
+    free(pObj->pData);
+FREE_LIST:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return ERR_NOMEM;
+}
+
+void SkipListDeinit(SkipList **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+
+    SkipList *pObj = *ppObj;
+    if (!(pObj->pData))
+        goto FREE_LIST;
+
+    SkipListData *pData = pObj->pData;
+    if (!(pData->pHead_))
+        goto FREE_DATA;
+
+    /* All the deleted nodes are unlinked when no thread is active, so the
+       lowest level holds exactly the live ones. */
+    _SkipListRelease(pData, EpochFlush(&(pData->epoch_)));
+    SkipNode *pCurr = NODE(pData->pHead_->aNext[0]);
+    while (pCurr) {
+        SkipNode *pNext = NODE(pCurr->aNext[0]);
+        if (pData->pDestroy_)
+            pData->pDestroy_(pCurr->pPair);
+        free(pCurr);
+        pCurr = pNext;
+    }
+
+    EpochDeinit(&(pData->epoch_));
+    free(pData->aCount_);
+    free(pData->pHead_);
+
+FREE_DATA:
+    free(pObj->pData);
+FREE_LIST:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t SkipListPut(SkipList *self, Pair *pPair)
+{
+    CHECK_INIT(self);
+
+    SkipListData *pData = self->pData;
+    SkipNode *aPred[SKIP_LIST_MAX_LEVEL];
+    SkipNode *aSucc[SKIP_LIST_MAX_LEVEL];
+    SkipNode *pNew = NULL;
+    SkipNode *pRecord = NULL;
+    int32_t iRtn = SUCC;
+    int32_t iHeight = _SkipListHeight();
+    int32_t iLvl;
+
+    uint32_t uiTicket = EpochEnter(&(pData->epoch_));
+    while (true) {
+        int32_t iTop = __atomic_load_n(&(pData->iLevel_), __ATOMIC_RELAXED);
+        if (iTop < iHeight - 1)
+            iTop = iHeight - 1;
+
+        /* Replace the pair of the live node holding the same key. */
+        if (_SkipListLocate(pData, pPair->key, iTop, aPred, aSucc)) {
+            SkipNode *pCurr = aSucc[0];
+            Pair *pOld = __atomic_load_n(&(pCurr->pPair), __ATOMIC_ACQUIRE);
+            if (!pOld) {
+                /* Help the deleting thread so that the node gets unlinked. */
+                _SkipListMark(pCurr);
+                continue;
+            }
+            if (pOld == pPair)
+                goto EXIT;
+            if (!pRecord) {
+                pRecord = _SkipListNewNode(0);
+                if (!pRecord) {
+                    iRtn = ERR_NOMEM;
+                    goto EXIT;
+                }
+            }
+            if (!__atomic_compare_exchange_n(&(pCurr->pPair), &pOld, pPair,
+                                             false, __ATOMIC_ACQ_REL,
+                                             __ATOMIC_ACQUIRE))
+                continue;
+            pRecord->pDead = pOld;
+            _SkipListRetire(pData, pRecord);
+            pRecord = NULL;
+            goto EXIT;
+        }
+
+        if (!pNew) {
+            pNew = _SkipListNewNode(iHeight);
+            if (!pNew) {
+                iRtn = ERR_NOMEM;
+                goto EXIT;
+            }
+            pNew->key = pPair->key;
+            pNew->pPair = pPair;
+            pNew->iOwner = 2;
+        }
+        for (iLvl = 0 ; iLvl < iHeight ; iLvl++)
+            pNew->aNext[iLvl] = (uintptr_t)aSucc[iLvl];
+
+        /* The pair becomes visible once the lowest level is linked. */
+        uintptr_t uSucc = (uintptr_t)aSucc[0];
+        if (__atomic_compare_exchange_n(&(aPred[0]->aNext[0]), &uSucc,
+                                        (uintptr_t)pNew, false, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED))
+            break;
+    }
+
+    __atomic_fetch_add(&(pData->aCount_[EPOCH_TICKET_SLOT(uiTicket)].lCount), 1,
+                       __ATOMIC_RELAXED);
+    int32_t iTop = __atomic_load_n(&(pData->iLevel_), __ATOMIC_RELAXED);
+    while (iTop < iHeight - 1 &&
+           !__atomic_compare_exchange_n(&(pData->iLevel_), &iTop, iHeight - 1,
+                                        true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED));
+
+    /* Link the higher levels. Stop once the node is deleted concurrently,
+       since the deleting thread marks the links before unlinking them. */
+    for (iLvl = 1 ; iLvl < iHeight ; iLvl++) {
+        while (true) {
+            uintptr_t uNext = __atomic_load_n(&(pNew->aNext[iLvl]),
+                                              __ATOMIC_ACQUIRE);
+            if (IS_MARKED(uNext))
+                goto LINKED;
+            if (NODE(uNext) != aSucc[iLvl] &&
+                !__atomic_compare_exchange_n(&(pNew->aNext[iLvl]), &uNext,
+                                             (uintptr_t)aSucc[iLvl], false,
+                                             __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+                goto LINKED;
+
+            uintptr_t uSucc = (uintptr_t)aSucc[iLvl];
+            if (__atomic_compare_exchange_n(&(aPred[iLvl]->aNext[iLvl]), &uSucc,
+                                            (uintptr_t)pNew, false,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+                break;
+
+            _SkipListLocate(pData, pNew->key, iHeight - 1, aPred, aSucc);
+            if (aSucc[0] != pNew)
+                goto LINKED;
+        }
+    }
+
+LINKED:
+    /* A level linked after the deleting thread unlinked the node has to be
+       unlinked again before the node can be retired. */
+    if (!__atomic_load_n(&(pNew->pPair), __ATOMIC_ACQUIRE)) {
+        _SkipListMark(pNew);
+        _SkipListUnlink(pData, pNew, iHeight - 1);
+    }
+    _SkipListDrop(pData, pNew);
+    pNew = NULL;
+
+EXIT:
+    EpochExit(&(pData->epoch_), uiTicket);
+    free(pNew);
+    free(pRecord);
+    return iRtn;
+}
+
+int32_t SkipListGet(SkipList *self, Key key, Value *pValue)
+{
+    CHECK_INIT(self);
+    if (!pValue)
+        return ERR_GET;
+
+    SkipListData *pData = self->pData;
+    uint32_t uiTicket = EpochEnter(&(pData->epoch_));
+    SkipNode *pCurr = _SkipListSeek(pData, key);
+    Pair *pPair = NULL;
+    if (pCurr && pData->pCompare_(pCurr->key, key) == 0)
+        pPair = __atomic_load_n(&(pCurr->pPair), __ATOMIC_ACQUIRE);
+    *pValue = (pPair)? pPair->value : NULL;
+    EpochExit(&(pData->epoch_), uiTicket);
+
+    return (pPair)? SUCC : ERR_NODATA;
+}
+
+int32_t SkipListFind(SkipList *self, Key key)
+{
+    CHECK_INIT(self);
+
+    SkipListData *pData = self->pData;
+    uint32_t uiTicket = EpochEnter(&(pData->epoch_));
+    SkipNode *pCurr = _SkipListSeek(pData, key);
+    Pair *pPair = NULL;
+    if (pCurr && pData->pCompare_(pCurr->key, key) == 0)
+        pPair = __atomic_load_n(&(pCurr->pPair), __ATOMIC_ACQUIRE);
+    EpochExit(&(pData->epoch_), uiTicket);
+
+    return (pPair)? SUCC : NOKEY;
+}
+
+int32_t SkipListRemove(SkipList *self, Key key)
+{
+    CHECK_INIT(self);
+
+    SkipListData *pData = self->pData;
+    SkipNode *aPred[SKIP_LIST_MAX_LEVEL];
+    SkipNode *aSucc[SKIP_LIST_MAX_LEVEL];
+    SkipNode *pCurr;
+    Pair *pOld;
+    int32_t iRtn = SUCC;
+
+    /* The deletion takes effect when the pair is detached from the node. */
+    uint32_t uiTicket = EpochEnter(&(pData->epoch_));
+    while (true) {
+        int32_t iTop = __atomic_load_n(&(pData->iLevel_), __ATOMIC_RELAXED);
+        if (!_SkipListLocate(pData, key, iTop, aPred, aSucc)) {
+            iRtn = ERR_NODATA;
+            goto EXIT;
+        }
+        pCurr = aSucc[0];
+        pOld = __atomic_load_n(&(pCurr->pPair), __ATOMIC_ACQUIRE);
+        if (!pOld) {
+            iRtn = ERR_NODATA;
+            goto EXIT;
+        }
+        if (__atomic_compare_exchange_n(&(pCurr->pPair), &pOld, NULL, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            break;
+    }
+
+    pCurr->pDead = pOld;
+    __atomic_fetch_sub(&(pData->aCount_[EPOCH_TICKET_SLOT(uiTicket)].lCount), 1,
+                       __ATOMIC_RELAXED);
+
+    int32_t iTop = __atomic_load_n(&(pData->iLevel_), __ATOMIC_RELAXED);
+    if (iTop < pCurr->iHeight - 1)
+        iTop = pCurr->iHeight - 1;
+    _SkipListMark(pCurr);
+    _SkipListUnlink(pData, pCurr, iTop);
+    _SkipListDrop(pData, pCurr);
+
+EXIT:
+    EpochExit(&(pData->epoch_), uiTicket);
+    return iRtn;
+}
+
+int32_t SkipListSize(SkipList *self)
+{
+    CHECK_INIT(self);
+
+    int64_t lSize = 0;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < EPOCH_NUM_SLOT ; iIdx++)
+        lSize += __atomic_load_n(&(self->pData->aCount_[iIdx].lCount),
+                                 __ATOMIC_RELAXED);
+    return (lSize > 0)? (int32_t)lSize : 0;
+}
+
+int32_t SkipListIterOpen(SkipList *self, SkipListIter *pIter)
+{
+    CHECK_INIT(self);
+    if (!pIter)
+        return ERR_GET;
+
+    SkipListData *pData = self->pData;
+    pIter->uiTicket = EpochEnter(&(pData->epoch_));
+    pIter->bOpen = true;
+    pIter->bBound = false;
+    pIter->keyEnd = NULL;
+    pIter->pNode = NODE(__atomic_load_n(&(pData->pHead_->aNext[0]),
+                                        __ATOMIC_ACQUIRE));
+    return SUCC;
+}
+
+int32_t SkipListIterRange(SkipList *self, SkipListIter *pIter, Key keyBgn,
+                          Key keyEnd)
+{
+    CHECK_INIT(self);
+    if (!pIter)
+        return ERR_GET;
+
+    SkipListData *pData = self->pData;
+    pIter->uiTicket = EpochEnter(&(pData->epoch_));
+    pIter->bOpen = true;
+    pIter->bBound = true;
+    pIter->keyEnd = keyEnd;
+    pIter->pNode = _SkipListSeek(pData, keyBgn);
+    return SUCC;
+}
+
+int32_t SkipListIterNext(SkipList *self, SkipListIter *pIter, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!pIter || !(pIter->bOpen) || !ppPair)
+        return ERR_GET;
+
+    /* The links of a deleted node still lead to the later keys. */
+    SkipListData *pData = self->pData;
+    while (pIter->pNode) {
+        SkipNode *pCurr = (SkipNode*)pIter->pNode;
+        uintptr_t uNext = __atomic_load_n(&(pCurr->aNext[0]), __ATOMIC_ACQUIRE);
+        pIter->pNode = NODE(uNext);
+        if (IS_MARKED(uNext))
+            continue;
+        if (pIter->bBound && pData->pCompare_(pCurr->key, pIter->keyEnd) >= 0) {
+            pIter->pNode = NULL;
+            break;
+        }
+        Pair *pPair = __atomic_load_n(&(pCurr->pPair), __ATOMIC_ACQUIRE);
+        if (!pPair)
+            continue;
+        *ppPair = pPair;
+        return CONTINUE;
+    }
+
+    *ppPair = NULL;
+    return END;
+}
+
+int32_t SkipListIterClose(SkipList *self, SkipListIter *pIter)
+{
+    CHECK_INIT(self);
+    if (!pIter || !(pIter->bOpen))
+        return ERR_GET;
+
+    pIter->bOpen = false;
+    pIter->pNode = NULL;
+    EpochExit(&(self->pData->epoch_), pIter->uiTicket);
+    return SUCC;
+}
+
+int32_t SkipListSetCompare(SkipList *self, int32_t (*pFunc) (Key, Key))
+{
+    CHECK_INIT(self);
+    self->pData->pCompare_ = pFunc;
+    return SUCC;
+}
+
+int32_t SkipListSetDestroy(SkipList *self, void (*pFunc) (Pair*))
+{
+    CHECK_INIT(self);
+    self->pData->pDestroy_ = pFunc;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+int32_t _SkipListCompare(Key keySrc, Key keyTge)
+{
+    if (keySrc == keyTge)
+        return 0;
+    return (keySrc > keyTge)? 1 : (-1);
+}
+
+SkipNode* _SkipListNewNode(int32_t iHeight)
+{
+    SkipNode *pNode = (SkipNode*)malloc(sizeof(SkipNode) +
+                                        sizeof(uintptr_t) * iHeight);
+    if (!pNode)
+        return NULL;
+
+    pNode->link.pNext = NULL;
+    pNode->key = NULL;
+    pNode->pPair = NULL;
+    pNode->pDead = NULL;
+    pNode->iHeight = iHeight;
+    pNode->iOwner = 1;
+    return pNode;
+}
+
+int32_t _SkipListHeight()
+{
+    /* Seed the xorshift64 generator with the thread specific address. */
+    uint64_t ulState = _ulSkipListSeed;
+    if (ulState == 0)
+        ulState = ((uint64_t)(uintptr_t)&_ulSkipListSeed) | 1;
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 7;
+    ulState ^= ulState << 17;
+    _ulSkipListSeed = ulState;
+
+    int32_t iHeight = 1;
+    while ((ulState & 3) == 0 && iHeight < SKIP_LIST_MAX_LEVEL) {
+        iHeight++;
+        ulState >>= 2;
+    }
+    return iHeight;
+}
+
+bool _SkipListLocate(SkipListData *pData, Key key, int32_t iTop,
+                     SkipNode **aPred, SkipNode **aSucc)
+{
+    int32_t (*pCompare) (Key, Key) = pData->pCompare_;
+    SkipNode *pPred, *pCurr;
+    int32_t iLvl;
+
+RETRY:
+    pPred = pData->pHead_;
+    for (iLvl = SKIP_LIST_MAX_LEVEL - 1 ; iLvl > iTop ; iLvl--) {
+        aPred[iLvl] = pPred;
+        aSucc[iLvl] = NULL;
+    }
+    for (iLvl = iTop ; iLvl >= 0 ; iLvl--) {
+        pCurr = NODE(__atomic_load_n(&(pPred->aNext[iLvl]), __ATOMIC_ACQUIRE));
+        while (pCurr) {
+            uintptr_t uNext = __atomic_load_n(&(pCurr->aNext[iLvl]),
+                                              __ATOMIC_ACQUIRE);
+            if (IS_MARKED(uNext)) {
+                /* Unlink the deleted node. If the predecessor is deleted as
+                   well, restart from the head. */
+                uintptr_t uCurr = (uintptr_t)pCurr;
+                if (!__atomic_compare_exchange_n(&(pPred->aNext[iLvl]), &uCurr,
+                                                 uNext & ~(uintptr_t)1, false,
+                                                 __ATOMIC_RELEASE,
+                                                 __ATOMIC_RELAXED))
+                    goto RETRY;
+                pCurr = NODE(uNext);
+                continue;
+            }
+            if (pCompare(pCurr->key, key) >= 0)
+                break;
+            pPred = pCurr;
+            pCurr = NODE(uNext);
+        }
+        aPred[iLvl] = pPred;
+        aSucc[iLvl] = pCurr;
+    }
+
+    pCurr = aSucc[0];
+    return pCurr && pCompare(pCurr->key, key) == 0;
+}
+
+SkipNode* _SkipListSeek(SkipListData *pData, Key key)
+{
+    int32_t (*pCompare) (Key, Key) = pData->pCompare_;
+    SkipNode *pPred = pData->pHead_;
+    SkipNode *pCurr = NULL;
+    int32_t iLvl = __atomic_load_n(&(pData->iLevel_), __ATOMIC_RELAXED);
+
+    /* Step over the deleted nodes without unlinking them. */
+    for ( ; iLvl >= 0 ; iLvl--) {
+        pCurr = NODE(__atomic_load_n(&(pPred->aNext[iLvl]), __ATOMIC_ACQUIRE));
+        while (pCurr) {
+            uintptr_t uNext = __atomic_load_n(&(pCurr->aNext[iLvl]),
+                                              __ATOMIC_ACQUIRE);
+            if (!IS_MARKED(uNext)) {
+                if (pCompare(pCurr->key, key) >= 0)
+                    break;
+                pPred = pCurr;
+            }
+            pCurr = NODE(uNext);
+        }
+    }
+    return pCurr;
+}
+
+void _SkipListMark(SkipNode *pNode)
+{
+    int32_t iLvl;
+    for (iLvl = pNode->iHeight - 1 ; iLvl >= 0 ; iLvl--) {
+        uintptr_t uNext = __atomic_load_n(&(pNode->aNext[iLvl]),
+                                          __ATOMIC_ACQUIRE);
+        while (!IS_MARKED(uNext) &&
+               !__atomic_compare_exchange_n(&(pNode->aNext[iLvl]), &uNext,
+                                            MARK(uNext), false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+    }
+    return;
+}
+
+void _SkipListUnlink(SkipListData *pData, SkipNode *pNode, int32_t iTop)
+{
+    int32_t (*pCompare) (Key, Key) = pData->pCompare_;
+    Key key = pNode->key;
+    SkipNode *pBase, *pPred, *pCurr;
+    int32_t iLvl;
+
+RETRY:
+    /* Descend from the last node ordered before the key, and walk through
+       the run of the same key at each level. */
+    pBase = pData->pHead_;
+    for (iLvl = iTop ; iLvl >= 0 ; iLvl--) {
+        pPred = pBase;
+        pCurr = NODE(__atomic_load_n(&(pPred->aNext[iLvl]), __ATOMIC_ACQUIRE));
+        while (pCurr) {
+            uintptr_t uNext = __atomic_load_n(&(pCurr->aNext[iLvl]),
+                                              __ATOMIC_ACQUIRE);
+            if (IS_MARKED(uNext)) {
+                uintptr_t uCurr = (uintptr_t)pCurr;
+                if (!__atomic_compare_exchange_n(&(pPred->aNext[iLvl]), &uCurr,
+                                                 uNext & ~(uintptr_t)1, false,
+                                                 __ATOMIC_RELEASE,
+                                                 __ATOMIC_RELAXED))
+                    goto RETRY;
+                pCurr = NODE(uNext);
+                continue;
+            }
+            int32_t iOrder = pCompare(pCurr->key, key);
+            if (iOrder > 0)
+                break;
+            if (iOrder < 0)
+                pBase = pCurr;
+            pPred = pCurr;
+            pCurr = NODE(uNext);
+        }
+    }
+    return;
+}
+
+void _SkipListDrop(SkipListData *pData, SkipNode *pNode)
+{
+    if (__atomic_sub_fetch(&(pNode->iOwner), 1, __ATOMIC_ACQ_REL) == 0)
+        _SkipListRetire(pData, pNode);
+    return;
+}
+
+void _SkipListRetire(SkipListData *pData, SkipNode *pNode)
+{
+    EpochRetire(&(pData->epoch_), &(pNode->link));
+    if ((++_uiSkipListRetire & SKIP_LIST_RECLAIM_MASK) == 0)
+        _SkipListRelease(pData, EpochReclaim(&(pData->epoch_)));
+    return;
+}
+
+void _SkipListRelease(SkipListData *pData, EpochNode *pLink)
+{
+    while (pLink) {
+        EpochNode *pNext = pLink->pNext;
+        SkipNode *pNode = (SkipNode*)pLink;
+        if (pNode->pDead && pData->pDestroy_)
+            pData->pDestroy_(pNode->pDead);
+        free(pNode);
+        pLink = pNext;
+    }
+    return;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file sort_internal.h The merge sort and the binary search bound shared by
+ * the array based containers.
+ */
+
+#ifndef _SORT_INTERNAL_H_
+#define _SORT_INTERNAL_H_
+
+#include "util.h"
+
+
+/* The length of the runs sorted by insertion sort before the merging. */
+#define SORT_RUN_SIZE       (32)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SORT_PREFETCH(pAddr)    __builtin_prefetch(pAddr)
+#else
+#define SORT_PREFETCH(pAddr)
+#endif
+
+
+/*===========================================================================*
+ *                  Definition for the shared operations                     *
+ *===========================================================================*/
+/**
+ * @brief Define the function which stably sorts an array of the designated
+ * element type.
+ *
+ * The defined function applies insertion sort to the short runs and then
+ * merges the runs bottom-up with the auxiliary buffer. The sorted elements are
+ * always left in the original array. Its signature is
+ * void NAME(TYPE *aElem, TYPE *aTmp, int64_t iSize, FUNC pCompare).
+ *
+ * @param NAME          The function name
+ * @param TYPE          The element type
+ * @param FUNC          The type of the comparison method
+ * @param ORDER         The macro ORDER(pCompare, pSrc, pTge) which compares the
+ *                      two elements referred by the pointers
+ */
+#define SORT_DEFINE_MERGE(NAME, TYPE, FUNC, ORDER)                              \
+void NAME(TYPE *aElem, TYPE *aTmp, int64_t iSize, FUNC pCompare)                \
+{                                                                               \
+    /* Sort the short runs with insertion sort. */                              \
+    int64_t iLow;                                                               \
+    for (iLow = 0 ; iLow < iSize ; iLow += SORT_RUN_SIZE) {                     \
+        int64_t iHigh = iLow + SORT_RUN_SIZE;                                   \
+        if (iHigh > iSize)                                                      \
+            iHigh = iSize;                                                      \
+        int64_t iIdx;                                                           \
+        for (iIdx = iLow + 1 ; iIdx < iHigh ; iIdx++) {                         \
+            TYPE elem = aElem[iIdx];                                            \
+            int64_t iPos = iIdx;                                                \
+            while ((iPos > iLow) &&                                             \
+                   (ORDER(pCompare, &aElem[iPos - 1], &elem) > 0)) {            \
+                aElem[iPos] = aElem[iPos - 1];                                  \
+                iPos--;                                                         \
+            }                                                                   \
+            aElem[iPos] = elem;                                                 \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    /* Merge the runs bottom-up and switch between the two buffers. */          \
+    TYPE *aSrc = aElem, *aDst = aTmp;                                           \
+    int64_t iWidth;                                                             \
+    for (iWidth = SORT_RUN_SIZE ; iWidth < iSize ; iWidth <<= 1) {              \
+        for (iLow = 0 ; iLow < iSize ; iLow += iWidth << 1) {                   \
+            int64_t iMid = iLow + iWidth;                                       \
+            int64_t iHigh = iMid + iWidth;                                      \
+            if (iMid > iSize)                                                   \
+                iMid = iSize;                                                   \
+            if (iHigh > iSize)                                                  \
+                iHigh = iSize;                                                  \
+                                                                                \
+            int64_t iFst = iLow, iSnd = iMid, iOut = iLow;                      \
+            while ((iFst < iMid) && (iSnd < iHigh)) {                           \
+                if (ORDER(pCompare, &aSrc[iSnd], &aSrc[iFst]) < 0)              \
+                    aDst[iOut++] = aSrc[iSnd++];                                \
+                else                                                            \
+                    aDst[iOut++] = aSrc[iFst++];                                \
+            }                                                                   \
+            if (iFst < iMid)                                                    \
+                memcpy(aDst + iOut, aSrc + iFst,                                \
+                       sizeof(TYPE) * (iMid - iFst));                           \
+            if (iSnd < iHigh)                                                   \
+                memcpy(aDst + iOut, aSrc + iSnd,                                \
+                       sizeof(TYPE) * (iHigh - iSnd));                          \
+        }                                                                       \
+        TYPE *aSwap = aSrc;                                                     \
+        aSrc = aDst;                                                            \
+        aDst = aSwap;                                                           \
+    }                                                                           \
+                                                                                \
+    if (aSrc != aElem)                                                          \
+        memcpy(aElem, aSrc, sizeof(TYPE) * iSize);                              \
+    return;                                                                     \
+}
+
+/**
+ * @brief Define the function which returns the index of the first element not
+ * ordered before the designated probe, or ordered after the probe for the
+ * upper bound.
+ *
+ * The range is halved without the data dependent branch so that the probe is
+ * selected with a conditional move. Its signature is
+ * int64_t NAME(const TYPE *aElem, int64_t iSize, PROBE probe, FUNC pCompare,
+ * bool bUpper).
+ *
+ * @param NAME          The function name
+ * @param TYPE          The element type
+ * @param PROBE         The probe type
+ * @param FUNC          The type of the comparison method
+ * @param ORDER         The macro ORDER(pCompare, pElem, probe) which compares
+ *                      the element referred by the pointer with the probe
+ */
+#define SORT_DEFINE_BOUND(NAME, TYPE, PROBE, FUNC, ORDER)                       \
+int64_t NAME(const TYPE *aElem, int64_t iSize, PROBE probe, FUNC pCompare,      \
+             bool bUpper)                                                       \
+{                                                                               \
+    if (iSize == 0)                                                             \
+        return 0;                                                               \
+                                                                                \
+    /* The lower bound moves past the elements ordered before the probe, and    \
+       the upper bound also moves past the equivalent ones. */                  \
+    int32_t iLimit = (bUpper)? 1 : 0;                                           \
+    const TYPE *aBase = aElem;                                                  \
+    while (iSize > 1) {                                                         \
+        int64_t iHalf = iSize >> 1;                                             \
+        /* Prefetch both the candidates for the next probe. */                  \
+        SORT_PREFETCH(aBase + (iHalf >> 1));                                    \
+        SORT_PREFETCH(aBase + iHalf + (iHalf >> 1));                            \
+        aBase = (ORDER(pCompare, &aBase[iHalf], probe) < iLimit)?               \
+                aBase + iHalf : aBase;                                          \
+        iSize -= iHalf;                                                         \
+    }                                                                           \
+    return (aBase - aElem) + (ORDER(pCompare, aBase, probe) < iLimit);          \
+}
+
+#endif
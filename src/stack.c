@@ -8,6 +8,7 @@ struct _StackData {
     int32_t iSize_;
     int32_t iCapacity_;
     Item *aItem_;
+    Storage store_;
     void (*pDestroy_) (Item);
 };
 
@@ -42,14 +43,15 @@ int32_t StackInit(Stack **ppObj)
     }
     StackData *pData = pObj->pData;
 
-    pData->aItem_ = (Item*)malloc(sizeof(Item) * DEFAULT_CAPACITY);
-    if (!(pData->aItem_)) {
+    StorageInit(&pData->store_, STORAGE_HEAP, NULL);
+    if (StorageResize(&pData->store_, sizeof(Item) * DEFAULT_CAPACITY) != SUCC) {
         free(pObj->pData);
         free(*ppObj);
         *ppObj = NULL;
         return ERR_NOMEM;
     }
     pData->iSize_ = 0;
+    pData->aItem_ = (Item*)pData->store_.pBase;
     pData->iCapacity_ = DEFAULT_CAPACITY;
     pData->pDestroy_ = NULL;
 
@@ -58,6 +60,7 @@ int32_t StackInit(Stack **ppObj)
     pObj->top = StackTop;
     pObj->size = StackSize;
     pObj->set_destroy = StackSetDestroy;
+    pObj->set_storage = StackSetStorage;
 
     return SUCC;
 }
@@ -85,7 +88,7 @@ void StackDeinit(Stack **ppObj)
     }
 
 FREE_ARRAY:
-    free(pData->aItem_);
+    StorageDeinit(&pData->store_);
 FREE_DATA:
     free(pObj->pData);
 FREE_QUEUE:
@@ -102,11 +105,11 @@ int32_t StackPush(Stack *self, Item item)
     /* If the array is full, extend it to double capacity. */
     if (pData->iSize_ == pData->iCapacity_) {
         int32_t iCapaNew = pData->iCapacity_ << 1;
-        Item *aItemNew = (Item*)realloc(pData->aItem_, iCapaNew * sizeof(Item));
-        if (!aItemNew)
-            return ERR_NOMEM;
-        pData->aItem_ = aItemNew;
-        pData->iCapacity_ = iCapaNew;
+        int32_t iRtn = StorageResize(&pData->store_, iCapaNew * sizeof(Item));
+        if (iRtn != SUCC)
+            return iRtn;
+        pData->aItem_ = (Item*)pData->store_.pBase;
+        pData->iCapacity_ = pData->store_.ulSize / sizeof(Item);
     }
 
     /* Insert the item to the tail of the array. */
@@ -158,3 +161,16 @@ int32_t StackSetDestroy(Stack *self, void (*pFunc) (Item))
     self->pData->pDestroy_ = pFunc;
     return SUCC;
 }
+
+int32_t StackSetStorage(Stack *self, int32_t iMode, const char *szPath)
+{
+    CHECK_INIT(self);
+    StackData *pData = self->pData;
+    int32_t iRtn = StorageSwitch(&pData->store_, iMode, szPath);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    pData->aItem_ = (Item*)pData->store_.pBase;
+    pData->iCapacity_ = pData->store_.ulSize / sizeof(Item);
+    return SUCC;
+}
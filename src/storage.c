@@ -0,0 +1,267 @@
+#define _GNU_SOURCE
+#include "memory/storage.h"
+#include <unistd.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+
+#define MAP_THRESHOLD       (1 << 26)
+#define HUGE_PAGE_SIZE      (1 << 21)
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+#ifdef __linux__
+/**
+ * @brief Round the size up to the mapping granularity of the storage.
+ *
+ * @param pStore        The pointer to the Storage structure
+ * @param ulSize        The designated size in bytes
+ *
+ * @return              The rounded size or 0 for overflow
+ */
+size_t _StorageRound(Storage *pStore, size_t ulSize);
+
+/**
+ * @brief Reserve the anonymous mapping aligned to the huge page size.
+ *
+ * @param ulSize        The designated size in bytes
+ *
+ * @return              The aligned base address or MAP_FAILED
+ */
+void* _StorageReserveAligned(size_t ulSize);
+
+/**
+ * @brief Resize the storage which is mapped from the system.
+ *
+ * @param pStore        The pointer to the Storage structure
+ * @param ulSize        The designated size in bytes
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for storage extension
+ * @retval ERR_IO       Fail to resize the backing file
+ */
+int32_t _StorageRemap(Storage *pStore, size_t ulSize);
+#endif
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t StorageInit(Storage *pStore, int32_t iMode, const char *szPath)
+{
+    pStore->pBase = NULL;
+    pStore->ulSize = 0;
+    pStore->iMode = STORAGE_HEAP;
+    pStore->iFd = -1;
+    pStore->bMapped = false;
+
+    if (iMode == STORAGE_HEAP)
+        return SUCC;
+
+#ifdef __linux__
+    if (iMode == STORAGE_HUGE_PAGE) {
+        pStore->iMode = iMode;
+        return SUCC;
+    }
+
+    if ((iMode == STORAGE_FILE) && szPath) {
+        int32_t iFd = open(szPath, O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (iFd < 0)
+            return ERR_IO;
+        unlink(szPath);
+        pStore->iMode = iMode;
+        pStore->iFd = iFd;
+        return SUCC;
+    }
+#endif
+
+    return ERR_POLICY;
+}
+
+void StorageDeinit(Storage *pStore)
+{
+#ifdef __linux__
+    if (pStore->bMapped)
+        munmap(pStore->pBase, pStore->ulSize);
+    else
+        free(pStore->pBase);
+    if (pStore->iFd >= 0)
+        close(pStore->iFd);
+#else
+    free(pStore->pBase);
+#endif
+
+    pStore->pBase = NULL;
+    pStore->ulSize = 0;
+    pStore->iFd = -1;
+    pStore->bMapped = false;
+    return;
+}
+
+int32_t StorageResize(Storage *pStore, size_t ulSize)
+{
+#ifdef __linux__
+    if (pStore->bMapped || (pStore->iMode != STORAGE_HEAP) ||
+        (ulSize >= MAP_THRESHOLD))
+        return _StorageRemap(pStore, ulSize);
+#endif
+
+    if (ulSize == 0) {
+        free(pStore->pBase);
+        pStore->pBase = NULL;
+        pStore->ulSize = 0;
+        return SUCC;
+    }
+
+    void *pBase = realloc(pStore->pBase, ulSize);
+    if (!pBase)
+        return ERR_NOMEM;
+    pStore->pBase = pBase;
+    pStore->ulSize = ulSize;
+    return SUCC;
+}
+
+int32_t StorageSwitch(Storage *pStore, int32_t iMode, const char *szPath)
+{
+    Storage store;
+    int32_t iRtn = StorageInit(&store, iMode, szPath);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    iRtn = StorageResize(&store, pStore->ulSize);
+    if (iRtn != SUCC) {
+        StorageDeinit(&store);
+        return iRtn;
+    }
+
+    if (pStore->ulSize > 0)
+        memcpy(store.pBase, pStore->pBase, pStore->ulSize);
+    StorageDeinit(pStore);
+    *pStore = store;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+#ifdef __linux__
+size_t _StorageRound(Storage *pStore, size_t ulSize)
+{
+    size_t ulUnit = (pStore->iMode == STORAGE_HUGE_PAGE)?
+                    HUGE_PAGE_SIZE : (size_t)sysconf(_SC_PAGESIZE);
+    if (ulSize > SIZE_MAX - ulUnit)
+        return 0;
+    return (ulSize + ulUnit - 1) & ~(ulUnit - 1);
+}
+
+void* _StorageReserveAligned(size_t ulSize)
+{
+    /* Over-reserve by one huge page and trim the unaligned head and tail. */
+    if (ulSize > SIZE_MAX - HUGE_PAGE_SIZE)
+        return MAP_FAILED;
+    size_t ulSpan = ulSize + HUGE_PAGE_SIZE;
+    char *pSpan = (char*)mmap(NULL, ulSpan, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((void*)pSpan == MAP_FAILED)
+        return MAP_FAILED;
+
+    uintptr_t ulAddr = (uintptr_t)pSpan;
+    char *pBase = (char*)((ulAddr + HUGE_PAGE_SIZE - 1) &
+                          ~((uintptr_t)HUGE_PAGE_SIZE - 1));
+    size_t ulHead = pBase - pSpan;
+    size_t ulTail = ulSpan - ulHead - ulSize;
+    if (ulHead > 0)
+        munmap(pSpan, ulHead);
+    if (ulTail > 0)
+        munmap(pBase + ulSize, ulTail);
+
+    madvise(pBase, ulSize, MADV_HUGEPAGE);
+    return pBase;
+}
+
+int32_t _StorageRemap(Storage *pStore, size_t ulSize)
+{
+    if (ulSize == 0) {
+        /* The memory is released even if the truncation fails, so the fields
+           are reset first to keep them from dangling. */
+        if (pStore->bMapped)
+            munmap(pStore->pBase, pStore->ulSize);
+        else
+            free(pStore->pBase);
+        pStore->pBase = NULL;
+        pStore->ulSize = 0;
+        pStore->bMapped = false;
+        if ((pStore->iFd >= 0) && (ftruncate(pStore->iFd, 0) != 0))
+            return ERR_IO;
+        return SUCC;
+    }
+
+    ulSize = _StorageRound(pStore, ulSize);
+    if (ulSize == 0)
+        return ERR_NOMEM;
+    if (pStore->bMapped && (ulSize == pStore->ulSize))
+        return SUCC;
+
+    /* The backing file should be extended before the mapping covers it, and
+       be shrunk before the mapping drops the tail, so that a failed
+       truncation leaves the storage untouched. */
+    bool bFile = pStore->iMode == STORAGE_FILE;
+    if (bFile && (ulSize != pStore->ulSize) &&
+        (ftruncate(pStore->iFd, ulSize) != 0))
+        return ERR_IO;
+
+    void *pBase = MAP_FAILED;
+    if (!pStore->bMapped) {
+        /* Map the storage for the first time and move the heap content. */
+        if (bFile)
+            pBase = mmap(NULL, ulSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         pStore->iFd, 0);
+        else if (pStore->iMode == STORAGE_HUGE_PAGE)
+            pBase = _StorageReserveAligned(ulSize);
+        else
+            pBase = mmap(NULL, ulSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (pBase == MAP_FAILED)
+            goto FAIL;
+        if (pStore->ulSize > 0) {
+            size_t ulCopy = (pStore->ulSize < ulSize)? pStore->ulSize : ulSize;
+            memcpy(pBase, pStore->pBase, ulCopy);
+        }
+        free(pStore->pBase);
+        pStore->bMapped = true;
+    } else {
+        /* Try to resize the mapping in place first. */
+        pBase = mremap(pStore->pBase, pStore->ulSize, ulSize, 0);
+        if ((pBase == MAP_FAILED) && (pStore->iMode == STORAGE_HUGE_PAGE)) {
+            /* Move the pages to a new aligned region to keep them eligible
+               for huge pages. */
+            void *pDst = _StorageReserveAligned(ulSize);
+            if (pDst != MAP_FAILED) {
+                pBase = mremap(pStore->pBase, pStore->ulSize, ulSize,
+                               MREMAP_MAYMOVE | MREMAP_FIXED, pDst);
+                if (pBase == MAP_FAILED)
+                    munmap(pDst, ulSize);
+            }
+        } else if (pBase == MAP_FAILED)
+            pBase = mremap(pStore->pBase, pStore->ulSize, ulSize, MREMAP_MAYMOVE);
+        if (pBase == MAP_FAILED)
+            goto FAIL;
+    }
+
+    pStore->pBase = pBase;
+    pStore->ulSize = ulSize;
+    return SUCC;
+
+FAIL:
+    /* Restore the file size covered by the untouched storage. */
+    if (bFile && (ulSize != pStore->ulSize) &&
+        (ftruncate(pStore->iFd, pStore->ulSize) != 0))
+        return ERR_IO;
+    return ERR_NOMEM;
+}
+#endif
@@ -0,0 +1,666 @@
+#include "container/succinct_trie.h"
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+#define SIZE_WORD_BIT       (64)
+#define SIZE_BLOCK_WORD     (8)
+#define SIZE_BLOCK_BIT      (SIZE_WORD_BIT * SIZE_BLOCK_WORD)
+#define SIZE_SELECT_SAMPLE  (512)
+#define CAP_INIT_STR        (16)
+
+/* The half open range of the sorted strings sharing a node. */
+typedef struct _SuccinctTrieRange {
+    int32_t iBgn;
+    int32_t iEnd;
+} SuccinctTrieRange;
+
+/* The growing array of the strings resolved by the prefix query. */
+typedef struct _SuccinctTrieResult {
+    char **aStr;
+    int32_t iNum;
+    int32_t iCap;
+} SuccinctTrieResult;
+
+/* The LOUDS bit vector is padded to whole blocks. The rank directory counts
+   the 1 bits before each block, and the select directory keeps the block
+   holding every SIZE_SELECT_SAMPLE-th 0 bit. */
+struct _SuccinctTrieData {
+    uint64_t *aLouds_;
+    uint64_t *aTerm_;
+    uint8_t *aLabel_;
+    uint32_t *aRank_;
+    uint32_t *aSelect_;
+    int64_t lNumNode_;
+    int64_t lNumBlock_;
+    int64_t lNumSelect_;
+    int32_t iNumStr_;
+    int32_t iMaxLen_;
+};
+
+#define GET_BIT(_words, _pos)                                                   \
+            (((_words)[(_pos) / SIZE_WORD_BIT] >> ((_pos) % SIZE_WORD_BIT)) & 1)
+
+#define SET_BIT(_words, _pos)                                                   \
+            do {                                                                \
+                (_words)[(_pos) / SIZE_WORD_BIT] |=                             \
+                    (uint64_t)1 << ((_pos) % SIZE_WORD_BIT);                    \
+            } while (0);
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Release the encoded trie and reset it to the empty one.
+ *
+ * @param pData         The pointer to the trie private data
+ */
+void _SuccinctTrieRelease(SuccinctTrieData *pData);
+
+/**
+ * @brief Collect all the strings of Trie and sort them in the byte order.
+ *
+ * @param pTrie         The pointer to the source Trie
+ * @param paStr         The pointer to the returned array of strings
+ * @param piNum         The pointer to the number of strings, which is the
+ *                      size of the trie on entry and the collected one on exit
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory to collect the strings
+ */
+int32_t _SuccinctTrieCollectTrie(Trie *pTrie, char ***paStr, int32_t *piNum);
+
+/**
+ * @brief Encode the sorted strings into the bit vectors and the label array.
+ *
+ * @param pData         The pointer to the empty private data to fill
+ * @param aStr          The sorted array of distinct strings
+ * @param iNum          The number of strings
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory to encode the trie
+ */
+int32_t _SuccinctTrieEncode(SuccinctTrieData *pData, char **aStr, int32_t iNum);
+
+/**
+ * @brief Build the rank and the select directories of the LOUDS bit vector.
+ *
+ * @param pData         The pointer to the trie private data
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for the directories
+ */
+int32_t _SuccinctTrieIndex(SuccinctTrieData *pData);
+
+/**
+ * @brief Return the position of the designated 0 bit of the LOUDS bit vector.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param lRank         The number of 0 bits before the designated one
+ *
+ * @return              The bit position
+ */
+int64_t _SuccinctTrieSelect0(SuccinctTrieData *pData, int64_t lRank);
+
+/**
+ * @brief Locate the children of the designated node.
+ *
+ * The children of the node x are the nodes from e + 1 to e + n, and their
+ * labels are the entries from e to e + n - 1 of the label array.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param lNode         The designated node
+ * @param plEdge        The pointer to the returned first edge e
+ *
+ * @return              The number of children n
+ */
+int32_t _SuccinctTrieChildren(SuccinctTrieData *pData, int64_t lNode,
+                              int64_t *plEdge);
+
+/**
+ * @brief Follow the designated string from the root.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param str           The designated string
+ *
+ * @return              The node reached by the string or -1 for the mismatch
+ */
+int64_t _SuccinctTrieWalk(SuccinctTrieData *pData, const char *str);
+
+/**
+ * @brief Append the strings below the designated node in the byte order.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param lNode         The designated node
+ * @param szBuf         The buffer holding the path to the node
+ * @param iLen          The length of the path
+ * @param pResult       The pointer to the result array
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory to store the resolved strings
+ */
+int32_t _SuccinctTrieCollect(SuccinctTrieData *pData, int64_t lNode,
+                             char *szBuf, int32_t iLen,
+                             SuccinctTrieResult *pResult);
+
+/**
+ * @brief The comparison method for qsort on the string array.
+ */
+int _SuccinctTrieCompare(const void *pSrc, const void *pTge);
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+
+/*===========================================================================*
+ *               Implementation for the exported operations                  *
+ *===========================================================================*/
+int32_t SuccinctTrieInit(SuccinctTrie **ppObj)
+{
+    *ppObj = (SuccinctTrie*)malloc(sizeof(SuccinctTrie));
+    if (!(*ppObj))
+        return ERR_NOMEM;
+    SuccinctTrie *pObj = *ppObj;
+
+    pObj->pData = (SuccinctTrieData*)malloc(sizeof(SuccinctTrieData));
+    if (!(pObj->pData)) {
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+
+    /* The empty trie holds the root without children. */
+    if (_SuccinctTrieEncode(pObj->pData, NULL, 0) != SUCC) {
+        free(pObj->pData);
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+
+    pObj->build = SuccinctTrieBuild;
+    pObj->has_exact = SuccinctTrieHasExact;
+    pObj->has_prefix_as = SuccinctTrieHasPrefixAs;
+    pObj->get_prefix_as = SuccinctTrieGetPrefixAs;
+    pObj->size = SuccinctTrieSize;
+    pObj->get_stat = SuccinctTrieGetStat;
+
+    return SUCC;
+}
+
+void SuccinctTrieDeinit(SuccinctTrie **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+
+    SuccinctTrie *pObj = *ppObj;
+    if (!(pObj->pData))
+        goto FREE_TRIE;
+
+    _SuccinctTrieRelease(pObj->pData);
+    free(pObj->pData);
+FREE_TRIE:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t SuccinctTrieBuild(SuccinctTrie *self, Trie *pTrie)
+{
+    CHECK_INIT(self);
+    int32_t iNum = TrieSize(pTrie);
+    if (iNum < 0)
+        return iNum;
+
+    char **aStr;
+    int32_t iRtn = _SuccinctTrieCollectTrie(pTrie, &aStr, &iNum);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    /* Encode into the fresh data so that the trie survives the failure. */
+    SuccinctTrieData data;
+    iRtn = _SuccinctTrieEncode(&data, aStr, iNum);
+    if (iRtn == SUCC) {
+        _SuccinctTrieRelease(self->pData);
+        *(self->pData) = data;
+    }
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        free(aStr[iIdx]);
+    free(aStr);
+    return iRtn;
+}
+
+int32_t SuccinctTrieHasExact(SuccinctTrie *self, char *str)
+{
+    CHECK_INIT(self);
+    if (!str)
+        return NOKEY;
+    if (*str == 0)
+        return NOKEY;
+
+    SuccinctTrieData *pData = self->pData;
+    int64_t lNode = _SuccinctTrieWalk(pData, str);
+    if (lNode < 0)
+        return NOKEY;
+    return (GET_BIT(pData->aTerm_, lNode))? SUCC : NOKEY;
+}
+
+int32_t SuccinctTrieHasPrefixAs(SuccinctTrie *self, char *str)
+{
+    CHECK_INIT(self);
+    if (!str)
+        return NOKEY;
+    if (*str == 0)
+        return NOKEY;
+
+    /* Every node leads to at least one stored string. */
+    return (_SuccinctTrieWalk(self->pData, str) >= 0)? SUCC : NOKEY;
+}
+
+int32_t SuccinctTrieGetPrefixAs(SuccinctTrie *self, char *str, char ***paStr,
+                                int *piNum)
+{
+    CHECK_INIT(self);
+    if (!paStr || !piNum)
+        return ERR_GET;
+
+    *paStr = NULL;
+    *piNum = 0;
+    if (!str)
+        return NOKEY;
+    if (*str == 0)
+        return NOKEY;
+
+    SuccinctTrieData *pData = self->pData;
+    int64_t lNode = _SuccinctTrieWalk(pData, str);
+    if (lNode < 0)
+        return NOKEY;
+
+    /* The walk consumed the whole prefix, so it is not longer than the longest
+       stored string, which bounds the buffer. */
+    char *szBuf = (char*)malloc(sizeof(char) * (pData->iMaxLen_ + 1));
+    if (!szBuf)
+        return ERR_NOMEM;
+    int32_t iLen = strlen(str);
+    memcpy(szBuf, str, iLen);
+
+    SuccinctTrieResult result;
+    result.aStr = NULL;
+    result.iNum = 0;
+    result.iCap = 0;
+    int32_t iRtn = _SuccinctTrieCollect(pData, lNode, szBuf, iLen, &result);
+    free(szBuf);
+    if (iRtn != SUCC) {
+        int32_t iIdx;
+        for (iIdx = 0 ; iIdx < result.iNum ; iIdx++)
+            free(result.aStr[iIdx]);
+        free(result.aStr);
+        return iRtn;
+    }
+
+    *paStr = result.aStr;
+    *piNum = result.iNum;
+    return SUCC;
+}
+
+int32_t SuccinctTrieSize(SuccinctTrie *self)
+{
+    CHECK_INIT(self);
+    return self->pData->iNumStr_;
+}
+
+int32_t SuccinctTrieGetStat(SuccinctTrie *self, TrieStat *pStat)
+{
+    CHECK_INIT(self);
+    if (!pStat)
+        return ERR_GET;
+
+    SuccinctTrieData *pData = self->pData;
+    int64_t lNumNode = pData->lNumNode_;
+    pStat->lCountNode = lNumNode;
+    pStat->lCountByte =
+        sizeof(uint64_t) * pData->lNumBlock_ * SIZE_BLOCK_WORD +
+        sizeof(uint64_t) * ((lNumNode + SIZE_WORD_BIT - 1) / SIZE_WORD_BIT) +
+        sizeof(uint8_t) * lNumNode +
+        sizeof(uint32_t) * (pData->lNumBlock_ + 1) +
+        sizeof(uint32_t) * pData->lNumSelect_;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+void _SuccinctTrieRelease(SuccinctTrieData *pData)
+{
+    free(pData->aLouds_);
+    free(pData->aTerm_);
+    free(pData->aLabel_);
+    free(pData->aRank_);
+    free(pData->aSelect_);
+    pData->aLouds_ = NULL;
+    pData->aTerm_ = NULL;
+    pData->aLabel_ = NULL;
+    pData->aRank_ = NULL;
+    pData->aSelect_ = NULL;
+    pData->lNumNode_ = 0;
+    pData->lNumBlock_ = 0;
+    pData->lNumSelect_ = 0;
+    pData->iNumStr_ = 0;
+    pData->iMaxLen_ = 0;
+    return;
+}
+
+int32_t _SuccinctTrieCollectTrie(Trie *pTrie, char ***paStr, int32_t *piNum)
+{
+    int32_t iCap = *piNum + 1;
+    char **aStr = (char**)malloc(sizeof(char*) * iCap);
+    if (!aStr)
+        return ERR_NOMEM;
+
+    /* Trie rejects the empty prefix, so the strings are drawn by their first
+       bytes, which works for both node layouts. */
+    int32_t iRtn = SUCC;
+    int32_t iSize = 0;
+    int32_t iByte, iIdx;
+    for (iByte = 1 ; iByte < 256 ; iByte++) {
+        char szPrefix[2];
+        szPrefix[0] = (char)iByte;
+        szPrefix[1] = 0;
+
+        char **aPart;
+        int iPart;
+        iRtn = TrieGetPrefixAs(pTrie, szPrefix, &aPart, &iPart);
+        if (iRtn == NOKEY)
+            continue;
+        if (iRtn != SUCC)
+            goto FREE_STR;
+
+        if (iSize + iPart > iCap) {
+            char **aNew = (char**)realloc(aStr, sizeof(char*) * (iSize + iPart));
+            if (!aNew) {
+                for (iIdx = 0 ; iIdx < iPart ; iIdx++)
+                    free(aPart[iIdx]);
+                free(aPart);
+                iRtn = ERR_NOMEM;
+                goto FREE_STR;
+            }
+            aStr = aNew;
+            iCap = iSize + iPart;
+        }
+        memcpy(aStr + iSize, aPart, sizeof(char*) * iPart);
+        iSize += iPart;
+        free(aPart);
+    }
+
+    /* The ternary nodes compare the plain chars, whose signedness depends on
+       the platform, so the strings are sorted again in the byte order. */
+    qsort(aStr, iSize, sizeof(char*), _SuccinctTrieCompare);
+    *paStr = aStr;
+    *piNum = iSize;
+    return SUCC;
+
+FREE_STR:
+    for (iIdx = 0 ; iIdx < iSize ; iIdx++)
+        free(aStr[iIdx]);
+    free(aStr);
+    return iRtn;
+}
+
+int32_t _SuccinctTrieEncode(SuccinctTrieData *pData, char **aStr, int32_t iNum)
+{
+    pData->aLouds_ = NULL;
+    pData->aTerm_ = NULL;
+    pData->aLabel_ = NULL;
+    pData->aRank_ = NULL;
+    pData->aSelect_ = NULL;
+    _SuccinctTrieRelease(pData);
+
+    /* Each string adds the nodes for the bytes beyond the longest common
+       prefix with its predecessor in the sorted order. */
+    int64_t lNumNode = 1;
+    int32_t iMaxLen = 0;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        int32_t iLen = strlen(aStr[iIdx]);
+        int32_t iCommon = 0;
+        if (iIdx > 0) {
+            const char *szPred = aStr[iIdx - 1];
+            while (szPred[iCommon] && (szPred[iCommon] == aStr[iIdx][iCommon]))
+                iCommon++;
+        }
+        lNumNode += iLen - iCommon;
+        if (iLen > iMaxLen)
+            iMaxLen = iLen;
+    }
+
+    /* The vector holds n - 1 bits of 1 for the edges and n bits of 0. */
+    int64_t lNumBit = (lNumNode << 1) - 1;
+    int64_t lNumBlock = (lNumBit + SIZE_BLOCK_BIT - 1) / SIZE_BLOCK_BIT;
+    int64_t lNumTerm = (lNumNode + SIZE_WORD_BIT - 1) / SIZE_WORD_BIT;
+    if (lNumBit > UINT32_MAX)
+        return ERR_NOMEM;
+    pData->aLouds_ = (uint64_t*)calloc(lNumBlock * SIZE_BLOCK_WORD,
+                                       sizeof(uint64_t));
+    pData->aTerm_ = (uint64_t*)calloc(lNumTerm, sizeof(uint64_t));
+    pData->aLabel_ = (uint8_t*)malloc(sizeof(uint8_t) * lNumNode);
+    SuccinctTrieRange *aCurr = (SuccinctTrieRange*)
+                               malloc(sizeof(SuccinctTrieRange) * (iNum + 1));
+    SuccinctTrieRange *aNext = (SuccinctTrieRange*)
+                               malloc(sizeof(SuccinctTrieRange) * (iNum + 1));
+    int32_t iRtn = ERR_NOMEM;
+    if (!pData->aLouds_ || !pData->aTerm_ || !pData->aLabel_ || !aCurr ||
+        !aNext)
+        goto FREE;
+
+    /* Visit the nodes level by level. The ranges of a level never outnumber
+       the strings, and a node whose range starts with the string ending at its
+       depth marks the terminal bit. */
+    int64_t lNode = 0, lEdge = 0, lBit = 0;
+    int32_t iNumCurr = 1, iDepth = 0;
+    aCurr[0].iBgn = 0;
+    aCurr[0].iEnd = iNum;
+    while (iNumCurr > 0) {
+        int32_t iNumNext = 0;
+        for (iIdx = 0 ; iIdx < iNumCurr ; iIdx++) {
+            int32_t iBgn = aCurr[iIdx].iBgn;
+            int32_t iEnd = aCurr[iIdx].iEnd;
+            if ((iBgn < iEnd) && (aStr[iBgn][iDepth] == 0)) {
+                SET_BIT(pData->aTerm_, lNode);
+                iBgn++;
+            }
+            while (iBgn < iEnd) {
+                char cByte = aStr[iBgn][iDepth];
+                int32_t iNext = iBgn + 1;
+                while ((iNext < iEnd) && (aStr[iNext][iDepth] == cByte))
+                    iNext++;
+                SET_BIT(pData->aLouds_, lBit);
+                lBit++;
+                pData->aLabel_[lEdge++] = (uint8_t)cByte;
+                aNext[iNumNext].iBgn = iBgn;
+                aNext[iNumNext++].iEnd = iNext;
+                iBgn = iNext;
+            }
+            lBit++;
+            lNode++;
+        }
+
+        SuccinctTrieRange *aSwap = aCurr;
+        aCurr = aNext;
+        aNext = aSwap;
+        iNumCurr = iNumNext;
+        iDepth++;
+    }
+
+    pData->lNumNode_ = lNumNode;
+    pData->lNumBlock_ = lNumBlock;
+    pData->iNumStr_ = iNum;
+    pData->iMaxLen_ = iMaxLen;
+    iRtn = _SuccinctTrieIndex(pData);
+
+FREE:
+    free(aCurr);
+    free(aNext);
+    if (iRtn != SUCC)
+        _SuccinctTrieRelease(pData);
+    return iRtn;
+}
+
+int32_t _SuccinctTrieIndex(SuccinctTrieData *pData)
+{
+    int64_t lNumBlock = pData->lNumBlock_;
+    int64_t lNumZero = pData->lNumNode_;
+    int64_t lNumSelect = (lNumZero + SIZE_SELECT_SAMPLE - 1) / SIZE_SELECT_SAMPLE;
+    pData->aRank_ = (uint32_t*)malloc(sizeof(uint32_t) * (lNumBlock + 1));
+    pData->aSelect_ = (uint32_t*)malloc(sizeof(uint32_t) * lNumSelect);
+    if (!pData->aRank_ || !pData->aSelect_)
+        return ERR_NOMEM;
+    pData->lNumSelect_ = lNumSelect;
+
+    /* The padding bits beyond the vector are never selected, since the last
+       node ends with the last real 0 bit. */
+    uint64_t ulOne = 0;
+    int64_t lSample = 0;
+    int64_t lBlock;
+    for (lBlock = 0 ; lBlock < lNumBlock ; lBlock++) {
+        pData->aRank_[lBlock] = (uint32_t)ulOne;
+        uint64_t ulBlockOne = 0;
+        int32_t iWord;
+        for (iWord = 0 ; iWord < SIZE_BLOCK_WORD ; iWord++)
+            ulBlockOne += __builtin_popcountll(
+                            pData->aLouds_[lBlock * SIZE_BLOCK_WORD + iWord]);
+
+        /* Record this block for the samples whose 0 bits fall into it. */
+        int64_t lZeroEnd = (lBlock + 1) * SIZE_BLOCK_BIT - (ulOne + ulBlockOne);
+        while ((lSample < lNumSelect) &&
+               (lSample * SIZE_SELECT_SAMPLE < lZeroEnd))
+            pData->aSelect_[lSample++] = (uint32_t)lBlock;
+        ulOne += ulBlockOne;
+    }
+    pData->aRank_[lNumBlock] = (uint32_t)ulOne;
+    return SUCC;
+}
+
+int64_t _SuccinctTrieSelect0(SuccinctTrieData *pData, int64_t lRank)
+{
+    /* Start from the sampled block, and skip the blocks by the rank directory
+       whose 0 bits are exhausted before the designated one. */
+    int64_t lBlock = pData->aSelect_[lRank / SIZE_SELECT_SAMPLE];
+    while ((lBlock + 1) * SIZE_BLOCK_BIT - pData->aRank_[lBlock + 1] <= lRank)
+        lBlock++;
+    lRank -= lBlock * SIZE_BLOCK_BIT - pData->aRank_[lBlock];
+
+    const uint64_t *aWord = pData->aLouds_ + lBlock * SIZE_BLOCK_WORD;
+    int32_t iWord = 0;
+    while (true) {
+        int32_t iZero = SIZE_WORD_BIT - __builtin_popcountll(aWord[iWord]);
+        if (lRank < iZero)
+            break;
+        lRank -= iZero;
+        iWord++;
+    }
+
+    /* Drop the lower 0 bits inside the word. */
+    uint64_t ulZero = ~aWord[iWord];
+    while (lRank > 0) {
+        ulZero &= ulZero - 1;
+        lRank--;
+    }
+    return (lBlock * SIZE_BLOCK_WORD + iWord) * SIZE_WORD_BIT +
+           __builtin_ctzll(ulZero);
+}
+
+int32_t _SuccinctTrieChildren(SuccinctTrieData *pData, int64_t lNode,
+                              int64_t *plEdge)
+{
+    /* The run of the node starts after the 0 bit closing its predecessor, and
+       the 1 bits before the run are the edges of the preceding nodes. */
+    int64_t lBgn = (lNode == 0)? 0 : (_SuccinctTrieSelect0(pData, lNode - 1) + 1);
+    *plEdge = lBgn - lNode;
+
+    /* Scan for the 0 bit closing the run. */
+    int64_t lWord = lBgn / SIZE_WORD_BIT;
+    uint64_t ulZero = ~pData->aLouds_[lWord] >> (lBgn % SIZE_WORD_BIT);
+    if (ulZero)
+        return __builtin_ctzll(ulZero);
+    int64_t lEnd = (lWord + 1) * SIZE_WORD_BIT;
+    while ((ulZero = ~pData->aLouds_[++lWord]) == 0)
+        lEnd += SIZE_WORD_BIT;
+    return (int32_t)(lEnd + __builtin_ctzll(ulZero) - lBgn);
+}
+
+int64_t _SuccinctTrieWalk(SuccinctTrieData *pData, const char *str)
+{
+    int64_t lNode = 0;
+    while (*str) {
+        int64_t lEdge;
+        int32_t iNum = _SuccinctTrieChildren(pData, lNode, &lEdge);
+
+        /* The labels of the siblings are sorted. */
+        const uint8_t *aLabel = pData->aLabel_ + lEdge;
+        uint8_t ucByte = (uint8_t)*str;
+        int32_t iBgn = 0, iEnd = iNum;
+        while (iBgn < iEnd) {
+            int32_t iMid = (iBgn + iEnd) >> 1;
+            if (aLabel[iMid] < ucByte)
+                iBgn = iMid + 1;
+            else
+                iEnd = iMid;
+        }
+        if ((iBgn == iNum) || (aLabel[iBgn] != ucByte))
+            return -1;
+
+        lNode = lEdge + iBgn + 1;
+        str++;
+    }
+    return lNode;
+}
+
+int32_t _SuccinctTrieCollect(SuccinctTrieData *pData, int64_t lNode,
+                             char *szBuf, int32_t iLen,
+                             SuccinctTrieResult *pResult)
+{
+    if (GET_BIT(pData->aTerm_, lNode)) {
+        if (pResult->iNum == pResult->iCap) {
+            int32_t iCap = (pResult->iCap > 0)?
+                           (pResult->iCap << 1) : CAP_INIT_STR;
+            char **aStr = (char**)realloc(pResult->aStr, sizeof(char*) * iCap);
+            if (!aStr)
+                return ERR_NOMEM;
+            pResult->aStr = aStr;
+            pResult->iCap = iCap;
+        }
+        char *szStr = (char*)malloc(sizeof(char) * (iLen + 1));
+        if (!szStr)
+            return ERR_NOMEM;
+        memcpy(szStr, szBuf, iLen);
+        szStr[iLen] = 0;
+        pResult->aStr[pResult->iNum++] = szStr;
+    }
+
+    int64_t lEdge;
+    int32_t iNum = _SuccinctTrieChildren(pData, lNode, &lEdge);
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        szBuf[iLen] = (char)pData->aLabel_[lEdge + iIdx];
+        int32_t iRtn = _SuccinctTrieCollect(pData, lEdge + iIdx + 1, szBuf,
+                                            iLen + 1, pResult);
+        if (iRtn != SUCC)
+            return iRtn;
+    }
+    return SUCC;
+}
+
+int _SuccinctTrieCompare(const void *pSrc, const void *pTge)
+{
+    return strcmp(*(char* const*)pSrc, *(char* const*)pTge);
+}
@@ -1,34 +1,26 @@
-#include "container/tree_map.h"
+#include "tree_map_internal.h"
 
 
-/*===========================================================================*
- *                        The container private data                         *
- *===========================================================================*/
-typedef struct _TreeNode {
-    bool bColor;
-    Pair *pPair;
-    struct _TreeNode *pParent;
-    struct _TreeNode *pLeft;
-    struct _TreeNode *pRight;
-} TreeNode;
-
-struct _TreeMapData {
-    bool bEnd_;
-    int32_t iSize_;
-    int32_t iTop_;
-    TreeNode *pRoot_;
-    TreeNode *pNull_;
-    TreeNode *pIter_;
-    TreeNode **pStack_;
-    int32_t (*pCompare_) (Key, Key);
-    void (*pDestroy_) (Pair*);
-};
-
-#define DIRECT_LEFT      (0)
-#define DIRECT_RIGHT     (1)
-
-#define COLOR_RED        (0)
-#define COLOR_BLACK      (1)
+/* The integer keys are ordered without calling the comparison method. */
+#define ORDER(pData, keySrc, keyTge)                                         \
+    (((pData)->iMode_ == TREE_MAP_PAIR_INTEGER)?                             \
+     (((intptr_t)(keySrc) > (intptr_t)(keyTge)) -                            \
+      ((intptr_t)(keySrc) < (intptr_t)(keyTge))) :                           \
+     (pData)->pCompare_((keySrc), (keyTge)))
+
+/* The nodes of the TREE_MAP_PAIR_REFER mode leave out the inline pair. */
+#define SIZE_NODE(pData)                                                     \
+    (((pData)->iMode_ == TREE_MAP_PAIR_REFER)?                               \
+     offsetof(TreeNode, pair) : sizeof(TreeNode))
+
+#define POOL_NODE(pData, aNode, iIdx)                                        \
+    ((TreeNode*)((char*)(aNode) + SIZE_NODE(pData) * (iIdx)))
+
+/* All the maps share one sentinel so that the subtrees can move between maps
+   without relinking their leaves. The sentinel is never written. */
+static TreeNode _TreeMapNull = {COLOR_BLACK, false, 0, 0, NULL,
+                                &_TreeMapNull, &_TreeMapNull, &_TreeMapNull,
+                                {NULL, NULL}};
 
 
 /*===========================================================================*
@@ -45,80 +37,216 @@ struct _TreeMapData {
 void _TreeMapDeinit(TreeMapData *pData);
 
 /**
- * @brief Return the node having the maximal order in the subtree rooted by the
- * designated node. The node order is determined by its stored key.
+ * @brief Allocate a node, preferring the released nodes of the bulk pools.
  *
- * @param pCurr         The pointer to the designated node
+ * @param pData         The pointer to the map private data
  *
- * @return              The pointer to the returned node or NULL
+ * @return              The pointer to the allocated node or NULL
  */
-TreeNode* _TreeMapMaximal(TreeNode *pNull, TreeNode *pCurr);
+TreeNode* _TreeMapNewNode(TreeMapData *pData);
 
 /**
- * @brief Return the node having the minimal order in the subtree rooted by the
- * designated node. The node order is determined by its stored key.
+ * @brief Return a node of the current version which can be written in place.
  *
- * @param pCurr         The pointer to the designated node
+ * If the node is shared with the snapshots, it is replaced by a private copy
+ * which takes over the child links, and its parent is relinked to the copy.
+ * The parent must already be private.
  *
- * @return              The pointer to the returned node or NULL
+ * @param pData         The pointer to the map private data
+ * @param pNode         The pointer to the designated node
+ *
+ * @return              The pointer to the private node or NULL if the memory
+ *                      is insufficient
  */
-TreeNode* _TreeMapMinimal(TreeNode *pNull, TreeNode *pCurr);
+TreeNode* _TreeMapOwn(TreeMapData *pData, TreeNode *pNode);
 
 /**
- * @brief Return the immediate successor of the designated node.
+ * @brief Make the search path of the designated key private before a write,
+ * and reserve the spare nodes for the copies made by the rebalancing.
  *
- * @param pCurr         The pointer to the designated node
+ * @param pData         The pointer to the map private data
+ * @param key           The designated key
+ * @param bSucc         Whether the path extends to the successor which takes
+ *                      over the position of the found node
  *
- * @return              The pointer to the returned node or NULL
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for the copies
  */
-TreeNode* _TreeMapSuccessor(TreeNode *pNull, TreeNode *pCurr);
+int32_t _TreeMapOwnPath(TreeMapData *pData, Key key, bool bSucc);
 
 /**
- * @brief Return the immediate predecessor of the designated node.
+ * @brief Keep the designated number of spare nodes for the later allocation.
  *
- * @param pCurr         The pointer to the designated node
+ * @param pData         The pointer to the map private data
+ * @param iNum          The designated number of spare nodes
  *
- * @return              The pointer to the returned node or NULL
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for the spare nodes
+ */
+int32_t _TreeMapReserve(TreeMapData *pData, int32_t iNum);
+
+/**
+ * @brief Drop a reference to the designated subtree, and release the nodes no
+ * longer referred to by any version. The pairs are left untouched.
+ *
+ * @param pData         The pointer to the map private data
+ * @param pNode         The pointer to the subtree root
  */
-TreeNode* _TreeMapPredecessor(TreeNode *pNull, TreeNode *pCurr);
+void _TreeMapDrop(TreeMapData *pData, TreeNode *pNode);
 
 /**
- * @brief Make right rotation for the subtree rooted by the designated node.
+ * @brief Keep the record of a pair removed from the current version until all
+ * the snapshots which may reach the pair are released.
  *
- * After rotation, the designated node will be the right child of its original
- * left child.
+ * The record is attached to the newest snapshot, since only that snapshot and
+ * the older ones were taken before the removal.
  *
- * @param pData         The pointer to the tree private data
- * @param pCurr         The pointer to the designated node
+ * @param pData         The pointer to the map private data
+ * @param pNode         The pointer to the unlinked node storing the pair
+ */
+void _TreeMapRetire(TreeMapData *pData, TreeNode *pNode);
+
+/**
+ * @brief Release the snapshot. The retired records are handed over to the
+ * previous snapshot, or released with their pairs if there is none.
+ *
+ * @param pData         The pointer to the map private data
+ * @param pSnap         The pointer to the snapshot
+ */
+void _TreeMapRelease(TreeMapData *pData, TreeMapSnapshot *pSnap);
+
+/**
+ * @brief Release a node. The nodes of the bulk pools are kept for reuse.
+ *
+ * @param pData         The pointer to the map private data
+ * @param pNode         The pointer to the designated node
  */
-void _TreeMapRightRotate(TreeMapData *pData, TreeNode *pCurr);
+void _TreeMapFreeNode(TreeMapData *pData, TreeNode *pNode);
 
 /**
- * @brief Make left rotation for the subtree rooted by the designated node.
+ * @brief Link the nodes of a sorted pair array into a balanced subtree.
  *
- * After rotation, the designated node will be the left child of its original
- * right child.
+ * The subtree is rooted by the middle pair so that all the dummy leaves are at
+ * the last two levels. The nodes at the designated red depth are colored red
+ * and the others black, which balances the black height of all the paths.
+ *
+ * @param pData         The pointer to the map private data
+ * @param aPair         The array of sorted pairs
+ * @param aNode         The array of nodes matching the pairs
+ * @param iBgn          The index of the first pair of the subtree
+ * @param iEnd          The index next to the last pair of the subtree
+ * @param iDepth        The depth of the subtree root
+ * @param iRed          The depth of the red nodes
+ *
+ * @return              The pointer to the subtree root
+ */
+TreeNode* _TreeMapBuild(TreeMapData *pData, Pair **aPair, TreeNode *aNode,
+                        int32_t iBgn, int32_t iEnd, int32_t iDepth, int32_t iRed);
+
+/**
+ * @brief Sort the pairs by their keys with the stable merge sort.
+ *
+ * @param aPair         The array of the pairs to sort
+ * @param aTmp          The buffer having the same size with the array
+ * @param iSize         The number of pairs
+ * @param pCompare      The key comparison method
+ */
+void _TreeMapSort(Pair **aPair, Pair **aTmp, int32_t iSize,
+                  int32_t (*pCompare) (Key, Key));
+
+/**
+ * @brief Join two subtrees with a middle node whose key is ordered after all
+ * the keys of the left subtree and before all the keys of the right one.
+ *
+ * The node is linked at the spine of the higher subtree where the black
+ * heights match, and the red violation is fixed upwards. The tree root of
+ * the private data is used as the scratch space. The black heights count the
+ * subtree roots as black, since the roots are painted black before the join.
  *
  * @param pData         The pointer to the tree private data
- * @param pCurr         The pointer to the designated node
+ * @param pLeft         The pointer to the root of the left subtree
+ * @param iLeft         The black height of the left subtree
+ * @param pMid          The pointer to the middle node
+ * @param pRight        The pointer to the root of the right subtree
+ * @param iRight        The black height of the right subtree
+ * @param piHeight      The pointer to the returned black height of the joined
+ *                      tree
+ *
+ * @return              The pointer to the root of the joined tree
  */
-void _TreeMapLeftRotate(TreeMapData *pData, TreeNode *pCurr);
+TreeNode* _TreeMapJoin(TreeMapData *pData, TreeNode *pLeft, int32_t iLeft,
+                       TreeNode *pMid, TreeNode *pRight, int32_t iRight,
+                       int32_t *piHeight);
 
 /**
- * @brief Maintain the red black tree property after node insertion.
+ * @brief Split the subtree into the keys ordered before and after the
+ * designated key.
+ *
+ * The black heights are passed down and returned with the parts, so that no
+ * join along the path has to measure its operands.
  *
  * @param pData         The pointer to the tree private data
- * @param pCurr         The pointer to the designated node
+ * @param pRoot         The pointer to the root of the subtree
+ * @param iHeight       The black height of the subtree counting its root as
+ *                      black
+ * @param key           The designated key
+ * @param ppLeft        The double pointer to the returned left subtree
+ * @param piLeft        The pointer to the returned black height of the left
+ *                      subtree
+ * @param ppRight       The double pointer to the returned right subtree
+ * @param piRight       The pointer to the returned black height of the right
+ *                      subtree
+ *
+ * @return              The pointer to the node storing the designated key or
+ *                      the dummy node if the key cannot be found
  */
-void _TreeMapInsertFixup(TreeMapData *pData, TreeNode *pCurr);
+TreeNode* _TreeMapSplit(TreeMapData *pData, TreeNode *pRoot, int32_t iHeight,
+                        Key key, TreeNode **ppLeft, int32_t *piLeft,
+                        TreeNode **ppRight, int32_t *piRight);
 
 /**
- * @brief Maintain the red black tree property after node deletion.
+ * @brief Union two subtrees by splitting the first one with the root of the
+ * second one recursively.
+ *
+ * The nodes of the first subtree whose keys also appear in the second one are
+ * released with their pairs.
  *
  * @param pData         The pointer to the tree private data
- * @param pCurr         The pointer to the designated node
+ * @param pFst          The pointer to the root of the first subtree
+ * @param iFst          The black height of the first subtree
+ * @param pSnd          The pointer to the root of the second subtree
+ * @param iSnd          The black height of the second subtree
+ * @param pDup          The pointer to the returned number of released nodes
+ * @param piHeight      The pointer to the returned black height of the united
+ *                      tree
+ *
+ * @return              The pointer to the root of the united tree
+ */
+TreeNode* _TreeMapUnion(TreeMapData *pData, TreeNode *pFst, int32_t iFst,
+                        TreeNode *pSnd, int32_t iSnd, int32_t *pDup,
+                        int32_t *piHeight);
+
+/**
+ * @brief Return the black height of the designated subtree.
+ *
+ * @param pNull         The pointer to the dummy node
+ * @param pCurr         The pointer to the root of the subtree
+ *
+ * @return              The number of black nodes on each path to the leaves
+ */
+int32_t _TreeMapBlackHeight(TreeNode *pNull, TreeNode *pCurr);
+
+/**
+ * @brief Let the destination map refer to all the node pools of the source
+ * map before the nodes move from the source to the destination.
+ *
+ * @param pDst          The pointer to the destination map private data
+ * @param pSrc          The pointer to the source map private data
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for the pool references
  */
-void _TreeMapDeleteFixup(TreeMapData *pData, TreeNode *pCurr);
+int32_t _TreeMapSharePool(TreeMapData *pDst, TreeMapData *pSrc);
 
 /**
  * @brief Get the node which stores the key having the same order with the
@@ -131,6 +259,44 @@ void _TreeMapDeleteFixup(TreeMapData *pData, TreeNode *pCurr);
  */
 TreeNode* _TreeMapSearch(TreeMapData *pData, Key key);
 
+/**
+ * @brief Get the node storing the first key not ordered before the designated
+ * key, or ordered after the key for the upper bound.
+ *
+ * @param pData         The pointer to the map private data
+ * @param key           The designated key
+ * @param bUpper        Whether to find the upper bound
+ *
+ * @return              The pointer to the node or the dummy node if all the
+ *                      keys are ordered before the bound
+ */
+TreeNode* _TreeMapBound(TreeMapData *pData, Key key, bool bUpper);
+
+/**
+ * @brief Return the number of keys ordered before the designated key.
+ *
+ * In the order statistic mode, the subtree counts of the left siblings along
+ * the search path are summed up. Otherwise, the nodes are counted from the
+ * minimal one.
+ *
+ * @param pData         The pointer to the map private data
+ * @param key           The designated key
+ *
+ * @return              The rank of the key
+ */
+int32_t _TreeMapRank(TreeMapData *pData, Key key);
+
+/**
+ * @brief Recompute the subtree counts of all the nodes in the designated
+ * subtree.
+ *
+ * @param pNull         The pointer to the dummy node
+ * @param pCurr         The pointer to the root of the subtree
+ *
+ * @return              The number of nodes in the subtree
+ */
+int32_t _TreeMapRecount(TreeNode *pNull, TreeNode *pCurr);
+
 /**
  * @brief The default key comparison method.
  *
@@ -143,6 +309,18 @@ TreeNode* _TreeMapSearch(TreeMapData *pData, Key key);
  */
 int32_t _TreeMapCompare(Key keySrc, Key keyTge);
 
+/**
+ * @brief The comparison method for the keys as signed integers.
+ *
+ * @param keySrc        The source key
+ * @param keyTge        The target key
+ *
+ * @retval 1            The source key should go after the target one
+ * @retval 0            The source key is equal to the target one
+ * @retval -1           The source key should go before the target one
+ */
+int32_t _TreeMapCompareInteger(Key keySrc, Key keyTge);
+
 /**
  * @brief The default resource clean method for a key value pair.
  *
@@ -180,27 +358,28 @@ int32_t TreeMapInit(TreeMap **ppObj)
     }
     TreeMapData *pData = pObj->pData;
 
-    /* Create the dummy node representing the NULL pointer of the tree. */
-    pData->pNull_ = (TreeNode*)malloc(sizeof(TreeNode));
-    if (!(pData->pNull_)) {
-        free(pObj->pData);
-        free(*ppObj);
-        *ppObj = NULL;
-        return ERR_NOMEM;
-    }
-    pData->pNull_->bColor = COLOR_BLACK;
-    pData->pNull_->pPair = NULL;
-    pData->pNull_->pParent = pData->pNull_;
-    pData->pNull_->pRight = pData->pNull_;
-    pData->pNull_->pLeft = pData->pNull_;
+    /* Refer to the dummy node representing the NULL pointer of the tree. */
+    pData->pNull_ = &_TreeMapNull;
 
     pObj->pData->iSize_ = 0;
     pObj->pData->pRoot_ = pData->pNull_;
     pObj->pData->pCompare_ = _TreeMapCompare;
     pObj->pData->pDestroy_ = NULL;
-    pObj->pData->pStack_ = NULL;
+    pObj->pData->pIter_ = pData->pNull_;
+    pObj->pData->pRange_ = pData->pNull_;
+    pObj->pData->keyEnd_ = NULL;
+    pObj->pData->bOrder_ = false;
+    pObj->pData->iMode_ = TREE_MAP_PAIR_REFER;
+    pObj->pData->pFree_ = NULL;
+    pObj->pData->aPool_ = NULL;
+    pObj->pData->iPool_ = 0;
+    pObj->pData->pSpare_ = NULL;
+    pObj->pData->iSpare_ = 0;
+    pObj->pData->pSnap_ = NULL;
+    pObj->pData->pAugment_ = NULL;
 
     pObj->put = TreeMapPut;
+    pObj->build = TreeMapBuild;
     pObj->get = TreeMapGet;
     pObj->find = TreeMapFind;
     pObj->remove = TreeMapRemove;
@@ -209,10 +388,32 @@ int32_t TreeMapInit(TreeMap **ppObj)
     pObj->maximum = TreeMapMaximum;
     pObj->predecessor = TreeMapPredecessor;
     pObj->successor = TreeMapSuccessor;
+    pObj->lower_bound = TreeMapLowerBound;
+    pObj->upper_bound = TreeMapUpperBound;
     pObj->iterate = TreeMapIterate;
     pObj->reverse_iterate = TreeMapReverseIterate;
+    pObj->iterate_range = TreeMapIterateRange;
+    pObj->count_range = TreeMapCountRange;
+    pObj->cursor_first = TreeMapCursorFirst;
+    pObj->cursor_last = TreeMapCursorLast;
+    pObj->cursor_seek = TreeMapCursorSeek;
+    pObj->cursor_next = TreeMapCursorNext;
+    pObj->cursor_prev = TreeMapCursorPrev;
+    pObj->rank = TreeMapRank;
+    pObj->select = TreeMapSelect;
     pObj->set_compare = TreeMapSetCompare;
     pObj->set_destroy = TreeMapSetDestroy;
+    pObj->set_order_statistic = TreeMapSetOrderStatistic;
+    pObj->set_pair_mode = TreeMapSetPairMode;
+    pObj->join = TreeMapJoin;
+    pObj->split = TreeMapSplit;
+    pObj->merge = TreeMapMerge;
+    pObj->snapshot_take = TreeMapSnapshotTake;
+    pObj->snapshot_release = TreeMapSnapshotRelease;
+    pObj->snapshot_get = TreeMapSnapshotGet;
+    pObj->snapshot_iterate = TreeMapSnapshotIterate;
+    pObj->snapshot_seek = TreeMapSnapshotSeek;
+    pObj->snapshot_size = TreeMapSnapshotSize;
 
     return SUCC;
 }
@@ -230,10 +431,9 @@ void TreeMapDeinit(TreeMap **ppObj)
     if (!(pData->pNull_))
         goto FREE_DATA;
 
+    while (pData->pSnap_)
+        _TreeMapRelease(pData, pData->pSnap_);
     _TreeMapDeinit(pData);
-    free(pData->pNull_);
-    if (pData->pStack_)
-        free(pData->pStack_);
 
 FREE_DATA:
     free(pObj->pData);
@@ -251,12 +451,23 @@ int32_t TreeMapPut(TreeMap *self, Pair *pPair)
     bool bDirect;
     int32_t iOrder;
     TreeNode *pNew, *pCurr, *pParent;
-    pNew = (TreeNode*)malloc(sizeof(TreeNode));
+    TreeMapData *pData = self->pData;
+    if (pData->pSnap_) {
+        int32_t iRtn = _TreeMapOwnPath(pData, pPair->key, false);
+        if (iRtn != SUCC)
+            return iRtn;
+    }
+
+    pNew = _TreeMapNewNode(pData);
     if (!pNew)
         return ERR_NOMEM;
-    TreeMapData *pData = self->pData;
     pNew->pPair = pPair;
+    if (pData->iMode_ != TREE_MAP_PAIR_REFER) {
+        pNew->pair = *pPair;
+        pNew->pPair = &(pNew->pair);
+    }
     pNew->bColor = COLOR_RED;
+    pNew->iCount = 1;
     pNew->pParent = pData->pNull_;
     pNew->pLeft = pData->pNull_;
     pNew->pRight = pData->pNull_;
@@ -265,7 +476,7 @@ int32_t TreeMapPut(TreeMap *self, Pair *pPair)
     pCurr = pData->pRoot_;
     while (pCurr != pData->pNull_) {
         pParent = pCurr;
-        iOrder = pData->pCompare_(pPair->key, pCurr->pPair->key);
+        iOrder = ORDER(pData, pPair->key, pCurr->pPair->key);
         if (iOrder > 0) {
             pCurr = pCurr->pRight;
             bDirect = DIRECT_RIGHT;
@@ -275,11 +486,25 @@ int32_t TreeMapPut(TreeMap *self, Pair *pPair)
             bDirect = DIRECT_LEFT;
         }
         else {
-            /* Conflict with the already stored key value pair. */
-            free(pNew);
-            if (pData->pDestroy_)
-                pData->pDestroy_(pCurr->pPair);
-            pCurr->pPair = pPair;
+            /* Conflict with the already stored key value pair. The spare node
+               takes over the replaced pair, and the copies are swapped in the
+               inline modes. The snapshots may still reach the replaced pair,
+               which is then retired with the spare node as its record. */
+            if (pData->iMode_ != TREE_MAP_PAIR_REFER) {
+                Pair pairOld = pCurr->pair;
+                pCurr->pair = pNew->pair;
+                pNew->pair = pairOld;
+            } else {
+                pNew->pPair = pCurr->pPair;
+                pCurr->pPair = pPair;
+            }
+            if (pData->pSnap_)
+                _TreeMapRetire(pData, pNew);
+            else {
+                if (pData->pDestroy_)
+                    pData->pDestroy_(pNew->pPair);
+                _TreeMapFreeNode(pData, pNew);
+            }
             return SUCC;
         }
     }
@@ -296,6 +521,12 @@ int32_t TreeMapPut(TreeMap *self, Pair *pPair)
 
     /* Increase the size. */
     pData->iSize_++;
+    if (pData->bOrder_) {
+        while (pParent != pData->pNull_) {
+            pParent->iCount++;
+            pParent = pParent->pParent;
+        }
+    }
 
     /* Maintain the red black tree structure. */
     _TreeMapInsertFixup(self->pData, pNew);
@@ -303,6 +534,93 @@ int32_t TreeMapPut(TreeMap *self, Pair *pPair)
     return SUCC;
 }
 
+int32_t TreeMapBuild(TreeMap *self, Pair **aPair, int32_t iNum)
+{
+    CHECK_INIT(self);
+    if ((iNum < 0) || ((iNum > 0) && (!aPair)))
+        return ERR_IDX;
+    if (self->pData->pSnap_)
+        return ERR_POLICY;
+
+    /* Prepare all the memory before the stored pairs are released. */
+    TreeMapData *pData = self->pData;
+    Pair **aSort = NULL;
+    TreePool *pPool = NULL;
+    TreePool **aPool = NULL;
+    if (iNum > 0) {
+        aSort = (Pair**)malloc(sizeof(Pair*) * iNum);
+        pPool = (TreePool*)malloc(sizeof(TreePool) + SIZE_NODE(pData) * iNum);
+        aPool = (TreePool**)malloc(sizeof(TreePool*));
+        if (!aSort || !pPool || !aPool) {
+            free(aSort);
+            free(pPool);
+            free(aPool);
+            return ERR_NOMEM;
+        }
+        memcpy(aSort, aPair, sizeof(Pair*) * iNum);
+    }
+
+    /* Sort the pairs unless they are sorted already. */
+    int32_t iIdx;
+    for (iIdx = 1 ; iIdx < iNum ; iIdx++) {
+        if (pData->pCompare_(aSort[iIdx - 1]->key, aSort[iIdx]->key) > 0)
+            break;
+    }
+    if (iIdx < iNum) {
+        Pair **aTmp = (Pair**)malloc(sizeof(Pair*) * iNum);
+        if (!aTmp) {
+            free(aSort);
+            free(pPool);
+            free(aPool);
+            return ERR_NOMEM;
+        }
+        _TreeMapSort(aSort, aTmp, iNum, pData->pCompare_);
+        free(aTmp);
+    }
+
+    _TreeMapDeinit(pData);
+
+    /* Keep the last pair of each group sharing the same order. */
+    int32_t iSize = 0;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        if ((iIdx + 1 < iNum) &&
+            (pData->pCompare_(aSort[iIdx]->key, aSort[iIdx + 1]->key) == 0)) {
+            if (pData->pDestroy_)
+                pData->pDestroy_(aSort[iIdx]);
+            continue;
+        }
+        aSort[iSize++] = aSort[iIdx];
+    }
+
+    if (iSize > 0) {
+        /* The red depth is the last level unless the tree is perfect. */
+        int32_t iHeight = 0;
+        while (((int64_t)2 << iHeight) - 1 < iSize)
+            iHeight++;
+        int32_t iRed = (((int64_t)2 << iHeight) - 1 == iSize)? (-1) : iHeight;
+
+        pPool->iRef = 1;
+        aPool[0] = pPool;
+        pData->aPool_ = aPool;
+        pData->iPool_ = 1;
+        pData->pRoot_ = _TreeMapBuild(pData, aSort, pPool->aNode, 0, iSize, 0,
+                                      iRed);
+        pData->pRoot_->pParent = pData->pNull_;
+    }
+
+    /* The unused tail of the pool serves the later insertions. */
+    for (iIdx = iSize ; iIdx < iNum ; iIdx++) {
+        TreeNode *pNode = POOL_NODE(pData, pPool->aNode, iIdx);
+        pNode->bBlock = true;
+        pNode->pRight = pData->pFree_;
+        pData->pFree_ = pNode;
+    }
+
+    pData->iSize_ = iSize;
+    free(aSort);
+    return SUCC;
+}
+
 int32_t TreeMapGet(TreeMap *self, Key key, Value *pValue)
 {
     CHECK_INIT(self);
@@ -334,82 +652,31 @@ int32_t TreeMapRemove(TreeMap *self, Key key)
 {
     CHECK_INIT(self);
 
-    TreeNode *pCurr, *pChild, *pSucc;
     TreeMapData *pData = self->pData;
-    TreeNode *pNull = pData->pNull_;
-    pCurr = _TreeMapSearch(pData, key);
-    if (pCurr == pNull)
+    TreeNode *pCurr = _TreeMapSearch(pData, key);
+    if (pCurr == pData->pNull_)
         return ERR_NODATA;
 
-    bool bColor;
-    /* The specified node has no child. */
-    if ((pCurr->pLeft == pNull) && (pCurr->pRight == pNull)) {
-        if (pCurr->pParent != pNull) {
-            if (pCurr == pCurr->pParent->pLeft)
-                pCurr->pParent->pLeft = pNull;
-            else
-                pCurr->pParent->pRight = pNull;
-        } else
-            pData->pRoot_ = pNull;
+    /* Copy the shared nodes on the way to the deleted node and its successor,
+       then search again for the copy. */
+    if (pData->pSnap_) {
+        int32_t iRtn = _TreeMapOwnPath(pData, key, true);
+        if (iRtn != SUCC)
+            return iRtn;
+        pCurr = _TreeMapSearch(pData, key);
+    }
 
-        bColor = pCurr->bColor;
-        pChild = pNull;
-        pChild->pParent = pCurr->pParent;
+    _TreeMapUnlink(pData, pCurr);
+    if (pData->pSnap_)
+        _TreeMapRetire(pData, pCurr);
+    else {
         if (pData->pDestroy_)
             pData->pDestroy_(pCurr->pPair);
-        free(pCurr);
-    } else {
-        /* The specified node has two children. */
-        if ((pCurr->pLeft != pNull) && (pCurr->pRight != pNull)) {
-            pSucc = _TreeMapSuccessor(pNull, pCurr);
-
-            pChild = pSucc->pLeft;
-            if (pChild == pNull)
-                pChild = pSucc->pRight;
-
-            pChild->pParent = pSucc->pParent;
-
-            if (pSucc == pSucc->pParent->pLeft)
-                pSucc->pParent->pLeft = pChild;
-            else
-                pSucc->pParent->pRight = pChild;
-
-            bColor = pSucc->bColor;
-            if (pData->pDestroy_)
-                pData->pDestroy_(pCurr->pPair);
-            pCurr->pPair = pSucc->pPair;
-            free(pSucc);
-        }
-        /* The specified node has one child. */
-        else {
-            pChild = pCurr->pLeft;
-            if (pChild == pNull)
-                pChild = pCurr->pRight;
-
-            pChild->pParent = pCurr->pParent;
-
-            if (pCurr->pParent != pNull) {
-                if (pCurr == pCurr->pParent->pLeft)
-                    pCurr->pParent->pLeft = pChild;
-                else
-                    pCurr->pParent->pRight = pChild;
-            } else
-                pData->pRoot_ = pChild;
-
-            bColor = pCurr->bColor;
-            if (pData->pDestroy_)
-                pData->pDestroy_(pCurr->pPair);
-            free(pCurr);
-        }
+        _TreeMapFreeNode(pData, pCurr);
     }
 
     /* Decrease the size. */
     pData->iSize_--;
-
-    /* Maintain the balanced tree structure. */
-    if (bColor == COLOR_BLACK)
-        _TreeMapDeleteFixup(pData, pChild);
-
     return SUCC;
 }
 
@@ -432,220 +699,962 @@ int32_t TreeMapMinimum(TreeMap *self, Pair **ppPair)
         return SUCC;
     }
 
-    *ppPair = NULL;
-    return ERR_IDX;
+    *ppPair = NULL;
+    return ERR_IDX;
+}
+
+int32_t TreeMapMaximum(TreeMap *self, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    TreeMapData *pData = self->pData;
+    TreeNode *pFind = _TreeMapMaximal(pData->pNull_, pData->pRoot_);
+    if (pFind != pData->pNull_) {
+        *ppPair = pFind->pPair;
+        return SUCC;
+    }
+
+    *ppPair = NULL;
+    return ERR_IDX;
+}
+
+int32_t TreeMapPredecessor(TreeMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    TreeNode *pNull = self->pData->pNull_;
+    TreeNode *pCurr = _TreeMapSearch(self->pData, key);
+    if (pCurr == pNull)
+        return ERR_NODATA;
+
+    TreeNode *pFind = _TreeMapPredecessor(pNull, pCurr);
+    if (pFind != pNull) {
+        *ppPair = pFind->pPair;
+        return SUCC;
+    }
+
+    *ppPair = NULL;
+    return ERR_NODATA;
+}
+
+int32_t TreeMapSuccessor(TreeMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    TreeNode *pNull = self->pData->pNull_;
+    TreeNode *pCurr = _TreeMapSearch(self->pData, key);
+    if (pCurr == pNull)
+        return ERR_NODATA;
+
+    TreeNode *pFind = _TreeMapSuccessor(pNull, pCurr);
+    if (pFind != pNull) {
+        *ppPair = pFind->pPair;
+        return SUCC;
+    }
+
+    *ppPair = NULL;
+    return ERR_NODATA;
+}
+
+int32_t TreeMapLowerBound(TreeMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    TreeNode *pFind = _TreeMapBound(self->pData, key, false);
+    if (pFind != self->pData->pNull_) {
+        *ppPair = pFind->pPair;
+        return SUCC;
+    }
+
+    *ppPair = NULL;
+    return ERR_NODATA;
+}
+
+int32_t TreeMapUpperBound(TreeMap *self, Key key, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    TreeNode *pFind = _TreeMapBound(self->pData, key, true);
+    if (pFind != self->pData->pNull_) {
+        *ppPair = pFind->pPair;
+        return SUCC;
+    }
+
+    *ppPair = NULL;
+    return ERR_NODATA;
+}
+
+int32_t TreeMapIterate(TreeMap *self, bool bReset, Pair **ppPair)
+{
+    CHECK_INIT(self);
+
+    TreeMapData *pData = self->pData;
+    if (bReset) {
+        pData->pIter_ = _TreeMapMinimal(pData->pNull_, pData->pRoot_);
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+
+    TreeNode *pCurr = pData->pIter_;
+    if (pCurr == pData->pNull_) {
+        *ppPair = NULL;
+        return END;
+    }
+
+    *ppPair = pCurr->pPair;
+    pData->pIter_ = _TreeMapSuccessor(pData->pNull_, pCurr);
+    return SUCC;
+}
+
+int32_t TreeMapReverseIterate(TreeMap *self, bool bReset, Pair **ppPair)
+{
+    CHECK_INIT(self);
+
+    TreeMapData *pData = self->pData;
+    if (bReset) {
+        pData->pIter_ = _TreeMapMaximal(pData->pNull_, pData->pRoot_);
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+
+    TreeNode *pCurr = pData->pIter_;
+    if (pCurr == pData->pNull_) {
+        *ppPair = NULL;
+        return END;
+    }
+
+    *ppPair = pCurr->pPair;
+    pData->pIter_ = _TreeMapPredecessor(pData->pNull_, pCurr);
+    return SUCC;
+}
+
+int32_t TreeMapCursorFirst(TreeMap *self, TreeMapCursor *pCursor)
+{
+    CHECK_INIT(self);
+    if (!pCursor)
+        return ERR_GET;
+
+    TreeMapData *pData = self->pData;
+    TreeNode *pFind = _TreeMapMinimal(pData->pNull_, pData->pRoot_);
+    pCursor->pNode = (pFind != pData->pNull_)? pFind : NULL;
+    return SUCC;
+}
+
+int32_t TreeMapCursorLast(TreeMap *self, TreeMapCursor *pCursor)
+{
+    CHECK_INIT(self);
+    if (!pCursor)
+        return ERR_GET;
+
+    TreeMapData *pData = self->pData;
+    TreeNode *pFind = _TreeMapMaximal(pData->pNull_, pData->pRoot_);
+    pCursor->pNode = (pFind != pData->pNull_)? pFind : NULL;
+    return SUCC;
+}
+
+int32_t TreeMapCursorSeek(TreeMap *self, Key key, TreeMapCursor *pCursor)
+{
+    CHECK_INIT(self);
+    if (!pCursor)
+        return ERR_GET;
+
+    TreeMapData *pData = self->pData;
+    TreeNode *pFind = _TreeMapBound(pData, key, false);
+    pCursor->pNode = (pFind != pData->pNull_)? pFind : NULL;
+    return SUCC;
+}
+
+int32_t TreeMapCursorNext(TreeMap *self, TreeMapCursor *pCursor, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!pCursor || !ppPair)
+        return ERR_GET;
+
+    TreeNode *pCurr = (TreeNode*)pCursor->pNode;
+    if (!pCurr) {
+        *ppPair = NULL;
+        return END;
+    }
+
+    TreeNode *pNull = self->pData->pNull_;
+    TreeNode *pFind = _TreeMapSuccessor(pNull, pCurr);
+    *ppPair = pCurr->pPair;
+    pCursor->pNode = (pFind != pNull)? pFind : NULL;
+    return SUCC;
+}
+
+int32_t TreeMapCursorPrev(TreeMap *self, TreeMapCursor *pCursor, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!pCursor || !ppPair)
+        return ERR_GET;
+
+    TreeNode *pCurr = (TreeNode*)pCursor->pNode;
+    if (!pCurr) {
+        *ppPair = NULL;
+        return END;
+    }
+
+    TreeNode *pNull = self->pData->pNull_;
+    TreeNode *pFind = _TreeMapPredecessor(pNull, pCurr);
+    *ppPair = pCurr->pPair;
+    pCursor->pNode = (pFind != pNull)? pFind : NULL;
+    return SUCC;
+}
+
+int32_t TreeMapIterateRange(TreeMap *self, bool bReset, Key keyBgn, Key keyEnd,
+                            Pair **ppPair)
+{
+    CHECK_INIT(self);
+
+    TreeMapData *pData = self->pData;
+    if (bReset) {
+        pData->pRange_ = _TreeMapBound(pData, keyBgn, false);
+        pData->keyEnd_ = keyEnd;
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+
+    /* Walk the in-order successors until the exclusive upper boundary. */
+    TreeNode *pNull = pData->pNull_;
+    TreeNode *pCurr = pData->pRange_;
+    if ((pCurr == pNull) ||
+        (pData->pCompare_(pCurr->pPair->key, pData->keyEnd_) >= 0)) {
+        pData->pRange_ = pNull;
+        *ppPair = NULL;
+        return END;
+    }
+
+    *ppPair = pCurr->pPair;
+    pData->pRange_ = _TreeMapSuccessor(pNull, pCurr);
+    return SUCC;
+}
+
+int32_t TreeMapCountRange(TreeMap *self, Key keyBgn, Key keyEnd)
+{
+    CHECK_INIT(self);
+
+    TreeMapData *pData = self->pData;
+    if (pData->bOrder_) {
+        if (pData->pCompare_(keyBgn, keyEnd) >= 0)
+            return 0;
+        return _TreeMapRank(pData, keyEnd) - _TreeMapRank(pData, keyBgn);
+    }
+
+    TreeNode *pNull = pData->pNull_;
+    TreeNode *pCurr = _TreeMapBound(pData, keyBgn, false);
+    int32_t iCount = 0;
+    while ((pCurr != pNull) &&
+           (pData->pCompare_(pCurr->pPair->key, keyEnd) < 0)) {
+        iCount++;
+        pCurr = _TreeMapSuccessor(pNull, pCurr);
+    }
+    return iCount;
+}
+
+int32_t TreeMapRank(TreeMap *self, Key key)
+{
+    CHECK_INIT(self);
+    return _TreeMapRank(self->pData, key);
+}
+
+int32_t TreeMapSelect(TreeMap *self, int32_t iIdx, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!ppPair)
+        return ERR_GET;
+
+    TreeMapData *pData = self->pData;
+    if ((iIdx < 0) || (iIdx >= pData->iSize_)) {
+        *ppPair = NULL;
+        return ERR_IDX;
+    }
+
+    TreeNode *pNull = pData->pNull_;
+    TreeNode *pCurr;
+    if (pData->bOrder_) {
+        /* Descend by comparing the index with the left subtree count. */
+        pCurr = pData->pRoot_;
+        while (true) {
+            int32_t iLeft = pCurr->pLeft->iCount;
+            if (iIdx == iLeft)
+                break;
+            if (iIdx < iLeft)
+                pCurr = pCurr->pLeft;
+            else {
+                iIdx -= iLeft + 1;
+                pCurr = pCurr->pRight;
+            }
+        }
+    } else {
+        pCurr = _TreeMapMinimal(pNull, pData->pRoot_);
+        while (iIdx-- > 0)
+            pCurr = _TreeMapSuccessor(pNull, pCurr);
+    }
+
+    *ppPair = pCurr->pPair;
+    return SUCC;
+}
+
+int32_t TreeMapJoin(TreeMap *self, TreeMap *pOther)
+{
+    CHECK_INIT(self);
+    CHECK_INIT(pOther);
+    if (self == pOther)
+        return ERR_IDX;
+
+    TreeMapData *pData = self->pData;
+    TreeMapData *pSrc = pOther->pData;
+    TreeNode *pNull = pData->pNull_;
+    if (pData->pSnap_ || pSrc->pSnap_ || (pData->iMode_ != pSrc->iMode_))
+        return ERR_POLICY;
+    if (pSrc->iSize_ == 0)
+        return SUCC;
+
+    /* Decide which tree holds the smaller keys. */
+    TreeNode *pLeft, *pRight;
+    if (pData->iSize_ == 0) {
+        pLeft = pNull;
+        pRight = pSrc->pRoot_;
+    } else {
+        TreeNode *pMin = _TreeMapMinimal(pNull, pData->pRoot_);
+        TreeNode *pMax = _TreeMapMaximal(pNull, pData->pRoot_);
+        TreeNode *pSrcMin = _TreeMapMinimal(pNull, pSrc->pRoot_);
+        TreeNode *pSrcMax = _TreeMapMaximal(pNull, pSrc->pRoot_);
+        if (pData->pCompare_(pMax->pPair->key, pSrcMin->pPair->key) < 0) {
+            pLeft = pData->pRoot_;
+            pRight = pSrc->pRoot_;
+        } else if (pData->pCompare_(pSrcMax->pPair->key, pMin->pPair->key) < 0) {
+            pLeft = pSrc->pRoot_;
+            pRight = pData->pRoot_;
+        } else
+            return ERR_IDX;
+    }
+
+    int32_t iRtn = _TreeMapSharePool(pData, pSrc);
+    if (iRtn != SUCC)
+        return iRtn;
+    if (pData->bOrder_ && !(pSrc->bOrder_))
+        _TreeMapRecount(pNull, pSrc->pRoot_);
+
+    /* Detach the minimum of the right tree as the middle node. */
+    TreeNode *pMid = _TreeMapMinimal(pNull, pRight);
+    pData->pRoot_ = pRight;
+    _TreeMapUnlink(pData, pMid);
+    pRight = pData->pRoot_;
+    int32_t iHeight;
+    pData->pRoot_ = _TreeMapJoin(pData, pLeft, _TreeMapBlackHeight(pNull, pLeft),
+                                 pMid, pRight,
+                                 _TreeMapBlackHeight(pNull, pRight), &iHeight);
+
+    pData->iSize_ += pSrc->iSize_;
+    pData->pIter_ = pNull;
+    pData->pRange_ = pNull;
+    pSrc->pRoot_ = pNull;
+    pSrc->pIter_ = pNull;
+    pSrc->pRange_ = pNull;
+    pSrc->iSize_ = 0;
+    return SUCC;
+}
+
+int32_t TreeMapSplit(TreeMap *self, Key key, TreeMap *pOther)
+{
+    CHECK_INIT(self);
+    CHECK_INIT(pOther);
+    if ((self == pOther) || (pOther->pData->iSize_ > 0))
+        return ERR_IDX;
+
+    TreeMapData *pData = self->pData;
+    TreeMapData *pDst = pOther->pData;
+    TreeNode *pNull = pData->pNull_;
+    if (pData->pSnap_ || pDst->pSnap_ || (pData->iMode_ != pDst->iMode_))
+        return ERR_POLICY;
+    int32_t iRtn = _TreeMapSharePool(pDst, pData);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    /* The node storing the key becomes the minimum of the right tree. */
+    TreeNode *pLeft, *pRight;
+    int32_t iHeight = _TreeMapBlackHeight(pNull, pData->pRoot_);
+    int32_t iLeftHeight, iRightHeight;
+    TreeNode *pFind = _TreeMapSplit(pData, pData->pRoot_, iHeight, key, &pLeft,
+                                    &iLeftHeight, &pRight, &iRightHeight);
+    if (pFind != pNull)
+        pRight = _TreeMapJoin(pData, pNull, 0, pFind, pRight, iRightHeight,
+                              &iRightHeight);
+
+    /* Without the subtree counts, count the smaller part by walking both
+       parts in turn, which costs O(min(k, n - k)). */
+    int32_t iLeft;
+    if (pData->bOrder_)
+        iLeft = pLeft->iCount;
+    else {
+        TreeNode *pFst = _TreeMapMinimal(pNull, pLeft);
+        TreeNode *pSnd = _TreeMapMinimal(pNull, pRight);
+        int32_t iStep = 0;
+        while ((pFst != pNull) && (pSnd != pNull)) {
+            pFst = _TreeMapSuccessor(pNull, pFst);
+            pSnd = _TreeMapSuccessor(pNull, pSnd);
+            iStep++;
+        }
+        iLeft = (pFst == pNull)? iStep : pData->iSize_ - iStep;
+    }
+    if (pDst->bOrder_ && !(pData->bOrder_))
+        _TreeMapRecount(pNull, pRight);
+
+    pDst->pRoot_ = pRight;
+    pDst->iSize_ = pData->iSize_ - iLeft;
+    pDst->pIter_ = pNull;
+    pDst->pRange_ = pNull;
+    pData->pRoot_ = pLeft;
+    pData->iSize_ = iLeft;
+    pData->pIter_ = pNull;
+    pData->pRange_ = pNull;
+    return SUCC;
+}
+
+int32_t TreeMapMerge(TreeMap *self, TreeMap *pOther)
+{
+    CHECK_INIT(self);
+    CHECK_INIT(pOther);
+    if (self == pOther)
+        return ERR_IDX;
+
+    TreeMapData *pData = self->pData;
+    TreeMapData *pSrc = pOther->pData;
+    TreeNode *pNull = pData->pNull_;
+    if (pData->pSnap_ || pSrc->pSnap_ || (pData->iMode_ != pSrc->iMode_))
+        return ERR_POLICY;
+    int32_t iRtn = _TreeMapSharePool(pData, pSrc);
+    if (iRtn != SUCC)
+        return iRtn;
+    if (pData->bOrder_ && !(pSrc->bOrder_))
+        _TreeMapRecount(pNull, pSrc->pRoot_);
+
+    int32_t iDup = 0;
+    int32_t iHeight;
+    pData->pRoot_ = _TreeMapUnion(pData, pData->pRoot_,
+                                  _TreeMapBlackHeight(pNull, pData->pRoot_),
+                                  pSrc->pRoot_,
+                                  _TreeMapBlackHeight(pNull, pSrc->pRoot_),
+                                  &iDup, &iHeight);
+
+    pData->iSize_ += pSrc->iSize_ - iDup;
+    pData->pIter_ = pNull;
+    pData->pRange_ = pNull;
+    pSrc->pRoot_ = pNull;
+    pSrc->pIter_ = pNull;
+    pSrc->pRange_ = pNull;
+    pSrc->iSize_ = 0;
+    return SUCC;
+}
+
+int32_t TreeMapSnapshotTake(TreeMap *self, TreeMapSnapshot *pSnap)
+{
+    CHECK_INIT(self);
+    if (!pSnap)
+        return ERR_GET;
+
+    /* Pin the root, so that the next write copies it instead. */
+    TreeMapData *pData = self->pData;
+    TreeNode *pRoot = pData->pRoot_;
+    if (pRoot != pData->pNull_)
+        pRoot->iRef++;
+
+    pSnap->pRoot = pRoot;
+    pSnap->pRetire = NULL;
+    pSnap->iSize = pData->iSize_;
+    pSnap->iDepth = 0;
+    pSnap->pNext = NULL;
+    pSnap->pPrev = pData->pSnap_;
+    if (pData->pSnap_)
+        pData->pSnap_->pNext = pSnap;
+    pData->pSnap_ = pSnap;
+    return SUCC;
+}
+
+int32_t TreeMapSnapshotRelease(TreeMap *self, TreeMapSnapshot *pSnap)
+{
+    CHECK_INIT(self);
+    if (!pSnap || !(pSnap->pRoot))
+        return ERR_GET;
+
+    _TreeMapRelease(self->pData, pSnap);
+    return SUCC;
+}
+
+int32_t TreeMapSnapshotGet(TreeMap *self, TreeMapSnapshot *pSnap, Key key,
+                           Value *pValue)
+{
+    CHECK_INIT(self);
+    if (!pSnap || !(pSnap->pRoot) || !pValue)
+        return ERR_GET;
+
+    TreeMapData *pData = self->pData;
+    TreeNode *pNull = pData->pNull_;
+    TreeNode *pCurr = (TreeNode*)pSnap->pRoot;
+    while (pCurr != pNull) {
+        int32_t iOrder = pData->pCompare_(key, pCurr->pPair->key);
+        if (iOrder == 0) {
+            *pValue = pCurr->pPair->value;
+            return SUCC;
+        }
+        pCurr = (iOrder > 0)? pCurr->pRight : pCurr->pLeft;
+    }
+
+    *pValue = NULL;
+    return ERR_NODATA;
+}
+
+int32_t TreeMapSnapshotIterate(TreeMap *self, TreeMapSnapshot *pSnap,
+                               bool bReset, Pair **ppPair)
+{
+    CHECK_INIT(self);
+    if (!pSnap || !(pSnap->pRoot))
+        return ERR_GET;
+
+    TreeNode *pNull = self->pData->pNull_;
+    TreeNode *pCurr;
+    if (bReset) {
+        pSnap->iDepth = 0;
+        pCurr = (TreeNode*)pSnap->pRoot;
+        while (pCurr != pNull) {
+            pSnap->aStack[pSnap->iDepth++] = pCurr;
+            pCurr = pCurr->pLeft;
+        }
+        return SUCC;
+    }
+
+    if (!ppPair)
+        return ERR_GET;
+    if (pSnap->iDepth == 0) {
+        *ppPair = NULL;
+        return END;
+    }
+
+    /* Pop the next node and push the left spine of its right subtree. */
+    TreeNode *pNext = (TreeNode*)pSnap->aStack[--(pSnap->iDepth)];
+    pCurr = pNext->pRight;
+    while (pCurr != pNull) {
+        pSnap->aStack[pSnap->iDepth++] = pCurr;
+        pCurr = pCurr->pLeft;
+    }
+
+    *ppPair = pNext->pPair;
+    return SUCC;
+}
+
+int32_t TreeMapSnapshotSeek(TreeMap *self, TreeMapSnapshot *pSnap, Key key)
+{
+    CHECK_INIT(self);
+    if (!pSnap || !(pSnap->pRoot))
+        return ERR_GET;
+
+    /* Stack the ancestors whose keys are not ordered before the given key, so
+       that the top of the stack is the lower bound. */
+    TreeMapData *pData = self->pData;
+    TreeNode *pNull = pData->pNull_;
+    TreeNode *pCurr = (TreeNode*)pSnap->pRoot;
+    pSnap->iDepth = 0;
+    while (pCurr != pNull) {
+        int32_t iOrder = pData->pCompare_(key, pCurr->pPair->key);
+        if (iOrder > 0) {
+            pCurr = pCurr->pRight;
+            continue;
+        }
+        pSnap->aStack[pSnap->iDepth++] = pCurr;
+        if (iOrder == 0)
+            break;
+        pCurr = pCurr->pLeft;
+    }
+    return SUCC;
+}
+
+int32_t TreeMapSnapshotSize(TreeMap *self, TreeMapSnapshot *pSnap)
+{
+    CHECK_INIT(self);
+    if (!pSnap || !(pSnap->pRoot))
+        return ERR_GET;
+    return pSnap->iSize;
+}
+
+int32_t TreeMapSetCompare(TreeMap *self, int32_t (*pFunc) (Key, Key))
+{
+    CHECK_INIT(self);
+    if (self->pData->iMode_ == TREE_MAP_PAIR_INTEGER)
+        self->pData->iMode_ = TREE_MAP_PAIR_INLINE;
+    self->pData->pCompare_ = pFunc;
+    return SUCC;
+}
+
+int32_t TreeMapSetDestroy(TreeMap *self, void (*pFunc) (Pair*))
+{
+    CHECK_INIT(self);
+    self->pData->pDestroy_ = pFunc;
+    return SUCC;
+}
+
+int32_t TreeMapSetOrderStatistic(TreeMap *self, bool bEnable)
+{
+    CHECK_INIT(self);
+
+    /* The counts are stale after running without the augmentation. */
+    TreeMapData *pData = self->pData;
+    if (bEnable && !(pData->bOrder_))
+        _TreeMapRecount(pData->pNull_, pData->pRoot_);
+    pData->bOrder_ = bEnable;
+    return SUCC;
+}
+
+int32_t TreeMapSetPairMode(TreeMap *self, int32_t iMode)
+{
+    CHECK_INIT(self);
+
+    /* The stored nodes and the snapshots depend on the current mode. */
+    TreeMapData *pData = self->pData;
+    if ((iMode < TREE_MAP_PAIR_REFER) || (iMode > TREE_MAP_PAIR_INTEGER))
+        return ERR_POLICY;
+    if ((pData->iSize_ > 0) || pData->pSnap_)
+        return ERR_POLICY;
+
+    /* The pooled nodes left for reuse are sized for the current mode. */
+    if ((iMode == TREE_MAP_PAIR_REFER) != (pData->iMode_ == TREE_MAP_PAIR_REFER))
+        _TreeMapDeinit(pData);
+
+    if (iMode == TREE_MAP_PAIR_INTEGER)
+        pData->pCompare_ = _TreeMapCompareInteger;
+    else if (pData->pCompare_ == _TreeMapCompareInteger)
+        pData->pCompare_ = _TreeMapCompare;
+    pData->iMode_ = iMode;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+void _TreeMapDeinit(TreeMapData *pData)
+{
+    /* Apply the post-order traversal which detaches each visited leaf from its
+       parent and climbs back through the parent link. */
+    TreeNode *pNull = pData->pNull_;
+    TreeNode *pCurr = pData->pRoot_;
+    while (pCurr != pNull) {
+        if (pCurr->pLeft != pNull)
+            pCurr = pCurr->pLeft;
+        else if (pCurr->pRight != pNull)
+            pCurr = pCurr->pRight;
+        else {
+            TreeNode *pParent = pCurr->pParent;
+            if (pParent != pNull) {
+                if (pCurr == pParent->pLeft)
+                    pParent->pLeft = pNull;
+                else
+                    pParent->pRight = pNull;
+            }
+            if (pData->pDestroy_)
+                pData->pDestroy_(pCurr->pPair);
+            if (!(pCurr->bBlock))
+                free(pCurr);
+            pCurr = pParent;
+        }
+    }
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < pData->iPool_ ; iIdx++) {
+        TreePool *pPool = pData->aPool_[iIdx];
+        if (--(pPool->iRef) == 0)
+            free(pPool);
+    }
+    free(pData->aPool_);
+    pData->aPool_ = NULL;
+    pData->iPool_ = 0;
+    pData->pFree_ = NULL;
+    pData->pRoot_ = pNull;
+    pData->pIter_ = pNull;
+    pData->pRange_ = pNull;
+    pData->iSize_ = 0;
+    return;
 }
 
-int32_t TreeMapMaximum(TreeMap *self, Pair **ppPair)
+TreeNode* _TreeMapNewNode(TreeMapData *pData)
 {
-    CHECK_INIT(self);
-    if (!ppPair)
-        return ERR_GET;
-
-    TreeMapData *pData = self->pData;
-    TreeNode *pFind = _TreeMapMaximal(pData->pNull_, pData->pRoot_);
-    if (pFind != pData->pNull_) {
-        *ppPair = pFind->pPair;
-        return SUCC;
+    TreeNode *pNode = pData->pFree_;
+    if (pNode)
+        pData->pFree_ = pNode->pRight;
+    else if (pData->pSpare_) {
+        pNode = pData->pSpare_;
+        pData->pSpare_ = pNode->pRight;
+        pData->iSpare_--;
+    } else {
+        pNode = (TreeNode*)malloc(SIZE_NODE(pData));
+        if (!pNode)
+            return NULL;
+        pNode->bBlock = false;
     }
 
-    *ppPair = NULL;
-    return ERR_IDX;
+    pNode->iRef = 1;
+    return pNode;
 }
 
-int32_t TreeMapPredecessor(TreeMap *self, Key key, Pair **ppPair)
+TreeNode* _TreeMapOwn(TreeMapData *pData, TreeNode *pNode)
 {
-    CHECK_INIT(self);
-    if (!ppPair)
-        return ERR_GET;
-
-    TreeNode *pNull = self->pData->pNull_;
-    TreeNode *pCurr = _TreeMapSearch(self->pData, key);
-    if (pCurr == pNull)
-        return ERR_NODATA;
+    /* The dummy node has no reference and is never copied. */
+    if (pNode->iRef <= 1)
+        return pNode;
+
+    TreeNode *pCopy = _TreeMapNewNode(pData);
+    if (!pCopy)
+        return NULL;
+    pCopy->bColor = pNode->bColor;
+    pCopy->iCount = pNode->iCount;
+    pCopy->pPair = pNode->pPair;
+    if (pNode->pPair == &(pNode->pair)) {
+        pCopy->pair = pNode->pair;
+        pCopy->pPair = &(pCopy->pair);
+    }
+    pCopy->pParent = pNode->pParent;
+    pCopy->pLeft = pNode->pLeft;
+    pCopy->pRight = pNode->pRight;
 
-    TreeNode *pFind = _TreeMapPredecessor(pNull, pCurr);
-    if (pFind != pNull) {
-        *ppPair = pFind->pPair;
-        return SUCC;
+    /* The parent links serve only the current version, so they can be
+       redirected even for the shared children. */
+    TreeNode *pNull = pData->pNull_;
+    if (pCopy->pLeft != pNull) {
+        pCopy->pLeft->iRef++;
+        pCopy->pLeft->pParent = pCopy;
+    }
+    if (pCopy->pRight != pNull) {
+        pCopy->pRight->iRef++;
+        pCopy->pRight->pParent = pCopy;
     }
 
-    *ppPair = NULL;
-    return ERR_NODATA;
+    TreeNode *pParent = pCopy->pParent;
+    if (pParent == pNull)
+        pData->pRoot_ = pCopy;
+    else if (pParent->pLeft == pNode)
+        pParent->pLeft = pCopy;
+    else
+        pParent->pRight = pCopy;
+    pNode->iRef--;
+    return pCopy;
 }
 
-int32_t TreeMapSuccessor(TreeMap *self, Key key, Pair **ppPair)
+int32_t _TreeMapOwnPath(TreeMapData *pData, Key key, bool bSucc)
 {
-    CHECK_INIT(self);
-    if (!ppPair)
-        return ERR_GET;
+    TreeNode *pNull = pData->pNull_;
+    TreeNode *pCurr = pData->pRoot_;
+    int32_t iDepth = 0;
+    while (pCurr != pNull) {
+        pCurr = _TreeMapOwn(pData, pCurr);
+        if (!pCurr)
+            return ERR_NOMEM;
+        iDepth++;
 
-    TreeNode *pNull = self->pData->pNull_;
-    TreeNode *pCurr = _TreeMapSearch(self->pData, key);
-    if (pCurr == pNull)
-        return ERR_NODATA;
+        int32_t iOrder = pData->pCompare_(key, pCurr->pPair->key);
+        if (iOrder != 0) {
+            pCurr = (iOrder > 0)? pCurr->pRight : pCurr->pLeft;
+            continue;
+        }
+        if (!bSucc || (pCurr->pLeft == pNull) || (pCurr->pRight == pNull))
+            break;
 
-    TreeNode *pFind = _TreeMapSuccessor(pNull, pCurr);
-    if (pFind != pNull) {
-        *ppPair = pFind->pPair;
-        return SUCC;
+        pCurr = pCurr->pRight;
+        while (true) {
+            pCurr = _TreeMapOwn(pData, pCurr);
+            if (!pCurr)
+                return ERR_NOMEM;
+            iDepth++;
+            if (pCurr->pLeft == pNull)
+                break;
+            pCurr = pCurr->pLeft;
+        }
+        break;
     }
 
-    *ppPair = NULL;
-    return ERR_NODATA;
+    /* The rebalancing climbs the path and copies at most four nodes beside
+       each level, namely the sibling and the nephews. One more node serves
+       the insertion. */
+    return _TreeMapReserve(pData, (iDepth + 1) * 4);
 }
 
-int32_t TreeMapIterate(TreeMap *self, bool bReset, Pair **ppPair)
+int32_t _TreeMapReserve(TreeMapData *pData, int32_t iNum)
 {
-    CHECK_INIT(self);
-
-    TreeMapData *pData = self->pData;
-    if (bReset) {
-        if (pData->pStack_)
-            free(pData->pStack_);
-        pData->pStack_ = (TreeNode**)malloc(sizeof(TreeNode*) * pData->iSize_);
-        if (!(pData->pStack_)) {
-            *ppPair = NULL;
+    while (pData->iSpare_ < iNum) {
+        TreeNode *pNode = (TreeNode*)malloc(SIZE_NODE(pData));
+        if (!pNode)
             return ERR_NOMEM;
-        }
-        pData->pIter_ = pData->pRoot_;
-        pData->iTop_ = 0;
-        pData->bEnd_ = false;
-        return SUCC;
+        pNode->bBlock = false;
+        pNode->pRight = pData->pSpare_;
+        pData->pSpare_ = pNode;
+        pData->iSpare_++;
     }
+    return SUCC;
+}
 
-    if (!ppPair)
-        return ERR_GET;
-
-    while (!(pData->bEnd_)) {
-        if (pData->pIter_ != pData->pNull_) {
-            if (pData->iTop_ == pData->iSize_) {
-                *ppPair = NULL;
-                return ERR_ITER;
-            }
-            pData->pStack_[pData->iTop_] = pData->pIter_;
-            pData->iTop_++;
-            pData->pIter_ = pData->pIter_->pLeft;
-        } else {
-            if (pData->iTop_ != 0) {
-                pData->iTop_--;
-                pData->pIter_ = pData->pStack_[pData->iTop_];
-                *ppPair = pData->pIter_->pPair;
-                pData->pIter_ = pData->pIter_->pRight;
-                return SUCC;
-            } else {
-                pData->bEnd_ = true;
-                free(pData->pStack_);
-                pData->pStack_ = NULL;
-            }
-        }
-    }
+void _TreeMapDrop(TreeMapData *pData, TreeNode *pNode)
+{
+    if ((pNode == pData->pNull_) || (--(pNode->iRef) > 0))
+        return;
 
-    *ppPair = NULL;
-    return END;
+    _TreeMapDrop(pData, pNode->pLeft);
+    _TreeMapDrop(pData, pNode->pRight);
+    _TreeMapFreeNode(pData, pNode);
+    return;
 }
 
-int32_t TreeMapReverseIterate(TreeMap *self, bool bReset, Pair **ppPair)
+void _TreeMapRetire(TreeMapData *pData, TreeNode *pNode)
 {
-    CHECK_INIT(self);
+    /* The records form a circular list referred to by its last record. */
+    TreeMapSnapshot *pSnap = pData->pSnap_;
+    TreeNode *pLast = (TreeNode*)pSnap->pRetire;
+    if (pLast) {
+        pNode->pRight = pLast->pRight;
+        pLast->pRight = pNode;
+    } else
+        pNode->pRight = pNode;
+    pSnap->pRetire = pNode;
+    return;
+}
 
-    TreeMapData *pData = self->pData;
-    if (bReset) {
-        if (pData->pStack_)
-            free(pData->pStack_);
-        pData->pStack_ = (TreeNode**)malloc(sizeof(TreeNode*) * pData->iSize_);
-        if (!(pData->pStack_)) {
-            *ppPair = NULL;
-            return END;
+void _TreeMapRelease(TreeMapData *pData, TreeMapSnapshot *pSnap)
+{
+    _TreeMapDrop(pData, (TreeNode*)pSnap->pRoot);
+
+    /* The pairs retired after this snapshot was taken may still be reached by
+       the older snapshots. */
+    TreeMapSnapshot *pPrev = pSnap->pPrev;
+    TreeNode *pLast = (TreeNode*)pSnap->pRetire;
+    if (pLast && pPrev) {
+        TreeNode *pPrevLast = (TreeNode*)pPrev->pRetire;
+        if (pPrevLast) {
+            TreeNode *pHead = pLast->pRight;
+            pLast->pRight = pPrevLast->pRight;
+            pPrevLast->pRight = pHead;
+        }
+        pPrev->pRetire = pLast;
+    } else if (pLast) {
+        TreeNode *pCurr = pLast->pRight;
+        while (true) {
+            TreeNode *pNext = pCurr->pRight;
+            if (pData->pDestroy_)
+                pData->pDestroy_(pCurr->pPair);
+            _TreeMapFreeNode(pData, pCurr);
+            if (pCurr == pLast)
+                break;
+            pCurr = pNext;
         }
-        pData->pIter_ = pData->pRoot_;
-        pData->iTop_ = 0;
-        pData->bEnd_ = false;
-        return SUCC;
     }
 
-    if (!ppPair)
-        return ERR_GET;
-
-    while (!(pData->bEnd_)) {
-        if (pData->pIter_ != pData->pNull_) {
-            if (pData->iTop_ == pData->iSize_) {
-                *ppPair = NULL;
-                return END;
-            }
-            pData->pStack_[pData->iTop_] = pData->pIter_;
-            pData->iTop_++;
-            pData->pIter_ = pData->pIter_->pRight;
-        } else {
-            if (pData->iTop_ != 0) {
-                pData->iTop_--;
-                pData->pIter_ = pData->pStack_[pData->iTop_];
-                *ppPair = pData->pIter_->pPair;
-                pData->pIter_ = pData->pIter_->pLeft;
-                return SUCC;
-            } else {
-                pData->bEnd_ = true;
-                free(pData->pStack_);
-                pData->pStack_ = NULL;
-            }
+    if (pPrev)
+        pPrev->pNext = pSnap->pNext;
+    if (pSnap->pNext)
+        pSnap->pNext->pPrev = pPrev;
+    else
+        pData->pSnap_ = pPrev;
+    pSnap->pRoot = NULL;
+    pSnap->pRetire = NULL;
+    pSnap->pPrev = NULL;
+    pSnap->pNext = NULL;
+
+    /* The spare nodes are needed only for the path copying. */
+    if (!(pData->pSnap_)) {
+        while (pData->pSpare_) {
+            TreeNode *pNode = pData->pSpare_;
+            pData->pSpare_ = pNode->pRight;
+            free(pNode);
         }
+        pData->iSpare_ = 0;
     }
-
-    *ppPair = NULL;
-    return END;
-}
-
-int32_t TreeMapSetCompare(TreeMap *self, int32_t (*pFunc) (Key, Key))
-{
-    CHECK_INIT(self);
-    self->pData->pCompare_ = pFunc;
-    return SUCC;
+    return;
 }
 
-int32_t TreeMapSetDestroy(TreeMap *self, void (*pFunc) (Pair*))
+void _TreeMapFreeNode(TreeMapData *pData, TreeNode *pNode)
 {
-    CHECK_INIT(self);
-    self->pData->pDestroy_ = pFunc;
-    return SUCC;
+    if (!(pNode->bBlock)) {
+        free(pNode);
+        return;
+    }
+    pNode->pRight = pData->pFree_;
+    pData->pFree_ = pNode;
+    return;
 }
 
-
-/*===========================================================================*
- *               Implementation for internal operations                      *
- *===========================================================================*/
-void _TreeMapDeinit(TreeMapData *pData)
+TreeNode* _TreeMapBuild(TreeMapData *pData, Pair **aPair, TreeNode *aNode,
+                        int32_t iBgn, int32_t iEnd, int32_t iDepth, int32_t iRed)
 {
     TreeNode *pNull = pData->pNull_;
-    if (pData->pRoot_ == pNull)
-        return;
+    if (iBgn == iEnd)
+        return pNull;
+
+    int32_t iMid = iBgn + ((iEnd - iBgn) >> 1);
+    TreeNode *pNode = POOL_NODE(pData, aNode, iMid);
+    pNode->bBlock = true;
+    pNode->iRef = 1;
+    pNode->bColor = (iDepth == iRed)? COLOR_RED : COLOR_BLACK;
+    pNode->iCount = iEnd - iBgn;
+    pNode->pPair = aPair[iMid];
+    if (pData->iMode_ != TREE_MAP_PAIR_REFER) {
+        pNode->pair = *(aPair[iMid]);
+        pNode->pPair = &(pNode->pair);
+    }
 
-    /* Simulate the stack and apply iterative post-order tree traversal. */
-    TreeNode ***stack = (TreeNode***)malloc(sizeof(TreeNode**) * pData->iSize_);
-    assert(stack != NULL);
+    pNode->pLeft = _TreeMapBuild(pData, aPair, aNode, iBgn, iMid, iDepth + 1,
+                                 iRed);
+    if (pNode->pLeft != pNull)
+        pNode->pLeft->pParent = pNode;
+    pNode->pRight = _TreeMapBuild(pData, aPair, aNode, iMid + 1, iEnd,
+                                  iDepth + 1, iRed);
+    if (pNode->pRight != pNull)
+        pNode->pRight->pParent = pNode;
+    return pNode;
+}
 
-    int32_t iSize = 0;
-    stack[iSize++] = &(pData->pRoot_);
-    while (iSize > 0) {
-        TreeNode **ppCurr = stack[iSize - 1];
-        TreeNode *pCurr = *ppCurr;
-        if (pCurr->pLeft != pNull)
-            stack[iSize++] = &(pCurr->pLeft);
-        else if (pCurr->pRight != pNull)
-            stack[iSize++] = &(pCurr->pRight);
-        else {
-            if (pData->pDestroy_)
-                pData->pDestroy_(pCurr->pPair);
-            TreeNode *pParent = pCurr->pParent;
-            if (pCurr == pParent->pLeft)
-                pParent->pLeft = pNull;
-            else
-                pParent->pRight = pNull;
-            free(pCurr);
-            iSize--;
+void _TreeMapSort(Pair **aPair, Pair **aTmp, int32_t iSize,
+                  int32_t (*pCompare) (Key, Key))
+{
+    /* Merge the runs bottom up and swap the roles of the two buffers. */
+    Pair **aSrc = aPair, **aDst = aTmp;
+    int32_t iWidth;
+    for (iWidth = 1 ; iWidth < iSize ; iWidth <<= 1) {
+        int32_t iBgn;
+        for (iBgn = 0 ; iBgn < iSize ; iBgn += iWidth << 1) {
+            int32_t iMid = (iBgn + iWidth < iSize)? iBgn + iWidth : iSize;
+            int32_t iEnd = (iMid + iWidth < iSize)? iMid + iWidth : iSize;
+            int32_t iFst = iBgn, iSnd = iMid, iOut = iBgn;
+            while ((iFst < iMid) && (iSnd < iEnd)) {
+                if (pCompare(aSrc[iSnd]->key, aSrc[iFst]->key) < 0)
+                    aDst[iOut++] = aSrc[iSnd++];
+                else
+                    aDst[iOut++] = aSrc[iFst++];
+            }
+            while (iFst < iMid)
+                aDst[iOut++] = aSrc[iFst++];
+            while (iSnd < iEnd)
+                aDst[iOut++] = aSrc[iSnd++];
         }
+        Pair **aSwap = aSrc;
+        aSrc = aDst;
+        aDst = aSwap;
     }
-
-    free(stack);
+    if (aSrc != aPair)
+        memcpy(aPair, aSrc, sizeof(Pair*) * iSize);
     return;
 }
 
@@ -718,6 +1727,12 @@ void _TreeMapRightRotate(TreeMapData *pData, TreeNode *pCurr)
      * a   b          b   c
      */
 
+    /* Let x take over the count of y, which then counts its new subtrees. */
+    if (pData->bOrder_) {
+        pChild->iCount = pCurr->iCount;
+        pCurr->iCount = pCurr->pRight->iCount + pChild->pRight->iCount + 1;
+    }
+
     /* Let y link b as its left child.
        If b is not dummy node, let b link y as its parent. */
     pCurr->pLeft = pChild->pRight;
@@ -740,6 +1755,12 @@ void _TreeMapRightRotate(TreeMapData *pData, TreeNode *pCurr)
     pCurr->pParent = pChild;
     pChild->pRight = pCurr;
 
+    /* Refresh y before x which now covers it. */
+    if (pData->pAugment_) {
+        pData->pAugment_(pCurr);
+        pData->pAugment_(pChild);
+    }
+
     return;
 }
 
@@ -756,6 +1777,12 @@ void _TreeMapLeftRotate(TreeMapData *pData, TreeNode *pCurr)
      *     b   c  a   b
      */
 
+    /* Let y take over the count of x, which then counts its new subtrees. */
+    if (pData->bOrder_) {
+        pChild->iCount = pCurr->iCount;
+        pCurr->iCount = pCurr->pLeft->iCount + pChild->pLeft->iCount + 1;
+    }
+
     /* Let x link b as its right child.
        If b is not dummy node, let b link x as its parent. */
     pCurr->pRight = pChild->pLeft;
@@ -778,10 +1805,30 @@ void _TreeMapLeftRotate(TreeMapData *pData, TreeNode *pCurr)
     pCurr->pParent = pChild;
     pChild->pLeft = pCurr;
 
+    /* Refresh x before y which now covers it. */
+    if (pData->pAugment_) {
+        pData->pAugment_(pCurr);
+        pData->pAugment_(pChild);
+    }
+
+    return;
+}
+
+void _TreeMapTransplant(TreeMapData *pData, TreeNode *pOld, TreeNode *pNew)
+{
+    TreeNode *pParent = pOld->pParent;
+    if (pParent == pData->pNull_)
+        pData->pRoot_ = pNew;
+    else if (pOld == pParent->pLeft)
+        pParent->pLeft = pNew;
+    else
+        pParent->pRight = pNew;
+    if (pNew != pData->pNull_)
+        pNew->pParent = pParent;
     return;
 }
 
-void _TreeMapInsertFixup(TreeMapData *pData, TreeNode *pCurr)
+bool _TreeMapInsertFixup(TreeMapData *pData, TreeNode *pCurr)
 {
     TreeNode *pUncle;
 
@@ -806,6 +1853,7 @@ void _TreeMapInsertFixup(TreeMapData *pData, TreeNode *pCurr)
              *     B   C              B   C
              */
             if (pUncle->bColor == COLOR_RED) {
+                pUncle = _TreeMapOwn(pData, pUncle);
                 pCurr->pParent->bColor = COLOR_BLACK;
                 pUncle->bColor = COLOR_BLACK;
                 pCurr->pParent->pParent->bColor = COLOR_RED;
@@ -858,6 +1906,7 @@ void _TreeMapInsertFixup(TreeMapData *pData, TreeNode *pCurr)
 
             /* Case 1: The color of x's uncle is also red. */
             if (pUncle->bColor == COLOR_RED) {
+                pUncle = _TreeMapOwn(pData, pUncle);
                 pCurr->pParent->bColor = COLOR_BLACK;
                 pUncle->bColor = COLOR_BLACK;
                 pCurr->pParent->pParent->bColor = COLOR_RED;
@@ -878,19 +1927,21 @@ void _TreeMapInsertFixup(TreeMapData *pData, TreeNode *pCurr)
         }
     }
 
+    bool bGrow = pData->pRoot_->bColor == COLOR_RED;
     pData->pRoot_->bColor = COLOR_BLACK;
-    return;
+    return bGrow;
 }
 
-void _TreeMapDeleteFixup(TreeMapData *pData, TreeNode *pCurr)
+void _TreeMapDeleteFixup(TreeMapData *pData, TreeNode *pCurr,
+                         TreeNode *pParent)
 {
     TreeNode *pBrother;
 
     /* Denote the current node as x. */
     while ((pCurr != pData->pRoot_) && (pCurr->bColor == COLOR_BLACK)) {
         /* x is its parent's left child. */
-        if (pCurr == pCurr->pParent->pLeft) {
-            pBrother = pCurr->pParent->pRight;
+        if (pCurr == pParent->pLeft) {
+            pBrother = _TreeMapOwn(pData, pParent->pRight);
             /**
              * Case 1: The color of x's brother is red.
              * Set the color of x's brother to black.
@@ -907,9 +1958,9 @@ void _TreeMapDeleteFixup(TreeMapData *pData, TreeNode *pCurr)
              */
             if (pBrother->bColor == COLOR_RED) {
                 pBrother->bColor = COLOR_BLACK;
-                pCurr->pParent->bColor = COLOR_RED;
-                _TreeMapLeftRotate(pData, pCurr->pParent);
-                pBrother = pCurr->pParent->pRight;
+                pParent->bColor = COLOR_RED;
+                _TreeMapLeftRotate(pData, pParent);
+                pBrother = _TreeMapOwn(pData, pParent->pRight);
             }
             /**
              * Case 2: The color of x's brother is black, and both of its
@@ -926,7 +1977,8 @@ void _TreeMapDeleteFixup(TreeMapData *pData, TreeNode *pCurr)
             if ((pBrother->pLeft->bColor == COLOR_BLACK) &&
                 (pBrother->pRight->bColor == COLOR_BLACK)) {
                 pBrother->bColor = COLOR_RED;
-                pCurr = pCurr->pParent;
+                pCurr = pParent;
+                pParent = pCurr->pParent;
             } else {
                 /**
                  * Case 3: The color of x's brother is black, and the colors of
@@ -945,10 +1997,11 @@ void _TreeMapDeleteFixup(TreeMapData *pData, TreeNode *pCurr)
                  *          C   D                    D   z(B)
                  */
                 if (pBrother->pRight->bColor == COLOR_BLACK) {
+                    _TreeMapOwn(pData, pBrother->pLeft);
                     pBrother->pLeft->bColor = COLOR_BLACK;
                     pBrother->bColor = COLOR_RED;
                     _TreeMapRightRotate(pData, pBrother);
-                    pBrother = pCurr->pParent->pRight;
+                    pBrother = _TreeMapOwn(pData, pParent->pRight);
                 }
                 /**
                  * Case 4: The color of x's brother is black, and its right child
@@ -967,59 +2020,340 @@ void _TreeMapDeleteFixup(TreeMapData *pData, TreeNode *pCurr)
                  *                    / \
                  *                   A   B
                  */
-                pBrother->bColor = pCurr->pParent->bColor;
-                pCurr->pParent->bColor = COLOR_BLACK;
+                pBrother->bColor = pParent->bColor;
+                pParent->bColor = COLOR_BLACK;
+                _TreeMapOwn(pData, pBrother->pRight);
                 pBrother->pRight->bColor = COLOR_BLACK;
-                _TreeMapLeftRotate(pData, pCurr->pParent);
+                _TreeMapLeftRotate(pData, pParent);
                 pCurr = pData->pRoot_;
             }
         }
         /* x is its parent's right child */
         else {
-            pBrother = pCurr->pParent->pLeft;
+            pBrother = _TreeMapOwn(pData, pParent->pLeft);
             /* Case 1: The color of x's brother is red. */
             if (pBrother->bColor == COLOR_RED) {
                 pBrother->bColor = COLOR_BLACK;
-                pCurr->pParent->bColor = COLOR_RED;
-                _TreeMapRightRotate(pData, pCurr->pParent);
-                pBrother = pCurr->pParent->pLeft;
+                pParent->bColor = COLOR_RED;
+                _TreeMapRightRotate(pData, pParent);
+                pBrother = _TreeMapOwn(pData, pParent->pLeft);
             }
             /* Case 2: The color of x's brother is black, and both of its
                children are also black. */
             if ((pBrother->pLeft->bColor == COLOR_BLACK) &&
                 (pBrother->pRight->bColor == COLOR_BLACK)) {
                 pBrother->bColor = COLOR_RED;
-                pCurr = pCurr->pParent;
+                pCurr = pParent;
+                pParent = pCurr->pParent;
             } else {
                 /* Case 3: The color of x's brother is black and the colors of its
                    right and left child are red and black respectively. */
                 if (pBrother->pLeft->bColor == COLOR_BLACK) {
+                    _TreeMapOwn(pData, pBrother->pRight);
                     pBrother->pRight->bColor = COLOR_BLACK;
                     pBrother->bColor = COLOR_RED;
                     _TreeMapLeftRotate(pData, pBrother);
-                    pBrother = pCurr->pParent->pLeft;
+                    pBrother = _TreeMapOwn(pData, pParent->pLeft);
                 }
                 /* Case 4: The color of x's brother is black, and its left child
                    is red. */
-                pBrother->bColor = pCurr->pParent->bColor;
-                pCurr->pParent->bColor = COLOR_BLACK;
+                pBrother->bColor = pParent->bColor;
+                pParent->bColor = COLOR_BLACK;
+                _TreeMapOwn(pData, pBrother->pLeft);
                 pBrother->pLeft->bColor = COLOR_BLACK;
-                _TreeMapRightRotate(pData, pCurr->pParent);
+                _TreeMapRightRotate(pData, pParent);
                 pCurr = pData->pRoot_;
             }
         }
     }
 
-    pCurr->bColor = COLOR_BLACK;
+    if (pCurr != pData->pNull_)
+        pCurr->bColor = COLOR_BLACK;
+    return;
+}
+
+void _TreeMapUnlink(TreeMapData *pData, TreeNode *pCurr)
+{
+    /* The child replaces the spliced node. Its parent is tracked separately
+       because the child may be the shared dummy node. */
+    TreeNode *pNull = pData->pNull_;
+    TreeNode *pChild, *pParent;
+    bool bColor = pCurr->bColor;
+    if (pCurr->pLeft == pNull) {
+        pChild = pCurr->pRight;
+        pParent = pCurr->pParent;
+        _TreeMapTransplant(pData, pCurr, pChild);
+    } else if (pCurr->pRight == pNull) {
+        pChild = pCurr->pLeft;
+        pParent = pCurr->pParent;
+        _TreeMapTransplant(pData, pCurr, pChild);
+    } else {
+        /* The successor without the left child takes over the position. */
+        TreeNode *pSucc = _TreeMapMinimal(pNull, pCurr->pRight);
+        bColor = pSucc->bColor;
+        pChild = pSucc->pRight;
+        if (pSucc->pParent == pCurr)
+            pParent = pSucc;
+        else {
+            pParent = pSucc->pParent;
+            _TreeMapTransplant(pData, pSucc, pChild);
+            pSucc->pRight = pCurr->pRight;
+            pSucc->pRight->pParent = pSucc;
+        }
+        _TreeMapTransplant(pData, pCurr, pSucc);
+        pSucc->pLeft = pCurr->pLeft;
+        pSucc->pLeft->pParent = pSucc;
+        pSucc->bColor = pCurr->bColor;
+    }
+
+    /* Only the nodes above the child change their subtree counts, and each of
+       them has the other child untouched. */
+    if (pData->bOrder_ || pData->pAugment_) {
+        TreeNode *pAnces = pParent;
+        while (pAnces != pNull) {
+            if (pData->bOrder_)
+                pAnces->iCount = pAnces->pLeft->iCount +
+                                 pAnces->pRight->iCount + 1;
+            if (pData->pAugment_)
+                pData->pAugment_(pAnces);
+            pAnces = pAnces->pParent;
+        }
+    }
+
+    /* Maintain the balanced tree structure. */
+    if (bColor == COLOR_BLACK)
+        _TreeMapDeleteFixup(pData, pChild, pParent);
     return;
 }
 
+TreeNode* _TreeMapJoin(TreeMapData *pData, TreeNode *pLeft, int32_t iLeft,
+                       TreeNode *pMid, TreeNode *pRight, int32_t iRight,
+                       int32_t *piHeight)
+{
+    /* The subtree roots are painted black, which keeps them valid trees. */
+    TreeNode *pNull = pData->pNull_;
+    if (pLeft != pNull) {
+        pLeft->pParent = pNull;
+        pLeft->bColor = COLOR_BLACK;
+    }
+    if (pRight != pNull) {
+        pRight->pParent = pNull;
+        pRight->bColor = COLOR_BLACK;
+    }
+
+    pMid->pParent = pNull;
+    if (iLeft == iRight) {
+        pMid->bColor = COLOR_BLACK;
+        pMid->pLeft = pLeft;
+        pMid->pRight = pRight;
+        if (pLeft != pNull)
+            pLeft->pParent = pMid;
+        if (pRight != pNull)
+            pRight->pParent = pMid;
+        pMid->iCount = pLeft->iCount + pRight->iCount + 1;
+        *piHeight = iLeft + 1;
+        return pMid;
+    }
+
+    /* Descend the spine of the higher subtree to the black node with the black
+       height of the lower subtree, and let the red middle node take over that
+       position. */
+    TreeNode *pParent = pNull, *pCurr;
+    *piHeight = (iLeft > iRight)? iLeft : iRight;
+    if (iLeft > iRight) {
+        pCurr = pLeft;
+        while ((pCurr->bColor != COLOR_BLACK) || (iLeft != iRight)) {
+            if (pCurr->bColor == COLOR_BLACK)
+                iLeft--;
+            pParent = pCurr;
+            pCurr = pCurr->pRight;
+        }
+        pParent->pRight = pMid;
+        pMid->pLeft = pCurr;
+        pMid->pRight = pRight;
+        if (pRight != pNull)
+            pRight->pParent = pMid;
+        pData->pRoot_ = pLeft;
+    } else {
+        pCurr = pRight;
+        while ((pCurr->bColor != COLOR_BLACK) || (iLeft != iRight)) {
+            if (pCurr->bColor == COLOR_BLACK)
+                iRight--;
+            pParent = pCurr;
+            pCurr = pCurr->pLeft;
+        }
+        pParent->pLeft = pMid;
+        pMid->pRight = pCurr;
+        pMid->pLeft = pLeft;
+        if (pLeft != pNull)
+            pLeft->pParent = pMid;
+        pData->pRoot_ = pRight;
+    }
+    if (pCurr != pNull)
+        pCurr->pParent = pMid;
+    pMid->pParent = pParent;
+    pMid->bColor = COLOR_RED;
+
+    if (pData->bOrder_) {
+        TreeNode *pAnces = pMid;
+        while (pAnces != pNull) {
+            pAnces->iCount = pAnces->pLeft->iCount + pAnces->pRight->iCount + 1;
+            pAnces = pAnces->pParent;
+        }
+    }
+
+    /* The black height grows only if the fixup paints a red root black. */
+    if (_TreeMapInsertFixup(pData, pMid))
+        (*piHeight)++;
+    return pData->pRoot_;
+}
+
+TreeNode* _TreeMapSplit(TreeMapData *pData, TreeNode *pRoot, int32_t iHeight,
+                        Key key, TreeNode **ppLeft, int32_t *piLeft,
+                        TreeNode **ppRight, int32_t *piRight)
+{
+    TreeNode *pNull = pData->pNull_;
+    if (pRoot == pNull) {
+        *ppLeft = pNull;
+        *ppRight = pNull;
+        *piLeft = 0;
+        *piRight = 0;
+        return pNull;
+    }
+
+    /* Detach the root from its children, then split the child on the side of
+       the key and join the root back with the other part. Each child has one
+       black node less than the root on its paths, plus one if it is red and
+       gets painted black. */
+    TreeNode *pLeft = pRoot->pLeft;
+    TreeNode *pRight = pRoot->pRight;
+    int32_t iLeft = iHeight - 1 + ((pLeft->bColor == COLOR_RED)? 1 : 0);
+    int32_t iRight = iHeight - 1 + ((pRight->bColor == COLOR_RED)? 1 : 0);
+    pRoot->pLeft = pNull;
+    pRoot->pRight = pNull;
+
+    TreeNode *pFind, *pPart;
+    int32_t iPart;
+    int32_t iOrder = pData->pCompare_(key, pRoot->pPair->key);
+    if (iOrder == 0) {
+        *ppLeft = pLeft;
+        *ppRight = pRight;
+        *piLeft = iLeft;
+        *piRight = iRight;
+        pFind = pRoot;
+    } else if (iOrder < 0) {
+        pFind = _TreeMapSplit(pData, pLeft, iLeft, key, ppLeft, piLeft, &pPart,
+                              &iPart);
+        *ppRight = _TreeMapJoin(pData, pPart, iPart, pRoot, pRight, iRight,
+                                piRight);
+    } else {
+        pFind = _TreeMapSplit(pData, pRight, iRight, key, &pPart, &iPart,
+                              ppRight, piRight);
+        *ppLeft = _TreeMapJoin(pData, pLeft, iLeft, pRoot, pPart, iPart,
+                               piLeft);
+    }
+
+    /* The detached children may be red, while the painted roots keep both
+       parts valid trees. */
+    if (*ppLeft != pNull) {
+        (*ppLeft)->pParent = pNull;
+        (*ppLeft)->bColor = COLOR_BLACK;
+    }
+    if (*ppRight != pNull) {
+        (*ppRight)->pParent = pNull;
+        (*ppRight)->bColor = COLOR_BLACK;
+    }
+    return pFind;
+}
+
+TreeNode* _TreeMapUnion(TreeMapData *pData, TreeNode *pFst, int32_t iFst,
+                        TreeNode *pSnd, int32_t iSnd, int32_t *pDup,
+                        int32_t *piHeight)
+{
+    TreeNode *pNull = pData->pNull_;
+    if (pSnd == pNull) {
+        *piHeight = iFst;
+        return pFst;
+    }
+    if (pFst == pNull) {
+        pSnd->bColor = COLOR_BLACK;
+        *piHeight = iSnd;
+        return pSnd;
+    }
+
+    TreeNode *pLeft = pSnd->pLeft;
+    TreeNode *pRight = pSnd->pRight;
+    int32_t iLeft = iSnd - 1 + ((pLeft->bColor == COLOR_RED)? 1 : 0);
+    int32_t iRight = iSnd - 1 + ((pRight->bColor == COLOR_RED)? 1 : 0);
+    if (pLeft != pNull)
+        pLeft->pParent = pNull;
+    if (pRight != pNull)
+        pRight->pParent = pNull;
+    pSnd->pLeft = pNull;
+    pSnd->pRight = pNull;
+
+    TreeNode *pFstLeft, *pFstRight;
+    int32_t iFstLeft, iFstRight;
+    TreeNode *pFind = _TreeMapSplit(pData, pFst, iFst, pSnd->pPair->key,
+                                    &pFstLeft, &iFstLeft, &pFstRight,
+                                    &iFstRight);
+    if (pFind != pNull) {
+        if (pData->pDestroy_)
+            pData->pDestroy_(pFind->pPair);
+        _TreeMapFreeNode(pData, pFind);
+        (*pDup)++;
+    }
+
+    pLeft = _TreeMapUnion(pData, pFstLeft, iFstLeft, pLeft, iLeft, pDup,
+                          &iLeft);
+    pRight = _TreeMapUnion(pData, pFstRight, iFstRight, pRight, iRight, pDup,
+                           &iRight);
+    return _TreeMapJoin(pData, pLeft, iLeft, pSnd, pRight, iRight, piHeight);
+}
+
+int32_t _TreeMapBlackHeight(TreeNode *pNull, TreeNode *pCurr)
+{
+    int32_t iHeight = 0;
+    while (pCurr != pNull) {
+        if (pCurr->bColor == COLOR_BLACK)
+            iHeight++;
+        pCurr = pCurr->pLeft;
+    }
+    return iHeight;
+}
+
+int32_t _TreeMapSharePool(TreeMapData *pDst, TreeMapData *pSrc)
+{
+    if (pSrc->iPool_ == 0)
+        return SUCC;
+
+    TreePool **aPool = (TreePool**)realloc(pDst->aPool_,
+                       sizeof(TreePool*) * (pDst->iPool_ + pSrc->iPool_));
+    if (!aPool)
+        return ERR_NOMEM;
+    pDst->aPool_ = aPool;
+
+    int32_t iSrc, iDst, iSize = pDst->iPool_;
+    for (iSrc = 0 ; iSrc < pSrc->iPool_ ; iSrc++) {
+        TreePool *pPool = pSrc->aPool_[iSrc];
+        for (iDst = 0 ; iDst < iSize ; iDst++) {
+            if (aPool[iDst] == pPool)
+                break;
+        }
+        if (iDst < iSize)
+            continue;
+        pPool->iRef++;
+        aPool[pDst->iPool_++] = pPool;
+    }
+    return SUCC;
+}
+
 TreeNode* _TreeMapSearch(TreeMapData *pData, Key key)
 {
     int32_t iOrder;
     TreeNode *pCurr = pData->pRoot_;
     while(pCurr != pData->pNull_) {
-        iOrder = pData->pCompare_(key, pCurr->pPair->key);
+        iOrder = ORDER(pData, key, pCurr->pPair->key);
         if (iOrder == 0)
             break;
         else {
@@ -1032,9 +2366,67 @@ TreeNode* _TreeMapSearch(TreeMapData *pData, Key key)
     return pCurr;
 }
 
+TreeNode* _TreeMapBound(TreeMapData *pData, Key key, bool bUpper)
+{
+    /* Keep the last node whose key satisfies the bound while descending. */
+    int32_t iLimit = (bUpper)? 1 : 0;
+    TreeNode *pFind = pData->pNull_;
+    TreeNode *pCurr = pData->pRoot_;
+    while (pCurr != pData->pNull_) {
+        if (ORDER(pData, pCurr->pPair->key, key) < iLimit)
+            pCurr = pCurr->pRight;
+        else {
+            pFind = pCurr;
+            pCurr = pCurr->pLeft;
+        }
+    }
+    return pFind;
+}
+
+int32_t _TreeMapRank(TreeMapData *pData, Key key)
+{
+    TreeNode *pNull = pData->pNull_;
+    int32_t iRank = 0;
+    if (pData->bOrder_) {
+        TreeNode *pCurr = pData->pRoot_;
+        while (pCurr != pNull) {
+            if (pData->pCompare_(pCurr->pPair->key, key) < 0) {
+                iRank += pCurr->pLeft->iCount + 1;
+                pCurr = pCurr->pRight;
+            } else
+                pCurr = pCurr->pLeft;
+        }
+    } else {
+        TreeNode *pCurr = _TreeMapMinimal(pNull, pData->pRoot_);
+        while ((pCurr != pNull) &&
+               (pData->pCompare_(pCurr->pPair->key, key) < 0)) {
+            iRank++;
+            pCurr = _TreeMapSuccessor(pNull, pCurr);
+        }
+    }
+    return iRank;
+}
+
+int32_t _TreeMapRecount(TreeNode *pNull, TreeNode *pCurr)
+{
+    /* The recursion depth is bounded by the tree height. */
+    if (pCurr == pNull)
+        return 0;
+    pCurr->iCount = _TreeMapRecount(pNull, pCurr->pLeft) +
+                    _TreeMapRecount(pNull, pCurr->pRight) + 1;
+    return pCurr->iCount;
+}
+
 int32_t _TreeMapCompare(Key keySrc, Key keyTge)
 {
     if (keySrc == keyTge)
         return 0;
     return (keySrc > keyTge)? 1 : (-1);
 }
+
+int32_t _TreeMapCompareInteger(Key keySrc, Key keyTge)
+{
+    if ((intptr_t)keySrc == (intptr_t)keyTge)
+        return 0;
+    return ((intptr_t)keySrc > (intptr_t)keyTge)? 1 : (-1);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file tree_map_internal.h The red black tree core shared by the tree based
+ * containers.
+ */
+
+#ifndef _TREE_MAP_INTERNAL_H_
+#define _TREE_MAP_INTERNAL_H_
+
+#include "container/tree_map.h"
+#include <stddef.h>
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+/* The inline pair stays the last member, since the nodes referring to the
+   caller pairs are allocated without it. */
+typedef struct _TreeNode {
+    bool bColor;
+    bool bBlock;
+    int32_t iCount;
+    int32_t iRef;
+    Pair *pPair;
+    struct _TreeNode *pParent;
+    struct _TreeNode *pLeft;
+    struct _TreeNode *pRight;
+    Pair pair;
+} TreeNode;
+
+/* The nodes created by the bulk build share one allocation, laid out with
+   the node size of the pair mode. Since the nodes can move between maps, the
+   pool is released after all the maps which may hold its nodes drop their
+   references. */
+typedef struct _TreePool {
+    int32_t iRef;
+    TreeNode aNode[];
+} TreePool;
+
+struct _TreeMapData {
+    bool bOrder_;
+    int32_t iMode_;
+    int32_t iSize_;
+    TreeNode *pRoot_;
+    TreeNode *pNull_;
+    TreeNode *pIter_;
+    TreeNode *pRange_;
+    TreeNode *pFree_;
+    TreeNode *pSpare_;
+    int32_t iSpare_;
+    TreePool **aPool_;
+    int32_t iPool_;
+    TreeMapSnapshot *pSnap_;
+    Key keyEnd_;
+    int32_t (*pCompare_) (Key, Key);
+    void (*pDestroy_) (Pair*);
+    /* The hook recomputing the augmented field of a node from its children,
+       which is run by the rotations and the deletion for the containers
+       built on the core. */
+    void (*pAugment_) (TreeNode*);
+};
+
+#define DIRECT_LEFT      (0)
+#define DIRECT_RIGHT     (1)
+
+#define COLOR_RED        (0)
+#define COLOR_BLACK      (1)
+
+
+/*===========================================================================*
+ *                Definition for the red black tree core                     *
+ *===========================================================================*/
+/**
+ * @brief Return the node having the maximal order in the subtree rooted by the
+ * designated node. The node order is determined by its stored key.
+ *
+ * @param pCurr         The pointer to the designated node
+ *
+ * @return              The pointer to the returned node or NULL
+ */
+TreeNode* _TreeMapMaximal(TreeNode *pNull, TreeNode *pCurr);
+
+/**
+ * @brief Return the node having the minimal order in the subtree rooted by the
+ * designated node. The node order is determined by its stored key.
+ *
+ * @param pCurr         The pointer to the designated node
+ *
+ * @return              The pointer to the returned node or NULL
+ */
+TreeNode* _TreeMapMinimal(TreeNode *pNull, TreeNode *pCurr);
+
+/**
+ * @brief Return the immediate successor of the designated node.
+ *
+ * @param pCurr         The pointer to the designated node
+ *
+ * @return              The pointer to the returned node or NULL
+ */
+TreeNode* _TreeMapSuccessor(TreeNode *pNull, TreeNode *pCurr);
+
+/**
+ * @brief Return the immediate predecessor of the designated node.
+ *
+ * @param pCurr         The pointer to the designated node
+ *
+ * @return              The pointer to the returned node or NULL
+ */
+TreeNode* _TreeMapPredecessor(TreeNode *pNull, TreeNode *pCurr);
+
+/**
+ * @brief Make right rotation for the subtree rooted by the designated node.
+ *
+ * After rotation, the designated node will be the right child of its original
+ * left child. The augmentation hook refreshes both rotated nodes.
+ *
+ * @param pData         The pointer to the tree private data
+ * @param pCurr         The pointer to the designated node
+ */
+void _TreeMapRightRotate(TreeMapData *pData, TreeNode *pCurr);
+
+/**
+ * @brief Make left rotation for the subtree rooted by the designated node.
+ *
+ * After rotation, the designated node will be the left child of its original
+ * right child. The augmentation hook refreshes both rotated nodes.
+ *
+ * @param pData         The pointer to the tree private data
+ * @param pCurr         The pointer to the designated node
+ */
+void _TreeMapLeftRotate(TreeMapData *pData, TreeNode *pCurr);
+
+/**
+ * @brief Replace the designated subtree with another one in the view of the
+ * parent of the designated subtree.
+ *
+ * @param pData         The pointer to the map private data
+ * @param pOld          The pointer to the root of the replaced subtree
+ * @param pNew          The pointer to the root of the replacing subtree
+ */
+void _TreeMapTransplant(TreeMapData *pData, TreeNode *pOld, TreeNode *pNew);
+
+/**
+ * @brief Maintain the red black tree property after node insertion.
+ *
+ * @param pData         The pointer to the tree private data
+ * @param pCurr         The pointer to the designated node
+ *
+ * @retval true         The red root is painted black, which raises the black
+ *                      height of the tree by one
+ * @retval false        Otherwise
+ */
+bool _TreeMapInsertFixup(TreeMapData *pData, TreeNode *pCurr);
+
+/**
+ * @brief Maintain the red black tree property after node deletion.
+ *
+ * The parent is passed explicitly because the designated node may be the
+ * shared dummy node.
+ *
+ * @param pData         The pointer to the tree private data
+ * @param pCurr         The pointer to the designated node
+ * @param pParent       The pointer to the parent of the designated node
+ */
+void _TreeMapDeleteFixup(TreeMapData *pData, TreeNode *pCurr,
+                         TreeNode *pParent);
+
+/**
+ * @brief Unlink the designated node from the tree and rebalance the tree.
+ *
+ * No other pair is moved between nodes, so that the cursors staying on other
+ * nodes remain valid. The node itself and the map size are left untouched. The
+ * augmentation hook refreshes the ancestors of the spliced position.
+ *
+ * @param pData         The pointer to the tree private data
+ * @param pCurr         The pointer to the designated node
+ */
+void _TreeMapUnlink(TreeMapData *pData, TreeNode *pCurr);
+
+#endif
@@ -13,10 +13,24 @@ typedef struct TrieNode_ {
     struct TrieNode_ *pParent_;
 } TrieNode;
 
+typedef struct RadixNode_ {
+    int64_t lLabel_;
+    int32_t iLenLabel_;
+    bool bEndStr_;
+    struct RadixNode_ *pChild_;
+    struct RadixNode_ *pSibling_;
+} RadixNode;
+
 struct TrieData_ {
     int32_t iSize_;
     int32_t iCountNode_;
+    int32_t iMode_;
     TrieNode *pRoot_;
+    RadixNode *pRadix_;
+    char *szLabel_;
+    int64_t lSizeLabel_;
+    int64_t lCapLabel_;
+    int64_t lLiveLabel_;
 };
 
 typedef struct StackFrame_ {
@@ -25,6 +39,11 @@ typedef struct StackFrame_ {
     TrieNode *pTrieNode_;
 } StackFrame;
 
+typedef struct RadixFrame_ {
+    int32_t iDepth_;
+    RadixNode *pNode_;
+} RadixFrame;
+
 
 /*===========================================================================*
  *                  Definition for internal operations                       *
@@ -36,11 +55,116 @@ typedef struct StackFrame_ {
  */
 void _TrieDeinit(TrieData *pData);
 
+/**
+ * @brief Release all the radix nodes and the label arena.
+ *
+ * @param pData         The pointer to the trie private data
+ */
+void _TrieRadixDeinit(TrieData *pData);
+
+/**
+ * @brief Extend the label arena for the designated number of characters.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param iLen          The number of characters to be appended
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for arena extension
+ */
+int32_t _TrieRadixReserve(TrieData *pData, int32_t iLen);
+
+/**
+ * @brief Append the characters to the label arena.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param str           The characters to append
+ * @param iLen          The number of characters
+ * @param plLabel       The pointer to the returned arena offset
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for arena extension
+ */
+int32_t _TrieRadixAppend(TrieData *pData, char *str, int32_t iLen,
+                         int64_t *plLabel);
+
+/**
+ * @brief Walk down the radix trie along the longest prefix of the string.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param pStr          The pointer to the string, which is advanced past the
+ *                      matched characters
+ * @param piMatch       The pointer to the returned number of the matched
+ *                      characters in the label of the returned node
+ *
+ * @return              The last node touched by the walk
+ */
+RadixNode* _TrieRadixMatch(TrieData *pData, char **pStr, int32_t *piMatch);
+
+/**
+ * @brief Insert a string into the radix trie.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param str           The designated non-empty string
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for trie extension
+ */
+int32_t _TrieRadixInsert(TrieData *pData, char *str);
+
+/**
+ * @brief Retrieve the strings from the radix trie matching the prefix.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param str           The designated non-empty prefix
+ * @param paStr         The pointer to the returned array of strings
+ * @param piNum         The pointer to the returned array size
+ *
+ * @retval SUCC
+ * @retval NOKEY
+ * @retval ERR_NOMEM    Insufficient memory to store the resolved strings
+ */
+int32_t _TrieRadixGetPrefixAs(TrieData *pData, char *str, char ***paStr,
+                              int *piNum);
+
+/**
+ * @brief Remove a string from the radix trie and compress the touched path.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param str           The designated non-empty string
+ *
+ * @retval SUCC
+ * @retval NOKEY
+ */
+int32_t _TrieRadixRemove(TrieData *pData, char *str);
+
+/**
+ * @brief Merge the radix node with its only child.
+ *
+ * @param pData         The pointer to the trie private data
+ * @param pNode         The pointer to the merged node
+ */
+void _TrieRadixMerge(TrieData *pData, RadixNode *pNode);
+
+/**
+ * @brief Re-pack the labels of all the radix nodes into a new arena, which
+ * drops the characters left by the removed and the merged nodes.
+ *
+ * The old arena is kept if the new one cannot be allocated.
+ *
+ * @param pData         The pointer to the trie private data
+ */
+void _TrieRadixCompact(TrieData *pData);
+
 
 #define DIRECT_LEFT             (0)
 #define DIRECT_MIDDLE           (1)
 #define DIRECT_RIGHT            (2)
 
+#define SIZE_LABEL_INIT         (64)
+#define SIZE_FRAME_INIT         (16)
+
+#define RADIX_LABEL(_data, _node)   ((_data)->szLabel_ + (_node)->lLabel_)
+
 #define CHECK_INIT(self)                                                        \
             do {                                                                \
                 if (!self)                                                      \
@@ -49,10 +173,16 @@ void _TrieDeinit(TrieData *pData);
                     return ERR_NOINIT;                                          \
             } while (0);
 
+/* A traversal step pushes at most 4 frames, which also bounds the estimation
+   from below so that the doubled capacity never stays at zero. */
+#define SIZE_MIN_STORAGE    (4)
+
 #define ESTIMATE_STORAGE_SIZE(_size_blk, _size_trie, _cap_trie)                 \
             do {                                                                \
                 _size_blk = ((_size_trie << 2) >= _cap_trie)?                   \
                              (_size_trie >> 2) : (_cap_trie >> 3);              \
+                if (_size_blk < SIZE_MIN_STORAGE)                               \
+                    _size_blk = SIZE_MIN_STORAGE;                               \
             } while (0);
 
 #define LONGEST_PREFIX_MATCH(_str, _node_pred, _node_curr)                      \
@@ -176,7 +306,11 @@ int32_t TrieInit(Trie **ppObj)
 
     TrieData *pData = pObj->pData;
     pData->iSize_ = pData->iCountNode_ = 0;
+    pData->iMode_ = TRIE_MODE_TERNARY;
     pData->pRoot_ = NULL;
+    pData->pRadix_ = NULL;
+    pData->szLabel_ = NULL;
+    pData->lSizeLabel_ = pData->lCapLabel_ = pData->lLiveLabel_ = 0;
 
     pObj->insert = TrieInsert;
     pObj->bulk_insert = TrieBulkInsert;
@@ -185,6 +319,8 @@ int32_t TrieInit(Trie **ppObj)
     pObj->get_prefix_as = TrieGetPrefixAs;
     pObj->remove = TrieRemove;
     pObj->size = TrieSize;
+    pObj->set_mode = TrieSetMode;
+    pObj->get_stat = TrieGetStat;
 
     return SUCC;
 }
@@ -199,6 +335,7 @@ void TrieDeinit(Trie **ppObj)
         goto FREE_TRIE;
 
     TrieData *pData = pObj->pData;
+    _TrieRadixDeinit(pData);
     if (!(pData->pRoot_))
         goto FREE_DATA;
 
@@ -220,8 +357,11 @@ int32_t TrieInsert(Trie *self, char *str)
     if (*str == 0)
         return SUCC;
 
-    int32_t iRtn = SUCC;
     TrieData *pData = self->pData;
+    if (pData->iMode_ == TRIE_MODE_RADIX)
+        return _TrieRadixInsert(pData, str);
+
+    int32_t iRtn = SUCC;
     TrieNode *pCurr = pData->pRoot_;
     TrieNode *pPred = NULL;
     char cDirect;
@@ -277,6 +417,13 @@ int32_t TrieBulkInsert(Trie *self, char **aStr, int iNum)
         if (*str == 0)
             continue;
 
+        if (pData->iMode_ == TRIE_MODE_RADIX) {
+            iRtn = _TrieRadixInsert(pData, str);
+            if (iRtn != SUCC)
+                goto EXIT;
+            continue;
+        }
+
         TrieNode *pCurr = pData->pRoot_;
         TrieNode *pPred = NULL;
         char cDirect;
@@ -329,6 +476,13 @@ int32_t TrieHasExact(Trie *self, char *str)
         return NOKEY;
 
     TrieData *pData = self->pData;
+    if (pData->iMode_ == TRIE_MODE_RADIX) {
+        int32_t iMatch;
+        RadixNode *pNode = _TrieRadixMatch(pData, &str, &iMatch);
+        return (*str == 0 && iMatch == pNode->iLenLabel_ && pNode->bEndStr_)?
+               SUCC : NOKEY;
+    }
+
     TrieNode *pCurr = pData->pRoot_;
     TrieNode *pPred = NULL;
     LONGEST_PREFIX_MATCH(str, pPred, pCurr);
@@ -346,6 +500,14 @@ int32_t TrieHasPrefixAs(Trie *self, char *str)
         return NOKEY;
 
     TrieData *pData = self->pData;
+    if (pData->iMode_ == TRIE_MODE_RADIX) {
+        /* Every radix leaf marks a string tail, so any node reached by the
+           whole prefix leads to a stored string. */
+        int32_t iMatch;
+        _TrieRadixMatch(pData, &str, &iMatch);
+        return (*str == 0)? SUCC : NOKEY;
+    }
+
     TrieNode *pCurr = pData->pRoot_;
     TrieNode *pPred = NULL;
     LONGEST_PREFIX_MATCH(str, pPred, pCurr);
@@ -376,7 +538,7 @@ int32_t TrieHasPrefixAs(Trie *self, char *str)
             break;
         }
 
-        if (iTop == iCap) {
+        if (iTop + 3 > iCap) {
             iCap <<= 1;
             REALLOC_BLOCK(stack, iCap, TrieNode*, iRtn, FREE_STACK);
         }
@@ -408,6 +570,9 @@ int32_t TrieGetPrefixAs(Trie *self, char* str, char ***paStr, int *piNum)
     if (*str == 0)
         return NOKEY;
 
+    if (self->pData->iMode_ == TRIE_MODE_RADIX)
+        return _TrieRadixGetPrefixAs(self->pData, str, paStr, piNum);
+
     /* Prepare the prefix path record which is extended or shrunk during trie
        traversal to represent a certain string stored in the trie. */
     int32_t iRtn;
@@ -478,7 +643,7 @@ int32_t TrieGetPrefixAs(Trie *self, char* str, char ***paStr, int *piNum)
             continue;
         }
 
-        if (iTop == iCapStack) {
+        if (iTop + 4 > iCapStack) {
             int32_t iCapStackNew = iCapStack << 1;
             REALLOC_BLOCK(stack, iCapStackNew, StackFrame, iRtn, FREE_STACK, \
                           FREE_BLOCK(*paStr, iSizeArr));
@@ -551,6 +716,9 @@ int32_t TrieRemove(Trie *self, char *str)
         return NOKEY;
 
     TrieData *pData = self->pData;
+    if (pData->iMode_ == TRIE_MODE_RADIX)
+        return _TrieRadixRemove(pData, str);
+
     TrieNode *pCurr = pData->pRoot_;
     TrieNode *pPred = NULL;
     LONGEST_PREFIX_MATCH(str, pPred, pCurr);
@@ -570,6 +738,57 @@ int32_t TrieSize(Trie *self)
     return self->pData->iSize_;
 }
 
+int32_t TrieSetMode(Trie *self, int32_t iMode)
+{
+    CHECK_INIT(self);
+
+    TrieData *pData = self->pData;
+    if ((iMode != TRIE_MODE_TERNARY) && (iMode != TRIE_MODE_RADIX))
+        return ERR_POLICY;
+    if (pData->iSize_ > 0)
+        return ERR_POLICY;
+
+    /* Drop the nodes left by the removed strings before the switch. */
+    int32_t iRtn = SUCC;
+    if (pData->pRoot_) {
+        _TrieDeinit(pData);
+        pData->pRoot_ = NULL;
+    }
+    _TrieRadixDeinit(pData);
+    pData->iCountNode_ = 0;
+
+    if (iMode == TRIE_MODE_RADIX) {
+        RadixNode *pRoot;
+        MALLOC_BLOCK(pRoot, 1, RadixNode, iRtn, EXIT);
+        pRoot->lLabel_ = 0;
+        pRoot->iLenLabel_ = 0;
+        pRoot->bEndStr_ = false;
+        pRoot->pChild_ = pRoot->pSibling_ = NULL;
+        pData->pRadix_ = pRoot;
+    }
+    pData->iMode_ = iMode;
+
+EXIT:
+    return iRtn;
+}
+
+int32_t TrieGetStat(Trie *self, TrieStat *pStat)
+{
+    CHECK_INIT(self);
+    if (!pStat)
+        return ERR_GET;
+
+    TrieData *pData = self->pData;
+    pStat->lCountNode = pData->iCountNode_;
+    if (pData->iMode_ == TRIE_MODE_RADIX) {
+        /* Count the root which carries no label. */
+        pStat->lCountByte = sizeof(RadixNode) * (pStat->lCountNode + 1) +
+                            pData->lCapLabel_;
+    } else
+        pStat->lCountByte = sizeof(TrieNode) * pStat->lCountNode;
+    return SUCC;
+}
+
 
 /*===========================================================================*
  *               Implementation for internal operations                      *
@@ -611,4 +830,371 @@ void _TrieDeinit(TrieData *pData)
 
     free(stack);
     return;
-}
\ No newline at end of file
+}
+void _TrieRadixDeinit(TrieData *pData)
+{
+    /* Splice the children ahead of the pending siblings so that the nodes are
+       released without an auxiliary stack. */
+    RadixNode *pList = pData->pRadix_;
+    while (pList) {
+        RadixNode *pCurr = pList;
+        pList = pCurr->pSibling_;
+        RadixNode *pChild = pCurr->pChild_;
+        if (pChild) {
+            RadixNode *pLast = pChild;
+            while (pLast->pSibling_)
+                pLast = pLast->pSibling_;
+            pLast->pSibling_ = pList;
+            pList = pChild;
+        }
+        free(pCurr);
+    }
+    pData->pRadix_ = NULL;
+
+    free(pData->szLabel_);
+    pData->szLabel_ = NULL;
+    pData->lSizeLabel_ = pData->lCapLabel_ = pData->lLiveLabel_ = 0;
+    return;
+}
+
+int32_t _TrieRadixReserve(TrieData *pData, int32_t iLen)
+{
+    int32_t iRtn = SUCC;
+    int64_t lCap = pData->lCapLabel_;
+    if (lCap == 0)
+        lCap = SIZE_LABEL_INIT;
+    while (pData->lSizeLabel_ + iLen > lCap)
+        lCap <<= 1;
+
+    if (lCap > pData->lCapLabel_) {
+        REALLOC_BLOCK(pData->szLabel_, lCap, char, iRtn, EXIT);
+        pData->lCapLabel_ = lCap;
+    }
+
+EXIT:
+    return iRtn;
+}
+
+int32_t _TrieRadixAppend(TrieData *pData, char *str, int32_t iLen,
+                         int64_t *plLabel)
+{
+    int32_t iRtn = _TrieRadixReserve(pData, iLen);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    memcpy(pData->szLabel_ + pData->lSizeLabel_, str, iLen);
+    *plLabel = pData->lSizeLabel_;
+    pData->lSizeLabel_ += iLen;
+    return SUCC;
+}
+
+RadixNode* _TrieRadixMatch(TrieData *pData, char **pStr, int32_t *piMatch)
+{
+    RadixNode *pCurr = pData->pRadix_;
+    char *str = *pStr;
+    int32_t iMatch = 0;
+
+    while (*str) {
+        /* The children are chained in the ascending order of the first
+           characters of their labels. */
+        RadixNode *pChild = pCurr->pChild_;
+        while (pChild && (RADIX_LABEL(pData, pChild)[0] < *str))
+            pChild = pChild->pSibling_;
+        if (!pChild || (RADIX_LABEL(pData, pChild)[0] != *str))
+            break;
+
+        char *szLabel = RADIX_LABEL(pData, pChild);
+        int32_t iLenLabel = pChild->iLenLabel_;
+        iMatch = 1;
+        ++str;
+        while ((iMatch < iLenLabel) && *str && (szLabel[iMatch] == *str)) {
+            ++iMatch;
+            ++str;
+        }
+
+        pCurr = pChild;
+        if (iMatch < iLenLabel)
+            break;
+    }
+
+    *pStr = str;
+    *piMatch = iMatch;
+    return pCurr;
+}
+
+int32_t _TrieRadixInsert(TrieData *pData, char *str)
+{
+    int32_t iRtn = SUCC;
+    RadixNode *pCurr = pData->pRadix_;
+
+    while (*str) {
+        RadixNode **ppLink = &(pCurr->pChild_);
+        while (*ppLink && (RADIX_LABEL(pData, *ppLink)[0] < *str))
+            ppLink = &((*ppLink)->pSibling_);
+
+        /* Hang the rest of the string as a new leaf. */
+        RadixNode *pChild = *ppLink;
+        if (!pChild || (RADIX_LABEL(pData, pChild)[0] != *str)) {
+            RadixNode *pNew;
+            MALLOC_BLOCK(pNew, 1, RadixNode, iRtn, EXIT);
+            int32_t iLen = strlen(str);
+            iRtn = _TrieRadixAppend(pData, str, iLen, &(pNew->lLabel_));
+            if (iRtn != SUCC) {
+                free(pNew);
+                goto EXIT;
+            }
+            pNew->iLenLabel_ = iLen;
+            pData->lLiveLabel_ += iLen;
+            pNew->bEndStr_ = true;
+            pNew->pChild_ = NULL;
+            pNew->pSibling_ = pChild;
+            *ppLink = pNew;
+            pData->iCountNode_++;
+            pData->iSize_++;
+            goto EXIT;
+        }
+
+        char *szLabel = RADIX_LABEL(pData, pChild);
+        int32_t iLenLabel = pChild->iLenLabel_;
+        int32_t iMatch = 1;
+        while ((iMatch < iLenLabel) && (szLabel[iMatch] == str[iMatch]))
+            ++iMatch;
+
+        /* Split the label, and the lower half still refers to the same arena
+           span, so no character is copied. */
+        if (iMatch < iLenLabel) {
+            RadixNode *pLower;
+            MALLOC_BLOCK(pLower, 1, RadixNode, iRtn, EXIT);
+            pLower->lLabel_ = pChild->lLabel_ + iMatch;
+            pLower->iLenLabel_ = iLenLabel - iMatch;
+            pLower->bEndStr_ = pChild->bEndStr_;
+            pLower->pChild_ = pChild->pChild_;
+            pLower->pSibling_ = NULL;
+            pChild->iLenLabel_ = iMatch;
+            pChild->bEndStr_ = false;
+            pChild->pChild_ = pLower;
+            pData->iCountNode_++;
+        }
+
+        str += iMatch;
+        pCurr = pChild;
+    }
+
+    if (!(pCurr->bEndStr_)) {
+        pCurr->bEndStr_ = true;
+        pData->iSize_++;
+    }
+
+EXIT:
+    return iRtn;
+}
+
+int32_t _TrieRadixGetPrefixAs(TrieData *pData, char *str, char ***paStr,
+                              int *piNum)
+{
+    char *szRest = str;
+    int32_t iMatch;
+    RadixNode *pHead = _TrieRadixMatch(pData, &szRest, &iMatch);
+    if (*szRest != 0)
+        return NOKEY;
+
+    /* The label of the head node overlaps the tail of the prefix. */
+    int32_t iRtn;
+    int32_t iLenPrefix = strlen(str);
+    int32_t iCapPrefix = iLenPrefix << 1;
+    char *szPrefix;
+    MALLOC_BLOCK(szPrefix, iCapPrefix, char, iRtn, EXIT);
+    memcpy(szPrefix, str, iLenPrefix);
+
+    int32_t iSizeArr = 0, iCapArr = SIZE_FRAME_INIT;
+    MALLOC_BLOCK(*paStr, iCapArr, char*, iRtn, FREE_PREFIX);
+
+    int32_t iTop = 0, iCapStack = SIZE_FRAME_INIT;
+    RadixFrame *stack;
+    MALLOC_BLOCK(stack, iCapStack, RadixFrame, iRtn, FREE_PREFIX, \
+                 FREE_BLOCK(*paStr, iSizeArr));
+    stack[iTop].iDepth_ = iLenPrefix - iMatch;
+    stack[iTop++].pNode_ = pHead;
+
+    /* Visit the nodes in preorder. The child is popped before the sibling, so
+       the strings are collected in the lexical order. */
+    while (iTop > 0) {
+        RadixFrame frame = stack[--iTop];
+        RadixNode *pCurr = frame.pNode_;
+        int32_t iDepth = frame.iDepth_ + pCurr->iLenLabel_;
+
+        if (iTop + 2 > iCapStack) {
+            int32_t iCapStackNew = iCapStack << 1;
+            REALLOC_BLOCK(stack, iCapStackNew, RadixFrame, iRtn, FREE_STACK, \
+                          FREE_BLOCK(*paStr, iSizeArr));
+            iCapStack = iCapStackNew;
+        }
+        if (iDepth > iCapPrefix) {
+            int32_t iCapPrefixNew = iCapPrefix;
+            while (iDepth > iCapPrefixNew)
+                iCapPrefixNew <<= 1;
+            REALLOC_BLOCK(szPrefix, iCapPrefixNew, char, iRtn, FREE_STACK, \
+                          FREE_BLOCK(*paStr, iSizeArr));
+            iCapPrefix = iCapPrefixNew;
+        }
+
+        if ((pCurr != pHead) && pCurr->pSibling_) {
+            stack[iTop].iDepth_ = frame.iDepth_;
+            stack[iTop++].pNode_ = pCurr->pSibling_;
+        }
+        if (pCurr->pChild_) {
+            stack[iTop].iDepth_ = iDepth;
+            stack[iTop++].pNode_ = pCurr->pChild_;
+        }
+
+        memcpy(szPrefix + frame.iDepth_, RADIX_LABEL(pData, pCurr),
+               pCurr->iLenLabel_);
+        if (pCurr->bEndStr_)
+            COLLECT_PREFIX(szPrefix, iDepth, paStr, iSizeArr, iCapArr, \
+                           iRtn, FREE_STACK);
+    }
+
+    /* Arrange the returned data. */
+    if (iSizeArr > 0) {
+        REALLOC_BLOCK(*paStr, iSizeArr, char*, iRtn, FREE_STACK, \
+                      FREE_BLOCK(*paStr, iSizeArr));
+        iRtn = SUCC;
+    } else {
+        free(*paStr);
+        *paStr = NULL;
+        iRtn = NOKEY;
+    }
+    *piNum = iSizeArr;
+
+FREE_STACK:
+    free(stack);
+FREE_PREFIX:
+    free(szPrefix);
+EXIT:
+    return iRtn;
+}
+
+int32_t _TrieRadixRemove(TrieData *pData, char *str)
+{
+    RadixNode *pRoot = pData->pRadix_;
+    RadixNode *pParent = NULL;
+    RadixNode *pCurr = pRoot;
+    RadixNode **ppLink = NULL;
+
+    while (*str) {
+        RadixNode **ppScan = &(pCurr->pChild_);
+        while (*ppScan && (RADIX_LABEL(pData, *ppScan)[0] < *str))
+            ppScan = &((*ppScan)->pSibling_);
+
+        RadixNode *pChild = *ppScan;
+        if (!pChild)
+            return NOKEY;
+        int32_t iLenLabel = pChild->iLenLabel_;
+        if (strncmp(str, RADIX_LABEL(pData, pChild), iLenLabel) != 0)
+            return NOKEY;
+
+        str += iLenLabel;
+        pParent = pCurr;
+        ppLink = ppScan;
+        pCurr = pChild;
+    }
+
+    if ((pCurr == pRoot) || !(pCurr->bEndStr_))
+        return NOKEY;
+    pCurr->bEndStr_ = false;
+    pData->iSize_--;
+
+    /* Prune the leaf, and then the node left with a single child and no string
+       tail is merged with that child. */
+    if (!(pCurr->pChild_)) {
+        *ppLink = pCurr->pSibling_;
+        pData->lLiveLabel_ -= pCurr->iLenLabel_;
+        free(pCurr);
+        pData->iCountNode_--;
+        pCurr = pParent;
+    }
+    if ((pCurr != pRoot) && !(pCurr->bEndStr_) && pCurr->pChild_ &&
+        !(pCurr->pChild_->pSibling_))
+        _TrieRadixMerge(pData, pCurr);
+
+    /* Re-pack the arena once the dead characters outweigh the live ones, so
+       the churn of the strings cannot grow it without bound. */
+    if (pData->lSizeLabel_ - pData->lLiveLabel_ > pData->lLiveLabel_)
+        _TrieRadixCompact(pData);
+
+    return SUCC;
+}
+
+void _TrieRadixMerge(TrieData *pData, RadixNode *pNode)
+{
+    RadixNode *pChild = pNode->pChild_;
+    int32_t iLenNode = pNode->iLenLabel_;
+    int32_t iLenChild = pChild->iLenLabel_;
+
+    /* The labels are adjacent if the child is the lower half of a split.
+       Otherwise, their concatenation is appended to the arena. If the arena
+       cannot grow, the uncompressed path still answers all the queries. */
+    if (pNode->lLabel_ + iLenNode != pChild->lLabel_) {
+        if (_TrieRadixReserve(pData, iLenNode + iLenChild) != SUCC)
+            return;
+        int64_t lLabel = pData->lSizeLabel_;
+        memcpy(pData->szLabel_ + lLabel, RADIX_LABEL(pData, pNode), iLenNode);
+        memcpy(pData->szLabel_ + lLabel + iLenNode, RADIX_LABEL(pData, pChild),
+               iLenChild);
+        pData->lSizeLabel_ += iLenNode + iLenChild;
+        pNode->lLabel_ = lLabel;
+    }
+
+    pNode->iLenLabel_ = iLenNode + iLenChild;
+    pNode->bEndStr_ = pChild->bEndStr_;
+    pNode->pChild_ = pChild->pChild_;
+    free(pChild);
+    pData->iCountNode_--;
+    return;
+}
+
+void _TrieRadixCompact(TrieData *pData)
+{
+    char *szLabel = NULL;
+    int64_t lCap = 0;
+    if (pData->lLiveLabel_ > 0) {
+        lCap = SIZE_LABEL_INIT;
+        while (lCap < pData->lLiveLabel_)
+            lCap <<= 1;
+        szLabel = (char*)malloc(sizeof(char) * lCap);
+        if (!szLabel)
+            return;
+    }
+
+    /* Each node is pushed only once, so the node count bounds the stack. */
+    RadixNode **stack = (RadixNode**)malloc(sizeof(RadixNode*) *
+                                            (pData->iCountNode_ + 1));
+    if (!stack) {
+        free(szLabel);
+        return;
+    }
+
+    /* Copy the labels in preorder, which keeps a node adjacent to its first
+       child for the later merges. */
+    int64_t lSize = 0;
+    int32_t iTop = 0;
+    if (pData->pRadix_->pChild_)
+        stack[iTop++] = pData->pRadix_->pChild_;
+    while (iTop > 0) {
+        RadixNode *pCurr = stack[--iTop];
+        if (pCurr->pSibling_)
+            stack[iTop++] = pCurr->pSibling_;
+        if (pCurr->pChild_)
+            stack[iTop++] = pCurr->pChild_;
+        memcpy(szLabel + lSize, RADIX_LABEL(pData, pCurr), pCurr->iLenLabel_);
+        pCurr->lLabel_ = lSize;
+        lSize += pCurr->iLenLabel_;
+    }
+    free(stack);
+
+    free(pData->szLabel_);
+    pData->szLabel_ = szLabel;
+    pData->lSizeLabel_ = lSize;
+    pData->lCapLabel_ = lCap;
+    return;
+}
@@ -0,0 +1,392 @@
+#include "container/typed_vector.h"
+
+
+/*===========================================================================*
+ *                        The container private data                         *
+ *===========================================================================*/
+struct _TypedVectorData {
+    int32_t iSize_;
+    int32_t iCapacity_;
+    int32_t iSizeElem_;
+    int32_t iIter_;
+    char *aElem_;
+    void (*pDestroy_) (void*);
+};
+
+#define DEFAULT_CAPACITY    (1)
+
+#define ELEMENT(pData, iIdx)    ((pData)->aElem_ + (size_t)(iIdx) * (pData)->iSizeElem_)
+
+
+/*===========================================================================*
+ *                  Definition for internal operations                       *
+ *===========================================================================*/
+/**
+ * @brief Change the capacity of the internal array.
+ *
+ * This function resizes the internal array. If the new capacity is smaller than
+ * the old one, the trailing elements will be removed. Also, if user defined
+ * destroy func is set, it also runs the resource clean method for the removed
+ * elements.
+ *
+ * @param pData         The pointer to the private data
+ * @param iCapNew       The designated capacity
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for array expansion
+ */
+int32_t _TypedVectorResize(TypedVectorData *pData, int32_t iCapNew);
+
+
+#define CHECK_INIT(self)                                                        \
+            do {                                                                \
+                if (!self)                                                      \
+                    return ERR_NOINIT;                                          \
+                if (!(self->pData))                                             \
+                    return ERR_NOINIT;                                          \
+            } while (0);
+
+
+/*===========================================================================*
+ *         Implementation for the container supporting operations            *
+ *===========================================================================*/
+int32_t TypedVectorInit(TypedVector **ppObj, int32_t iSizeElem, int32_t iCap)
+{
+    if (iSizeElem <= 0)
+        return ERR_ELEMSIZE;
+
+    TypedVector *pObj;
+    *ppObj = (TypedVector*)malloc(sizeof(TypedVector));
+    if (!(*ppObj))
+        return ERR_NOMEM;
+    pObj = *ppObj;
+
+    TypedVectorData *pData;
+    pObj->pData = (TypedVectorData*)malloc(sizeof(TypedVectorData));
+    if (!(pObj->pData)) {
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+    pData = pObj->pData;
+
+    iCap = (iCap <= 0)? DEFAULT_CAPACITY : iCap;
+    pData->aElem_ = (char*)malloc((size_t)iSizeElem * iCap);
+    if (!(pData->aElem_)) {
+        free(pObj->pData);
+        free(*ppObj);
+        *ppObj = NULL;
+        return ERR_NOMEM;
+    }
+    pData->iSize_ = 0;
+    pData->iCapacity_ = iCap;
+    pData->iSizeElem_ = iSizeElem;
+    pData->iIter_ = 0;
+    pData->pDestroy_ = NULL;
+
+    pObj->push_back = TypedVectorPushBack;
+    pObj->emplace_back = TypedVectorEmplaceBack;
+    pObj->insert = TypedVectorInsert;
+    pObj->pop_back = TypedVectorPopBack;
+    pObj->remove = TypedVectorRemove;
+    pObj->set = TypedVectorSet;
+    pObj->get = TypedVectorGet;
+    pObj->at = TypedVectorAt;
+    pObj->resize = TypedVectorResize;
+    pObj->size = TypedVectorSize;
+    pObj->capacity = TypedVectorCapacity;
+    pObj->element_size = TypedVectorElementSize;
+    pObj->sort = TypedVectorSort;
+    pObj->iterate = TypedVectorIterate;
+    pObj->reverse_iterate = TypedVectorReverseIterate;
+    pObj->set_destroy = TypedVectorSetDestroy;
+
+    return SUCC;
+}
+
+void TypedVectorDeinit(TypedVector **ppObj)
+{
+    if (!(*ppObj))
+        goto EXIT;
+    TypedVectorData *pData = (*ppObj)->pData;
+    if (!pData)
+        goto FREE_VECTOR;
+    if (!(pData->aElem_))
+        goto FREE_INTERNAL;
+
+    if (pData->pDestroy_) {
+        int32_t iIdx;
+        for (iIdx = 0 ; iIdx < pData->iSize_ ; iIdx++)
+            pData->pDestroy_(ELEMENT(pData, iIdx));
+    }
+
+    free(pData->aElem_);
+FREE_INTERNAL:
+    free((*ppObj)->pData);
+FREE_VECTOR:
+    free(*ppObj);
+    *ppObj = NULL;
+EXIT:
+    return;
+}
+
+int32_t TypedVectorPushBack(TypedVector *self, const void *pElem)
+{
+    CHECK_INIT(self);
+    TypedVectorData *pData = self->pData;
+
+    /* If the internal array is full, extend it to double capacity. */
+    if (pData->iSize_ == pData->iCapacity_) {
+        int32_t iRtnCode = _TypedVectorResize(pData, pData->iCapacity_ * 2);
+        if (iRtnCode != SUCC)
+            return iRtnCode;
+    }
+
+    memcpy(ELEMENT(pData, pData->iSize_), pElem, pData->iSizeElem_);
+    pData->iSize_++;
+    return SUCC;
+}
+
+int32_t TypedVectorEmplaceBack(TypedVector *self, void **ppElem)
+{
+    CHECK_INIT(self);
+    if (!ppElem)
+        return ERR_GET;
+    *ppElem = NULL;
+
+    TypedVectorData *pData = self->pData;
+    if (pData->iSize_ == pData->iCapacity_) {
+        int32_t iRtnCode = _TypedVectorResize(pData, pData->iCapacity_ * 2);
+        if (iRtnCode != SUCC)
+            return iRtnCode;
+    }
+
+    char *pSlot = ELEMENT(pData, pData->iSize_);
+    memset(pSlot, 0, pData->iSizeElem_);
+    pData->iSize_++;
+    *ppElem = pSlot;
+    return SUCC;
+}
+
+int32_t TypedVectorInsert(TypedVector *self, const void *pElem, int32_t iIdx)
+{
+    CHECK_INIT(self);
+    TypedVectorData *pData = self->pData;
+
+    /* Check for illegal index. */
+    if ((iIdx < 0) || (iIdx > pData->iSize_))
+        return ERR_IDX;
+
+    /* If the internal array is full, extend it to double capacity. */
+    if (pData->iSize_ == pData->iCapacity_) {
+        int32_t iRtnCode = _TypedVectorResize(pData, pData->iCapacity_ * 2);
+        if (iRtnCode != SUCC)
+            return iRtnCode;
+    }
+
+    /* Shift the trailing elements if necessary. */
+    int32_t iShftSize = pData->iSize_ - iIdx;
+    if (iShftSize > 0)
+        memmove(ELEMENT(pData, iIdx + 1), ELEMENT(pData, iIdx),
+                (size_t)pData->iSizeElem_ * iShftSize);
+    memcpy(ELEMENT(pData, iIdx), pElem, pData->iSizeElem_);
+    pData->iSize_++;
+
+    return SUCC;
+}
+
+int32_t TypedVectorPopBack(TypedVector *self)
+{
+    CHECK_INIT(self);
+    TypedVectorData *pData = self->pData;
+
+    if (pData->iSize_ == 0)
+        return ERR_IDX;
+
+    pData->iSize_--;
+    if (pData->pDestroy_)
+        pData->pDestroy_(ELEMENT(pData, pData->iSize_));
+    return SUCC;
+}
+
+int32_t TypedVectorRemove(TypedVector *self, int32_t iIdx)
+{
+    CHECK_INIT(self);
+    TypedVectorData *pData = self->pData;
+
+    /* Check for illegal index. */
+    if ((iIdx < 0) || (iIdx >= pData->iSize_))
+        return ERR_IDX;
+
+    if (pData->pDestroy_)
+        pData->pDestroy_(ELEMENT(pData, iIdx));
+
+    /* Shift the trailing elements if necessary. */
+    int32_t iShftSize = pData->iSize_ - iIdx - 1;
+    if (iShftSize > 0)
+        memmove(ELEMENT(pData, iIdx), ELEMENT(pData, iIdx + 1),
+                (size_t)pData->iSizeElem_ * iShftSize);
+    pData->iSize_--;
+
+    return SUCC;
+}
+
+int32_t TypedVectorSet(TypedVector *self, const void *pElem, int32_t iIdx)
+{
+    CHECK_INIT(self);
+    TypedVectorData *pData = self->pData;
+
+    /* Check for illegal index. */
+    if ((iIdx < 0) || (iIdx >= pData->iSize_))
+        return ERR_IDX;
+
+    char *pSlot = ELEMENT(pData, iIdx);
+    if (pData->pDestroy_)
+        pData->pDestroy_(pSlot);
+    memcpy(pSlot, pElem, pData->iSizeElem_);
+    return SUCC;
+}
+
+int32_t TypedVectorGet(TypedVector *self, void *pElem, int32_t iIdx)
+{
+    CHECK_INIT(self);
+    if (!pElem)
+        return ERR_GET;
+
+    TypedVectorData *pData = self->pData;
+
+    /* Check for illegal index. */
+    if ((iIdx < 0) || (iIdx >= pData->iSize_))
+        return ERR_IDX;
+
+    memcpy(pElem, ELEMENT(pData, iIdx), pData->iSizeElem_);
+    return SUCC;
+}
+
+int32_t TypedVectorAt(TypedVector *self, void **ppElem, int32_t iIdx)
+{
+    CHECK_INIT(self);
+    if (!ppElem)
+        return ERR_GET;
+    *ppElem = NULL;
+
+    TypedVectorData *pData = self->pData;
+
+    /* Check for illegal index. */
+    if ((iIdx < 0) || (iIdx >= pData->iSize_))
+        return ERR_IDX;
+
+    *ppElem = ELEMENT(pData, iIdx);
+    return SUCC;
+}
+
+int32_t TypedVectorResize(TypedVector *self, int32_t iCap)
+{
+    CHECK_INIT(self);
+    if (iCap <= 0)
+        return ERR_IDX;
+    return _TypedVectorResize(self->pData, iCap);
+}
+
+int32_t TypedVectorSize(TypedVector *self)
+{
+    CHECK_INIT(self);
+    return self->pData->iSize_;
+}
+
+int32_t TypedVectorCapacity(TypedVector *self)
+{
+    CHECK_INIT(self);
+    return self->pData->iCapacity_;
+}
+
+int32_t TypedVectorElementSize(TypedVector *self)
+{
+    CHECK_INIT(self);
+    return self->pData->iSizeElem_;
+}
+
+int32_t TypedVectorSort(TypedVector *self,
+                        int32_t (*pFunc) (const void*, const void*))
+{
+    CHECK_INIT(self);
+    TypedVectorData *pData = self->pData;
+    qsort(pData->aElem_, pData->iSize_, pData->iSizeElem_, pFunc);
+    return SUCC;
+}
+
+int32_t TypedVectorIterate(TypedVector *self, bool bReset, void **ppElem)
+{
+    CHECK_INIT(self);
+
+    TypedVectorData *pData = self->pData;
+    if (bReset) {
+        pData->iIter_ = 0;
+        return SUCC;
+    }
+    if (!ppElem)
+        return ERR_GET;
+    if (pData->iIter_ == pData->iSize_) {
+        *ppElem = NULL;
+        return END;
+    }
+
+    *ppElem = ELEMENT(pData, pData->iIter_);
+    pData->iIter_++;
+    return SUCC;
+}
+
+int32_t TypedVectorReverseIterate(TypedVector *self, bool bReset, void **ppElem)
+{
+    CHECK_INIT(self);
+
+    TypedVectorData *pData = self->pData;
+    if (bReset) {
+        pData->iIter_ = pData->iSize_ - 1;
+        return SUCC;
+    }
+    if (!ppElem)
+        return ERR_GET;
+    if (pData->iIter_ == -1) {
+        *ppElem = NULL;
+        return END;
+    }
+
+    *ppElem = ELEMENT(pData, pData->iIter_);
+    pData->iIter_--;
+    return SUCC;
+}
+
+int32_t TypedVectorSetDestroy(TypedVector *self, void (*pFunc) (void*))
+{
+    CHECK_INIT(self);
+    self->pData->pDestroy_ = pFunc;
+    return SUCC;
+}
+
+
+/*===========================================================================*
+ *               Implementation for internal operations                      *
+ *===========================================================================*/
+int32_t _TypedVectorResize(TypedVectorData *pData, int32_t iCapNew)
+{
+    /* Remove the trailing elements if the new capacity is smaller than the old
+       size. Clean the resource hold by the removed elements if user defined
+       destroy is set. */
+    if (iCapNew < pData->iSize_) {
+        if (pData->pDestroy_) {
+            int32_t iIdx;
+            for (iIdx = iCapNew ; iIdx < pData->iSize_ ; iIdx++)
+                pData->pDestroy_(ELEMENT(pData, iIdx));
+        }
+        pData->iSize_ = iCapNew;
+    }
+
+    char *aElemNew = (char*)realloc(pData->aElem_,
+                                    (size_t)iCapNew * pData->iSizeElem_);
+    if (aElemNew) {
+        pData->aElem_ = aElemNew;
+        pData->iCapacity_ = iCapNew;
+    }
+    return (aElemNew)? SUCC : ERR_NOMEM;
+}
@@ -1,13 +1,23 @@
 #include "container/vector.h"
+#include "sort_internal.h"
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define VECTOR_SIMD_X86
+#include <immintrin.h>
+#endif
 
 
 /*===========================================================================*
  *                        The container private data                         *
  *===========================================================================*/
 struct _VectorData {
-    int32_t iSize_;
-    int32_t iCapacity_;
-    int32_t iIter_;
+    int64_t iSize_;
+    int64_t iCapacity_;
+    int64_t iIter_;
+    int64_t iChunk_;
+    int32_t iGrowth_;
+    Storage store_;
     Item *aItem_;
     void (*pDestroy_) (Item);
     bool bUserDestroy_;
@@ -15,6 +25,45 @@ struct _VectorData {
 
 #define DEFAULT_CAPACITY    (1)
 
+#define SORT_MIN_PER_THREAD (1 << 14)
+#define RADIX_BITS          (8)
+#define RADIX_BUCKETS       (1 << RADIX_BITS)
+#define RADIX_MASK          (RADIX_BUCKETS - 1)
+
+#define SIMD_NONE           (0)
+#define SIMD_SSE2           (1)
+#define SIMD_SSE42          (2)
+#define SIMD_AVX2           (3)
+#define SELECT_BLOCK_SIZE   (256)
+#define SIGN_FLIP           (0x8000000000000000ull)
+#define ITEM_WORD(item)     ((uint64_t)(uintptr_t)(item))
+
+typedef int32_t (*SortCompare) (const void*, const void*);
+
+/* The comparison method receives the pointers to the items. */
+#define ITEM_ORDER(pCompare, pSrc, pTge)        ((pCompare)((pSrc), (pTge)))
+#define ITEM_ORDER_PROBE(pCompare, pItem, item) ((pCompare)((pItem), &(item)))
+
+/* The task to sort a consecutive run of items. */
+typedef struct _SortRunTask {
+    Item *aItem_;
+    Item *aTmp_;
+    int64_t iSize_;
+    SortCompare pCompare_;
+} SortRunTask;
+
+/* The task to produce the output segment [iBegin_, iEnd_) of merging two runs. */
+typedef struct _SortMergeTask {
+    Item *aFst_;
+    Item *aSnd_;
+    Item *aDst_;
+    int64_t iSizeFst_;
+    int64_t iSizeSnd_;
+    int64_t iBegin_;
+    int64_t iEnd_;
+    SortCompare pCompare_;
+} SortMergeTask;
+
 
 /*===========================================================================*
  *                  Definition for internal operations                       *
@@ -39,10 +88,229 @@ void _VectorItemDestroy(Item item);
  *
  * @retval SUCC
  * @retval ERR_NOMEM    Insufficient memory for array expansion
+ * @retval ERR_IO       Fail to extend the backing file
  *
  * @note The designated capacity should greater than zero.
  */
-int32_t _VectorReisze(VectorData *pData, int32_t iSizeNew);
+int32_t _VectorReisze(VectorData *pData, int64_t iSizeNew);
+
+/**
+ * @brief Ensure the storage can hold the designated number of additional items.
+ *
+ * The capacity is extended with the growth policy if necessary.
+ *
+ * @param pData         The pointer to the vector private data
+ * @param iNum          The number of additional items
+ *
+ * @retval SUCC
+ * @retval ERR_NOMEM    Insufficient memory for vector extension
+ */
+int32_t _VectorReserve(VectorData *pData, int64_t iNum);
+
+/**
+ * @brief Stably sort the designated run of items.
+ *
+ * This function applies insertion sort to the short runs and then merges the
+ * runs bottom-up with the auxiliary buffer. The sorted items are always left
+ * in the original array.
+ *
+ * @param aItem         The array of items
+ * @param aTmp          The auxiliary buffer with the same size
+ * @param iSize         The number of items
+ * @param pCompare      The item comparison method
+ */
+void _VectorMergeSort(Item *aItem, Item *aTmp, int64_t iSize, SortCompare pCompare);
+
+/**
+ * @brief Restore the max heap property for the subtree of the designated node.
+ *
+ * @param aItem         The array of items organized as a binary heap
+ * @param iSize         The number of items in the heap
+ * @param iIdx          The index of the designated node
+ * @param pCompare      The item comparison method
+ */
+void _VectorSiftDown(Item *aItem, int64_t iSize, int64_t iIdx, SortCompare pCompare);
+
+/**
+ * @brief Sort the designated items in place with heap sort.
+ *
+ * @param aItem         The array of items
+ * @param iSize         The number of items
+ * @param pCompare      The item comparison method
+ */
+void _VectorHeapSort(Item *aItem, int64_t iSize, SortCompare pCompare);
+
+/**
+ * @brief Place the item of the designated rank at its sorted position.
+ *
+ * @param aItem         The array of items
+ * @param iSize         The number of items
+ * @param iNth          The designated rank
+ * @param pCompare      The item comparison method
+ */
+void _VectorIntroSelect(Item *aItem, int64_t iSize, int64_t iNth,
+                        SortCompare pCompare);
+
+/**
+ * @brief Return the number of items contributed by the first run to the first
+ * iRank items of the stable merge result.
+ *
+ * @param aFst          The first sorted run
+ * @param iSizeFst      The size of the first run
+ * @param aSnd          The second sorted run
+ * @param iSizeSnd      The size of the second run
+ * @param iRank         The designated output rank
+ * @param pCompare      The item comparison method
+ *
+ * @return              The split index of the first run
+ */
+int64_t _VectorMergePath(Item *aFst, int64_t iSizeFst, Item *aSnd,
+                         int64_t iSizeSnd, int64_t iRank, SortCompare pCompare);
+
+/**
+ * @brief The thread routine to sort a run of items.
+ *
+ * @param pArg          The pointer to the SortRunTask
+ */
+void* _VectorSortRun(void *pArg);
+
+/**
+ * @brief The thread routine to produce a segment of the merge result.
+ *
+ * @param pArg          The pointer to the SortMergeTask
+ */
+void* _VectorSortMerge(void *pArg);
+
+/**
+ * @brief Run the designated tasks concurrently with one thread per task.
+ *
+ * The first task is run by the calling thread. If a thread cannot be spawned,
+ * its task is run by the calling thread instead.
+ *
+ * @param pFunc         The thread routine
+ * @param aTask         The array of tasks
+ * @param iSizeTask     The size of a single task in bytes
+ * @param iNum          The number of tasks
+ */
+void _VectorRunTasks(void* (*pFunc) (void*), void *aTask, size_t iSizeTask,
+                     int32_t iNum);
+
+/**
+ * @brief Return the first index of the designated item or -1 if not found.
+ *
+ * The SSE2 and AVX2 variants follow the same contract.
+ *
+ * @param aItem         The array of items
+ * @param iSize         The number of items
+ * @param item          The designated item
+ *
+ * @return              The first index or -1
+ */
+int64_t _VectorFindScalar(const Item *aItem, int64_t iSize, Item item);
+
+/**
+ * @brief Return the number of items equal to the designated item.
+ *
+ * The SSE2 and AVX2 variants follow the same contract.
+ *
+ * @param aItem         The array of items
+ * @param iSize         The number of items
+ * @param item          The designated item
+ *
+ * @return              The number of matched items
+ */
+int64_t _VectorCountScalar(const Item *aItem, int64_t iSize, Item item);
+
+/**
+ * @brief Find the first indexes of the minimum and maximum items.
+ *
+ * The items are compared as the 64 bit words whose sign bits are already
+ * flipped by the designated mask. The SSE4.2 and AVX2 variants follow the same
+ * contract.
+ *
+ * @param aItem         The non-empty array of items
+ * @param iSize         The number of items
+ * @param ulFlip        The mask to flip the sign bits for unsigned comparison
+ * @param pIdxMin       The pointer to the returned index of the minimum
+ * @param pIdxMax       The pointer to the returned index of the maximum
+ */
+void _VectorMinMaxScalar(const Item *aItem, int64_t iSize, uint64_t ulFlip,
+                         int64_t *pIdxMin, int64_t *pIdxMax);
+
+/**
+ * @brief Copy the items within the designated closed range to the buffer.
+ *
+ * The items and the range bounds are compared as the 64 bit words whose sign
+ * bits are flipped by the designated mask. The SSE4.2 and AVX2 variants follow
+ * the same contract.
+ *
+ * @param aItem         The array of items
+ * @param iSize         The number of items
+ * @param lLow          The flipped lower bound
+ * @param lHigh         The flipped upper bound
+ * @param ulFlip        The mask to flip the sign bits for unsigned comparison
+ * @param aOut          The buffer which can hold iSize items
+ *
+ * @return              The number of copied items
+ */
+int64_t _VectorSelectScalar(const Item *aItem, int64_t iSize, int64_t lLow,
+                            int64_t lHigh, uint64_t ulFlip, Item *aOut);
+
+#ifdef VECTOR_SIMD_X86
+int64_t _VectorFindSse2(const Item *aItem, int64_t iSize, Item item);
+int64_t _VectorFindAvx2(const Item *aItem, int64_t iSize, Item item);
+int64_t _VectorCountSse2(const Item *aItem, int64_t iSize, Item item);
+int64_t _VectorCountAvx2(const Item *aItem, int64_t iSize, Item item);
+void _VectorMinMaxSse42(const Item *aItem, int64_t iSize, uint64_t ulFlip,
+                        int64_t *pIdxMin, int64_t *pIdxMax);
+void _VectorMinMaxAvx2(const Item *aItem, int64_t iSize, uint64_t ulFlip,
+                       int64_t *pIdxMin, int64_t *pIdxMax);
+int64_t _VectorSelectSse42(const Item *aItem, int64_t iSize, int64_t lLow,
+                           int64_t lHigh, uint64_t ulFlip, Item *aOut);
+int64_t _VectorSelectAvx2(const Item *aItem, int64_t iSize, int64_t lLow,
+                          int64_t lHigh, uint64_t ulFlip, Item *aOut);
+
+/**
+ * @brief Merge the per lane extremes and visit the trailing items.
+ *
+ * @param aMin          The per lane minimums
+ * @param aIdxMin       The per lane indexes of the minimums
+ * @param aMax          The per lane maximums
+ * @param aIdxMax       The per lane indexes of the maximums
+ * @param iLane         The number of lanes
+ * @param aItem         The array of items
+ * @param iIdx          The index of the first unvisited item
+ * @param iSize         The number of items
+ * @param ulFlip        The mask to flip the sign bits for unsigned comparison
+ * @param pIdxMin       The pointer to the returned index of the minimum
+ * @param pIdxMax       The pointer to the returned index of the maximum
+ */
+void _VectorReduceMinMax(int64_t *aMin, int64_t *aIdxMin, int64_t *aMax,
+                         int64_t *aIdxMax, int32_t iLane, const Item *aItem,
+                         int64_t iIdx, int64_t iSize, uint64_t ulFlip,
+                         int64_t *pIdxMin, int64_t *pIdxMax);
+#endif
+
+/**
+ * @brief Return the widest instruction set supported by the running processor.
+ *
+ * @return              One of the SIMD_* levels
+ */
+int32_t _VectorSimdLevel();
+
+/**
+ * @brief Find the lower or upper bound of the designated item.
+ *
+ * @param aItem         The array of sorted items
+ * @param iSize         The number of items
+ * @param item          The designated item
+ * @param pCompare      The item comparison method
+ * @param bUpper        Whether to find the upper bound
+ *
+ * @return              The bound index
+ */
+int64_t _VectorBound(const Item *aItem, int64_t iSize, Item item,
+                     SortCompare pCompare, bool bUpper);
 
 
 #define CHECK_INIT(self)                                                        \
@@ -58,7 +326,7 @@ int32_t _VectorReisze(VectorData *pData, int32_t iSizeNew);
  *         Implementation for the container supporting operations            *
  *===========================================================================*/
 
-int32_t VectorInit(Vector **ppObj, int32_t iCap)
+int32_t VectorInit(Vector **ppObj, int64_t iCap)
 {
     Vector *pObj;
     *ppObj = (Vector*)malloc(sizeof(Vector));
@@ -75,33 +343,57 @@ int32_t VectorInit(Vector **ppObj, int32_t iCap)
     }
     pData = pObj->pData;
 
+    pData->aItem_ = NULL;
+    pData->iSize_ = 0;
+    pData->iCapacity_ = 0;
+    pData->iIter_ = 0;
+    pData->iChunk_ = 0;
+    pData->iGrowth_ = VECTOR_GROW_DOUBLE;
+    StorageInit(&pData->store_, STORAGE_HEAP, NULL);
+
     iCap = (iCap <= 0)? DEFAULT_CAPACITY : iCap;
-    pData->aItem_ = (Item*)malloc(sizeof(Item) * iCap);
-    if (!(pData->aItem_)) {
+    if (_VectorReisze(pData, iCap) != SUCC) {
         free(pObj->pData);
         free(*ppObj);
         *ppObj = NULL;
         return ERR_NOMEM;
     }
-    pData->iSize_ = 0;
-    pData->iCapacity_ = iCap;
-    pData->iIter_ = 0;
     pData->pDestroy_ = _VectorItemDestroy;
     pData->bUserDestroy_ = false;
 
     pObj->push_back = VectorPushBack;
     pObj->pop_back = VectorPopBack;
     pObj->insert = VectorInsert;
+    pObj->append = VectorAppend;
+    pObj->insert_range = VectorInsertRange;
     pObj->remove = VectorRemove;
+    pObj->remove_range = VectorRemoveRange;
     pObj->resize = VectorResize;
     pObj->size = VectorSize;
     pObj->capacity = VectorCapacity;
     pObj->set = VectorSet;
     pObj->get = VectorGet;
     pObj->sort = VectorSort;
+    pObj->stable_sort = VectorStableSort;
+    pObj->parallel_sort = VectorParallelSort;
+    pObj->radix_sort = VectorRadixSort;
+    pObj->nth_element = VectorNthElement;
+    pObj->partial_sort = VectorPartialSort;
+    pObj->top_k = VectorTopK;
+    pObj->find = VectorFind;
+    pObj->count = VectorCount;
+    pObj->min_max = VectorMinMax;
+    pObj->filter = VectorFilter;
+    pObj->lower_bound = VectorLowerBound;
+    pObj->upper_bound = VectorUpperBound;
+    pObj->equal_range = VectorEqualRange;
+    pObj->insert_sorted = VectorInsertSorted;
+    pObj->merge = VectorMerge;
     pObj->iterate = VectorIterate;
     pObj->reverse_iterate = VectorReverseIterate;
     pObj->set_destroy = VectorSetDestroy;
+    pObj->set_growth = VectorSetGrowth;
+    pObj->set_storage = VectorSetStorage;
 
     return SUCC;
 }
@@ -115,15 +407,15 @@ void VectorDeinit(Vector **ppObj)
         goto FREE_VECTOR;
     Item *aItem = pData->aItem_;
     if (!aItem)
-        goto FREE_INTERNAL;
+        goto FREE_STORAGE;
 
-    int32_t iIdx;
+    int64_t iIdx;
     for (iIdx = 0 ; iIdx < pData->iSize_ ; iIdx++)
         if (pData->bUserDestroy_)
             pData->pDestroy_(aItem[iIdx]);
 
-    free(pData->aItem_);
-FREE_INTERNAL:
+FREE_STORAGE:
+    StorageDeinit(&pData->store_);
     free((*ppObj)->pData);
 FREE_VECTOR:
     free(*ppObj);
@@ -137,9 +429,9 @@ int32_t VectorPushBack(Vector *self, Item item)
     CHECK_INIT(self);
     VectorData *pData = self->pData;
 
-    /* If the internal array is full, extend it to double capacity. */
+    /* If the internal array is full, extend it with the growth policy. */
     if (pData->iSize_ == pData->iCapacity_) {
-        int iRtnCode = _VectorReisze(pData, pData->iCapacity_ * 2);
+        int32_t iRtnCode = _VectorReserve(pData, 1);
         if (iRtnCode != SUCC)
             return iRtnCode;
     }
@@ -149,7 +441,7 @@ int32_t VectorPushBack(Vector *self, Item item)
     return SUCC;
 }
 
-int32_t VectorInsert(Vector *self, Item item, int32_t iIdx)
+int32_t VectorInsert(Vector *self, Item item, int64_t iIdx)
 {
     CHECK_INIT(self);
     VectorData *pData = self->pData;
@@ -158,16 +450,16 @@ int32_t VectorInsert(Vector *self, Item item, int32_t iIdx)
     if ((iIdx < 0) || (iIdx > pData->iSize_))
         return ERR_IDX;
 
-    /* If the internal array is full, extend it to double capacity. */
+    /* If the internal array is full, extend it with the growth policy. */
     if (pData->iSize_ == pData->iCapacity_) {
-        int iRtnCode = _VectorReisze(pData, pData->iCapacity_ * 2);
+        int32_t iRtnCode = _VectorReserve(pData, 1);
         if (iRtnCode != SUCC)
             return iRtnCode;
     }
 
     /* Shift the trailing items if necessary. */
     Item *aItem = pData->aItem_;
-    int32_t iShftSize = pData->iSize_ - iIdx;
+    int64_t iShftSize = pData->iSize_ - iIdx;
     if (iShftSize > 0)
         memmove(aItem + iIdx + 1, aItem + iIdx, sizeof(Item) * iShftSize);
     aItem[iIdx] = item;
@@ -176,6 +468,41 @@ int32_t VectorInsert(Vector *self, Item item, int32_t iIdx)
     return SUCC;
 }
 
+int32_t VectorAppend(Vector *self, const Item *aItem, int64_t iNum)
+{
+    CHECK_INIT(self);
+    return VectorInsertRange(self, aItem, iNum, self->pData->iSize_);
+}
+
+int32_t VectorInsertRange(Vector *self, const Item *aItem, int64_t iNum,
+                          int64_t iIdx)
+{
+    CHECK_INIT(self);
+    VectorData *pData = self->pData;
+
+    /* Check for illegal index and item array. */
+    if ((iIdx < 0) || (iIdx > pData->iSize_))
+        return ERR_IDX;
+    if ((iNum < 0) || ((iNum > 0) && (!aItem)))
+        return ERR_IDX;
+    if (iNum == 0)
+        return SUCC;
+
+    int32_t iRtnCode = _VectorReserve(pData, iNum);
+    if (iRtnCode != SUCC)
+        return iRtnCode;
+
+    /* Shift the trailing items once and copy the new items into the gap. */
+    Item *aDst = pData->aItem_;
+    int64_t iShftSize = pData->iSize_ - iIdx;
+    if (iShftSize > 0)
+        memmove(aDst + iIdx + iNum, aDst + iIdx, sizeof(Item) * iShftSize);
+    memcpy(aDst + iIdx, aItem, sizeof(Item) * iNum);
+    pData->iSize_ += iNum;
+
+    return SUCC;
+}
+
 int32_t VectorPopBack(Vector *self)
 {
     CHECK_INIT(self);
@@ -191,7 +518,7 @@ int32_t VectorPopBack(Vector *self)
     return SUCC;
 }
 
-int32_t VectorRemove(Vector *self, int32_t iIdx)
+int32_t VectorRemove(Vector *self, int64_t iIdx)
 {
     CHECK_INIT(self);
     VectorData *pData = self->pData;
@@ -206,7 +533,7 @@ int32_t VectorRemove(Vector *self, int32_t iIdx)
         pData->pDestroy_(aItem[iIdx]);
 
     /* Shift the trailing items if necessary. */
-    int32_t iShftSize = pData->iSize_ - iIdx - 1;
+    int64_t iShftSize = pData->iSize_ - iIdx - 1;
     if (iShftSize > 0)
         memmove(aItem + iIdx, aItem + iIdx + 1, sizeof(Item) *iShftSize);
     pData->iSize_--;
@@ -214,25 +541,52 @@ int32_t VectorRemove(Vector *self, int32_t iIdx)
     return SUCC;
 }
 
-int32_t VectorResize(Vector *self, int32_t iSize)
+int32_t VectorRemoveRange(Vector *self, int64_t iIdx, int64_t iNum)
+{
+    CHECK_INIT(self);
+    VectorData *pData = self->pData;
+
+    /* Check for illegal index range. */
+    if ((iIdx < 0) || (iNum < 0) || (iIdx > pData->iSize_ - iNum))
+        return ERR_IDX;
+    if (iNum == 0)
+        return SUCC;
+
+    Item *aItem = pData->aItem_;
+    if (pData->bUserDestroy_) {
+        int64_t iOfst;
+        for (iOfst = iIdx ; iOfst < iIdx + iNum ; iOfst++)
+            pData->pDestroy_(aItem[iOfst]);
+    }
+
+    /* Shift the trailing items if necessary. */
+    int64_t iShftSize = pData->iSize_ - iIdx - iNum;
+    if (iShftSize > 0)
+        memmove(aItem + iIdx, aItem + iIdx + iNum, sizeof(Item) * iShftSize);
+    pData->iSize_ -= iNum;
+
+    return SUCC;
+}
+
+int32_t VectorResize(Vector *self, int64_t iSize)
 {
     CHECK_INIT(self);
     return _VectorReisze(self->pData, iSize);
 }
 
-int32_t VectorSize(Vector *self)
+int64_t VectorSize(Vector *self)
 {
     CHECK_INIT(self);
     return self->pData->iSize_;
 }
 
-int32_t VectorCapacity(Vector *self)
+int64_t VectorCapacity(Vector *self)
 {
     CHECK_INIT(self);
     return self->pData->iCapacity_;
 }
 
-int32_t VectorSet(Vector *self, Item item, int32_t iIdx)
+int32_t VectorSet(Vector *self, Item item, int64_t iIdx)
 {
     CHECK_INIT(self);
     VectorData *pData = self->pData;
@@ -249,7 +603,7 @@ int32_t VectorSet(Vector *self, Item item, int32_t iIdx)
     return SUCC;
 }
 
-int32_t VectorGet(Vector *self, Item *pItem, int32_t iIdx)
+int32_t VectorGet(Vector *self, Item *pItem, int64_t iIdx)
 {
     CHECK_INIT(self);
     if (!pItem)
@@ -274,6 +628,500 @@ int32_t VectorSort(Vector *self, int32_t (*pFunc) (const void*, const void*))
     return SUCC;
 }
 
+int32_t VectorStableSort(Vector *self, int32_t (*pFunc) (const void*, const void*))
+{
+    CHECK_INIT(self);
+    VectorData *pData = self->pData;
+    if (pData->iSize_ < 2)
+        return SUCC;
+
+    Item *aTmp = (Item*)malloc(sizeof(Item) * pData->iSize_);
+    if (!aTmp)
+        return ERR_NOMEM;
+    _VectorMergeSort(pData->aItem_, aTmp, pData->iSize_, pFunc);
+    free(aTmp);
+    return SUCC;
+}
+
+int32_t VectorParallelSort(Vector *self, int32_t (*pFunc) (const void*, const void*),
+                           int32_t iThread)
+{
+    CHECK_INIT(self);
+    VectorData *pData = self->pData;
+    int64_t iSize = pData->iSize_;
+    if (iSize < 2)
+        return SUCC;
+
+    /* Do not let a thread handle too few items. */
+    if (iThread <= 0)
+        iThread = (int32_t)sysconf(_SC_NPROCESSORS_ONLN);
+    int64_t iMaxThread = iSize / SORT_MIN_PER_THREAD;
+    if (iThread > iMaxThread)
+        iThread = (int32_t)iMaxThread;
+    if (iThread <= 1)
+        return VectorStableSort(self, pFunc);
+
+    int32_t iRtn = ERR_NOMEM;
+    Item *aTmp = (Item*)malloc(sizeof(Item) * iSize);
+    if (!aTmp)
+        goto EXIT;
+    int64_t *aBound = (int64_t*)malloc(sizeof(int64_t) * (iThread + 1));
+    if (!aBound)
+        goto FREE_TMP;
+    SortRunTask *aRun = (SortRunTask*)malloc(sizeof(SortRunTask) * iThread);
+    if (!aRun)
+        goto FREE_BOUND;
+    SortMergeTask *aMerge = (SortMergeTask*)malloc(sizeof(SortMergeTask) * iThread);
+    if (!aMerge)
+        goto FREE_RUN;
+
+    /* Sort one run per thread. */
+    Item *aSrc = pData->aItem_;
+    Item *aDst = aTmp;
+    int32_t iRun;
+    for (iRun = 0 ; iRun <= iThread ; iRun++)
+        aBound[iRun] = iSize * iRun / iThread;
+    for (iRun = 0 ; iRun < iThread ; iRun++) {
+        aRun[iRun].aItem_ = aSrc + aBound[iRun];
+        aRun[iRun].aTmp_ = aDst + aBound[iRun];
+        aRun[iRun].iSize_ = aBound[iRun + 1] - aBound[iRun];
+        aRun[iRun].pCompare_ = pFunc;
+    }
+    _VectorRunTasks(_VectorSortRun, aRun, sizeof(SortRunTask), iThread);
+
+    /* Merge the adjacent runs pairwise till only one run is left. Each round
+       distributes all the threads among the pairs of the round. */
+    int32_t iCountRun = iThread;
+    while (iCountRun > 1) {
+        int32_t iCountPair = iCountRun >> 1;
+        int32_t iSlice = iThread / iCountPair;
+        int32_t iTask = 0, iPair;
+        for (iPair = 0 ; iPair < iCountPair ; iPair++) {
+            int64_t iLow = aBound[iPair << 1];
+            int64_t iMid = aBound[(iPair << 1) + 1];
+            int64_t iHigh = aBound[(iPair << 1) + 2];
+            int64_t iSizeOut = iHigh - iLow;
+            int32_t iPiece;
+            for (iPiece = 0 ; iPiece < iSlice ; iPiece++) {
+                SortMergeTask *pTask = aMerge + iTask++;
+                pTask->aFst_ = aSrc + iLow;
+                pTask->aSnd_ = aSrc + iMid;
+                pTask->aDst_ = aDst + iLow;
+                pTask->iSizeFst_ = iMid - iLow;
+                pTask->iSizeSnd_ = iHigh - iMid;
+                pTask->iBegin_ = iSizeOut * iPiece / iSlice;
+                pTask->iEnd_ = iSizeOut * (iPiece + 1) / iSlice;
+                pTask->pCompare_ = pFunc;
+            }
+        }
+        _VectorRunTasks(_VectorSortMerge, aMerge, sizeof(SortMergeTask), iTask);
+
+        /* The unpaired trailing run is moved as is. */
+        if (iCountRun & 1) {
+            int64_t iLow = aBound[iCountRun - 1];
+            memcpy(aDst + iLow, aSrc + iLow, sizeof(Item) * (iSize - iLow));
+        }
+
+        for (iPair = 0 ; iPair < iCountPair ; iPair++)
+            aBound[iPair] = aBound[iPair << 1];
+        if (iCountRun & 1)
+            aBound[iCountPair] = aBound[iCountRun - 1];
+        iCountRun = iCountPair + (iCountRun & 1);
+        aBound[iCountRun] = iSize;
+
+        Item *aSwap = aSrc;
+        aSrc = aDst;
+        aDst = aSwap;
+    }
+
+    if (aSrc != pData->aItem_)
+        memcpy(pData->aItem_, aSrc, sizeof(Item) * iSize);
+    iRtn = SUCC;
+
+    free(aMerge);
+FREE_RUN:
+    free(aRun);
+FREE_BOUND:
+    free(aBound);
+FREE_TMP:
+    free(aTmp);
+EXIT:
+    return iRtn;
+}
+
+int32_t VectorRadixSort(Vector *self, uint64_t (*pKey) (Item), int32_t iWidth)
+{
+    CHECK_INIT(self);
+    if ((iWidth <= 0) || (iWidth > (int32_t)sizeof(uint64_t)))
+        return ERR_KEYSIZE;
+
+    VectorData *pData = self->pData;
+    int64_t iSize = pData->iSize_;
+    if (iSize < 2)
+        return SUCC;
+
+    int32_t iRtn = ERR_NOMEM;
+    uint64_t *aKey = (uint64_t*)malloc(sizeof(uint64_t) * iSize);
+    if (!aKey)
+        goto EXIT;
+    uint64_t *aKeyTmp = (uint64_t*)malloc(sizeof(uint64_t) * iSize);
+    if (!aKeyTmp)
+        goto FREE_KEY;
+    Item *aItemTmp = (Item*)malloc(sizeof(Item) * iSize);
+    if (!aItemTmp)
+        goto FREE_KEY_TMP;
+    int64_t (*aCount)[RADIX_BUCKETS] =
+        (int64_t(*)[RADIX_BUCKETS])calloc(iWidth, sizeof(int64_t) * RADIX_BUCKETS);
+    if (!aCount)
+        goto FREE_ITEM_TMP;
+
+    /* Extract the keys and build the histograms of all the digits at once. */
+    Item *aItem = pData->aItem_;
+    int64_t iIdx;
+    int32_t iPass;
+    for (iIdx = 0 ; iIdx < iSize ; iIdx++) {
+        uint64_t ulKey = pKey(aItem[iIdx]);
+        aKey[iIdx] = ulKey;
+        for (iPass = 0 ; iPass < iWidth ; iPass++)
+            aCount[iPass][(ulKey >> (iPass * RADIX_BITS)) & RADIX_MASK]++;
+    }
+
+    /* Scatter the items from the least significant digit. */
+    uint64_t *aKeySrc = aKey, *aKeyDst = aKeyTmp;
+    Item *aItemSrc = aItem, *aItemDst = aItemTmp;
+    for (iPass = 0 ; iPass < iWidth ; iPass++) {
+        int32_t iShift = iPass * RADIX_BITS;
+        int64_t *aBucket = aCount[iPass];
+
+        /* Skip the digit shared by all the keys. */
+        if (aBucket[(aKeySrc[0] >> iShift) & RADIX_MASK] == iSize)
+            continue;
+
+        int64_t iSum = 0, iDigit;
+        for (iDigit = 0 ; iDigit < RADIX_BUCKETS ; iDigit++) {
+            int64_t iCount = aBucket[iDigit];
+            aBucket[iDigit] = iSum;
+            iSum += iCount;
+        }
+
+        for (iIdx = 0 ; iIdx < iSize ; iIdx++) {
+            uint64_t ulKey = aKeySrc[iIdx];
+            int64_t iPos = aBucket[(ulKey >> iShift) & RADIX_MASK]++;
+            aKeyDst[iPos] = ulKey;
+            aItemDst[iPos] = aItemSrc[iIdx];
+        }
+
+        uint64_t *aKeySwap = aKeySrc;
+        aKeySrc = aKeyDst;
+        aKeyDst = aKeySwap;
+        Item *aItemSwap = aItemSrc;
+        aItemSrc = aItemDst;
+        aItemDst = aItemSwap;
+    }
+
+    if (aItemSrc != aItem)
+        memcpy(aItem, aItemSrc, sizeof(Item) * iSize);
+    iRtn = SUCC;
+
+    free(aCount);
+FREE_ITEM_TMP:
+    free(aItemTmp);
+FREE_KEY_TMP:
+    free(aKeyTmp);
+FREE_KEY:
+    free(aKey);
+EXIT:
+    return iRtn;
+}
+
+int32_t VectorNthElement(Vector *self, int64_t iNth,
+                         int32_t (*pFunc) (const void*, const void*))
+{
+    CHECK_INIT(self);
+    VectorData *pData = self->pData;
+    if ((iNth < 0) || (iNth >= pData->iSize_))
+        return ERR_IDX;
+
+    _VectorIntroSelect(pData->aItem_, pData->iSize_, iNth, pFunc);
+    return SUCC;
+}
+
+int32_t VectorPartialSort(Vector *self, int64_t iNum,
+                          int32_t (*pFunc) (const void*, const void*))
+{
+    CHECK_INIT(self);
+    VectorData *pData = self->pData;
+    if ((iNum < 0) || (iNum > pData->iSize_))
+        return ERR_IDX;
+    if (iNum == 0)
+        return SUCC;
+
+    if (iNum < pData->iSize_)
+        _VectorIntroSelect(pData->aItem_, pData->iSize_, iNum - 1, pFunc);
+    qsort(pData->aItem_, iNum, sizeof(Item), pFunc);
+    return SUCC;
+}
+
+int32_t VectorTopK(Vector *self, int64_t iNum,
+                   int32_t (*pFunc) (const void*, const void*), Item *aDst)
+{
+    CHECK_INIT(self);
+    VectorData *pData = self->pData;
+    if ((iNum < 0) || (iNum > pData->iSize_))
+        return ERR_IDX;
+    if (!aDst)
+        return ERR_GET;
+    if (iNum == 0)
+        return SUCC;
+
+    /* Build the max heap with the leading items. Then each remaining item
+       replaces the heap root if it is ordered before the root. */
+    Item *aItem = pData->aItem_;
+    memcpy(aDst, aItem, sizeof(Item) * iNum);
+    int64_t iIdx;
+    for (iIdx = (iNum >> 1) - 1 ; iIdx >= 0 ; iIdx--)
+        _VectorSiftDown(aDst, iNum, iIdx, pFunc);
+    for (iIdx = iNum ; iIdx < pData->iSize_ ; iIdx++) {
+        if (pFunc(&aItem[iIdx], &aDst[0]) < 0) {
+            aDst[0] = aItem[iIdx];
+            _VectorSiftDown(aDst, iNum, 0, pFunc);
+        }
+    }
+
+    _VectorHeapSort(aDst, iNum, pFunc);
+    return SUCC;
+}
+
+int32_t VectorFind(Vector *self, Item item, int64_t iBgn, int64_t *pIdx)
+{
+    CHECK_INIT(self);
+    if (!pIdx)
+        return ERR_GET;
+    *pIdx = -1;
+
+    VectorData *pData = self->pData;
+    if ((iBgn < 0) || (iBgn > pData->iSize_))
+        return ERR_IDX;
+
+    const Item *aItem = pData->aItem_ + iBgn;
+    int64_t iSize = pData->iSize_ - iBgn;
+    int64_t iIdx;
+    switch (_VectorSimdLevel()) {
+#ifdef VECTOR_SIMD_X86
+        case SIMD_AVX2:
+            iIdx = _VectorFindAvx2(aItem, iSize, item);
+            break;
+        case SIMD_SSE42:
+        case SIMD_SSE2:
+            iIdx = _VectorFindSse2(aItem, iSize, item);
+            break;
+#endif
+        default:
+            iIdx = _VectorFindScalar(aItem, iSize, item);
+    }
+
+    if (iIdx < 0)
+        return ERR_NODATA;
+    *pIdx = iBgn + iIdx;
+    return SUCC;
+}
+
+int32_t VectorCount(Vector *self, Item item, int64_t *pCount)
+{
+    CHECK_INIT(self);
+    if (!pCount)
+        return ERR_GET;
+
+    VectorData *pData = self->pData;
+    switch (_VectorSimdLevel()) {
+#ifdef VECTOR_SIMD_X86
+        case SIMD_AVX2:
+            *pCount = _VectorCountAvx2(pData->aItem_, pData->iSize_, item);
+            break;
+        case SIMD_SSE42:
+        case SIMD_SSE2:
+            *pCount = _VectorCountSse2(pData->aItem_, pData->iSize_, item);
+            break;
+#endif
+        default:
+            *pCount = _VectorCountScalar(pData->aItem_, pData->iSize_, item);
+    }
+    return SUCC;
+}
+
+int32_t VectorMinMax(Vector *self, bool bSigned, int64_t *pIdxMin,
+                     int64_t *pIdxMax)
+{
+    CHECK_INIT(self);
+    if (!pIdxMin && !pIdxMax)
+        return ERR_GET;
+    if (pIdxMin)
+        *pIdxMin = -1;
+    if (pIdxMax)
+        *pIdxMax = -1;
+
+    VectorData *pData = self->pData;
+    if (pData->iSize_ == 0)
+        return ERR_IDX;
+
+    uint64_t ulFlip = (bSigned)? 0 : SIGN_FLIP;
+    int64_t iIdxMin, iIdxMax;
+    switch (_VectorSimdLevel()) {
+#ifdef VECTOR_SIMD_X86
+        case SIMD_AVX2:
+            _VectorMinMaxAvx2(pData->aItem_, pData->iSize_, ulFlip,
+                              &iIdxMin, &iIdxMax);
+            break;
+        case SIMD_SSE42:
+            _VectorMinMaxSse42(pData->aItem_, pData->iSize_, ulFlip,
+                               &iIdxMin, &iIdxMax);
+            break;
+#endif
+        default:
+            _VectorMinMaxScalar(pData->aItem_, pData->iSize_, ulFlip,
+                                &iIdxMin, &iIdxMax);
+    }
+
+    if (pIdxMin)
+        *pIdxMin = iIdxMin;
+    if (pIdxMax)
+        *pIdxMax = iIdxMax;
+    return SUCC;
+}
+
+int32_t VectorFilter(Vector *self, Vector *pDst, Item itemLow, Item itemHigh,
+                     bool bSigned)
+{
+    CHECK_INIT(self);
+    CHECK_INIT(pDst);
+
+    uint64_t ulFlip = (bSigned)? 0 : SIGN_FLIP;
+    int64_t lLow = (int64_t)(ITEM_WORD(itemLow) ^ ulFlip);
+    int64_t lHigh = (int64_t)(ITEM_WORD(itemHigh) ^ ulFlip);
+    int32_t iLevel = _VectorSimdLevel();
+
+    /* Select the items block by block and append each block in bulk. The item
+       array is fetched again for each block in case the source vector is also
+       the destination. */
+    VectorData *pData = self->pData;
+    Item aBuf[SELECT_BLOCK_SIZE];
+    int64_t iSize = pData->iSize_;
+    int64_t iBgn;
+    for (iBgn = 0 ; iBgn < iSize ; iBgn += SELECT_BLOCK_SIZE) {
+        const Item *aItem = pData->aItem_ + iBgn;
+        int64_t iNum = iSize - iBgn;
+        if (iNum > SELECT_BLOCK_SIZE)
+            iNum = SELECT_BLOCK_SIZE;
+
+        int64_t iCount;
+        switch (iLevel) {
+#ifdef VECTOR_SIMD_X86
+            case SIMD_AVX2:
+                iCount = _VectorSelectAvx2(aItem, iNum, lLow, lHigh, ulFlip, aBuf);
+                break;
+            case SIMD_SSE42:
+                iCount = _VectorSelectSse42(aItem, iNum, lLow, lHigh, ulFlip, aBuf);
+                break;
+#endif
+            default:
+                iCount = _VectorSelectScalar(aItem, iNum, lLow, lHigh, ulFlip, aBuf);
+        }
+
+        if (iCount > 0) {
+            int32_t iRtn = VectorAppend(pDst, aBuf, iCount);
+            if (iRtn != SUCC)
+                return iRtn;
+        }
+    }
+    return SUCC;
+}
+
+int32_t VectorLowerBound(Vector *self, Item item,
+                         int32_t (*pFunc) (const void*, const void*), int64_t *pIdx)
+{
+    CHECK_INIT(self);
+    if (!pIdx)
+        return ERR_GET;
+
+    VectorData *pData = self->pData;
+    *pIdx = _VectorBound(pData->aItem_, pData->iSize_, item, pFunc, false);
+    return SUCC;
+}
+
+int32_t VectorUpperBound(Vector *self, Item item,
+                         int32_t (*pFunc) (const void*, const void*), int64_t *pIdx)
+{
+    CHECK_INIT(self);
+    if (!pIdx)
+        return ERR_GET;
+
+    VectorData *pData = self->pData;
+    *pIdx = _VectorBound(pData->aItem_, pData->iSize_, item, pFunc, true);
+    return SUCC;
+}
+
+int32_t VectorEqualRange(Vector *self, Item item,
+                         int32_t (*pFunc) (const void*, const void*),
+                         int64_t *pBgn, int64_t *pEnd)
+{
+    CHECK_INIT(self);
+    if ((!pBgn) || (!pEnd))
+        return ERR_GET;
+
+    /* The upper bound is searched only within the items after the lower one. */
+    VectorData *pData = self->pData;
+    int64_t iBgn = _VectorBound(pData->aItem_, pData->iSize_, item, pFunc, false);
+    *pBgn = iBgn;
+    *pEnd = iBgn + _VectorBound(pData->aItem_ + iBgn, pData->iSize_ - iBgn, item,
+                                pFunc, true);
+    return SUCC;
+}
+
+int32_t VectorInsertSorted(Vector *self, Item item,
+                           int32_t (*pFunc) (const void*, const void*))
+{
+    CHECK_INIT(self);
+    VectorData *pData = self->pData;
+    int64_t iIdx = _VectorBound(pData->aItem_, pData->iSize_, item, pFunc, true);
+    return VectorInsert(self, item, iIdx);
+}
+
+int32_t VectorMerge(Vector *self, Vector *pSrc,
+                    int32_t (*pFunc) (const void*, const void*))
+{
+    CHECK_INIT(self);
+    CHECK_INIT(pSrc);
+
+    VectorData *pData = self->pData;
+    int64_t iSizeSrc = pSrc->pData->iSize_;
+    if (iSizeSrc == 0)
+        return SUCC;
+
+    int32_t iRtnCode = _VectorReserve(pData, iSizeSrc);
+    if (iRtnCode != SUCC)
+        return iRtnCode;
+
+    /* Fill the extended array from the tail end. Each slot is written only after
+       the items stored there are consumed, which also holds when the source
+       vector is this vector itself. */
+    Item *aDst = pData->aItem_;
+    const Item *aSrc = pSrc->pData->aItem_;
+    int64_t iFst = pData->iSize_ - 1;
+    int64_t iSnd = iSizeSrc - 1;
+    int64_t iPos = pData->iSize_ + iSizeSrc - 1;
+    while ((iFst >= 0) && (iSnd >= 0)) {
+        if (pFunc(&aDst[iFst], &aSrc[iSnd]) > 0)
+            aDst[iPos--] = aDst[iFst--];
+        else
+            aDst[iPos--] = aSrc[iSnd--];
+    }
+    while (iSnd >= 0)
+        aDst[iPos--] = aSrc[iSnd--];
+
+    pData->iSize_ += iSizeSrc;
+    return SUCC;
+}
+
 int32_t VectorIterate(Vector *self, bool bReset, Item *pItem)
 {
     CHECK_INIT(self);
@@ -324,19 +1172,46 @@ int32_t VectorSetDestroy(Vector *self, void (*pFunc) (Item))
     return SUCC;
 }
 
+int32_t VectorSetGrowth(Vector *self, int32_t iPolicy, int64_t iChunk)
+{
+    CHECK_INIT(self);
+    if ((iPolicy != VECTOR_GROW_DOUBLE) && (iPolicy != VECTOR_GROW_HALF) &&
+        (iPolicy != VECTOR_GROW_CHUNK))
+        return ERR_POLICY;
+    if ((iPolicy == VECTOR_GROW_CHUNK) && (iChunk <= 0))
+        return ERR_POLICY;
+
+    self->pData->iGrowth_ = iPolicy;
+    self->pData->iChunk_ = iChunk;
+    return SUCC;
+}
+
+int32_t VectorSetStorage(Vector *self, int32_t iMode, const char *szPath)
+{
+    CHECK_INIT(self);
+    VectorData *pData = self->pData;
+    int32_t iRtn = StorageSwitch(&pData->store_, iMode, szPath);
+    if (iRtn != SUCC)
+        return iRtn;
+
+    pData->aItem_ = (Item*)pData->store_.pBase;
+    pData->iCapacity_ = pData->store_.ulSize / sizeof(Item);
+    return SUCC;
+}
+
 
 /*===========================================================================*
  *               Implementation for internal operations                      *
  *===========================================================================*/
 void _VectorItemDestroy(Item item) {}
 
-int32_t _VectorReisze(VectorData *pData, int32_t iSizeNew)
+int32_t _VectorReisze(VectorData *pData, int64_t iSizeNew)
 {
     /* Remove the trailing items if the new capacity is smaller than the old size.
        Clean the resource hold by the removed items if user defined destroy is
        set. */
     if ((iSizeNew < pData->iSize_)) {
-        int32_t iIdx = iSizeNew;
+        int64_t iIdx = iSizeNew;
         while (iIdx < pData->iSize_) {
             if (pData->bUserDestroy_)
                 pData->pDestroy_(pData->aItem_[iIdx]);
@@ -345,10 +1220,535 @@ int32_t _VectorReisze(VectorData *pData, int32_t iSizeNew)
         pData->iSize_ = iSizeNew;
     }
 
-    Item *aItemNew = (Item*)realloc(pData->aItem_, iSizeNew * sizeof(Item));
-    if (aItemNew) {
-        pData->aItem_ = aItemNew;
-        pData->iCapacity_ = iSizeNew;
+    if ((uint64_t)iSizeNew > SIZE_MAX / sizeof(Item))
+        return ERR_NOMEM;
+
+    int32_t iRtn = StorageResize(&pData->store_, iSizeNew * sizeof(Item));
+    if (iRtn != SUCC)
+        return iRtn;
+    pData->aItem_ = (Item*)pData->store_.pBase;
+    pData->iCapacity_ = pData->store_.ulSize / sizeof(Item);
+    return SUCC;
+}
+
+int32_t _VectorReserve(VectorData *pData, int64_t iNum)
+{
+    if (iNum > INT64_MAX - pData->iSize_)
+        return ERR_NOMEM;
+    int64_t iSizeReq = pData->iSize_ + iNum;
+    int64_t iCap = pData->iCapacity_;
+    if (iSizeReq <= iCap)
+        return SUCC;
+
+    /* Extend the storage with the growth policy, but at least hold all the
+       requested items. */
+    int64_t iCapNew;
+    if (pData->iGrowth_ == VECTOR_GROW_HALF)
+        iCapNew = iCap + (iCap >> 1);
+    else if (pData->iGrowth_ == VECTOR_GROW_CHUNK)
+        iCapNew = (iCap > INT64_MAX - pData->iChunk_)?
+                  INT64_MAX : iCap + pData->iChunk_;
+    else
+        iCapNew = (iCap > INT64_MAX / 2)? INT64_MAX : iCap * 2;
+
+    if (iCapNew < iSizeReq)
+        iCapNew = iSizeReq;
+    return _VectorReisze(pData, iCapNew);
+}
+
+SORT_DEFINE_MERGE(_VectorMergeSort, Item, SortCompare, ITEM_ORDER)
+
+void _VectorSiftDown(Item *aItem, int64_t iSize, int64_t iIdx, SortCompare pCompare)
+{
+    Item item = aItem[iIdx];
+    int64_t iChild;
+    while ((iChild = (iIdx << 1) + 1) < iSize) {
+        if ((iChild + 1 < iSize) &&
+            (pCompare(&aItem[iChild], &aItem[iChild + 1]) < 0))
+            iChild++;
+        if (pCompare(&item, &aItem[iChild]) >= 0)
+            break;
+        aItem[iIdx] = aItem[iChild];
+        iIdx = iChild;
+    }
+    aItem[iIdx] = item;
+    return;
+}
+
+void _VectorHeapSort(Item *aItem, int64_t iSize, SortCompare pCompare)
+{
+    int64_t iIdx;
+    for (iIdx = (iSize >> 1) - 1 ; iIdx >= 0 ; iIdx--)
+        _VectorSiftDown(aItem, iSize, iIdx, pCompare);
+
+    /* Move the heap root behind the shrinking heap one by one. */
+    for (iIdx = iSize - 1 ; iIdx > 0 ; iIdx--) {
+        Item item = aItem[0];
+        aItem[0] = aItem[iIdx];
+        aItem[iIdx] = item;
+        _VectorSiftDown(aItem, iIdx, 0, pCompare);
     }
-    return (aItemNew)? SUCC : ERR_NOMEM;
+    return;
 }
+
+void _VectorIntroSelect(Item *aItem, int64_t iSize, int64_t iNth,
+                        SortCompare pCompare)
+{
+    /* Allow twice the depth of the balanced partitions before falling back. */
+    int32_t iDepth = 0;
+    int64_t iSpan;
+    for (iSpan = iSize ; iSpan > 1 ; iSpan >>= 1)
+        iDepth += 2;
+
+    int64_t iLow = 0, iHigh = iSize;
+    Item item;
+    while (iHigh - iLow > SORT_RUN_SIZE) {
+        if (iDepth-- == 0) {
+            _VectorHeapSort(aItem + iLow, iHigh - iLow, pCompare);
+            return;
+        }
+
+        /* Order the first, middle, and last items so that the median becomes
+           the pivot and the outer two bound the partition scans. */
+        int64_t iMid = iLow + ((iHigh - 1 - iLow) >> 1);
+        int64_t iLast = iHigh - 1;
+        if (pCompare(&aItem[iMid], &aItem[iLow]) < 0) {
+            item = aItem[iMid]; aItem[iMid] = aItem[iLow]; aItem[iLow] = item;
+        }
+        if (pCompare(&aItem[iLast], &aItem[iMid]) < 0) {
+            item = aItem[iLast]; aItem[iLast] = aItem[iMid]; aItem[iMid] = item;
+            if (pCompare(&aItem[iMid], &aItem[iLow]) < 0) {
+                item = aItem[iMid]; aItem[iMid] = aItem[iLow]; aItem[iLow] = item;
+            }
+        }
+
+        /* Apply the Hoare partition. Items equal to the pivot may land on both
+           sides, which keeps the partitions balanced for repeated keys. */
+        Item pivot = aItem[iMid];
+        int64_t iFst = iLow - 1, iSnd = iHigh;
+        while (true) {
+            do {
+                iFst++;
+            } while (pCompare(&aItem[iFst], &pivot) < 0);
+            do {
+                iSnd--;
+            } while (pCompare(&pivot, &aItem[iSnd]) < 0);
+            if (iFst >= iSnd)
+                break;
+            item = aItem[iFst]; aItem[iFst] = aItem[iSnd]; aItem[iSnd] = item;
+        }
+
+        if (iNth <= iSnd)
+            iHigh = iSnd + 1;
+        else
+            iLow = iSnd + 1;
+    }
+
+    /* Finish the short range with insertion sort. */
+    int64_t iIdx;
+    for (iIdx = iLow + 1 ; iIdx < iHigh ; iIdx++) {
+        item = aItem[iIdx];
+        int64_t iPos = iIdx;
+        while ((iPos > iLow) && (pCompare(&item, &aItem[iPos - 1]) < 0)) {
+            aItem[iPos] = aItem[iPos - 1];
+            iPos--;
+        }
+        aItem[iPos] = item;
+    }
+    return;
+}
+
+int64_t _VectorMergePath(Item *aFst, int64_t iSizeFst, Item *aSnd,
+                         int64_t iSizeSnd, int64_t iRank, SortCompare pCompare)
+{
+    /* Find the smallest split such that the item of the first run at the split
+       is placed after the first iRank output items. The item of the first run
+       wins the tie to keep the merge stable. */
+    int64_t iLow = (iRank > iSizeSnd)? (iRank - iSizeSnd) : 0;
+    int64_t iHigh = (iRank < iSizeFst)? iRank : iSizeFst;
+    while (iLow < iHigh) {
+        int64_t iMid = iLow + ((iHigh - iLow) >> 1);
+        if (pCompare(&aFst[iMid], &aSnd[iRank - iMid - 1]) <= 0)
+            iLow = iMid + 1;
+        else
+            iHigh = iMid;
+    }
+    return iLow;
+}
+
+void* _VectorSortRun(void *pArg)
+{
+    SortRunTask *pTask = (SortRunTask*)pArg;
+    _VectorMergeSort(pTask->aItem_, pTask->aTmp_, pTask->iSize_, pTask->pCompare_);
+    return NULL;
+}
+
+void* _VectorSortMerge(void *pArg)
+{
+    SortMergeTask *pTask = (SortMergeTask*)pArg;
+    Item *aFst = pTask->aFst_;
+    Item *aSnd = pTask->aSnd_;
+    Item *aDst = pTask->aDst_;
+    SortCompare pCompare = pTask->pCompare_;
+
+    int64_t iFst = _VectorMergePath(aFst, pTask->iSizeFst_, aSnd, pTask->iSizeSnd_,
+                                    pTask->iBegin_, pCompare);
+    int64_t iSnd = pTask->iBegin_ - iFst;
+    int64_t iFstEnd = _VectorMergePath(aFst, pTask->iSizeFst_, aSnd,
+                                       pTask->iSizeSnd_, pTask->iEnd_, pCompare);
+    int64_t iSndEnd = pTask->iEnd_ - iFstEnd;
+
+    int64_t iOut = pTask->iBegin_;
+    while ((iFst < iFstEnd) && (iSnd < iSndEnd)) {
+        if (pCompare(&aSnd[iSnd], &aFst[iFst]) < 0)
+            aDst[iOut++] = aSnd[iSnd++];
+        else
+            aDst[iOut++] = aFst[iFst++];
+    }
+    if (iFst < iFstEnd)
+        memcpy(aDst + iOut, aFst + iFst, sizeof(Item) * (iFstEnd - iFst));
+    if (iSnd < iSndEnd)
+        memcpy(aDst + iOut, aSnd + iSnd, sizeof(Item) * (iSndEnd - iSnd));
+    return NULL;
+}
+
+void _VectorRunTasks(void* (*pFunc) (void*), void *aTask, size_t iSizeTask,
+                     int32_t iNum)
+{
+    pthread_t *aThread = NULL;
+    bool *aSpawn = NULL;
+    if (iNum > 1) {
+        aThread = (pthread_t*)malloc(sizeof(pthread_t) * iNum);
+        aSpawn = (bool*)calloc(iNum, sizeof(bool));
+    }
+
+    int32_t iIdx;
+    for (iIdx = 1 ; iIdx < iNum ; iIdx++) {
+        void *pTask = (char*)aTask + iSizeTask * iIdx;
+        if (aThread && aSpawn)
+            aSpawn[iIdx] = (pthread_create(&aThread[iIdx], NULL, pFunc, pTask) == 0);
+        if (!aSpawn || !aSpawn[iIdx])
+            pFunc(pTask);
+    }
+    if (iNum > 0)
+        pFunc(aTask);
+
+    for (iIdx = 1 ; iIdx < iNum ; iIdx++) {
+        if (aSpawn && aSpawn[iIdx])
+            pthread_join(aThread[iIdx], NULL);
+    }
+
+    free(aSpawn);
+    free(aThread);
+    return;
+}
+
+int32_t _VectorSimdLevel()
+{
+#ifdef VECTOR_SIMD_X86
+    static int32_t iLevel = -1;
+    if (iLevel < 0) {
+        if (__builtin_cpu_supports("avx2"))
+            iLevel = SIMD_AVX2;
+        else if (__builtin_cpu_supports("sse4.2"))
+            iLevel = SIMD_SSE42;
+        else
+            iLevel = SIMD_SSE2;
+    }
+    return iLevel;
+#else
+    return SIMD_NONE;
+#endif
+}
+
+int64_t _VectorFindScalar(const Item *aItem, int64_t iSize, Item item)
+{
+    int64_t iIdx;
+    for (iIdx = 0 ; iIdx < iSize ; iIdx++) {
+        if (aItem[iIdx] == item)
+            return iIdx;
+    }
+    return -1;
+}
+
+int64_t _VectorCountScalar(const Item *aItem, int64_t iSize, Item item)
+{
+    int64_t iCount = 0, iIdx;
+    for (iIdx = 0 ; iIdx < iSize ; iIdx++)
+        iCount += (aItem[iIdx] == item);
+    return iCount;
+}
+
+void _VectorMinMaxScalar(const Item *aItem, int64_t iSize, uint64_t ulFlip,
+                         int64_t *pIdxMin, int64_t *pIdxMax)
+{
+    int64_t lMin = (int64_t)(ITEM_WORD(aItem[0]) ^ ulFlip);
+    int64_t lMax = lMin;
+    int64_t iIdxMin = 0, iIdxMax = 0, iIdx;
+    for (iIdx = 1 ; iIdx < iSize ; iIdx++) {
+        int64_t lWord = (int64_t)(ITEM_WORD(aItem[iIdx]) ^ ulFlip);
+        if (lWord < lMin) {
+            lMin = lWord;
+            iIdxMin = iIdx;
+        }
+        if (lWord > lMax) {
+            lMax = lWord;
+            iIdxMax = iIdx;
+        }
+    }
+    *pIdxMin = iIdxMin;
+    *pIdxMax = iIdxMax;
+    return;
+}
+
+int64_t _VectorSelectScalar(const Item *aItem, int64_t iSize, int64_t lLow,
+                            int64_t lHigh, uint64_t ulFlip, Item *aOut)
+{
+    int64_t iCount = 0, iIdx;
+    for (iIdx = 0 ; iIdx < iSize ; iIdx++) {
+        int64_t lWord = (int64_t)(ITEM_WORD(aItem[iIdx]) ^ ulFlip);
+        aOut[iCount] = aItem[iIdx];
+        iCount += (lWord >= lLow) & (lWord <= lHigh);
+    }
+    return iCount;
+}
+
+#ifdef VECTOR_SIMD_X86
+__attribute__((target("sse2")))
+int64_t _VectorFindSse2(const Item *aItem, int64_t iSize, Item item)
+{
+    /* SSE2 lacks the 64 bit equality, so both 32 bit halves should match. */
+    __m128i vKey = _mm_set1_epi64x((int64_t)ITEM_WORD(item));
+    int64_t iIdx = 0;
+    for ( ; iIdx + 2 <= iSize ; iIdx += 2) {
+        __m128i vWord = _mm_loadu_si128((const __m128i*)(aItem + iIdx));
+        __m128i vEq = _mm_cmpeq_epi32(vWord, vKey);
+        vEq = _mm_and_si128(vEq, _mm_shuffle_epi32(vEq, _MM_SHUFFLE(2, 3, 0, 1)));
+        int32_t iMask = _mm_movemask_pd(_mm_castsi128_pd(vEq));
+        if (iMask)
+            return iIdx + __builtin_ctz(iMask);
+    }
+    int64_t iRest = _VectorFindScalar(aItem + iIdx, iSize - iIdx, item);
+    return (iRest < 0)? -1 : iIdx + iRest;
+}
+
+__attribute__((target("avx2")))
+int64_t _VectorFindAvx2(const Item *aItem, int64_t iSize, Item item)
+{
+    __m256i vKey = _mm256_set1_epi64x((int64_t)ITEM_WORD(item));
+    int64_t iIdx = 0;
+    for ( ; iIdx + 8 <= iSize ; iIdx += 8) {
+        __m256i vFst = _mm256_loadu_si256((const __m256i*)(aItem + iIdx));
+        __m256i vSnd = _mm256_loadu_si256((const __m256i*)(aItem + iIdx + 4));
+        int32_t iMaskFst = _mm256_movemask_pd(
+                           _mm256_castsi256_pd(_mm256_cmpeq_epi64(vFst, vKey)));
+        int32_t iMaskSnd = _mm256_movemask_pd(
+                           _mm256_castsi256_pd(_mm256_cmpeq_epi64(vSnd, vKey)));
+        int32_t iMask = iMaskFst | (iMaskSnd << 4);
+        if (iMask)
+            return iIdx + __builtin_ctz(iMask);
+    }
+    int64_t iRest = _VectorFindScalar(aItem + iIdx, iSize - iIdx, item);
+    return (iRest < 0)? -1 : iIdx + iRest;
+}
+
+__attribute__((target("sse2")))
+int64_t _VectorCountSse2(const Item *aItem, int64_t iSize, Item item)
+{
+    __m128i vKey = _mm_set1_epi64x((int64_t)ITEM_WORD(item));
+    __m128i vCount = _mm_setzero_si128();
+    int64_t iIdx = 0;
+    for ( ; iIdx + 2 <= iSize ; iIdx += 2) {
+        __m128i vWord = _mm_loadu_si128((const __m128i*)(aItem + iIdx));
+        __m128i vEq = _mm_cmpeq_epi32(vWord, vKey);
+        vEq = _mm_and_si128(vEq, _mm_shuffle_epi32(vEq, _MM_SHUFFLE(2, 3, 0, 1)));
+        vCount = _mm_sub_epi64(vCount, vEq);
+    }
+    int64_t aLane[2];
+    _mm_storeu_si128((__m128i*)aLane, vCount);
+    return aLane[0] + aLane[1] +
+           _VectorCountScalar(aItem + iIdx, iSize - iIdx, item);
+}
+
+__attribute__((target("avx2")))
+int64_t _VectorCountAvx2(const Item *aItem, int64_t iSize, Item item)
+{
+    __m256i vKey = _mm256_set1_epi64x((int64_t)ITEM_WORD(item));
+    __m256i vCount = _mm256_setzero_si256();
+    int64_t iIdx = 0;
+    for ( ; iIdx + 4 <= iSize ; iIdx += 4) {
+        __m256i vWord = _mm256_loadu_si256((const __m256i*)(aItem + iIdx));
+        vCount = _mm256_sub_epi64(vCount, _mm256_cmpeq_epi64(vWord, vKey));
+    }
+    int64_t aLane[4];
+    _mm256_storeu_si256((__m256i*)aLane, vCount);
+    return aLane[0] + aLane[1] + aLane[2] + aLane[3] +
+           _VectorCountScalar(aItem + iIdx, iSize - iIdx, item);
+}
+
+__attribute__((target("sse4.2")))
+void _VectorMinMaxSse42(const Item *aItem, int64_t iSize, uint64_t ulFlip,
+                        int64_t *pIdxMin, int64_t *pIdxMax)
+{
+    if (iSize < 4) {
+        _VectorMinMaxScalar(aItem, iSize, ulFlip, pIdxMin, pIdxMax);
+        return;
+    }
+
+    /* Each lane keeps its own extremes and their first indexes. */
+    __m128i vFlip = _mm_set1_epi64x((int64_t)ulFlip);
+    __m128i vMin = _mm_xor_si128(_mm_loadu_si128((const __m128i*)aItem), vFlip);
+    __m128i vMax = vMin;
+    __m128i vIdx = _mm_set_epi64x(1, 0);
+    __m128i vIdxMin = vIdx, vIdxMax = vIdx;
+    __m128i vStep = _mm_set1_epi64x(2);
+    int64_t iIdx = 2;
+    for ( ; iIdx + 2 <= iSize ; iIdx += 2) {
+        vIdx = _mm_add_epi64(vIdx, vStep);
+        __m128i vWord = _mm_xor_si128(
+                        _mm_loadu_si128((const __m128i*)(aItem + iIdx)), vFlip);
+        __m128i vLess = _mm_cmpgt_epi64(vMin, vWord);
+        __m128i vMore = _mm_cmpgt_epi64(vWord, vMax);
+        vMin = _mm_blendv_epi8(vMin, vWord, vLess);
+        vIdxMin = _mm_blendv_epi8(vIdxMin, vIdx, vLess);
+        vMax = _mm_blendv_epi8(vMax, vWord, vMore);
+        vIdxMax = _mm_blendv_epi8(vIdxMax, vIdx, vMore);
+    }
+
+    int64_t aMin[2], aMax[2], aIdxMin[2], aIdxMax[2];
+    _mm_storeu_si128((__m128i*)aMin, vMin);
+    _mm_storeu_si128((__m128i*)aMax, vMax);
+    _mm_storeu_si128((__m128i*)aIdxMin, vIdxMin);
+    _mm_storeu_si128((__m128i*)aIdxMax, vIdxMax);
+    _VectorReduceMinMax(aMin, aIdxMin, aMax, aIdxMax, 2, aItem, iIdx, iSize,
+                        ulFlip, pIdxMin, pIdxMax);
+    return;
+}
+
+__attribute__((target("avx2")))
+void _VectorMinMaxAvx2(const Item *aItem, int64_t iSize, uint64_t ulFlip,
+                       int64_t *pIdxMin, int64_t *pIdxMax)
+{
+    if (iSize < 8) {
+        _VectorMinMaxScalar(aItem, iSize, ulFlip, pIdxMin, pIdxMax);
+        return;
+    }
+
+    __m256i vFlip = _mm256_set1_epi64x((int64_t)ulFlip);
+    __m256i vMin = _mm256_xor_si256(
+                   _mm256_loadu_si256((const __m256i*)aItem), vFlip);
+    __m256i vMax = vMin;
+    __m256i vIdx = _mm256_set_epi64x(3, 2, 1, 0);
+    __m256i vIdxMin = vIdx, vIdxMax = vIdx;
+    __m256i vStep = _mm256_set1_epi64x(4);
+    int64_t iIdx = 4;
+    for ( ; iIdx + 4 <= iSize ; iIdx += 4) {
+        vIdx = _mm256_add_epi64(vIdx, vStep);
+        __m256i vWord = _mm256_xor_si256(
+                        _mm256_loadu_si256((const __m256i*)(aItem + iIdx)), vFlip);
+        __m256i vLess = _mm256_cmpgt_epi64(vMin, vWord);
+        __m256i vMore = _mm256_cmpgt_epi64(vWord, vMax);
+        vMin = _mm256_blendv_epi8(vMin, vWord, vLess);
+        vIdxMin = _mm256_blendv_epi8(vIdxMin, vIdx, vLess);
+        vMax = _mm256_blendv_epi8(vMax, vWord, vMore);
+        vIdxMax = _mm256_blendv_epi8(vIdxMax, vIdx, vMore);
+    }
+
+    int64_t aMin[4], aMax[4], aIdxMin[4], aIdxMax[4];
+    _mm256_storeu_si256((__m256i*)aMin, vMin);
+    _mm256_storeu_si256((__m256i*)aMax, vMax);
+    _mm256_storeu_si256((__m256i*)aIdxMin, vIdxMin);
+    _mm256_storeu_si256((__m256i*)aIdxMax, vIdxMax);
+    _VectorReduceMinMax(aMin, aIdxMin, aMax, aIdxMax, 4, aItem, iIdx, iSize,
+                        ulFlip, pIdxMin, pIdxMax);
+    return;
+}
+
+__attribute__((target("sse4.2")))
+int64_t _VectorSelectSse42(const Item *aItem, int64_t iSize, int64_t lLow,
+                           int64_t lHigh, uint64_t ulFlip, Item *aOut)
+{
+    __m128i vFlip = _mm_set1_epi64x((int64_t)ulFlip);
+    __m128i vLow = _mm_set1_epi64x(lLow);
+    __m128i vHigh = _mm_set1_epi64x(lHigh);
+    int64_t iCount = 0, iIdx = 0;
+    for ( ; iIdx + 2 <= iSize ; iIdx += 2) {
+        __m128i vWord = _mm_xor_si128(
+                        _mm_loadu_si128((const __m128i*)(aItem + iIdx)), vFlip);
+        __m128i vOut = _mm_or_si128(_mm_cmpgt_epi64(vLow, vWord),
+                                    _mm_cmpgt_epi64(vWord, vHigh));
+        int32_t iMask = ~_mm_movemask_pd(_mm_castsi128_pd(vOut)) & 0x3;
+        while (iMask) {
+            aOut[iCount++] = aItem[iIdx + __builtin_ctz(iMask)];
+            iMask &= iMask - 1;
+        }
+    }
+    return iCount + _VectorSelectScalar(aItem + iIdx, iSize - iIdx, lLow, lHigh,
+                                        ulFlip, aOut + iCount);
+}
+
+__attribute__((target("avx2")))
+int64_t _VectorSelectAvx2(const Item *aItem, int64_t iSize, int64_t lLow,
+                          int64_t lHigh, uint64_t ulFlip, Item *aOut)
+{
+    __m256i vFlip = _mm256_set1_epi64x((int64_t)ulFlip);
+    __m256i vLow = _mm256_set1_epi64x(lLow);
+    __m256i vHigh = _mm256_set1_epi64x(lHigh);
+    int64_t iCount = 0, iIdx = 0;
+    for ( ; iIdx + 4 <= iSize ; iIdx += 4) {
+        __m256i vWord = _mm256_xor_si256(
+                        _mm256_loadu_si256((const __m256i*)(aItem + iIdx)), vFlip);
+        __m256i vOut = _mm256_or_si256(_mm256_cmpgt_epi64(vLow, vWord),
+                                       _mm256_cmpgt_epi64(vWord, vHigh));
+        int32_t iMask = ~_mm256_movemask_pd(_mm256_castsi256_pd(vOut)) & 0xf;
+        while (iMask) {
+            aOut[iCount++] = aItem[iIdx + __builtin_ctz(iMask)];
+            iMask &= iMask - 1;
+        }
+    }
+    return iCount + _VectorSelectScalar(aItem + iIdx, iSize - iIdx, lLow, lHigh,
+                                        ulFlip, aOut + iCount);
+}
+
+void _VectorReduceMinMax(int64_t *aMin, int64_t *aIdxMin, int64_t *aMax,
+                         int64_t *aIdxMax, int32_t iLane, const Item *aItem,
+                         int64_t iIdx, int64_t iSize, uint64_t ulFlip,
+                         int64_t *pIdxMin, int64_t *pIdxMax)
+{
+    /* Merge the lanes and prefer the smaller index for the equal extremes. */
+    int64_t lMin = aMin[0], lMax = aMax[0];
+    int64_t iIdxMin = aIdxMin[0], iIdxMax = aIdxMax[0];
+    int32_t iPos;
+    for (iPos = 1 ; iPos < iLane ; iPos++) {
+        if ((aMin[iPos] < lMin) ||
+            ((aMin[iPos] == lMin) && (aIdxMin[iPos] < iIdxMin))) {
+            lMin = aMin[iPos];
+            iIdxMin = aIdxMin[iPos];
+        }
+        if ((aMax[iPos] > lMax) ||
+            ((aMax[iPos] == lMax) && (aIdxMax[iPos] < iIdxMax))) {
+            lMax = aMax[iPos];
+            iIdxMax = aIdxMax[iPos];
+        }
+    }
+
+    /* Visit the trailing items which do not fill a whole register. */
+    for ( ; iIdx < iSize ; iIdx++) {
+        int64_t lWord = (int64_t)(ITEM_WORD(aItem[iIdx]) ^ ulFlip);
+        if (lWord < lMin) {
+            lMin = lWord;
+            iIdxMin = iIdx;
+        }
+        if (lWord > lMax) {
+            lMax = lWord;
+            iIdxMax = iIdx;
+        }
+    }
+
+    *pIdxMin = iIdxMin;
+    *pIdxMax = iIdxMax;
+    return;
+}
+#endif
+
+SORT_DEFINE_BOUND(_VectorBound, Item, Item, SortCompare, ITEM_ORDER_PROBE)
@@ -0,0 +1,362 @@
+#include "container/art_map.h"
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+
+
+/*------------------------------------------------------------*
+ * Test Function Declaration for basic structure verification *
+ *------------------------------------------------------------*/
+int32_t AddBasicSuite();
+void TestBasicOperation();
+void TestPrefixKey();
+void TestNodeLayout();
+
+void DestroyEntry(ArtEntry*);
+
+
+/*------------------------------------------------------------*
+ *    Test Function Declaration for bulk data manipulation    *
+ *------------------------------------------------------------*/
+#define COUNT_BULK          (6000)
+#define SIZE_BULK_KEY       (24)
+
+int32_t AddBulkSuite();
+void TestBulkOrder();
+
+typedef struct _Record {
+    int32_t iSize;
+    bool bAlive;
+    uint8_t aKey[SIZE_BULK_KEY];
+} Record;
+
+int32_t CompareRecord(const void*, const void*);
+int32_t CompareEntry(ArtEntry*, Record*);
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    /* Register the test suite for basic structure verification. */
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Register the test suite for bulk data manipulation. */
+    if (AddBulkSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Basic Suite        *
+ *------------------------------------------------------------*/
+int32_t iDestroy;
+
+void DestroyEntry(ArtEntry *pEntry) { iDestroy++; }
+
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Basic Structure Verification", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Entry insertion and deletion",
+                     TestBasicOperation);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Keys prefixing the other keys", TestPrefixKey);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Node growth and shrinking", TestNodeLayout);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBasicOperation()
+{
+    ArtMap *pMap;
+    CU_ASSERT(ArtMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyEntry) == SUCC);
+    iDestroy = 0;
+
+    ArtEntry *pEntry;
+    CU_ASSERT(pMap->minimum(pMap, &pEntry) == ERR_IDX);
+    CU_ASSERT(pMap->put(pMap, "apple", 5, (Value)1) == SUCC);
+    CU_ASSERT(pMap->put(pMap, "apply", 5, (Value)2) == SUCC);
+    CU_ASSERT(pMap->put(pMap, "banana", 6, (Value)3) == SUCC);
+    CU_ASSERT(pMap->put(pMap, "apple", 5, (Value)4) == SUCC);
+    CU_ASSERT_EQUAL(iDestroy, 1);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 3);
+
+    CU_ASSERT(pMap->put(pMap, NULL, 3, (Value)5) == ERR_KEYSIZE);
+    CU_ASSERT(pMap->put(pMap, "x", -1, (Value)5) == ERR_KEYSIZE);
+
+    Value value;
+    CU_ASSERT(pMap->get(pMap, "apple", 5, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)4);
+    CU_ASSERT(pMap->get(pMap, "appl", 4, &value) == ERR_NODATA);
+    CU_ASSERT(pMap->get(pMap, "apple", 5, NULL) == ERR_GET);
+    CU_ASSERT(pMap->find(pMap, "apply", 5) == SUCC);
+    CU_ASSERT(pMap->find(pMap, "applz", 5) == NOKEY);
+
+    CU_ASSERT(pMap->minimum(pMap, &pEntry) == SUCC);
+    CU_ASSERT_EQUAL(pEntry->value, (Value)4);
+    CU_ASSERT(pMap->maximum(pMap, &pEntry) == SUCC);
+    CU_ASSERT_EQUAL(pEntry->iSize, 6);
+    CU_ASSERT(memcmp(pEntry->key, "banana", 6) == 0);
+
+    CU_ASSERT(pMap->remove(pMap, "apple", 5) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, "apple", 5) == ERR_NODATA);
+    CU_ASSERT_EQUAL(iDestroy, 2);
+    CU_ASSERT(pMap->find(pMap, "apply", 5) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, "banana", 6) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, "apply", 5) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 0);
+    CU_ASSERT(pMap->maximum(pMap, &pEntry) == ERR_IDX);
+
+    CU_ASSERT(pMap->put(pMap, "cherry", 6, (Value)6) == SUCC);
+    ArtMapDeinit(&pMap);
+    CU_ASSERT_EQUAL(iDestroy, 5);
+    CU_ASSERT(ArtMapSize(pMap) == ERR_NOINIT);
+}
+
+void TestPrefixKey()
+{
+    ArtMap *pMap;
+    CU_ASSERT(ArtMapInit(&pMap) == SUCC);
+
+    /* The empty key and the keys prefixing each other, including the paths
+       longer than the inline part of the nodes. */
+    char *aKey[] = {"", "a", "ab", "abcdefghijklmnop", "abcdefghijklmnopq",
+                    "abcdefghijklmnoz", "abcdefghijk", "b"};
+    int32_t iIdx;
+    for (iIdx = 7 ; iIdx >= 0 ; iIdx--) {
+        CU_ASSERT(pMap->put(pMap, aKey[iIdx], strlen(aKey[iIdx]),
+                            (Value)(intptr_t)iIdx) == SUCC);
+    }
+    CU_ASSERT_EQUAL(pMap->size(pMap), 8);
+    for (iIdx = 0 ; iIdx < 8 ; iIdx++)
+        CU_ASSERT(pMap->find(pMap, aKey[iIdx], strlen(aKey[iIdx])) == SUCC);
+    CU_ASSERT(pMap->find(pMap, "abcdefghijklmno", 15) == NOKEY);
+    CU_ASSERT(pMap->find(pMap, "abcdefghijklxnop", 16) == NOKEY);
+
+    /* The shorter key goes first. */
+    int32_t iOrder[] = {0, 1, 2, 6, 3, 4, 5, 7};
+    ArtEntry *pEntry;
+    iIdx = 0;
+    CU_ASSERT(pMap->iterate(pMap, true, NULL) == SUCC);
+    while (pMap->iterate(pMap, false, &pEntry) == CONTINUE) {
+        CU_ASSERT_EQUAL(pEntry->value, (Value)(intptr_t)iOrder[iIdx]);
+        iIdx++;
+    }
+    CU_ASSERT_EQUAL(iIdx, 8);
+
+    iIdx = 4;
+    CU_ASSERT(pMap->iterate_prefix(pMap, true, "abcdefghijklmn", 14, NULL)
+              == SUCC);
+    while (pMap->iterate_prefix(pMap, false, NULL, 0, &pEntry) == CONTINUE) {
+        CU_ASSERT_EQUAL(pEntry->value, (Value)(intptr_t)iOrder[iIdx]);
+        iIdx++;
+    }
+    CU_ASSERT_EQUAL(iIdx, 7);
+    CU_ASSERT(pMap->iterate_prefix(pMap, true, "abcdefghijklmx", 14, NULL)
+              == SUCC);
+    CU_ASSERT(pMap->iterate_prefix(pMap, false, NULL, 0, &pEntry) == END);
+
+    /* Removing the keys hung on the inner nodes joins the paths. */
+    CU_ASSERT(pMap->remove(pMap, "abcdefghijk", 11) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, "abcdefghijklmnoz", 16) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, "ab", 2) == SUCC);
+    CU_ASSERT(pMap->find(pMap, "abcdefghijklmnopq", 17) == SUCC);
+    CU_ASSERT(pMap->find(pMap, "abcdefghijklmnop", 16) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, "", 0) == SUCC);
+    CU_ASSERT(pMap->find(pMap, NULL, 0) == NOKEY);
+    CU_ASSERT(pMap->put(pMap, "abcdefghijklmnoq", 16, (Value)8) == SUCC);
+    CU_ASSERT(pMap->find(pMap, "abcdefghijklmnop", 16) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 5);
+
+    ArtMapDeinit(&pMap);
+}
+
+void TestNodeLayout()
+{
+    ArtMap *pMap;
+    CU_ASSERT(ArtMapInit(&pMap) == SUCC);
+
+    /* The node grows through all the layouts with the keys differing in the
+       last byte. */
+    uint8_t aKey[2];
+    int32_t iIdx;
+    aKey[0] = 'k';
+    for (iIdx = 255 ; iIdx >= 0 ; iIdx--) {
+        aKey[1] = iIdx;
+        CU_ASSERT(pMap->put(pMap, aKey, 2, (Value)(intptr_t)iIdx) == SUCC);
+    }
+
+    ArtEntry *pEntry;
+    iIdx = 0;
+    CU_ASSERT(pMap->iterate(pMap, true, NULL) == SUCC);
+    while (pMap->iterate(pMap, false, &pEntry) == CONTINUE) {
+        CU_ASSERT_EQUAL(pEntry->value, (Value)(intptr_t)iIdx);
+        iIdx++;
+    }
+    CU_ASSERT_EQUAL(iIdx, 256);
+
+    /* Remove the even bytes and then the odd bytes to shrink the node. */
+    int32_t iRound;
+    for (iRound = 0 ; iRound < 2 ; iRound++) {
+        for (iIdx = iRound ; iIdx < 256 ; iIdx += 2) {
+            aKey[1] = iIdx;
+            CU_ASSERT(pMap->remove(pMap, aKey, 2) == SUCC);
+            int32_t iNext = (iIdx + 2 < 256)? (iIdx + 2) :
+                            ((iRound == 0)? 1 : 256);
+            if (iNext < 256) {
+                aKey[1] = iNext;
+                CU_ASSERT(pMap->find(pMap, aKey, 2) == SUCC);
+            }
+        }
+    }
+    CU_ASSERT_EQUAL(pMap->size(pMap), 0);
+
+    ArtMapDeinit(&pMap);
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Bulk Suite         *
+ *------------------------------------------------------------*/
+int32_t AddBulkSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Bulk data manipulation", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Order against sorted keys",
+                     TestBulkOrder);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+int32_t CompareRecord(const void *pSrc, const void *pTge)
+{
+    Record *pRecSrc = (Record*)pSrc;
+    Record *pRecTge = (Record*)pTge;
+    int32_t iSize = (pRecSrc->iSize < pRecTge->iSize)?
+                    pRecSrc->iSize : pRecTge->iSize;
+    int32_t iOrder = memcmp(pRecSrc->aKey, pRecTge->aKey, iSize);
+    if (iOrder != 0)
+        return iOrder;
+    return pRecSrc->iSize - pRecTge->iSize;
+}
+
+int32_t CompareEntry(ArtEntry *pEntry, Record *pRec)
+{
+    if (pEntry->iSize != pRec->iSize)
+        return 1;
+    return memcmp(pEntry->key, pRec->aKey, pRec->iSize);
+}
+
+void TestBulkOrder()
+{
+    ArtMap *pMap;
+    CU_ASSERT(ArtMapInit(&pMap) == SUCC);
+
+    /* The keys over a few bytes, including 0 and 255, collide on the paths. */
+    static const uint8_t aByte[] = {0, 1, 'a', 'b', 0x7f, 0x80, 0xff};
+    Record *aRec = (Record*)malloc(sizeof(Record) * COUNT_BULK);
+    srand(23);
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_BULK ; iIdx++) {
+        Record *pRec = &aRec[iIdx];
+        pRec->iSize = rand() % SIZE_BULK_KEY;
+        int32_t iOfst;
+        for (iOfst = 0 ; iOfst < pRec->iSize ; iOfst++)
+            pRec->aKey[iOfst] = (iOfst < 10 && (rand() % 4))?
+                                'p' : aByte[rand() % 7];
+        pRec->bAlive = true;
+    }
+    qsort(aRec, COUNT_BULK, sizeof(Record), CompareRecord);
+
+    /* Drop the duplicated keys. */
+    int32_t iNum = 1;
+    for (iIdx = 1 ; iIdx < COUNT_BULK ; iIdx++) {
+        if (CompareRecord(&aRec[iNum - 1], &aRec[iIdx]) != 0)
+            aRec[iNum++] = aRec[iIdx];
+    }
+
+    for (iIdx = iNum - 1 ; iIdx >= 0 ; iIdx--) {
+        CU_ASSERT(pMap->put(pMap, aRec[iIdx].aKey, aRec[iIdx].iSize,
+                            (Value)(intptr_t)iIdx) == SUCC);
+    }
+    for (iIdx = 0 ; iIdx < iNum ; iIdx += 3) {
+        CU_ASSERT(pMap->remove(pMap, aRec[iIdx].aKey, aRec[iIdx].iSize)
+                  == SUCC);
+        aRec[iIdx].bAlive = false;
+    }
+    CU_ASSERT_EQUAL(pMap->size(pMap), iNum - (iNum + 2) / 3);
+
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        CU_ASSERT_EQUAL(pMap->find(pMap, aRec[iIdx].aKey, aRec[iIdx].iSize),
+                        (aRec[iIdx].bAlive)? SUCC : NOKEY);
+    }
+
+    /* The iteration follows the sorted order of the alive keys. */
+    ArtEntry *pEntry;
+    int32_t iPos = 0;
+    CU_ASSERT(pMap->iterate(pMap, true, NULL) == SUCC);
+    while (pMap->iterate(pMap, false, &pEntry) == CONTINUE) {
+        while (!(aRec[iPos].bAlive))
+            iPos++;
+        CU_ASSERT(CompareEntry(pEntry, &aRec[iPos]) == 0);
+        CU_ASSERT_EQUAL(pEntry->value, (Value)(intptr_t)iPos);
+        iPos++;
+    }
+
+    /* Each prefix scan reports a contiguous run of the sorted keys. */
+    for (iIdx = 1 ; iIdx < iNum ; iIdx += 37) {
+        Record *pPrefix = &aRec[iIdx];
+        int32_t iSize = pPrefix->iSize / 2;
+        int32_t iExpect = 0;
+        for (iPos = 0 ; iPos < iNum ; iPos++) {
+            if (aRec[iPos].bAlive && (aRec[iPos].iSize >= iSize) &&
+                (memcmp(aRec[iPos].aKey, pPrefix->aKey, iSize) == 0))
+                iExpect++;
+        }
+
+        int32_t iCount = 0;
+        CU_ASSERT(pMap->iterate_prefix(pMap, true, pPrefix->aKey, iSize, NULL)
+                  == SUCC);
+        while (pMap->iterate_prefix(pMap, false, NULL, 0, &pEntry) == CONTINUE) {
+            CU_ASSERT(memcmp(pEntry->key, pPrefix->aKey, iSize) == 0);
+            iCount++;
+        }
+        CU_ASSERT_EQUAL(iCount, iExpect);
+    }
+
+    ArtMapDeinit(&pMap);
+    free(aRec);
+}
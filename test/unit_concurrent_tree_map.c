@@ -0,0 +1,297 @@
+#include "container/concurrent_tree_map.h"
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+#include <pthread.h>
+
+
+/*------------------------------------------------------------*
+ * Test Function Declaration for basic structure verification *
+ *------------------------------------------------------------*/
+#define COUNT_KEY           (1000)
+
+int32_t AddBasicSuite();
+void TestBasicOperation();
+void TestView();
+
+void DestroyPair(Pair*);
+Pair* MakePair(intptr_t, intptr_t);
+
+
+/*------------------------------------------------------------*
+ *   Test Function Declaration for concurrent manipulation    *
+ *------------------------------------------------------------*/
+#define COUNT_READER        (4)
+#define COUNT_ROUND         (20000)
+#define COUNT_STABLE        (512)
+#define BASE_VOLATILE       (COUNT_STABLE)
+#define COUNT_VOLATILE      (256)
+
+typedef struct Shared_ {
+    ConcurrentTreeMap *pMap;
+    bool bStop;
+    int32_t iFault;
+} Shared;
+
+int32_t AddConcurrentSuite();
+void TestReadWhileWrite();
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    /* Register the test suite for basic structure verification. */
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Register the test suite for concurrent manipulation. */
+    if (AddConcurrentSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Basic Suite        *
+ *------------------------------------------------------------*/
+void DestroyPair(Pair *pPair) { free(pPair); }
+
+Pair* MakePair(intptr_t iKey, intptr_t iValue)
+{
+    Pair *pPair = (Pair*)malloc(sizeof(Pair));
+    pPair->key = (void*)iKey;
+    pPair->value = (void*)iValue;
+    return pPair;
+}
+
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Basic Structure Verification", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Pair insertion, search, and deletion",
+                                 TestBasicOperation);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Consistent views", TestView);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBasicOperation()
+{
+    ConcurrentTreeMap *pMap;
+    CU_ASSERT(ConcurrentTreeMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyPair) == SUCC);
+
+    intptr_t iKey;
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey++)
+        CU_ASSERT(pMap->put(pMap, MakePair(iKey, iKey)) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_KEY);
+
+    /* Replace the values of the odd keys. */
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey += 2)
+        CU_ASSERT(pMap->put(pMap, MakePair(iKey, -iKey)) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_KEY);
+
+    Value value;
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey++) {
+        CU_ASSERT(pMap->find(pMap, (Key)iKey) == SUCC);
+        CU_ASSERT(pMap->get(pMap, (Key)iKey, &value) == SUCC);
+        CU_ASSERT_EQUAL((intptr_t)value, (iKey & 1)? -iKey : iKey);
+    }
+    CU_ASSERT(pMap->find(pMap, (Key)(COUNT_KEY + 1)) == NOKEY);
+    CU_ASSERT(pMap->get(pMap, (Key)(COUNT_KEY + 1), &value) == ERR_NODATA);
+    CU_ASSERT(pMap->get(pMap, (Key)1, NULL) == ERR_GET);
+
+    /* Delete the even keys. */
+    for (iKey = 2 ; iKey <= COUNT_KEY ; iKey += 2)
+        CU_ASSERT(pMap->remove(pMap, (Key)iKey) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, (Key)2) == ERR_NODATA);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_KEY / 2);
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey++) {
+        int32_t iRtn = pMap->find(pMap, (Key)iKey);
+        CU_ASSERT_EQUAL(iRtn, (iKey & 1)? SUCC : NOKEY);
+    }
+
+    ConcurrentTreeMapDeinit(&pMap);
+}
+
+void TestView()
+{
+    ConcurrentTreeMap *pMap;
+    CU_ASSERT(ConcurrentTreeMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyPair) == SUCC);
+
+    /* The view of the empty map has nothing to iterate. */
+    Pair *pPair;
+    ConcurrentTreeMapView viewOld, viewNew;
+    CU_ASSERT(pMap->view_open(pMap, &viewOld) == SUCC);
+    CU_ASSERT(pMap->view_iterate(pMap, &viewOld, true, NULL) == SUCC);
+    CU_ASSERT(pMap->view_iterate(pMap, &viewOld, false, &pPair) == END);
+    CU_ASSERT(pMap->view_close(pMap, &viewOld) == SUCC);
+    CU_ASSERT(pMap->view_close(pMap, &viewOld) == ERR_GET);
+
+    intptr_t iKey;
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey++)
+        CU_ASSERT(pMap->put(pMap, MakePair(iKey, iKey)) == SUCC);
+    CU_ASSERT(pMap->view_open(pMap, &viewOld) == SUCC);
+
+    /* The writes after opening the view are invisible to it. */
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey += 2)
+        CU_ASSERT(pMap->remove(pMap, (Key)iKey) == SUCC);
+    for (iKey = 2 ; iKey <= COUNT_KEY ; iKey += 2)
+        CU_ASSERT(pMap->put(pMap, MakePair(iKey, -iKey)) == SUCC);
+    CU_ASSERT(pMap->view_open(pMap, &viewNew) == SUCC);
+
+    Value value;
+    CU_ASSERT(pMap->view_get(pMap, &viewOld, (Key)1, &value) == SUCC);
+    CU_ASSERT_EQUAL((intptr_t)value, 1);
+    CU_ASSERT(pMap->view_get(pMap, &viewOld, (Key)2, &value) == SUCC);
+    CU_ASSERT_EQUAL((intptr_t)value, 2);
+    CU_ASSERT(pMap->view_get(pMap, &viewNew, (Key)1, &value) == ERR_NODATA);
+    CU_ASSERT(pMap->view_get(pMap, &viewNew, (Key)2, &value) == SUCC);
+    CU_ASSERT_EQUAL((intptr_t)value, -2);
+
+    int32_t iCount = 0;
+    CU_ASSERT(pMap->view_iterate(pMap, &viewOld, true, NULL) == SUCC);
+    while (pMap->view_iterate(pMap, &viewOld, false, &pPair) == SUCC) {
+        iCount++;
+        CU_ASSERT_EQUAL((intptr_t)pPair->key, iCount);
+        CU_ASSERT_EQUAL((intptr_t)pPair->value, iCount);
+    }
+    CU_ASSERT_EQUAL(iCount, COUNT_KEY);
+
+    /* Scan the range from the key missing in the newer view. */
+    iKey = COUNT_KEY / 2 + 1;
+    CU_ASSERT(pMap->view_seek(pMap, &viewNew, (Key)iKey) == SUCC);
+    while (pMap->view_iterate(pMap, &viewNew, false, &pPair) == SUCC) {
+        iKey++;
+        CU_ASSERT_EQUAL((intptr_t)pPair->key, iKey);
+        CU_ASSERT_EQUAL((intptr_t)pPair->value, -iKey);
+        iKey++;
+    }
+    CU_ASSERT_EQUAL(iKey, COUNT_KEY + 1);
+
+    CU_ASSERT(pMap->view_close(pMap, &viewOld) == SUCC);
+    CU_ASSERT(pMap->view_close(pMap, &viewNew) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_KEY / 2);
+
+    ConcurrentTreeMapDeinit(&pMap);
+}
+
+
+/*------------------------------------------------------------*
+ *     Test Function Implementation for Concurrent Suite      *
+ *------------------------------------------------------------*/
+int32_t AddConcurrentSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Concurrent Manipulation", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Lock free reads during the writes",
+                                 TestReadWhileWrite);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void* ReadRoutine(void *pArg)
+{
+    Shared *pShared = (Shared*)pArg;
+    ConcurrentTreeMap *pMap = pShared->pMap;
+    int32_t iFault = 0;
+    intptr_t iKey = 0;
+
+    while (!__atomic_load_n(&(pShared->bStop), __ATOMIC_ACQUIRE)) {
+        /* The stable keys are never absent from any version. */
+        Value value;
+        iKey = (iKey + 7) % COUNT_STABLE;
+        if (pMap->get(pMap, (Key)iKey, &value) != SUCC ||
+            (intptr_t)value != iKey)
+            iFault++;
+
+        /* Each view should be sorted and match its own size. */
+        Pair *pPair;
+        ConcurrentTreeMapView view;
+        pMap->view_open(pMap, &view);
+        int32_t iCount = 0;
+        intptr_t iPrev = -1;
+        pMap->view_iterate(pMap, &view, true, NULL);
+        while (pMap->view_iterate(pMap, &view, false, &pPair) == SUCC) {
+            if ((intptr_t)pPair->key <= iPrev)
+                iFault++;
+            iPrev = (intptr_t)pPair->key;
+            iCount++;
+        }
+        if (iCount != view.snap.iSize)
+            iFault++;
+        pMap->view_close(pMap, &view);
+    }
+
+    __atomic_fetch_add(&(pShared->iFault), iFault, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+void TestReadWhileWrite()
+{
+    Shared shared;
+    CU_ASSERT(ConcurrentTreeMapInit(&(shared.pMap)) == SUCC);
+    ConcurrentTreeMap *pMap = shared.pMap;
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyPair) == SUCC);
+    shared.bStop = false;
+    shared.iFault = 0;
+
+    intptr_t iKey;
+    for (iKey = 0 ; iKey < COUNT_STABLE ; iKey++)
+        CU_ASSERT(pMap->put(pMap, MakePair(iKey, iKey)) == SUCC);
+
+    pthread_t aThrd[COUNT_READER];
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_READER ; iIdx++)
+        pthread_create(&aThrd[iIdx], NULL, ReadRoutine, &shared);
+
+    /* Keep churning the volatile keys and replacing the stable pairs. */
+    int32_t iRound;
+    for (iRound = 0 ; iRound < COUNT_ROUND ; iRound++) {
+        iKey = BASE_VOLATILE + (iRound % COUNT_VOLATILE);
+        if ((iRound / COUNT_VOLATILE) & 1)
+            pMap->remove(pMap, (Key)iKey);
+        else
+            pMap->put(pMap, MakePair(iKey, iKey));
+        iKey = iRound % COUNT_STABLE;
+        pMap->put(pMap, MakePair(iKey, iKey));
+    }
+
+    __atomic_store_n(&(shared.bStop), true, __ATOMIC_RELEASE);
+    for (iIdx = 0 ; iIdx < COUNT_READER ; iIdx++)
+        pthread_join(aThrd[iIdx], NULL);
+
+    CU_ASSERT_EQUAL(shared.iFault, 0);
+    CU_ASSERT(pMap->size(pMap) >= COUNT_STABLE);
+
+    ConcurrentTreeMapDeinit(&pMap);
+}
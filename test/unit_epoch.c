@@ -0,0 +1,143 @@
+#include "memory/epoch.h"
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+
+
+/*------------------------------------------------------------*
+ *     Test Function Declaration for memory reclamation       *
+ *------------------------------------------------------------*/
+#define COUNT_NODE  (8)
+
+int32_t AddBasicSuite();
+void TestReclaim();
+void TestActiveReader();
+void TestFlush();
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *    Test Function implementation for memory reclamation     *
+ *------------------------------------------------------------*/
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Epoch Reclamation", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Reclamation after two advances",
+                                 TestReclaim);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Advance blocked by readers", TestActiveReader);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Flush of retired objects", TestFlush);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+int32_t CountList(EpochNode *pNode)
+{
+    int32_t iCount = 0;
+    while (pNode) {
+        iCount++;
+        pNode = pNode->pNext;
+    }
+    return iCount;
+}
+
+void TestReclaim()
+{
+    Epoch epoch;
+    EpochNode aNode[COUNT_NODE];
+    CU_ASSERT(EpochInit(&epoch) == SUCC);
+
+    /* Nothing is reclaimed before the epoch advances twice. */
+    CU_ASSERT(EpochReclaim(&epoch) == NULL);
+    EpochRetire(&epoch, &aNode[0]);
+    EpochRetire(&epoch, &aNode[1]);
+    CU_ASSERT(EpochReclaim(&epoch) == NULL);
+
+    /* The objects retired later stay behind the earlier ones. */
+    EpochRetire(&epoch, &aNode[2]);
+    EpochNode *pList = EpochReclaim(&epoch);
+    CU_ASSERT(pList == &aNode[0]);
+    CU_ASSERT_EQUAL(CountList(pList), 2);
+    CU_ASSERT(EpochReclaim(&epoch) == &aNode[2]);
+    CU_ASSERT(EpochReclaim(&epoch) == NULL);
+
+    EpochDeinit(&epoch);
+}
+
+void TestActiveReader()
+{
+    Epoch epoch;
+    EpochNode aNode[COUNT_NODE];
+    CU_ASSERT(EpochInit(&epoch) == SUCC);
+
+    /* The reader entering before the retirement pins the object. */
+    uint32_t uiTicket = EpochEnter(&epoch);
+    EpochRetire(&epoch, &aNode[0]);
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_NODE ; iIdx++)
+        CU_ASSERT(EpochReclaim(&epoch) == NULL);
+
+    /* So does the reader entering after it until it exits. */
+    EpochExit(&epoch, uiTicket);
+    uiTicket = EpochEnter(&epoch);
+    EpochRetire(&epoch, &aNode[1]);
+    CU_ASSERT(EpochReclaim(&epoch) == &aNode[0]);
+    for (iIdx = 0 ; iIdx < COUNT_NODE ; iIdx++)
+        CU_ASSERT(EpochReclaim(&epoch) == NULL);
+    EpochExit(&epoch, uiTicket);
+    CU_ASSERT(EpochReclaim(&epoch) == &aNode[1]);
+
+    EpochDeinit(&epoch);
+}
+
+void TestFlush()
+{
+    Epoch epoch;
+    EpochNode aNode[COUNT_NODE];
+    CU_ASSERT(EpochInit(&epoch) == SUCC);
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_NODE ; iIdx++)
+        EpochRetire(&epoch, &aNode[iIdx]);
+
+    EpochNode *pList = EpochFlush(&epoch);
+    CU_ASSERT(pList == &aNode[0]);
+    CU_ASSERT_EQUAL(CountList(pList), COUNT_NODE);
+    CU_ASSERT(EpochFlush(&epoch) == NULL);
+    CU_ASSERT(EpochReclaim(&epoch) == NULL);
+
+    EpochDeinit(&epoch);
+}
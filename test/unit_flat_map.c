@@ -0,0 +1,377 @@
+#include "container/flat_map.h"
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+
+
+/*------------------------------------------------------------*
+ * Test Function Declaration for basic structure verification *
+ *------------------------------------------------------------*/
+int32_t AddBasicSuite();
+void TestBasicInsert();
+void TestBoundary();
+void TestIterator();
+
+int32_t CompareBasicKey(Key, Key);
+
+
+/*------------------------------------------------------------*
+ *    Test Function Declaration for bulk data manipulation    *
+ *------------------------------------------------------------*/
+#define SIZE_MID_TEST       (10000)
+#define RANGE_KEY           (4000)
+
+int32_t AddBulkSuite();
+void TestBuild();
+void TestPutBatch();
+
+int32_t iCountDestroy;
+void CountDestroy(Pair*);
+void DestroyBulkPair(Pair*);
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    /* Register the test suite for basic structure verification. */
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Register the test suite for bulk data manipulation. */
+    if (AddBulkSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Basic Suite        *
+ *------------------------------------------------------------*/
+int32_t CompareBasicKey(Key keySrc, Key keyTge)
+{
+    if (keySrc == keyTge)
+        return 0;
+    return (keySrc > keyTge)? 1 : (-1);
+}
+
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Basic Structure Verification", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Pair insertion and removal",
+                     TestBasicInsert);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Key search and boundary case handling",
+            TestBoundary);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Map iterator", TestIterator);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBasicInsert()
+{
+    FlatMap *pMap;
+    CU_ASSERT(FlatMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_compare(pMap, CompareBasicKey) == SUCC);
+
+    /* The pairs are copied, so the same structure can be reused. */
+    Pair pair;
+    intptr_t aKey[] = {10, 4, 15, 1, 6, 22, 7, 20, 25, 9};
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 10 ; iIdx++) {
+        pair.key = (void*)aKey[iIdx];
+        pair.value = (void*)(aKey[iIdx] * 10);
+        CU_ASSERT(pMap->put(pMap, &pair) == SUCC);
+    }
+    CU_ASSERT_EQUAL(pMap->size(pMap), 10);
+    CU_ASSERT(pMap->put(pMap, NULL) == ERR_GET);
+
+    /* Replace the value of an existing key. */
+    pair.key = (void*)6;
+    pair.value = (void*)66;
+    CU_ASSERT(pMap->put(pMap, &pair) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 10);
+
+    Value value;
+    CU_ASSERT(pMap->get(pMap, (Key)6, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)66);
+    CU_ASSERT(pMap->get(pMap, (Key)22, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)220);
+    CU_ASSERT(pMap->get(pMap, (Key)5, &value) == ERR_NODATA);
+    CU_ASSERT_EQUAL(value, NULL);
+    CU_ASSERT(pMap->get(pMap, (Key)5, NULL) == ERR_GET);
+
+    CU_ASSERT(pMap->find(pMap, (Key)25) == SUCC);
+    CU_ASSERT(pMap->find(pMap, (Key)26) == NOKEY);
+
+    /* Remove the pairs at the head, the middle, and the tail. */
+    CU_ASSERT(pMap->remove(pMap, (Key)1) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, (Key)10) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, (Key)25) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, (Key)25) == ERR_NODATA);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 7);
+    CU_ASSERT(pMap->find(pMap, (Key)10) == NOKEY);
+    CU_ASSERT(pMap->find(pMap, (Key)9) == SUCC);
+
+    FlatMapDeinit(&pMap);
+}
+
+void TestBoundary()
+{
+    FlatMap *pMap;
+    CU_ASSERT(FlatMapInit(&pMap) == SUCC);
+
+    Pair *pPair;
+    CU_ASSERT(pMap->minimum(pMap, &pPair) == ERR_IDX);
+    CU_ASSERT(pMap->maximum(pMap, &pPair) == ERR_IDX);
+    CU_ASSERT(pMap->minimum(pMap, NULL) == ERR_GET);
+    CU_ASSERT(pMap->predecessor(pMap, (Key)1, &pPair) == ERR_NODATA);
+    CU_ASSERT(pMap->successor(pMap, (Key)1, &pPair) == ERR_NODATA);
+
+    Pair pair;
+    intptr_t lKey;
+    for (lKey = 2 ; lKey <= 20 ; lKey += 2) {
+        pair.key = (void*)lKey;
+        pair.value = NULL;
+        CU_ASSERT(pMap->put(pMap, &pair) == SUCC);
+    }
+
+    CU_ASSERT(pMap->minimum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (void*)2);
+    CU_ASSERT(pMap->maximum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (void*)20);
+
+    /* The neighbors are found for both the stored and the absent keys. */
+    CU_ASSERT(pMap->predecessor(pMap, (Key)8, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (void*)6);
+    CU_ASSERT(pMap->predecessor(pMap, (Key)9, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (void*)8);
+    CU_ASSERT(pMap->successor(pMap, (Key)8, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (void*)10);
+    CU_ASSERT(pMap->successor(pMap, (Key)9, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (void*)10);
+    CU_ASSERT(pMap->predecessor(pMap, (Key)2, &pPair) == ERR_NODATA);
+    CU_ASSERT_EQUAL(pPair, NULL);
+    CU_ASSERT(pMap->successor(pMap, (Key)20, &pPair) == ERR_NODATA);
+    CU_ASSERT_EQUAL(pPair, NULL);
+
+    FlatMapDeinit(&pMap);
+    CU_ASSERT(FlatMapSize(pMap) == ERR_NOINIT);
+}
+
+void TestIterator()
+{
+    FlatMap *pMap;
+    CU_ASSERT(FlatMapInit(&pMap) == SUCC);
+
+    Pair pair;
+    intptr_t lKey;
+    for (lKey = 9 ; lKey >= 0 ; lKey--) {
+        pair.key = (void*)lKey;
+        pair.value = NULL;
+        CU_ASSERT(pMap->put(pMap, &pair) == SUCC);
+    }
+
+    Pair *pPair;
+    bool bOrder = true;
+    lKey = 0;
+    CU_ASSERT(pMap->iterate(pMap, true, NULL) == SUCC);
+    while (pMap->iterate(pMap, false, &pPair) != END) {
+        if (pPair->key != (void*)lKey)
+            bOrder = false;
+        lKey++;
+    }
+    CU_ASSERT(bOrder);
+    CU_ASSERT_EQUAL(lKey, 10);
+    CU_ASSERT(pMap->iterate(pMap, false, NULL) == ERR_GET);
+
+    lKey = 9;
+    CU_ASSERT(pMap->reverse_iterate(pMap, true, NULL) == SUCC);
+    while (pMap->reverse_iterate(pMap, false, &pPair) != END) {
+        if (pPair->key != (void*)lKey)
+            bOrder = false;
+        lKey--;
+    }
+    CU_ASSERT(bOrder);
+    CU_ASSERT_EQUAL(lKey, -1);
+
+    FlatMapDeinit(&pMap);
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Bulk Suite         *
+ *------------------------------------------------------------*/
+void CountDestroy(Pair *pPair)
+{
+    iCountDestroy++;
+}
+
+void DestroyBulkPair(Pair *pPair)
+{
+    free(pPair->value);
+}
+
+int32_t AddBulkSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Bulk Data Manipulation", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Bulk build with deduplication",
+                     TestBuild);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Batched insertion with merge", TestPutBatch);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void PrepareBulkPairs(Pair *aPair, int32_t iNum, uint32_t uiSeed)
+{
+    /* The value records the array position so that the winner of the duplicated
+       keys can be verified. */
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        uiSeed = uiSeed * 1103515245u + 12345u;
+        aPair[iIdx].key = (void*)(intptr_t)((uiSeed >> 8) % RANGE_KEY);
+        aPair[iIdx].value = (void*)(intptr_t)iIdx;
+    }
+}
+
+bool CheckBulkMap(FlatMap *pMap, intptr_t *aExpect)
+{
+    /* Verify the pairs against the table indexed by key. */
+    int32_t iCount = 0;
+    intptr_t lKey;
+    for (lKey = 0 ; lKey < RANGE_KEY ; lKey++)
+        iCount += (aExpect[lKey] >= 0);
+    if (pMap->size(pMap) != iCount)
+        return false;
+
+    Pair *pPair;
+    intptr_t lPrev = -1;
+    pMap->iterate(pMap, true, NULL);
+    while (pMap->iterate(pMap, false, &pPair) != END) {
+        lKey = (intptr_t)pPair->key;
+        if ((lKey <= lPrev) || (aExpect[lKey] != (intptr_t)pPair->value))
+            return false;
+        lPrev = lKey;
+    }
+    return true;
+}
+
+void TestBuild()
+{
+    FlatMap *pMap;
+    CU_ASSERT(FlatMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, CountDestroy) == SUCC);
+    CU_ASSERT(pMap->build(pMap, NULL, 1) == ERR_IDX);
+    CU_ASSERT(pMap->build(pMap, NULL, -1) == ERR_IDX);
+
+    Pair *aPair = (Pair*)malloc(sizeof(Pair) * SIZE_MID_TEST);
+    intptr_t *aExpect = (intptr_t*)malloc(sizeof(intptr_t) * RANGE_KEY);
+    PrepareBulkPairs(aPair, SIZE_MID_TEST, 17);
+
+    /* The last pair of the duplicated keys wins. */
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < RANGE_KEY ; iIdx++)
+        aExpect[iIdx] = -1;
+    for (iIdx = 0 ; iIdx < SIZE_MID_TEST ; iIdx++)
+        aExpect[(intptr_t)aPair[iIdx].key] = (intptr_t)aPair[iIdx].value;
+
+    iCountDestroy = 0;
+    CU_ASSERT(pMap->build(pMap, aPair, SIZE_MID_TEST) == SUCC);
+    CU_ASSERT(CheckBulkMap(pMap, aExpect));
+    CU_ASSERT_EQUAL(iCountDestroy, SIZE_MID_TEST - pMap->size(pMap));
+
+    /* Rebuild the map with fewer pairs. */
+    int32_t iSize = pMap->size(pMap);
+    iCountDestroy = 0;
+    CU_ASSERT(pMap->build(pMap, aPair, 3) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 3);
+    CU_ASSERT_EQUAL(iCountDestroy, iSize);
+
+    iCountDestroy = 0;
+    CU_ASSERT(pMap->build(pMap, NULL, 0) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 0);
+    CU_ASSERT_EQUAL(iCountDestroy, 3);
+
+    free(aExpect);
+    free(aPair);
+    FlatMapDeinit(&pMap);
+}
+
+void TestPutBatch()
+{
+    FlatMap *pMap;
+    CU_ASSERT(FlatMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->put_batch(pMap, NULL, 1) == ERR_IDX);
+    CU_ASSERT(pMap->put_batch(pMap, NULL, 0) == SUCC);
+
+    Pair *aPair = (Pair*)malloc(sizeof(Pair) * SIZE_MID_TEST);
+    intptr_t *aExpect = (intptr_t*)malloc(sizeof(intptr_t) * RANGE_KEY);
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < RANGE_KEY ; iIdx++)
+        aExpect[iIdx] = -1;
+
+    /* Merge the batches of various sizes into the map. The later batches
+       overlap the stored keys heavily. */
+    int32_t aSize[] = {1, 7, 100, 1000, SIZE_MID_TEST};
+    int32_t iBatch;
+    bool bMatch = true;
+    for (iBatch = 0 ; iBatch < sizeof(aSize) / sizeof(int32_t) ; iBatch++) {
+        PrepareBulkPairs(aPair, aSize[iBatch], 31 + iBatch);
+        for (iIdx = 0 ; iIdx < aSize[iBatch] ; iIdx++)
+            aExpect[(intptr_t)aPair[iIdx].key] = (intptr_t)aPair[iIdx].value;
+        CU_ASSERT(pMap->put_batch(pMap, aPair, aSize[iBatch]) == SUCC);
+        if (!CheckBulkMap(pMap, aExpect))
+            bMatch = false;
+    }
+    CU_ASSERT(bMatch);
+    FlatMapDeinit(&pMap);
+
+    /* The replaced and the dropped pairs are released. */
+    CU_ASSERT(FlatMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyBulkPair) == SUCC);
+    for (iBatch = 0 ; iBatch < 3 ; iBatch++) {
+        PrepareBulkPairs(aPair, 1000, 7);
+        for (iIdx = 0 ; iIdx < 1000 ; iIdx++)
+            aPair[iIdx].value = malloc(sizeof(int32_t));
+        CU_ASSERT(pMap->put_batch(pMap, aPair, 1000) == SUCC);
+    }
+    CU_ASSERT(pMap->remove(pMap, aPair[0].key) == SUCC);
+    FlatMapDeinit(&pMap);
+
+    free(aExpect);
+    free(aPair);
+}
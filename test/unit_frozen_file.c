@@ -0,0 +1,153 @@
+#include "memory/frozen_file.h"
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+
+
+/*------------------------------------------------------------*
+ *       Test Function Declaration for the frozen file        *
+ *------------------------------------------------------------*/
+#define PATH_DIR        "/tmp/unit_frozen_file.d"
+#define PATH_FROZEN     PATH_DIR "/frozen"
+#define MAGIC_TEST      "CDSTEST"
+#define VERSION_TEST    (3)
+#define SIZE_FILE       (10000)
+
+int32_t AddBasicSuite();
+void TestCommit();
+void TestAbort();
+
+int32_t CountEntry();
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    mkdir(PATH_DIR, 0755);
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+    unlink(PATH_FROZEN);
+    rmdir(PATH_DIR);
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *      Test Function implementation for the frozen file      *
+ *------------------------------------------------------------*/
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Frozen File", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Commit and open", TestCommit);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Abort and failure", TestAbort);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+int32_t CountEntry()
+{
+    DIR *pDir = opendir(PATH_DIR);
+    if (!pDir)
+        return -1;
+    int32_t iCount = 0;
+    struct dirent *pEnt;
+    while ((pEnt = readdir(pDir))) {
+        if (pEnt->d_name[0] != '.')
+            iCount++;
+    }
+    closedir(pDir);
+    return iCount;
+}
+
+void TestCommit()
+{
+    FrozenFile file;
+    CU_ASSERT(FrozenFileCreate(&file, PATH_FROZEN, SIZE_FILE) == SUCC);
+    CU_ASSERT_EQUAL(file.ulSize, SIZE_FILE);
+
+    /* The path is not created until the commit. */
+    CU_ASSERT(access(PATH_FROZEN, F_OK) != 0);
+    memset(file.pBase + sizeof(FrozenFileHead), 0x5a,
+           SIZE_FILE - sizeof(FrozenFileHead));
+    CU_ASSERT(FrozenFileCommit(&file, PATH_FROZEN, MAGIC_TEST,
+                               VERSION_TEST) == SUCC);
+    CU_ASSERT_EQUAL(file.pBase, NULL);
+    CU_ASSERT_EQUAL(CountEntry(), 1);
+
+    uint8_t *pBase;
+    size_t ulSize;
+    CU_ASSERT(FrozenFileOpen(PATH_FROZEN, MAGIC_TEST, VERSION_TEST,
+                             sizeof(FrozenFileHead), &pBase, &ulSize) == SUCC);
+    CU_ASSERT_EQUAL(ulSize, SIZE_FILE);
+    CU_ASSERT_EQUAL(pBase[SIZE_FILE - 1], 0x5a);
+
+    /* The commit replaces the path, and the old mapping stays intact. */
+    CU_ASSERT(FrozenFileCreate(&file, PATH_FROZEN, 100) == SUCC);
+    CU_ASSERT(FrozenFileCommit(&file, PATH_FROZEN, MAGIC_TEST,
+                               VERSION_TEST) == SUCC);
+    CU_ASSERT_EQUAL(pBase[SIZE_FILE - 1], 0x5a);
+    FrozenFileClose(pBase, ulSize);
+    CU_ASSERT(FrozenFileOpen(PATH_FROZEN, MAGIC_TEST, VERSION_TEST,
+                             sizeof(FrozenFileHead), &pBase, &ulSize) == SUCC);
+    CU_ASSERT_EQUAL(ulSize, 100);
+    FrozenFileClose(pBase, ulSize);
+
+    /* The mismatched head and the short file are rejected. */
+    CU_ASSERT(FrozenFileOpen(PATH_FROZEN, "CDSELSE", VERSION_TEST,
+                             sizeof(FrozenFileHead), &pBase, &ulSize) == ERR_IO);
+    CU_ASSERT(FrozenFileOpen(PATH_FROZEN, MAGIC_TEST, VERSION_TEST + 1,
+                             sizeof(FrozenFileHead), &pBase, &ulSize) == ERR_IO);
+    CU_ASSERT(FrozenFileOpen(PATH_FROZEN, MAGIC_TEST, VERSION_TEST,
+                             101, &pBase, &ulSize) == ERR_IO);
+    CU_ASSERT(truncate(PATH_FROZEN, 50) == 0);
+    CU_ASSERT(FrozenFileOpen(PATH_FROZEN, MAGIC_TEST, VERSION_TEST,
+                             sizeof(FrozenFileHead), &pBase, &ulSize) == ERR_IO);
+    CU_ASSERT(unlink(PATH_FROZEN) == 0);
+}
+
+void TestAbort()
+{
+    FrozenFile file;
+    CU_ASSERT(FrozenFileCreate(&file, "/nonexistent/dir/file", 100) == ERR_IO);
+
+    /* The aborted file leaves nothing behind. */
+    CU_ASSERT(FrozenFileCreate(&file, PATH_FROZEN, SIZE_FILE) == SUCC);
+    CU_ASSERT_EQUAL(CountEntry(), 1);
+    FrozenFileAbort(&file);
+    CU_ASSERT_EQUAL(CountEntry(), 0);
+    CU_ASSERT(access(PATH_FROZEN, F_OK) != 0);
+
+    /* The failed rename removes the temporary file. */
+    CU_ASSERT(mkdir(PATH_FROZEN, 0755) == 0);
+    CU_ASSERT(FrozenFileCreate(&file, PATH_FROZEN, SIZE_FILE) == SUCC);
+    CU_ASSERT(FrozenFileCommit(&file, PATH_FROZEN, MAGIC_TEST,
+                               VERSION_TEST) == ERR_IO);
+    CU_ASSERT_EQUAL(CountEntry(), 1);
+    CU_ASSERT(rmdir(PATH_FROZEN) == 0);
+}
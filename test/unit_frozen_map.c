@@ -0,0 +1,386 @@
+#include "container/frozen_map.h"
+#include <unistd.h>
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+
+
+/*------------------------------------------------------------*
+ * Test Function Declaration for basic structure verification *
+ *------------------------------------------------------------*/
+#define PATH_FROZEN         "/tmp/unit_frozen_map.frozen"
+#define SIZE_NAME           (8)
+#define COUNT_REFREEZE      (1000)
+
+int32_t AddBasicSuite();
+void TestIntegerKey();
+void TestSizedKey();
+void TestIllegalFile();
+void TestRefreeze();
+
+int32_t CompareName(Key, Key);
+
+
+/*------------------------------------------------------------*
+ *    Test Function Declaration for bulk data manipulation    *
+ *------------------------------------------------------------*/
+#define COUNT_BULK          (5000)
+#define RANGE_KEY           (20000)
+
+int32_t AddBulkSuite();
+void TestBulkQuery();
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    /* Register the test suite for basic structure verification. */
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Register the test suite for bulk data manipulation. */
+    if (AddBulkSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+    unlink(PATH_FROZEN);
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Basic Suite        *
+ *------------------------------------------------------------*/
+int32_t CompareName(Key keySrc, Key keyTge)
+{
+    int32_t iOrder = memcmp(keySrc, keyTge, SIZE_NAME);
+    return (iOrder > 0)? 1 : ((iOrder < 0)? (-1) : 0);
+}
+
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Basic Structure Verification", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Integer keys and values",
+                     TestIntegerKey);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Fixed size keys and values", TestSizedKey);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Illegal frozen file", TestIllegalFile);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Freeze over an opened file", TestRefreeze);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestIntegerKey()
+{
+    TreeMap *pTree;
+    CU_ASSERT(TreeMapInit(&pTree) == SUCC);
+    CU_ASSERT(pTree->set_pair_mode(pTree, TREE_MAP_PAIR_INLINE) == SUCC);
+
+    /* Freeze the even keys within [2, 20]. */
+    Pair pair;
+    intptr_t iKey;
+    for (iKey = 20 ; iKey > 0 ; iKey -= 2) {
+        pair.key = (void*)iKey;
+        pair.value = (void*)(iKey * 10);
+        CU_ASSERT(pTree->put(pTree, &pair) == SUCC);
+    }
+    CU_ASSERT(FrozenMapFreeze(pTree, PATH_FROZEN, 0, 0) == SUCC);
+    CU_ASSERT(FrozenMapFreeze(NULL, PATH_FROZEN, 0, 0) == ERR_NOINIT);
+    CU_ASSERT(FrozenMapFreeze(pTree, NULL, 0, 0) == ERR_IDX);
+    TreeMapDeinit(&pTree);
+
+    FrozenMap *pMap;
+    CU_ASSERT(FrozenMapInit(&pMap) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 0);
+    Pair *pPair;
+    CU_ASSERT(pMap->minimum(pMap, &pPair) == ERR_IDX);
+    CU_ASSERT(pMap->open(pMap, PATH_FROZEN) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 10);
+
+    Value value;
+    CU_ASSERT(pMap->get(pMap, (Key)8, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)80);
+    CU_ASSERT(pMap->get(pMap, (Key)9, &value) == ERR_NODATA);
+    CU_ASSERT(pMap->get(pMap, (Key)8, NULL) == ERR_GET);
+    CU_ASSERT(pMap->find(pMap, (Key)20) == SUCC);
+    CU_ASSERT(pMap->find(pMap, (Key)0) == NOKEY);
+
+    CU_ASSERT(pMap->minimum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)2);
+    CU_ASSERT(pMap->maximum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)20);
+    CU_ASSERT(pMap->predecessor(pMap, (Key)8, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)6);
+    CU_ASSERT(pMap->predecessor(pMap, (Key)2, &pPair) == ERR_NODATA);
+    CU_ASSERT(pMap->predecessor(pMap, (Key)7, &pPair) == ERR_NODATA);
+    CU_ASSERT(pMap->successor(pMap, (Key)8, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->value, (Value)100);
+    CU_ASSERT(pMap->successor(pMap, (Key)20, &pPair) == ERR_NODATA);
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)7, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)8);
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)21, &pPair) == ERR_NODATA);
+    CU_ASSERT(pMap->upper_bound(pMap, (Key)8, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)10);
+    CU_ASSERT(pMap->upper_bound(pMap, (Key)20, &pPair) == ERR_NODATA);
+
+    /* Scan all the pairs and then the range [5, 11). */
+    iKey = 2;
+    CU_ASSERT(pMap->iterate(pMap, true, NULL) == SUCC);
+    while (pMap->iterate(pMap, false, &pPair) == SUCC) {
+        CU_ASSERT_EQUAL(pPair->key, (Key)iKey);
+        iKey += 2;
+    }
+    CU_ASSERT_EQUAL(iKey, 22);
+    iKey = 6;
+    CU_ASSERT(pMap->iterate_range(pMap, true, (Key)5, (Key)11, NULL) == SUCC);
+    while (pMap->iterate_range(pMap, false, NULL, NULL, &pPair) == SUCC) {
+        CU_ASSERT_EQUAL(pPair->key, (Key)iKey);
+        iKey += 2;
+    }
+    CU_ASSERT_EQUAL(iKey, 12);
+
+    FrozenMapDeinit(&pMap);
+    CU_ASSERT(FrozenMapSize(pMap) == ERR_NOINIT);
+}
+
+void TestSizedKey()
+{
+    /* The names are copied into the file, so the buffers can go away. */
+    static const char *aName[] = {"delta", "alpha", "echo", "charlie", "bravo"};
+    TreeMap *pTree;
+    CU_ASSERT(TreeMapInit(&pTree) == SUCC);
+    CU_ASSERT(pTree->set_compare(pTree, CompareName) == SUCC);
+    char aBuf[5][SIZE_NAME];
+    int64_t aRank[5];
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 5 ; iIdx++) {
+        memset(aBuf[iIdx], 0, SIZE_NAME);
+        strcpy(aBuf[iIdx], aName[iIdx]);
+        aRank[iIdx] = aName[iIdx][0] - 'a';
+        Pair *pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = aBuf[iIdx];
+        pPair->value = &aRank[iIdx];
+        CU_ASSERT(pTree->put(pTree, pPair) == SUCC);
+    }
+    CU_ASSERT(pTree->set_destroy(pTree, (void (*) (Pair*))free) == SUCC);
+    CU_ASSERT(FrozenMapFreeze(pTree, PATH_FROZEN, SIZE_NAME,
+                              sizeof(int64_t)) == SUCC);
+    TreeMapDeinit(&pTree);
+    memset(aBuf, 0, sizeof(aBuf));
+
+    FrozenMap *pMap;
+    CU_ASSERT(FrozenMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_compare(pMap, CompareName) == SUCC);
+    CU_ASSERT(pMap->open(pMap, PATH_FROZEN) == SUCC);
+
+    char aKey[SIZE_NAME] = "charlie";
+    Value value;
+    CU_ASSERT(pMap->get(pMap, aKey, &value) == SUCC);
+    CU_ASSERT_EQUAL(*(int64_t*)value, 2);
+
+    Pair *pPair;
+    CU_ASSERT(pMap->successor(pMap, aKey, &pPair) == SUCC);
+    CU_ASSERT(strcmp((char*)pPair->key, "delta") == 0);
+    memset(aKey, 0, SIZE_NAME);
+    strcpy(aKey, "cat");
+    CU_ASSERT(pMap->lower_bound(pMap, aKey, &pPair) == SUCC);
+    CU_ASSERT(strcmp((char*)pPair->key, "charlie") == 0);
+    CU_ASSERT(pMap->maximum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(*(int64_t*)pPair->value, 4);
+
+    FrozenMapDeinit(&pMap);
+}
+
+void TestIllegalFile()
+{
+    FrozenMap *pMap;
+    CU_ASSERT(FrozenMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->open(pMap, NULL) == ERR_IDX);
+    CU_ASSERT(pMap->open(pMap, "/nonexistent/dir/file") == ERR_IO);
+
+    /* A truncated file is rejected, and the map stays empty. */
+    TreeMap *pTree;
+    CU_ASSERT(TreeMapInit(&pTree) == SUCC);
+    Pair pair = {(void*)1, (void*)1};
+    CU_ASSERT(pTree->put(pTree, &pair) == SUCC);
+    CU_ASSERT(FrozenMapFreeze(pTree, PATH_FROZEN, 0, 0) == SUCC);
+    CU_ASSERT(pMap->open(pMap, PATH_FROZEN) == SUCC);
+    CU_ASSERT(truncate(PATH_FROZEN, 100) == 0);
+    CU_ASSERT(pMap->open(pMap, PATH_FROZEN) == ERR_IO);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 0);
+    CU_ASSERT(pMap->find(pMap, (Key)1) == NOKEY);
+
+    /* The empty map is frozen too. */
+    CU_ASSERT(pTree->remove(pTree, (Key)1) == SUCC);
+    CU_ASSERT(FrozenMapFreeze(pTree, PATH_FROZEN, 0, 0) == SUCC);
+    CU_ASSERT(pMap->open(pMap, PATH_FROZEN) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 0);
+    Pair *pPair;
+    CU_ASSERT(pMap->iterate(pMap, true, NULL) == SUCC);
+    CU_ASSERT(pMap->iterate(pMap, false, &pPair) == END);
+
+    TreeMapDeinit(&pTree);
+    FrozenMapDeinit(&pMap);
+}
+
+
+void TestRefreeze()
+{
+    TreeMap *pTree;
+    CU_ASSERT(TreeMapInit(&pTree) == SUCC);
+    CU_ASSERT(pTree->set_pair_mode(pTree, TREE_MAP_PAIR_INLINE) == SUCC);
+    Pair pair;
+    intptr_t iKey;
+    for (iKey = 1 ; iKey <= COUNT_REFREEZE ; iKey++) {
+        pair.key = (void*)iKey;
+        pair.value = (void*)iKey;
+        CU_ASSERT(pTree->put(pTree, &pair) == SUCC);
+    }
+    CU_ASSERT(FrozenMapFreeze(pTree, PATH_FROZEN, 0, 0) == SUCC);
+
+    FrozenMap *pOld;
+    CU_ASSERT(FrozenMapInit(&pOld) == SUCC);
+    CU_ASSERT(pOld->open(pOld, PATH_FROZEN) == SUCC);
+
+    /* Replace the file with a much smaller one while it is still mapped. */
+    TreeMapDeinit(&pTree);
+    CU_ASSERT(TreeMapInit(&pTree) == SUCC);
+    CU_ASSERT(pTree->set_pair_mode(pTree, TREE_MAP_PAIR_INLINE) == SUCC);
+    for (iKey = 1 ; iKey <= 10 ; iKey++) {
+        pair.key = (void*)iKey;
+        pair.value = (void*)(iKey * 2);
+        CU_ASSERT(pTree->put(pTree, &pair) == SUCC);
+    }
+    CU_ASSERT(FrozenMapFreeze(pTree, PATH_FROZEN, 0, 0) == SUCC);
+    CU_ASSERT(FrozenMapFreeze(pTree, "/nonexistent/dir/file", 0, 0) == ERR_IO);
+
+    /* The opened map keeps reading the replaced file. */
+    Value value;
+    bool bSame = true;
+    for (iKey = 1 ; iKey <= COUNT_REFREEZE ; iKey++) {
+        if ((pOld->get(pOld, (Key)iKey, &value) != SUCC) ||
+            (value != (Value)iKey))
+            bSame = false;
+    }
+    CU_ASSERT(bSame);
+    CU_ASSERT_EQUAL(pOld->size(pOld), COUNT_REFREEZE);
+
+    /* The map opened afterward reads the new file. */
+    FrozenMap *pNew;
+    CU_ASSERT(FrozenMapInit(&pNew) == SUCC);
+    CU_ASSERT(pNew->open(pNew, PATH_FROZEN) == SUCC);
+    CU_ASSERT_EQUAL(pNew->size(pNew), 10);
+    CU_ASSERT(pNew->get(pNew, (Key)5, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)10);
+
+    TreeMapDeinit(&pTree);
+    FrozenMapDeinit(&pOld);
+    FrozenMapDeinit(&pNew);
+}
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Bulk Suite         *
+ *------------------------------------------------------------*/
+int32_t AddBulkSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Bulk data manipulation", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Queries against TreeMap",
+                     TestBulkQuery);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBulkQuery()
+{
+    TreeMap *pTree;
+    CU_ASSERT(TreeMapInit(&pTree) == SUCC);
+    CU_ASSERT(pTree->set_pair_mode(pTree, TREE_MAP_PAIR_INLINE) == SUCC);
+    srand(11);
+    Pair pair;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_BULK ; iIdx++) {
+        pair.key = (void*)(intptr_t)(rand() % RANGE_KEY + 1);
+        pair.value = (void*)(intptr_t)iIdx;
+        CU_ASSERT(pTree->put(pTree, &pair) == SUCC);
+    }
+    CU_ASSERT(FrozenMapFreeze(pTree, PATH_FROZEN, 0, 0) == SUCC);
+
+    FrozenMap *pMap;
+    CU_ASSERT(FrozenMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->open(pMap, PATH_FROZEN) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), pTree->size(pTree));
+
+    /* Every key in the range answers the same with both maps. */
+    Pair *pTreePair, *pPair;
+    intptr_t iKey;
+    for (iKey = 0 ; iKey <= RANGE_KEY + 1 ; iKey++) {
+        Value valTree, value;
+        int32_t iRtn = pTree->get(pTree, (Key)iKey, &valTree);
+        CU_ASSERT_EQUAL(pMap->get(pMap, (Key)iKey, &value), iRtn);
+        if (iRtn == SUCC)
+            CU_ASSERT_EQUAL(value, valTree);
+
+        iRtn = pTree->lower_bound(pTree, (Key)iKey, &pTreePair);
+        CU_ASSERT_EQUAL(pMap->lower_bound(pMap, (Key)iKey, &pPair), iRtn);
+        if (iRtn == SUCC)
+            CU_ASSERT_EQUAL(pPair->key, pTreePair->key);
+
+        iRtn = pTree->upper_bound(pTree, (Key)iKey, &pTreePair);
+        CU_ASSERT_EQUAL(pMap->upper_bound(pMap, (Key)iKey, &pPair), iRtn);
+        if (iRtn == SUCC)
+            CU_ASSERT_EQUAL(pPair->key, pTreePair->key);
+
+        iRtn = pTree->predecessor(pTree, (Key)iKey, &pTreePair);
+        CU_ASSERT_EQUAL(pMap->predecessor(pMap, (Key)iKey, &pPair), iRtn);
+        if (iRtn == SUCC)
+            CU_ASSERT_EQUAL(pPair->key, pTreePair->key);
+    }
+
+    /* The iteration follows the same order. */
+    int32_t iNum = 0;
+    CU_ASSERT(pTree->iterate(pTree, true, NULL) == SUCC);
+    CU_ASSERT(pMap->iterate(pMap, true, NULL) == SUCC);
+    while (pMap->iterate(pMap, false, &pPair) != END) {
+        CU_ASSERT(pTree->iterate(pTree, false, &pTreePair) != END);
+        CU_ASSERT_EQUAL(pPair->key, pTreePair->key);
+        CU_ASSERT_EQUAL(pPair->value, pTreePair->value);
+        iNum++;
+    }
+    CU_ASSERT_EQUAL(iNum, pTree->size(pTree));
+
+    TreeMapDeinit(&pTree);
+    FrozenMapDeinit(&pMap);
+}
@@ -0,0 +1,323 @@
+#include "container/frozen_trie.h"
+#include <unistd.h>
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+
+
+#define FREE_BLOCK_TEST(_arr, _num)                                             \
+            do {                                                                \
+                int32_t _idx;                                                   \
+                for (_idx = 0 ; _idx < _num ; ++_idx)                           \
+                    free((_arr)[_idx]);                                         \
+                free(_arr);                                                     \
+            } while (0);
+
+
+/*------------------------------------------------------------*
+ * Test Function Declaration for basic structure verification *
+ *------------------------------------------------------------*/
+#define PATH_FROZEN         "/tmp/unit_frozen_trie.frozen"
+#define COUNT_REFREEZE      (2000)
+
+int32_t AddBasicSuite();
+void TestBasicQuery();
+void TestIllegalFile();
+void TestRefreeze();
+
+
+/*------------------------------------------------------------*
+ *    Test Function Declaration for bulk data manipulation    *
+ *------------------------------------------------------------*/
+#define COUNT_BULK          (3000)
+#define SIZE_BULK_STR       (12)
+
+int32_t AddBulkSuite();
+void TestBulkQuery();
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    /* Register the test suite for basic structure verification. */
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Register the test suite for bulk data manipulation. */
+    if (AddBulkSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+    unlink(PATH_FROZEN);
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Basic Suite        *
+ *------------------------------------------------------------*/
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Basic Structure Verification", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Queries on the frozen strings",
+                     TestBasicQuery);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Illegal frozen file", TestIllegalFile);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Freeze over an opened file", TestRefreeze);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBasicQuery()
+{
+    char *aStr[8] = {"romulus", "rubens", "romane", "rom", "rubicundus",
+                     "romanus", "ruber", "rubicon"};
+    Trie *pTrie;
+    CU_ASSERT(TrieInit(&pTrie) == SUCC);
+    CU_ASSERT(pTrie->bulk_insert(pTrie, aStr, 8) == SUCC);
+    CU_ASSERT(FrozenTrieFreeze(pTrie, PATH_FROZEN) == SUCC);
+    CU_ASSERT(FrozenTrieFreeze(NULL, PATH_FROZEN) == ERR_NOINIT);
+    CU_ASSERT(FrozenTrieFreeze(pTrie, NULL) == ERR_IDX);
+    TrieDeinit(&pTrie);
+
+    FrozenTrie *pFrozen;
+    CU_ASSERT(FrozenTrieInit(&pFrozen) == SUCC);
+    CU_ASSERT_EQUAL(pFrozen->size(pFrozen), 0);
+    CU_ASSERT(pFrozen->has_exact(pFrozen, "rom") == NOKEY);
+    CU_ASSERT(pFrozen->open(pFrozen, PATH_FROZEN) == SUCC);
+    CU_ASSERT_EQUAL(pFrozen->size(pFrozen), 8);
+
+    /* The string which prefixes the others is marked by its terminal unit. */
+    CU_ASSERT(pFrozen->has_exact(pFrozen, "rom") == SUCC);
+    CU_ASSERT(pFrozen->has_exact(pFrozen, "romanus") == SUCC);
+    CU_ASSERT(pFrozen->has_exact(pFrozen, "roma") == NOKEY);
+    CU_ASSERT(pFrozen->has_exact(pFrozen, "romanuses") == NOKEY);
+    CU_ASSERT(pFrozen->has_exact(pFrozen, "") == NOKEY);
+    CU_ASSERT(pFrozen->has_exact(pFrozen, NULL) == NOKEY);
+    CU_ASSERT(pFrozen->has_prefix_as(pFrozen, "rubic") == SUCC);
+    CU_ASSERT(pFrozen->has_prefix_as(pFrozen, "rubicundusx") == NOKEY);
+    CU_ASSERT(pFrozen->has_prefix_as(pFrozen, "x") == NOKEY);
+    CU_ASSERT(pFrozen->has_prefix_as(pFrozen, "") == NOKEY);
+
+    /* The resolved strings are sorted. */
+    char **aGet;
+    int iNum;
+    CU_ASSERT(pFrozen->get_prefix_as(pFrozen, "rom", &aGet, &iNum) == SUCC);
+    CU_ASSERT_EQUAL(iNum, 4);
+    if (iNum == 4) {
+        CU_ASSERT(strcmp(aGet[0], "rom") == 0);
+        CU_ASSERT(strcmp(aGet[1], "romane") == 0);
+        CU_ASSERT(strcmp(aGet[2], "romanus") == 0);
+        CU_ASSERT(strcmp(aGet[3], "romulus") == 0);
+    }
+    FREE_BLOCK_TEST(aGet, iNum);
+    CU_ASSERT(pFrozen->get_prefix_as(pFrozen, "rube", &aGet, &iNum) == SUCC);
+    CU_ASSERT_EQUAL(iNum, 2);
+    if (iNum == 2) {
+        CU_ASSERT(strcmp(aGet[0], "rubens") == 0);
+        CU_ASSERT(strcmp(aGet[1], "ruber") == 0);
+    }
+    FREE_BLOCK_TEST(aGet, iNum);
+    CU_ASSERT(pFrozen->get_prefix_as(pFrozen, "rot", &aGet, &iNum) == NOKEY);
+    CU_ASSERT(aGet == NULL);
+    CU_ASSERT_EQUAL(iNum, 0);
+    CU_ASSERT(pFrozen->get_prefix_as(pFrozen, "rom", NULL, &iNum) == ERR_GET);
+
+    TrieStat stat;
+    CU_ASSERT(pFrozen->get_stat(pFrozen, &stat) == SUCC);
+    CU_ASSERT(stat.lCountNode > 0);
+    CU_ASSERT(pFrozen->get_stat(pFrozen, NULL) == ERR_GET);
+
+    FrozenTrieDeinit(&pFrozen);
+    CU_ASSERT(FrozenTrieSize(pFrozen) == ERR_NOINIT);
+}
+
+void TestIllegalFile()
+{
+    FrozenTrie *pFrozen;
+    CU_ASSERT(FrozenTrieInit(&pFrozen) == SUCC);
+    CU_ASSERT(pFrozen->open(pFrozen, NULL) == ERR_IDX);
+    CU_ASSERT(pFrozen->open(pFrozen, "/nonexistent/dir/file") == ERR_IO);
+
+    /* A truncated file is rejected, and the trie stays empty. */
+    Trie *pTrie;
+    CU_ASSERT(TrieInit(&pTrie) == SUCC);
+    CU_ASSERT(pTrie->insert(pTrie, "alpha") == SUCC);
+    CU_ASSERT(FrozenTrieFreeze(pTrie, PATH_FROZEN) == SUCC);
+    CU_ASSERT(pFrozen->open(pFrozen, PATH_FROZEN) == SUCC);
+    CU_ASSERT(truncate(PATH_FROZEN, 100) == 0);
+    CU_ASSERT(pFrozen->open(pFrozen, PATH_FROZEN) == ERR_IO);
+    CU_ASSERT_EQUAL(pFrozen->size(pFrozen), 0);
+    CU_ASSERT(pFrozen->has_prefix_as(pFrozen, "a") == NOKEY);
+
+    /* The empty trie is frozen too. */
+    CU_ASSERT(pTrie->remove(pTrie, "alpha") == SUCC);
+    CU_ASSERT(FrozenTrieFreeze(pTrie, PATH_FROZEN) == SUCC);
+    CU_ASSERT(pFrozen->open(pFrozen, PATH_FROZEN) == SUCC);
+    CU_ASSERT_EQUAL(pFrozen->size(pFrozen), 0);
+    CU_ASSERT(pFrozen->has_exact(pFrozen, "alpha") == NOKEY);
+    CU_ASSERT(pFrozen->has_prefix_as(pFrozen, "\x01") == NOKEY);
+
+    TrieDeinit(&pTrie);
+    FrozenTrieDeinit(&pFrozen);
+}
+
+
+void TestRefreeze()
+{
+    Trie *pTrie;
+    CU_ASSERT(TrieInit(&pTrie) == SUCC);
+    char szBuf[16];
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_REFREEZE ; iIdx++) {
+        snprintf(szBuf, sizeof(szBuf), "key%05d", iIdx);
+        CU_ASSERT(pTrie->insert(pTrie, szBuf) == SUCC);
+    }
+    CU_ASSERT(FrozenTrieFreeze(pTrie, PATH_FROZEN) == SUCC);
+
+    FrozenTrie *pOld;
+    CU_ASSERT(FrozenTrieInit(&pOld) == SUCC);
+    CU_ASSERT(pOld->open(pOld, PATH_FROZEN) == SUCC);
+
+    /* Replace the file with a much smaller one while it is still mapped. */
+    TrieDeinit(&pTrie);
+    CU_ASSERT(TrieInit(&pTrie) == SUCC);
+    CU_ASSERT(pTrie->insert(pTrie, "alpha") == SUCC);
+    CU_ASSERT(FrozenTrieFreeze(pTrie, PATH_FROZEN) == SUCC);
+    CU_ASSERT(FrozenTrieFreeze(pTrie, "/nonexistent/dir/file") == ERR_IO);
+
+    /* The opened trie keeps reading the replaced file. */
+    bool bSame = true;
+    for (iIdx = 0 ; iIdx < COUNT_REFREEZE ; iIdx++) {
+        snprintf(szBuf, sizeof(szBuf), "key%05d", iIdx);
+        if (pOld->has_exact(pOld, szBuf) != SUCC)
+            bSame = false;
+    }
+    CU_ASSERT(bSame);
+    CU_ASSERT_EQUAL(pOld->size(pOld), COUNT_REFREEZE);
+
+    /* The trie opened afterward reads the new file. */
+    FrozenTrie *pNew;
+    CU_ASSERT(FrozenTrieInit(&pNew) == SUCC);
+    CU_ASSERT(pNew->open(pNew, PATH_FROZEN) == SUCC);
+    CU_ASSERT_EQUAL(pNew->size(pNew), 1);
+    CU_ASSERT(pNew->has_exact(pNew, "alpha") == SUCC);
+    CU_ASSERT(pNew->has_exact(pNew, "key00000") == NOKEY);
+
+    TrieDeinit(&pTrie);
+    FrozenTrieDeinit(&pOld);
+    FrozenTrieDeinit(&pNew);
+}
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Bulk Suite         *
+ *------------------------------------------------------------*/
+int32_t AddBulkSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Bulk data manipulation", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Queries against Trie", TestBulkQuery);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBulkQuery()
+{
+    /* The strings share the short prefixes, and some carry the bytes beyond
+       ASCII. */
+    static char aBuf[COUNT_BULK * 2][SIZE_BULK_STR];
+    char *aStr[COUNT_BULK];
+    srand(17);
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_BULK * 2 ; iIdx++) {
+        int32_t iLen = rand() % (SIZE_BULK_STR - 2) + 1;
+        int32_t iPos;
+        for (iPos = 0 ; iPos < iLen ; iPos++)
+            aBuf[iIdx][iPos] = (iPos < 2)? ('a' + rand() % 3) :
+                               ((rand() % 8 == 0)? (char)(0xc0 + rand() % 4) :
+                                ('a' + rand() % 6));
+        aBuf[iIdx][iLen] = 0;
+    }
+    for (iIdx = 0 ; iIdx < COUNT_BULK ; iIdx++)
+        aStr[iIdx] = aBuf[iIdx];
+
+    int32_t iMode;
+    for (iMode = TRIE_MODE_TERNARY ; iMode <= TRIE_MODE_RADIX ; iMode++) {
+        Trie *pTrie;
+        CU_ASSERT(TrieInit(&pTrie) == SUCC);
+        CU_ASSERT(pTrie->set_mode(pTrie, iMode) == SUCC);
+        CU_ASSERT(pTrie->bulk_insert(pTrie, aStr, COUNT_BULK) == SUCC);
+        for (iIdx = 0 ; iIdx < COUNT_BULK ; iIdx += 7)
+            pTrie->remove(pTrie, aStr[iIdx]);
+        CU_ASSERT(FrozenTrieFreeze(pTrie, PATH_FROZEN) == SUCC);
+
+        FrozenTrie *pFrozen;
+        CU_ASSERT(FrozenTrieInit(&pFrozen) == SUCC);
+        CU_ASSERT(pFrozen->open(pFrozen, PATH_FROZEN) == SUCC);
+        CU_ASSERT_EQUAL(pFrozen->size(pFrozen), pTrie->size(pTrie));
+
+        /* Both the inserted and the absent strings answer the same. */
+        for (iIdx = 0 ; iIdx < COUNT_BULK * 2 ; iIdx++) {
+            CU_ASSERT_EQUAL(pFrozen->has_exact(pFrozen, aBuf[iIdx]),
+                            pTrie->has_exact(pTrie, aBuf[iIdx]));
+            CU_ASSERT_EQUAL(pFrozen->has_prefix_as(pFrozen, aBuf[iIdx]),
+                            pTrie->has_prefix_as(pTrie, aBuf[iIdx]));
+        }
+
+        /* The short prefixes resolve the same sets of strings. */
+        char szPrefix[3] = {0, 0, 0};
+        char cFst, cSnd;
+        for (cFst = 'a' ; cFst <= 'c' ; cFst++) {
+            for (cSnd = 'a' ; cSnd <= 'd' ; cSnd++) {
+                szPrefix[0] = cFst;
+                szPrefix[1] = cSnd;
+                char **aTrie, **aGet;
+                int iTrie, iGet;
+                int32_t iRtn = pTrie->get_prefix_as(pTrie, szPrefix, &aTrie,
+                                                    &iTrie);
+                CU_ASSERT_EQUAL(pFrozen->get_prefix_as(pFrozen, szPrefix, &aGet,
+                                                       &iGet), iRtn);
+                CU_ASSERT_EQUAL(iGet, iTrie);
+                int32_t iOrd;
+                for (iOrd = 1 ; iOrd < iGet ; iOrd++)
+                    CU_ASSERT(strcmp(aGet[iOrd - 1], aGet[iOrd]) < 0);
+                for (iOrd = 0 ; iOrd < iGet ; iOrd++)
+                    CU_ASSERT(pTrie->has_exact(pTrie, aGet[iOrd]) == SUCC);
+                FREE_BLOCK_TEST(aTrie, iTrie);
+                FREE_BLOCK_TEST(aGet, iGet);
+            }
+        }
+
+        FrozenTrieDeinit(&pFrozen);
+        TrieDeinit(&pTrie);
+    }
+}
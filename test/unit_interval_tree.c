@@ -0,0 +1,265 @@
+#include "container/interval_tree.h"
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+
+
+/*------------------------------------------------------------*
+ * Test Function Declaration for basic structure verification *
+ *------------------------------------------------------------*/
+int32_t AddBasicSuite();
+void TestBasicOperation();
+void TestQuery();
+
+int32_t CollectInterval(Interval*, void*);
+int32_t StopInterval(Interval*, void*);
+void DestroyInterval(Interval*);
+
+
+/*------------------------------------------------------------*
+ *    Test Function Declaration for bulk data manipulation    *
+ *------------------------------------------------------------*/
+#define COUNT_BULK          (4000)
+#define COUNT_PROBE         (500)
+#define RANGE_POINT         (100000)
+#define RANGE_SPAN          (2000)
+
+int32_t AddBulkSuite();
+void TestBulkQuery();
+
+int32_t CountBrute(Interval*, bool*, int32_t, int64_t, int64_t);
+int32_t CheckOrder(Interval*, void*);
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    /* Register the test suite for basic structure verification. */
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Register the test suite for bulk data manipulation. */
+    if (AddBulkSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Basic Suite        *
+ *------------------------------------------------------------*/
+typedef struct Collect_ {
+    int32_t iNum;
+    Interval aInterval[16];
+} Collect;
+
+int32_t iDestroy;
+
+int32_t CollectInterval(Interval *pInterval, void *pArg)
+{
+    Collect *pCollect = (Collect*)pArg;
+    pCollect->aInterval[pCollect->iNum++] = *pInterval;
+    return CONTINUE;
+}
+
+int32_t StopInterval(Interval *pInterval, void *pArg)
+{
+    return END;
+}
+
+void DestroyInterval(Interval *pInterval) { iDestroy++; }
+
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Basic Structure Verification", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Interval insertion and deletion",
+                     TestBasicOperation);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Stabbing and overlap query", TestQuery);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBasicOperation()
+{
+    IntervalTree *pTree;
+    CU_ASSERT(IntervalTreeInit(&pTree) == SUCC);
+    CU_ASSERT(pTree->set_destroy(pTree, DestroyInterval) == SUCC);
+    iDestroy = 0;
+
+    /* The intervals sharing the endpoints are told apart by the values. */
+    Interval interval = {10, 20, (Value)1};
+    CU_ASSERT(pTree->put(pTree, &interval) == SUCC);
+    CU_ASSERT(pTree->put(pTree, &interval) == SUCC);
+    CU_ASSERT_EQUAL(pTree->size(pTree), 1);
+    interval.value = (Value)2;
+    CU_ASSERT(pTree->find(pTree, &interval) == NOKEY);
+    CU_ASSERT(pTree->put(pTree, &interval) == SUCC);
+    CU_ASSERT(pTree->find(pTree, &interval) == SUCC);
+    CU_ASSERT_EQUAL(pTree->size(pTree), 2);
+
+    interval.lLow = 21;
+    CU_ASSERT(pTree->put(pTree, &interval) == ERR_IDX);
+    CU_ASSERT(pTree->put(pTree, NULL) == ERR_IDX);
+    interval.lLow = 5;
+    interval.lHigh = 5;
+    CU_ASSERT(pTree->remove(pTree, &interval) == ERR_NODATA);
+    CU_ASSERT(pTree->put(pTree, &interval) == SUCC);
+    CU_ASSERT(pTree->remove(pTree, &interval) == SUCC);
+    CU_ASSERT_EQUAL(iDestroy, 1);
+    CU_ASSERT_EQUAL(pTree->size(pTree), 2);
+
+    IntervalTreeDeinit(&pTree);
+    CU_ASSERT_EQUAL(iDestroy, 3);
+    CU_ASSERT(IntervalTreeSize(pTree) == ERR_NOINIT);
+}
+
+void TestQuery()
+{
+    IntervalTree *pTree;
+    CU_ASSERT(IntervalTreeInit(&pTree) == SUCC);
+
+    /* Nested, disjoint, and touching intervals. */
+    Interval aInterval[] = {{0, 100, (Value)0}, {10, 20, (Value)1},
+                            {15, 30, (Value)2}, {30, 40, (Value)3},
+                            {50, 50, (Value)4}, {-20, -10, (Value)5}};
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 6 ; iIdx++)
+        CU_ASSERT(pTree->put(pTree, &aInterval[iIdx]) == SUCC);
+
+    Collect collect;
+    collect.iNum = 0;
+    CU_ASSERT_EQUAL(pTree->stab(pTree, 30, CollectInterval, &collect), 3);
+    CU_ASSERT_EQUAL(collect.aInterval[0].value, (Value)0);
+    CU_ASSERT_EQUAL(collect.aInterval[1].value, (Value)2);
+    CU_ASSERT_EQUAL(collect.aInterval[2].value, (Value)3);
+
+    collect.iNum = 0;
+    CU_ASSERT_EQUAL(pTree->stab(pTree, -15, CollectInterval, &collect), 1);
+    CU_ASSERT_EQUAL(collect.aInterval[0].value, (Value)5);
+    CU_ASSERT_EQUAL(pTree->stab(pTree, 101, CollectInterval, &collect), 0);
+
+    collect.iNum = 0;
+    CU_ASSERT_EQUAL(pTree->overlap(pTree, 41, 50, CollectInterval, &collect),
+                    2);
+    CU_ASSERT_EQUAL(collect.aInterval[1].value, (Value)4);
+    CU_ASSERT_EQUAL(pTree->overlap(pTree, INT64_MIN, INT64_MAX, StopInterval,
+                                   NULL), 1);
+    CU_ASSERT(pTree->overlap(pTree, 2, 1, CollectInterval, &collect) == ERR_IDX);
+    CU_ASSERT(pTree->stab(pTree, 1, NULL, NULL) == ERR_GET);
+
+    /* The maximum shrinks after the covering interval leaves. */
+    CU_ASSERT(pTree->remove(pTree, &aInterval[0]) == SUCC);
+    CU_ASSERT_EQUAL(pTree->stab(pTree, 45, CollectInterval, &collect), 0);
+    CU_ASSERT_EQUAL(pTree->stab(pTree, 40, CollectInterval, &collect), 1);
+
+    IntervalTreeDeinit(&pTree);
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Bulk Suite         *
+ *------------------------------------------------------------*/
+int32_t AddBulkSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Bulk data manipulation", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Queries against linear scan",
+                     TestBulkQuery);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+int32_t CountBrute(Interval *aInterval, bool *aAlive, int32_t iNum,
+                   int64_t lLow, int64_t lHigh)
+{
+    int32_t iCount = 0;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        if (aAlive[iIdx] && (aInterval[iIdx].lLow <= lHigh) &&
+            (aInterval[iIdx].lHigh >= lLow))
+            iCount++;
+    }
+    return iCount;
+}
+
+int32_t CheckOrder(Interval *pInterval, void *pArg)
+{
+    Interval *pLast = (Interval*)pArg;
+    if (pLast->lLow > pInterval->lLow)
+        pLast->value = (Value)1;
+    pLast->lLow = pInterval->lLow;
+    return CONTINUE;
+}
+
+void TestBulkQuery()
+{
+    IntervalTree *pTree;
+    CU_ASSERT(IntervalTreeInit(&pTree) == SUCC);
+
+    Interval *aInterval = (Interval*)malloc(sizeof(Interval) * COUNT_BULK);
+    bool *aAlive = (bool*)malloc(sizeof(bool) * COUNT_BULK);
+    srand(7);
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_BULK ; iIdx++) {
+        aInterval[iIdx].lLow = rand() % RANGE_POINT;
+        aInterval[iIdx].lHigh = aInterval[iIdx].lLow + rand() % RANGE_SPAN;
+        aInterval[iIdx].value = (Value)(intptr_t)iIdx;
+        aAlive[iIdx] = true;
+        CU_ASSERT(pTree->put(pTree, &aInterval[iIdx]) == SUCC);
+    }
+
+    /* Remove a half to exercise the maintenance of the maxima. */
+    for (iIdx = 0 ; iIdx < COUNT_BULK ; iIdx += 2) {
+        CU_ASSERT(pTree->remove(pTree, &aInterval[iIdx]) == SUCC);
+        aAlive[iIdx] = false;
+    }
+    CU_ASSERT_EQUAL(pTree->size(pTree), COUNT_BULK / 2);
+
+    Interval last;
+    for (iIdx = 0 ; iIdx < COUNT_PROBE ; iIdx++) {
+        int64_t lLow = rand() % RANGE_POINT;
+        int64_t lHigh = lLow + rand() % (RANGE_SPAN / 4);
+        last.lLow = INT64_MIN;
+        last.value = (Value)0;
+        CU_ASSERT_EQUAL(pTree->overlap(pTree, lLow, lHigh, CheckOrder, &last),
+                        CountBrute(aInterval, aAlive, COUNT_BULK, lLow, lHigh));
+        CU_ASSERT_EQUAL(last.value, (Value)0);
+        last.lLow = INT64_MIN;
+        CU_ASSERT_EQUAL(pTree->stab(pTree, lLow, CheckOrder, &last),
+                        CountBrute(aInterval, aAlive, COUNT_BULK, lLow, lLow));
+        CU_ASSERT_EQUAL(last.value, (Value)0);
+    }
+
+    IntervalTreeDeinit(&pTree);
+    free(aInterval);
+    free(aAlive);
+}
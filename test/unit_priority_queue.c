@@ -36,6 +36,7 @@ int32_t AddSimpleSuite();
 int32_t AddAdvancedSuit();
 void TestSimpleOrder();
 void TestSimpleMixOp();
+void TestStorage();
 void TestAdvancedMixOp();
 
 
@@ -128,6 +129,10 @@ int32_t AddSimpleSuite()
     if (!pTest)
         return ERR_REG;
 
+    pTest = CU_add_test(pSuite, "Storage mode switch", TestStorage);
+    if (!pTest)
+        return ERR_REG;
+
     return SUCC;
 }
 
@@ -253,6 +258,46 @@ void TestSimpleMixOp()
 }
 
 
+void TestStorage()
+{
+    PriorityQueue *pQueue;
+    CU_ASSERT(PriorityQueueInit(&pQueue) == SUCC);
+    CU_ASSERT(pQueue->set_storage(pQueue, -1, NULL) == ERR_POLICY);
+
+    /* Interleave the items so that the heap is reordered after each switch. */
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < SIZE_MID_TEST ; iIdx += 2)
+        CU_ASSERT(pQueue->push(pQueue, (Item)(intptr_t)iIdx) == SUCC);
+
+    /* Move the items to the huge page storage and keep growing. */
+    CU_ASSERT(pQueue->set_storage(pQueue, STORAGE_HUGE_PAGE, NULL) == SUCC);
+    for (iIdx = 1 ; iIdx < SIZE_MID_TEST ; iIdx += 2)
+        CU_ASSERT(pQueue->push(pQueue, (Item)(intptr_t)iIdx) == SUCC);
+
+    /* Move the items to the file backed storage and keep growing. */
+    CU_ASSERT(pQueue->set_storage(pQueue, STORAGE_FILE,
+                                  "/tmp/unit_priority_queue.spill") == SUCC);
+    for (iIdx = SIZE_MID_TEST ; iIdx < 100000 ; iIdx++)
+        CU_ASSERT(pQueue->push(pQueue, (Item)(intptr_t)iIdx) == SUCC);
+    CU_ASSERT_EQUAL(pQueue->size(pQueue), 100000);
+
+    /* Move the items back to the heap storage. */
+    CU_ASSERT(pQueue->set_storage(pQueue, STORAGE_HEAP, NULL) == SUCC);
+    Item item;
+    bool bOrder = true;
+    for (iIdx = 100000 - 1 ; iIdx >= 0 ; iIdx--) {
+        pQueue->top(pQueue, &item);
+        if (item != (Item)(intptr_t)iIdx)
+            bOrder = false;
+        pQueue->pop(pQueue);
+    }
+    CU_ASSERT(bOrder);
+    CU_ASSERT_EQUAL(pQueue->size(pQueue), 0);
+
+    PriorityQueueDeinit(&pQueue);
+}
+
+
 void TestAdvancedMixOp()
 {
     PriorityQueue *pQueue;
@@ -17,6 +17,7 @@ typedef struct Employ_ {
 int32_t AddSuite();
 void TestManipulate();
 void TestBoundary();
+void TestStorage();
 void DestroyItem(Item);
 
 
@@ -64,6 +65,10 @@ int32_t AddSuite()
     if (!pTest)
         rc = ERR_REG;
 
+    pTest = CU_add_test(pSuite, "Storage mode switch", TestStorage);
+    if (!pTest)
+        rc = ERR_REG;
+
 EXIT:
     return rc;
 }
@@ -174,4 +179,42 @@ void TestBoundary()
     CU_ASSERT(pQueue->back(pQueue, NULL) == ERR_GET);
 
     QueueDeinit(&pQueue);
-}
\ No newline at end of file
+}
+
+void TestStorage()
+{
+    Queue *pQueue;
+    CU_ASSERT(QueueInit(&pQueue) == SUCC);
+    CU_ASSERT(pQueue->set_storage(pQueue, -1, NULL) == ERR_POLICY);
+
+    /* Let the items wrap around the array before the switch. */
+    int iIdx;
+    for (iIdx = 0 ; iIdx < SIZE_SMALL_TEST ; iIdx++)
+        CU_ASSERT(pQueue->push(pQueue, (Item)(intptr_t)iIdx) == SUCC);
+    for (iIdx = 0 ; iIdx < SIZE_SMALL_TEST / 2 ; iIdx++)
+        CU_ASSERT(pQueue->pop(pQueue) == SUCC);
+    for (iIdx = SIZE_SMALL_TEST ; iIdx < SIZE_SMALL_TEST * 3 / 2 ; iIdx++)
+        CU_ASSERT(pQueue->push(pQueue, (Item)(intptr_t)iIdx) == SUCC);
+
+    /* Move the items to the huge page storage and keep growing. */
+    CU_ASSERT(pQueue->set_storage(pQueue, STORAGE_HUGE_PAGE, NULL) == SUCC);
+    for (iIdx = SIZE_SMALL_TEST * 3 / 2 ; iIdx < 100000 ; iIdx++)
+        CU_ASSERT(pQueue->push(pQueue, (Item)(intptr_t)iIdx) == SUCC);
+
+    /* Move the items to the file backed storage. */
+    CU_ASSERT(pQueue->set_storage(pQueue, STORAGE_FILE,
+                                  "/tmp/unit_queue.spill") == SUCC);
+
+    Item item;
+    bool bOrder = true;
+    for (iIdx = SIZE_SMALL_TEST / 2 ; iIdx < 100000 ; iIdx++) {
+        pQueue->front(pQueue, &item);
+        if (item != (Item)(intptr_t)iIdx)
+            bOrder = false;
+        pQueue->pop(pQueue);
+    }
+    CU_ASSERT(bOrder);
+    CU_ASSERT_EQUAL(pQueue->size(pQueue), 0);
+
+    QueueDeinit(&pQueue);
+}
@@ -0,0 +1,573 @@
+#include "container/skip_list.h"
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+#include <pthread.h>
+#include <semaphore.h>
+
+
+/*------------------------------------------------------------*
+ * Test Function Declaration for basic structure verification *
+ *------------------------------------------------------------*/
+#define COUNT_KEY           (1000)
+
+int32_t AddBasicSuite();
+void TestBasicOperation();
+void TestIterator();
+
+void DestroyPair(Pair*);
+Pair* MakePair(intptr_t, intptr_t);
+int32_t CompareReverse(Key, Key);
+
+
+/*------------------------------------------------------------*
+ *   Test Function Declaration for concurrent manipulation    *
+ *------------------------------------------------------------*/
+#define COUNT_THREAD        (8)
+#define COUNT_ROUND         (4000)
+#define RANGE_SHARED        (256)
+#define RANGE_CHURN         (4)
+#define COUNT_STAGE         (400)
+#define COUNT_RECLAIM       (128)
+#define SIZE_SCRIBBLE       (256)
+#define COUNT_SCRIBBLE      (8)
+#define ROLE_PUT            (1)
+#define ROLE_REMOVE         (2)
+
+typedef struct Worker_ {
+    SkipList *pList;
+    int32_t iId;
+    int32_t iFault;
+} Worker;
+
+/* The inserter and the remover of the staged key are held inside the key
+   comparison, so that the interleaving does not depend on the scheduler. */
+typedef struct Stage_ {
+    intptr_t iKey;
+    bool bHeld;
+    int32_t iStale;
+    sem_t semPause;
+    sem_t semPut;
+    sem_t semRemove;
+} Stage;
+
+static Stage _stage;
+static __thread int32_t _iRole;
+static __thread bool _bHeld;
+static __thread bool _bEqual;
+static __thread Key _keyFirst;
+
+int32_t AddConcurrentSuite();
+void TestConcurrentWrite();
+void TestReadWhileWrite();
+void TestChurnSameKey();
+void TestUnlinkBehindSameKey();
+
+int32_t CompareStaged(Key, Key);
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    /* Register the test suite for basic structure verification. */
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Register the test suite for concurrent manipulation. */
+    if (AddConcurrentSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Basic Suite        *
+ *------------------------------------------------------------*/
+void DestroyPair(Pair *pPair) { free(pPair); }
+
+Pair* MakePair(intptr_t iKey, intptr_t iValue)
+{
+    Pair *pPair = (Pair*)malloc(sizeof(Pair));
+    pPair->key = (void*)iKey;
+    pPair->value = (void*)iValue;
+    return pPair;
+}
+
+int32_t CompareReverse(Key keySrc, Key keyTge)
+{
+    if (keySrc == keyTge)
+        return 0;
+    return (keySrc < keyTge)? 1 : (-1);
+}
+
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Basic Structure Verification", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Pair insertion, search, and deletion",
+                                 TestBasicOperation);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Ordered and range iteration", TestIterator);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBasicOperation()
+{
+    SkipList *pList;
+    CU_ASSERT(SkipListInit(&pList) == SUCC);
+    CU_ASSERT(pList->set_destroy(pList, DestroyPair) == SUCC);
+
+    /* Insert the keys in a scattered order. */
+    intptr_t iIdx, iKey;
+    for (iIdx = 0 ; iIdx < COUNT_KEY ; iIdx++) {
+        iKey = (iIdx * 7919) % COUNT_KEY + 1;
+        CU_ASSERT(pList->put(pList, MakePair(iKey, iKey)) == SUCC);
+    }
+    CU_ASSERT_EQUAL(pList->size(pList), COUNT_KEY);
+
+    /* Replace the values of the odd keys. */
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey += 2)
+        CU_ASSERT(pList->put(pList, MakePair(iKey, -iKey)) == SUCC);
+    CU_ASSERT_EQUAL(pList->size(pList), COUNT_KEY);
+
+    Value value;
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey++) {
+        CU_ASSERT(pList->find(pList, (Key)iKey) == SUCC);
+        CU_ASSERT(pList->get(pList, (Key)iKey, &value) == SUCC);
+        CU_ASSERT_EQUAL((intptr_t)value, (iKey & 1)? -iKey : iKey);
+    }
+    CU_ASSERT(pList->find(pList, (Key)0) == NOKEY);
+    CU_ASSERT(pList->find(pList, (Key)(COUNT_KEY + 1)) == NOKEY);
+    CU_ASSERT(pList->get(pList, (Key)(COUNT_KEY + 1), &value) == ERR_NODATA);
+    CU_ASSERT(pList->get(pList, (Key)1, NULL) == ERR_GET);
+
+    /* Delete the even keys, and insert some of them back. */
+    for (iKey = 2 ; iKey <= COUNT_KEY ; iKey += 2)
+        CU_ASSERT(pList->remove(pList, (Key)iKey) == SUCC);
+    CU_ASSERT(pList->remove(pList, (Key)2) == ERR_NODATA);
+    CU_ASSERT_EQUAL(pList->size(pList), COUNT_KEY / 2);
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey++) {
+        int32_t iRtn = pList->find(pList, (Key)iKey);
+        CU_ASSERT_EQUAL(iRtn, (iKey & 1)? SUCC : NOKEY);
+    }
+    CU_ASSERT(pList->put(pList, MakePair(2, 2)) == SUCC);
+    CU_ASSERT(pList->get(pList, (Key)2, &value) == SUCC);
+    CU_ASSERT_EQUAL((intptr_t)value, 2);
+    CU_ASSERT_EQUAL(pList->size(pList), COUNT_KEY / 2 + 1);
+
+    SkipListDeinit(&pList);
+}
+
+void TestIterator()
+{
+    SkipList *pList;
+    CU_ASSERT(SkipListInit(&pList) == SUCC);
+    CU_ASSERT(pList->set_destroy(pList, DestroyPair) == SUCC);
+    CU_ASSERT(pList->set_compare(pList, CompareReverse) == SUCC);
+
+    Pair *pPair;
+    SkipListIter iter;
+    CU_ASSERT(pList->iter_open(pList, &iter) == SUCC);
+    CU_ASSERT(pList->iter_next(pList, &iter, &pPair) == END);
+    CU_ASSERT(pList->iter_close(pList, &iter) == SUCC);
+    CU_ASSERT(pList->iter_close(pList, &iter) == ERR_GET);
+    CU_ASSERT(pList->iter_next(pList, &iter, &pPair) == ERR_GET);
+
+    intptr_t iKey;
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey++)
+        CU_ASSERT(pList->put(pList, MakePair(iKey, iKey)) == SUCC);
+    for (iKey = 1 ; iKey <= COUNT_KEY ; iKey += 3)
+        CU_ASSERT(pList->remove(pList, (Key)iKey) == SUCC);
+
+    /* The custom order is descending. */
+    intptr_t iPrev = COUNT_KEY + 1;
+    int32_t iCount = 0;
+    CU_ASSERT(pList->iter_open(pList, &iter) == SUCC);
+    while (pList->iter_next(pList, &iter, &pPair) == CONTINUE) {
+        CU_ASSERT((intptr_t)pPair->key < iPrev);
+        CU_ASSERT((intptr_t)pPair->key % 3 != 1);
+        iPrev = (intptr_t)pPair->key;
+        iCount++;
+    }
+    CU_ASSERT(pList->iter_close(pList, &iter) == SUCC);
+    CU_ASSERT_EQUAL(iCount, pList->size(pList));
+
+    /* Scan the keys from 100 down to 51, where a third of them are deleted. */
+    iCount = 0;
+    iKey = 100;
+    CU_ASSERT(pList->iter_range(pList, &iter, (Key)100, (Key)50) == SUCC);
+    while (pList->iter_next(pList, &iter, &pPair) == CONTINUE) {
+        if (iKey % 3 == 1)
+            iKey--;
+        CU_ASSERT_EQUAL((intptr_t)pPair->key, iKey);
+        iKey--;
+        iCount++;
+    }
+    CU_ASSERT(pList->iter_close(pList, &iter) == SUCC);
+    CU_ASSERT_EQUAL(iKey, 50);
+    CU_ASSERT_EQUAL(iCount, 33);
+
+    /* The empty range. */
+    CU_ASSERT(pList->iter_range(pList, &iter, (Key)10, (Key)10) == SUCC);
+    CU_ASSERT(pList->iter_next(pList, &iter, &pPair) == END);
+    CU_ASSERT(pList->iter_close(pList, &iter) == SUCC);
+
+    SkipListDeinit(&pList);
+}
+
+
+/*------------------------------------------------------------*
+ *     Test Function Implementation for Concurrent Suite      *
+ *------------------------------------------------------------*/
+int32_t AddConcurrentSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Concurrent Manipulation", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Concurrent writers",
+                                 TestConcurrentWrite);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Lock free reads during the writes",
+                        TestReadWhileWrite);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Removal racing the reinsertion of the same key",
+                        TestChurnSameKey);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Removal behind a new node of the same key",
+                        TestUnlinkBehindSameKey);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void* WriteRoutine(void *pArg)
+{
+    Worker *pWorker = (Worker*)pArg;
+    SkipList *pList = pWorker->pList;
+
+    /* Each thread owns a disjoint range of keys above the shared ones, and
+       all the threads fight over the shared keys. */
+    intptr_t iBase = RANGE_SHARED + (intptr_t)pWorker->iId * COUNT_ROUND;
+    int32_t iRound;
+    for (iRound = 0 ; iRound < COUNT_ROUND ; iRound++) {
+        intptr_t iKey = iBase + iRound;
+        if (pList->put(pList, MakePair(iKey, iKey)) != SUCC)
+            pWorker->iFault++;
+        if ((iRound & 1) && pList->remove(pList, (Key)(iKey - 1)) != SUCC)
+            pWorker->iFault++;
+
+        iKey = (iRound * 31 + pWorker->iId) % RANGE_SHARED;
+        if (iRound % 3 == 0)
+            pList->remove(pList, (Key)iKey);
+        else
+            pList->put(pList, MakePair(iKey, iKey));
+    }
+    return NULL;
+}
+
+void TestConcurrentWrite()
+{
+    SkipList *pList;
+    CU_ASSERT(SkipListInit(&pList) == SUCC);
+    CU_ASSERT(pList->set_destroy(pList, DestroyPair) == SUCC);
+
+    pthread_t aThrd[COUNT_THREAD];
+    Worker aWorker[COUNT_THREAD];
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_THREAD ; iIdx++) {
+        aWorker[iIdx].pList = pList;
+        aWorker[iIdx].iId = iIdx;
+        aWorker[iIdx].iFault = 0;
+        pthread_create(&aThrd[iIdx], NULL, WriteRoutine, &aWorker[iIdx]);
+    }
+    for (iIdx = 0 ; iIdx < COUNT_THREAD ; iIdx++) {
+        pthread_join(aThrd[iIdx], NULL);
+        CU_ASSERT_EQUAL(aWorker[iIdx].iFault, 0);
+    }
+
+    /* Only the odd keys of each private range survive. */
+    intptr_t iKey;
+    for (iKey = RANGE_SHARED ;
+         iKey < RANGE_SHARED + COUNT_THREAD * COUNT_ROUND ; iKey++) {
+        int32_t iRtn = pList->find(pList, (Key)iKey);
+        CU_ASSERT_EQUAL(iRtn, ((iKey - RANGE_SHARED) & 1)? SUCC : NOKEY);
+    }
+
+    /* The list should be sorted and match its size. */
+    Pair *pPair;
+    SkipListIter iter;
+    intptr_t iPrev = -1;
+    int32_t iCount = 0;
+    CU_ASSERT(pList->iter_open(pList, &iter) == SUCC);
+    while (pList->iter_next(pList, &iter, &pPair) == CONTINUE) {
+        CU_ASSERT((intptr_t)pPair->key > iPrev);
+        iPrev = (intptr_t)pPair->key;
+        iCount++;
+    }
+    CU_ASSERT(pList->iter_close(pList, &iter) == SUCC);
+    CU_ASSERT_EQUAL(iCount, pList->size(pList));
+    CU_ASSERT(iCount >= COUNT_THREAD * COUNT_ROUND / 2);
+
+    SkipListDeinit(&pList);
+}
+
+void* ReadRoutine(void *pArg)
+{
+    Worker *pWorker = (Worker*)pArg;
+    SkipList *pList = pWorker->pList;
+
+    /* The stable keys below the shared range are never deleted. */
+    int32_t iRound;
+    for (iRound = 0 ; iRound < COUNT_ROUND ; iRound++) {
+        Value value;
+        intptr_t iKey = -1 - (iRound % RANGE_SHARED);
+        if (pList->get(pList, (Key)iKey, &value) != SUCC ||
+            (intptr_t)value != iKey)
+            pWorker->iFault++;
+
+        Pair *pPair;
+        SkipListIter iter;
+        intptr_t iPrev = -RANGE_SHARED - 1;
+        pList->iter_range(pList, &iter, (Key)iPrev, (Key)RANGE_SHARED);
+        while (pList->iter_next(pList, &iter, &pPair) == CONTINUE) {
+            if ((intptr_t)pPair->key <= iPrev)
+                pWorker->iFault++;
+            iPrev = (intptr_t)pPair->key;
+        }
+        pList->iter_close(pList, &iter);
+    }
+    return NULL;
+}
+
+void TestReadWhileWrite()
+{
+    SkipList *pList;
+    CU_ASSERT(SkipListInit(&pList) == SUCC);
+    CU_ASSERT(pList->set_destroy(pList, DestroyPair) == SUCC);
+
+    intptr_t iKey;
+    for (iKey = -RANGE_SHARED ; iKey < 0 ; iKey++)
+        CU_ASSERT(pList->put(pList, MakePair(iKey, iKey)) == SUCC);
+
+    pthread_t aThrd[COUNT_THREAD];
+    Worker aWorker[COUNT_THREAD];
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_THREAD ; iIdx++) {
+        aWorker[iIdx].pList = pList;
+        aWorker[iIdx].iId = iIdx;
+        aWorker[iIdx].iFault = 0;
+        pthread_create(&aThrd[iIdx], NULL,
+                       (iIdx & 1)? ReadRoutine : WriteRoutine, &aWorker[iIdx]);
+    }
+    for (iIdx = 0 ; iIdx < COUNT_THREAD ; iIdx++) {
+        pthread_join(aThrd[iIdx], NULL);
+        CU_ASSERT_EQUAL(aWorker[iIdx].iFault, 0);
+    }
+
+    SkipListDeinit(&pList);
+}
+
+void* ChurnRoutine(void *pArg)
+{
+    Worker *pWorker = (Worker*)pArg;
+    SkipList *pList = pWorker->pList;
+
+    /* All the threads delete and put back the same few keys, so a new node
+       is often linked in front of a deleted one of the same key. */
+    int32_t iRound;
+    for (iRound = 0 ; iRound < COUNT_ROUND * 4 ; iRound++) {
+        intptr_t iKey = (iRound + pWorker->iId) % RANGE_CHURN;
+        if (pList->put(pList, MakePair(iKey, iKey)) != SUCC)
+            pWorker->iFault++;
+        pList->remove(pList, (Key)iKey);
+    }
+    return NULL;
+}
+
+void TestChurnSameKey()
+{
+    SkipList *pList;
+    CU_ASSERT(SkipListInit(&pList) == SUCC);
+    CU_ASSERT(pList->set_destroy(pList, DestroyPair) == SUCC);
+
+    pthread_t aThrd[COUNT_THREAD];
+    Worker aWorker[COUNT_THREAD];
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_THREAD ; iIdx++) {
+        aWorker[iIdx].pList = pList;
+        aWorker[iIdx].iId = iIdx;
+        aWorker[iIdx].iFault = 0;
+        pthread_create(&aThrd[iIdx], NULL, ChurnRoutine, &aWorker[iIdx]);
+    }
+    for (iIdx = 0 ; iIdx < COUNT_THREAD ; iIdx++) {
+        pthread_join(aThrd[iIdx], NULL);
+        CU_ASSERT_EQUAL(aWorker[iIdx].iFault, 0);
+    }
+
+    /* Each key is held by at most one live node. */
+    Pair *pPair;
+    SkipListIter iter;
+    intptr_t iPrev = -1;
+    int32_t iCount = 0;
+    CU_ASSERT(pList->iter_open(pList, &iter) == SUCC);
+    while (pList->iter_next(pList, &iter, &pPair) == CONTINUE) {
+        CU_ASSERT((intptr_t)pPair->key > iPrev);
+        iPrev = (intptr_t)pPair->key;
+        iCount++;
+    }
+    CU_ASSERT(pList->iter_close(pList, &iter) == SUCC);
+    CU_ASSERT_EQUAL(iCount, pList->size(pList));
+    CU_ASSERT(iCount <= RANGE_CHURN);
+
+    SkipListDeinit(&pList);
+}
+
+int32_t CompareStaged(Key keySrc, Key keyTge)
+{
+    Key keyStage = (Key)_stage.iKey;
+
+    /* The keys start from one, so a null key is read from a released node. */
+    if (!keySrc)
+        __atomic_fetch_add(&_stage.iStale, 1, __ATOMIC_RELAXED);
+
+    /* The inserter meets the live node of the staged key at its top level,
+       and holds it as the successor there. */
+    if (_iRole == ROLE_PUT && !_bHeld && keySrc == keyStage) {
+        _bHeld = true;
+        sem_post(&_stage.semPause);
+        sem_wait(&_stage.semPut);
+    }
+
+    /* The first key the remover compares is met again only when the cleanup
+       after the marking restarts from the highest level. */
+    if (_iRole == ROLE_REMOVE && !_bHeld) {
+        if (!_keyFirst)
+            _keyFirst = keySrc;
+        else if (_bEqual && keySrc == _keyFirst && keySrc != keyStage) {
+            _bHeld = true;
+            _stage.bHeld = true;
+            sem_post(&_stage.semPause);
+            sem_wait(&_stage.semRemove);
+        }
+        if (keySrc == keyStage)
+            _bEqual = true;
+    }
+
+    if (keySrc == keyTge)
+        return 0;
+    return (keySrc > keyTge)? 1 : (-1);
+}
+
+void* PutStaged(void *pArg)
+{
+    SkipList *pList = (SkipList*)pArg;
+    _iRole = ROLE_PUT;
+    pList->put(pList, MakePair(_stage.iKey, _stage.iKey));
+    return NULL;
+}
+
+void* RemoveStaged(void *pArg)
+{
+    SkipList *pList = (SkipList*)pArg;
+    _iRole = ROLE_REMOVE;
+    pList->remove(pList, (Key)_stage.iKey);
+    if (!_bHeld)
+        sem_post(&_stage.semPause);
+    return NULL;
+}
+
+void TestUnlinkBehindSameKey()
+{
+    SkipList *pList;
+    CU_ASSERT(SkipListInit(&pList) == SUCC);
+    CU_ASSERT(pList->set_destroy(pList, DestroyPair) == SUCC);
+    CU_ASSERT(pList->set_compare(pList, CompareStaged) == SUCC);
+
+    memset(&_stage, 0, sizeof(Stage));
+    sem_init(&_stage.semPause, 0, 0);
+    sem_init(&_stage.semPut, 0, 0);
+    sem_init(&_stage.semRemove, 0, 0);
+
+    /* The even keys are staged in turn, and the key one is only replaced. */
+    intptr_t iKey;
+    for (iKey = 1 ; iKey <= COUNT_STAGE * 2 ; iKey++) {
+        if (iKey == 1 || !(iKey & 1))
+            CU_ASSERT(pList->put(pList, MakePair(iKey, iKey)) == SUCC);
+    }
+
+    /* The remover marks the node while the inserter holds it as the successor
+       at the top level of the node. Then the inserter unlinks the lower levels
+       and puts its new node in front of the marked one at the top level. The
+       interleaving happens when the node has more than one level and the new
+       node is not shorter, so the stage is repeated over many keys. */
+    void *aBlock[SIZE_SCRIBBLE / 8 * COUNT_SCRIBBLE];
+    int32_t iStage, iIdx;
+    for (iStage = 0 ; iStage < COUNT_STAGE && !_stage.iStale ; iStage++) {
+        _stage.iKey = (iStage + 1) * 2;
+        _stage.bHeld = false;
+
+        pthread_t thrdPut, thrdRemove;
+        pthread_create(&thrdPut, NULL, PutStaged, pList);
+        sem_wait(&_stage.semPause);
+        pthread_create(&thrdRemove, NULL, RemoveStaged, pList);
+        sem_wait(&_stage.semPause);
+        sem_post(&_stage.semPut);
+        pthread_join(thrdPut, NULL);
+        if (_stage.bHeld)
+            sem_post(&_stage.semRemove);
+        pthread_join(thrdRemove, NULL);
+        CU_ASSERT(pList->find(pList, (Key)_stage.iKey) == SUCC);
+
+        /* Replacing the pairs retires enough records to release the removed
+           node, and the blocks from the largest size down reuse its memory. A node
+           left linked is then stepped on by the search of the next key. */
+        for (iIdx = 0 ; iIdx < COUNT_RECLAIM ; iIdx++)
+            pList->put(pList, MakePair(1, iIdx));
+        for (iIdx = 0 ; iIdx < SIZE_SCRIBBLE / 8 * COUNT_SCRIBBLE ; iIdx++) {
+            size_t ulSize = SIZE_SCRIBBLE - (iIdx / COUNT_SCRIBBLE) * 8;
+            aBlock[iIdx] = malloc(ulSize);
+            memset(aBlock[iIdx], 0, ulSize);
+        }
+        pList->find(pList, (Key)(_stage.iKey + 1));
+        for (iIdx = 0 ; iIdx < SIZE_SCRIBBLE / 8 * COUNT_SCRIBBLE ; iIdx++)
+            free(aBlock[iIdx]);
+    }
+    CU_ASSERT_EQUAL(_stage.iStale, 0);
+
+    sem_destroy(&_stage.semPause);
+    sem_destroy(&_stage.semPut);
+    sem_destroy(&_stage.semRemove);
+    SkipListDeinit(&pList);
+}
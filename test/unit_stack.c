@@ -17,6 +17,7 @@ typedef struct Employ_ {
 int32_t AddSuite();
 void TestManipulate();
 void TestBoundary();
+void TestStorage();
 void DestroyItem(Item);
 
 
@@ -64,6 +65,10 @@ int32_t AddSuite()
     if (!pTest)
         rc = ERR_REG;
 
+    pTest = CU_add_test(pSuite, "Storage mode switch", TestStorage);
+    if (!pTest)
+        rc = ERR_REG;
+
 EXIT:
     return rc;
 }
@@ -140,4 +145,42 @@ void TestBoundary()
     CU_ASSERT(pStack->top(pStack, NULL) == ERR_GET);
 
     StackDeinit(&pStack);
-}
\ No newline at end of file
+}
+
+void TestStorage()
+{
+    Stack *pStack;
+    CU_ASSERT(StackInit(&pStack) == SUCC);
+    CU_ASSERT(pStack->set_storage(pStack, -1, NULL) == ERR_POLICY);
+
+    int iIdx;
+    for (iIdx = 0 ; iIdx < SIZE_DATA ; iIdx++)
+        CU_ASSERT(pStack->push(pStack, (Item)(intptr_t)iIdx) == SUCC);
+
+    /* Move the items to the huge page storage and keep growing. */
+    CU_ASSERT(pStack->set_storage(pStack, STORAGE_HUGE_PAGE, NULL) == SUCC);
+    for (iIdx = SIZE_DATA ; iIdx < 100000 ; iIdx++)
+        CU_ASSERT(pStack->push(pStack, (Item)(intptr_t)iIdx) == SUCC);
+
+    /* Move the items to the file backed storage and keep growing. */
+    CU_ASSERT(pStack->set_storage(pStack, STORAGE_FILE,
+                                  "/tmp/unit_stack.spill") == SUCC);
+    for (iIdx = 100000 ; iIdx < 200000 ; iIdx++)
+        CU_ASSERT(pStack->push(pStack, (Item)(intptr_t)iIdx) == SUCC);
+    CU_ASSERT_EQUAL(pStack->size(pStack), 200000);
+
+    /* Move the items back to the heap storage. */
+    CU_ASSERT(pStack->set_storage(pStack, STORAGE_HEAP, NULL) == SUCC);
+    Item item;
+    bool bOrder = true;
+    for (iIdx = 200000 - 1 ; iIdx >= 0 ; iIdx--) {
+        pStack->top(pStack, &item);
+        if (item != (Item)(intptr_t)iIdx)
+            bOrder = false;
+        pStack->pop(pStack);
+    }
+    CU_ASSERT(bOrder);
+    CU_ASSERT_EQUAL(pStack->size(pStack), 0);
+
+    StackDeinit(&pStack);
+}
@@ -0,0 +1,258 @@
+#include "memory/storage.h"
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/*------------------------------------------------------------*
+ *      Test Function Declaration for storage management      *
+ *------------------------------------------------------------*/
+#define PATH_SPILL  "/tmp/unit_storage.spill"
+
+int32_t AddBasicSuite();
+void TestHeap();
+void TestHugePage();
+void TestFile();
+void TestFileShrink();
+void TestSwitch();
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *     Test Function implementation for storage management    *
+ *------------------------------------------------------------*/
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Storage Management", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Heap storage", TestHeap);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Huge page storage", TestHugePage);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "File backed storage", TestFile);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "File backed storage shrink", TestFileShrink);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Storage mode switch", TestSwitch);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void FillPattern(Storage *pStore, size_t ulSize)
+{
+    uint32_t *aWord = (uint32_t*)pStore->pBase;
+    size_t ulIdx;
+    for (ulIdx = 0 ; ulIdx < ulSize / sizeof(uint32_t) ; ulIdx++)
+        aWord[ulIdx] = (uint32_t)(ulIdx * 2654435761u);
+}
+
+bool CheckPattern(Storage *pStore, size_t ulSize)
+{
+    uint32_t *aWord = (uint32_t*)pStore->pBase;
+    size_t ulIdx;
+    for (ulIdx = 0 ; ulIdx < ulSize / sizeof(uint32_t) ; ulIdx++) {
+        if (aWord[ulIdx] != (uint32_t)(ulIdx * 2654435761u))
+            return false;
+    }
+    return true;
+}
+
+void TestHeap()
+{
+    Storage store;
+    CU_ASSERT(StorageInit(&store, -1, NULL) == ERR_POLICY);
+    CU_ASSERT(StorageInit(&store, STORAGE_HEAP, NULL) == SUCC);
+    CU_ASSERT_EQUAL(store.pBase, NULL);
+    CU_ASSERT_EQUAL(store.ulSize, 0);
+
+    /* The small storage stays in the heap. */
+    CU_ASSERT(StorageResize(&store, 4096) == SUCC);
+    CU_ASSERT_EQUAL(store.ulSize, 4096);
+    FillPattern(&store, 4096);
+
+    /* The large storage is moved to the system mapping. */
+    size_t ulLarge = (size_t)1 << 27;
+    CU_ASSERT(StorageResize(&store, ulLarge) == SUCC);
+    CU_ASSERT(store.ulSize >= ulLarge);
+    CU_ASSERT(CheckPattern(&store, 4096));
+    FillPattern(&store, ulLarge);
+
+    /* Extend and shrink the mapping. */
+    CU_ASSERT(StorageResize(&store, ulLarge * 2) == SUCC);
+    CU_ASSERT(CheckPattern(&store, ulLarge));
+    CU_ASSERT(StorageResize(&store, 8192) == SUCC);
+    CU_ASSERT(store.ulSize >= 8192);
+    CU_ASSERT(CheckPattern(&store, 8192));
+
+    CU_ASSERT(StorageResize(&store, 0) == SUCC);
+    CU_ASSERT_EQUAL(store.pBase, NULL);
+    StorageDeinit(&store);
+}
+
+void TestHugePage()
+{
+    Storage store;
+    CU_ASSERT(StorageInit(&store, STORAGE_HUGE_PAGE, NULL) == SUCC);
+
+    /* The size is rounded up to the huge page size. */
+    CU_ASSERT(StorageResize(&store, 100) == SUCC);
+    CU_ASSERT_EQUAL(store.ulSize, (size_t)1 << 21);
+    CU_ASSERT_EQUAL((uintptr_t)store.pBase & (((uintptr_t)1 << 21) - 1), 0);
+    FillPattern(&store, store.ulSize);
+
+    size_t ulSize = store.ulSize;
+    CU_ASSERT(StorageResize(&store, (size_t)1 << 25) == SUCC);
+    CU_ASSERT_EQUAL(store.ulSize, (size_t)1 << 25);
+    CU_ASSERT(CheckPattern(&store, ulSize));
+
+    StorageDeinit(&store);
+}
+
+void TestFile()
+{
+    Storage store;
+    CU_ASSERT(StorageInit(&store, STORAGE_FILE, NULL) == ERR_POLICY);
+    CU_ASSERT(StorageInit(&store, STORAGE_FILE, "/nonexistent/dir/file") == ERR_IO);
+    CU_ASSERT(StorageInit(&store, STORAGE_FILE, PATH_SPILL) == SUCC);
+
+    /* The backing file is unlinked right after creation. */
+    FILE *pFile = fopen(PATH_SPILL, "r");
+    CU_ASSERT_EQUAL(pFile, NULL);
+    if (pFile)
+        fclose(pFile);
+
+    CU_ASSERT(StorageResize(&store, 10000) == SUCC);
+    CU_ASSERT(store.ulSize >= 10000);
+    FillPattern(&store, 10000);
+    CU_ASSERT(StorageResize(&store, (size_t)1 << 24) == SUCC);
+    CU_ASSERT(CheckPattern(&store, 10000));
+    CU_ASSERT(StorageResize(&store, 4096) == SUCC);
+    CU_ASSERT(CheckPattern(&store, 4096));
+
+    StorageDeinit(&store);
+}
+
+off_t FileSize(Storage *pStore)
+{
+    struct stat st;
+    if (fstat(pStore->iFd, &st) != 0)
+        return -1;
+    return st.st_size;
+}
+
+void TestFileShrink()
+{
+    Storage store;
+    CU_ASSERT(StorageInit(&store, STORAGE_FILE, PATH_SPILL) == SUCC);
+
+    size_t ulPage = (size_t)sysconf(_SC_PAGESIZE);
+    size_t ulLarge = (size_t)1 << 24;
+    CU_ASSERT(StorageResize(&store, ulLarge) == SUCC);
+    CU_ASSERT_EQUAL(store.ulSize, ulLarge);
+    CU_ASSERT_EQUAL(FileSize(&store), (off_t)ulLarge);
+    FillPattern(&store, ulLarge);
+
+    /* The file is truncated to the rounded size before the mapping drops
+       the tail, and the head of the content is preserved. */
+    CU_ASSERT(StorageResize(&store, ulPage * 3 - 100) == SUCC);
+    CU_ASSERT_EQUAL(store.ulSize, ulPage * 3);
+    CU_ASSERT_EQUAL(FileSize(&store), (off_t)(ulPage * 3));
+    CU_ASSERT(CheckPattern(&store, ulPage * 3));
+
+    /* The extension beyond the file size limit fails in the truncation, and
+       the storage is left untouched. */
+    struct rlimit limOld, limNew;
+    CU_ASSERT(getrlimit(RLIMIT_FSIZE, &limOld) == 0);
+    void (*pHandler)(int) = signal(SIGXFSZ, SIG_IGN);
+    limNew = limOld;
+    limNew.rlim_cur = ulPage * 4;
+    CU_ASSERT(setrlimit(RLIMIT_FSIZE, &limNew) == 0);
+
+    void *pBase = store.pBase;
+    CU_ASSERT(StorageResize(&store, ulLarge) == ERR_IO);
+    CU_ASSERT_EQUAL(store.pBase, pBase);
+    CU_ASSERT_EQUAL(store.ulSize, ulPage * 3);
+    CU_ASSERT_EQUAL(FileSize(&store), (off_t)(ulPage * 3));
+    CU_ASSERT(CheckPattern(&store, ulPage * 3));
+
+    /* The shrink is still allowed under the limit. */
+    CU_ASSERT(StorageResize(&store, ulPage) == SUCC);
+    CU_ASSERT_EQUAL(store.ulSize, ulPage);
+    CU_ASSERT_EQUAL(FileSize(&store), (off_t)ulPage);
+    CU_ASSERT(CheckPattern(&store, ulPage));
+
+    CU_ASSERT(setrlimit(RLIMIT_FSIZE, &limOld) == 0);
+    signal(SIGXFSZ, pHandler);
+
+    CU_ASSERT(StorageResize(&store, 0) == SUCC);
+    CU_ASSERT_EQUAL(store.pBase, NULL);
+    CU_ASSERT_EQUAL(store.ulSize, 0);
+    CU_ASSERT_EQUAL(FileSize(&store), 0);
+    StorageDeinit(&store);
+}
+
+void TestSwitch()
+{
+    Storage store;
+    CU_ASSERT(StorageInit(&store, STORAGE_HEAP, NULL) == SUCC);
+    CU_ASSERT(StorageResize(&store, 40000) == SUCC);
+    FillPattern(&store, 40000);
+
+    /* Move the content across all the modes. */
+    CU_ASSERT(StorageSwitch(&store, STORAGE_HUGE_PAGE, NULL) == SUCC);
+    CU_ASSERT_EQUAL(store.iMode, STORAGE_HUGE_PAGE);
+    CU_ASSERT(CheckPattern(&store, 40000));
+
+    CU_ASSERT(StorageSwitch(&store, STORAGE_FILE, PATH_SPILL) == SUCC);
+    CU_ASSERT_EQUAL(store.iMode, STORAGE_FILE);
+    CU_ASSERT(CheckPattern(&store, 40000));
+
+    CU_ASSERT(StorageSwitch(&store, STORAGE_HEAP, NULL) == SUCC);
+    CU_ASSERT_EQUAL(store.iMode, STORAGE_HEAP);
+    CU_ASSERT(CheckPattern(&store, 40000));
+
+    /* The old storage is kept for the illegal switch. */
+    CU_ASSERT(StorageSwitch(&store, 7, NULL) == ERR_POLICY);
+    CU_ASSERT(CheckPattern(&store, 40000));
+
+    StorageDeinit(&store);
+}
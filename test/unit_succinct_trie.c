@@ -0,0 +1,265 @@
+#include "container/succinct_trie.h"
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+
+
+#define FREE_BLOCK_TEST(_arr, _num)                                             \
+            do {                                                                \
+                int32_t _idx;                                                   \
+                for (_idx = 0 ; _idx < _num ; ++_idx)                           \
+                    free((_arr)[_idx]);                                         \
+                free(_arr);                                                     \
+            } while (0);
+
+
+/*------------------------------------------------------------*
+ * Test Function Declaration for basic structure verification *
+ *------------------------------------------------------------*/
+int32_t AddBasicSuite();
+void TestBasicQuery();
+void TestEmptyTrie();
+
+
+/*------------------------------------------------------------*
+ *    Test Function Declaration for bulk data manipulation    *
+ *------------------------------------------------------------*/
+#define COUNT_BULK          (3000)
+#define SIZE_BULK_STR       (12)
+
+int32_t AddBulkSuite();
+void TestBulkQuery();
+
+
+int32_t main()
+{
+    int32_t rc = SUCC;
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        rc = CU_get_error();
+        goto EXIT;
+    }
+
+    /* Register the test suite for basic structure verification. */
+    if (AddBasicSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Register the test suite for bulk data manipulation. */
+    if (AddBulkSuite() != SUCC) {
+        rc = CU_get_error();
+        goto CLEAN;
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+CLEAN:
+    CU_cleanup_registry();
+EXIT:
+    return rc;
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Basic Suite        *
+ *------------------------------------------------------------*/
+int32_t AddBasicSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Basic Structure Verification", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Queries on the encoded strings",
+                     TestBasicQuery);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Empty and rebuilt trie", TestEmptyTrie);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBasicQuery()
+{
+    char *aStr[8] = {"romulus", "rubens", "romane", "rom", "rubicundus",
+                     "romanus", "ruber", "rubicon"};
+    Trie *pTrie;
+    CU_ASSERT(TrieInit(&pTrie) == SUCC);
+    CU_ASSERT(pTrie->bulk_insert(pTrie, aStr, 8) == SUCC);
+
+    SuccinctTrie *pSuccinct;
+    CU_ASSERT(SuccinctTrieInit(&pSuccinct) == SUCC);
+    CU_ASSERT_EQUAL(pSuccinct->size(pSuccinct), 0);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "rom") == NOKEY);
+    CU_ASSERT(pSuccinct->build(pSuccinct, NULL) == ERR_NOINIT);
+    CU_ASSERT(pSuccinct->build(pSuccinct, pTrie) == SUCC);
+    CU_ASSERT_EQUAL(pSuccinct->size(pSuccinct), 8);
+    TrieDeinit(&pTrie);
+
+    /* The string which prefixes the others is marked by its terminal bit. */
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "rom") == SUCC);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "romanus") == SUCC);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "roma") == NOKEY);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "romanuses") == NOKEY);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "") == NOKEY);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, NULL) == NOKEY);
+    CU_ASSERT(pSuccinct->has_prefix_as(pSuccinct, "rubic") == SUCC);
+    CU_ASSERT(pSuccinct->has_prefix_as(pSuccinct, "rubicundusx") == NOKEY);
+    CU_ASSERT(pSuccinct->has_prefix_as(pSuccinct, "x") == NOKEY);
+    CU_ASSERT(pSuccinct->has_prefix_as(pSuccinct, "") == NOKEY);
+
+    /* The resolved strings are sorted. */
+    char **aGet;
+    int iNum;
+    CU_ASSERT(pSuccinct->get_prefix_as(pSuccinct, "rom", &aGet, &iNum) == SUCC);
+    CU_ASSERT_EQUAL(iNum, 4);
+    if (iNum == 4) {
+        CU_ASSERT(strcmp(aGet[0], "rom") == 0);
+        CU_ASSERT(strcmp(aGet[1], "romane") == 0);
+        CU_ASSERT(strcmp(aGet[2], "romanus") == 0);
+        CU_ASSERT(strcmp(aGet[3], "romulus") == 0);
+    }
+    FREE_BLOCK_TEST(aGet, iNum);
+    CU_ASSERT(pSuccinct->get_prefix_as(pSuccinct, "rube", &aGet, &iNum) == SUCC);
+    CU_ASSERT_EQUAL(iNum, 2);
+    if (iNum == 2) {
+        CU_ASSERT(strcmp(aGet[0], "rubens") == 0);
+        CU_ASSERT(strcmp(aGet[1], "ruber") == 0);
+    }
+    FREE_BLOCK_TEST(aGet, iNum);
+    CU_ASSERT(pSuccinct->get_prefix_as(pSuccinct, "rot", &aGet, &iNum) == NOKEY);
+    CU_ASSERT(aGet == NULL);
+    CU_ASSERT_EQUAL(iNum, 0);
+    CU_ASSERT(pSuccinct->get_prefix_as(pSuccinct, "rom", NULL, &iNum) ==
+              ERR_GET);
+
+    /* The character trie has 28 nodes including the root. */
+    TrieStat stat;
+    CU_ASSERT(pSuccinct->get_stat(pSuccinct, &stat) == SUCC);
+    CU_ASSERT_EQUAL(stat.lCountNode, 28);
+    CU_ASSERT(pSuccinct->get_stat(pSuccinct, NULL) == ERR_GET);
+
+    SuccinctTrieDeinit(&pSuccinct);
+    CU_ASSERT(SuccinctTrieSize(pSuccinct) == ERR_NOINIT);
+}
+
+void TestEmptyTrie()
+{
+    Trie *pTrie;
+    CU_ASSERT(TrieInit(&pTrie) == SUCC);
+    SuccinctTrie *pSuccinct;
+    CU_ASSERT(SuccinctTrieInit(&pSuccinct) == SUCC);
+    CU_ASSERT(pSuccinct->has_prefix_as(pSuccinct, "a") == NOKEY);
+
+    /* The rebuild replaces the previous content. */
+    CU_ASSERT(pTrie->insert(pTrie, "alpha") == SUCC);
+    CU_ASSERT(pSuccinct->build(pSuccinct, pTrie) == SUCC);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "alpha") == SUCC);
+    CU_ASSERT(pTrie->remove(pTrie, "alpha") == SUCC);
+    CU_ASSERT(pTrie->insert(pTrie, "beta") == SUCC);
+    CU_ASSERT(pSuccinct->build(pSuccinct, pTrie) == SUCC);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "alpha") == NOKEY);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "beta") == SUCC);
+
+    /* The empty trie is encoded too. */
+    CU_ASSERT(pTrie->remove(pTrie, "beta") == SUCC);
+    CU_ASSERT(pSuccinct->build(pSuccinct, pTrie) == SUCC);
+    CU_ASSERT_EQUAL(pSuccinct->size(pSuccinct), 0);
+    CU_ASSERT(pSuccinct->has_exact(pSuccinct, "beta") == NOKEY);
+    CU_ASSERT(pSuccinct->has_prefix_as(pSuccinct, "\x01") == NOKEY);
+
+    TrieDeinit(&pTrie);
+    SuccinctTrieDeinit(&pSuccinct);
+}
+
+
+/*------------------------------------------------------------*
+ *        Test Function Implementation for Bulk Suite         *
+ *------------------------------------------------------------*/
+int32_t AddBulkSuite()
+{
+    CU_pSuite pSuite = CU_add_suite("Bulk data manipulation", NULL, NULL);
+    if (!pSuite)
+        return ERR_REG;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Queries against Trie", TestBulkQuery);
+    if (!pTest)
+        return ERR_REG;
+
+    return SUCC;
+}
+
+void TestBulkQuery()
+{
+    /* The strings share the short prefixes, and some carry the bytes beyond
+       ASCII. */
+    static char aBuf[COUNT_BULK * 2][SIZE_BULK_STR];
+    char *aStr[COUNT_BULK];
+    srand(17);
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_BULK * 2 ; iIdx++) {
+        int32_t iLen = rand() % (SIZE_BULK_STR - 2) + 1;
+        int32_t iPos;
+        for (iPos = 0 ; iPos < iLen ; iPos++)
+            aBuf[iIdx][iPos] = (iPos < 2)? ('a' + rand() % 3) :
+                               ((rand() % 8 == 0)? (char)(0xc0 + rand() % 4) :
+                                ('a' + rand() % 6));
+        aBuf[iIdx][iLen] = 0;
+    }
+    for (iIdx = 0 ; iIdx < COUNT_BULK ; iIdx++)
+        aStr[iIdx] = aBuf[iIdx];
+
+    int32_t iMode;
+    for (iMode = TRIE_MODE_TERNARY ; iMode <= TRIE_MODE_RADIX ; iMode++) {
+        Trie *pTrie;
+        CU_ASSERT(TrieInit(&pTrie) == SUCC);
+        CU_ASSERT(pTrie->set_mode(pTrie, iMode) == SUCC);
+        CU_ASSERT(pTrie->bulk_insert(pTrie, aStr, COUNT_BULK) == SUCC);
+        for (iIdx = 0 ; iIdx < COUNT_BULK ; iIdx += 7)
+            pTrie->remove(pTrie, aStr[iIdx]);
+
+        SuccinctTrie *pSuccinct;
+        CU_ASSERT(SuccinctTrieInit(&pSuccinct) == SUCC);
+        CU_ASSERT(pSuccinct->build(pSuccinct, pTrie) == SUCC);
+        CU_ASSERT_EQUAL(pSuccinct->size(pSuccinct), pTrie->size(pTrie));
+
+        /* Both the inserted and the absent strings answer the same. */
+        for (iIdx = 0 ; iIdx < COUNT_BULK * 2 ; iIdx++) {
+            CU_ASSERT_EQUAL(pSuccinct->has_exact(pSuccinct, aBuf[iIdx]),
+                            pTrie->has_exact(pTrie, aBuf[iIdx]));
+            CU_ASSERT_EQUAL(pSuccinct->has_prefix_as(pSuccinct, aBuf[iIdx]),
+                            pTrie->has_prefix_as(pTrie, aBuf[iIdx]));
+        }
+
+        /* The short prefixes resolve the same sets of strings. */
+        char szPrefix[3] = {0, 0, 0};
+        char cFst, cSnd;
+        for (cFst = 'a' ; cFst <= 'c' ; cFst++) {
+            for (cSnd = 'a' ; cSnd <= 'd' ; cSnd++) {
+                szPrefix[0] = cFst;
+                szPrefix[1] = cSnd;
+                char **aTrie, **aGet;
+                int iTrie, iGet;
+                int32_t iRtn = pTrie->get_prefix_as(pTrie, szPrefix, &aTrie,
+                                                    &iTrie);
+                CU_ASSERT_EQUAL(pSuccinct->get_prefix_as(pSuccinct, szPrefix, &aGet,
+                                                       &iGet), iRtn);
+                CU_ASSERT_EQUAL(iGet, iTrie);
+                int32_t iOrd;
+                for (iOrd = 1 ; iOrd < iGet ; iOrd++)
+                    CU_ASSERT(strcmp(aGet[iOrd - 1], aGet[iOrd]) < 0);
+                for (iOrd = 0 ; iOrd < iGet ; iOrd++)
+                    CU_ASSERT(pTrie->has_exact(pTrie, aGet[iOrd]) == SUCC);
+                FREE_BLOCK_TEST(aTrie, iTrie);
+                FREE_BLOCK_TEST(aGet, iGet);
+            }
+        }
+
+        SuccinctTrieDeinit(&pSuccinct);
+        TrieDeinit(&pTrie);
+    }
+}
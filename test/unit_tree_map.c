@@ -10,6 +10,13 @@ int32_t AddBasicSuite();
 void TestBasicInsert();
 void TestBoundary();
 void TestIterator();
+void TestRange();
+void TestOrderStatistic();
+void TestCursor();
+void TestBuild();
+void TestJoinSplit();
+void TestSnapshot();
+void TestPairMode();
 
 void DestroyBasicPair(Pair*);
 int32_t CompareBasicKey(Key, Key);
@@ -93,6 +100,10 @@ int32_t CompareBasicKey(Key keySrc, Key keyTge)
     return (keySrc > keyTge)? 1 : (-1);
 }
 
+int32_t iInlineDrop;
+
+void DestroyInlinePair(Pair *pPair) { iInlineDrop++; }
+
 int32_t AddBasicSuite()
 {
     CU_pSuite pSuite = CU_add_suite("Basic Structure Verification", NULL, NULL);
@@ -113,6 +124,34 @@ int32_t AddBasicSuite()
     if (!pTest)
         return ERR_REG;
 
+    pTest = CU_add_test(pSuite, "Bound search and range query", TestRange);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Rank and select", TestOrderStatistic);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Independent cursors", TestCursor);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Bulk build", TestBuild);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Join, split, and merge", TestJoinSplit);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Persistent snapshots", TestSnapshot);
+    if (!pTest)
+        return ERR_REG;
+
+    pTest = CU_add_test(pSuite, "Inline pair storage", TestPairMode);
+    if (!pTest)
+        return ERR_REG;
+
     return SUCC;
 }
 
@@ -360,6 +399,590 @@ void TestIterator()
     TreeMapDeinit(&pMap);
 }
 
+void TestRange()
+{
+    TreeMap *pMap;
+    CU_ASSERT(TreeMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_compare(pMap, CompareBasicKey) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyBasicPair) == SUCC);
+
+    /* Query the empty map. */
+    Pair *pPair;
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)0, NULL) == ERR_GET);
+    CU_ASSERT(pMap->upper_bound(pMap, (Key)0, NULL) == ERR_GET);
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)0, &pPair) == ERR_NODATA);
+    CU_ASSERT(pMap->upper_bound(pMap, (Key)0, &pPair) == ERR_NODATA);
+    CU_ASSERT_EQUAL(pMap->count_range(pMap, (Key)0, (Key)100), 0);
+    CU_ASSERT(pMap->iterate_range(pMap, true, (Key)0, (Key)100, NULL) == SUCC);
+    CU_ASSERT(pMap->iterate_range(pMap, false, NULL, NULL, &pPair) == END);
+
+    /* Insert the even keys within [2, COUNT_ITER]. */
+    int64_t lKey;
+    for (lKey = 2 ; lKey <= COUNT_ITER ; lKey += 2) {
+        pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = (void*)(intptr_t)lKey;
+        pPair->value = 0;
+        CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+    }
+
+    /* The bounds of the stored and the absent keys. */
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)10, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)10);
+    CU_ASSERT(pMap->upper_bound(pMap, (Key)10, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)12);
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)11, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)12);
+    CU_ASSERT(pMap->upper_bound(pMap, (Key)11, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)12);
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)0, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)2);
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)COUNT_ITER, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)COUNT_ITER);
+    CU_ASSERT(pMap->upper_bound(pMap, (Key)COUNT_ITER, &pPair) == ERR_NODATA);
+    CU_ASSERT_EQUAL(pPair, NULL);
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)(COUNT_ITER + 1), &pPair) == ERR_NODATA);
+
+    /* Scan the half open ranges. */
+    CU_ASSERT(pMap->iterate_range(pMap, true, (Key)101, (Key)201, NULL) == SUCC);
+    CU_ASSERT(pMap->iterate_range(pMap, false, NULL, NULL, NULL) == ERR_GET);
+    lKey = 102;
+    while (pMap->iterate_range(pMap, false, NULL, NULL, &pPair) != END) {
+        CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)lKey);
+        lKey += 2;
+    }
+    CU_ASSERT_EQUAL(lKey, 202);
+    CU_ASSERT_EQUAL(pPair, NULL);
+    CU_ASSERT(pMap->iterate_range(pMap, false, NULL, NULL, &pPair) == END);
+
+    CU_ASSERT_EQUAL(pMap->count_range(pMap, (Key)101, (Key)201), 50);
+    CU_ASSERT_EQUAL(pMap->count_range(pMap, (Key)100, (Key)200), 50);
+    CU_ASSERT_EQUAL(pMap->count_range(pMap, (Key)100, (Key)100), 0);
+    CU_ASSERT_EQUAL(pMap->count_range(pMap, (Key)200, (Key)100), 0);
+    CU_ASSERT_EQUAL(pMap->count_range(pMap, (Key)0, (Key)(COUNT_ITER + 1)),
+                    COUNT_ITER / 2);
+
+    /* The empty range ends the scan immediately. */
+    CU_ASSERT(pMap->iterate_range(pMap, true, (Key)201, (Key)202, NULL) == SUCC);
+    CU_ASSERT(pMap->iterate_range(pMap, false, NULL, NULL, &pPair) == END);
+
+    TreeMapDeinit(&pMap);
+}
+
+void TestOrderStatistic()
+{
+    TreeMap *pMap;
+    CU_ASSERT(TreeMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_compare(pMap, CompareBasicKey) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyBasicPair) == SUCC);
+
+    /* Query the empty map. */
+    Pair *pPair;
+    CU_ASSERT_EQUAL(pMap->rank(pMap, (Key)1), 0);
+    CU_ASSERT(pMap->select(pMap, 0, NULL) == ERR_GET);
+    CU_ASSERT(pMap->select(pMap, 0, &pPair) == ERR_IDX);
+
+    /* Insert the keys within [0, COUNT_ITER) in a scattered order before the
+       order statistic mode is enabled, and the counts are rebuilt later. */
+    bool aLive[COUNT_ITER];
+    int64_t lKey;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_ITER ; iIdx++) {
+        lKey = ((int64_t)iIdx * 7) % COUNT_ITER;
+        pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = (void*)(intptr_t)lKey;
+        pPair->value = 0;
+        CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+        aLive[iIdx] = true;
+    }
+    CU_ASSERT_EQUAL(pMap->rank(pMap, (Key)(COUNT_ITER / 2)), COUNT_ITER / 2);
+    CU_ASSERT(pMap->select(pMap, COUNT_ITER / 2, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)(COUNT_ITER / 2));
+    CU_ASSERT(pMap->set_order_statistic(pMap, true) == SUCC);
+
+    /* Remove every third key so that the counts follow the deletion and the
+       rotations of the rebalancing. */
+    for (lKey = 0 ; lKey < COUNT_ITER ; lKey += 3) {
+        CU_ASSERT(pMap->remove(pMap, (Key)(intptr_t)lKey) == SUCC);
+        aLive[lKey] = false;
+    }
+
+    int32_t iRank = 0;
+    for (lKey = 0 ; lKey < COUNT_ITER ; lKey++) {
+        CU_ASSERT_EQUAL(pMap->rank(pMap, (Key)(intptr_t)lKey), iRank);
+        if (aLive[lKey]) {
+            CU_ASSERT(pMap->select(pMap, iRank, &pPair) == SUCC);
+            CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)lKey);
+            iRank++;
+        }
+    }
+    CU_ASSERT_EQUAL(iRank, pMap->size(pMap));
+    CU_ASSERT(pMap->select(pMap, -1, &pPair) == ERR_IDX);
+    CU_ASSERT(pMap->select(pMap, iRank, &pPair) == ERR_IDX);
+    CU_ASSERT_EQUAL(pPair, NULL);
+
+    /* Replacing a pair does not change the counts. */
+    pPair = (Pair*)malloc(sizeof(Pair));
+    pPair->key = (void*)1; pPair->value = 0;
+    CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+    CU_ASSERT_EQUAL(pMap->rank(pMap, (Key)COUNT_ITER), iRank);
+
+    /* The range count agrees with the walk in the plain mode. */
+    int32_t iCount = pMap->count_range(pMap, (Key)100, (Key)700);
+    CU_ASSERT_EQUAL(pMap->count_range(pMap, (Key)700, (Key)100), 0);
+    CU_ASSERT(pMap->set_order_statistic(pMap, false) == SUCC);
+    CU_ASSERT_EQUAL(pMap->count_range(pMap, (Key)100, (Key)700), iCount);
+    CU_ASSERT_EQUAL(iCount, 400);
+
+    TreeMapDeinit(&pMap);
+}
+
+void TestCursor()
+{
+    TreeMap *pMap;
+    CU_ASSERT(TreeMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_compare(pMap, CompareBasicKey) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyBasicPair) == SUCC);
+
+    /* The cursors on the empty map are exhausted. */
+    TreeMapCursor curFwd, curBwd;
+    Pair *pPair;
+    CU_ASSERT(pMap->cursor_first(pMap, NULL) == ERR_GET);
+    CU_ASSERT(pMap->cursor_first(pMap, &curFwd) == SUCC);
+    CU_ASSERT(pMap->cursor_next(pMap, &curFwd, NULL) == ERR_GET);
+    CU_ASSERT(pMap->cursor_next(pMap, &curFwd, &pPair) == END);
+    CU_ASSERT(pMap->cursor_last(pMap, &curBwd) == SUCC);
+    CU_ASSERT(pMap->cursor_prev(pMap, &curBwd, &pPair) == END);
+    CU_ASSERT(pMap->cursor_seek(pMap, (Key)1, &curFwd) == SUCC);
+    CU_ASSERT(pMap->cursor_next(pMap, &curFwd, &pPair) == END);
+
+    int64_t lKey;
+    for (lKey = 1 ; lKey <= COUNT_ITER ; lKey++) {
+        pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = (void*)(intptr_t)lKey;
+        pPair->value = 0;
+        CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+    }
+
+    /* Move two cursors in the opposite directions. */
+    CU_ASSERT(pMap->cursor_first(pMap, &curFwd) == SUCC);
+    CU_ASSERT(pMap->cursor_last(pMap, &curBwd) == SUCC);
+    for (lKey = 1 ; lKey <= 10 ; lKey++) {
+        CU_ASSERT(pMap->cursor_next(pMap, &curFwd, &pPair) == SUCC);
+        CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)lKey);
+        CU_ASSERT(pMap->cursor_prev(pMap, &curBwd, &pPair) == SUCC);
+        CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)(COUNT_ITER + 1 - lKey));
+    }
+
+    /* Delete the pairs between the cursors. Both cursors keep their nodes. */
+    for (lKey = 100 ; lKey <= COUNT_ITER - 100 ; lKey++)
+        CU_ASSERT(pMap->remove(pMap, (Key)(intptr_t)lKey) == SUCC);
+
+    lKey = 11;
+    while (pMap->cursor_next(pMap, &curFwd, &pPair) != END) {
+        CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)lKey);
+        lKey = (lKey == 99)? COUNT_ITER - 99 : lKey + 1;
+    }
+    CU_ASSERT_EQUAL(lKey, COUNT_ITER + 1);
+    CU_ASSERT_EQUAL(pPair, NULL);
+
+    lKey = COUNT_ITER - 10;
+    while (pMap->cursor_prev(pMap, &curBwd, &pPair) != END) {
+        CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)lKey);
+        lKey = (lKey == COUNT_ITER - 99)? 99 : lKey - 1;
+    }
+    CU_ASSERT_EQUAL(lKey, 0);
+
+    /* Seek to an absent key. */
+    CU_ASSERT(pMap->cursor_seek(pMap, (Key)500, &curFwd) == SUCC);
+    CU_ASSERT(pMap->cursor_next(pMap, &curFwd, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)(COUNT_ITER - 99));
+    CU_ASSERT(pMap->cursor_seek(pMap, (Key)(COUNT_ITER + 1), &curFwd) == SUCC);
+    CU_ASSERT(pMap->cursor_next(pMap, &curFwd, &pPair) == END);
+
+    TreeMapDeinit(&pMap);
+}
+
+void TestBuild()
+{
+    TreeMap *pMap;
+    CU_ASSERT(TreeMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_compare(pMap, CompareBasicKey) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyBasicPair) == SUCC);
+    CU_ASSERT(pMap->set_order_statistic(pMap, true) == SUCC);
+
+    Pair *aPair[COUNT_ITER];
+    CU_ASSERT(pMap->build(pMap, NULL, 1) == ERR_IDX);
+    CU_ASSERT(pMap->build(pMap, aPair, -1) == ERR_IDX);
+    CU_ASSERT(pMap->build(pMap, aPair, 0) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 0);
+
+    /* Build the map from the sorted keys within [0, COUNT_ITER). */
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_ITER ; iIdx++) {
+        aPair[iIdx] = (Pair*)malloc(sizeof(Pair));
+        aPair[iIdx]->key = (void*)(intptr_t)iIdx;
+        aPair[iIdx]->value = 0;
+    }
+    CU_ASSERT(pMap->build(pMap, aPair, COUNT_ITER) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_ITER);
+
+    Pair *pPair;
+    iIdx = 0;
+    CU_ASSERT(pMap->iterate(pMap, true, NULL) == SUCC);
+    while (pMap->iterate(pMap, false, &pPair) != END) {
+        CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)iIdx);
+        iIdx++;
+    }
+    CU_ASSERT_EQUAL(iIdx, COUNT_ITER);
+    CU_ASSERT(pMap->select(pMap, COUNT_ITER / 3, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)(COUNT_ITER / 3));
+
+    /* Mix the deletions and the insertions with the built nodes. */
+    for (iIdx = 0 ; iIdx < COUNT_ITER ; iIdx += 2)
+        CU_ASSERT(pMap->remove(pMap, (Key)(intptr_t)iIdx) == SUCC);
+    for (iIdx = COUNT_ITER ; iIdx < COUNT_ITER * 2 ; iIdx += 2) {
+        pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = (void*)(intptr_t)iIdx;
+        pPair->value = 0;
+        CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+    }
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_ITER);
+    CU_ASSERT_EQUAL(pMap->rank(pMap, (Key)COUNT_ITER), COUNT_ITER / 2);
+    CU_ASSERT(pMap->find(pMap, (Key)1) == SUCC);
+    CU_ASSERT(pMap->find(pMap, (Key)2) == NOKEY);
+
+    /* Rebuild the map from the unsorted keys with duplicates. The last pair of
+       each key wins. */
+    for (iIdx = 0 ; iIdx < COUNT_ITER ; iIdx++) {
+        aPair[iIdx] = (Pair*)malloc(sizeof(Pair));
+        aPair[iIdx]->key = (void*)(intptr_t)((iIdx * 7) % (COUNT_ITER / 2));
+        aPair[iIdx]->value = (void*)(intptr_t)iIdx;
+    }
+    CU_ASSERT(pMap->build(pMap, aPair, COUNT_ITER) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_ITER / 2);
+    for (iIdx = COUNT_ITER / 2 ; iIdx < COUNT_ITER ; iIdx++) {
+        Value value;
+        CU_ASSERT(pMap->get(pMap, aPair[iIdx]->key, &value) == SUCC);
+        CU_ASSERT_EQUAL(value, (Value)(intptr_t)iIdx);
+    }
+    CU_ASSERT(pMap->minimum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)0);
+    CU_ASSERT(pMap->maximum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)(COUNT_ITER / 2 - 1));
+
+    TreeMapDeinit(&pMap);
+}
+
+void TestJoinSplit()
+{
+    TreeMap *pMap, *pOther;
+    CU_ASSERT(TreeMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_compare(pMap, CompareBasicKey) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyBasicPair) == SUCC);
+    CU_ASSERT(pMap->set_order_statistic(pMap, true) == SUCC);
+    CU_ASSERT(TreeMapInit(&pOther) == SUCC);
+    CU_ASSERT(pOther->set_compare(pOther, CompareBasicKey) == SUCC);
+    CU_ASSERT(pOther->set_destroy(pOther, DestroyBasicPair) == SUCC);
+
+    /* Build the map with the even keys within [0, COUNT_ITER * 2), so that the
+       split nodes come from the bulk allocation. */
+    Pair *aPair[COUNT_ITER];
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_ITER ; iIdx++) {
+        aPair[iIdx] = (Pair*)malloc(sizeof(Pair));
+        aPair[iIdx]->key = (void*)(intptr_t)(iIdx * 2);
+        aPair[iIdx]->value = 0;
+    }
+    CU_ASSERT(pMap->build(pMap, aPair, COUNT_ITER) == SUCC);
+
+    /* Split at an existing key and at a missing key. */
+    CU_ASSERT(pMap->split(pMap, (Key)COUNT_ITER, pOther) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_ITER / 2);
+    CU_ASSERT_EQUAL(pOther->size(pOther), COUNT_ITER / 2);
+    CU_ASSERT(pMap->split(pMap, (Key)1, pOther) == ERR_IDX);
+
+    Pair *pPair;
+    CU_ASSERT(pMap->maximum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)(COUNT_ITER - 2));
+    CU_ASSERT(pOther->minimum(pOther, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)COUNT_ITER);
+    CU_ASSERT_EQUAL(pMap->rank(pMap, (Key)COUNT_ITER), COUNT_ITER / 2);
+
+    /* The overlapping key ranges cannot be joined. */
+    pPair = (Pair*)malloc(sizeof(Pair));
+    pPair->key = (void*)(intptr_t)(COUNT_ITER + 1);
+    pPair->value = 0;
+    CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+    CU_ASSERT(pMap->join(pMap, pOther) == ERR_IDX);
+    CU_ASSERT(pMap->remove(pMap, (Key)(intptr_t)(COUNT_ITER + 1)) == SUCC);
+
+    /* Join the map after the other one, then iterate through the result. */
+    CU_ASSERT(pOther->join(pOther, pMap) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), 0);
+    CU_ASSERT_EQUAL(pOther->size(pOther), COUNT_ITER);
+    iIdx = 0;
+    CU_ASSERT(pOther->iterate(pOther, true, NULL) == SUCC);
+    while (pOther->iterate(pOther, false, &pPair) != END) {
+        CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)(iIdx * 2));
+        iIdx++;
+    }
+    CU_ASSERT_EQUAL(iIdx, COUNT_ITER);
+
+    /* Split at a missing key, then merge back with the odd keys on both
+       sides. The pairs of the other map win the key collisions. */
+    CU_ASSERT(pOther->split(pOther, (Key)(COUNT_ITER + 1), pMap) == SUCC);
+    CU_ASSERT_EQUAL(pOther->size(pOther), COUNT_ITER / 2 + 1);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_ITER / 2 - 1);
+    for (iIdx = 0 ; iIdx < COUNT_ITER * 2 ; iIdx += 3) {
+        pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = (void*)(intptr_t)iIdx;
+        pPair->value = (void*)1;
+        CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+    }
+    CU_ASSERT(pMap->merge(pMap, pOther) == SUCC);
+    CU_ASSERT(pMap->merge(pMap, pMap) == ERR_IDX);
+    CU_ASSERT_EQUAL(pOther->size(pOther), 0);
+
+    int32_t iCount = 0;
+    for (iIdx = 0 ; iIdx < COUNT_ITER * 2 ; iIdx++) {
+        if ((iIdx % 2 == 0) || (iIdx % 3 == 0))
+            iCount++;
+    }
+    CU_ASSERT_EQUAL(pMap->size(pMap), iCount);
+    CU_ASSERT_EQUAL(pMap->count_range(pMap, (Key)0, (Key)(COUNT_ITER * 2)),
+                    iCount);
+    Value value;
+    CU_ASSERT(pMap->get(pMap, (Key)6, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)0);
+    CU_ASSERT(pMap->get(pMap, (Key)(intptr_t)(COUNT_ITER + 2), &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)1);
+    CU_ASSERT(pMap->get(pMap, (Key)3, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)1);
+
+    /* The emptied map stays usable. */
+    pPair = (Pair*)malloc(sizeof(Pair));
+    pPair->key = (void*)1;
+    pPair->value = 0;
+    CU_ASSERT(pOther->put(pOther, pPair) == SUCC);
+    CU_ASSERT(pOther->find(pOther, (Key)1) == SUCC);
+
+    TreeMapDeinit(&pOther);
+    TreeMapDeinit(&pMap);
+}
+
+void TestSnapshot()
+{
+    TreeMap *pMap;
+    CU_ASSERT(TreeMapInit(&pMap) == SUCC);
+    CU_ASSERT(pMap->set_compare(pMap, CompareBasicKey) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyBasicPair) == SUCC);
+
+    /* Pin the version with the keys within [0, COUNT_ITER). */
+    Pair *pPair;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_ITER ; iIdx++) {
+        pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = (void*)(intptr_t)iIdx;
+        pPair->value = 0;
+        CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+    }
+    TreeMapSnapshot snapOld, snapNew;
+    CU_ASSERT(pMap->snapshot_take(pMap, NULL) == ERR_GET);
+    CU_ASSERT(pMap->snapshot_take(pMap, &snapOld) == SUCC);
+
+    /* Replace the even keys and remove the odd keys. */
+    for (iIdx = 0 ; iIdx < COUNT_ITER ; iIdx++) {
+        if (iIdx % 2 == 0) {
+            pPair = (Pair*)malloc(sizeof(Pair));
+            pPair->key = (void*)(intptr_t)iIdx;
+            pPair->value = (void*)1;
+            CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+        } else
+            CU_ASSERT(pMap->remove(pMap, (Key)(intptr_t)iIdx) == SUCC);
+    }
+    CU_ASSERT(pMap->snapshot_take(pMap, &snapNew) == SUCC);
+    CU_ASSERT(pMap->build(pMap, NULL, 0) == ERR_POLICY);
+    for (iIdx = COUNT_ITER ; iIdx < COUNT_ITER * 2 ; iIdx++) {
+        pPair = (Pair*)malloc(sizeof(Pair));
+        pPair->key = (void*)(intptr_t)iIdx;
+        pPair->value = 0;
+        CU_ASSERT(pMap->put(pMap, pPair) == SUCC);
+    }
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_ITER / 2 + COUNT_ITER);
+
+    /* The old snapshot still sees the original pairs. */
+    Value value;
+    CU_ASSERT_EQUAL(pMap->snapshot_size(pMap, &snapOld), COUNT_ITER);
+    CU_ASSERT(pMap->snapshot_get(pMap, &snapOld, (Key)1, &value) == SUCC);
+    CU_ASSERT(pMap->snapshot_get(pMap, &snapOld, (Key)2, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)0);
+    CU_ASSERT(pMap->snapshot_get(pMap, &snapOld, (Key)COUNT_ITER, &value) ==
+              ERR_NODATA);
+    iIdx = 0;
+    CU_ASSERT(pMap->snapshot_iterate(pMap, &snapOld, true, NULL) == SUCC);
+    while (pMap->snapshot_iterate(pMap, &snapOld, false, &pPair) == SUCC) {
+        CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)iIdx);
+        iIdx++;
+    }
+    CU_ASSERT_EQUAL(iIdx, COUNT_ITER);
+    CU_ASSERT(pMap->snapshot_seek(pMap, &snapOld, (Key)(COUNT_ITER - 2)) ==
+              SUCC);
+    CU_ASSERT(pMap->snapshot_iterate(pMap, &snapOld, false, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)(COUNT_ITER - 2));
+    CU_ASSERT(pMap->snapshot_iterate(pMap, &snapOld, false, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)(COUNT_ITER - 1));
+    CU_ASSERT(pMap->snapshot_iterate(pMap, &snapOld, false, &pPair) == END);
+
+    /* The new snapshot sees the replaced even keys only. */
+    CU_ASSERT_EQUAL(pMap->snapshot_size(pMap, &snapNew), COUNT_ITER / 2);
+    CU_ASSERT(pMap->snapshot_get(pMap, &snapNew, (Key)1, &value) == ERR_NODATA);
+    CU_ASSERT(pMap->snapshot_get(pMap, &snapNew, (Key)2, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)1);
+    CU_ASSERT(pMap->snapshot_seek(pMap, &snapNew, (Key)3) == SUCC);
+    CU_ASSERT(pMap->snapshot_iterate(pMap, &snapNew, false, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)4);
+
+    /* Release the snapshots out of order. The retired pairs stay reachable
+       from the old snapshot until it is released. */
+    CU_ASSERT(pMap->snapshot_release(pMap, &snapNew) == SUCC);
+    CU_ASSERT(pMap->snapshot_release(pMap, &snapNew) == ERR_GET);
+    CU_ASSERT(pMap->snapshot_get(pMap, &snapOld, (Key)3, &value) == SUCC);
+    CU_ASSERT(pMap->snapshot_release(pMap, &snapOld) == SUCC);
+    CU_ASSERT(pMap->snapshot_size(pMap, &snapOld) == ERR_GET);
+
+    /* The map runs in place again, and the live snapshots are released by the
+       destructor. */
+    CU_ASSERT(pMap->remove(pMap, (Key)0) == SUCC);
+    CU_ASSERT(pMap->get(pMap, (Key)2, &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)1);
+    CU_ASSERT(pMap->snapshot_take(pMap, &snapOld) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, (Key)2) == SUCC);
+    CU_ASSERT(pMap->find(pMap, (Key)2) == NOKEY);
+    CU_ASSERT(pMap->snapshot_get(pMap, &snapOld, (Key)2, &value) == SUCC);
+
+    TreeMapDeinit(&pMap);
+}
+
+void TestPairMode()
+{
+    TreeMap *pMap, *pOther;
+    CU_ASSERT(TreeMapInit(&pMap) == SUCC);
+    CU_ASSERT(TreeMapInit(&pOther) == SUCC);
+    CU_ASSERT(pMap->set_pair_mode(pMap, TREE_MAP_PAIR_INTEGER + 1) ==
+              ERR_POLICY);
+    CU_ASSERT(pMap->set_pair_mode(pMap, TREE_MAP_PAIR_INTEGER) == SUCC);
+    CU_ASSERT(pMap->set_destroy(pMap, DestroyInlinePair) == SUCC);
+    iInlineDrop = 0;
+
+    /* The same pair structure is reused for all the insertions, and the
+       negative keys are ordered before the positive ones. */
+    Pair pair;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_ITER ; iIdx++) {
+        pair.key = (void*)(intptr_t)(iIdx - COUNT_ITER / 2);
+        pair.value = (void*)(intptr_t)iIdx;
+        CU_ASSERT(pMap->put(pMap, &pair) == SUCC);
+    }
+    CU_ASSERT(pMap->set_pair_mode(pMap, TREE_MAP_PAIR_REFER) == ERR_POLICY);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_ITER);
+
+    Pair *pPair;
+    CU_ASSERT(pMap->minimum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)(-COUNT_ITER / 2));
+    CU_ASSERT(pMap->lower_bound(pMap, (Key)(intptr_t)(-1), &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->value, (Value)(intptr_t)(COUNT_ITER / 2 - 1));
+    iIdx = 0;
+    CU_ASSERT(pMap->iterate(pMap, true, NULL) == SUCC);
+    while (pMap->iterate(pMap, false, &pPair) != END) {
+        CU_ASSERT_EQUAL(pPair->value, (Value)(intptr_t)iIdx);
+        iIdx++;
+    }
+    CU_ASSERT_EQUAL(iIdx, COUNT_ITER);
+
+    /* The replaced copies stay visible to the snapshot. */
+    TreeMapSnapshot snap;
+    CU_ASSERT(pMap->snapshot_take(pMap, &snap) == SUCC);
+    pair.key = (void*)(intptr_t)(-1);
+    pair.value = (void*)(intptr_t)(-1);
+    CU_ASSERT(pMap->put(pMap, &pair) == SUCC);
+    CU_ASSERT(pMap->remove(pMap, (Key)(intptr_t)(-2)) == SUCC);
+    CU_ASSERT_EQUAL(iInlineDrop, 0);
+
+    Value value;
+    CU_ASSERT(pMap->get(pMap, (Key)(intptr_t)(-1), &value) == SUCC);
+    CU_ASSERT_EQUAL(value, (Value)(intptr_t)(-1));
+    CU_ASSERT(pMap->find(pMap, (Key)(intptr_t)(-2)) == NOKEY);
+    CU_ASSERT(pMap->snapshot_get(pMap, &snap, (Key)(intptr_t)(-1), &value) ==
+              SUCC);
+    CU_ASSERT_EQUAL(value, (Value)(intptr_t)(COUNT_ITER / 2 - 1));
+    CU_ASSERT(pMap->snapshot_get(pMap, &snap, (Key)(intptr_t)(-2), &value) ==
+              SUCC);
+    CU_ASSERT(pMap->snapshot_release(pMap, &snap) == SUCC);
+    CU_ASSERT_EQUAL(iInlineDrop, 2);
+
+    /* The maps in different modes cannot exchange their nodes. */
+    CU_ASSERT(pMap->merge(pMap, pOther) == ERR_POLICY);
+    CU_ASSERT(pOther->set_pair_mode(pOther, TREE_MAP_PAIR_INTEGER) == SUCC);
+    CU_ASSERT(pMap->split(pMap, (Key)0, pOther) == SUCC);
+    CU_ASSERT_EQUAL(pOther->size(pOther), COUNT_ITER / 2);
+    CU_ASSERT(pMap->join(pMap, pOther) == SUCC);
+    CU_ASSERT_EQUAL(pMap->size(pMap), COUNT_ITER - 1);
+
+    /* The bulk build copies the pairs too. */
+    Pair aPair[4];
+    Pair *aRef[4];
+    for (iIdx = 0 ; iIdx < 4 ; iIdx++) {
+        aPair[iIdx].key = (void*)(intptr_t)(1 - iIdx);
+        aPair[iIdx].value = (void*)(intptr_t)iIdx;
+        aRef[iIdx] = &aPair[iIdx];
+    }
+    iInlineDrop = 0;
+    CU_ASSERT(pOther->set_destroy(pOther, DestroyInlinePair) == SUCC);
+    CU_ASSERT(pOther->build(pOther, aRef, 4) == SUCC);
+    memset(aPair, 0, sizeof(aPair));
+    CU_ASSERT(pOther->minimum(pOther, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)(intptr_t)(-2));
+    CU_ASSERT_EQUAL(pPair->value, (Value)3);
+    CU_ASSERT(pOther->maximum(pOther, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)1);
+
+    /* Leaving the integer mode restores the default comparison. */
+    CU_ASSERT(pOther->build(pOther, NULL, 0) == SUCC);
+    CU_ASSERT_EQUAL(iInlineDrop, 4);
+    CU_ASSERT(pOther->set_pair_mode(pOther, TREE_MAP_PAIR_INLINE) == SUCC);
+    pair.key = (void*)(intptr_t)(-1);
+    CU_ASSERT(pOther->put(pOther, &pair) == SUCC);
+    pair.key = (void*)1;
+    CU_ASSERT(pOther->put(pOther, &pair) == SUCC);
+    CU_ASSERT(pOther->minimum(pOther, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->key, (Key)1);
+
+    TreeMapDeinit(&pMap);
+    TreeMapDeinit(&pOther);
+    CU_ASSERT_EQUAL(iInlineDrop, COUNT_ITER - 1 + 6);
+
+    /* The pooled nodes of the referring mode lack the room for the inline
+       pairs, so they are not reused after the switch. */
+    CU_ASSERT(TreeMapInit(&pMap) == SUCC);
+    for (iIdx = 0 ; iIdx < 4 ; iIdx++) {
+        aPair[iIdx].key = (void*)(intptr_t)(iIdx + 1);
+        aPair[iIdx].value = (void*)(intptr_t)iIdx;
+        aRef[iIdx] = &aPair[iIdx];
+    }
+    CU_ASSERT(pMap->build(pMap, aRef, 4) == SUCC);
+    for (iIdx = 0 ; iIdx < 4 ; iIdx++)
+        CU_ASSERT(pMap->remove(pMap, (Key)(intptr_t)(iIdx + 1)) == SUCC);
+    CU_ASSERT(pMap->set_pair_mode(pMap, TREE_MAP_PAIR_INLINE) == SUCC);
+    for (iIdx = 0 ; iIdx < 4 ; iIdx++) {
+        pair.key = (void*)(intptr_t)(iIdx + 1);
+        pair.value = (void*)(intptr_t)iIdx;
+        CU_ASSERT(pMap->put(pMap, &pair) == SUCC);
+    }
+    CU_ASSERT(pMap->maximum(pMap, &pPair) == SUCC);
+    CU_ASSERT_EQUAL(pPair->value, (Value)3);
+    TreeMapDeinit(&pMap);
+}
+
 
 /*------------------------------------------------------------*
  *        Test Function Implementation for Bulk Suite         *
@@ -5,6 +5,14 @@
 
 #define SIZE_LONG_STR   (1024)
 
+#define FREE_BLOCK_TEST(_arr, _num)                                             \
+            do {                                                                \
+                int32_t _idx;                                                   \
+                for (_idx = 0 ; _idx < _num ; ++_idx)                           \
+                    free((_arr)[_idx]);                                         \
+                free(_arr);                                                     \
+            } while (0);
+
 
 int32_t AddSuite();
 void TestInsertDummy();
@@ -15,6 +23,16 @@ void TestSearchExact();
 void TestSearchPrefix();
 void TestDeleteThenVerify();
 void TestGetPrefix();
+void TestDeepPrefix();
+void TestRadixMode();
+void TestRadixAgainstTernary();
+
+
+#define COUNT_RADIX_STR     (3000)
+#define COUNT_RADIX_PROBE   (2000)
+#define SIZE_RADIX_STR      (12)
+#define SIZE_DEEP_PREFIX    (64)
+#define SIZE_DEEP_TAIL      (8)
 
 
 int32_t main()
@@ -92,6 +110,21 @@ int32_t AddSuite()
     if (!pTest)
         rc = ERR_REG;
 
+    szMsg = "Traverse a deep and wide sub-trie held by a few strings.";
+    pTest = CU_add_test(pSuite, szMsg, TestDeepPrefix);
+    if (!pTest)
+        rc = ERR_REG;
+
+    szMsg = "Switch to the radix mode and verify the compressed nodes.";
+    pTest = CU_add_test(pSuite, szMsg, TestRadixMode);
+    if (!pTest)
+        rc = ERR_REG;
+
+    szMsg = "Compare the radix mode with the ternary search tree.";
+    pTest = CU_add_test(pSuite, szMsg, TestRadixAgainstTernary);
+    if (!pTest)
+        rc = ERR_REG;
+
 EXIT:
     return rc;
 }
@@ -544,3 +577,191 @@ void TestGetPrefix()
 
     TrieDeinit(&pTrie);
 }
+
+void TestDeepPrefix()
+{
+    Trie *pTrie;
+    CU_ASSERT(TrieInit(&pTrie) == SUCC);
+
+    /* The k-th string leaves the chain of 'a' at the depth k, so the traversal
+       keeps one pending sibling per level while the few strings only let the
+       stack be estimated small. All the strings end deep below the chain. */
+    char szBuf[SIZE_DEEP_PREFIX + SIZE_DEEP_TAIL + 3];
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < SIZE_DEEP_PREFIX ; ++iIdx) {
+        szBuf[0] = 'p';
+        memset(szBuf + 1, 'a', iIdx);
+        szBuf[iIdx + 1] = 'b';
+        memset(szBuf + iIdx + 2, 'z', SIZE_DEEP_TAIL);
+        szBuf[iIdx + SIZE_DEEP_TAIL + 2] = 0;
+        CU_ASSERT(pTrie->insert(pTrie, szBuf) == SUCC);
+    }
+
+    CU_ASSERT(pTrie->has_prefix_as(pTrie, "p") == SUCC);
+    CU_ASSERT(pTrie->has_prefix_as(pTrie, "paaaa") == SUCC);
+    CU_ASSERT(pTrie->has_prefix_as(pTrie, "pc") == NOKEY);
+
+    /* The longer chains come first in the lexicographic order. */
+    char **aStr;
+    int32_t iSizeArr;
+    CU_ASSERT(pTrie->get_prefix_as(pTrie, "p", &aStr, &iSizeArr) == SUCC);
+    CU_ASSERT_EQUAL(iSizeArr, SIZE_DEEP_PREFIX);
+    for (iIdx = 0 ; iIdx < iSizeArr ; ++iIdx) {
+        int32_t iLen = SIZE_DEEP_PREFIX - iIdx + SIZE_DEEP_TAIL + 1;
+        CU_ASSERT_EQUAL((int32_t)strlen(aStr[iIdx]), iLen);
+        if (iIdx > 0)
+            CU_ASSERT(strcmp(aStr[iIdx - 1], aStr[iIdx]) < 0);
+    }
+    FREE_BLOCK_TEST(aStr, iSizeArr);
+
+    TrieDeinit(&pTrie);
+}
+
+void TestRadixMode()
+{
+    Trie *pTrie;
+    CU_ASSERT(TrieInit(&pTrie) == SUCC);
+    CU_ASSERT(pTrie->set_mode(pTrie, 2) == ERR_POLICY);
+    CU_ASSERT(pTrie->insert(pTrie, "rubens\0") == SUCC);
+    CU_ASSERT(pTrie->set_mode(pTrie, TRIE_MODE_RADIX) == ERR_POLICY);
+    CU_ASSERT(pTrie->remove(pTrie, "rubens\0") == SUCC);
+    CU_ASSERT(pTrie->set_mode(pTrie, TRIE_MODE_RADIX) == SUCC);
+
+    char *aStr[] = {"romane\0", "romanus\0", "romulus\0", "rubens\0",
+                    "ruber\0", "rubicon\0", "rubicundus\0"};
+    CU_ASSERT(pTrie->bulk_insert(pTrie, aStr, 7) == SUCC);
+    CU_ASSERT(pTrie->insert(pTrie, "ruber\0") == SUCC);
+    CU_ASSERT_EQUAL(pTrie->size(pTrie), 7);
+
+    /* r -> om -> an -> {e, us}, ulus, and r -> ub -> e -> {ns, r}, ic ->
+       {on, undus} */
+    TrieStat stat;
+    CU_ASSERT(pTrie->get_stat(pTrie, NULL) == ERR_GET);
+    CU_ASSERT(pTrie->get_stat(pTrie, &stat) == SUCC);
+    CU_ASSERT_EQUAL(stat.lCountNode, 13);
+
+    CU_ASSERT(pTrie->has_exact(pTrie, "rubic\0") == NOKEY);
+    CU_ASSERT(pTrie->has_exact(pTrie, "rubicon\0") == SUCC);
+    CU_ASSERT(pTrie->has_prefix_as(pTrie, "rubic\0") == SUCC);
+    CU_ASSERT(pTrie->has_prefix_as(pTrie, "rubix\0") == NOKEY);
+
+    char **aGet;
+    int32_t iSizeArr;
+    CU_ASSERT(pTrie->get_prefix_as(pTrie, "rom\0", &aGet, &iSizeArr) == SUCC);
+    CU_ASSERT_EQUAL(iSizeArr, 3);
+    CU_ASSERT(strcmp(aGet[0], "romane") == 0);
+    CU_ASSERT(strcmp(aGet[2], "romulus") == 0);
+    FREE_BLOCK_TEST(aGet, iSizeArr);
+
+    /* Removing a leaf merges its parent with the remaining sibling. */
+    CU_ASSERT(pTrie->remove(pTrie, "rubicon\0") == SUCC);
+    CU_ASSERT(pTrie->remove(pTrie, "rubicon\0") == NOKEY);
+    CU_ASSERT(pTrie->remove(pTrie, "rubi\0") == NOKEY);
+    CU_ASSERT(pTrie->get_stat(pTrie, &stat) == SUCC);
+    CU_ASSERT_EQUAL(stat.lCountNode, 11);
+    CU_ASSERT(pTrie->has_exact(pTrie, "rubicundus\0") == SUCC);
+    CU_ASSERT(pTrie->insert(pTrie, "rub\0") == SUCC);
+    CU_ASSERT(pTrie->remove(pTrie, "rub\0") == SUCC);
+    CU_ASSERT(pTrie->get_stat(pTrie, &stat) == SUCC);
+    CU_ASSERT_EQUAL(stat.lCountNode, 11);
+
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 7 ; ++iIdx)
+        pTrie->remove(pTrie, aStr[iIdx]);
+    CU_ASSERT_EQUAL(pTrie->size(pTrie), 0);
+
+    /* The churn of the strings keeps the label arena bounded by the live
+       labels, while the stored strings survive the re-packing. */
+    CU_ASSERT(pTrie->bulk_insert(pTrie, aStr, 7) == SUCC);
+    TrieStat statBase;
+    CU_ASSERT(pTrie->get_stat(pTrie, &statBase) == SUCC);
+    char szBuf[SIZE_LONG_STR];
+    for (iIdx = 0 ; iIdx < COUNT_RADIX_STR ; ++iIdx) {
+        snprintf(szBuf, SIZE_LONG_STR, "rubrica-%d-%d", iIdx, iIdx * 7919);
+        CU_ASSERT(pTrie->insert(pTrie, szBuf) == SUCC);
+        CU_ASSERT(pTrie->remove(pTrie, szBuf) == SUCC);
+    }
+    CU_ASSERT(pTrie->get_stat(pTrie, &stat) == SUCC);
+    CU_ASSERT_EQUAL(stat.lCountNode, statBase.lCountNode);
+    CU_ASSERT(stat.lCountByte <= statBase.lCountByte * 2);
+    CU_ASSERT(pTrie->get_prefix_as(pTrie, "r\0", &aGet, &iSizeArr) == SUCC);
+    CU_ASSERT_EQUAL(iSizeArr, 7);
+    for (iIdx = 0 ; iIdx < iSizeArr ; ++iIdx)
+        CU_ASSERT(strcmp(aGet[iIdx], aStr[iIdx]) == 0);
+    FREE_BLOCK_TEST(aGet, iSizeArr);
+
+    for (iIdx = 0 ; iIdx < 7 ; ++iIdx)
+        pTrie->remove(pTrie, aStr[iIdx]);
+    CU_ASSERT_EQUAL(pTrie->size(pTrie), 0);
+    CU_ASSERT(pTrie->get_stat(pTrie, &stat) == SUCC);
+    CU_ASSERT_EQUAL(stat.lCountNode, 0);
+    CU_ASSERT(pTrie->has_prefix_as(pTrie, "r\0") == NOKEY);
+
+    TrieDeinit(&pTrie);
+}
+
+void TestRadixAgainstTernary()
+{
+    Trie *pTern, *pRadix;
+    CU_ASSERT(TrieInit(&pTern) == SUCC);
+    CU_ASSERT(TrieInit(&pRadix) == SUCC);
+    CU_ASSERT(pRadix->set_mode(pRadix, TRIE_MODE_RADIX) == SUCC);
+
+    /* The strings over a small alphabet share many prefixes. */
+    char *aStr = (char*)malloc(COUNT_RADIX_STR * SIZE_RADIX_STR);
+    srand(17);
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < COUNT_RADIX_STR ; ++iIdx) {
+        char *str = aStr + iIdx * SIZE_RADIX_STR;
+        int32_t iLen = rand() % (SIZE_RADIX_STR - 2) + 1;
+        int32_t iOfst;
+        for (iOfst = 0 ; iOfst < iLen ; ++iOfst)
+            str[iOfst] = 'a' + rand() % 4;
+        str[iLen] = 0;
+        CU_ASSERT(pTern->insert(pTern, str) == SUCC);
+        CU_ASSERT(pRadix->insert(pRadix, str) == SUCC);
+    }
+    for (iIdx = 0 ; iIdx < COUNT_RADIX_STR ; iIdx += 3) {
+        char *str = aStr + iIdx * SIZE_RADIX_STR;
+        CU_ASSERT_EQUAL(pRadix->remove(pRadix, str), pTern->remove(pTern, str));
+    }
+    CU_ASSERT_EQUAL(pRadix->size(pRadix), pTern->size(pTern));
+
+    TrieStat statTern, statRadix;
+    CU_ASSERT(pTern->get_stat(pTern, &statTern) == SUCC);
+    CU_ASSERT(pRadix->get_stat(pRadix, &statRadix) == SUCC);
+    CU_ASSERT(statRadix.lCountNode <= 2 * pRadix->size(pRadix));
+    CU_ASSERT(statRadix.lCountNode < statTern.lCountNode);
+
+    char szBuf[SIZE_RADIX_STR];
+    for (iIdx = 0 ; iIdx < COUNT_RADIX_PROBE ; ++iIdx) {
+        int32_t iLen = rand() % (SIZE_RADIX_STR - 2) + 1;
+        int32_t iOfst;
+        for (iOfst = 0 ; iOfst < iLen ; ++iOfst)
+            szBuf[iOfst] = 'a' + rand() % 5;
+        szBuf[iLen] = 0;
+
+        CU_ASSERT_EQUAL(pRadix->has_exact(pRadix, szBuf),
+                        pTern->has_exact(pTern, szBuf));
+        CU_ASSERT_EQUAL(pRadix->has_prefix_as(pRadix, szBuf),
+                        pTern->has_prefix_as(pTern, szBuf));
+
+        char **aTern, **aRadix;
+        int32_t iNumTern, iNumRadix;
+        szBuf[(iLen + 1) >> 1] = 0;
+        CU_ASSERT_EQUAL(
+            pRadix->get_prefix_as(pRadix, szBuf, &aRadix, &iNumRadix),
+            pTern->get_prefix_as(pTern, szBuf, &aTern, &iNumTern));
+        CU_ASSERT_EQUAL(iNumRadix, iNumTern);
+        if (iNumRadix == iNumTern) {
+            for (iOfst = 0 ; iOfst < iNumTern ; ++iOfst)
+                CU_ASSERT(strcmp(aRadix[iOfst], aTern[iOfst]) == 0);
+        }
+        FREE_BLOCK_TEST(aTern, iNumTern);
+        FREE_BLOCK_TEST(aRadix, iNumRadix);
+    }
+
+    free(aStr);
+    TrieDeinit(&pTern);
+    TrieDeinit(&pRadix);
+}
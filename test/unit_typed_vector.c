@@ -0,0 +1,436 @@
+#include "container/typed_vector.h"
+#include "CUnit/Util.h"
+#include "CUnit/Basic.h"
+
+
+typedef struct Tuple_ {
+    int32_t iMajor;
+    int32_t iMinor;
+    char *szName;
+} Tuple;
+
+
+void TestPrimPushBack();
+void TestPrimInsert();
+void TestPrimSet();
+void TestPrimPopBack();
+void TestPrimDelete();
+void TestPrimResize();
+
+void DestroyTuple(void*);
+int32_t CompareTuple(const void*, const void*);
+void TestInPlace();
+void TestSort();
+void TestIterate();
+
+
+int32_t SuitePrimitive()
+{
+    CU_pSuite pSuite = CU_add_suite("Primitive Type Input", NULL, NULL);
+    if (!pSuite)
+        return ERR_NOMEM;
+
+    CU_pTest pTest = CU_add_test(pSuite, "Element insertion via push_back().",
+                     TestPrimPushBack);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Element insertion via insert().", TestPrimInsert);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Element replacement via set().", TestPrimSet);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Element deletion via pop_back().", TestPrimPopBack);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Element deletion via remove().", TestPrimDelete);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Storage reallocation.", TestPrimResize);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    return SUCC;
+}
+
+int32_t SuiteStructure()
+{
+    CU_pSuite pSuite = CU_add_suite("Structure Type Input", NULL, NULL);
+    if (!pSuite)
+        return ERR_NOMEM;
+
+    CU_pTest pTest = CU_add_test(pSuite, "In place element update.", TestInPlace);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Element sorting.", TestSort);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Vector iteration.", TestIterate);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    return SUCC;
+}
+
+
+int32_t main()
+{
+    if (CU_initialize_registry() != CUE_SUCCESS)
+        return CU_get_error();
+    assert(CU_get_registry() != NULL);
+    assert(!CU_is_test_running());
+
+    /* Prepare the test suite for primitive input. */
+    if (SuitePrimitive() != SUCC) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Prepare the test suite for structure input. */
+    if (SuiteStructure() != SUCC) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Launch all the tests. */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+    CU_cleanup_registry();
+    return SUCC;
+}
+
+
+void TestPrimPushBack()
+{
+    TypedVector *pVec;
+    CU_ASSERT(TypedVectorInit(&pVec, 0, 0) == ERR_ELEMSIZE);
+    CU_ASSERT(TypedVectorInit(&pVec, sizeof(int64_t), 0) == SUCC);
+    CU_ASSERT_EQUAL(pVec->element_size(pVec), sizeof(int64_t));
+
+    /* Append the elements. */
+    int64_t iNum;
+    for (iNum = 1 ; iNum <= 4 ; iNum++)
+        CU_ASSERT(pVec->push_back(pVec, &iNum) == SUCC);
+
+    /* Check element insertion sequence. */
+    int64_t iElem;
+    CU_ASSERT(pVec->get(pVec, &iElem, 0) == SUCC);
+    CU_ASSERT_EQUAL(iElem, 1);
+    CU_ASSERT(pVec->get(pVec, &iElem, 1) == SUCC);
+    CU_ASSERT_EQUAL(iElem, 2);
+    CU_ASSERT(pVec->get(pVec, &iElem, 2) == SUCC);
+    CU_ASSERT_EQUAL(iElem, 3);
+    CU_ASSERT(pVec->get(pVec, &iElem, 3) == SUCC);
+    CU_ASSERT_EQUAL(iElem, 4);
+
+    /* Check vector storage. */
+    CU_ASSERT_EQUAL(pVec->size(pVec), 4);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 4);
+
+    /* Check illegal indexing. */
+    CU_ASSERT(pVec->get(pVec, &iElem, -1) == ERR_IDX);
+    CU_ASSERT(pVec->get(pVec, &iElem, 4) == ERR_IDX);
+    CU_ASSERT(pVec->get(pVec, NULL, 0) == ERR_GET);
+
+    TypedVectorDeinit(&pVec);
+}
+
+void TestPrimInsert()
+{
+    TypedVector *pVec;
+    CU_ASSERT(TypedVectorInit(&pVec, sizeof(int64_t), 0) == SUCC);
+
+    /* Append the elements. */
+    int64_t iNum = 3;
+    CU_ASSERT(pVec->insert(pVec, &iNum, 0) == SUCC);
+    iNum = 4;
+    CU_ASSERT(pVec->insert(pVec, &iNum, 1) == SUCC);
+
+    /* Trigger the shift of trailing elements. */
+    iNum = 1;
+    CU_ASSERT(pVec->insert(pVec, &iNum, 0) == SUCC);
+    iNum = 2;
+    CU_ASSERT(pVec->insert(pVec, &iNum, 1) == SUCC);
+
+    /* Check element insertion sequence. */
+    int64_t iElem;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 4 ; iIdx++) {
+        CU_ASSERT(pVec->get(pVec, &iElem, iIdx) == SUCC);
+        CU_ASSERT_EQUAL(iElem, iIdx + 1);
+    }
+
+    /* Check vector storage. */
+    CU_ASSERT_EQUAL(pVec->size(pVec), 4);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 4);
+
+    /* Check illegal indexing. */
+    CU_ASSERT(pVec->insert(pVec, &iNum, -1) == ERR_IDX);
+    CU_ASSERT(pVec->insert(pVec, &iNum, 5) == ERR_IDX);
+
+    TypedVectorDeinit(&pVec);
+}
+
+void TestPrimSet()
+{
+    TypedVector *pVec;
+    CU_ASSERT(TypedVectorInit(&pVec, sizeof(int64_t), 0) == SUCC);
+
+    int64_t iNum = 0;
+    CU_ASSERT(pVec->push_back(pVec, &iNum) == SUCC);
+    iNum = 1;
+    CU_ASSERT(pVec->push_back(pVec, &iNum) == SUCC);
+
+    /* Replace the existing elements. */
+    iNum = 2;
+    CU_ASSERT(pVec->set(pVec, &iNum, 0) == SUCC);
+    iNum = 3;
+    CU_ASSERT(pVec->set(pVec, &iNum, 1) == SUCC);
+
+    int64_t iElem;
+    CU_ASSERT(pVec->get(pVec, &iElem, 0) == SUCC);
+    CU_ASSERT_EQUAL(iElem, 2);
+    CU_ASSERT(pVec->get(pVec, &iElem, 1) == SUCC);
+    CU_ASSERT_EQUAL(iElem, 3);
+
+    /* Check illegal indexing. */
+    CU_ASSERT(pVec->set(pVec, &iNum, -1) == ERR_IDX);
+    CU_ASSERT(pVec->set(pVec, &iNum, 2) == ERR_IDX);
+
+    TypedVectorDeinit(&pVec);
+}
+
+void TestPrimPopBack()
+{
+    TypedVector *pVec;
+    CU_ASSERT(TypedVectorInit(&pVec, sizeof(int64_t), 0) == SUCC);
+
+    int64_t iNum = 0;
+    CU_ASSERT(pVec->push_back(pVec, &iNum) == SUCC);
+    CU_ASSERT(pVec->push_back(pVec, &iNum) == SUCC);
+
+    /* Pop all the elements. */
+    CU_ASSERT(pVec->pop_back(pVec) == SUCC);
+    CU_ASSERT(pVec->pop_back(pVec) == SUCC);
+
+    /* Check vector storage. */
+    CU_ASSERT_EQUAL(pVec->size(pVec), 0);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 2);
+
+    /* Check illegal pop. */
+    CU_ASSERT(pVec->pop_back(pVec) == ERR_IDX);
+
+    TypedVectorDeinit(&pVec);
+}
+
+void TestPrimDelete()
+{
+    TypedVector *pVec;
+    CU_ASSERT(TypedVectorInit(&pVec, sizeof(int64_t), 0) == SUCC);
+
+    int64_t iNum;
+    for (iNum = 0 ; iNum < 4 ; iNum++)
+        CU_ASSERT(pVec->push_back(pVec, &iNum) == SUCC);
+
+    /* Delete the head and tail. */
+    CU_ASSERT(pVec->remove(pVec, 3) == SUCC);
+    CU_ASSERT(pVec->remove(pVec, 0) == SUCC);
+
+    /* Check element shifting sequence. */
+    int64_t iElem;
+    CU_ASSERT(pVec->get(pVec, &iElem, 0) == SUCC);
+    CU_ASSERT_EQUAL(iElem, 1);
+    CU_ASSERT(pVec->get(pVec, &iElem, 1) == SUCC);
+    CU_ASSERT_EQUAL(iElem, 2);
+
+    /* Check vector storage. */
+    CU_ASSERT_EQUAL(pVec->size(pVec), 2);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 4);
+
+    /* Check illegal deletion. */
+    CU_ASSERT(pVec->remove(pVec, -1) == ERR_IDX);
+    CU_ASSERT(pVec->remove(pVec, 2) == ERR_IDX);
+
+    TypedVectorDeinit(&pVec);
+}
+
+void TestPrimResize()
+{
+    TypedVector *pVec;
+    CU_ASSERT(TypedVectorInit(&pVec, sizeof(int64_t), 0) == SUCC);
+
+    /* Expand the capacity. */
+    CU_ASSERT(pVec->resize(pVec, 4) == SUCC);
+    CU_ASSERT_EQUAL(pVec->size(pVec), 0);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 4);
+
+    /* Fill the half of the storage. */
+    int64_t iNum = 0;
+    CU_ASSERT(pVec->push_back(pVec, &iNum) == SUCC);
+    iNum = 1;
+    CU_ASSERT(pVec->push_back(pVec, &iNum) == SUCC);
+    CU_ASSERT_EQUAL(pVec->size(pVec), 2);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 4);
+
+    /* Shrink the storage and trim the trailing elements. */
+    CU_ASSERT(pVec->resize(pVec, 1) == SUCC);
+    int64_t iElem;
+    CU_ASSERT(pVec->get(pVec, &iElem, 0) == SUCC);
+    CU_ASSERT_EQUAL(iElem, 0);
+    CU_ASSERT_EQUAL(pVec->size(pVec), 1);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 1);
+
+    /* Check illegal capacity. */
+    CU_ASSERT(pVec->resize(pVec, 0) == ERR_IDX);
+
+    TypedVectorDeinit(&pVec);
+}
+
+void DestroyTuple(void *pElem)
+{
+    free(((Tuple*)pElem)->szName);
+}
+
+int32_t CompareTuple(const void *pSrc, const void *pTge)
+{
+    const Tuple *pTupleSrc = (const Tuple*)pSrc;
+    const Tuple *pTupleTge = (const Tuple*)pTge;
+    if (pTupleSrc->iMajor == pTupleTge->iMajor)
+        return 0;
+    return (pTupleSrc->iMajor > pTupleTge->iMajor)? 1 : (-1);
+}
+
+void TestInPlace()
+{
+    TypedVector *pVec;
+    CU_ASSERT(TypedVectorInit(&pVec, sizeof(Tuple), 0) == SUCC);
+    CU_ASSERT(pVec->set_destroy(pVec, DestroyTuple) == SUCC);
+
+    /* Construct the elements in place. */
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 100 ; iIdx++) {
+        void *pElem;
+        CU_ASSERT(pVec->emplace_back(pVec, &pElem) == SUCC);
+        Tuple *pTuple = (Tuple*)pElem;
+        CU_ASSERT_EQUAL(pTuple->szName, NULL);
+        pTuple->iMajor = iIdx;
+        pTuple->iMinor = 0;
+        pTuple->szName = strdup("tuple");
+    }
+    CU_ASSERT(pVec->emplace_back(pVec, NULL) == ERR_GET);
+
+    /* Update the elements through the returned addresses. */
+    for (iIdx = 0 ; iIdx < 100 ; iIdx++) {
+        void *pElem;
+        CU_ASSERT(pVec->at(pVec, &pElem, iIdx) == SUCC);
+        ((Tuple*)pElem)->iMinor = iIdx * 2;
+    }
+
+    Tuple tuple;
+    CU_ASSERT(pVec->get(pVec, &tuple, 50) == SUCC);
+    CU_ASSERT_EQUAL(tuple.iMajor, 50);
+    CU_ASSERT_EQUAL(tuple.iMinor, 100);
+
+    /* Check illegal indexing. */
+    void *pElem;
+    CU_ASSERT(pVec->at(pVec, &pElem, 100) == ERR_IDX);
+    CU_ASSERT_EQUAL(pElem, NULL);
+
+    /* The clean method should be applied to the removed elements. */
+    CU_ASSERT(pVec->remove(pVec, 0) == SUCC);
+    CU_ASSERT(pVec->pop_back(pVec) == SUCC);
+    CU_ASSERT(pVec->resize(pVec, 10) == SUCC);
+    CU_ASSERT_EQUAL(pVec->size(pVec), 10);
+
+    TypedVectorDeinit(&pVec);
+}
+
+void TestSort()
+{
+    TypedVector *pVec;
+    CU_ASSERT(TypedVectorInit(&pVec, sizeof(Tuple), 0) == SUCC);
+
+    /* Push the initial elements. */
+    Tuple tuple;
+    tuple.szName = NULL;
+    int32_t iNum;
+    for (iNum = 10 ; iNum > 0 ; iNum--) {
+        tuple.iMajor = iNum;
+        tuple.iMinor = -iNum;
+        CU_ASSERT(pVec->push_back(pVec, &tuple) == SUCC);
+    }
+
+    /* Sort the elements. */
+    CU_ASSERT(pVec->sort(pVec, CompareTuple) == SUCC);
+
+    /* Check the element order. */
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 10 ; iIdx++) {
+        CU_ASSERT(pVec->get(pVec, &tuple, iIdx) == SUCC);
+        CU_ASSERT_EQUAL(tuple.iMajor, iIdx + 1);
+        CU_ASSERT_EQUAL(tuple.iMinor, -(iIdx + 1));
+    }
+
+    TypedVectorDeinit(&pVec);
+}
+
+void TestIterate()
+{
+    TypedVector *pVec;
+    CU_ASSERT(TypedVectorInit(&pVec, sizeof(Tuple), 0) == SUCC);
+
+    /* Iterate through empty vector. */
+    void *pElem;
+    CU_ASSERT(pVec->iterate(pVec, true, NULL) == SUCC);
+    while (pVec->iterate(pVec, false, &pElem) != END);
+    CU_ASSERT_EQUAL(pElem, NULL);
+    CU_ASSERT(pVec->reverse_iterate(pVec, true, NULL) == SUCC);
+    while (pVec->reverse_iterate(pVec, false, &pElem) != END);
+    CU_ASSERT_EQUAL(pElem, NULL);
+
+    /* Push the initial elements. */
+    Tuple tuple;
+    tuple.szName = NULL;
+    int32_t iNum;
+    for (iNum = 3 ; iNum > 0 ; iNum--) {
+        tuple.iMajor = iNum;
+        tuple.iMinor = iNum;
+        CU_ASSERT(pVec->push_back(pVec, &tuple) == SUCC);
+    }
+
+    /* Iterate through the vector elements and update them in place. */
+    int32_t iSum = 0;
+    int32_t iIdx = 3;
+    CU_ASSERT(pVec->iterate(pVec, true, NULL) == SUCC);
+    while (pVec->iterate(pVec, false, &pElem) != END) {
+        Tuple *pTuple = (Tuple*)pElem;
+        CU_ASSERT_EQUAL(iIdx, pTuple->iMajor);
+        iSum += pTuple->iMajor;
+        pTuple->iMinor *= 10;
+        iIdx--;
+    }
+    CU_ASSERT_EQUAL(iSum, 6);
+
+    /* Reversely iterate through the vector elements. */
+    iSum = 0;
+    iIdx = 1;
+    CU_ASSERT(pVec->reverse_iterate(pVec, true, NULL) == SUCC);
+    while (pVec->reverse_iterate(pVec, false, &pElem) != END) {
+        Tuple *pTuple = (Tuple*)pElem;
+        CU_ASSERT_EQUAL(iIdx, pTuple->iMajor);
+        CU_ASSERT_EQUAL(iIdx * 10, pTuple->iMinor);
+        iSum += pTuple->iMajor;
+        iIdx++;
+    }
+    CU_ASSERT_EQUAL(iSum, 6);
+
+    TypedVectorDeinit(&pVec);
+}
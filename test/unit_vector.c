@@ -14,11 +14,20 @@ void TestPrimInsert();
 void TestPrimSet();
 void TestPrimPopBack();
 void TestPrimDelete();
+void TestPrimRange();
 void TestPrimResize();
+void TestPrimGrowth();
+void TestPrimLarge();
 
 void DestroyObject(Item);
 int32_t CompareObject(const void*, const void*);
 void TestSort();
+void TestStableSort();
+void TestParallelSort();
+void TestRadixSort();
+void TestQuery();
+void TestSortedSearch();
+void TestSelection();
 void TestIterate();
 
 
@@ -49,14 +58,50 @@ int32_t SuitePrimitive()
     if (!pTest)
         return ERR_NOMEM;
 
+    pTest = CU_add_test(pSuite, "Bulk item insertion and deletion.", TestPrimRange);
+    if (!pTest)
+        return ERR_NOMEM;
+
     pTest = CU_add_test(pSuite, "Storage reallocation.", TestPrimResize);
     if (!pTest)
         return ERR_NOMEM;
 
+    pTest = CU_add_test(pSuite, "Storage growth policy.", TestPrimGrowth);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Large storage reallocation.", TestPrimLarge);
+    if (!pTest)
+        return ERR_NOMEM;
+
     pTest = CU_add_test(pSuite, "Item sorting.", TestSort);
     if (!pTest)
         return ERR_NOMEM;
 
+    pTest = CU_add_test(pSuite, "Stable item sorting.", TestStableSort);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Parallel item sorting.", TestParallelSort);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Radix item sorting.", TestRadixSort);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Bulk item query.", TestQuery);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Sorted item search and merge.", TestSortedSearch);
+    if (!pTest)
+        return ERR_NOMEM;
+
+    pTest = CU_add_test(pSuite, "Item selection.", TestSelection);
+    if (!pTest)
+        return ERR_NOMEM;
+
     pTest = CU_add_test(pSuite, "Vector iteration.", TestIterate);
     if (!pTest)
         return ERR_NOMEM;
@@ -234,6 +279,78 @@ void TestPrimDelete()
     VectorDeinit(&pVec);
 }
 
+int32_t iCountDestroy;
+
+void CountDestroy(Item item)
+{
+    (void)item;
+    iCountDestroy++;
+}
+
+void TestPrimRange()
+{
+    Vector *pVec;
+    CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+    CU_ASSERT(pVec->set_destroy(pVec, CountDestroy) == SUCC);
+
+    /* Append the items with a single extension. */
+    Item aItem[] = {(Item)0, (Item)1, (Item)2, (Item)6, (Item)7};
+    CU_ASSERT(pVec->append(pVec, aItem, 5) == SUCC);
+    CU_ASSERT_EQUAL(pVec->size(pVec), 5);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 5);
+
+    /* Insert the items in the middle. */
+    Item aMid[] = {(Item)3, (Item)4, (Item)5};
+    CU_ASSERT(pVec->insert_range(pVec, aMid, 3, 3) == SUCC);
+    CU_ASSERT_EQUAL(pVec->size(pVec), 8);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 10);
+
+    /* Insert the items at the head and the tail. */
+    Item aEdge[] = {(Item)8, (Item)9};
+    CU_ASSERT(pVec->insert_range(pVec, aEdge, 2, 8) == SUCC);
+    CU_ASSERT(pVec->insert_range(pVec, aEdge, 1, 0) == SUCC);
+    CU_ASSERT(pVec->remove(pVec, 0) == SUCC);
+    CU_ASSERT_EQUAL(iCountDestroy, 1);
+
+    /* Check item insertion sequence. */
+    Item item;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 10 ; iIdx++) {
+        CU_ASSERT(pVec->get(pVec, &item, iIdx) == SUCC);
+        CU_ASSERT_EQUAL(item, (Item)(intptr_t)iIdx);
+    }
+
+    /* Check illegal insertion. */
+    CU_ASSERT(pVec->insert_range(pVec, aMid, 1, -1) == ERR_IDX);
+    CU_ASSERT(pVec->insert_range(pVec, aMid, 1, 11) == ERR_IDX);
+    CU_ASSERT(pVec->insert_range(pVec, aMid, -1, 0) == ERR_IDX);
+    CU_ASSERT(pVec->append(pVec, NULL, 1) == ERR_IDX);
+    CU_ASSERT(pVec->append(pVec, NULL, 0) == SUCC);
+
+    /* Remove the items in the middle and run the destroy method for each. */
+    CU_ASSERT(pVec->remove_range(pVec, 2, 5) == SUCC);
+    CU_ASSERT_EQUAL(iCountDestroy, 6);
+    CU_ASSERT_EQUAL(pVec->size(pVec), 5);
+    CU_ASSERT(pVec->get(pVec, &item, 1) == SUCC);
+    CU_ASSERT_EQUAL(item, (Item)1);
+    CU_ASSERT(pVec->get(pVec, &item, 2) == SUCC);
+    CU_ASSERT_EQUAL(item, (Item)7);
+
+    /* Check illegal deletion. */
+    CU_ASSERT(pVec->remove_range(pVec, -1, 1) == ERR_IDX);
+    CU_ASSERT(pVec->remove_range(pVec, 3, 3) == ERR_IDX);
+    CU_ASSERT(pVec->remove_range(pVec, 0, -1) == ERR_IDX);
+    CU_ASSERT(pVec->remove_range(pVec, 5, 0) == SUCC);
+
+    /* Remove the trailing items. */
+    CU_ASSERT(pVec->remove_range(pVec, 3, 2) == SUCC);
+    CU_ASSERT_EQUAL(pVec->size(pVec), 3);
+    CU_ASSERT_EQUAL(iCountDestroy, 8);
+
+    VectorDeinit(&pVec);
+    CU_ASSERT_EQUAL(iCountDestroy, 11);
+}
+
 void TestPrimResize()
 {
     Vector *pVec;
@@ -266,6 +383,79 @@ void TestPrimResize()
     VectorDeinit(&pVec);
 }
 
+void TestPrimGrowth()
+{
+    Vector *pVec;
+    CU_ASSERT(VectorInit(&pVec, 4) == SUCC);
+
+    /* Check illegal policies. */
+    CU_ASSERT(pVec->set_growth(pVec, -1, 0) == ERR_POLICY);
+    CU_ASSERT(pVec->set_growth(pVec, VECTOR_GROW_CHUNK, 0) == ERR_POLICY);
+
+    /* Extend the storage to one and a half of the capacity. */
+    CU_ASSERT(pVec->set_growth(pVec, VECTOR_GROW_HALF, 0) == SUCC);
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 5 ; iIdx++)
+        CU_ASSERT(pVec->push_back(pVec, (Item)(intptr_t)iIdx) == SUCC);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 6);
+
+    /* Extend the storage by the fixed number of items. */
+    CU_ASSERT(pVec->set_growth(pVec, VECTOR_GROW_CHUNK, 10) == SUCC);
+    for (iIdx = 5 ; iIdx < 7 ; iIdx++)
+        CU_ASSERT(pVec->push_back(pVec, (Item)(intptr_t)iIdx) == SUCC);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 16);
+
+    /* The bulk insertion extends the storage beyond the policy if necessary. */
+    Item aItem[20] = {NULL};
+    CU_ASSERT(pVec->append(pVec, aItem, 20) == SUCC);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 27);
+
+    /* Restore the default policy. */
+    CU_ASSERT(pVec->set_growth(pVec, VECTOR_GROW_DOUBLE, 0) == SUCC);
+    CU_ASSERT(pVec->push_back(pVec, NULL) == SUCC);
+    CU_ASSERT_EQUAL(pVec->capacity(pVec), 54);
+
+    Item item;
+    for (iIdx = 0 ; iIdx < 7 ; iIdx++) {
+        CU_ASSERT(pVec->get(pVec, &item, iIdx) == SUCC);
+        CU_ASSERT_EQUAL(item, (Item)(intptr_t)iIdx);
+    }
+
+    VectorDeinit(&pVec);
+}
+
+void TestPrimLarge()
+{
+    Vector *pVec;
+    CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+
+    /* Grow across the threshold to map the storage from the system. */
+    int64_t iNum = (int64_t)(1 << 23) + 3;
+    int64_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++)
+        pVec->push_back(pVec, (Item)(intptr_t)iIdx);
+    CU_ASSERT_EQUAL(pVec->size(pVec), iNum);
+    CU_ASSERT(pVec->capacity(pVec) >= iNum);
+
+    /* Extend and shrink the mapped storage. */
+    CU_ASSERT(pVec->resize(pVec, iNum * 3) == SUCC);
+    CU_ASSERT(pVec->capacity(pVec) >= iNum * 3);
+    CU_ASSERT(pVec->resize(pVec, iNum - 3) == SUCC);
+    CU_ASSERT_EQUAL(pVec->size(pVec), iNum - 3);
+
+    Item item;
+    bool bMatch = true;
+    for (iIdx = 0 ; iIdx < iNum - 3 ; iIdx++) {
+        pVec->get(pVec, &item, iIdx);
+        if (item != (Item)(intptr_t)iIdx)
+            bMatch = false;
+    }
+    CU_ASSERT(bMatch);
+    CU_ASSERT(pVec->get(pVec, &item, iNum - 3) == ERR_IDX);
+
+    VectorDeinit(&pVec);
+}
+
 void DestroyObject(Item item)
 {
     free((Tuple*)item);
@@ -316,6 +506,398 @@ void TestSort()
     VectorDeinit(&pVec);
 }
 
+uint64_t ExtractObjectKey(Item item)
+{
+    /* Flip the sign bit so that the negative keys precede the positive ones. */
+    return (uint32_t)((Tuple*)item)->iMajor ^ 0x80000000u;
+}
+
+void PushObjects(Vector *pVec, int32_t iNum, int32_t iMod)
+{
+    /* The major field repeats heavily, and the minor field records the
+       insertion order to verify the sort stability. */
+    uint32_t uiState = 7;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        uiState = uiState * 1103515245u + 12345u;
+        Tuple *tuple = (Tuple*)malloc(sizeof(Tuple));
+        tuple->iMajor = (int32_t)((uiState >> 8) % iMod) - (iMod >> 1);
+        tuple->iMinor = iIdx;
+        CU_ASSERT(pVec->push_back(pVec, (Item)tuple) == SUCC);
+    }
+}
+
+bool CheckStableOrder(Vector *pVec, int32_t iNum)
+{
+    if (pVec->size(pVec) != iNum)
+        return false;
+    Item item;
+    Tuple *prev = NULL;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        pVec->get(pVec, &item, iIdx);
+        Tuple *tuple = (Tuple*)item;
+        if (prev) {
+            if (prev->iMajor > tuple->iMajor)
+                return false;
+            if ((prev->iMajor == tuple->iMajor) && (prev->iMinor > tuple->iMinor))
+                return false;
+        }
+        prev = tuple;
+    }
+    return true;
+}
+
+void TestStableSort()
+{
+    Vector *pVec;
+    CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+    CU_ASSERT(pVec->set_destroy(pVec, DestroyObject) == SUCC);
+
+    /* Sort the empty vector. */
+    CU_ASSERT(pVec->stable_sort(pVec, CompareObject) == SUCC);
+
+    PushObjects(pVec, 1000, 17);
+    CU_ASSERT(pVec->stable_sort(pVec, CompareObject) == SUCC);
+    CU_ASSERT(CheckStableOrder(pVec, 1000));
+
+    VectorDeinit(&pVec);
+}
+
+void TestParallelSort()
+{
+    int32_t aThread[] = {0, 1, 2, 3, 8};
+    int32_t iCase;
+    for (iCase = 0 ; iCase < (int32_t)(sizeof(aThread) / sizeof(int32_t)) ; iCase++) {
+        Vector *pVec;
+        CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+        CU_ASSERT(pVec->set_destroy(pVec, DestroyObject) == SUCC);
+
+        /* The vector is large enough to be split among the threads. */
+        PushObjects(pVec, 100003, 101);
+        CU_ASSERT(pVec->parallel_sort(pVec, CompareObject, aThread[iCase]) == SUCC);
+        CU_ASSERT(CheckStableOrder(pVec, 100003));
+
+        VectorDeinit(&pVec);
+    }
+
+    /* Sort the small vector which falls back to the single thread. */
+    Vector *pVec;
+    CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+    CU_ASSERT(pVec->set_destroy(pVec, DestroyObject) == SUCC);
+    PushObjects(pVec, 100, 7);
+    CU_ASSERT(pVec->parallel_sort(pVec, CompareObject, 4) == SUCC);
+    CU_ASSERT(CheckStableOrder(pVec, 100));
+    VectorDeinit(&pVec);
+}
+
+void TestRadixSort()
+{
+    Vector *pVec;
+    CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+    CU_ASSERT(pVec->set_destroy(pVec, DestroyObject) == SUCC);
+
+    /* Reject the illegal key widths. */
+    CU_ASSERT(pVec->radix_sort(pVec, ExtractObjectKey, 0) == ERR_KEYSIZE);
+    CU_ASSERT(pVec->radix_sort(pVec, ExtractObjectKey, 9) == ERR_KEYSIZE);
+
+    /* Sort the signed keys spanning multiple digits. */
+    PushObjects(pVec, 5000, 70001);
+    CU_ASSERT(pVec->radix_sort(pVec, ExtractObjectKey, 4) == SUCC);
+    CU_ASSERT(CheckStableOrder(pVec, 5000));
+
+    VectorDeinit(&pVec);
+}
+
+void TestQuery()
+{
+    /* Verify the queries against the plain loops for all the tail lengths. */
+    uint32_t uiState = 11;
+    int32_t iSize;
+    for (iSize = 0 ; iSize < 70 ; iSize++) {
+        Vector *pVec, *pDst;
+        CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+        CU_ASSERT(VectorInit(&pDst, 0) == SUCC);
+
+        intptr_t aValue[70];
+        int32_t iIdx;
+        for (iIdx = 0 ; iIdx < iSize ; iIdx++) {
+            uiState = uiState * 1103515245u + 12345u;
+            aValue[iIdx] = (intptr_t)((uiState >> 16) % 15) - 7;
+            CU_ASSERT(pVec->push_back(pVec, (Item)aValue[iIdx]) == SUCC);
+        }
+
+        /* Find and count the items. */
+        intptr_t lKey;
+        for (lKey = -8 ; lKey <= 8 ; lKey++) {
+            int64_t iFirst = -1, iSecond = -1, iCount = 0;
+            for (iIdx = 0 ; iIdx < iSize ; iIdx++) {
+                if (aValue[iIdx] != lKey)
+                    continue;
+                if (iFirst < 0)
+                    iFirst = iIdx;
+                else if (iSecond < 0)
+                    iSecond = iIdx;
+                iCount++;
+            }
+
+            int64_t iRtn;
+            int32_t rc = pVec->find(pVec, (Item)lKey, 0, &iRtn);
+            CU_ASSERT_EQUAL(rc, (iFirst < 0)? ERR_NODATA : SUCC);
+            CU_ASSERT_EQUAL(iRtn, iFirst);
+            if (iFirst >= 0) {
+                rc = pVec->find(pVec, (Item)lKey, iFirst + 1, &iRtn);
+                CU_ASSERT_EQUAL(rc, (iSecond < 0)? ERR_NODATA : SUCC);
+                CU_ASSERT_EQUAL(iRtn, iSecond);
+            }
+            CU_ASSERT(pVec->count(pVec, (Item)lKey, &iRtn) == SUCC);
+            CU_ASSERT_EQUAL(iRtn, iCount);
+        }
+
+        /* Find the extremes with signed and unsigned comparison. */
+        int64_t iMin = 0, iMax = 0, iUMin = 0, iUMax = 0;
+        for (iIdx = 1 ; iIdx < iSize ; iIdx++) {
+            if (aValue[iIdx] < aValue[iMin])
+                iMin = iIdx;
+            if (aValue[iIdx] > aValue[iMax])
+                iMax = iIdx;
+            if ((uintptr_t)aValue[iIdx] < (uintptr_t)aValue[iUMin])
+                iUMin = iIdx;
+            if ((uintptr_t)aValue[iIdx] > (uintptr_t)aValue[iUMax])
+                iUMax = iIdx;
+        }
+        int64_t iRtnMin, iRtnMax;
+        if (iSize == 0) {
+            CU_ASSERT(pVec->min_max(pVec, true, &iRtnMin, &iRtnMax) == ERR_IDX);
+        } else {
+            CU_ASSERT(pVec->min_max(pVec, true, &iRtnMin, &iRtnMax) == SUCC);
+            CU_ASSERT_EQUAL(iRtnMin, iMin);
+            CU_ASSERT_EQUAL(iRtnMax, iMax);
+            CU_ASSERT(pVec->min_max(pVec, false, &iRtnMin, NULL) == SUCC);
+            CU_ASSERT_EQUAL(iRtnMin, iUMin);
+            CU_ASSERT(pVec->min_max(pVec, false, NULL, &iRtnMax) == SUCC);
+            CU_ASSERT_EQUAL(iRtnMax, iUMax);
+        }
+
+        /* Filter the items within the signed range. */
+        CU_ASSERT(pVec->filter(pVec, pDst, (Item)-2, (Item)3, true) == SUCC);
+        int64_t iPos = 0;
+        bool bMatch = true;
+        Item item;
+        for (iIdx = 0 ; iIdx < iSize ; iIdx++) {
+            if ((aValue[iIdx] < -2) || (aValue[iIdx] > 3))
+                continue;
+            pDst->get(pDst, &item, iPos++);
+            if (item != (Item)aValue[iIdx])
+                bMatch = false;
+        }
+        CU_ASSERT(bMatch);
+        CU_ASSERT_EQUAL(pDst->size(pDst), iPos);
+
+        /* The unsigned range excludes the negative items. */
+        CU_ASSERT(pVec->filter(pVec, pVec, (Item)0, (Item)7, false) == SUCC);
+        int64_t iCount = 0;
+        for (iIdx = 0 ; iIdx < iSize ; iIdx++)
+            iCount += (aValue[iIdx] >= 0);
+        CU_ASSERT_EQUAL(pVec->size(pVec), iSize + iCount);
+
+        VectorDeinit(&pVec);
+        VectorDeinit(&pDst);
+    }
+
+    /* Check illegal parameters. */
+    Vector *pVec;
+    CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+    int64_t iRtn;
+    CU_ASSERT(pVec->find(pVec, NULL, 0, NULL) == ERR_GET);
+    CU_ASSERT(pVec->find(pVec, NULL, 1, &iRtn) == ERR_IDX);
+    CU_ASSERT(pVec->count(pVec, NULL, NULL) == ERR_GET);
+    CU_ASSERT(pVec->min_max(pVec, true, NULL, NULL) == ERR_GET);
+    CU_ASSERT(pVec->filter(pVec, NULL, NULL, NULL, true) == ERR_NOINIT);
+    VectorDeinit(&pVec);
+}
+
+bool CheckMajorOrder(Vector *pVec)
+{
+    Item item;
+    Tuple *prev = NULL;
+    int64_t iIdx;
+    for (iIdx = 0 ; iIdx < pVec->size(pVec) ; iIdx++) {
+        pVec->get(pVec, &item, iIdx);
+        if (prev && (prev->iMajor > ((Tuple*)item)->iMajor))
+            return false;
+        prev = (Tuple*)item;
+    }
+    return true;
+}
+
+void TestSortedSearch()
+{
+    Vector *pVec;
+    CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+    CU_ASSERT(pVec->set_destroy(pVec, DestroyObject) == SUCC);
+
+    /* Search the empty vector. */
+    Tuple key;
+    key.iMajor = 0;
+    int64_t iBgn, iEnd;
+    CU_ASSERT(pVec->lower_bound(pVec, (Item)&key, CompareObject, &iBgn) == SUCC);
+    CU_ASSERT_EQUAL(iBgn, 0);
+    CU_ASSERT(pVec->lower_bound(pVec, (Item)&key, CompareObject, NULL) == ERR_GET);
+    CU_ASSERT(pVec->equal_range(pVec, (Item)&key, CompareObject, &iBgn, NULL) == ERR_GET);
+
+    PushObjects(pVec, 501, 21);
+    CU_ASSERT(pVec->stable_sort(pVec, CompareObject) == SUCC);
+
+    /* Compare the bounds with the linear scan, including the absent keys. */
+    bool bMatch = true;
+    for (key.iMajor = -13 ; key.iMajor <= 13 ; key.iMajor++) {
+        int64_t iLow = 0, iHigh = 0, iIdx;
+        Item item;
+        for (iIdx = 0 ; iIdx < pVec->size(pVec) ; iIdx++) {
+            pVec->get(pVec, &item, iIdx);
+            iLow += (((Tuple*)item)->iMajor < key.iMajor);
+            iHigh += (((Tuple*)item)->iMajor <= key.iMajor);
+        }
+        int64_t iRtnLow, iRtnHigh;
+        pVec->lower_bound(pVec, (Item)&key, CompareObject, &iRtnLow);
+        pVec->upper_bound(pVec, (Item)&key, CompareObject, &iRtnHigh);
+        pVec->equal_range(pVec, (Item)&key, CompareObject, &iBgn, &iEnd);
+        if ((iRtnLow != iLow) || (iRtnHigh != iHigh) || (iBgn != iLow) ||
+            (iEnd != iHigh))
+            bMatch = false;
+    }
+    CU_ASSERT(bMatch);
+
+    /* The sorted insertion places the item after the equivalent ones. */
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < 50 ; iIdx++) {
+        Tuple *tuple = (Tuple*)malloc(sizeof(Tuple));
+        tuple->iMajor = (iIdx * 7) % 25 - 12;
+        tuple->iMinor = 1000 + iIdx;
+        CU_ASSERT(pVec->insert_sorted(pVec, (Item)tuple, CompareObject) == SUCC);
+    }
+    CU_ASSERT(CheckStableOrder(pVec, 551));
+
+    /* Merge another sorted vector whose items are owned by the first one. */
+    Vector *pSrc;
+    CU_ASSERT(VectorInit(&pSrc, 0) == SUCC);
+    PushObjects(pSrc, 300, 31);
+    CU_ASSERT(pSrc->stable_sort(pSrc, CompareObject) == SUCC);
+    CU_ASSERT(pVec->merge(pVec, pSrc, CompareObject) == SUCC);
+    CU_ASSERT_EQUAL(pVec->size(pVec), 851);
+    CU_ASSERT(CheckMajorOrder(pVec));
+    CU_ASSERT_EQUAL(pSrc->size(pSrc), 300);
+
+    /* Merge the vector with itself. */
+    CU_ASSERT(pSrc->merge(pSrc, pSrc, CompareObject) == SUCC);
+    CU_ASSERT_EQUAL(pSrc->size(pSrc), 600);
+    CU_ASSERT(CheckMajorOrder(pSrc));
+    CU_ASSERT(pSrc->merge(pSrc, NULL, CompareObject) == ERR_NOINIT);
+
+    VectorDeinit(&pSrc);
+    VectorDeinit(&pVec);
+}
+
+int32_t CompareInteger(const void *ppSrc, const void *ppTge)
+{
+    intptr_t lSrc = (intptr_t)*((Item*)ppSrc);
+    intptr_t lTge = (intptr_t)*((Item*)ppTge);
+    if (lSrc == lTge)
+        return 0;
+    return (lSrc > lTge)? 1 : (-1);
+}
+
+void PushIntegers(Vector *pVec, intptr_t *aValue, int32_t iNum, int32_t iPattern)
+{
+    /* The patterns are random, ascending, descending, and all equal. */
+    uint32_t uiState = 5;
+    int32_t iIdx;
+    for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+        uiState = uiState * 1103515245u + 12345u;
+        intptr_t lValue = (iPattern == 0)? (intptr_t)((uiState >> 8) % 997) - 498 :
+                          (iPattern == 1)? iIdx :
+                          (iPattern == 2)? (iNum - iIdx) : 42;
+        aValue[iIdx] = lValue;
+        CU_ASSERT(pVec->push_back(pVec, (Item)lValue) == SUCC);
+    }
+    qsort(aValue, iNum, sizeof(intptr_t), CompareInteger);
+}
+
+void TestSelection()
+{
+    int32_t iNum = 3001;
+    intptr_t *aValue = (intptr_t*)malloc(sizeof(intptr_t) * iNum);
+    Item *aTop = (Item*)malloc(sizeof(Item) * iNum);
+    int32_t aRank[] = {0, 1, 17, 1500, 2999, 3000};
+
+    int32_t iPattern;
+    for (iPattern = 0 ; iPattern < 4 ; iPattern++) {
+        int32_t iCase;
+        for (iCase = 0 ; iCase < (int32_t)(sizeof(aRank) / sizeof(int32_t)) ; iCase++) {
+            int64_t iNth = aRank[iCase];
+            Vector *pVec;
+            CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+            PushIntegers(pVec, aValue, iNum, iPattern);
+
+            /* The item of the designated rank partitions the others. */
+            CU_ASSERT(pVec->nth_element(pVec, iNth, CompareInteger) == SUCC);
+            Item item;
+            pVec->get(pVec, &item, iNth);
+            intptr_t lPivot = (intptr_t)item;
+            CU_ASSERT_EQUAL(lPivot, aValue[iNth]);
+            bool bMatch = true;
+            int64_t iIdx;
+            for (iIdx = 0 ; iIdx < iNum ; iIdx++) {
+                pVec->get(pVec, &item, iIdx);
+                if ((iIdx < iNth) && ((intptr_t)item > lPivot))
+                    bMatch = false;
+                if ((iIdx > iNth) && ((intptr_t)item < lPivot))
+                    bMatch = false;
+            }
+            CU_ASSERT(bMatch);
+
+            /* The leading items are sorted by the partial sort. */
+            CU_ASSERT(pVec->partial_sort(pVec, iNth, CompareInteger) == SUCC);
+            for (iIdx = 0 ; iIdx < iNth ; iIdx++) {
+                pVec->get(pVec, &item, iIdx);
+                if ((intptr_t)item != aValue[iIdx])
+                    bMatch = false;
+            }
+            CU_ASSERT(bMatch);
+
+            /* The top items are collected without touching the vector. */
+            Item itemHead;
+            pVec->get(pVec, &itemHead, 0);
+            CU_ASSERT(pVec->top_k(pVec, iNth + 1, CompareInteger, aTop) == SUCC);
+            for (iIdx = 0 ; iIdx <= iNth ; iIdx++) {
+                if ((intptr_t)aTop[iIdx] != aValue[iIdx])
+                    bMatch = false;
+            }
+            CU_ASSERT(bMatch);
+            pVec->get(pVec, &item, 0);
+            CU_ASSERT_EQUAL(item, itemHead);
+
+            VectorDeinit(&pVec);
+        }
+    }
+
+    /* Check illegal parameters. */
+    Vector *pVec;
+    CU_ASSERT(VectorInit(&pVec, 0) == SUCC);
+    CU_ASSERT(pVec->nth_element(pVec, 0, CompareInteger) == ERR_IDX);
+    CU_ASSERT(pVec->partial_sort(pVec, 0, CompareInteger) == SUCC);
+    CU_ASSERT(pVec->partial_sort(pVec, 1, CompareInteger) == ERR_IDX);
+    CU_ASSERT(pVec->push_back(pVec, (Item)1) == SUCC);
+    CU_ASSERT(pVec->nth_element(pVec, -1, CompareInteger) == ERR_IDX);
+    CU_ASSERT(pVec->top_k(pVec, 2, CompareInteger, aTop) == ERR_IDX);
+    CU_ASSERT(pVec->top_k(pVec, 1, CompareInteger, NULL) == ERR_GET);
+    VectorDeinit(&pVec);
+
+    free(aTop);
+    free(aValue);
+}
+
 void TestIterate()
 {
     Vector *pVec;